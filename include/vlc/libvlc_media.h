@@ -114,11 +114,25 @@ typedef struct libvlc_media_stats_t
     /* Decoders */
     int         i_decoded_video;
     int         i_decoded_audio;
+    /** Instantaneous rate of bytes fed to the video decoder */
+    float       f_video_es_bitrate;
+    /** Instantaneous rate of bytes fed to the audio decoder */
+    float       f_audio_es_bitrate;
+    /** Current number of frames waiting in the video decoder fifo */
+    int64_t     i_decoder_queue_depth;
 
     /* Video Output */
     int         i_displayed_pictures;
     int         i_late_pictures;
     int         i_lost_pictures;
+    /** Number of frames accounted in the display latency histogram */
+    int64_t     i_display_latency_samples;
+    /** Average demux-to-display latency of the displayed frames,
+     * in microseconds */
+    int64_t     i_display_latency_avg_us;
+    /** Demux-to-display latency histogram: bucket N counts frames with a
+     * latency below 10000 us << N, the last bucket everything above */
+    int64_t     i_display_latency_histogram[8];
 
     /* Audio output */
     int         i_played_abuffers;
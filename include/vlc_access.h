@@ -74,6 +74,52 @@ VLC_API int access_vaDirectoryControlHelper( stream_t *p_access, int i_query, va
         p_access->pf_demux = NULL; \
     } while(0)
 
+/**
+ * Access block recycling pool.
+ *
+ * A block access allocates a fresh block for every read while the consumer
+ * releases them from downstream threads, so generic allocation caches never
+ * return the buffers to the reading thread. A pool hands out fixed-capacity
+ * blocks whose release callback sends them back to the originating pool,
+ * whichever thread consumed them, making the steady-state ingest path
+ * allocation-free.
+ */
+struct vlc_access_pool;
+
+/**
+ * Creates a block recycling pool.
+ *
+ * @param capacity payload capacity of a pooled block, in bytes
+ * @param depth maximum number of idle blocks kept for reuse
+ * @return a pool or NULL on memory error
+ */
+VLC_API struct vlc_access_pool *vlc_access_pool_New(size_t capacity,
+                                                    unsigned depth) VLC_USED;
+
+/**
+ * Allocates a block from a pool.
+ *
+ * The block is returned to the pool when it is released, from any thread.
+ * Requests larger than the pool capacity fall back to a plain allocation.
+ *
+ * @param size size in bytes (at most the pool capacity to recycle)
+ * @return a block or NULL on memory error
+ */
+VLC_API block_t *vlc_access_pool_Block(struct vlc_access_pool *,
+                                       size_t size) VLC_USED;
+
+/**
+ * Releases the owner reference to a pool.
+ *
+ * Idle blocks are freed immediately; blocks still held downstream are freed
+ * on release and the pool itself once the last one is gone. No new block may
+ * be requested afterwards.
+ *
+ * @param access access to log the pool hit rate to, or NULL
+ */
+VLC_API void vlc_access_pool_Release(struct vlc_access_pool *,
+                                     stream_t *access);
+
 /**
  * @} @}
  */
@@ -93,6 +93,21 @@ vlc_ancillary_Create(void *data, vlc_ancillary_id id)
     return vlc_ancillary_CreateWithFreeCb(data, id, free);
 }
 
+/**
+ * Create an ancillary embedding its data in the same allocation
+ *
+ * Compared to vlc_ancillary_Create(), this does a single allocation for
+ * both the ancillary and its data, which matters for metadata attached
+ * to every frame (HDR10+, Dolby Vision). The data is uninitialized and
+ * can be retrieved with vlc_ancillary_GetData().
+ *
+ * @param id id of ancillary
+ * @param size size of the data to allocate, must be > 0
+ * @return a valid vlc_ancillary pointer or NULL in case of allocation error
+ */
+VLC_API struct vlc_ancillary *
+vlc_ancillary_CreateWithSize(vlc_ancillary_id id, size_t size);
+
 /**
  * Release an ancillary
  *
@@ -577,6 +577,19 @@ typedef struct
 
 typedef struct aout_filters aout_filters_t;
 
+/**
+ * Audio filter buffer convention
+ *
+ * Sample buffers handed to audio filters are allocated with
+ * vlc_frame_Alloc() and are therefore at least 32-byte aligned, with
+ * samples of all channels interleaved contiguously. Filters should process
+ * whole buffers with dense inner loops over samples or channels so that
+ * SIMD (SSE/NEON) code, hand-written or compiler-generated, can be used.
+ * The number of frames per buffer is arbitrary: vectorized kernels must
+ * handle a scalar tail rather than assume a multiple of the vector width.
+ * In-place processing is allowed whenever the input format is preserved.
+ */
+
 VLC_API aout_filters_t *aout_FiltersNew(vlc_object_t *,
                                         const audio_sample_format_t *,
                                         const audio_sample_format_t *,
@@ -277,14 +277,37 @@ static inline void bs_write_align( bs_t *s, uint8_t v )
 #define bs_align_1( s ) bs_write_align( s, 1 )
 
 /* Read unsigned Exp-Golomb code */
-static inline uint_fast32_t bs_read_ue( bs_t * bs )
+static inline uint_fast32_t bs_read_ue( bs_t *bs )
 {
     unsigned i = 0;
 
-    while( !bs->b_error &&
-           bs_read1( bs ) == 0 &&
-           bs->p < bs->p_end && i < 31 )
-        i++;
+    /* Count the leading zero bits one byte at a time rather than with a
+     * per-bit loop: the zero run length is derived from the position of the
+     * highest bit set in the pending bits of the current byte. */
+    while( !bs->b_error && i < 31 )
+    {
+        if( bs_refill( bs ) )
+        {
+            bs->b_error = true;
+            break;
+        }
+
+        unsigned cur = *bs->p & ( ( 1U << bs->i_left ) - 1 );
+        if( cur != 0 )
+        {
+            unsigned msb = 32 - vlc_clz( cur ); /* 1-based highest bit set */
+            i += bs->i_left - msb;
+            bs->i_left = msb - 1; /* consume the zeros and the stop bit */
+            break;
+        }
+
+        /* All pending bits of this byte are zero */
+        i += bs->i_left;
+        bs->i_left = 0;
+    }
+
+    if( i > 31 )
+        i = 31;
 
     return (1U << i) - 1 + bs_read( bs, i );
 }
@@ -0,0 +1,113 @@
+/*****************************************************************************
+ * vlc_chan.h: bounded inter-thread channels
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifndef VLC_CHAN_H
+#define VLC_CHAN_H
+
+#include <vlc_common.h>
+
+/**
+ * @defgroup chan Bounded channels
+ * @ingroup cext
+ * @{
+ * @file vlc_chan.h
+ *
+ * A channel is a bounded thread-safe FIFO of pointers, meant to connect the
+ * stages of a processing pipeline running on separate threads.
+ *
+ * Unlike @ref vlc_queue_t, a channel has a fixed capacity: vlc_chan_Send()
+ * blocks while the channel is full, so backpressure from a slow consumer
+ * propagates naturally to the producer instead of growing an unbounded
+ * backlog. Blocking operations honour the interruption context of the
+ * calling thread (see vlc_interrupt_set()), so that every stage of a
+ * pipeline can be unwound uniformly with vlc_interrupt_raise().
+ */
+
+/**
+ * Opaque channel type.
+ */
+typedef struct vlc_chan vlc_chan_t;
+
+/**
+ * Creates a channel.
+ *
+ * @param capacity maximum number of queued entries (must be non-zero)
+ * @return a channel, or NULL on allocation failure
+ */
+VLC_API vlc_chan_t *vlc_chan_New(size_t capacity) VLC_USED;
+
+/**
+ * Deletes a channel.
+ *
+ * No thread may be blocked on, or further use, the channel.
+ *
+ * @note The channel does not own the queued entries: any entry still queued
+ * is the responsibility of the caller, which should normally close the
+ * channel and drain it with vlc_chan_Recv() first.
+ */
+VLC_API void vlc_chan_Delete(vlc_chan_t *chan);
+
+/**
+ * Sends an entry through a channel.
+ *
+ * If the channel is full, this function waits until an entry is received or
+ * the channel is closed.
+ *
+ * @warning Interruptions are only delivered accurately if no more than one
+ * thread ever sends on the channel (see vlc_sem_wait_i11e()).
+ *
+ * @param chan the channel
+ * @param entry the entry to send (cannot be NULL)
+ * @return 0 on success, EPIPE if the channel is closed, EINTR if the calling
+ * thread was interrupted (the entry is not queued in the last two cases)
+ */
+VLC_API int vlc_chan_Send(vlc_chan_t *chan, void *entry);
+
+/**
+ * Receives the oldest entry from a channel.
+ *
+ * If the channel is empty, this function waits until an entry is sent or the
+ * channel is closed.
+ *
+ * @warning Interruptions are only delivered accurately if no more than one
+ * thread ever receives on the channel (see vlc_sem_wait_i11e()).
+ *
+ * @param chan the channel
+ * @param entry storage space for the received entry
+ * @return 0 on success, EPIPE if the channel is closed and drained, EINTR if
+ * the calling thread was interrupted (*entry is set to NULL in the last two
+ * cases)
+ */
+VLC_API int vlc_chan_Recv(vlc_chan_t *chan, void **entry);
+
+/**
+ * Closes a channel.
+ *
+ * This marks the end of the stream of entries. Pending and subsequent calls
+ * to vlc_chan_Send() fail with EPIPE. vlc_chan_Recv() keeps returning the
+ * entries already queued, then fails with EPIPE.
+ *
+ * Closing is idempotent and is typically performed by the sending side, or
+ * by a controlling thread to tear the pipeline down.
+ */
+VLC_API void vlc_chan_Close(vlc_chan_t *chan);
+
+/** @} */
+#endif
@@ -49,6 +49,27 @@
  */
 VLC_API ssize_t vlc_towc(const char *str, uint32_t *restrict pwc);
 
+/**
+ * Skips leading ASCII characters.
+ *
+ * Looks for the first null or non-ASCII byte in a null-terminated string.
+ * ASCII bytes are always valid UTF-8 and most strings are predominantly
+ * ASCII, so this short-circuits the bulk of the per-code-point validation
+ * work.
+ *
+ * \param str string to scan
+ *
+ * \return a pointer to the first null or non-ASCII byte in the string
+ */
+VLC_USED static inline const char *vlc_skip_ascii(const char *str)
+{
+    /* One byte at a time: without a known length or padding guarantee,
+     * word-sized loads would read past the terminator. */
+    while (*str != '\0' && ((unsigned char)*str) < 0x80)
+        str++;
+    return str;
+}
+
 /**
  * Checks UTF-8 validity.
  *
@@ -64,9 +85,10 @@ VLC_USED static inline const char *IsUTF8(const char *str)
     ssize_t n;
     uint32_t cp;
 
+    str = vlc_skip_ascii(str);
     while ((n = vlc_towc(str, &cp)) != 0)
         if (likely(n != -1))
-            str += n;
+            str = vlc_skip_ascii(str + n);
         else
             return NULL;
     return str;
@@ -85,12 +107,7 @@ VLC_USED static inline const char *IsUTF8(const char *str)
  */
 VLC_USED static inline const char *IsASCII(const char *str)
 {
-    unsigned char c;
-
-    for (const char *p = str; (c = *p) != '\0'; p++)
-        if (c >= 0x80)
-            return NULL;
-    return str;
+    return (*vlc_skip_ascii(str) == '\0') ? str : NULL;
 }
 
 /**
@@ -117,9 +134,10 @@ static inline char *EnsureUTF8(char *str)
     ssize_t n;
     uint32_t cp;
 
+    str = (char *)vlc_skip_ascii(str);
     while ((n = vlc_towc(str, &cp)) != 0)
         if (likely(n != -1))
-            str += n;
+            str = (char *)vlc_skip_ascii(str + n);
         else
         {
             *str++ = '?';
@@ -507,6 +507,8 @@ typedef union
 #define VLC_ENOMEM         (-ENOMEM)
 /** Timeout */
 #define VLC_ETIMEOUT       (-ETIMEDOUT)
+/** Incomplete, try again */
+#define VLC_EAGAIN         (-EAGAIN)
 /** Not found */
 #define VLC_ENOENT         (-ENOENT)
 /** Bad variable value */
@@ -635,6 +635,29 @@ VLC_API vlc_demux_chained_t *vlc_demux_chained_New(vlc_object_t *parent,
                                                    const char *name,
                                                    es_out_t *out);
 
+/**
+ * Creates an inline chained demuxer.
+ *
+ * This behaves like vlc_demux_chained_New(), except that the chained demuxer
+ * runs on the caller thread, within vlc_demux_chained_Send(), rather than on
+ * a separate thread. This saves a thread and a thread hop per buffer, and
+ * queued data is consumed as it is sent rather than accumulated.
+ *
+ * \warning This only works with demuxers that consume the stream along the
+ * boundaries of the blocks sent to them, e.g. whole transport stream packets.
+ * The input FIFO is non-blocking here: a demuxer reading across the end of
+ * the queued data observes a (transient) end-of-stream instead of waiting,
+ * and any partially read data is lost.
+ *
+ * \param parent parent VLC object
+ * \param name chained demux module name (e.g. "ts")
+ * \param out elementary stream output for the chained demux
+ * \return a non-NULL pointer on success, NULL on failure.
+ */
+VLC_API vlc_demux_chained_t *vlc_demux_chained_NewInline(vlc_object_t *parent,
+                                                         const char *name,
+                                                         es_out_t *out);
+
 /**
  * Destroys a chained demuxer.
  *
@@ -109,6 +109,17 @@ VLC_API bool vlc_epg_AddEvent(vlc_epg_t *p_epg, vlc_epg_event_t *p_evt);
  */
 VLC_API void vlc_epg_SetCurrent(vlc_epg_t *p_epg, int64_t i_start);
 
+/**
+ * Returns the event airing at time \p i_time, or NULL if none.
+ *
+ * The lookup is O(log n): events are kept sorted by start time and do not
+ * overlap within a table.
+ *
+ * \p i_time a time in epoch time
+ */
+VLC_API const vlc_epg_event_t * vlc_epg_GetEvent(const vlc_epg_t *p_epg,
+                                                 int64_t i_time) VLC_USED;
+
 /**
  * Returns a duplicated \p p_src and its associated events.
  *
@@ -25,6 +25,8 @@
 
 #include <assert.h>
 
+#include <vlc_frame.h>
+
 /**
  * \defgroup es_out ES output
  * \ingroup input
@@ -130,6 +132,12 @@ struct es_out_callbacks
 {
     es_out_id_t *(*add)(es_out_t *, input_source_t *in, const es_format_t *);
     int          (*send)(es_out_t *, es_out_id_t *, block_t *);
+    /**
+     * Optional: sends a whole block chain for a single ES in one call,
+     * amortizing locking and clock bookkeeping across the chain.
+     * May be NULL, in which case es_out_SendBatch() falls back on send.
+     */
+    int          (*send_batch)(es_out_t *, es_out_id_t *, block_t *);
     void         (*del)(es_out_t *, es_out_id_t *);
     int          (*control)(es_out_t *, input_source_t *in, int query, va_list);
     void         (*destroy)(es_out_t *);
@@ -161,6 +169,32 @@ static inline int es_out_Send( es_out_t *out, es_out_id_t *id,
     return out->cbs->send( out, id, p_block );
 }
 
+/**
+ * Sends a chain of data blocks for a given ES.
+ *
+ * Equivalent to calling es_out_Send() on each block of the chain in order,
+ * but gives the es_out a chance to process the whole chain under a single
+ * lock acquisition. High-rate demuxers emitting many small blocks (e.g.
+ * MPEG-TS PES) should prefer this over per-block es_out_Send() calls.
+ */
+static inline int es_out_SendBatch( es_out_t *out, es_out_id_t *id,
+                                    block_t *p_chain )
+{
+    if( out->cbs->send_batch != NULL )
+        return out->cbs->send_batch( out, id, p_chain );
+
+    int ret = VLC_SUCCESS;
+    while( p_chain != NULL )
+    {
+        block_t *p_next = p_chain->p_next;
+
+        p_chain->p_next = NULL;
+        ret = out->cbs->send( out, id, p_chain );
+        p_chain = p_next;
+    }
+    return ret;
+}
+
 static inline int es_out_vaControl( es_out_t *out, int i_query, va_list args )
 {
     return out->cbs->control( out, NULL, i_query, args );
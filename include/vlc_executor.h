@@ -31,6 +31,18 @@ extern "C" {
 /** Executor type (opaque) */
 typedef struct vlc_executor vlc_executor_t;
 
+/**
+ * Priority of a submitted runnable.
+ *
+ * Urgent runnables are executed before any pending normal runnable,
+ * regardless of submission order. Within a priority level, runnables are
+ * executed in submission order.
+ */
+enum vlc_executor_priority {
+    VLC_EXECUTOR_PRIORITY_NORMAL,
+    VLC_EXECUTOR_PRIORITY_URGENT,
+};
+
 /**
  * A Runnable encapsulates a task to be run from an executor thread.
  */
@@ -145,6 +157,25 @@ vlc_executor_Delete(vlc_executor_t *executor);
 VLC_API void
 vlc_executor_Submit(vlc_executor_t *executor, struct vlc_runnable *runnable);
 
+/**
+ * Submit a runnable for execution with an explicit priority.
+ *
+ * Same as vlc_executor_Submit(), except that the runnable is queued
+ * according to the given priority. Useful to keep interactive work (like
+ * generating the thumbnail of an item just displayed) responsive while
+ * bulk background tasks are pending.
+ *
+ * Note that an urgent runnable never preempts a runnable already started.
+ *
+ * \param executor the executor
+ * \param runnable the task to run
+ * \param priority the queuing priority
+ */
+VLC_API void
+vlc_executor_SubmitWithPriority(vlc_executor_t *executor,
+                                struct vlc_runnable *runnable,
+                                enum vlc_executor_priority priority);
+
 /**
  * Cancel a runnable previously submitted.
  *
@@ -414,6 +414,26 @@ VLC_API int filter_Blend( vlc_blender_t *, picture_t *p_dst, int i_dst_x, int i_
  */
 VLC_API void filter_DeleteBlend( vlc_blender_t * );
 
+/**
+ * Runs a work callback sliced over the shared filter worker pool.
+ *
+ * The pool is shared by all filters of a LibVLC instance and created on
+ * first use. The callback is invoked once per slice, potentially
+ * concurrently from several threads, with a slice index in [0, count)
+ * and the total slice count; one slice always runs on the calling
+ * thread. The function returns once every slice has completed.
+ *
+ * Concurrent calls from different filters are serialized, and when no
+ * pool can be created the callback is invoked once with slice 0 and
+ * count 1, so filters may use this unconditionally for row-independent
+ * work. The caller remains responsible for making sure slices do not
+ * write to overlapping picture areas.
+ */
+VLC_API void filter_RunSlices( filter_t *,
+                               void (*work)( void *opaque, unsigned slice,
+                                             unsigned count ),
+                               void *opaque );
+
 /**
  * Create a picture_t *(*)( filter_t *, picture_t * ) compatible wrapper
  * using a void (*)( filter_t *, picture_t *, picture_t * ) function
@@ -513,6 +533,25 @@ VLC_API void filter_chain_Reset( filter_chain_t *p_chain,
                                  vlc_video_context *vctx_in,
                                  const es_format_t *p_fmt_out );
 
+/**
+ * Applies a benign source format change to the chain in place.
+ *
+ * If the new input format only differs from the current one by fields the
+ * loaded filters can absorb without reopening (sample aspect ratio, frame
+ * rate), the formats along the chain are patched and the filters keep their
+ * state. Otherwise the chain is left untouched and the caller must rebuild
+ * it with filter_chain_Reset().
+ *
+ * \param p_chain pointer to filter chain
+ * \param p_fmt_in new fmt_in params
+ * \param vctx_in new input video context
+ * \return true if the change was applied in place, false if a rebuild is
+ * required
+ */
+VLC_API bool filter_chain_UpdateSourceFormat( filter_chain_t *p_chain,
+                                              const es_format_t *p_fmt_in,
+                                              vlc_video_context *vctx_in );
+
 /**
  * Remove all existing filters
  *
@@ -586,6 +625,19 @@ VLC_API const es_format_t *filter_chain_GetFmtOut(const filter_chain_t *chain);
  */
 VLC_API vlc_video_context *filter_chain_GetVideoCtxOut(const filter_chain_t *chain);
 
+/**
+ * Count the copies to CPU memory incurred by a video filter chain.
+ *
+ * Opaque (hardware-decoded) pictures are passed by video context from one
+ * filter to the next without copying. Each filter that accepts an opaque
+ * input but outputs to CPU memory has to download every surface, costing
+ * one copy per frame. A well-negotiated chain has at most one such copy.
+ *
+ * \param chain filter chain
+ * \return the number of per-frame copies to CPU memory in the chain
+ */
+VLC_API unsigned filter_chain_GetVideoCopyCount(const filter_chain_t *chain);
+
 /**
  * Apply the filter chain to a video picture.
  *
@@ -662,6 +662,19 @@ static inline void vlc_fifo_Wait(vlc_fifo_t *fifo)
     vlc_queue_Wait(vlc_fifo_queue(fifo));
 }
 
+/**
+ * Waits on the FIFO up to a deadline.
+ *
+ * Like vlc_fifo_Wait(), but the wait ends at the given deadline even if the
+ * FIFO is not signaled.
+ *
+ * @return 0 if the FIFO was signaled, ETIMEDOUT on time-out
+ */
+static inline int vlc_fifo_TimedWait(vlc_fifo_t *fifo, vlc_tick_t deadline)
+{
+    return vlc_queue_TimedWait(vlc_fifo_queue(fifo), deadline);
+}
+
 static inline void vlc_fifo_WaitCond(vlc_fifo_t *fifo, vlc_cond_t *condvar)
 {
     vlc_queue_t *q = vlc_fifo_queue(fifo);
@@ -55,7 +55,9 @@ struct image_handler_t
     vlc_object_t *p_parent;
     decoder_t *p_dec;
     encoder_t *p_enc;
-    filter_t  *p_converter;
+    /* Converter cache, most recently used first,
+     * keyed by input/output format and size */
+    filter_t  *converters[3];
 
     picture_fifo_t *outfifo;
 };
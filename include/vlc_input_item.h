@@ -289,6 +289,34 @@ VLC_API char * input_item_GetTitleFbName( input_item_t * p_i ) VLC_USED;
 VLC_API char * input_item_GetURI( input_item_t * p_i ) VLC_USED;
 VLC_API char * input_item_GetNowPlayingFb( input_item_t *p_item ) VLC_USED;
 VLC_API void input_item_SetURI( input_item_t * p_i, const char *psz_uri );
+
+/**
+ * Borrows the current name of an item.
+ *
+ * Unlike input_item_GetName(), this neither takes the item lock nor copies
+ * the string: the returned string is an immutable shared copy, which remains
+ * valid even if the name is changed concurrently. It must be released with
+ * input_item_ReleaseString().
+ *
+ * \return the item name, or NULL if the item has none
+ */
+VLC_API const char *input_item_HoldName( input_item_t * ) VLC_USED;
+
+/**
+ * Borrows the current URI of an item.
+ *
+ * This is the URI counterpart of input_item_HoldName(). The returned string
+ * must be released with input_item_ReleaseString().
+ *
+ * \return the item URI, or NULL if the item has none
+ */
+VLC_API const char *input_item_HoldURI( input_item_t * ) VLC_USED;
+
+/**
+ * Releases a string borrowed with input_item_HoldName() or
+ * input_item_HoldURI(). NULL is a valid no-op argument.
+ */
+VLC_API void input_item_ReleaseString( const char *psz_value );
 VLC_API vlc_tick_t input_item_GetDuration( input_item_t * p_i );
 VLC_API void input_item_SetDuration( input_item_t * p_i, vlc_tick_t i_duration );
 VLC_API bool input_item_IsPreparsed( input_item_t *p_i );
@@ -518,6 +546,12 @@ VLC_API void libvlc_MetadataCancel( libvlc_int_t *, void * );
 /******************
  * Input stats
  ******************/
+
+/** Number of buckets in the display latency histogram. Bucket N counts
+ * frames with a demux-to-display latency below 10 ms << N, the last
+ * bucket everything above. */
+#define INPUT_STATS_LATENCY_BUCKETS 8
+
 struct input_stats_t
 {
     /* Input */
@@ -535,11 +569,34 @@ struct input_stats_t
     /* Decoders */
     int64_t i_decoded_audio;
     int64_t i_decoded_video;
+    /** Bytes fed to the video decoder and the resulting rate */
+    int64_t i_video_es_read_bytes;
+    float f_video_es_bitrate;
+    /** Bytes fed to the audio decoder and the resulting rate */
+    int64_t i_audio_es_read_bytes;
+    float f_audio_es_bitrate;
+    /** Current number of frames waiting in the video decoder fifo */
+    int64_t i_decoder_queue_depth;
 
     /* Vout */
     int64_t i_displayed_pictures;
     int64_t i_late_pictures;
     int64_t i_lost_pictures;
+    /** Pictures displayed with the user filters bypassed to catch up */
+    int64_t i_degraded_pictures;
+    /** Current number of pictures in the video decoder pool */
+    int64_t i_pool_occupancy;
+    /** Times the decoder found the picture pool exhausted */
+    int64_t i_pool_starved;
+    /** Total time the decoder spent waiting for a pool picture */
+    vlc_tick_t i_pool_wait_duration;
+    /** Number of frames accounted in the display latency histogram */
+    int64_t i_display_latency_samples;
+    /** Total demux-to-display latency of the accounted frames */
+    vlc_tick_t i_display_latency_sum;
+    /** Demux-to-display latency histogram,
+     * \see INPUT_STATS_LATENCY_BUCKETS */
+    int64_t i_display_latency_histogram[INPUT_STATS_LATENCY_BUCKETS];
 
     /* Aout */
     int64_t i_played_abuffers;
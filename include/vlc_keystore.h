@@ -195,6 +195,7 @@ struct vlc_credential
     char *psz_dialog_username;
     char *psz_dialog_password;
     bool b_from_keystore;
+    bool b_from_memory_keystore;
     bool b_store;
 };
 
@@ -115,6 +115,26 @@ VLC_API
 size_t vlc_memstream_write(struct vlc_memstream *ms,
                            const void *ptr, size_t len);
 
+struct iovec;
+
+/**
+ * Appends a series of binary blobs to a byte stream.
+ *
+ * Writes an array of discontiguous spans in a single call, so that the
+ * stream storage is grown at most once.
+ *
+ * Compare with @c writev().
+ *
+ * @param iov array of spans to append
+ * @param iovcnt number of spans in the array
+ *
+ * @return the total number of bytes written; on error, this is smaller than
+ *         the sum of the span lengths
+ */
+VLC_API
+size_t vlc_memstream_writev(struct vlc_memstream *ms,
+                            const struct iovec *iov, int iovcnt);
+
 /**
  * Appends a single byte to a byte stream.
  *
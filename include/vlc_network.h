@@ -297,6 +297,26 @@ VLC_API int vlc_getaddrinfo (const char *, unsigned,
 VLC_API int vlc_getaddrinfo_i11e(const char *, unsigned,
                                  const struct addrinfo *, struct addrinfo **);
 
+/**
+ * Resolves a host name with a time-bounded cache.
+ *
+ * Variant of vlc_getaddrinfo_i11e() keeping recently resolved names in a
+ * small process-wide cache, so that repeated connections to the same host
+ * (e.g. streaming segment fetches) do not hit the resolver every time.
+ * Lookups that miss the cache are interruptible like vlc_getaddrinfo_i11e().
+ *
+ * @note The returned list is owned by the caller and must be released with
+ * vlc_freeaddrinfo(), <b>not</b> with freeaddrinfo().
+ */
+VLC_API int vlc_getaddrinfo_cached(const char *, unsigned,
+                                   const struct addrinfo *,
+                                   struct addrinfo **);
+
+/**
+ * Releases a list returned by vlc_getaddrinfo_cached().
+ */
+VLC_API void vlc_freeaddrinfo(struct addrinfo *);
+
 static inline bool
 net_SockAddrIsMulticast (const struct sockaddr *addr, socklen_t len)
 {
@@ -163,17 +163,15 @@ VLC_API struct vlc_tracer *vlc_object_get_tracer(vlc_object_t *obj);
 #define vlc_object_find_name(a,b) \
     vlc_object_find_name( VLC_OBJECT(a),b)
 
-VLC_USED
-static inline libvlc_int_t *vlc_object_instance(vlc_object_t *obj)
-{
-    vlc_object_t *parent;
-
-    do
-        parent = obj;
-    while ((obj = vlc_object_parent(obj)) != NULL);
-
-    return (libvlc_int_t *)parent;
-}
+/**
+ * Gets the LibVLC instance that an object belongs to.
+ *
+ * This is a constant-time operation: the root of the object tree is cached
+ * in each object when it is created.
+ *
+ * \return the root object of the tree the object belongs to
+ */
+VLC_API libvlc_int_t *vlc_object_instance(vlc_object_t *obj) VLC_USED;
 #define vlc_object_instance(o) vlc_object_instance(VLC_OBJECT(o))
 
 /* Here for backward compatibility. TODO: Move to <vlc_vout.h>! */
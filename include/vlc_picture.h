@@ -407,6 +407,66 @@ VLC_API void plane_CopyPixels( plane_t *p_dst, const plane_t *p_src );
  */
 VLC_API void picture_Copy( picture_t *p_dst, const picture_t *p_src );
 
+/**
+ * Pool of worker threads dedicated to plane copies.
+ *
+ * Copying a single high definition picture can exceed a frame interval, so
+ * the copier slices the planes in horizontal bands and hands them to a small
+ * set of persistent threads. The calling thread takes part in the copy, so a
+ * copier is always usable, even when no thread could be spawned.
+ */
+typedef struct vlc_plane_copier vlc_plane_copier_t;
+
+/**
+ * Creates a new plane copier.
+ *
+ * \param nb_workers number of copy workers, including the calling thread,
+ *                   0 to pick a sensible default from the CPU count
+ * \return a plane copier, or NULL on allocation error
+ */
+VLC_API vlc_plane_copier_t *vlc_plane_copier_New(unsigned nb_workers) VLC_USED;
+
+/**
+ * Deletes a plane copier.
+ *
+ * The copier must be idle (no vlc_plane_copier_Run() call in progress).
+ */
+VLC_API void vlc_plane_copier_Delete(vlc_plane_copier_t *copier);
+
+/**
+ * Returns the number of workers of the copier, including the calling thread.
+ */
+VLC_API unsigned vlc_plane_copier_GetWorkerCount(const vlc_plane_copier_t *);
+
+/**
+ * Runs a sliced work callback on every worker of the copier.
+ *
+ * The callback is invoked exactly once per worker, from the calling thread
+ * and from the copier threads, with a distinct slice index each. It returns
+ * once every invocation has completed.
+ *
+ * A copier runs a single job at a time: this function must not be called
+ * concurrently on the same copier.
+ *
+ * \param copier the plane copier
+ * \param work callback copying slice number slice out of count
+ * \param opaque user pointer passed back to the callback
+ */
+VLC_API void vlc_plane_copier_Run(vlc_plane_copier_t *copier,
+                                  void (*work)(void *opaque, unsigned slice,
+                                               unsigned count),
+                                  void *opaque);
+
+/**
+ * Multithreaded equivalent of picture_CopyPixels().
+ *
+ * Small pictures are copied in place; larger ones are sliced over the copier
+ * workers, one horizontal band of every plane per worker.
+ */
+VLC_API void vlc_plane_copier_CopyPixels(vlc_plane_copier_t *copier,
+                                         picture_t *p_dst,
+                                         const picture_t *p_src);
+
 /**
  * Perform a shallow picture copy
  *
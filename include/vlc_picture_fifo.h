@@ -42,6 +42,19 @@ typedef struct picture_fifo_t picture_fifo_t;
  */
 VLC_API picture_fifo_t * picture_fifo_New( void ) VLC_USED;
 
+/**
+ * It creates an empty lock-free picture_fifo_t for single-producer,
+ * single-consumer use.
+ *
+ * With this variant, picture_fifo_Push() must always be called from one
+ * thread (the producer) and picture_fifo_Pop() from one other thread
+ * (the consumer); neither ever blocks on the other side.
+ * picture_fifo_IsEmpty() may be called from any thread.
+ * picture_fifo_Flush() may be called from either side, provided the
+ * caller ensures it cannot run concurrently with the consumer.
+ */
+VLC_API picture_fifo_t * picture_fifo_NewSPSC( void ) VLC_USED;
+
 /**
  * It destroys a fifo created by picture_fifo_New.
  *
@@ -68,6 +68,27 @@ VLC_API picture_pool_t * picture_pool_New(unsigned count,
 VLC_API picture_pool_t * picture_pool_NewFromFormat(const video_format_t *fmt,
                                                     unsigned count) VLC_USED;
 
+/**
+ * Allocates pictures from the heap and creates a growable picture pool with
+ * them.
+ *
+ * Unlike picture_pool_NewFromFormat(), the pool can allocate further pictures
+ * on demand: when no picture is available, picture_pool_Get() and
+ * picture_pool_Wait() allocate an extra one, up to the max_count budget.
+ * Extra pictures are freed again as they come back to the pool, so that the
+ * pool shrinks back to count once the demand burst is over.
+ *
+ * @param fmt video format of pictures to allocate from the heap
+ * @param count number of pictures to allocate up front
+ * @param max_count maximum number of pictures the pool may grow to
+ *                  (no larger than count plus the picture budget)
+ *
+ * @return a pointer to the new pool on success, NULL on error
+ */
+VLC_API picture_pool_t * picture_pool_NewGrowable(const video_format_t *fmt,
+                                                  unsigned count,
+                                                  unsigned max_count) VLC_USED;
+
 /**
  * Releases a pool created by picture_pool_New()
  * or picture_pool_NewFromFormat().
@@ -127,6 +148,27 @@ VLC_USED;
  */
 unsigned picture_pool_GetSize(const picture_pool_t *);
 
+/**
+ * Retrieves the usage statistics of the given pool.
+ *
+ * The starvation counters are reset so that successive calls return the
+ * activity since the previous call.
+ *
+ * @param count [OUT] current number of allocated pictures
+ * @param in_use [OUT] number of pictures currently handed out
+ * @param starved [OUT] times a picture was requested while the pool was
+ *                      exhausted, since the previous call
+ * @param waited [OUT] total time spent blocked in picture_pool_Wait() since
+ *                     the previous call
+ *
+ * @note This function is thread-safe.
+ */
+VLC_API void picture_pool_GetResetStats(picture_pool_t *,
+                                        unsigned *restrict count,
+                                        unsigned *restrict in_use,
+                                        unsigned *restrict starved,
+                                        vlc_tick_t *restrict waited);
+
 
 #endif /* VLC_PICTURE_POOL_H */
 
@@ -777,6 +777,26 @@ vlc_player_JumpTime(vlc_player_t *player, vlc_tick_t jumptime)
                           VLC_PLAYER_WHENCE_RELATIVE);
 }
 
+/**
+ * Enable or disable scrub mode
+ *
+ * In scrub mode, the player assumes that seek requests come from an
+ * interactive jog or timeline drag. While a previous seek is still being
+ * resolved, further requests are not forwarded to the input: only the latest
+ * target is kept, and it is submitted once the input reports a new time.
+ * Each displayed frame then costs at most one decode from the previous
+ * keyframe, which keeps backward scrubbing as responsive as forward.
+ *
+ * Disabling scrub mode submits the last pending request, if any. Scrub mode
+ * does not otherwise alter the seek requests: pair it with
+ * VLC_PLAYER_SEEK_PRECISE for frame-accurate review.
+ *
+ * @param player locked player instance
+ * @param enabled true while the user is scrubbing
+ */
+VLC_API void
+vlc_player_SetScrubbing(vlc_player_t *player, bool enabled);
+
 /**
  * Display the player position on the vout OSD
  *
@@ -3376,6 +3396,30 @@ vlc_player_AddTimer(vlc_player_t *player, vlc_tick_t min_period,
                     const struct vlc_player_timer_cbs *cbs,
                     void *cbs_data);
 
+/**
+ * Add a timer delivering updates aligned with the video display
+ *
+ * Unlike vlc_player_AddTimer(), the updates are sent from the video output
+ * clock each time a frame is rendered, so the points match what is actually
+ * displayed. Use it for frame-accurate overlays or smooth seek bars: the
+ * delivered points can be extrapolated between two frames with
+ * vlc_player_timer_point_Interpolate(), which removes the need to poll the
+ * position at an arbitrary rate.
+ *
+ * No update is sent when the played media has no (selected) video track.
+ *
+ * @param player player instance (locked or not)
+ * @param cbs pointer to a vlc_player_timer_cbs structure, the structure must
+ * be valid during the lifetime of the player
+ * @param cbs_data opaque pointer used by the callbacks
+ * @return a valid vlc_player_timer_id or NULL in case of memory allocation
+ * error
+ */
+VLC_API vlc_player_timer_id *
+vlc_player_AddVideoDisplayTimer(vlc_player_t *player,
+                                const struct vlc_player_timer_cbs *cbs,
+                                void *cbs_data);
+
 /**
  * Add a smpte timer in order to get accurate video frame updates
  *
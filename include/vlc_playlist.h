@@ -490,6 +490,24 @@ vlc_playlist_AppendOne(vlc_playlist_t *playlist, input_item_t *media)
     return vlc_playlist_Append(playlist, &media, 1);
 }
 
+/**
+ * Add a list of media at their sorted positions.
+ *
+ * If the playlist has been sorted by vlc_playlist_Sort() (and its order has
+ * not been changed since, by a shuffle or a manual move), each media is
+ * inserted at the position matching the last sort criteria, found by binary
+ * search in O(log n) comparisons, so the whole playlist needs not be sorted
+ * again. Otherwise, the media are appended.
+ *
+ * \param playlist the playlist, locked
+ * \param media    the array of media to insert
+ * \param count    the number of media to insert
+ * \return VLC_SUCCESS on success, another value on error
+ */
+VLC_API int
+vlc_playlist_InsertSorted(vlc_playlist_t *playlist,
+                          input_item_t *const media[], size_t count);
+
 /**
  * Move a slice of items to a given target index.
  *
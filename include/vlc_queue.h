@@ -122,6 +122,18 @@ static inline void vlc_queue_Wait(vlc_queue_t *q)
     vlc_cond_wait(&q->wait, &q->lock);
 }
 
+/**
+ * Waits for a queue entry until a deadline.
+ *
+ * @param deadline deadline to wait until, as per vlc_cond_timedwait()
+ *
+ * @return 0 if the queue was signaled, ETIMEDOUT on time-out
+ */
+static inline int vlc_queue_TimedWait(vlc_queue_t *q, vlc_tick_t deadline)
+{
+    return vlc_cond_timedwait(&q->wait, &q->lock, deadline);
+}
+
 /**
  * Queues an entry (without locking).
  *
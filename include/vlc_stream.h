@@ -185,6 +185,10 @@ struct stream_t
      * Callback to fill an item node from a directory
      * (see doc/browsing.txt for details).
      *
+     * May return VLC_EAGAIN to deliver the entries read so far and request
+     * to be called again for the rest, so that very large directories or
+     * playlists are processed incrementally.
+     *
      * NULL if the stream is not a directory.
      */
     int         (*pf_readdir)(stream_t *, input_item_node_t *);
@@ -112,6 +112,54 @@ vlc_thumbnailer_RequestByPos( vlc_thumbnailer_t *thumbnailer,
                               input_item_t *input_item, vlc_tick_t timeout,
                               vlc_thumbnailer_cb cb, void* user_data );
 
+/**
+ * \brief vlc_thumbnailer_batch_cb defines a callback invoked per batch entry
+ *
+ * The callback is invoked exactly once for every entry of a submitted batch,
+ * in no particular order, including entries whose pipeline failed or whose
+ * deadline elapsed before they could run (thumbnail is then NULL).
+ * The picture, if any, is owned by the thumbnailer, and must be acquired by
+ * using \link picture_Hold \endlink to use it past the callback's scope.
+ *
+ * \param data The opaque pointer passed to vlc_thumbnailer_RequestBatch
+ * \param index The position of the entry in the submitted batch
+ * \param thumbnail The generated thumbnail, or NULL in case of failure
+ */
+typedef void(*vlc_thumbnailer_batch_cb)( void* data, size_t index,
+                                         picture_t* thumbnail );
+
+struct vlc_thumbnailer_batch_item
+{
+    input_item_t *item; /**< media to generate the thumbnail for */
+    vlc_tick_t time; /**< time at which the thumbnail should be taken */
+};
+
+/**
+ * \brief vlc_thumbnailer_RequestBatch Requests a batch of thumbnails
+ * \param thumbnailer A thumbnailer object
+ * \param items An array of (media, timestamp) entries
+ * \param count The number of entries
+ * \param speed The seeking speed \sa{enum vlc_thumbnailer_seek_speed}
+ * \param timeout A deadline for the whole batch counted from submission, or
+ *                VLC_TICK_INVALID to disable it
+ * \param cb A user callback invoked once per entry \sa{vlc_thumbnailer_batch_cb}
+ * \param user_data An opaque value, provided as cb's first parameter
+ * \return VLC_SUCCESS, or an error code if not all entries could be submitted
+ *
+ * Entries run on the thumbnailer's pipelines in parallel, all under the same
+ * deadline. Batch entries cannot be cancelled individually; submitted entries
+ * are guaranteed to invoke the callback even in case of error. The provided
+ * input items are held by the thumbnailer and can safely be released after
+ * calling this function.
+ */
+VLC_API int
+vlc_thumbnailer_RequestBatch( vlc_thumbnailer_t *thumbnailer,
+                              const struct vlc_thumbnailer_batch_item *items,
+                              size_t count,
+                              enum vlc_thumbnailer_seek_speed speed,
+                              vlc_tick_t timeout,
+                              vlc_thumbnailer_batch_cb cb, void* user_data );
+
 /**
  * \brief vlc_thumbnailer_DestroyRequest Destroy a thumbnail request
  * \param thumbnailer A thumbnailer object
@@ -128,6 +128,22 @@ VLC_API char *vlc_uri_compose(const vlc_url_t *) VLC_MALLOC;
  */
 VLC_API char *vlc_uri_resolve(const char *base, const char *ref) VLC_MALLOC;
 
+/**
+ * Resolves an URI reference against a parsed base URI.
+ *
+ * Variant of vlc_uri_resolve() taking an already parsed base URI, so that
+ * callers resolving many references against the same base (e.g. the segments
+ * of a playlist) do not have to reparse the base for every reference.
+ *
+ * \param base parsed base URI (\see vlc_UrlParse())
+ * \param ref URI reference (as a nul-terminated string)
+ *
+ * \return a heap-allocated nul-terminated string representing the resolved
+ * absolute URI, or NULL if out of memory.
+ */
+VLC_API char *vlc_uri_resolve_url(const vlc_url_t *base, const char *ref)
+VLC_MALLOC;
+
 /**
  * Fixes up a URI string.
  *
@@ -274,6 +274,28 @@ vlc_vector_growsize_(size_t value)
     ) \
 )
 
+/**
+ * Increase the capacity of the vector to `mincap` exactly.
+ *
+ * Unlike vlc_vector_reserve(), no growth policy is applied: the vector is
+ * reallocated to exactly the requested capacity. Use it when the final size
+ * is known up front (for example when mirroring another list), to avoid
+ * overshooting the allocation by the amortized growth factor.
+ *
+ * \param pv a pointer to the vector
+ * \param mincap (size_t) the requested capacity
+ * \retval true if no allocation failed
+ * \retval false on allocation failure (the vector is left untouched)
+ */
+#define vlc_vector_reserve_exact(pv, mincap) \
+( \
+    (mincap) <= (pv)->cap /* nothing to do */ || \
+    ( \
+        (mincap) <= vlc_vector_max_cap_(pv) /* not too big */ && \
+        vlc_vector_realloc_(pv, vlc_vector_enforce_size_t_(mincap)) \
+    ) \
+)
+
 /**
  * Resize the vector so that its capacity equals its actual size.
  *
@@ -319,6 +341,30 @@ vlc_vector_growsize_(size_t value)
     ) \
 )
 
+/**
+ * Append an uninitialized item at the end of the vector.
+ *
+ * On success, `*(pitem)` points to the new item, to be initialized in place
+ * by the caller. For struct payloads, this avoids building the item in a
+ * local variable only to copy it by assignment, as vlc_vector_push() would.
+ *
+ * The pointer is invalidated by any vector call that may reallocate.
+ *
+ * \param pv a pointer to the vector
+ * \param[out] pitem a pointer to the item pointer
+ * \retval true if no allocation failed
+ * \retval false on allocation failure (the vector is left untouched)
+ */
+#define vlc_vector_push_hole(pv, pitem) \
+( \
+    vlc_vector_check_same_ptr_type_((pv)->data, *(pitem)), \
+    vlc_vector_reserve(pv, (pv)->size + 1) && \
+    ( \
+        *(pitem) = &(pv)->data[(pv)->size++], \
+        true \
+    ) \
+)
+
 /**
  * Append `count` items at the end of the vector.
  *
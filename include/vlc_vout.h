@@ -121,6 +121,14 @@ VLC_API int vout_GetSnapshot( vout_thread_t *p_vout,
 /* */
 VLC_API void vout_PutPicture( vout_thread_t *, picture_t * );
 
+/**
+ * It gives to the vout a chain of pictures to be displayed, in order,
+ * waking up the vout thread only once for the whole batch.
+ *
+ * The chain is emptied and must not be used afterwards.
+ */
+VLC_API void vout_PutPictureChain( vout_thread_t *, vlc_picture_chain_t * );
+
 /* Subpictures channels ID */
 #define VOUT_SPU_CHANNEL_INVALID      (-1) /* Always fails in comparison */
 #define VOUT_SPU_CHANNEL_OSD            0 /* OSD channel is automatically cleared */
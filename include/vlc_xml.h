@@ -81,11 +81,32 @@ VLC_API xml_reader_t * xml_ReaderCreate(vlc_object_t *, stream_t *) VLC_USED;
 #define xml_ReaderCreate( a, s ) xml_ReaderCreate(VLC_OBJECT(a), s)
 VLC_API void xml_ReaderDelete(xml_reader_t *);
 
+/**
+ * Advances to the next node of the document.
+ *
+ * The node name or text is returned through \ref pval as a zero-copy
+ * reference into a buffer owned by the reader. It stays valid until the
+ * next call to this function; duplicate it to retain it longer.
+ *
+ * @param pval storage for the element name or text content [OUT]
+ * @return the node type, or XML_READER_NONE at the end of the document,
+ *         or XML_READER_ERROR on failure
+ */
 static inline int xml_ReaderNextNode( xml_reader_t *reader, const char **pval )
 {
     return reader->pf_next_node( reader, pval );
 }
 
+/**
+ * Gets the next attribute of the current element.
+ *
+ * As with xml_ReaderNextNode(), the name and value reference storage owned
+ * by the reader; they are only valid until the next call to this function
+ * or to xml_ReaderNextNode().
+ *
+ * @param pval storage for the attribute value [OUT]
+ * @return the attribute name, or NULL if there are no more attributes
+ */
 static inline const char *xml_ReaderNextAttr( xml_reader_t *reader,
                                               const char **pval )
 {
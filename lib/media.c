@@ -740,11 +740,25 @@ bool libvlc_media_get_stats(libvlc_media_t *p_md,
 
     p_stats->i_decoded_video = p_itm_stats->i_decoded_video;
     p_stats->i_decoded_audio = p_itm_stats->i_decoded_audio;
+    p_stats->f_video_es_bitrate = p_itm_stats->f_video_es_bitrate;
+    p_stats->f_audio_es_bitrate = p_itm_stats->f_audio_es_bitrate;
+    p_stats->i_decoder_queue_depth = p_itm_stats->i_decoder_queue_depth;
 
     p_stats->i_displayed_pictures = p_itm_stats->i_displayed_pictures;
     p_stats->i_late_pictures = p_itm_stats->i_late_pictures;
     p_stats->i_lost_pictures = p_itm_stats->i_lost_pictures;
 
+    p_stats->i_display_latency_samples = p_itm_stats->i_display_latency_samples;
+    p_stats->i_display_latency_avg_us = p_itm_stats->i_display_latency_samples > 0
+        ? US_FROM_VLC_TICK( p_itm_stats->i_display_latency_sum
+                            / p_itm_stats->i_display_latency_samples )
+        : 0;
+    static_assert( ARRAY_SIZE( p_stats->i_display_latency_histogram )
+                   == INPUT_STATS_LATENCY_BUCKETS, "histogram size mismatch" );
+    for( size_t i = 0; i < INPUT_STATS_LATENCY_BUCKETS; i++ )
+        p_stats->i_display_latency_histogram[i] =
+            p_itm_stats->i_display_latency_histogram[i];
+
     p_stats->i_played_abuffers = p_itm_stats->i_played_abuffers;
     p_stats->i_lost_abuffers = p_itm_stats->i_lost_abuffers;
 
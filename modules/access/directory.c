@@ -31,21 +31,42 @@
 #endif
 
 #include <limits.h>
+#include <stdatomic.h>
 #include <sys/stat.h>
 
 #include <vlc_common.h>
 #include "fs.h"
 #include <vlc_access.h>
 #include <vlc_input_item.h>
+#include <vlc_list.h>
 
 #include <vlc_fs.h>
 #include <vlc_url.h>
 
+/* A directory entry read ahead by the enumeration thread */
+struct dir_entry
+{
+    struct vlc_list node;
+    struct stat st;
+    char name[];
+};
+
 typedef struct
 {
     char *base_uri;
     bool need_separator;
     vlc_DIR *dir;
+
+    /* Enumeration runs ahead of the reader on its own thread, so the
+     * readdir()/stat() system calls overlap with item creation and do not
+     * serialize on the input thread. */
+    bool scanning;
+    vlc_thread_t thread;
+    atomic_bool abort;
+    vlc_mutex_t lock;
+    vlc_cond_t wait;
+    struct vlc_list entries; /**< protected by lock */
+    bool eof; /**< protected by lock */
 } access_sys_t;
 
 static int DirRead (stream_t *access, input_item_node_t *node);
@@ -64,6 +85,63 @@ static int DirControl( stream_t *p_access, int i_query, va_list args )
     }
 }
 
+static struct dir_entry *ReadEntry(stream_t *access)
+{
+    access_sys_t *sys = access->p_sys;
+    const char *entry;
+
+    while ((entry = vlc_readdir(sys->dir)) != NULL)
+    {
+        struct stat st;
+
+#ifdef HAVE_FSTATAT
+        if (fstatat(dirfd(sys->dir), entry, &st, 0))
+            continue;
+#else
+        char *path;
+        int val;
+
+        if (asprintf(&path, "%s"DIR_SEP"%s", access->psz_filepath, entry) == -1
+         || (val = vlc_stat(path, &st), free(path), val))
+            continue;
+#endif
+        struct dir_entry *e = malloc(sizeof (*e) + strlen(entry) + 1);
+        if (unlikely(e == NULL))
+            continue;
+
+        e->st = st;
+        strcpy(e->name, entry);
+        return e;
+    }
+    return NULL;
+}
+
+static void *Thread(void *data)
+{
+    stream_t *access = data;
+    access_sys_t *sys = access->p_sys;
+
+    vlc_thread_set_name("vlc-dir-scan");
+
+    while (!atomic_load_explicit(&sys->abort, memory_order_relaxed))
+    {
+        struct dir_entry *entry = ReadEntry(access);
+        if (entry == NULL)
+            break;
+
+        vlc_mutex_lock(&sys->lock);
+        vlc_list_append(&entry->node, &sys->entries);
+        vlc_cond_signal(&sys->wait);
+        vlc_mutex_unlock(&sys->lock);
+    }
+
+    vlc_mutex_lock(&sys->lock);
+    sys->eof = true;
+    vlc_cond_signal(&sys->wait);
+    vlc_mutex_unlock(&sys->lock);
+    return NULL;
+}
+
 /*****************************************************************************
  * DirInit: Init the directory access with a directory stream
  *****************************************************************************/
@@ -92,9 +170,18 @@ int DirInit (stream_t *access, vlc_DIR *dir)
             last_char != '/';
     sys->dir = dir;
 
+    atomic_init(&sys->abort, false);
+    vlc_mutex_init(&sys->lock);
+    vlc_cond_init(&sys->wait);
+    vlc_list_init(&sys->entries);
+    sys->eof = false;
+
     access->p_sys = sys;
     access->pf_readdir = DirRead;
     access->pf_control = DirControl;
+
+    /* On failure, fall back to enumerating synchronously in DirRead() */
+    sys->scanning = vlc_clone(&sys->thread, Thread, access) == VLC_SUCCESS;
     return VLC_SUCCESS;
 
 error:
@@ -127,14 +214,88 @@ void DirClose(vlc_object_t *obj)
     stream_t *access = (stream_t *)obj;
     access_sys_t *sys = access->p_sys;
 
+    if (sys->scanning)
+    {
+        atomic_store_explicit(&sys->abort, true, memory_order_relaxed);
+        vlc_join(sys->thread, NULL);
+    }
+
+    struct dir_entry *entry;
+    vlc_list_foreach (entry, &sys->entries, node)
+        free(entry);
+
     free(sys->base_uri);
     vlc_closedir(sys->dir);
 }
 
+static int AddEntry(stream_t *access, struct vlc_readdir_helper *rdh,
+                    const struct dir_entry *entry, bool special_files)
+{
+    access_sys_t *sys = access->p_sys;
+    int type;
+
+    switch (entry->st.st_mode & S_IFMT)
+    {
+#ifdef S_IFBLK
+        case S_IFBLK:
+            if (!special_files)
+                return VLC_SUCCESS;
+            type = ITEM_TYPE_DISC;
+            break;
+#endif
+        case S_IFCHR:
+            if (!special_files)
+                return VLC_SUCCESS;
+            type = ITEM_TYPE_CARD;
+            break;
+        case S_IFIFO:
+            if (!special_files)
+                return VLC_SUCCESS;
+            type = ITEM_TYPE_STREAM;
+            break;
+        case S_IFREG:
+            type = ITEM_TYPE_FILE;
+            break;
+        case S_IFDIR:
+            type = ITEM_TYPE_DIRECTORY;
+            break;
+        /* S_IFLNK cannot occur while following symbolic links */
+        /* S_IFSOCK cannot be opened with open()/openat() */
+        default:
+            return VLC_SUCCESS; /* ignore */
+    }
+
+    /* Create an input item for the current entry */
+    char *encoded = vlc_uri_encode(entry->name);
+    if (unlikely(encoded == NULL))
+        return VLC_ENOMEM;
+
+    char *uri;
+    if (unlikely(asprintf(&uri, "%s%s%s", sys->base_uri,
+                          sys->need_separator ? "/" : "",
+                          encoded) == -1))
+        uri = NULL;
+    free(encoded);
+    if (unlikely(uri == NULL))
+        return VLC_ENOMEM;
+
+    input_item_t *p_item;
+    int ret = vlc_readdir_helper_additem(rdh, uri, NULL, entry->name, type,
+                                         ITEM_NET_UNKNOWN, &p_item);
+
+    if (ret == VLC_SUCCESS && p_item
+     && entry->st.st_mtime >= 0 && entry->st.st_size >= 0)
+    {
+        input_item_AddStat( p_item, "mtime", entry->st.st_mtime );
+        input_item_AddStat( p_item, "size", entry->st.st_size );
+    }
+    free(uri);
+    return ret;
+}
+
 static int DirRead (stream_t *access, input_item_node_t *node)
 {
     access_sys_t *sys = access->p_sys;
-    const char *entry;
     int ret = VLC_SUCCESS;
 
     bool special_files = var_InheritBool(access, "list-special-files");
@@ -142,81 +303,29 @@ static int DirRead (stream_t *access, input_item_node_t *node)
     struct vlc_readdir_helper rdh;
     vlc_readdir_helper_init(&rdh, access, node);
 
-    while (ret == VLC_SUCCESS && (entry = vlc_readdir(sys->dir)) != NULL)
+    while (ret == VLC_SUCCESS)
     {
-        struct stat st;
-        int type;
+        struct dir_entry *entry;
 
-#ifdef HAVE_FSTATAT
-        if (fstatat(dirfd(sys->dir), entry, &st, 0))
-            continue;
-#else
-        char *path;
-
-        if (asprintf(&path, "%s"DIR_SEP"%s", access->psz_filepath, entry) == -1
-         || (type = vlc_stat(path, &st), free(path), type))
-            continue;
-#endif
-        switch (st.st_mode & S_IFMT)
+        if (sys->scanning)
         {
-#ifdef S_IFBLK
-            case S_IFBLK:
-                if (!special_files)
-                    continue;
-                type = ITEM_TYPE_DISC;
-                break;
-#endif
-            case S_IFCHR:
-                if (!special_files)
-                    continue;
-                type = ITEM_TYPE_CARD;
-                break;
-            case S_IFIFO:
-                if (!special_files)
-                    continue;
-                type = ITEM_TYPE_STREAM;
-                break;
-            case S_IFREG:
-                type = ITEM_TYPE_FILE;
-                break;
-            case S_IFDIR:
-                type = ITEM_TYPE_DIRECTORY;
-                break;
-            /* S_IFLNK cannot occur while following symbolic links */
-            /* S_IFSOCK cannot be opened with open()/openat() */
-            default:
-                continue; /* ignore */
-        }
-
-        /* Create an input item for the current entry */
-        char *encoded = vlc_uri_encode(entry);
-        if (unlikely(encoded == NULL))
-        {
-            ret = VLC_ENOMEM;
-            break;
+            vlc_mutex_lock(&sys->lock);
+            while ((entry = vlc_list_first_entry_or_null(&sys->entries,
+                                       struct dir_entry, node)) == NULL
+                && !sys->eof)
+                vlc_cond_wait(&sys->wait, &sys->lock);
+            if (entry != NULL)
+                vlc_list_remove(&entry->node);
+            vlc_mutex_unlock(&sys->lock);
         }
+        else
+            entry = ReadEntry(access);
 
-        char *uri;
-        if (unlikely(asprintf(&uri, "%s%s%s", sys->base_uri,
-                              sys->need_separator ? "/" : "",
-                              encoded) == -1))
-            uri = NULL;
-        free(encoded);
-        if (unlikely(uri == NULL))
-        {
-            ret = VLC_ENOMEM;
+        if (entry == NULL)
             break;
-        }
-        input_item_t *p_item;
-        ret = vlc_readdir_helper_additem(&rdh, uri, NULL, entry, type,
-                                         ITEM_NET_UNKNOWN, &p_item);
 
-        if (ret == VLC_SUCCESS && p_item && st.st_mtime >= 0 && st.st_size >= 0)
-        {
-            input_item_AddStat( p_item, "mtime", st.st_mtime );
-            input_item_AddStat( p_item, "size", st.st_size );
-        }
-        free(uri);
+        ret = AddEntry(access, &rdh, entry, special_files);
+        free(entry);
     }
 
     vlc_readdir_helper_finish(&rdh, ret == VLC_SUCCESS);
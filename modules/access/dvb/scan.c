@@ -33,6 +33,8 @@
 #include <vlc_block.h>
 #include <vlc_dialog.h>
 #include <vlc_charset.h>
+#include <vlc_configuration.h>
+#include <vlc_fs.h>
 
 #include <sys/types.h>
 
@@ -107,6 +109,7 @@ struct scan_multiplex_t
 
     uint8_t i_nit_version;
     uint8_t i_sdt_version;
+    bool b_from_cache; /* seeded from the tuning cache, not yet confirmed */
 };
 
 typedef struct
@@ -116,6 +119,8 @@ typedef struct
     unsigned i_index;
 } scan_enumeration_t;
 
+typedef struct scan_session_t scan_session_t;
+
 struct scan_t
 {
     vlc_object_t *p_obj;
@@ -142,9 +147,13 @@ struct scan_t
     const scan_list_entry_t *p_current;
 
     scan_enumeration_t spectrum;
+
+    /* Tables of the last read multiplex, parsed while the frontend locks
+     * on the next one */
+    scan_session_t    *p_session_prev;
 };
 
-typedef struct
+struct scan_session_t
 {
     vlc_object_t *p_obj;
 
@@ -173,13 +182,16 @@ typedef struct
     dvbpsi_t *p_pathandle;
     dvbpsi_t *p_sdthandle;
     dvbpsi_t *p_nithandle;
-} scan_session_t;
+};
 
 static scan_session_t * scan_session_New( scan_t *p_scan, const scan_tuner_config_t *p_cfg );
 static void scan_session_Destroy( scan_t *p_scan, scan_session_t *p_session );
 static bool scan_session_Push( scan_session_t *p_scan, const uint8_t *p_packet );
 static unsigned scan_session_GetTablesTimeout( const scan_session_t *p_session );
 
+static void scan_CacheLoad( scan_t *p_scan );
+static void scan_CacheSave( const scan_t *p_scan );
+
 /* */
 static void scan_tuner_config_Init( scan_tuner_config_t *p_cfg, const scan_parameter_t *p_params )
 {
@@ -281,6 +293,7 @@ static scan_multiplex_t *scan_multiplex_New( const scan_tuner_config_t *p_cfg, u
         p_mplex->i_sdt_version = UINT8_MAX;
         p_mplex->i_snr = -1;
         p_mplex->b_scanned = false;
+        p_mplex->b_from_cache = false;
     }
     return p_mplex;
 }
@@ -427,11 +440,14 @@ scan_t *scan_New( vlc_object_t *p_obj, const scan_parameter_t *p_parameter,
 
     scan_Prepare( p_obj, p_parameter, p_scan );
     p_scan->p_current = p_scan->p_scanlist;
+    p_scan->p_session_prev = NULL;
 
     p_scan->spectrum.i_index = 0;
     p_scan->spectrum.i_symbolrate_index = 0;
     p_scan->spectrum.modulation = 0;
 
+    scan_CacheLoad( p_scan );
+
     scan_Debug_Parameters( p_obj, p_parameter );
 
     return p_scan;
@@ -441,9 +457,13 @@ void scan_Destroy( scan_t *p_scan )
 {
     if( !p_scan )
         return;
+    if( p_scan->p_session_prev )
+        scan_session_Destroy( p_scan, p_scan->p_session_prev );
     if( p_scan->p_dialog_id != NULL )
         vlc_dialog_release( p_scan->p_obj, p_scan->p_dialog_id );
 
+    scan_CacheSave( p_scan );
+
     scan_parameter_Clean( &p_scan->parameter );
 
     for( size_t i = 0; i < p_scan->i_multiplex; i++ )
@@ -515,6 +535,120 @@ static size_t scan_CountServices( const scan_t *p_scan )
     return i_total_services;
 }
 
+/*
+ * Persistent tuning cache. Transponders found by an earlier scan are stored
+ * with their exact tuning parameters, so the next scan locks them directly
+ * instead of rediscovering them through the band sweep.
+ */
+static char *scan_CachePath( void )
+{
+    char *psz_dir = config_GetUserDir( VLC_CACHE_DIR );
+    if( psz_dir == NULL )
+        return NULL;
+    char *psz_path;
+    if( asprintf( &psz_path, "%s"DIR_SEP"dvb-scan.cache", psz_dir ) == -1 )
+        psz_path = NULL;
+    free( psz_dir );
+    return psz_path;
+}
+
+static void scan_CacheLoad( scan_t *p_scan )
+{
+    char *psz_path = scan_CachePath();
+    if( psz_path == NULL )
+        return;
+    FILE *p_file = vlc_fopen( psz_path, "rt" );
+    free( psz_path );
+    if( p_file == NULL )
+        return;
+
+    char psz_line[256];
+    size_t i_loaded = 0;
+    while( fgets( psz_line, sizeof(psz_line), p_file ) )
+    {
+        int i_type, i_delivery, i_modulation, i_hp, i_lp, i_fec, i_pol;
+        unsigned i_frequency, i_bandwidth, i_network_id, i_ts_id;
+        if( sscanf( psz_line, "%d %u %u %d %d %d %d %d %d %u %u",
+                    &i_type, &i_frequency, &i_bandwidth, &i_delivery,
+                    &i_modulation, &i_hp, &i_lp, &i_fec, &i_pol,
+                    &i_network_id, &i_ts_id ) != 11 )
+            continue;
+        if( i_type != (int) p_scan->parameter.type || i_frequency == 0 ||
+            scan_FindMultiplex( p_scan, i_ts_id ) != NULL )
+            continue;
+
+        scan_tuner_config_t cfg;
+        scan_tuner_config_Init( &cfg, &p_scan->parameter );
+        cfg.i_frequency = i_frequency;
+        cfg.i_bandwidth = i_bandwidth;
+        cfg.delivery = i_delivery;
+        cfg.modulation = i_modulation;
+        cfg.coderate_hp = i_hp;
+        cfg.coderate_lp = i_lp;
+        cfg.inner_fec = i_fec;
+        cfg.polarization = i_pol;
+
+        scan_multiplex_t *p_mplex = scan_multiplex_New( &cfg, i_ts_id );
+        if( unlikely(p_mplex == NULL) )
+            break;
+        p_mplex->i_network_id = i_network_id;
+        p_mplex->b_from_cache = true;
+        if( unlikely(!scan_AddMultiplex( p_scan, p_mplex )) )
+        {
+            scan_multiplex_Delete( p_mplex );
+            break;
+        }
+        i_loaded++;
+    }
+    fclose( p_file );
+
+    if( i_loaded )
+        msg_Dbg( p_scan->p_obj, "tuning cache: %zu known multiplexes",
+                 i_loaded );
+}
+
+static void scan_CacheSave( const scan_t *p_scan )
+{
+    char *psz_path = scan_CachePath();
+    if( psz_path == NULL )
+        return;
+    FILE *p_file = vlc_fopen( psz_path, "wt" );
+    free( psz_path );
+    if( p_file == NULL )
+        return;
+
+    fputs( "# VLC DVB tuning cache\n", p_file );
+    for( size_t i = 0; i < p_scan->i_multiplex; i++ )
+    {
+        const scan_multiplex_t *p_mplex = p_scan->pp_multiplex[i];
+        /* Keep confirmed transponders and the cached ones this run did not
+         * get to; drop cached entries that no longer lock or carry nothing */
+        if( p_mplex->i_services == 0 &&
+            !( p_mplex->b_from_cache && !p_mplex->b_scanned ) )
+            continue;
+        fprintf( p_file, "%d %u %u %d %d %d %d %d %d %u %u\n",
+                 (int) p_mplex->cfg.type, p_mplex->cfg.i_frequency,
+                 p_mplex->cfg.i_bandwidth, (int) p_mplex->cfg.delivery,
+                 (int) p_mplex->cfg.modulation,
+                 (int) p_mplex->cfg.coderate_hp,
+                 (int) p_mplex->cfg.coderate_lp,
+                 (int) p_mplex->cfg.inner_fec,
+                 (int) p_mplex->cfg.polarization,
+                 (unsigned) p_mplex->i_network_id,
+                 (unsigned) p_mplex->i_ts_id );
+    }
+    fclose( p_file );
+}
+
+/** Multiplexes learned from this spectrum, excluding unconfirmed cache seeds */
+static size_t scan_CountDiscoveredMultiplexes( const scan_t *p_scan )
+{
+    size_t i_count = 0;
+    for( size_t i = 0; i < p_scan->i_multiplex; i++ )
+        i_count += !p_scan->pp_multiplex[i]->b_from_cache;
+    return i_count;
+}
+
 static int Scan_Next_DVB_SpectrumExhaustive( const scan_parameter_t *p_params, scan_enumeration_t *p_spectrum,
                                              scan_tuner_config_t *p_cfg, double *pf_pos )
 {
@@ -767,8 +901,22 @@ static int Scan_GetNextTunerConfig( scan_t *p_scan, scan_tuner_config_t *p_cfg,
         return VLC_SUCCESS;
     }
 
+    /* Known transponders from the tuning cache first: they lock with exact
+     * parameters, ahead of the band sweep */
+    for( size_t i=0; i<p_scan->i_multiplex; i++ )
+    {
+        scan_multiplex_t *p_mplex = p_scan->pp_multiplex[i];
+        if( p_mplex->b_from_cache && !p_mplex->b_scanned )
+        {
+            *p_cfg = p_mplex->cfg;
+            *pf_pos = (double) 1.0 - (p_scan->i_multiplex / p_scan->i_multiplex_toscan);
+            scan_SetMultiplexScanStatus( p_scan, p_mplex, true );
+            return VLC_SUCCESS;
+        }
+    }
+
     if( p_scan->p_scanlist == NULL &&
-        ( p_scan->i_multiplex == 0 || /* Stop frequency scanning if we've found a valid NIT */
+        ( scan_CountDiscoveredMultiplexes( p_scan ) == 0 || /* Stop frequency scanning if we've found a valid NIT */
          (p_scan->parameter.b_use_nit && !p_scan->b_multiplexes_from_nit) ) )
     {
         int i_ret = Scan_GetNextSpectrumTunerConfig( p_scan, p_cfg, pf_pos );
@@ -853,7 +1001,15 @@ int scan_Run( scan_t *p_scan )
 {
     scan_tuner_config_t cfg;
     if( scan_Next( p_scan, &cfg ) )
-        return VLC_ENOENT;
+    {
+        /* The pending tables may still hold unseen NIT multiplexes */
+        if( p_scan->p_session_prev == NULL )
+            return VLC_ENOENT;
+        scan_session_Destroy( p_scan, p_scan->p_session_prev );
+        p_scan->p_session_prev = NULL;
+        if( scan_Next( p_scan, &cfg ) )
+            return VLC_ENOENT;
+    }
 
     scan_session_t *session = scan_session_New( p_scan, &cfg );
     if( unlikely(session == NULL) )
@@ -865,6 +1021,14 @@ int scan_Run( scan_t *p_scan )
         return VLC_EGENERIC;
     }
 
+    /* The frontend is now acquiring its lock: fold the tables collected on
+     * the previous multiplex in the meantime instead of serializing both */
+    if( p_scan->p_session_prev )
+    {
+        scan_session_Destroy( p_scan, p_scan->p_session_prev );
+        p_scan->p_session_prev = NULL;
+    }
+
     p_scan->pf_filter( p_scan, p_scan->p_cbdata, PSI_PAT_PID, true );
     p_scan->pf_filter( p_scan, p_scan->p_cbdata, SI_SDT_PID, true );
     if( p_scan->parameter.b_use_nit )
@@ -901,7 +1065,9 @@ int scan_Run( scan_t *p_scan )
         }
     }
 
-    scan_session_Destroy( p_scan, session );
+    /* Keep the collected tables for parsing during the next lock wait
+     * (scan_Destroy flushes the last one) */
+    p_scan->p_session_prev = session;
 
     return VLC_SUCCESS;
 }
@@ -959,6 +1125,7 @@ static void ParsePAT( vlc_object_t *p_obj, scan_t *p_scan,
     scan_multiplex_t *p_mplex = scan_FindOrCreateMultiplex( p_scan, p_pat->i_ts_id, p_cfg );
     if( unlikely(p_mplex == NULL) )
         return;
+    p_mplex->b_from_cache = false; /* confirmed on air */
 
     if( p_mplex->i_snr > 0 && i_snr > p_mplex->i_snr )
     {
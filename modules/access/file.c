@@ -50,6 +50,9 @@
 #else
 #   include <unistd.h>
 #endif
+#ifdef HAVE_MMAP
+#   include <sys/mman.h>
+#endif
 
 #include <vlc_common.h>
 #include "fs.h"
@@ -57,6 +60,7 @@
 #ifdef _WIN32
 # include <vlc_charset.h>
 #endif
+#include <vlc_block.h>
 #include <vlc_fs.h>
 #include <vlc_url.h>
 #include <vlc_interrupt.h>
@@ -66,6 +70,12 @@ typedef struct
     int fd;
 
     bool b_pace_control;
+
+#ifdef HAVE_MMAP
+    /* Memory-mapped mode (see MmapBlock()) */
+    uint64_t size;
+    uint64_t offset;
+#endif
 } access_sys_t;
 
 #if !defined (_WIN32) && !defined (__OS2__)
@@ -168,6 +178,10 @@ static bool IsRemote (const char *path)
 static ssize_t Read (stream_t *, void *, size_t);
 static int FileSeek (stream_t *, uint64_t);
 static int FileControl (stream_t *, int, va_list);
+#ifdef HAVE_MMAP
+static block_t *MmapBlock (stream_t *, bool *);
+static int MmapSeek (stream_t *, uint64_t);
+#endif
 
 /*****************************************************************************
  * FileOpen: open the file
@@ -258,6 +272,21 @@ int FileOpen( vlc_object_t *p_this )
         p_access->pf_seek = FileSeek;
         p_sys->b_pace_control = true;
 
+#ifdef HAVE_MMAP
+        /* Opt-in zero-copy mode: demuxers get blocks wrapping mapped file
+         * regions rather than copies of them. */
+        if (S_ISREG (st.st_mode) && st.st_size > 0
+         && var_InheritBool (p_access, "file-mmap"))
+        {
+            p_sys->size = st.st_size;
+            p_sys->offset = 0;
+            p_access->pf_read = NULL;
+            p_access->pf_block = MmapBlock;
+            p_access->pf_seek = MmapSeek;
+            return VLC_SUCCESS;
+        }
+#endif
+
         /* Demuxers will need the beginning of the file for probing. */
         posix_fadvise (fd, 0, 4096, POSIX_FADV_WILLNEED);
         /* In most cases, we only read the file once. */
@@ -292,7 +321,7 @@ void FileClose (vlc_object_t * p_this)
 {
     stream_t     *p_access = (stream_t*)p_this;
 
-    if (p_access->pf_read == NULL)
+    if (p_access->pf_read == NULL && p_access->pf_block == NULL)
     {
         DirClose (p_this);
         return;
@@ -326,6 +355,66 @@ static ssize_t Read (stream_t *p_access, void *p_buffer, size_t i_len)
     return val;
 }
 
+#ifdef HAVE_MMAP
+/* Size of each mapping handed out as a block. Large enough to amortize the
+ * mmap/munmap system calls and page faults, small enough to keep resident
+ * memory bounded while playing huge files. */
+#define MMAP_CHUNK (8 * 1024 * 1024)
+
+static block_t *MmapBlock (stream_t *p_access, bool *restrict eof)
+{
+    access_sys_t *p_sys = p_access->p_sys;
+    const uint64_t pagemask = sysconf (_SC_PAGE_SIZE) - 1;
+
+    if (p_sys->offset >= p_sys->size)
+    {
+        *eof = true;
+        return NULL;
+    }
+
+    /* Map from a page boundary, then trim the block to the current offset */
+    uint64_t base = p_sys->offset & ~pagemask;
+    size_t length = MMAP_CHUNK;
+
+    if (length > p_sys->size - base)
+        length = p_sys->size - base;
+
+    void *addr = mmap (NULL, length, PROT_READ, MAP_SHARED, p_sys->fd, base);
+    if (addr == MAP_FAILED)
+    {
+        msg_Err (p_access, "cannot map file (%s)", vlc_strerror_c(errno));
+        *eof = true;
+        return NULL;
+    }
+
+    /* We only read the mapping once, in playback order. */
+    madvise (addr, length, MADV_SEQUENTIAL);
+    madvise (addr, length, MADV_WILLNEED);
+
+    block_t *block = block_mmap_Alloc (addr, length);
+    if (unlikely(block == NULL))
+    {
+        munmap (addr, length);
+        *eof = true;
+        return NULL;
+    }
+
+    size_t skip = p_sys->offset - base;
+    block->p_buffer += skip;
+    block->i_buffer -= skip;
+    p_sys->offset = base + length;
+    return block;
+}
+
+static int MmapSeek (stream_t *p_access, uint64_t i_pos)
+{
+    access_sys_t *p_sys = p_access->p_sys;
+
+    p_sys->offset = (i_pos <= p_sys->size) ? i_pos : p_sys->size;
+    return VLC_SUCCESS;
+}
+#endif /* HAVE_MMAP */
+
 /*****************************************************************************
  * Seek: seek to a specific location in a file
  *****************************************************************************/
@@ -37,6 +37,11 @@ vlc_module_begin ()
     set_capability( "access", 50 )
     add_shortcut( "file", "fd", "stream" )
     set_callbacks( FileOpen, FileClose )
+#ifdef HAVE_MMAP
+    add_bool( "file-mmap", false, N_("Memory-mapped reads"),
+              N_("Read regular files through zero-copy memory mappings "
+                 "instead of buffered read copies") )
+#endif
 
     add_submodule()
     set_section( N_("Directory" ), NULL )
@@ -23,7 +23,10 @@
 #endif
 
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
 #include <vlc_common.h>
+#include <vlc_list.h>
 #include <vlc_network.h>
 #include <vlc_tls.h>
 #include <vlc_url.h>
@@ -96,50 +99,124 @@ static char *vlc_http_proxy_find(const char *hostname, unsigned port,
 }
 
 
+/* Maximum number of connections kept alive per manager */
+#define VLC_HTTP_MGR_POOL_SIZE 4
+/* Delay after which an unused connection is closed */
+#define VLC_HTTP_MGR_IDLE_TIMEOUT VLC_TICK_FROM_SEC(30)
+
+struct vlc_http_mgr_conn
+{
+    struct vlc_list node;
+    struct vlc_http_conn *conn;
+    char *host;
+    unsigned port;
+    bool https;
+    vlc_tick_t used; /* last time a request was issued on this connection */
+};
+
 struct vlc_http_mgr
 {
     struct vlc_logger *logger;
     vlc_object_t *obj;
     vlc_tls_client_t *creds;
     struct vlc_http_cookie_jar_t *jar;
-    struct vlc_http_conn *conn;
+    struct vlc_list conns; /* most recently used first */
+    unsigned conn_count;
 };
 
-static struct vlc_http_conn *vlc_http_mgr_find(struct vlc_http_mgr *mgr,
-                                               const char *host, unsigned port)
+static void vlc_http_mgr_release(struct vlc_http_mgr *mgr,
+                                 struct vlc_http_mgr_conn *entry)
 {
-    (void) host; (void) port;
-    return mgr->conn;
+    assert(mgr->conn_count > 0);
+    mgr->conn_count--;
+    vlc_list_remove(&entry->node);
+
+    vlc_http_conn_release(entry->conn);
+    free(entry->host);
+    free(entry);
 }
 
-static void vlc_http_mgr_release(struct vlc_http_mgr *mgr,
-                                 struct vlc_http_conn *conn)
+static struct vlc_http_mgr_conn *
+vlc_http_mgr_find(struct vlc_http_mgr *mgr, const char *host, unsigned port,
+                  bool https)
+{
+    struct vlc_http_mgr_conn *entry, *found = NULL;
+    vlc_tick_t now = vlc_tick_now();
+
+    vlc_list_foreach(entry, &mgr->conns, node)
+    {
+        if (found == NULL && entry->https == https && entry->port == port
+         && strcasecmp(entry->host, host) == 0)
+        {
+            found = entry;
+            continue;
+        }
+        /* Prune other connections that sat idle for too long */
+        if (now - entry->used >= VLC_HTTP_MGR_IDLE_TIMEOUT)
+            vlc_http_mgr_release(mgr, entry);
+    }
+    return found;
+}
+
+static void vlc_http_mgr_insert(struct vlc_http_mgr *mgr,
+                                struct vlc_http_conn *conn, const char *host,
+                                unsigned port, bool https)
 {
-    assert(mgr->conn == conn);
-    mgr->conn = NULL;
+    struct vlc_http_mgr_conn *entry = malloc(sizeof (*entry));
+    char *dup = strdup(host);
+
+    if (unlikely(entry == NULL || dup == NULL))
+    {   /* Cannot pool the connection; it will simply not be reused. */
+        free(dup);
+        free(entry);
+        vlc_http_conn_release(conn);
+        return;
+    }
 
-    vlc_http_conn_release(conn);
+    entry->conn = conn;
+    entry->host = dup;
+    entry->port = port;
+    entry->https = https;
+    entry->used = vlc_tick_now();
+    vlc_list_prepend(&entry->node, &mgr->conns);
+
+    if (++mgr->conn_count > VLC_HTTP_MGR_POOL_SIZE)
+    {   /* Evict the least recently used connection */
+        struct vlc_http_mgr_conn *last =
+            vlc_list_last_entry_or_null(&mgr->conns,
+                                        struct vlc_http_mgr_conn, node);
+        vlc_http_mgr_release(mgr, last);
+    }
 }
 
 static
 struct vlc_http_msg *vlc_http_mgr_reuse(struct vlc_http_mgr *mgr,
                                         const char *host, unsigned port,
+                                        bool https,
                                         const struct vlc_http_msg *req,
                                         bool payload)
 {
-    struct vlc_http_conn *conn = vlc_http_mgr_find(mgr, host, port);
-    if (conn == NULL)
+    struct vlc_http_mgr_conn *entry = vlc_http_mgr_find(mgr, host, port,
+                                                        https);
+    if (entry == NULL)
         return NULL;
 
-    struct vlc_http_stream *stream = vlc_http_stream_open(conn, req, payload);
+    struct vlc_http_stream *stream = vlc_http_stream_open(entry->conn, req,
+                                                          payload);
     if (stream != NULL)
     {
         struct vlc_http_msg *m = vlc_http_msg_get_initial(stream);
         if (m != NULL)
+        {
+            entry->used = vlc_tick_now();
+            /* most recently used first */
+            vlc_list_remove(&entry->node);
+            vlc_list_prepend(&entry->node, &mgr->conns);
             return m;
+        }
     }
     /* Get rid of closing or reset connection */
-    vlc_http_mgr_release(mgr, conn);
+    vlc_http_mgr_release(mgr, entry);
     return NULL;
 }
 
@@ -151,9 +228,6 @@ static struct vlc_http_msg *vlc_https_request(struct vlc_http_mgr *mgr,
     vlc_tls_t *tls;
     bool http2 = true;
 
-    if (mgr->creds == NULL && mgr->conn != NULL)
-        return NULL; /* switch from HTTP to HTTPS not implemented */
-
     if (mgr->creds == NULL)
     {   /* First TLS connection: load x509 credentials */
         mgr->creds = vlc_tls_ClientCreate(mgr->obj);
@@ -167,8 +241,8 @@ static struct vlc_http_msg *vlc_https_request(struct vlc_http_mgr *mgr,
          * the nonidempotent request was processed if the connection fails
          * before the response is received.
          */
-        struct vlc_http_msg *resp = vlc_http_mgr_reuse(mgr, host, port, req,
-                                                       payload);
+        struct vlc_http_msg *resp = vlc_http_mgr_reuse(mgr, host, port, true,
+                                                       req, payload);
         if (resp != NULL)
             return resp; /* existing connection reused */
     }
@@ -206,11 +280,8 @@ static struct vlc_http_msg *vlc_https_request(struct vlc_http_mgr *mgr,
         return NULL;
     }
 
-    if (mgr->conn != NULL)
-        vlc_http_mgr_release(mgr, mgr->conn);
-
-    mgr->conn = conn;
-    return vlc_http_mgr_reuse(mgr, host, port, req, payload);
+    vlc_http_mgr_insert(mgr, conn, host, port, true);
+    return vlc_http_mgr_reuse(mgr, host, port, true, req, payload);
 }
 
 static struct vlc_http_msg *vlc_http_request(struct vlc_http_mgr *mgr,
@@ -218,13 +289,10 @@ static struct vlc_http_msg *vlc_http_request(struct vlc_http_mgr *mgr,
                                              const struct vlc_http_msg *req,
                                              bool idempotent, bool payload)
 {
-    if (mgr->creds != NULL && mgr->conn != NULL)
-        return NULL; /* switch from HTTPS to HTTP not implemented */
-
     if (idempotent)
     {
-        struct vlc_http_msg *resp = vlc_http_mgr_reuse(mgr, host, port, req,
-                                                       payload);
+        struct vlc_http_msg *resp = vlc_http_mgr_reuse(mgr, host, port, false,
+                                                       req, payload);
         if (resp != NULL)
             return resp;
     }
@@ -263,10 +331,7 @@ static struct vlc_http_msg *vlc_http_request(struct vlc_http_mgr *mgr,
         return NULL;
     }
 
-    if (mgr->conn != NULL)
-        vlc_http_mgr_release(mgr, mgr->conn);
-
-    mgr->conn = conn;
+    vlc_http_mgr_insert(mgr, conn, host, port, false);
     return resp;
 }
 
@@ -298,14 +363,17 @@ struct vlc_http_mgr *vlc_http_mgr_create(vlc_object_t *obj,
     mgr->obj = obj;
     mgr->creds = NULL;
     mgr->jar = jar;
-    mgr->conn = NULL;
+    vlc_list_init(&mgr->conns);
+    mgr->conn_count = 0;
     return mgr;
 }
 
 void vlc_http_mgr_destroy(struct vlc_http_mgr *mgr)
 {
-    if (mgr->conn != NULL)
-        vlc_http_mgr_release(mgr, mgr->conn);
+    struct vlc_http_mgr_conn *entry;
+
+    vlc_list_foreach(entry, &mgr->conns, node)
+        vlc_http_mgr_release(mgr, entry);
     if (mgr->creds != NULL)
         vlc_tls_ClientDelete(mgr->creds);
     free(mgr);
@@ -22,23 +22,53 @@
 # include "config.h"
 #endif
 #include <assert.h>
+#include <stdatomic.h>
 #include <stdint.h>
 #include <limits.h>
 
 #include <vlc_common.h>
 #include <vlc_access.h>
+#include <vlc_interrupt.h>
 #include <vlc_plugin.h>
 
 #include <vlc/libvlc.h>
 #include <vlc/libvlc_picture.h>
 #include <vlc/libvlc_media.h>
 
+#define VLC_IMEM_RING_EOF 0x1
+
+/**
+ * Lock-free input FIFO.
+ *
+ * Instead of serving every read through the "imem-read" callback, the
+ * application can share a single-producer single-consumer byte FIFO by
+ * passing its address as the "imem-ring" variable. The application appends
+ * bytes at \ref head, VLC consumes them from \ref tail; both offsets are
+ * free-running and wrap modulo 2^32, so \ref size must be a power of two.
+ * The steady-state exchange is then a pair of memcpy() without any lock.
+ *
+ * In this mode, the "imem-read" callback becomes optional: if set, it is
+ * invoked with a NULL buffer and zero length as a batched refill
+ * notification, once whenever the fill level drops below \ref watermark
+ * rather than once per buffer. Seeking is not supported on a FIFO.
+ */
+struct vlc_imem_ring
+{
+    uint32_t size; /**< Capacity of data[] in bytes, a power of two */
+    uint32_t watermark; /**< Refill notification threshold, in bytes */
+    _Atomic uint32_t flags; /**< VLC_IMEM_RING_EOF once the producer is done */
+    _Atomic uint32_t head; /**< Free-running write offset, application-owned */
+    _Atomic uint32_t tail; /**< Free-running read offset, VLC-owned */
+    uint8_t data[];
+};
+
 typedef struct
 {
     void *opaque;
     libvlc_media_read_cb read_cb;
     libvlc_media_seek_cb seek_cb;
     libvlc_media_close_cb close_cb;
+    struct vlc_imem_ring *ring;
     uint64_t size;
 } access_sys_t;
 
@@ -60,6 +90,50 @@ static ssize_t Read(stream_t *access, void *buf, size_t len)
     return val;
 }
 
+static ssize_t RingRead(stream_t *access, void *buf, size_t len)
+{
+    access_sys_t *sys = access->p_sys;
+    struct vlc_imem_ring *ring = sys->ring;
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    uint32_t used;
+
+    for (;;) {
+        uint32_t head = atomic_load_explicit(&ring->head,
+                                             memory_order_acquire);
+        used = head - tail;
+        if (used > 0)
+            break;
+        if (atomic_load_explicit(&ring->flags, memory_order_relaxed)
+                & VLC_IMEM_RING_EOF)
+            return 0; /* end of stream */
+        if (vlc_killed())
+            return -1; /* stalled producer must not block stopping */
+        /* Empty FIFO. A producer keeping up never gets VLC here. */
+        vlc_tick_sleep(VLC_TICK_FROM_MS(1));
+    }
+
+    if (len > used)
+        len = used;
+
+    uint32_t offset = tail & (ring->size - 1);
+    size_t contig = ring->size - offset;
+    if (len <= contig)
+        memcpy(buf, ring->data + offset, len);
+    else {
+        memcpy(buf, ring->data + offset, contig);
+        memcpy((uint8_t *)buf + contig, ring->data, len - contig);
+    }
+    atomic_store_explicit(&ring->tail, tail + len, memory_order_release);
+
+    /* Batched refill notification: poke the producer when, and only when,
+     * the fill level crosses below the watermark. */
+    if (sys->read_cb != NULL
+     && used >= ring->watermark && used - len < ring->watermark)
+        sys->read_cb(sys->opaque, NULL, 0);
+
+    return len;
+}
+
 static int Seek(stream_t *access, uint64_t offset)
 {
     access_sys_t *sys = access->p_sys;
@@ -134,11 +208,21 @@ static int Open(vlc_object_t *object)
     sys->read_cb = var_InheritAddress(access, "imem-read");
     sys->seek_cb = var_InheritAddress(access, "imem-seek");
     sys->close_cb = var_InheritAddress(access, "imem-close");
+    sys->ring = var_InheritAddress(access, "imem-ring");
     sys->size = UINT64_MAX;
 
     if (open_cb == NULL)
         open_cb = open_cb_default;
-    if (sys->read_cb == NULL)
+
+    if (sys->ring != NULL) {
+        uint32_t size = sys->ring->size;
+
+        if (size == 0 || (size & (size - 1))) {
+            msg_Err(access, "ring size %"PRIu32" not a power of two", size);
+            return VLC_EGENERIC;
+        }
+        sys->seek_cb = NULL; /* cannot seek a FIFO */
+    } else if (sys->read_cb == NULL)
         return VLC_EGENERIC;
 
     if (open_cb(opaque, &sys->opaque, &sys->size)) {
@@ -146,7 +230,7 @@ static int Open(vlc_object_t *object)
         return VLC_EGENERIC;
     }
 
-    access->pf_read = Read;
+    access->pf_read = (sys->ring != NULL) ? RingRead : Read;
     access->pf_block = NULL;
     access->pf_seek = (sys->seek_cb != NULL) ? Seek : NULL;
     access->pf_control = Control;
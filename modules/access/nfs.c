@@ -50,6 +50,10 @@
 #define AUTO_GUID_LONGTEXT N_("If uid/gid are not specified in " \
     "the url, VLC will automatically set a uid/gid.")
 
+#define READAHEAD_TEXT N_("Read-ahead depth")
+#define READAHEAD_LONGTEXT N_("Number of read requests kept in flight. " \
+    "Higher values hide the network round-trip time on sequential reads.")
+
 static int Open(vlc_object_t *);
 static void Close(vlc_object_t *);
 
@@ -58,11 +62,36 @@ vlc_module_begin()
     set_description(N_("NFS input"))
     set_subcategory(SUBCAT_INPUT_ACCESS)
     add_bool("nfs-auto-guid", true, AUTO_GUID_TEXT, AUTO_GUID_LONGTEXT)
+    add_integer("nfs-readahead", 8, READAHEAD_TEXT, READAHEAD_LONGTEXT)
+        change_integer_range(1, 64)
     set_capability("access", 0)
     add_shortcut("nfs")
     set_callbacks(Open, Close)
 vlc_module_end()
 
+/* Request size of a single pipelined read. The server may answer with
+ * less (rsize cap), in which case the window resyncs. */
+#define NFS_RA_CHUNK_SIZE (256 * 1024)
+
+enum nfs_ra_state
+{
+    NFS_RA_IDLE,
+    NFS_RA_PENDING, /* pread in flight */
+    NFS_RA_DONE,    /* data (or EOF) available */
+    NFS_RA_STALE,   /* in flight but the window moved, drop on arrival */
+};
+
+/* One outstanding read RPC and its reordering storage */
+struct nfs_ra_slot
+{
+    stream_t *          p_access;
+    uint8_t *           p_buf;
+    uint64_t            i_offset;
+    size_t              i_requested;
+    size_t              i_len;
+    enum nfs_ra_state   state;
+};
+
 typedef struct
 {
     struct rpc_context *    p_mount; /* used to to get exports mount point */
@@ -78,21 +107,18 @@ typedef struct
     bool                    b_error;
     bool                    b_auto_guid;
 
+    struct nfs_ra_slot *    p_ra_slots;
+    uint8_t *               p_ra_buf;
+    unsigned                i_ra_count;
+    uint64_t                i_read_offset;    /* next byte to request */
+    uint64_t                i_deliver_offset; /* next byte for the caller */
+
     union {
         struct
         {
             char **         ppsz_names;
             int             i_count;
         } exports;
-        struct
-        {
-            uint8_t *p_buf;
-            size_t i_len;
-        } read;
-        struct
-        {
-            bool b_done;
-        } seek;
     } res;
 } access_sys_t;
 
@@ -173,30 +199,97 @@ vlc_mount_mainloop(stream_t *p_access, bool (*pf_until_cb)(stream_t *))
 }
 
 static void
-nfs_read_cb(int i_status, struct nfs_context *p_nfs, void *p_data,
-            void *p_private_data)
+nfs_pread_cb(int i_status, struct nfs_context *p_nfs, void *p_data,
+             void *p_private_data)
 {
-    VLC_UNUSED(p_nfs);
-    stream_t *p_access = p_private_data;
+    struct nfs_ra_slot *p_slot = p_private_data;
+    stream_t *p_access = p_slot->p_access;
     access_sys_t *p_sys = p_access->p_sys;
-    assert(p_sys->p_nfs == p_nfs);
+    assert(p_sys->p_nfs == p_nfs); VLC_UNUSED(p_nfs); VLC_UNUSED(p_sys);
+
+    if (p_slot->state == NFS_RA_STALE)
+    {
+        /* reply for a window that was seeked away from */
+        p_slot->state = NFS_RA_IDLE;
+        return;
+    }
     if (NFS_CHECK_STATUS(p_access, i_status, p_data))
         return;
 
-    if (i_status == 0)
-        p_sys->b_eof = true;
-    else
+    p_slot->i_len = i_status > 0 ? (size_t)i_status : 0; /* 0 = EOF */
+    if (i_status > 0)
+        memcpy(p_slot->p_buf, p_data, i_status);
+    p_slot->state = NFS_RA_DONE;
+}
+
+/* Issue preads until the configured count of RPCs is in flight */
+static bool
+nfs_ra_schedule(stream_t *p_access)
+{
+    access_sys_t *p_sys = p_access->p_sys;
+
+    for (unsigned i = 0; i < p_sys->i_ra_count; ++i)
     {
-        p_sys->res.read.i_len = i_status;
-        memcpy(p_sys->res.read.p_buf, p_data, i_status);
+        struct nfs_ra_slot *p_slot = &p_sys->p_ra_slots[i];
+        if (p_slot->state != NFS_RA_IDLE)
+            continue;
+        if (p_sys->stat.nfs_size > 0
+         && p_sys->i_read_offset >= p_sys->stat.nfs_size)
+            break;
+        p_slot->i_offset = p_sys->i_read_offset;
+        p_slot->i_requested = NFS_RA_CHUNK_SIZE;
+        p_slot->i_len = 0;
+        if (nfs_pread_async(p_sys->p_nfs, p_sys->p_nfsfh, p_slot->i_offset,
+                            p_slot->i_requested, nfs_pread_cb, p_slot) < 0)
+        {
+            msg_Err(p_access, "nfs_pread_async failed");
+            return false;
+        }
+        p_slot->state = NFS_RA_PENDING;
+        p_sys->i_read_offset += p_slot->i_requested;
     }
+    return true;
+}
+
+/* Drop buffered data and flag in-flight replies as stale */
+static void
+nfs_ra_abort(access_sys_t *p_sys)
+{
+    for (unsigned i = 0; i < p_sys->i_ra_count; ++i)
+    {
+        struct nfs_ra_slot *p_slot = &p_sys->p_ra_slots[i];
+        if (p_slot->state == NFS_RA_PENDING)
+            p_slot->state = NFS_RA_STALE;
+        else if (p_slot->state == NFS_RA_DONE)
+            p_slot->state = NFS_RA_IDLE;
+    }
+}
+
+/* Completed slot holding the next byte owed to the caller, if any */
+static struct nfs_ra_slot *
+nfs_ra_find(access_sys_t *p_sys)
+{
+    for (unsigned i = 0; i < p_sys->i_ra_count; ++i)
+    {
+        struct nfs_ra_slot *p_slot = &p_sys->p_ra_slots[i];
+        if (p_slot->state != NFS_RA_DONE
+         || p_slot->i_offset > p_sys->i_deliver_offset)
+            continue;
+        if (p_slot->i_len == 0 /* EOF */
+         || p_sys->i_deliver_offset < p_slot->i_offset + p_slot->i_len)
+            return p_slot;
+    }
+    return NULL;
 }
 
 static bool
 nfs_read_finished_cb(stream_t *p_access)
 {
     access_sys_t *p_sys = p_access->p_sys;
-    return p_sys->res.read.i_len > 0 || p_sys->b_eof;
+    if (p_sys->stat.nfs_size > 0
+     && p_sys->i_deliver_offset >= p_sys->stat.nfs_size)
+        return true;
+    return nfs_ra_find(p_sys) != NULL;
 }
 
 static ssize_t
@@ -207,41 +300,41 @@ FileRead(stream_t *p_access, void *p_buf, size_t i_len)
     if (p_sys->b_eof)
         return 0;
 
-    p_sys->res.read.i_len = 0;
-    p_sys->res.read.p_buf = p_buf;
-    if (nfs_read_async(p_sys->p_nfs, p_sys->p_nfsfh, i_len, nfs_read_cb,
-                       p_access) < 0)
-    {
-        msg_Err(p_access, "nfs_read_async failed");
+    if (!nfs_ra_schedule(p_access))
         return 0;
-    }
 
     if (vlc_nfs_mainloop(p_access, nfs_read_finished_cb) < 0)
         return 0;
 
-    return p_sys->res.read.i_len;
-}
+    struct nfs_ra_slot *p_slot = nfs_ra_find(p_sys);
+    if (p_slot == NULL || p_slot->i_len == 0)
+    {
+        if (p_slot != NULL)
+            p_slot->state = NFS_RA_IDLE;
+        p_sys->b_eof = true;
+        return 0;
+    }
 
-static void
-nfs_seek_cb(int i_status, struct nfs_context *p_nfs, void *p_data,
-            void *p_private_data)
-{
-    VLC_UNUSED(p_nfs);
-    stream_t *p_access = p_private_data;
-    access_sys_t *p_sys = p_access->p_sys;
-    assert(p_sys->p_nfs == p_nfs);
-    (void) p_data;
-    if (NFS_CHECK_STATUS(p_access, i_status, p_data))
-        return;
+    size_t i_slot_off = p_sys->i_deliver_offset - p_slot->i_offset;
+    size_t i_copy = p_slot->i_len - i_slot_off;
+    if (i_copy > i_len)
+        i_copy = i_len;
+    memcpy(p_buf, &p_slot->p_buf[i_slot_off], i_copy);
+    p_sys->i_deliver_offset += i_copy;
 
-    p_sys->res.seek.b_done = true;
-}
+    if (p_sys->i_deliver_offset >= p_slot->i_offset + p_slot->i_len)
+    {
+        p_slot->state = NFS_RA_IDLE;
+        if (p_slot->i_len < p_slot->i_requested)
+        {
+            /* short read (server rsize below our chunk size): the later
+             * slots were requested past a gap, resync the window */
+            nfs_ra_abort(p_sys);
+            p_sys->i_read_offset = p_sys->i_deliver_offset;
+        }
+    }
 
-static bool
-nfs_seek_finished_cb(stream_t *p_access)
-{
-    access_sys_t *p_sys = p_access->p_sys;
-    return p_sys->res.seek.b_done;
+    return i_copy;
 }
 
 static int
@@ -249,17 +342,10 @@ FileSeek(stream_t *p_access, uint64_t i_pos)
 {
     access_sys_t *p_sys = p_access->p_sys;
 
-    p_sys->res.seek.b_done = false;
-    if (nfs_lseek_async(p_sys->p_nfs, p_sys->p_nfsfh, i_pos, SEEK_SET,
-                        nfs_seek_cb, p_access) < 0)
-    {
-        msg_Err(p_access, "nfs_seek_async failed");
-        return VLC_EGENERIC;
-    }
-
-    if (vlc_nfs_mainloop(p_access, nfs_seek_finished_cb) < 0)
-        return VLC_EGENERIC;
-
+    /* Reads are issued at explicit offsets: just move the window and
+     * drop the replies of the old one when they land */
+    nfs_ra_abort(p_sys);
+    p_sys->i_deliver_offset = p_sys->i_read_offset = i_pos;
     p_sys->b_eof = false;
 
     return VLC_SUCCESS;
@@ -699,6 +785,20 @@ Open(vlc_object_t *p_obj)
 
         if (p_sys->p_nfsfh != NULL)
         {
+            p_sys->i_ra_count = var_InheritInteger(p_obj, "nfs-readahead");
+            p_sys->p_ra_slots = calloc(p_sys->i_ra_count,
+                                       sizeof(*p_sys->p_ra_slots));
+            p_sys->p_ra_buf = malloc((size_t)p_sys->i_ra_count
+                                     * NFS_RA_CHUNK_SIZE);
+            if (p_sys->p_ra_slots == NULL || p_sys->p_ra_buf == NULL)
+                goto error;
+            for (unsigned i = 0; i < p_sys->i_ra_count; ++i)
+            {
+                p_sys->p_ra_slots[i].p_access = p_access;
+                p_sys->p_ra_slots[i].p_buf =
+                        &p_sys->p_ra_buf[(size_t)i * NFS_RA_CHUNK_SIZE];
+            }
+
             p_access->pf_read = FileRead;
             p_access->pf_seek = FileSeek;
             p_access->pf_control = FileControl;
@@ -763,7 +863,15 @@ Close(vlc_object_t *p_obj)
         nfs_closedir(p_sys->p_nfs, p_sys->p_nfsdir);
 
     if (p_sys->p_nfs != NULL)
+    {
+        /* Destroying the context surfaces the pending pread replies, flag
+         * them stale so they are dropped silently */
+        if (p_sys->p_ra_slots != NULL)
+            nfs_ra_abort(p_sys);
         nfs_destroy_context(p_sys->p_nfs);
+    }
+    free(p_sys->p_ra_slots);
+    free(p_sys->p_ra_buf);
 
     if (p_sys->p_mount != NULL)
     {
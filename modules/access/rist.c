@@ -29,6 +29,7 @@
 #include <vlc_plugin.h>
 #include <vlc_access.h>
 #include <vlc_block.h>
+#include <vlc_tracer.h>
 
 #define RIST_CFG_PREFIX "rist-"
 #include "rist.h"
@@ -54,10 +55,40 @@ typedef struct
     int          i_recovery_buffer;
     int          i_maximum_jitter;
     struct       rist_logging_settings logging_settings;
+    struct       vlc_tracer *tracer;
     vlc_mutex_t  lock;
-    struct       rist_data_block *rist_items[RIST_MAX_QUEUE_BUFFERS];
+    block_t     *queue; /* packets received but not passed downstream yet */
+    block_t    **queue_end;
 } stream_sys_t;
 
+/*
+ * librist owns the payload buffers; wrap them in custom frames so that they
+ * reach the demux without an intermediate copy and are returned to librist
+ * when released.
+ */
+struct rist_frame
+{
+    block_t block;
+    struct rist_data_block *rist;
+};
+
+static void RistFrameFree(block_t *block)
+{
+    struct rist_frame *f = container_of(block, struct rist_frame, block);
+
+    rist_receiver_data_block_free2(&f->rist);
+    free(f);
+}
+
+static const struct vlc_frame_callbacks rist_frame_cbs = { RistFrameFree };
+
+static struct vlc_tracer_entry rist_trace_entry_int(const char *key, int64_t v)
+{
+    vlc_tracer_value_t value = { .integer = v };
+    struct vlc_tracer_entry entry = { key, value, VLC_TRACER_INT };
+    return entry;
+}
+
 static int cb_stats(void *arg, const struct rist_stats *stats_container)
 {
     stream_t *p_access = (stream_t*)arg;
@@ -80,6 +111,27 @@ static int cb_stats(void *arg, const struct rist_stats *stats_container)
     p_sys->cumulative_loss
     );
 
+    /* Surface the flow health to the tracer so link monitoring does not
+     * need to scrape debug logs. The json above still carries the full
+     * per-peer breakdown for deep dives. */
+    if (p_sys->tracer != NULL)
+    {
+        vlc_tracer_Trace(p_sys->tracer,
+            VLC_TRACE("type", "RIST"),
+            VLC_TRACE("id", p_access->psz_url),
+            rist_trace_entry_int("flow", stats_receiver_flow->flow_id),
+            rist_trace_entry_int("received", stats_receiver_flow->received),
+            rist_trace_entry_int("missing", stats_receiver_flow->missing),
+            rist_trace_entry_int("reordered", stats_receiver_flow->reordered),
+            rist_trace_entry_int("recovered", stats_receiver_flow->recovered),
+            rist_trace_entry_int("lost", stats_receiver_flow->lost),
+            rist_trace_entry_int("cumulative_loss", p_sys->cumulative_loss),
+            rist_trace_entry_int("quality_pct", (int64_t)stats_receiver_flow->quality),
+            rist_trace_entry_int("max_ips_us", stats_receiver_flow->max_inter_packet_spacing),
+            rist_trace_entry_int("rtt_ms", stats_receiver_flow->rtt),
+            VLC_TRACE_END);
+    }
+
     if ((int)stats_receiver_flow->max_inter_packet_spacing > p_sys->i_recovery_buffer * 1000)
     {
         msg_Err(p_access, "The IP network jitter exceeded your recovery buffer size, %d > %d us, you should increase the recovery buffer size or fix your source/network jitter",
@@ -132,14 +184,15 @@ static int Control(stream_t *p_access, int i_query, va_list args)
 static block_t *BlockRIST(stream_t *p_access, bool *restrict eof)
 {
     stream_sys_t *p_sys = p_access->p_sys;
-    block_t *pktout = NULL;
     struct rist_data_block *rist_buffer = NULL;
-    size_t i_total_size, i_rist_items_index;
-    int i_flags, ret;
+    size_t i_queued = 0;
+    int ret = 0;
     *eof = false;
-    i_rist_items_index = i_flags = i_total_size = 0;
     int i_read_timeout_ms = p_sys->i_maximum_jitter;
 
+    if (p_sys->queue != NULL)
+        goto pop; /* drain the previous batch without touching librist */
+
     while ((ret = rist_receiver_data_read2(p_sys->receiver_ctx, &rist_buffer, i_read_timeout_ms)) > 0)
     {
         if (p_sys->gre_filter_dst_port > 0 && rist_buffer->virt_dst_port != p_sys->gre_filter_dst_port) {
@@ -148,8 +201,7 @@ static block_t *BlockRIST(stream_t *p_access, bool *restrict eof)
         }
         i_read_timeout_ms = 0;
 
-        p_sys->rist_items[i_rist_items_index++] = rist_buffer;
-        i_total_size += rist_buffer->payload_len;
+        int i_flags = 0;
         vlc_mutex_lock( &p_sys->lock );
         if (p_sys->flow_id != rist_buffer->flow_id ||
             rist_buffer->flags == RIST_DATA_FLAGS_DISCONTINUITY ||
@@ -159,50 +211,46 @@ static block_t *BlockRIST(stream_t *p_access, bool *restrict eof)
                 p_sys->flow_id = rist_buffer->flow_id;
             }
             i_flags = BLOCK_FLAG_DISCONTINUITY;
-            vlc_mutex_unlock( &p_sys->lock );
-            break;
         }
         vlc_mutex_unlock( &p_sys->lock );
-        // Make sure we never read more than our array size
-        if (i_rist_items_index == (RIST_MAX_QUEUE_BUFFERS -1))
+
+        struct rist_frame *f = malloc(sizeof (*f));
+        if (unlikely(f == NULL)) {
+            rist_receiver_data_block_free2(&rist_buffer);
+            break;
+        }
+        f->rist = rist_buffer;
+        vlc_frame_Init(&f->block, &rist_frame_cbs,
+                       (void *)rist_buffer->payload, rist_buffer->payload_len);
+        f->block.i_flags = i_flags;
+        *p_sys->queue_end = &f->block;
+        p_sys->queue_end = &f->block.p_next;
+
+        if (i_flags & BLOCK_FLAG_DISCONTINUITY)
+            break;
+        // Make sure we never queue more than the old array size at once
+        if (++i_queued == (RIST_MAX_QUEUE_BUFFERS -1))
             break;
     }
 
     if (ret > 50)
         msg_Dbg(p_access, "Falling behind reading rist buffer by %d packets", ret);
 
-    if (ret < 0) {
-        msg_Err(p_access, "Unrecoverable error %i while reading from rist, ending stream", ret);
-        *eof = true;
-        goto failed_cleanup;
-    }
-
-    if (i_total_size == 0) {
+pop:
+    if (p_sys->queue == NULL) {
+        if (ret < 0) {
+            msg_Err(p_access, "Unrecoverable error %i while reading from rist, ending stream", ret);
+            *eof = true;
+        }
         return NULL;
     }
 
-    // Prepare one large buffer (when we are behing in reading, otherwise it is the same size as what is being read)
-    pktout = block_Alloc(i_total_size);
-    if ( unlikely(pktout == NULL) ) {
-        goto failed_cleanup;
-    }
-
-    size_t block_offset = 0;
-    for(size_t i = 0; i < i_rist_items_index; ++i) {
-        memcpy(pktout->p_buffer + block_offset,  p_sys->rist_items[i]->payload,  p_sys->rist_items[i]->payload_len);
-        block_offset +=  p_sys->rist_items[i]->payload_len;
-        rist_receiver_data_block_free2(& p_sys->rist_items[i]);
-    }
-    pktout->i_flags = i_flags;
+    block_t *pktout = p_sys->queue;
+    p_sys->queue = pktout->p_next;
+    if (p_sys->queue == NULL)
+        p_sys->queue_end = &p_sys->queue;
+    pktout->p_next = NULL;
     return pktout;
-
-failed_cleanup:
-    if (i_total_size > 0) {
-        for (size_t i = 0; i < i_rist_items_index; i++) {
-            rist_receiver_data_block_free2(&p_sys->rist_items[i]);
-        }
-    }
-    return NULL;
 }
 
 
@@ -210,6 +258,7 @@ static void Close(vlc_object_t *p_this)
 {
     stream_t *p_access = (stream_t*)p_this;
     stream_sys_t *p_sys = p_access->p_sys;
+    block_ChainRelease(p_sys->queue);
     rist_destroy(p_sys->receiver_ctx);
 }
 
@@ -223,6 +272,8 @@ static int Open(vlc_object_t *p_this)
         return VLC_ENOMEM;
 
     p_access->p_sys = p_sys;
+    p_sys->queue_end = &p_sys->queue;
+    p_sys->tracer = vlc_object_get_tracer( p_this );
 
     vlc_mutex_init( &p_sys->lock );
 
@@ -278,7 +329,8 @@ static int Open(vlc_object_t *p_this)
         goto failed;
     }
 
-    if( !rist_add_peers(VLC_OBJECT(p_access), p_sys->receiver_ctx, p_access->psz_url, 0, RIST_DEFAULT_VIRT_DST_PORT, i_recovery_length) )
+    int i_multipeer_mode = var_InheritInteger( p_access, RIST_CFG_PREFIX "multipeer-mode" );
+    if( !rist_add_peers(VLC_OBJECT(p_access), p_sys->receiver_ctx, p_access->psz_url, i_multipeer_mode, RIST_DEFAULT_VIRT_DST_PORT, i_recovery_length) )
         goto failed;
 
     /* Start the rist protocol thread */
@@ -298,6 +350,12 @@ failed:
     return VLC_EGENERIC;
 }
 
+#define MULTIPEER_MODE_TEXT N_("Multipeer weight")
+#define MULTIPEER_MODE_LONGTEXT N_( \
+    "Weight applied to every bonded peer (peer-url2/3/4). 0 duplicates the "\
+    "stream on all links for full redundancy, a positive value enables "\
+    "weighted load balancing between them." )
+
 #define DST_PORT_TEXT N_("Virtual Destination Port Filter")
 #define DST_PORT_LONGTEXT N_( \
     "Destination port to be used inside the reduced-mode of the main profile "\
@@ -321,6 +379,8 @@ vlc_module_begin ()
             DST_PORT_TEXT, DST_PORT_LONGTEXT )
     add_integer( RIST_CFG_PREFIX RIST_CFG_MAX_PACKET_SIZE, RIST_MAX_PACKET_SIZE,
             RIST_PACKET_SIZE_TEXT, NULL )
+    add_integer( RIST_CFG_PREFIX "multipeer-mode", 0,
+            MULTIPEER_MODE_TEXT, MULTIPEER_MODE_LONGTEXT )
     add_string( RIST_CFG_PREFIX RIST_CFG_URL2, NULL, RIST_URL2_TEXT, NULL )
     add_string( RIST_CFG_PREFIX RIST_CFG_URL3, NULL, RIST_URL3_TEXT, NULL )
     add_string( RIST_CFG_PREFIX RIST_CFG_URL4, NULL, RIST_URL4_TEXT, NULL )
@@ -35,6 +35,15 @@
 
 typedef struct rtp_source_t rtp_source_t;
 
+/* De-jitter depth adaptation: waiting for a missing packet starts at
+ * RTP_DEJITTER_MUL times the interarrival jitter estimate, deepens by one
+ * step whenever a packet arrives after we gave up waiting for it, and
+ * shrinks back one step per RTP_DEJITTER_DECAY decoded packets without any
+ * late arrival. */
+#define RTP_DEJITTER_MUL        3
+#define RTP_DEJITTER_MUL_MAX   15
+#define RTP_DEJITTER_DECAY   1000
+
 /** State for a RTP session: */
 struct rtp_session_t
 {
@@ -121,6 +130,10 @@ struct rtp_source_t
     uint16_t max_seq; /* next expected sequence */
 
     uint16_t last_seq; /* sequence of the next dequeued packet */
+    uint16_t depth_mul; /* de-jitter depth, in multiples of the jitter estimate */
+    uint16_t run; /* packets decoded since the last late arrival */
+    uint64_t late; /* packets dropped for arriving after the wait expired */
+    uint64_t lost; /* packets never received */
     block_t *blocks; /* re-ordered blocks queue */
     struct {
         struct vlc_rtp_pt *instance; /* Per-source current payload format */
@@ -147,6 +160,10 @@ rtp_source_create (demux_t *demux, const rtp_session_t *session,
     source->ref_ntp = UINT64_C (1) << 51;
     source->max_seq = source->bad_seq = init_seq;
     source->last_seq = init_seq - 1;
+    source->depth_mul = RTP_DEJITTER_MUL;
+    source->run = 0;
+    source->late = 0;
+    source->lost = 0;
     source->blocks = NULL;
     source->pt.instance = NULL;
     msg_Dbg (demux, "added RTP source (%08x)", ssrc);
@@ -160,6 +177,9 @@ rtp_source_create (demux_t *demux, const rtp_session_t *session,
 static void rtp_source_destroy(demux_t *demux, rtp_source_t *source)
 {
     msg_Dbg (demux, "removing RTP source (%08x)", source->ssrc);
+    msg_Dbg (demux, " %"PRIu64" packet(s) late, %"PRIu64" lost, "
+             "de-jitter depth %"PRIu16"x jitter",
+             source->late, source->lost, source->depth_mul);
     if (source->pt.instance != NULL)
         vlc_rtp_pt_end(source->pt.instance, source->pt.opaque);
     block_ChainRelease (source->blocks);
@@ -396,13 +416,14 @@ bool rtp_dequeue (demux_t *demux, const rtp_session_t *session,
                 continue;
             }
 
-            /* Wait for 3 times the inter-arrival delay variance (about 99.7%
-             * match for random gaussian jitter).
-             */
+            /* Wait for depth_mul times the inter-arrival delay variance
+             * (3 times is about a 99.7% match for random gaussian jitter);
+             * the multiplier adapts to the lateness actually observed. */
             vlc_tick_t deadline;
             const rtp_pt_t *pt = rtp_find_ptype(session, block);
             if (pt)
-                deadline = vlc_tick_from_samples(3 * src->jitter, pt->frequency);
+                deadline = vlc_tick_from_samples((uint32_t)src->depth_mul
+                                                 * src->jitter, pt->frequency);
             else
                 deadline = 0; /* no jitter estimate with no frequency :( */
 
@@ -450,13 +471,30 @@ rtp_decode (demux_t *demux, const rtp_session_t *session, rtp_source_t *src)
         {   /* Trash too late packets (and PIM Assert duplicates) */
             msg_Dbg (demux, "ignoring late packet (sequence: %"PRIu16")",
                       rtp_seq (block));
+            /* We did not wait long enough for this one: deepen the
+             * de-jitter buffer */
+            src->late++;
+            src->run = 0;
+            if (src->depth_mul < RTP_DEJITTER_MUL_MAX)
+                msg_Dbg (demux, "de-jitter depth increased to %"PRIu16"x",
+                         ++src->depth_mul);
             goto drop;
         }
         msg_Warn (demux, "%"PRIu16" packet(s) lost", delta_seq);
+        src->lost += delta_seq;
         block->i_flags |= BLOCK_FLAG_DISCONTINUITY;
     }
     src->last_seq = rtp_seq (block);
 
+    /* No late arrival for a while: give the latency back */
+    if (++src->run >= RTP_DEJITTER_DECAY)
+    {
+        src->run = 0;
+        if (src->depth_mul > RTP_DEJITTER_MUL)
+            msg_Dbg (demux, "de-jitter depth decreased to %"PRIu16"x",
+                     --src->depth_mul);
+    }
+
     /* Match the payload type */
     struct vlc_rtp_pt *pt = rtp_find_ptype(session, block);
     if (pt == NULL)
@@ -28,6 +28,7 @@
 #include <errno.h>
 #include <xcb/xcb.h>
 #include <xcb/composite.h>
+#include <xcb/damage.h>
 #ifdef HAVE_SYS_SHM_H
 # include <sys/shm.h>
 # include <xcb/shm.h>
@@ -108,6 +109,10 @@ typedef struct
     float             rate; /**< Frame rate */
     xcb_window_t      window; /**< Captured window XID  */
     xcb_pixmap_t      pixmap; /**< Pixmap for composited capture */
+    xcb_damage_damage_t damage; /**< Damage object XID (or XCB_NONE) */
+    uint8_t           damage_base; /**< Damage extension first event code */
+    bool              damaged; /**< Whether content changed since capture */
+    vlc_tick_t        last_sent; /**< Time of the last delivered frame */
 #ifdef HAVE_SYS_SHM_H
     xcb_shm_seg_t     segment; /**< SHM segment XID */
 #endif
@@ -137,6 +142,29 @@ static bool CheckSHM (xcb_connection_t *conn)
 #endif
 }
 
+/** Sets up change notification on the drawable, if Damage is available */
+static xcb_damage_damage_t SetupDamage (xcb_connection_t *conn,
+                                        xcb_window_t window, uint8_t *base)
+{
+    const xcb_query_extension_reply_t *ext =
+        xcb_get_extension_data (conn, &xcb_damage_id);
+    if (ext == NULL || !ext->present)
+        return XCB_NONE;
+
+    xcb_damage_query_version_reply_t *r =
+        xcb_damage_query_version_reply (conn,
+            xcb_damage_query_version (conn, 1, 1), NULL);
+    if (r == NULL)
+        return XCB_NONE;
+    free (r);
+
+    xcb_damage_damage_t damage = xcb_generate_id (conn);
+    xcb_damage_create (conn, damage, window,
+                       XCB_DAMAGE_REPORT_LEVEL_NON_EMPTY);
+    *base = ext->first_event;
+    return damage;
+}
+
 /**
  * Probes and initializes.
  */
@@ -223,6 +251,12 @@ static int Open (vlc_object_t *obj)
     p_sys->segment = xcb_generate_id (conn);
 #endif
     p_sys->shm = CheckSHM (conn);
+    p_sys->damage = SetupDamage (conn, p_sys->window, &p_sys->damage_base);
+    p_sys->damaged = true; /* always capture the first frame */
+    p_sys->last_sent = VLC_TICK_INVALID;
+    if (p_sys->damage == XCB_NONE)
+        msg_Dbg (obj, "Damage extension not available, "
+                 "capturing at fixed rate");
     p_sys->w = var_InheritInteger (obj, "screen-width");
     p_sys->h = var_InheritInteger (obj, "screen-height");
     if (p_sys->w != 0 || p_sys->h != 0)
@@ -335,6 +369,33 @@ static void Demux (void *opaque)
     demux_sys_t *sys = demux->p_sys;
     xcb_connection_t *conn = sys->conn;
 
+    /* Skip the capture entirely while the server reports no changes to the
+     * drawable. The mouse crop window moves without damaging anything, and
+     * a frame per second is kept flowing regardless so that the PCR and any
+     * recording sink do not stall on an idle desktop. */
+    if (sys->damage != XCB_NONE)
+    {
+        xcb_generic_event_t *ev;
+
+        while ((ev = xcb_poll_for_event (conn)) != NULL)
+        {
+            if ((ev->response_type & 0x7f)
+                    == sys->damage_base + XCB_DAMAGE_NOTIFY)
+                sys->damaged = true;
+            free (ev);
+        }
+
+        if (!sys->damaged && !sys->follow_mouse
+         && vlc_tick_now () < sys->last_sent + VLC_TICK_FROM_SEC(1))
+            return;
+
+        if (sys->damaged)
+        {
+            xcb_damage_subtract (conn, sys->damage, XCB_NONE, XCB_NONE);
+            sys->damaged = false;
+        }
+    }
+
     /* Determine capture region */
     xcb_get_geometry_cookie_t gc;
     xcb_query_pointer_cookie_t qc;
@@ -505,6 +566,7 @@ noshm:
     if (sys->es != NULL)
     {
         block->i_pts = block->i_dts = vlc_tick_now ();
+        sys->last_sent = block->i_pts;
 
         es_out_SetPCR(demux->out, block->i_pts);
         es_out_Send (demux->out, sys->es, block);
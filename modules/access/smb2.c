@@ -96,6 +96,10 @@ netbios_ns_interrupt_unregister(void)
 #include "smb_common.h"
 #include "cache.h"
 
+#define READAHEAD_TEXT N_("Read-ahead depth")
+#define READAHEAD_LONGTEXT N_("Number of read commands kept in flight. " \
+    "Higher values hide the network round-trip time on sequential reads.")
+
 static int Open(vlc_object_t *);
 static void Close(vlc_object_t *);
 
@@ -108,12 +112,38 @@ vlc_module_begin()
     add_string("smb-user", NULL, SMB_USER_TEXT, SMB_USER_LONGTEXT)
     add_password("smb-pwd", NULL, SMB_PASS_TEXT, SMB_PASS_LONGTEXT)
     add_string("smb-domain", NULL, SMB_DOMAIN_TEXT, SMB_DOMAIN_LONGTEXT)
+    add_integer("smb2-readahead", 8, READAHEAD_TEXT, READAHEAD_LONGTEXT)
+        change_integer_range(1, 64)
     add_shortcut("smb", "smb2")
     set_callbacks(Open, Close)
 vlc_module_end()
 
 VLC_ACCESS_CACHE_REGISTER(smb2_cache);
 
+/* Size of a single pipelined read command */
+#define SMB2_RA_CHUNK_SIZE (256 * 1024)
+
+enum smb2_ra_state
+{
+    SMB2_RA_IDLE,
+    SMB2_RA_PENDING, /* pread in flight */
+    SMB2_RA_DONE,    /* data available */
+    SMB2_RA_STALE,   /* in flight but the window moved, drop on arrival */
+};
+
+/* One outstanding read command and its reordering storage */
+struct smb2_ra_slot
+{
+    stream_t *          access;
+    uint8_t *           buf;
+    uint64_t            offset;
+    size_t              requested;
+    size_t              len;
+    enum smb2_ra_state  state;
+};
+
+struct vlc_smb2_op;
+
 struct access_sys
 {
     struct smb2_context *   smb2;
@@ -125,6 +155,13 @@ struct access_sys
     bool                    eof;
     bool                    smb2_connected;
 
+    struct smb2_ra_slot *   ra_slots;
+    uint8_t *               ra_buf;
+    unsigned                ra_count;
+    uint64_t                read_offset;    /* next byte to request */
+    uint64_t                deliver_offset; /* next byte for the caller */
+    struct vlc_smb2_op *    ra_op;          /* op waiting on a completion */
+
     struct vlc_access_cache_entry *cache_entry;
 };
 
@@ -139,10 +176,6 @@ struct vlc_smb2_op
 
     bool res_done;
     union {
-        struct
-        {
-            size_t len;
-        } read;
         void *data;
     } res;
 };
@@ -272,13 +305,127 @@ smb2_generic_cb(struct smb2_context *smb2, int status, void *data,
 }
 
 static void
-smb2_read_cb(struct smb2_context *smb2, int status, void *data,
-             void *private_data)
+smb2_ra_read_cb(struct smb2_context *smb2, int status, void *data,
+                void *private_data)
 {
-    VLC_UNUSED(data);
-    VLC_SMB2_GENERIC_CB();
+    struct smb2_ra_slot *slot = private_data;
+    struct access_sys *sys = slot->access->p_sys;
+    assert(sys->smb2 == smb2); (void) smb2; (void) data;
+
+    if (slot->state == SMB2_RA_STALE)
+        slot->state = SMB2_RA_IDLE; /* reply for a window seeked away from */
+    else if (status < 0)
+    {
+        if (sys->ra_op != NULL)
+            VLC_SMB2_CHECK_STATUS(sys->ra_op, status);
+        slot->state = SMB2_RA_IDLE;
+        return;
+    }
+    else
+    {
+        slot->len = status;
+        slot->state = SMB2_RA_DONE;
+    }
+
+    /* Wake the waiting mainloop so it can re-check its condition */
+    if (sys->ra_op != NULL)
+        sys->ra_op->res_done = true;
+}
+
+/* Issue preads until the configured count of commands is in flight */
+static bool
+smb2_ra_schedule(stream_t *access, struct vlc_smb2_op *op)
+{
+    struct access_sys *sys = access->p_sys;
+
+    for (unsigned i = 0; i < sys->ra_count; ++i)
+    {
+        struct smb2_ra_slot *slot = &sys->ra_slots[i];
+        if (slot->state != SMB2_RA_IDLE)
+            continue;
+        if (sys->read_offset >= sys->smb2_size)
+            break;
+        slot->offset = sys->read_offset;
+        slot->requested = SMB2_RA_CHUNK_SIZE;
+        if (slot->requested > sys->smb2_size - sys->read_offset)
+            slot->requested = sys->smb2_size - sys->read_offset;
+        slot->len = 0;
+        int err = smb2_pread_async(sys->smb2, sys->smb2fh, slot->buf,
+                                   slot->requested, slot->offset,
+                                   smb2_ra_read_cb, slot);
+        if (err < 0)
+        {
+            VLC_SMB2_SET_ERROR(op, "smb2_pread_async", err);
+            return false;
+        }
+        slot->state = SMB2_RA_PENDING;
+        sys->read_offset += slot->requested;
+    }
+    return true;
+}
 
-    op->res.read.len = status;
+/* Drop buffered data and flag in-flight replies as stale */
+static void
+smb2_ra_abort(struct access_sys *sys)
+{
+    for (unsigned i = 0; i < sys->ra_count; ++i)
+    {
+        struct smb2_ra_slot *slot = &sys->ra_slots[i];
+        if (slot->state == SMB2_RA_PENDING)
+            slot->state = SMB2_RA_STALE;
+        else if (slot->state == SMB2_RA_DONE)
+            slot->state = SMB2_RA_IDLE;
+    }
+}
+
+/* Completed slot holding the next byte owed to the caller, if any */
+static struct smb2_ra_slot *
+smb2_ra_find(struct access_sys *sys)
+{
+    for (unsigned i = 0; i < sys->ra_count; ++i)
+    {
+        struct smb2_ra_slot *slot = &sys->ra_slots[i];
+        if (slot->state != SMB2_RA_DONE || slot->offset > sys->deliver_offset)
+            continue;
+        if (slot->len == 0 /* EOF */
+         || sys->deliver_offset < slot->offset + slot->len)
+            return slot;
+    }
+    return NULL;
+}
+
+static bool
+smb2_ra_busy(const struct access_sys *sys)
+{
+    for (unsigned i = 0; i < sys->ra_count; ++i)
+        if (sys->ra_slots[i].state == SMB2_RA_PENDING
+         || sys->ra_slots[i].state == SMB2_RA_STALE)
+            return true;
+    return false;
+}
+
+/* Wait for the in-flight reads before the context is closed or put back
+ * into the connection cache, their replies reference our slots */
+static void
+smb2_ra_drain(stream_t *access)
+{
+    struct access_sys *sys = access->p_sys;
+
+    if (sys->ra_slots == NULL)
+        return;
+    smb2_ra_abort(sys);
+    if (!smb2_ra_busy(sys))
+        return;
+
+    struct vlc_smb2_op op = VLC_SMB2_OP(access, &sys->smb2);
+    sys->ra_op = &op;
+    while (op.error_status == 0 && smb2_ra_busy(sys))
+    {
+        op.res_done = false;
+        if (vlc_smb2_mainloop(&op) < 0)
+            break;
+    }
+    sys->ra_op = NULL;
 }
 
 static ssize_t
@@ -289,30 +436,60 @@ FileRead(stream_t *access, void *buf, size_t len)
     if (sys->eof || sys->smb2 == NULL)
         return 0;
 
-    /* Limit the read size since smb2_read_async() will complete only after
-     * reading the whole requested data and not when whatever data is available
-     * (high read size means a faster I/O but a higher latency). */
-    if (len > 262144)
-        len = 262144;
+    if (sys->deliver_offset >= sys->smb2_size)
+    {
+        sys->eof = true;
+        return 0;
+    }
 
     struct vlc_smb2_op op = VLC_SMB2_OP(access, &sys->smb2);
-    op.res.read.len = 0;
+    sys->ra_op = &op;
 
-    int err = smb2_read_async(sys->smb2, sys->smb2fh, buf, len,
-                              smb2_read_cb, &op);
-    if (err < 0)
+    if (!smb2_ra_schedule(access, &op))
     {
-        VLC_SMB2_SET_ERROR(&op, "smb2_read_async", err);
+        sys->ra_op = NULL;
         return 0;
     }
 
-    if (vlc_smb2_mainloop(&op) < 0)
-        return 0;
+    struct smb2_ra_slot *slot;
+    while ((slot = smb2_ra_find(sys)) == NULL)
+    {
+        op.res_done = false;
+        if (vlc_smb2_mainloop(&op) < 0)
+        {
+            sys->ra_op = NULL;
+            return 0;
+        }
+    }
+    sys->ra_op = NULL;
 
-    if (op.res.read.len == 0)
+    if (slot->len == 0)
+    {
+        slot->state = SMB2_RA_IDLE;
         sys->eof = true;
+        return 0;
+    }
+
+    size_t slot_off = sys->deliver_offset - slot->offset;
+    size_t copy = slot->len - slot_off;
+    if (copy > len)
+        copy = len;
+    memcpy(buf, &slot->buf[slot_off], copy);
+    sys->deliver_offset += copy;
 
-    return op.res.read.len;
+    if (sys->deliver_offset >= slot->offset + slot->len)
+    {
+        slot->state = SMB2_RA_IDLE;
+        if (slot->len < slot->requested)
+        {
+            /* short read: the later slots were requested past a gap,
+             * resync the window */
+            smb2_ra_abort(sys);
+            sys->read_offset = sys->deliver_offset;
+        }
+    }
+
+    return copy;
 }
 
 static int
@@ -330,14 +507,10 @@ FileSeek(stream_t *access, uint64_t i_pos)
         return VLC_EGENERIC;
     }
 
-    struct vlc_smb2_op op = VLC_SMB2_OP(access, &sys->smb2);
-
-    int64_t err = smb2_lseek(op.smb2, sys->smb2fh, i_pos, SEEK_SET, NULL);
-    if (err < 0)
-    {
-        VLC_SMB2_SET_ERROR(&op, "smb2_lseek", err);
-        return err;
-    }
+    /* Reads are issued at explicit offsets: just move the window and
+     * drop the replies of the old one when they land */
+    smb2_ra_abort(sys);
+    sys->deliver_offset = sys->read_offset = i_pos;
     sys->eof = false;
 
     return VLC_SUCCESS;
@@ -921,6 +1094,23 @@ Open(vlc_object_t *p_obj)
 
     if (sys->smb2fh != NULL)
     {
+        sys->ra_count = var_InheritInteger(access, "smb2-readahead");
+        sys->ra_slots = vlc_obj_calloc(p_obj, sys->ra_count,
+                                       sizeof(*sys->ra_slots));
+        sys->ra_buf = vlc_obj_malloc(p_obj, (size_t)sys->ra_count
+                                     * SMB2_RA_CHUNK_SIZE);
+        if (sys->ra_slots == NULL || sys->ra_buf == NULL)
+        {
+            Close(p_obj);
+            free(var_domain);
+            return VLC_ENOMEM;
+        }
+        for (unsigned i = 0; i < sys->ra_count; ++i)
+        {
+            sys->ra_slots[i].access = access;
+            sys->ra_slots[i].buf = &sys->ra_buf[(size_t)i * SMB2_RA_CHUNK_SIZE];
+        }
+
         access->pf_read = FileRead;
         access->pf_seek = FileSeek;
         access->pf_control = FileControl;
@@ -964,7 +1154,11 @@ Close(vlc_object_t *p_obj)
     if (sys->smb2fh != NULL)
     {
         if (sys->smb2)
-            vlc_smb2_close_fh(access, &sys->smb2, sys->smb2fh);
+        {
+            smb2_ra_drain(access);
+            if (sys->smb2)
+                vlc_smb2_close_fh(access, &sys->smb2, sys->smb2fh);
+        }
     }
     else if (sys->smb2dir != NULL)
         smb2_closedir(sys->smb2, sys->smb2dir);
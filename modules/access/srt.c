@@ -27,11 +27,14 @@
 #include <vlc_plugin.h>
 #include <vlc_access.h>
 #include <vlc_interrupt.h>
+#include <vlc_tracer.h>
 
 #include <vlc_network.h>
 #include <vlc_url.h>
 
 
+/* Interval between two link stats reports to the tracer */
+#define SRT_STATS_INTERVAL VLC_TICK_FROM_SEC(1)
 
 typedef struct
 {
@@ -42,6 +45,10 @@ typedef struct
     char       *psz_host;
     int         i_port;
     int         i_chunks; /* Number of chunks to allocate in the next read */
+    block_t    *p_spare;  /* Unused buffer kept from the previous read */
+    size_t      i_spare_size;
+    struct vlc_tracer *tracer;
+    vlc_tick_t  last_stats;
 } stream_sys_t;
 
 
@@ -65,6 +72,47 @@ static void srt_wait_interrupted(void *p_data)
     vlc_mutex_unlock( &p_sys->lock );
 }
 
+static struct vlc_tracer_entry srt_trace_entry_int( const char *key, int64_t v )
+{
+    vlc_tracer_value_t value = { .integer = v };
+    struct vlc_tracer_entry entry = { key, value, VLC_TRACER_INT };
+    return entry;
+}
+
+/* Report the link health counters the library keeps per connection
+ * (interval counters are cleared on each report). */
+static void srt_trace_stats(stream_t *p_stream)
+{
+    stream_sys_t *p_sys = p_stream->p_sys;
+
+    if ( p_sys->tracer == NULL )
+        return;
+
+    vlc_tick_t now = vlc_tick_now();
+    if ( p_sys->last_stats != VLC_TICK_INVALID &&
+         now - p_sys->last_stats < SRT_STATS_INTERVAL )
+        return;
+
+    SRT_TRACEBSTATS mon;
+    if ( srt_bistats( p_sys->sock, &mon, 1 /* clear */,
+                      1 /* instantaneous */ ) != 0 )
+        return;
+    p_sys->last_stats = now;
+
+    vlc_tracer_Trace( p_sys->tracer,
+        VLC_TRACE( "type", "SRT" ),
+        VLC_TRACE( "id", p_stream->psz_url ),
+        srt_trace_entry_int( "rtt_us", (int64_t)( mon.msRTT * 1000.0 ) ),
+        srt_trace_entry_int( "recv_pkt_loss", mon.pktRcvLoss ),
+        srt_trace_entry_int( "recv_pkt_retrans", mon.pktRcvRetrans ),
+        srt_trace_entry_int( "recv_pkt_drop", mon.pktRcvDrop ),
+        srt_trace_entry_int( "flight_pkt", mon.pktFlightSize ),
+        srt_trace_entry_int( "recv_rate_kbps",
+                             (int64_t)( mon.mbpsRecvRate * 1000.0 ) ),
+        srt_trace_entry_int( "rcv_buf_ms", mon.msRcvBuf ),
+        VLC_TRACE_END );
+}
+
 static int Control(stream_t *p_stream, int i_query, va_list args)
 {
     int i_ret = VLC_SUCCESS;
@@ -242,10 +290,25 @@ static block_t *BlockSRT(stream_t *p_stream, bool *restrict eof)
 
     const size_t i_chunk_size = SRT_LIVE_MAX_PLSIZE;
     const size_t bufsize = i_chunk_size * p_sys->i_chunks;
-    block_t *pkt = block_Alloc( bufsize );
-    if ( unlikely( pkt == NULL ) )
+
+    /* Reuse the buffer kept from a previous empty wake when it is
+     * still large enough, instead of hitting the allocator on every
+     * poll timeout. */
+    block_t *pkt = p_sys->p_spare;
+    p_sys->p_spare = NULL;
+    if ( pkt != NULL && p_sys->i_spare_size < bufsize )
     {
-        return NULL;
+        block_Release( pkt );
+        pkt = NULL;
+    }
+    if ( pkt == NULL )
+    {
+        pkt = block_Alloc( bufsize );
+        if ( unlikely( pkt == NULL ) )
+        {
+            return NULL;
+        }
+        p_sys->i_spare_size = bufsize;
     }
 
     vlc_interrupt_register( srt_wait_interrupted, p_stream);
@@ -319,6 +382,8 @@ static block_t *BlockSRT(stream_t *p_stream, bool *restrict eof)
             }
         }
 
+        srt_trace_stats( p_stream );
+
         goto out;
     }
 
@@ -329,7 +394,8 @@ static block_t *BlockSRT(stream_t *p_stream, bool *restrict eof)
 
 out:
     if (pkt->i_buffer == 0) {
-      block_Release(pkt);
+      /* nothing read, keep the buffer for the next wake */
+      p_sys->p_spare = pkt;
       pkt = NULL;
     }
 
@@ -383,6 +449,8 @@ static int Open(vlc_object_t *p_this)
         goto failed;
     }
     p_sys->sock = SRT_INVALID_SOCK;
+    p_sys->tracer = vlc_object_get_tracer( p_this );
+    p_sys->last_stats = VLC_TICK_INVALID;
 
     if ( !srt_schedule_reconnect( p_stream ) )
     {
@@ -413,6 +481,9 @@ static void Close(vlc_object_t *p_this)
     srt_close( p_sys->sock );
     srt_epoll_release( p_sys->i_poll_id );
 
+    if ( p_sys->p_spare )
+        block_Release( p_sys->p_spare );
+
     srt_cleanup();
 }
 
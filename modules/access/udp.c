@@ -53,13 +53,24 @@
  */
 #define MRU 65507u
 
+/* How many datagrams to receive in one system call */
+#define UDP_BATCH 32u
+
 typedef struct {
     int fd;
     int timeout;
 
+#ifdef HAVE_RECVMMSG
+    struct vlc_access_pool *pool; /* downstream returns consumed buffers */
+    block_t *queue;    /* datagrams received but not passed downstream yet */
+    block_t **queue_end;
+    block_t *spare;    /* preallocated buffers recycled across batches */
+    uint32_t drops;    /* last socket overflow counter value */
+#else
     size_t length;
     char *offset;
     char buf[MRU];
+#endif
 } access_sys_t;
 
 static int Control(stream_t *access, int query, va_list args)
@@ -83,6 +94,119 @@ static int Control(stream_t *access, int query, va_list args)
     return VLC_SUCCESS;
 }
 
+#ifdef HAVE_RECVMMSG
+static block_t *BlockRead(stream_t *access, bool *restrict eof)
+{
+    access_sys_t *sys = access->p_sys;
+
+    if (sys->queue != NULL) {
+        block_t *block = sys->queue;
+
+        sys->queue = block->p_next;
+        if (sys->queue == NULL)
+            sys->queue_end = &sys->queue;
+        block->p_next = NULL;
+        return block;
+    }
+
+    struct pollfd ufd = { .fd = sys->fd, .events = POLLIN };
+
+    switch (vlc_poll_i11e(&ufd, 1, sys->timeout)) {
+        case 0:
+            msg_Err(access, "receive time-out");
+            *eof = true;
+            /* fall through */
+        case -1:
+            return NULL;
+    }
+
+    block_t *blocks[UDP_BATCH];
+    struct mmsghdr msgs[UDP_BATCH];
+    struct iovec iovs[UDP_BATCH];
+#ifdef SO_RXQ_OVFL
+    char ctls[UDP_BATCH][CMSG_SPACE(sizeof (uint32_t))];
+#endif
+    unsigned n;
+
+    for (n = 0; n < UDP_BATCH; n++) {
+        block_t *block = sys->spare;
+
+        if (block != NULL)
+            sys->spare = block->p_next;
+        else {
+            block = vlc_access_pool_Block(sys->pool, MRU);
+            if (unlikely(block == NULL))
+                break;
+        }
+        block->p_next = NULL;
+
+        blocks[n] = block;
+        iovs[n] = (struct iovec){
+            .iov_base = block->p_buffer,
+            .iov_len = MRU,
+        };
+        msgs[n] = (struct mmsghdr){
+            .msg_hdr = {
+                .msg_iov = &iovs[n],
+                .msg_iovlen = 1,
+#ifdef SO_RXQ_OVFL
+                .msg_control = ctls[n],
+                .msg_controllen = sizeof (ctls[n]),
+#endif
+            },
+        };
+    }
+    if (unlikely(n == 0))
+        return NULL;
+
+    int val = recvmmsg(sys->fd, msgs, n, MSG_DONTWAIT, NULL);
+    if (val <= 0)
+        val = 0; /* empty (0 bytes) payload does *not* mean EOF here */
+
+    /* Keep untouched buffers for the next batch */
+    for (unsigned i = val; i < n; i++) {
+        blocks[i]->p_next = sys->spare;
+        sys->spare = blocks[i];
+    }
+
+    for (int i = 0; i < val; i++) {
+        block_t *block = blocks[i];
+
+        block->i_buffer = msgs[i].msg_len;
+        *sys->queue_end = block;
+        sys->queue_end = &block->p_next;
+
+#ifdef SO_RXQ_OVFL
+        for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msgs[i].msg_hdr);
+             cmsg != NULL; cmsg = CMSG_NXTHDR(&msgs[i].msg_hdr, cmsg)) {
+            uint32_t drops;
+
+            if (cmsg->cmsg_level != SOL_SOCKET
+             || cmsg->cmsg_type != SO_RXQ_OVFL)
+                continue;
+
+            memcpy(&drops, CMSG_DATA(cmsg), sizeof (drops));
+            if (drops != sys->drops) {
+                msg_Warn(access, "%"PRIu32" datagram(s) lost to socket "
+                         "buffer overflow", drops - sys->drops);
+                sys->drops = drops;
+            }
+        }
+#endif
+    }
+
+    if (sys->queue == NULL)
+        return NULL;
+
+    block_t *block = sys->queue;
+
+    sys->queue = block->p_next;
+    if (sys->queue == NULL)
+        sys->queue_end = &sys->queue;
+    block->p_next = NULL;
+    return block;
+}
+#else /* !HAVE_RECVMMSG */
 static ssize_t Read(stream_t *access, void *buf, size_t len)
 {
     access_sys_t *sys = access->p_sys;
@@ -131,6 +255,7 @@ static ssize_t Read(stream_t *access, void *buf, size_t len)
 
     return val;
 }
+#endif /* !HAVE_RECVMMSG */
 
 /*****************************************************************************
  * Open: open the socket
@@ -147,10 +272,19 @@ static int Open( vlc_object_t *p_this )
     if( unlikely( sys == NULL ) )
         return VLC_ENOMEM;
 
-    sys->length = 0;
     p_access->p_sys = sys;
+#ifdef HAVE_RECVMMSG
+    sys->queue = NULL;
+    sys->queue_end = &sys->queue;
+    sys->spare = NULL;
+    sys->drops = 0;
+    p_access->pf_read = NULL;
+    p_access->pf_block = BlockRead;
+#else
+    sys->length = 0;
     p_access->pf_read = Read;
     p_access->pf_block = NULL;
+#endif
     p_access->pf_control = Control;
     p_access->pf_seek = NULL;
 
@@ -213,10 +347,24 @@ static int Open( vlc_object_t *p_this )
         return VLC_EGENERIC;
     }
 
+#if defined (HAVE_RECVMMSG) && defined (SO_RXQ_OVFL)
+    /* Account datagrams dropped on kernel socket buffer overflow */
+    setsockopt( sys->fd, SOL_SOCKET, SO_RXQ_OVFL, &(int){ 1 }, sizeof (int) );
+#endif
+
     sys->timeout = var_InheritInteger( p_access, "udp-timeout");
     if( sys->timeout > 0)
         sys->timeout *= 1000;
 
+#ifdef HAVE_RECVMMSG
+    sys->pool = vlc_access_pool_New( MRU, 2 * UDP_BATCH );
+    if( unlikely(sys->pool == NULL) )
+    {
+        net_Close( sys->fd );
+        return VLC_ENOMEM;
+    }
+#endif
+
     return VLC_SUCCESS;
 }
 
@@ -228,6 +376,11 @@ static void Close( vlc_object_t *p_this )
     stream_t     *p_access = (stream_t*)p_this;
     access_sys_t *sys = p_access->p_sys;
 
+#ifdef HAVE_RECVMMSG
+    block_ChainRelease( sys->queue );
+    block_ChainRelease( sys->spare );
+    vlc_access_pool_Release( sys->pool, p_access );
+#endif
     net_Close( sys->fd );
 }
 
@@ -144,6 +144,61 @@ static struct vlc_v4l2_buffer *AllocateBuffer(struct vlc_v4l2_buffers *pool,
     return buf;
 }
 
+/**
+ * Appends one buffer to a started pool.
+ *
+ * The copy fallback in GrabVideo() costs a full frame copy, so growing the
+ * pool is always cheaper as long as the driver accepts more buffers.
+ */
+static void GrowPool(vlc_object_t *obj, struct vlc_v4l2_buffers *pool)
+{
+    struct v4l2_create_buffers cbuf = {
+        .count = 1,
+        .memory = V4L2_MEMORY_MMAP,
+        .format = pool->format,
+    };
+
+    vlc_mutex_lock(&pool->lock);
+    int fd = pool->fd;
+
+    if (fd < 0 || pool->count >= VIDEO_MAX_FRAME) {
+        pool->can_grow = false;
+        vlc_mutex_unlock(&pool->lock);
+        return;
+    }
+
+    if (v4l2_ioctl(fd, VIDIOC_CREATE_BUFS, &cbuf) < 0 || cbuf.count == 0) {
+        pool->can_grow = false;
+        vlc_mutex_unlock(&pool->lock);
+        msg_Warn(obj, "cannot add capture buffers: %s (copying frames)",
+                 vlc_strerror_c(errno));
+        return;
+    }
+
+    size_t count = cbuf.index + cbuf.count;
+    struct vlc_v4l2_buffer **bufs = realloc(pool->bufs,
+                                            count * sizeof (bufs[0]));
+    if (unlikely(bufs == NULL)) {
+        pool->can_grow = false;
+        vlc_mutex_unlock(&pool->lock);
+        return;
+    }
+
+    for (size_t i = pool->count; i < count; i++)
+        bufs[i] = NULL;
+    pool->bufs = bufs;
+    pool->count = count;
+
+    for (uint32_t index = cbuf.index; index < cbuf.index + cbuf.count; index++)
+        if (AllocateBuffer(pool, index) != NULL)
+            atomic_fetch_add(&pool->unused, 1);
+        else
+            pool->can_grow = false;
+
+    vlc_mutex_unlock(&pool->lock);
+    msg_Dbg(obj, "capture buffer pool grown to %zu buffers", count);
+}
+
 block_t *GrabVideo(vlc_object_t *demux, struct vlc_v4l2_buffers *restrict pool)
 {
     int fd = pool->fd;
@@ -184,9 +239,17 @@ block_t *GrabVideo(vlc_object_t *demux, struct vlc_v4l2_buffers *restrict pool)
     block->p_next = NULL;
 
     if (atomic_fetch_sub(&pool->unused, 1) <= 2) {
-        /* Running out of buffers! Memory copy forced. */
-        block = block_Duplicate(block);
-        block_Release(&buf->block);
+        /* Running out of buffers: the consumer is retaining most of the
+         * pool, typically a transcode pipeline. Add a buffer instead of
+         * copying the frame whenever the driver supports it. */
+        if (pool->can_grow)
+            GrowPool(demux, pool);
+
+        if (!pool->can_grow) {
+            /* Running out of buffers! Memory copy forced. */
+            block = block_Duplicate(block);
+            block_Release(&buf->block);
+        }
     }
 
     block->i_pts = block->i_dts = GetBufferPTS(&buf_req);
@@ -236,6 +299,12 @@ struct vlc_v4l2_buffers *StartMmap(vlc_object_t *obj, int fd)
     vlc_atomic_rc_init(&pool->refs);
     vlc_mutex_init(&pool->lock);
 
+    /* Keep the negotiated format at hand so that the pool can be grown
+     * with VIDIOC_CREATE_BUFS if the consumer retains too many buffers. */
+    memset(&pool->format, 0, sizeof (pool->format));
+    pool->format.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    pool->can_grow = v4l2_ioctl(fd, VIDIOC_G_FMT, &pool->format) >= 0;
+
     for (uint32_t index = 0; index < req.count; index++)
     {
         struct vlc_v4l2_buffer *buf = AllocateBuffer(pool, index);
@@ -53,6 +53,8 @@ struct vlc_v4l2_buffers {
     int fd;
     vlc_atomic_rc_t refs;
     _Atomic size_t unused;
+    struct v4l2_format format; /**< Negotiated format (to grow the pool) */
+    bool can_grow; /**< Whether more buffers can be added to the pool */
     vlc_mutex_t lock;
 };
 
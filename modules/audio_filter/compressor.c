@@ -351,10 +351,12 @@ static block_t * DoWork( filter_t * p_filter, block_t * p_in_buf )
 
         /* Find the peak value of current sample.  This becomes the new delayed
          * buffer value that replaces the old one in the lookahead array */
-        f_lev_in_new = fabs( pf_buf[0] );
+        /* Use the single precision fabsf() so the loop stays in float and
+         * can be vectorized */
+        f_lev_in_new = fabsf( pf_buf[0] );
         for( int i_chan = 1; i_chan < i_channels; i_chan++ )
         {
-            f_lev_in_new = Max( f_lev_in_new, fabs( pf_buf[i_chan] ) );
+            f_lev_in_new = Max( f_lev_in_new, fabsf( pf_buf[i_chan] ) );
         }
         p_la->p_buf[p_la->i_pos].f_lev_in = f_lev_in_new;
 
@@ -608,17 +610,19 @@ static float RmsEnvProcess( rms_env * p_r, const float f_x )
 static void BufferProcess( float * pf_buf, int i_channels, float f_gain,
                            float f_mug, lookahead * p_la )
 {
+    const float f_out_gain = f_gain * f_mug;
+    float *pf_vals = p_la->p_buf[p_la->i_pos].pf_vals;
+
     /* Loop through every channel */
     for( int i_chan = 0; i_chan < i_channels; i_chan++ )
     {
         float f_x = pf_buf[i_chan]; /* Current buffer value */
 
         /* Output the compressed delayed buffer value */
-        pf_buf[i_chan] = p_la->p_buf[p_la->i_pos].pf_vals[i_chan]
-                       * f_gain * f_mug;
+        pf_buf[i_chan] = pf_vals[i_chan] * f_out_gain;
 
         /* Update the delayed buffer value */
-        p_la->p_buf[p_la->i_pos].pf_vals[i_chan] = f_x;
+        pf_vals[i_chan] = f_x;
     }
 
     /* Go to the next delayed buffer value for the next run */
@@ -37,6 +37,7 @@
 #include <vlc_plugin.h>
 #include <vlc_aout.h>
 #include <vlc_block.h>
+#include <vlc_cpu.h>
 #include <vlc_filter.h>
 
 /*****************************************************************************
@@ -441,6 +442,258 @@ static block_t *Fl64toS32(filter_t *filter, block_t *b)
 }
 
 
+/*****************************************************************************
+ * Accelerated variants of the hottest paths (FL32<->S16)
+ *****************************************************************************/
+
+#if defined(__i386__) || defined(__x86_64__)
+# ifdef HAVE_SSE2_INTRINSICS
+#  include <emmintrin.h>
+
+#  ifdef __SSE2__
+#   define VLC_TARGET_SSE2
+#  else
+#   define VLC_TARGET_SSE2 __attribute__ ((__target__ ("sse2")))
+#  endif
+
+static bool CPU_SSE2(void)
+{
+    return vlc_CPU_SSE2();
+}
+
+VLC_TARGET_SSE2
+static block_t *Fl32toS16_SSE2(filter_t *filter, block_t *b)
+{
+    VLC_UNUSED(filter);
+    float   *src = (float *)b->p_buffer;
+    int16_t *dst = (int16_t *)src;
+    size_t i = b->i_buffer / 4;
+
+    const __m128 scale = _mm_set1_ps(32768.f);
+    const __m128 vmax = _mm_set1_ps(32767.f);
+    const __m128 vmin = _mm_set1_ps(-32768.f);
+
+    /* The product is clamped before conversion: unlike the scalar trick,
+     * _mm_cvtps_epi32() maps positive overflow to INT32_MIN */
+    while (i >= 8) {
+        __m128 f0 = _mm_loadu_ps(src);
+        __m128 f1 = _mm_loadu_ps(src + 4);
+        f0 = _mm_max_ps(_mm_min_ps(_mm_mul_ps(f0, scale), vmax), vmin);
+        f1 = _mm_max_ps(_mm_min_ps(_mm_mul_ps(f1, scale), vmax), vmin);
+        _mm_storeu_si128((__m128i *)dst,
+                         _mm_packs_epi32(_mm_cvtps_epi32(f0),
+                                         _mm_cvtps_epi32(f1)));
+        src += 8;
+        dst += 8;
+        i -= 8;
+    }
+
+    while (i-- > 0) {
+        float s = *src++ * 32768.f;
+        if (s >= 32767.f)
+            *dst++ = 32767;
+        else if (s <= -32768.f)
+            *dst++ = -32768;
+        else
+            *dst++ = lroundf(s);
+    }
+
+    b->i_buffer /= 2;
+    return b;
+}
+
+VLC_TARGET_SSE2
+static block_t *S16toFl32_SSE2(filter_t *filter, block_t *bsrc)
+{
+    block_t *bdst = block_Alloc(bsrc->i_buffer * 2);
+    if (unlikely(bdst == NULL))
+        goto out;
+
+    block_CopyProperties(bdst, bsrc);
+    int16_t *src = (int16_t *)bsrc->p_buffer;
+    float   *dst = (float *)bdst->p_buffer;
+    size_t i = bsrc->i_buffer / 2;
+
+    const __m128 scale = _mm_set1_ps(1.f / 32768.f);
+
+    while (i >= 8) {
+        __m128i s = _mm_loadu_si128((const __m128i *)src);
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16);
+        _mm_storeu_ps(dst,     _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(dst + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+        src += 8;
+        dst += 8;
+        i -= 8;
+    }
+
+    while (i-- > 0)
+        *dst++ = (float)*src++ / 32768.f;
+out:
+    block_Release(bsrc);
+    VLC_UNUSED(filter);
+    return bdst;
+}
+# endif /* HAVE_SSE2_INTRINSICS */
+
+# ifdef HAVE_AVX2_INTRINSICS
+#  include <immintrin.h>
+
+#  ifdef __AVX2__
+#   define VLC_TARGET_AVX2
+#  else
+#   define VLC_TARGET_AVX2 __attribute__ ((__target__ ("avx2")))
+#  endif
+
+static bool CPU_AVX2(void)
+{
+    return vlc_CPU_AVX2();
+}
+
+VLC_TARGET_AVX2
+static block_t *Fl32toS16_AVX2(filter_t *filter, block_t *b)
+{
+    VLC_UNUSED(filter);
+    float   *src = (float *)b->p_buffer;
+    int16_t *dst = (int16_t *)src;
+    size_t i = b->i_buffer / 4;
+
+    const __m256 scale = _mm256_set1_ps(32768.f);
+    const __m256 vmax = _mm256_set1_ps(32767.f);
+    const __m256 vmin = _mm256_set1_ps(-32768.f);
+
+    while (i >= 16) {
+        __m256 f0 = _mm256_loadu_ps(src);
+        __m256 f1 = _mm256_loadu_ps(src + 8);
+        f0 = _mm256_max_ps(_mm256_min_ps(_mm256_mul_ps(f0, scale), vmax), vmin);
+        f1 = _mm256_max_ps(_mm256_min_ps(_mm256_mul_ps(f1, scale), vmax), vmin);
+        __m256i s = _mm256_packs_epi32(_mm256_cvtps_epi32(f0),
+                                       _mm256_cvtps_epi32(f1));
+        /* The pack interleaves the two 128 bits lanes */
+        s = _mm256_permute4x64_epi64(s, _MM_SHUFFLE(3, 1, 2, 0));
+        _mm256_storeu_si256((__m256i *)dst, s);
+        src += 16;
+        dst += 16;
+        i -= 16;
+    }
+
+    while (i-- > 0) {
+        float s = *src++ * 32768.f;
+        if (s >= 32767.f)
+            *dst++ = 32767;
+        else if (s <= -32768.f)
+            *dst++ = -32768;
+        else
+            *dst++ = lroundf(s);
+    }
+
+    b->i_buffer /= 2;
+    return b;
+}
+
+VLC_TARGET_AVX2
+static block_t *S16toFl32_AVX2(filter_t *filter, block_t *bsrc)
+{
+    block_t *bdst = block_Alloc(bsrc->i_buffer * 2);
+    if (unlikely(bdst == NULL))
+        goto out;
+
+    block_CopyProperties(bdst, bsrc);
+    int16_t *src = (int16_t *)bsrc->p_buffer;
+    float   *dst = (float *)bdst->p_buffer;
+    size_t i = bsrc->i_buffer / 2;
+
+    const __m256 scale = _mm256_set1_ps(1.f / 32768.f);
+
+    while (i >= 16) {
+        __m256i lo = _mm256_cvtepi16_epi32(
+            _mm_loadu_si128((const __m128i *)src));
+        __m256i hi = _mm256_cvtepi16_epi32(
+            _mm_loadu_si128((const __m128i *)(src + 8)));
+        _mm256_storeu_ps(dst,
+                         _mm256_mul_ps(_mm256_cvtepi32_ps(lo), scale));
+        _mm256_storeu_ps(dst + 8,
+                         _mm256_mul_ps(_mm256_cvtepi32_ps(hi), scale));
+        src += 16;
+        dst += 16;
+        i -= 16;
+    }
+
+    while (i-- > 0)
+        *dst++ = (float)*src++ / 32768.f;
+out:
+    block_Release(bsrc);
+    VLC_UNUSED(filter);
+    return bdst;
+}
+# endif /* HAVE_AVX2_INTRINSICS */
+
+#elif defined(__aarch64__)
+# include <arm_neon.h>
+
+static block_t *Fl32toS16_NEON(filter_t *filter, block_t *b)
+{
+    VLC_UNUSED(filter);
+    float   *src = (float *)b->p_buffer;
+    int16_t *dst = (int16_t *)src;
+    size_t i = b->i_buffer / 4;
+
+    while (i >= 8) {
+        /* vcvtnq saturates to the int32 range, vqmovn to the int16 range */
+        int32x4_t i0 = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(src), 32768.f));
+        int32x4_t i1 = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(src + 4),
+                                                  32768.f));
+        vst1q_s16(dst, vcombine_s16(vqmovn_s32(i0), vqmovn_s32(i1)));
+        src += 8;
+        dst += 8;
+        i -= 8;
+    }
+
+    while (i-- > 0) {
+        float s = *src++ * 32768.f;
+        if (s >= 32767.f)
+            *dst++ = 32767;
+        else if (s <= -32768.f)
+            *dst++ = -32768;
+        else
+            *dst++ = lroundf(s);
+    }
+
+    b->i_buffer /= 2;
+    return b;
+}
+
+static block_t *S16toFl32_NEON(filter_t *filter, block_t *bsrc)
+{
+    block_t *bdst = block_Alloc(bsrc->i_buffer * 2);
+    if (unlikely(bdst == NULL))
+        goto out;
+
+    block_CopyProperties(bdst, bsrc);
+    int16_t *src = (int16_t *)bsrc->p_buffer;
+    float   *dst = (float *)bdst->p_buffer;
+    size_t i = bsrc->i_buffer / 2;
+
+    while (i >= 8) {
+        int16x8_t s = vld1q_s16(src);
+        float32x4_t f0 = vcvtq_f32_s32(vmovl_s16(vget_low_s16(s)));
+        float32x4_t f1 = vcvtq_f32_s32(vmovl_s16(vget_high_s16(s)));
+        vst1q_f32(dst,     vmulq_n_f32(f0, 1.f / 32768.f));
+        vst1q_f32(dst + 4, vmulq_n_f32(f1, 1.f / 32768.f));
+        src += 8;
+        dst += 8;
+        i -= 8;
+    }
+
+    while (i-- > 0)
+        *dst++ = (float)*src++ / 32768.f;
+out:
+    block_Release(bsrc);
+    VLC_UNUSED(filter);
+    return bdst;
+}
+#endif
+
 /* */
 /* */
 static const struct {
@@ -476,8 +729,39 @@ static const struct {
     { 0, 0, { .filter_audio = NULL } }
 };
 
+/* Accelerated replacements for some of the conversions above, tried in
+ * order: the first entry whose CPU requirements are met wins. */
+static const struct {
+    vlc_fourcc_t src;
+    vlc_fourcc_t dst;
+    bool (*supported)(void);
+    struct vlc_filter_operations convert;
+} cvt_accels[] = {
+#if defined(__i386__) || defined(__x86_64__)
+# ifdef HAVE_AVX2_INTRINSICS
+    { VLC_CODEC_FL32, VLC_CODEC_S16N, CPU_AVX2, { .filter_audio = Fl32toS16_AVX2 } },
+    { VLC_CODEC_S16N, VLC_CODEC_FL32, CPU_AVX2, { .filter_audio = S16toFl32_AVX2 } },
+# endif
+# ifdef HAVE_SSE2_INTRINSICS
+    { VLC_CODEC_FL32, VLC_CODEC_S16N, CPU_SSE2, { .filter_audio = Fl32toS16_SSE2 } },
+    { VLC_CODEC_S16N, VLC_CODEC_FL32, CPU_SSE2, { .filter_audio = S16toFl32_SSE2 } },
+# endif
+#elif defined(__aarch64__)
+    { VLC_CODEC_FL32, VLC_CODEC_S16N, NULL, { .filter_audio = Fl32toS16_NEON } },
+    { VLC_CODEC_S16N, VLC_CODEC_FL32, NULL, { .filter_audio = S16toFl32_NEON } },
+#endif
+    { 0, 0, NULL, { .filter_audio = NULL } }
+};
+
 static const struct vlc_filter_operations *FindConversion(vlc_fourcc_t src, vlc_fourcc_t dst)
 {
+    for (int i = 0; cvt_accels[i].convert.filter_audio; i++) {
+        if (cvt_accels[i].src == src &&
+            cvt_accels[i].dst == dst &&
+            (cvt_accels[i].supported == NULL || cvt_accels[i].supported()))
+            return &cvt_accels[i].convert;
+    }
+
     for (int i = 0; cvt_directs[i].convert.filter_audio; i++) {
         if (cvt_directs[i].src == src &&
             cvt_directs[i].dst == dst)
@@ -112,13 +112,22 @@ typedef struct
     float f_gamp;   /* Global preamp */
     bool b_2eqz;
 
-    /* Filter state */
+    /* Filter state. The two delayed outputs of each band are kept in
+     * separate planar arrays so that the per-band loop reads contiguous
+     * memory and can be vectorized by the compiler. */
     float x[32][2];
-    float y[32][128][2];
+    float y0[32][128];
+    float y1[32][128];
 
     /* Second filter state */
     float x2[32][2];
-    float y2[32][128][2];
+    float y2_0[32][128];
+    float y2_1[32][128];
+
+    /* Bands with a zero gain contribute nothing and are skipped.
+     * The table is rebuilt whenever the band gains change. */
+    int i_active;
+    int band_active[EQZ_BANDS_MAX];
 
     vlc_mutex_t lock;
 } filter_sys_t;
@@ -314,6 +323,7 @@ static int EqzInit( filter_t *p_filter, int i_rate )
     {
         p_sys->f_amp[i] = 0.0f;
     }
+    p_sys->i_active = 0;
 
     /* Filter state */
     for( ch = 0; ch < 32; ch++ )
@@ -325,10 +335,10 @@ static int EqzInit( filter_t *p_filter, int i_rate )
 
         for( i = 0; i < p_sys->i_band; i++ )
         {
-            p_sys->y[ch][i][0]  =
-            p_sys->y[ch][i][1]  =
-            p_sys->y2[ch][i][0] =
-            p_sys->y2[ch][i][1] = 0.0f;
+            p_sys->y0[ch][i]   =
+            p_sys->y1[ch][i]   =
+            p_sys->y2_0[ch][i] =
+            p_sys->y2_1[ch][i] = 0.0f;
         }
     }
 
@@ -385,65 +395,107 @@ error:
     return i_ret;
 }
 
+/* Frames per deinterleaved block pass */
+#define EQZ_BLOCK 256
+
+/* Runs all the active bands over one block of a deinterleaved channel.
+ * xdiff[n] holds x[n] - x[n-2]; obuf receives the weighted band sum.
+ * The biquad recursion is serial in time, so each band is run over the
+ * whole block with its state kept in registers instead of reloading the
+ * per-band state arrays for every sample. */
+static void EqzBandPass( filter_sys_t *p_sys, int ch, bool b_second,
+                         const float *restrict xdiff,
+                         float *restrict obuf, int i_frames )
+{
+    float *y0s = b_second ? p_sys->y2_0[ch] : p_sys->y0[ch];
+    float *y1s = b_second ? p_sys->y2_1[ch] : p_sys->y1[ch];
+
+    memset( obuf, 0, i_frames * sizeof (*obuf) );
+
+    for( int k = 0; k < p_sys->i_active; k++ )
+    {
+        const int j = p_sys->band_active[k];
+        const float f_alpha = p_sys->f_alpha[j];
+        const float f_beta  = p_sys->f_beta[j];
+        const float f_gamma = p_sys->f_gamma[j];
+        const float f_amp   = p_sys->f_amp[j];
+        float y0 = y0s[j];
+        float y1 = y1s[j];
+
+        for( int n = 0; n < i_frames; n++ )
+        {
+            const float y = f_alpha * xdiff[n] + f_gamma * y0 - f_beta * y1;
+
+            y1 = y0;
+            y0 = y;
+
+            obuf[n] += y * f_amp;
+        }
+        y0s[j] = y0;
+        y1s[j] = y1;
+    }
+}
+
 static void EqzFilter( filter_t *p_filter, float *out, float *in,
                        int i_samples, int i_channels )
 {
     filter_sys_t *p_sys = p_filter->p_sys;
-    int i, ch, j;
+    float xbuf[2 + EQZ_BLOCK], x2buf[2 + EQZ_BLOCK];
+    float xdiff[EQZ_BLOCK], obuf[EQZ_BLOCK];
+    int i, ch, n;
 
     vlc_mutex_lock( &p_sys->lock );
-    for( i = 0; i < i_samples; i++ )
+
+    for( i = 0; i < i_samples; i += n )
     {
+        n = __MIN( i_samples - i, EQZ_BLOCK );
+
         for( ch = 0; ch < i_channels; ch++ )
         {
-            const float x = in[ch];
-            float o = 0.0f;
-
-            for( j = 0; j < p_sys->i_band; j++ )
-            {
-                float y = p_sys->f_alpha[j] * ( x - p_sys->x[ch][1] ) +
-                          p_sys->f_gamma[j] * p_sys->y[ch][j][0] -
-                          p_sys->f_beta[j]  * p_sys->y[ch][j][1];
-
-                p_sys->y[ch][j][1] = p_sys->y[ch][j][0];
-                p_sys->y[ch][j][0] = y;
-
-                o += y * p_sys->f_amp[j];
-            }
-            p_sys->x[ch][1] = p_sys->x[ch][0];
-            p_sys->x[ch][0] = x;
+            const float *pin = in + i * i_channels + ch;
+            float *pout = out + i * i_channels + ch;
+
+            /* Deinterleave one channel, keeping two frames of history
+             * for the difference input of the band filters */
+            xbuf[0] = p_sys->x[ch][1];
+            xbuf[1] = p_sys->x[ch][0];
+            for( int k = 0; k < n; k++ )
+                xbuf[2 + k] = pin[k * i_channels];
+            for( int k = 0; k < n; k++ )
+                xdiff[k] = xbuf[2 + k] - xbuf[k];
+            p_sys->x[ch][1] = xbuf[n];
+            p_sys->x[ch][0] = xbuf[n + 1];
+
+            EqzBandPass( p_sys, ch, false, xdiff, obuf, n );
 
             /* Second filter */
             if( p_sys->b_2eqz )
             {
-                const float x2 = EQZ_IN_FACTOR * x + o;
-                o = 0.0f;
-                for( j = 0; j < p_sys->i_band; j++ )
-                {
-                    float y = p_sys->f_alpha[j] * ( x2 - p_sys->x2[ch][1] ) +
-                              p_sys->f_gamma[j] * p_sys->y2[ch][j][0] -
-                              p_sys->f_beta[j]  * p_sys->y2[ch][j][1];
-
-                    p_sys->y2[ch][j][1] = p_sys->y2[ch][j][0];
-                    p_sys->y2[ch][j][0] = y;
-
-                    o += y * p_sys->f_amp[j];
-                }
-                p_sys->x2[ch][1] = p_sys->x2[ch][0];
-                p_sys->x2[ch][0] = x2;
+                x2buf[0] = p_sys->x2[ch][1];
+                x2buf[1] = p_sys->x2[ch][0];
+                for( int k = 0; k < n; k++ )
+                    x2buf[2 + k] = EQZ_IN_FACTOR * xbuf[2 + k] + obuf[k];
+                for( int k = 0; k < n; k++ )
+                    xdiff[k] = x2buf[2 + k] - x2buf[k];
+                p_sys->x2[ch][1] = x2buf[n];
+                p_sys->x2[ch][0] = x2buf[n + 1];
+
+                EqzBandPass( p_sys, ch, true, xdiff, obuf, n );
 
                 /* We add source PCM + filtered PCM */
-                out[ch] = p_sys->f_gamp * p_sys->f_gamp *( EQZ_IN_FACTOR * x2 + o );
+                const float f_gain = p_sys->f_gamp * p_sys->f_gamp;
+                for( int k = 0; k < n; k++ )
+                    pout[k * i_channels] =
+                        f_gain * ( EQZ_IN_FACTOR * x2buf[2 + k] + obuf[k] );
             }
             else
             {
                 /* We add source PCM + filtered PCM */
-                out[ch] = p_sys->f_gamp *( EQZ_IN_FACTOR * x + o );
+                for( int k = 0; k < n; k++ )
+                    pout[k * i_channels] =
+                        p_sys->f_gamp * ( EQZ_IN_FACTOR * xbuf[2 + k] + obuf[k] );
             }
         }
-
-        in  += i_channels;
-        out += i_channels;
     }
     vlc_mutex_unlock( &p_sys->lock );
 }
@@ -559,6 +611,21 @@ static int BandsCallback( vlc_object_t *p_this, char const *psz_cmd,
     }
     while( i < p_sys->i_band )
         p_sys->f_amp[i++] = EqzConvertdB( 0.f );
+
+    /* Rebuild the active band table, resetting the state of muted bands
+     * so they restart cleanly when re-enabled */
+    p_sys->i_active = 0;
+    for( int j = 0; j < p_sys->i_band; j++ )
+    {
+        if( p_sys->f_amp[j] != 0.f )
+            p_sys->band_active[p_sys->i_active++] = j;
+        else
+            for( int ch = 0; ch < 32; ch++ )
+            {
+                p_sys->y0[ch][j]   = p_sys->y1[ch][j]   = 0.f;
+                p_sys->y2_0[ch][j] = p_sys->y2_1[ch][j] = 0.f;
+            }
+    }
     vlc_mutex_unlock( &p_sys->lock );
     return VLC_SUCCESS;
 }
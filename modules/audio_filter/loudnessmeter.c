@@ -0,0 +1,524 @@
+/*****************************************************************************
+ * loudnessmeter.c : EBU R128 loudness meter
+ *****************************************************************************
+ * Copyright © 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+/* Native implementation of ITU-R BS.1770-4 / EBU R128 loudness measurement.
+ *
+ * Unlike the libebur128 wrapper, this meter processes whole FL32 blocks with
+ * the K-weighting biquads and the true-peak polyphase interpolator written as
+ * dense planar loops that compilers can vectorize, which matters when many
+ * streams are monitored at once. Integrated loudness and loudness range use
+ * fixed-size 0.1 LU histograms, so memory stays constant regardless of the
+ * stream duration. */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <math.h>
+
+#include <vlc_common.h>
+#include <vlc_aout.h>
+#include <vlc_filter.h>
+#include <vlc_plugin.h>
+
+#define UPDATE_INTERVAL VLC_TICK_FROM_MS(400)
+
+/* Gating step: 100 ms sub-blocks, 400 ms momentary window with 75% overlap,
+ * 3 s short-term window */
+#define MOMENTARY_SUBBLOCKS  4
+#define SHORTTERM_SUBBLOCKS  30
+
+/* Loudness histograms: 0.1 LU bins covering [-70, +5] LUFS */
+#define HIST_MIN   (-70.0)
+#define HIST_STEP  0.1
+#define HIST_BINS  751
+
+/* True-peak estimation: 4x oversampling, 12-tap polyphase FIR phases */
+#define TP_RATIO   4
+#define TP_TAPS    12
+
+struct meter_sys
+{
+    unsigned channels;
+    bool measure_shortterm;
+    bool measure_integrated;
+    bool measure_range;
+    bool measure_truepeak;
+
+    /* BS.1770 channel weights (0 for LFE, 1.41 for surrounds) */
+    float weight[AOUT_CHAN_MAX];
+
+    /* K-weighting: shelving then high-pass biquad, direct form II
+     * transposed. The per-channel states are planar so that the channel
+     * loop reads contiguous memory and vectorizes. */
+    float shelf_b[3], shelf_a[2];
+    float hpf_b[3], hpf_a[2];
+    float shelf_z1[AOUT_CHAN_MAX], shelf_z2[AOUT_CHAN_MAX];
+    float hpf_z1[AOUT_CHAN_MAX], hpf_z2[AOUT_CHAN_MAX];
+
+    /* Ring of weighted K-filtered energies per 100 ms sub-block */
+    size_t subblock_frames;
+    size_t subblock_fill;
+    double subblock_energy;
+    double window[SHORTTERM_SUBBLOCKS];
+    unsigned window_pos;
+    unsigned window_count;
+
+    /* Integrated loudness: absolute-gated momentary blocks */
+    unsigned *block_hist;
+    double *block_hist_energy;
+
+    /* Loudness range: absolute-gated short-term loudness values */
+    unsigned *st_hist;
+
+    /* True peak: per-phase FIR taps and per-channel input history ring */
+    float tp_taps[TP_RATIO][TP_TAPS];
+    float tp_hist[AOUT_CHAN_MAX][TP_TAPS];
+    unsigned tp_pos;
+    double truepeak; /* linear amplitude, running maximum */
+
+    vlc_tick_t last_update;
+    bool new_frames;
+};
+
+static double EnergyToLoudness(double energy)
+{
+    return -0.691 + 10.0 * log10(energy);
+}
+
+static double BinToEnergy(unsigned bin)
+{
+    double loudness = HIST_MIN + (bin + 0.5) * HIST_STEP;
+    return pow(10.0, (loudness + 0.691) / 10.0);
+}
+
+static int LoudnessToBin(double loudness)
+{
+    if (loudness < HIST_MIN)
+        return -1;
+    int bin = (int)((loudness - HIST_MIN) / HIST_STEP);
+    return bin >= HIST_BINS ? HIST_BINS - 1 : bin;
+}
+
+/* BS.1770-4 K-weighting coefficients, pre-warped for the sample rate
+ * (same constants as the reference 48 kHz filter) */
+static void InitKWeighting(struct meter_sys *sys, unsigned rate)
+{
+    double f0 = 1681.974450955533;
+    double G = 3.999843853973347;
+    double Q = 0.7071752369554196;
+
+    double K = tan(M_PI * f0 / rate);
+    double Vh = pow(10.0, G / 20.0);
+    double Vb = pow(Vh, 0.4996667741545416);
+    double a0 = 1.0 + K / Q + K * K;
+
+    sys->shelf_b[0] = (Vh + Vb * K / Q + K * K) / a0;
+    sys->shelf_b[1] = 2.0 * (K * K - Vh) / a0;
+    sys->shelf_b[2] = (Vh - Vb * K / Q + K * K) / a0;
+    sys->shelf_a[0] = 2.0 * (K * K - 1.0) / a0;
+    sys->shelf_a[1] = (1.0 - K / Q + K * K) / a0;
+
+    f0 = 38.13547087602444;
+    Q = 0.5003270373238773;
+    K = tan(M_PI * f0 / rate);
+    a0 = 1.0 + K / Q + K * K;
+
+    sys->hpf_b[0] = 1.0;
+    sys->hpf_b[1] = -2.0;
+    sys->hpf_b[2] = 1.0;
+    sys->hpf_a[0] = 2.0 * (K * K - 1.0) / a0;
+    sys->hpf_a[1] = (1.0 - K / Q + K * K) / a0;
+}
+
+/* Windowed-sinc interpolation low-pass, split into TP_RATIO phases */
+static void InitTruePeakTaps(struct meter_sys *sys)
+{
+    const int length = TP_RATIO * TP_TAPS;
+    const double center = (length - 1) / 2.0;
+
+    for (int n = 0; n < length; n++)
+    {
+        double x = (n - center) / TP_RATIO;
+        double sinc = x == 0.0 ? 1.0 : sin(M_PI * x) / (M_PI * x);
+        double win = 0.5 * (1.0 - cos(2.0 * M_PI * n / (length - 1)));
+
+        sys->tp_taps[n % TP_RATIO][n / TP_RATIO] = sinc * win;
+    }
+}
+
+static void ResetMeasurement(struct meter_sys *sys)
+{
+    for (unsigned i = 0; i < AOUT_CHAN_MAX; i++)
+    {
+        sys->shelf_z1[i] = sys->shelf_z2[i] = 0.f;
+        sys->hpf_z1[i] = sys->hpf_z2[i] = 0.f;
+    }
+    memset(sys->tp_hist, 0, sizeof (sys->tp_hist));
+    sys->tp_pos = 0;
+    sys->truepeak = 0.0;
+
+    sys->subblock_fill = 0;
+    sys->subblock_energy = 0.0;
+    sys->window_pos = 0;
+    sys->window_count = 0;
+
+    if (sys->block_hist != NULL)
+    {
+        memset(sys->block_hist, 0, HIST_BINS * sizeof (*sys->block_hist));
+        memset(sys->block_hist_energy, 0,
+               HIST_BINS * sizeof (*sys->block_hist_energy));
+    }
+    if (sys->st_hist != NULL)
+        memset(sys->st_hist, 0, HIST_BINS * sizeof (*sys->st_hist));
+
+    sys->last_update = VLC_TICK_INVALID;
+    sys->new_frames = false;
+}
+
+/* Mean energy of the last 'subblocks' sub-blocks */
+static double WindowEnergy(const struct meter_sys *sys, unsigned subblocks)
+{
+    double sum = 0.0;
+
+    for (unsigned i = 0; i < subblocks; i++)
+    {
+        unsigned pos = (sys->window_pos + SHORTTERM_SUBBLOCKS - 1 - i)
+                     % SHORTTERM_SUBBLOCKS;
+        sum += sys->window[pos];
+    }
+    return sum / (subblocks * sys->subblock_frames);
+}
+
+/* A 100 ms sub-block is complete: update the gating histograms */
+static void PushSubBlock(struct meter_sys *sys)
+{
+    sys->window[sys->window_pos] = sys->subblock_energy;
+    sys->window_pos = (sys->window_pos + 1) % SHORTTERM_SUBBLOCKS;
+    if (sys->window_count < SHORTTERM_SUBBLOCKS)
+        sys->window_count++;
+    sys->subblock_energy = 0.0;
+    sys->subblock_fill = 0;
+
+    if (sys->measure_integrated && sys->window_count >= MOMENTARY_SUBBLOCKS)
+    {
+        double energy = WindowEnergy(sys, MOMENTARY_SUBBLOCKS);
+        int bin = LoudnessToBin(EnergyToLoudness(energy));
+        if (bin >= 0) /* -70 LUFS absolute gate */
+        {
+            sys->block_hist[bin]++;
+            sys->block_hist_energy[bin] += energy;
+        }
+    }
+
+    if (sys->measure_range && sys->window_count >= SHORTTERM_SUBBLOCKS)
+    {
+        int bin = LoudnessToBin(EnergyToLoudness(
+                        WindowEnergy(sys, SHORTTERM_SUBBLOCKS)));
+        if (bin >= 0)
+            sys->st_hist[bin]++;
+    }
+}
+
+/* Integrated loudness: -70 LUFS absolute gate (enforced at insertion),
+ * then a relative gate 10 LU below the absolute-gated mean */
+static double IntegratedLoudness(const struct meter_sys *sys)
+{
+    double energy = 0.0;
+    uint64_t count = 0;
+
+    for (unsigned bin = 0; bin < HIST_BINS; bin++)
+    {
+        energy += sys->block_hist_energy[bin];
+        count += sys->block_hist[bin];
+    }
+    if (count == 0)
+        return 0.0;
+
+    double gate = EnergyToLoudness(energy / count) - 10.0;
+
+    energy = 0.0;
+    count = 0;
+    for (unsigned bin = 0; bin < HIST_BINS; bin++)
+    {
+        if (HIST_MIN + (bin + 0.5) * HIST_STEP < gate)
+            continue;
+        energy += sys->block_hist_energy[bin];
+        count += sys->block_hist[bin];
+    }
+    return count == 0 ? 0.0 : EnergyToLoudness(energy / count);
+}
+
+/* Loudness range (EBU Tech 3342): relative gate 20 LU below the
+ * absolute-gated mean, then the 10th to 95th percentile spread */
+static double LoudnessRange(const struct meter_sys *sys)
+{
+    double energy = 0.0;
+    uint64_t count = 0;
+
+    for (unsigned bin = 0; bin < HIST_BINS; bin++)
+    {
+        energy += sys->st_hist[bin] * BinToEnergy(bin);
+        count += sys->st_hist[bin];
+    }
+    if (count == 0)
+        return 0.0;
+
+    double gate = EnergyToLoudness(energy / count) - 20.0;
+    unsigned first_bin = 0;
+    while (first_bin < HIST_BINS
+        && HIST_MIN + (first_bin + 0.5) * HIST_STEP < gate)
+        first_bin++;
+
+    count = 0;
+    for (unsigned bin = first_bin; bin < HIST_BINS; bin++)
+        count += sys->st_hist[bin];
+    if (count == 0)
+        return 0.0;
+
+    uint64_t low_rank = (uint64_t)((count - 1) * 0.10);
+    uint64_t high_rank = (uint64_t)((count - 1) * 0.95);
+    double low = 0.0, high = 0.0;
+    uint64_t seen = 0;
+
+    for (unsigned bin = first_bin; bin < HIST_BINS; bin++)
+    {
+        if (sys->st_hist[bin] == 0)
+            continue;
+        if (seen <= low_rank)
+            low = HIST_MIN + (bin + 0.5) * HIST_STEP;
+        high = HIST_MIN + (bin + 0.5) * HIST_STEP;
+        seen += sys->st_hist[bin];
+        if (seen > high_rank)
+            break;
+    }
+    return high - low;
+}
+
+static void SendLoudnessMeter(filter_t *filter)
+{
+    struct meter_sys *sys = filter->p_sys;
+    struct vlc_audio_loudness loudness = { 0, 0, 0, 0, 0 };
+
+    if (sys->window_count >= MOMENTARY_SUBBLOCKS)
+        loudness.loudness_momentary =
+            EnergyToLoudness(WindowEnergy(sys, MOMENTARY_SUBBLOCKS));
+    if (sys->measure_shortterm && sys->window_count >= SHORTTERM_SUBBLOCKS)
+        loudness.loudness_shortterm =
+            EnergyToLoudness(WindowEnergy(sys, SHORTTERM_SUBBLOCKS));
+    if (sys->measure_integrated)
+        loudness.loudness_integrated = IntegratedLoudness(sys);
+    if (sys->measure_range)
+        loudness.loudness_range = LoudnessRange(sys);
+    if (sys->measure_truepeak && sys->truepeak > 0.0)
+        loudness.truepeak = 20.0 * log10(sys->truepeak);
+
+    filter_SendAudioLoudness(filter, &loudness);
+}
+
+static block_t *Process(filter_t *filter, block_t *block)
+{
+    struct meter_sys *sys = filter->p_sys;
+    const float *buf = (const float *)block->p_buffer;
+    const unsigned channels = sys->channels;
+
+    const float sb0 = sys->shelf_b[0], sb1 = sys->shelf_b[1],
+                sb2 = sys->shelf_b[2], sa1 = sys->shelf_a[0],
+                sa2 = sys->shelf_a[1];
+    const float hb0 = sys->hpf_b[0], hb1 = sys->hpf_b[1],
+                hb2 = sys->hpf_b[2], ha1 = sys->hpf_a[0],
+                ha2 = sys->hpf_a[1];
+
+    for (size_t i = 0; i < block->i_nb_samples; i++)
+    {
+        const float *frame = buf + i * channels;
+        float energy = 0.f;
+
+        /* The recursion is across frames only: the channel loop below is
+         * parallel and reads the planar state arrays contiguously */
+        for (unsigned ch = 0; ch < channels; ch++)
+        {
+            const float x = frame[ch];
+
+            float s = sb0 * x + sys->shelf_z1[ch];
+            sys->shelf_z1[ch] = sb1 * x - sa1 * s + sys->shelf_z2[ch];
+            sys->shelf_z2[ch] = sb2 * x - sa2 * s;
+
+            float y = hb0 * s + sys->hpf_z1[ch];
+            sys->hpf_z1[ch] = hb1 * s - ha1 * y + sys->hpf_z2[ch];
+            sys->hpf_z2[ch] = hb2 * s - ha2 * y;
+
+            energy += sys->weight[ch] * y * y;
+        }
+        sys->subblock_energy += energy;
+
+        if (sys->measure_truepeak)
+        {
+            const unsigned pos = sys->tp_pos;
+
+            for (unsigned ch = 0; ch < channels; ch++)
+                sys->tp_hist[ch][pos] = frame[ch];
+
+            for (unsigned phase = 0; phase < TP_RATIO; phase++)
+            {
+                const float *taps = sys->tp_taps[phase];
+
+                for (unsigned ch = 0; ch < channels; ch++)
+                {
+                    const float *hist = sys->tp_hist[ch];
+                    float acc = 0.f;
+
+                    for (unsigned t = 0; t < TP_TAPS; t++)
+                        acc += taps[t]
+                             * hist[(pos + TP_TAPS - t) % TP_TAPS];
+                    float peak = fabsf(acc);
+                    if (peak > sys->truepeak)
+                        sys->truepeak = peak;
+                }
+            }
+            sys->tp_pos = (pos + 1) % TP_TAPS;
+        }
+
+        if (++sys->subblock_fill == sys->subblock_frames)
+            PushSubBlock(sys);
+    }
+
+    if (sys->last_update == VLC_TICK_INVALID)
+        sys->last_update = block->i_pts;
+
+    if (block->i_pts + block->i_length - sys->last_update >= UPDATE_INTERVAL)
+    {
+        SendLoudnessMeter(filter);
+        sys->last_update = block->i_pts + block->i_length;
+        sys->new_frames = false;
+    }
+    else
+        sys->new_frames = true;
+
+    return block;
+}
+
+static void Flush(filter_t *filter)
+{
+    struct meter_sys *sys = filter->p_sys;
+
+    if (sys->new_frames)
+        SendLoudnessMeter(filter);
+    ResetMeasurement(sys);
+}
+
+static void Close(filter_t *filter)
+{
+    struct meter_sys *sys = filter->p_sys;
+
+    free(sys->block_hist);
+    free(sys->block_hist_energy);
+    free(sys->st_hist);
+    free(sys);
+}
+
+static const struct vlc_filter_operations filter_ops = {
+    .filter_audio = Process, .flush = Flush, .close = Close,
+};
+
+static int Open(vlc_object_t *this)
+{
+    filter_t *filter = (filter_t *)this;
+    const audio_sample_format_t *fmt = &filter->fmt_in.audio;
+
+    if (fmt->i_format != VLC_CODEC_FL32
+     || fmt->i_channels == 0 || fmt->i_channels > AOUT_CHAN_MAX
+     || fmt->i_rate < 8000)
+        return VLC_EGENERIC;
+
+    struct meter_sys *sys = calloc(1, sizeof (*sys));
+    if (unlikely(sys == NULL))
+        return VLC_ENOMEM;
+    filter->p_sys = sys;
+
+    sys->channels = fmt->i_channels;
+
+    /* Same measurement ladder as the libebur128 wrapper */
+    int mode = var_InheritInteger(filter, "ebur128-mode");
+    sys->measure_truepeak = mode >= 4;
+    sys->measure_range = mode >= 3;
+    sys->measure_integrated = mode >= 2;
+    sys->measure_shortterm = mode >= 1;
+
+    /* Assign BS.1770 weights following the WG4 interleaving order */
+    unsigned ch = 0;
+    for (unsigned i = 0; pi_vlc_chan_order_wg4[i] != 0 && ch < sys->channels;
+         i++)
+    {
+        uint32_t chan = pi_vlc_chan_order_wg4[i];
+        if (!(fmt->i_physical_channels & chan))
+            continue;
+
+        if (chan == AOUT_CHAN_LFE)
+            sys->weight[ch] = 0.f;
+        else if (chan & (AOUT_CHAN_MIDDLELEFT | AOUT_CHAN_MIDDLERIGHT
+                       | AOUT_CHAN_REARLEFT | AOUT_CHAN_REARRIGHT
+                       | AOUT_CHAN_REARCENTER))
+            sys->weight[ch] = 1.41f;
+        else
+            sys->weight[ch] = 1.f;
+        ch++;
+    }
+    for (; ch < sys->channels; ch++)
+        sys->weight[ch] = 1.f; /* unknown layout: assume frontal */
+
+    InitKWeighting(sys, fmt->i_rate);
+    InitTruePeakTaps(sys);
+
+    sys->subblock_frames = fmt->i_rate / 10; /* 100 ms */
+
+    if (sys->measure_integrated)
+    {
+        sys->block_hist = calloc(HIST_BINS, sizeof (*sys->block_hist));
+        sys->block_hist_energy =
+            calloc(HIST_BINS, sizeof (*sys->block_hist_energy));
+        if (sys->block_hist == NULL || sys->block_hist_energy == NULL)
+            goto error;
+    }
+    if (sys->measure_range)
+    {
+        sys->st_hist = calloc(HIST_BINS, sizeof (*sys->st_hist));
+        if (sys->st_hist == NULL)
+            goto error;
+    }
+
+    ResetMeasurement(sys);
+
+    filter->fmt_out.audio = filter->fmt_in.audio;
+    filter->ops = &filter_ops;
+    return VLC_SUCCESS;
+
+error:
+    Close(filter);
+    return VLC_ENOMEM;
+}
+
+vlc_module_begin()
+    set_shortname(N_("Loudness meter"))
+    set_description(N_("EBU R128 loudness meter"))
+    set_subcategory(SUBCAT_AUDIO_AFILTER)
+    set_capability("audio meter", 10)
+    set_callback(Open)
+vlc_module_end()
@@ -30,6 +30,7 @@
 #include <vlc_common.h>
 #include <vlc_plugin.h>
 #include <vlc_aout.h>
+#include <vlc_cpu.h>
 #include <vlc_filter.h>
 #include <vlc_modules.h>
 
@@ -128,6 +129,9 @@ typedef struct
     void     *buf_pre_corr;
     void     *table_window;
     unsigned(*best_overlap_offset)( filter_t *p_filter );
+    float   (*pf_dot)( const float *, const float *, size_t );
+    unsigned  frames_prev_best;
+    bool      b_prev_best_valid;
 #ifdef PITCH_SHIFTER
     /* pitch */
     filter_t * resampler;
@@ -138,12 +142,66 @@ typedef struct
 /*****************************************************************************
  * best_overlap_offset: calculate best offset for overlap
  *****************************************************************************/
+static float dot_product_float( const float *a, const float *b, size_t n )
+{
+    float corr = 0;
+    for( size_t i = 0; i < n; i++ )
+        corr += a[i] * b[i];
+    return corr;
+}
+
+#if defined(__i386__) || defined(__x86_64__)
+# ifdef HAVE_SSE2_INTRINSICS
+#  include <emmintrin.h>
+
+#  ifdef __SSE2__
+#   define VLC_TARGET_SSE2
+#  else
+#   define VLC_TARGET_SSE2 __attribute__ ((__target__ ("sse2")))
+#  endif
+
+VLC_TARGET_SSE2
+static float dot_product_float_sse2( const float *a, const float *b, size_t n )
+{
+    __m128 acc = _mm_setzero_ps();
+    size_t i = 0;
+
+    for( ; i + 4 <= n; i += 4 )
+        acc = _mm_add_ps( acc, _mm_mul_ps( _mm_loadu_ps( a + i ),
+                                           _mm_loadu_ps( b + i ) ) );
+    acc = _mm_add_ps( acc, _mm_movehl_ps( acc, acc ) );
+    acc = _mm_add_ss( acc, _mm_shuffle_ps( acc, acc, 1 ) );
+
+    float corr = _mm_cvtss_f32( acc );
+    for( ; i < n; i++ )
+        corr += a[i] * b[i];
+    return corr;
+}
+# endif
+#elif defined(__aarch64__)
+# include <arm_neon.h>
+
+static float dot_product_float_neon( const float *a, const float *b, size_t n )
+{
+    float32x4_t acc = vdupq_n_f32( 0.f );
+    size_t i = 0;
+
+    for( ; i + 4 <= n; i += 4 )
+        acc = vfmaq_f32( acc, vld1q_f32( a + i ), vld1q_f32( b + i ) );
+
+    float corr = vaddvq_f32( acc );
+    for( ; i < n; i++ )
+        corr += a[i] * b[i];
+    return corr;
+}
+#endif
+
 static unsigned best_overlap_offset_float( filter_t *p_filter )
 {
     filter_sys_t *p = p_filter->p_sys;
     float *pw, *po, *ppc, *search_start;
     float best_corr = INT_MIN;
-    unsigned best_off = 0;
+    unsigned best_off;
     unsigned i, off;
 
     pw  = p->table_window;
@@ -154,14 +212,23 @@ static unsigned best_overlap_offset_float( filter_t *p_filter )
       *ppc++ = *pw++ * *po++;
     }
 
-    search_start = (float *)p->buf_queue + p->samples_per_frame;
-    for( off = 0; off < p->frames_search; off++ ) {
-      float corr = 0;
-      float *ps = search_start;
-      ppc = p->buf_pre_corr;
-      for( i = p->samples_per_frame; i < p->samples_overlap; i++ ) {
-        corr += *ppc++ * *ps++;
-      }
+    /* Consecutive strides usually lock onto nearby offsets, so once a best
+     * offset is known only a window around it is searched. A best offset
+     * landing on a window edge invalidates the guess and forces a full
+     * search on the next stride. */
+    unsigned lo = 0, hi = p->frames_search;
+    if( p->b_prev_best_valid ) {
+        unsigned radius = __MAX( p->frames_search / 4, 8 );
+        lo = ( p->frames_prev_best > radius ) ? p->frames_prev_best - radius : 0;
+        hi = __MIN( p->frames_prev_best + radius + 1, p->frames_search );
+    }
+
+    const size_t n = p->samples_overlap - p->samples_per_frame;
+    search_start = (float *)p->buf_queue
+                 + ( lo + 1 ) * p->samples_per_frame;
+    best_off = lo;
+    for( off = lo; off < hi; off++ ) {
+      float corr = p->pf_dot( p->buf_pre_corr, search_start, n );
       if( corr > best_corr ) {
         best_corr = corr;
         best_off  = off;
@@ -169,6 +236,10 @@ static unsigned best_overlap_offset_float( filter_t *p_filter )
       search_start += p->samples_per_frame;
     }
 
+    p->b_prev_best_valid = ( lo == 0 && hi == p->frames_search )
+                        || ( best_off > lo && best_off < hi - 1 );
+    p->frames_prev_best = best_off;
+
     return best_off * p->bytes_per_frame;
 }
 
@@ -343,6 +414,16 @@ static int reinit_buffers( filter_t *p_filter )
         p->table_window = malloc( bytes_pre_corr );
         if( ! p->buf_pre_corr || ! p->table_window )
             return VLC_ENOMEM;
+        p->pf_dot = dot_product_float;
+#if defined(__i386__) || defined(__x86_64__)
+# ifdef HAVE_SSE2_INTRINSICS
+        if( vlc_CPU_SSE2() )
+            p->pf_dot = dot_product_float_sse2;
+# endif
+#elif defined(__aarch64__)
+        p->pf_dot = dot_product_float_neon;
+#endif
+        p->b_prev_best_valid = false;
         float *pw = p->table_window;
         for( i = 1; i<frames_overlap; i++ )
         {
@@ -433,6 +514,7 @@ static int Open( vlc_object_t *p_this )
     p_sys->bytes_queued   = 0;
     p_sys->bytes_to_slide = 0;
     p_sys->frames_stride_error = 0;
+    p_sys->b_prev_best_valid = false;
 
     if( reinit_buffers( p_filter ) != VLC_SUCCESS )
     {
@@ -565,6 +647,7 @@ static block_t *DoWork( filter_t * p_filter, block_t * p_in_buf )
         p->bytes_stride_scaled  = p->bytes_stride * p->scale;
         p->frames_stride_scaled = p->bytes_stride_scaled / p->bytes_per_frame;
         p->bytes_to_slide = 0;
+        p->b_prev_best_valid = false;
         msg_Dbg( p_filter, "%.3f scale, %.3f stride_in, %i stride_out rate: %u",
                  p->scale, p->frames_stride_scaled,
                  (int)( p->bytes_stride / p->bytes_per_frame ), p->sample_rate );
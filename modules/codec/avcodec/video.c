@@ -107,6 +107,12 @@ typedef struct
     /* */
     bool palette_sent;
 
+    /* Low-delay (slice-threaded) mode the codec was opened with. A runtime
+     * change of the "low-delay" variable is latched here and applied by
+     * reloading the decoder at the next clean restart point. */
+    bool b_low_delay;
+    atomic_bool low_delay_request;
+
     /* VA API */
     vlc_va_t *p_va; /* Protected by lock */
     enum AVPixelFormat pix_fmt;
@@ -387,7 +393,7 @@ static int OpenVideoCodec( decoder_t *p_dec )
     cc_Init( &p_sys->cc );
 
     set_video_color_settings( &p_dec->fmt_in->video, ctx );
-    if( var_InheritBool(p_dec, "low-delay") ||
+    if( p_sys->b_low_delay ||
       ( p_dec->fmt_in->video.i_frame_rate_base &&
         p_dec->fmt_in->video.i_frame_rate &&
         (double) p_dec->fmt_in->video.i_frame_rate /
@@ -422,6 +428,17 @@ static int OpenVideoCodec( decoder_t *p_dec )
     return 0;
 }
 
+static int LowDelayCallback( vlc_object_t *p_this, char const *psz_cmd,
+                             vlc_value_t oldval, vlc_value_t newval,
+                             void *p_data )
+{
+    decoder_sys_t *p_sys = p_data;
+    VLC_UNUSED(p_this); VLC_UNUSED(psz_cmd); VLC_UNUSED(oldval);
+
+    atomic_store( &p_sys->low_delay_request, newval.b_bool );
+    return VLC_SUCCESS;
+}
+
 /*****************************************************************************
  * InitVideo: initialize the video decoder
  *****************************************************************************
@@ -475,6 +492,11 @@ int InitVideoDec( vlc_object_t *obj )
     else if( i_val == 1 ) p_context->skip_loop_filter = AVDISCARD_NONREF;
     else p_context->skip_loop_filter = AVDISCARD_DEFAULT;
 
+    /* ***** libavcodec threading mode ***** */
+    p_sys->b_low_delay = var_CreateGetBool( p_dec, "low-delay" );
+    atomic_init( &p_sys->low_delay_request, p_sys->b_low_delay );
+    var_AddCallback( p_dec, "low-delay", LowDelayCallback, p_sys );
+
     /* ***** libavcodec frame skipping ***** */
     p_sys->b_hurry_up = var_CreateGetBool( p_dec, "avcodec-hurry-up" );
     p_sys->b_show_corrupted = var_CreateGetBool( p_dec, "avcodec-corrupted" );
@@ -559,7 +581,7 @@ int InitVideoDec( vlc_object_t *obj )
             break;
     }
 
-    if( var_InheritBool(p_dec, "low-delay") )
+    if( p_sys->b_low_delay )
         p_context->thread_type &= ~FF_THREAD_FRAME;
 
     if( p_context->thread_type & FF_THREAD_FRAME )
@@ -597,6 +619,7 @@ int InitVideoDec( vlc_object_t *obj )
     /* ***** Open the codec ***** */
     if( OpenVideoCodec( p_dec ) < 0 )
     {
+        var_DelCallback( p_dec, "low-delay", LowDelayCallback, p_sys );
         free( p_sys );
         avcodec_free_context( &p_context );
         return VLC_EGENERIC;
@@ -1346,6 +1369,26 @@ static int DecodeVideo( decoder_t *p_dec, block_t *p_block )
     decoder_sys_t *p_sys = p_dec->p_sys;
     block_t **pp_block = p_block ? &p_block : NULL /* drain signal */;
 
+    if( p_block != NULL
+     && (p_block->i_flags & (BLOCK_FLAG_TYPE_I|BLOCK_FLAG_DISCONTINUITY))
+     && !(p_block->i_flags & BLOCK_FLAG_CORRUPTED)
+     && atomic_load( &p_sys->low_delay_request ) != p_sys->b_low_delay )
+    {
+        vlc_mutex_lock( &p_sys->lock );
+        bool b_software = p_sys->p_va == NULL;
+        vlc_mutex_unlock( &p_sys->lock );
+
+        /* Hardware decoders pick their own threading; only software decoding
+         * switches between frame and slice threads. */
+        if( b_software && avcodec_is_open( p_sys->p_context ) )
+        {
+            msg_Dbg( p_dec, "low-delay changed, reloading to switch the "
+                     "threading mode" );
+            /* The core feeds this block back to the reloaded decoder */
+            return VLCDEC_RELOAD;
+        }
+    }
+
     if( p_block &&
         p_block->i_flags & (BLOCK_FLAG_DISCONTINUITY|BLOCK_FLAG_CORRUPTED) )
     {
@@ -1381,6 +1424,8 @@ void EndVideoDec( vlc_object_t *obj )
     decoder_sys_t *p_sys = p_dec->p_sys;
     AVCodecContext *ctx = p_sys->p_context;
 
+    var_DelCallback( p_dec, "low-delay", LowDelayCallback, p_sys );
+
     cc_Flush( &p_sys->cc );
     avcodec_free_context( &ctx );
 
@@ -207,9 +207,17 @@ typedef struct
         uint8_t d1;
         uint8_t d2;
     } last;
+
+    /* Per-row render cache: styled segments built from unchanged rows are
+     * reused (copied) instead of being regenerated on every screen update.
+     * An entry is meaningful only when the matching valid flag is set; a
+     * valid NULL entry means the row renders to nothing. */
+    text_segment_t *p_row_cache[2][EIA608_SCREEN_ROWS];
+    bool b_row_cached[2][EIA608_SCREEN_ROWS];
 } eia608_t;
 
 static void         Eia608Init( eia608_t * );
+static void         Eia608FlushCache( eia608_t * );
 static eia608_status_t Eia608Parse( eia608_t *h, int i_channel_selected, const uint8_t data[2] );
 static void         Eia608FillUpdaterRegions( subtext_updater_sys_t *p_updater, eia608_t *h );
 
@@ -325,6 +333,7 @@ static void Flush( decoder_t *p_dec )
 
     if( p_sys->p_eia608 )
     {
+        Eia608FlushCache( p_sys->p_eia608 );
         Eia608Init( p_sys->p_eia608 );
     }
     else
@@ -372,6 +381,7 @@ static int Decode( decoder_t *p_dec, block_t *p_block )
             for( ; DoDecode( p_dec, true ) ; );
             if( p_sys->p_eia608 )
             {
+                Eia608FlushCache( p_sys->p_eia608 );
                 Eia608Init( p_sys->p_eia608 );
             }
             else
@@ -417,6 +427,8 @@ static void Close( vlc_object_t *p_this )
     decoder_t *p_dec = (decoder_t *)p_this;
     decoder_sys_t *p_sys = p_dec->p_sys;
 
+    if( p_sys->p_eia608 )
+        Eia608FlushCache( p_sys->p_eia608 );
     free( p_sys->p_eia608 );
     if( p_sys->p_cea708 )
     {
@@ -594,10 +606,29 @@ static void Eia608Cursor( eia608_t *h, int dx )
     else if( h->cursor.i_column > EIA608_SCREEN_COLUMNS-1 )
         h->cursor.i_column = EIA608_SCREEN_COLUMNS-1;
 }
+static void Eia608DirtyRow( eia608_t *h, int i_screen, int i_row )
+{
+    if( h->b_row_cached[i_screen][i_row] )
+    {
+        text_segment_ChainDelete( h->p_row_cache[i_screen][i_row] );
+        h->p_row_cache[i_screen][i_row] = NULL;
+        h->b_row_cached[i_screen][i_row] = false;
+    }
+}
+
+static void Eia608FlushCache( eia608_t *h )
+{
+    for( int i = 0; i < 2; i++ )
+        for( int j = 0; j < EIA608_SCREEN_ROWS; j++ )
+            Eia608DirtyRow( h, i, j );
+}
+
 static void Eia608ClearScreenRowX( eia608_t *h, int i_screen, int i_row, int x )
 {
     eia608_screen *screen = &h->screen[i_screen];
 
+    Eia608DirtyRow( h, i_screen, i_row );
+
     if( x == 0 )
     {
         screen->row_used[i_row] = false;
@@ -675,6 +706,7 @@ static void Eia608Write( eia608_t *h, const uint8_t c )
     screen->colors[i_row][i_column] = h->color;
     screen->fonts[i_row][i_column] = h->font;
     screen->row_used[i_row] = true;
+    Eia608DirtyRow( h, Eia608GetWritingScreenIndex( h ), i_row );
     Eia608Cursor( h, 1 );
 }
 static void Eia608Erase( eia608_t *h )
@@ -692,6 +724,7 @@ static void Eia608Erase( eia608_t *h )
 
     /* FIXME do we need to reset row_used/colors/font ? */
     screen->characters[i_row][i_column] = ' ';
+    Eia608DirtyRow( h, Eia608GetWritingScreenIndex( h ), i_row );
     Eia608Cursor( h, -1 );
 }
 static void Eia608EraseToEndOfRow( eia608_t *h )
@@ -740,6 +773,14 @@ static void Eia608RollUp( eia608_t *h )
         memcpy( screen->colors[i_row], screen->colors[i_row+1], sizeof(*screen->colors) );
         memcpy( screen->fonts[i_row], screen->fonts[i_row+1], sizeof(*screen->fonts) );
         screen->row_used[i_row] = screen->row_used[i_row+1];
+
+        /* The row content moved verbatim: move its cached rendering along
+         * instead of re-rendering the whole roll-up window */
+        Eia608DirtyRow( h, i_screen, i_row );
+        h->p_row_cache[i_screen][i_row] = h->p_row_cache[i_screen][i_row+1];
+        h->b_row_cached[i_screen][i_row] = h->b_row_cached[i_screen][i_row+1];
+        h->p_row_cache[i_screen][i_row+1] = NULL;
+        h->b_row_cached[i_screen][i_row+1] = false;
     }
     /* Reset current row */
     Eia608ClearScreenRow( h, i_screen, h->cursor.i_row );
@@ -1103,13 +1144,21 @@ static void Eia608TextUtf8( char *psz_utf8, uint8_t c ) // Returns number of byt
 #undef E2
 #undef E1
 
+    /* Plain ASCII except for the nine exceptions of the table above */
+    if( c < 0x80 && ( c < 0x2a || !strchr( "\x2a\x5c\x5e\x5f\x60\x7b\x7c\x7d\x7e", c ) ) )
+    {
+        psz_utf8[0] = c;
+        psz_utf8[1] = '\0';
+        return;
+    }
+
     for( size_t i = 0; i < ARRAY_SIZE(c2utf8) ; i++ )
         if( c2utf8[i].c == c ) {
             strcpy( psz_utf8, c2utf8[i].utf8 );
             return;
         }
 
-    psz_utf8[0] = c < 0x80 ? c : '?';   /* Normal : Unsupported */
+    psz_utf8[0] = '?';   /* Unsupported */
     psz_utf8[1] = '\0';
 }
 
@@ -1234,6 +1283,19 @@ static text_segment_t * Eia608TextLine( struct eia608_screen *screen, int i_row
     return p_segments_head;
 }
 
+static text_segment_t * Eia608RenderRow( eia608_t *h, struct eia608_screen *screen,
+                                         int i_screen, int i_row )
+{
+    if( !h->b_row_cached[i_screen][i_row] )
+    {
+        h->p_row_cache[i_screen][i_row] = Eia608TextLine( screen, i_row );
+        h->b_row_cached[i_screen][i_row] = true;
+    }
+
+    /* The updater owns the returned chain, hand out a copy */
+    return text_segment_Copy( h->p_row_cache[i_screen][i_row] );
+}
+
 static void Eia608FillUpdaterRegions( subtext_updater_sys_t *p_updater, eia608_t *h )
 {
     struct eia608_screen *screen = &h->screen[h->i_screen];
@@ -1246,7 +1308,7 @@ static void Eia608FillUpdaterRegions( subtext_updater_sys_t *p_updater, eia608_t
         if( !screen->row_used[i] )
             continue;
 
-        text_segment_t *p_segments = Eia608TextLine( screen, i );
+        text_segment_t *p_segments = Eia608RenderRow( h, screen, h->i_screen, i );
         if( p_segments )
         {
             if( b_newregion )
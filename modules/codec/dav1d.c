@@ -55,6 +55,10 @@ static void CloseDecoder(vlc_object_t *);
 #define THREAD_FRAMES_LONGTEXT N_( "Max number of threads used for frame decoding, default 0=auto" )
 #define THREAD_TILES_TEXT N_("Tiles Threads")
 #define THREAD_TILES_LONGTEXT N_( "Max number of threads used for tile decoding, default 0=auto" )
+#define APPLY_GRAIN_TEXT N_("Apply film grain")
+#define APPLY_GRAIN_LONGTEXT N_( "Synthesize film grain during decoding. " \
+    "Disabling it saves a significant amount of processing power on grainy " \
+    "streams, at the cost of fidelity." )
 
 
 vlc_module_begin ()
@@ -74,6 +78,7 @@ vlc_module_begin ()
     add_integer_with_range("dav1d-thread-tiles", 0, 0, DAV1D_MAX_TILE_THREADS,
                 THREAD_TILES_TEXT, THREAD_TILES_LONGTEXT)
 #endif
+    add_bool("dav1d-apply-grain", true, APPLY_GRAIN_TEXT, APPLY_GRAIN_LONGTEXT)
 vlc_module_end ()
 
 /*****************************************************************************
@@ -463,6 +468,7 @@ static int OpenDecoder(vlc_object_t *p_this)
     if (p_sys->s.n_frame_threads == 0)
         p_sys->s.n_frame_threads = __MAX(1, vlc_GetCPUCount());
 #endif
+    p_sys->s.apply_grain = var_InheritBool(p_this, "dav1d-apply-grain");
     p_sys->s.allocator.cookie = dec;
     p_sys->s.allocator.alloc_picture_callback = NewPicture;
     p_sys->s.allocator.release_picture_callback = FreePicture;
@@ -518,6 +524,12 @@ static int OpenDecoder(vlc_object_t *p_this)
 
     dec->i_extra_picture_buffers = (p_sys->s.n_frame_threads - 1);
 #endif
+
+    /* Grain synthesis writes into a second picture taken from the same
+     * allocator while the grainless reference frame stays alive. */
+    if (p_sys->s.apply_grain)
+        dec->i_extra_picture_buffers += 2;
+
     dec->fmt_out.video.i_width  = (dec->fmt_out.video.i_width + 0x7F) & ~0x7F;
     dec->fmt_out.video.i_height = (dec->fmt_out.video.i_height + 0x7F) & ~0x7F;
 
@@ -72,6 +72,10 @@ vlc_module_end ()
 static int DecodeBlock( decoder_t *, block_t * );
 static void Flush( decoder_t * );
 
+/* How far ahead of display time the prefetch thread renders; roughly one
+ * frame interval of typical contents. */
+#define PREFETCH_LOOKAHEAD VLC_TICK_FROM_MS(40)
+
 /* */
 typedef struct
 {
@@ -89,6 +93,14 @@ typedef struct
 
     /* */
     ASS_Track      *p_track;
+
+    /* Prefetch thread, protected by lock (see PrefetchThread) */
+    vlc_cond_t     wait;
+    vlc_thread_t   thread;
+    bool           b_thread;
+    bool           b_exit;
+    vlc_tick_t     i_prefetch_date; /**< Stream date to render ahead, or VLC_TICK_INVALID */
+    vlc_tick_t     i_rendered_date; /**< Stream date of the last display render */
 } decoder_sys_t;
 static void DecSysRelease( decoder_sys_t *p_sys );
 static void DecSysHold( decoder_sys_t *p_sys );
@@ -123,6 +135,8 @@ typedef struct
 static int BuildRegions( rectangle_t *p_region, int i_max_region, ASS_Image *p_img_list, int i_width, int i_height );
 static void RegionDraw( subpicture_region_t *p_region, ASS_Image *p_img );
 
+static void *PrefetchThread( void * );
+
 //#define DEBUG_REGION
 
 /*****************************************************************************
@@ -152,6 +166,11 @@ static int Create( vlc_object_t *p_this )
     p_sys->p_library  = NULL;
     p_sys->p_renderer = NULL;
     p_sys->p_track    = NULL;
+    vlc_cond_init( &p_sys->wait );
+    p_sys->b_thread = false;
+    p_sys->b_exit   = false;
+    p_sys->i_prefetch_date = VLC_TICK_INVALID;
+    p_sys->i_rendered_date = VLC_TICK_INVALID;
 
     /* Create libass library */
     ASS_Library *p_library = p_sys->p_library = ass_library_init();
@@ -280,19 +299,80 @@ static int Create( vlc_object_t *p_this )
     }
     ass_process_codec_private( p_track, p_dec->fmt_in->p_extra, p_dec->fmt_in->i_extra );
 
+    /* The prefetch thread is an optimization only; without it rendering
+     * simply stays fully synchronous on the display path. */
+    p_sys->b_thread = !vlc_clone( &p_sys->thread, PrefetchThread, p_sys );
+    if( !p_sys->b_thread )
+        msg_Warn( p_dec, "prefetch thread creation failed" );
+
     p_dec->fmt_out.i_codec = VLC_CODEC_RGBA;
 
     return VLC_SUCCESS;
 }
 
+/*****************************************************************************
+ * PrefetchThread: render ahead of display time.
+ *
+ * ass_render_frame() rasterizes every glyph and style combination it has
+ * not seen before; with heavily styled scripts (karaoke effects) this can
+ * take longer than a frame interval and stall the video output.  libass
+ * keeps the rasterized glyphs and bitmaps in caches inside the renderer,
+ * so rendering the next frame slightly in advance turns the synchronous
+ * render on the display path into a near pure cache hit.
+ *
+ * The renderer is not thread safe, so the speculative render shares
+ * p_sys->lock with the display path and only runs between display frames.
+ * It also resets the change detection of ass_render_frame(), so the last
+ * displayed date is rendered again afterwards to restore the comparison
+ * baseline; that second render hits the caches just warmed and is cheap.
+ *****************************************************************************/
+static void *PrefetchThread( void *p_data )
+{
+    decoder_sys_t *p_sys = p_data;
+
+    vlc_thread_set_name("vlc-libass");
+
+    vlc_mutex_lock( &p_sys->lock );
+    for( ;; )
+    {
+        while( !p_sys->b_exit && p_sys->i_prefetch_date == VLC_TICK_INVALID )
+            vlc_cond_wait( &p_sys->wait, &p_sys->lock );
+        if( p_sys->b_exit )
+            break;
+
+        const vlc_tick_t i_date = p_sys->i_prefetch_date;
+        p_sys->i_prefetch_date = VLC_TICK_INVALID;
+
+        int i_changed;
+        ass_render_frame( p_sys->p_renderer, p_sys->p_track,
+                          MS_FROM_VLC_TICK( i_date ), &i_changed );
+        if( p_sys->i_rendered_date != VLC_TICK_INVALID )
+            ass_render_frame( p_sys->p_renderer, p_sys->p_track,
+                              MS_FROM_VLC_TICK( p_sys->i_rendered_date ),
+                              &i_changed );
+    }
+    vlc_mutex_unlock( &p_sys->lock );
+    return NULL;
+}
+
 /*****************************************************************************
  * Destroy: finish
  *****************************************************************************/
 static void Destroy( vlc_object_t *p_this )
 {
     decoder_t *p_dec = (decoder_t *)p_this;
+    decoder_sys_t *p_sys = p_dec->p_sys;
+
+    if( p_sys->b_thread )
+    {
+        vlc_mutex_lock( &p_sys->lock );
+        p_sys->b_exit = true;
+        vlc_cond_signal( &p_sys->wait );
+        vlc_mutex_unlock( &p_sys->lock );
+        vlc_join( p_sys->thread, NULL );
+    }
 
-    DecSysRelease( p_dec->p_sys );
+    DecSysRelease( p_sys );
 }
 
 static void DecSysHold( decoder_sys_t *p_sys )
@@ -451,6 +531,12 @@ static int SubpictureValidate( subpicture_t *p_subpic,
     ASS_Image *p_img = ass_render_frame( p_sys->p_renderer, p_sys->p_track,
                                          MS_FROM_VLC_TICK( i_stream_date ), &i_changed );
 
+    /* Warm the renderer caches for the next display date in the background */
+    p_sys->i_rendered_date = i_stream_date;
+    p_sys->i_prefetch_date = i_stream_date + PREFETCH_LOOKAHEAD;
+    if( p_sys->b_thread )
+        vlc_cond_signal( &p_sys->wait );
+
     if( !i_changed && !b_fmt_src && !b_fmt_dst &&
         (p_img != NULL) == (p_subpic->p_region != NULL) )
     {
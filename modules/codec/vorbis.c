@@ -507,21 +507,54 @@ static block_t *ProcessPacket( decoder_t *p_dec, ogg_packet *p_oggpacket,
 /*****************************************************************************
  * Interleave: helper function to interleave channels
  *****************************************************************************/
+#ifdef PLUGIN_TREMOR
+static inline int32_t InterleaveSample( int32_t i_spl )
+{
+    union { int32_t i; uint32_t u;} spl;
+
+    spl.u = ((uint32_t)i_spl) << 8;
+    return spl.i;
+}
+#else
+# define InterleaveSample( spl ) ( spl )
+#endif
+
+/* Samples interleaved per pass: keeps the output window of all channels
+ * within the L1 cache even for 16 channels (3rd order ambisonics) */
+#define INTERLEAVE_BLOCK 256
+
 static void Interleave( INTERLEAVE_TYPE *p_out, const INTERLEAVE_TYPE **pp_in,
                         int i_nb_channels, int i_samples, uint8_t *pi_chan_table)
 {
-    for( int j = 0; j < i_samples; j++ )
+    if( i_nb_channels == 2 && pi_chan_table[0] == 0 && pi_chan_table[1] == 1 )
+    {   /* common stereo case: a pairwise loop the compiler can vectorize */
+        const INTERLEAVE_TYPE *p_left = pp_in[0], *p_right = pp_in[1];
+
+        for( int j = 0; j < i_samples; j++ )
+        {
+            p_out[2 * j]     = InterleaveSample( p_left[j] );
+            p_out[2 * j + 1] = InterleaveSample( p_right[j] );
+        }
+        return;
+    }
+
+    /* Channel-major, in bounded sample blocks: each decoded plane is read
+     * with unit stride and the reorder table lookup is hoisted out of the
+     * inner loop, which then reduces to a vectorizable strided store. */
+    for( int j = 0; j < i_samples; j += INTERLEAVE_BLOCK )
+    {
+        int i_block = __MIN( i_samples - j, INTERLEAVE_BLOCK );
+
         for( int i = 0; i < i_nb_channels; i++ )
         {
-#ifdef PLUGIN_TREMOR
-            union { int32_t i; uint32_t u;} spl;
+            const INTERLEAVE_TYPE *p_in = &pp_in[i][j];
+            INTERLEAVE_TYPE *p_dst = &p_out[j * i_nb_channels
+                                            + pi_chan_table[i]];
 
-            spl.u = ((uint32_t)pp_in[i][j]) << 8;
-            p_out[j * i_nb_channels + pi_chan_table[i]] = spl.i;
-#else
-            p_out[j * i_nb_channels + pi_chan_table[i]] = pp_in[i][j];
-#endif
+            for( int k = 0; k < i_block; k++ )
+                p_dst[k * i_nb_channels] = InterleaveSample( p_in[k] );
         }
+    }
 }
 
 /*****************************************************************************
@@ -404,6 +404,12 @@ static void x264_log( void *, int i_level, const char *psz, va_list );
 #define TUNE_TEXT N_("Default tune setting used" )
 #define PRESET_TEXT N_("Default preset setting used" )
 
+#define ADAPTIVE_SPEED_TEXT N_("Adapt preset to encoding speed")
+#define ADAPTIVE_SPEED_LONGTEXT N_("Fall back to the analysis settings of a " \
+    "faster preset whenever encoding cannot keep up with the input frame " \
+    "rate, and restore them once there is headroom again.")
+#define PRESET_FLOOR_TEXT N_("Fastest preset used for speed adaptation")
+
 #define X264_OPTIONS_TEXT N_("x264 advanced options")
 #define X264_OPTIONS_LONGTEXT N_("x264 advanced options, in the form {opt=val,op2=val2}.")
 
@@ -711,6 +717,14 @@ vlc_module_begin ()
             (sizeof(x264_tune_names) / sizeof (char*)) - 1,
             x264_tune_names, x264_tune_names);
 
+    add_bool( SOUT_CFG_PREFIX "adaptive-speed", false, ADAPTIVE_SPEED_TEXT,
+              ADAPTIVE_SPEED_LONGTEXT )
+    add_string( SOUT_CFG_PREFIX "preset-floor", "ultrafast", PRESET_FLOOR_TEXT,
+                NULL )
+        vlc_config_set (VLC_CONFIG_LIST,
+            (sizeof(x264_preset_names) / sizeof (char*)) - 1,
+            x264_preset_names, x264_preset_names);
+
     add_string( SOUT_CFG_PREFIX "options", NULL, X264_OPTIONS_TEXT,
                 X264_OPTIONS_LONGTEXT )
 
@@ -734,11 +748,20 @@ static const char *const ppsz_sout_options[] = {
     "aq-mode", "aq-strength", "psy-rd", "psy", "profile", "lookahead", "slices",
     "slice-max-size", "slice-max-mbs", "intra-refresh", "mbtree", "hrd",
     "tune","preset", "opengop", "bluray-compat", "frame-packing", "options",
-    "fullrange",
+    "fullrange", "adaptive-speed", "preset-floor",
     NULL
 };
 
 static block_t *Encode( encoder_t *, picture_t * );
+static int  PresetIndex( const char * );
+static void AdaptSpeed( encoder_t *, vlc_tick_t );
+
+/* Speed adaptation: frames between preset switches, and the encode time to
+ * frame interval ratios triggering a switch. The gap between both ratios
+ * provides the hysteresis keeping borderline loads from flip-flopping. */
+#define SPEED_ADAPT_WINDOW     32
+#define SPEED_ADAPT_DOWN_RATIO 0.95f
+#define SPEED_ADAPT_UP_RATIO   0.60f
 
 typedef struct
 {
@@ -749,6 +772,15 @@ typedef struct
     int             i_sei_size;
     uint32_t         i_colorspace;
     uint8_t         *p_sei;
+
+    /* Closed-loop speed adaptation (adaptive-speed) */
+    bool            b_adaptive_speed;
+    int             i_preset;         /* current index in x264_preset_names */
+    int             i_preset_ceiling; /* preset configured by the user */
+    int             i_preset_floor;   /* fastest preset adaptation may pick */
+    vlc_tick_t      i_frame_length;   /* nominal input frame interval */
+    float           f_load;           /* EMA of encode time / frame interval */
+    unsigned        i_adapt_frames;   /* frames since the last switch */
 } encoder_sys_t;
 
 /*****************************************************************************
@@ -867,6 +899,30 @@ static int  Open ( vlc_object_t *p_this )
         p_sys->param.i_bitdepth = 10;
 # endif
 #endif
+    p_sys->b_adaptive_speed = var_GetBool( p_enc, SOUT_CFG_PREFIX "adaptive-speed" );
+    p_sys->i_preset_ceiling = PresetIndex( psz_preset ? psz_preset : "medium" );
+    psz_val = var_GetString( p_enc, SOUT_CFG_PREFIX "preset-floor" );
+    p_sys->i_preset_floor = psz_val ? PresetIndex( psz_val ) : -1;
+    free( psz_val );
+    if( p_enc->fmt_in.video.i_frame_rate && p_enc->fmt_in.video.i_frame_rate_base )
+        p_sys->i_frame_length = vlc_tick_from_samples(
+                    p_enc->fmt_in.video.i_frame_rate_base,
+                    p_enc->fmt_in.video.i_frame_rate );
+    else
+        p_sys->i_frame_length = 0;
+    if( p_sys->b_adaptive_speed &&
+        ( p_sys->i_preset_ceiling < 0 || p_sys->i_preset_floor < 0 ||
+          p_sys->i_preset_floor > p_sys->i_preset_ceiling ||
+          p_sys->i_frame_length == 0 ) )
+    {
+        msg_Warn( p_enc, "cannot adapt speed without a valid preset ladder "
+                  "and input frame rate" );
+        p_sys->b_adaptive_speed = false;
+    }
+    p_sys->i_preset = p_sys->i_preset_ceiling;
+    p_sys->f_load = 0.f;
+    p_sys->i_adapt_frames = 0;
+
     free( psz_preset );
     free( psz_tune );
     p_sys->param.i_csp = p_sys->i_colorspace;
@@ -1435,6 +1491,71 @@ static void x264_log( void *data, int i_level, const char *psz, va_list args)
     msg_GenericVa( p_enc, i_level, psz, args );
 };
 
+/****************************************************************************
+ * Speed adaptation: pick a faster preset when encoding falls behind the
+ * input frame rate, and restore the configured one when there is headroom.
+ ****************************************************************************/
+static int PresetIndex( const char *psz_preset )
+{
+    for( int i = 0; x264_preset_names[i]; i++ )
+        if( !strcmp( x264_preset_names[i], psz_preset ) )
+            return i;
+    return -1;
+}
+
+static void AdaptSpeed( encoder_t *p_enc, vlc_tick_t i_duration )
+{
+    encoder_sys_t *p_sys = p_enc->p_sys;
+
+    /* Exponential moving average of the encode time per frame interval */
+    p_sys->f_load += 0.1f * ( (float)i_duration / p_sys->i_frame_length
+                              - p_sys->f_load );
+
+    if( ++p_sys->i_adapt_frames < SPEED_ADAPT_WINDOW )
+        return;
+
+    int i_preset = p_sys->i_preset;
+    if( p_sys->f_load > SPEED_ADAPT_DOWN_RATIO &&
+        i_preset > p_sys->i_preset_floor )
+        i_preset--; /* cannot keep up, take the next faster preset */
+    else if( p_sys->f_load < SPEED_ADAPT_UP_RATIO &&
+             i_preset < p_sys->i_preset_ceiling )
+        i_preset++; /* ample headroom, restore quality */
+    if( i_preset == p_sys->i_preset )
+        return;
+
+    x264_param_t preset;
+#ifdef PLUGIN_X262
+    x264_param_default_preset_mpeg2( &preset, x264_preset_names[i_preset], NULL );
+#else
+    x264_param_default_preset( &preset, x264_preset_names[i_preset], NULL );
+#endif
+
+    /* Restrict the switch to the analysis settings honoured by
+     * x264_encoder_reconfig(); stream-level settings (profile, references,
+     * threading, rate control) must not change mid-stream. */
+    x264_param_t param = p_sys->param;
+    param.analyse.intra              = preset.analyse.intra;
+    param.analyse.inter              = preset.analyse.inter;
+    param.analyse.i_me_method        = preset.analyse.i_me_method;
+    param.analyse.i_me_range         = preset.analyse.i_me_range;
+    param.analyse.i_subpel_refine    = preset.analyse.i_subpel_refine;
+    param.analyse.i_trellis          = preset.analyse.i_trellis;
+    param.analyse.b_mixed_references = preset.analyse.b_mixed_references;
+    param.analyse.b_fast_pskip       = preset.analyse.b_fast_pskip;
+    param.analyse.f_psy_rd           = preset.analyse.f_psy_rd;
+    param.analyse.f_psy_trellis      = preset.analyse.f_psy_trellis;
+
+    if( x264_encoder_reconfig( p_sys->h, &param ) )
+        return;
+
+    msg_Dbg( p_enc, "encoder load %.2f, switching to preset %s",
+             p_sys->f_load, x264_preset_names[i_preset] );
+    p_sys->param = param;
+    p_sys->i_preset = i_preset;
+    p_sys->i_adapt_frames = 0;
+}
+
 /****************************************************************************
  * Encode:
  ****************************************************************************/
@@ -1458,7 +1579,14 @@ static block_t *Encode( encoder_t *p_enc, picture_t *p_pict )
             pic.img.i_stride[i] = p_pict->p[i].i_pitch;
         }
 
-        x264_encoder_encode( p_sys->h, &nal, &i_nal, &pic, &pic );
+        if( p_sys->b_adaptive_speed )
+        {
+            const vlc_tick_t i_begin = vlc_tick_now();
+            x264_encoder_encode( p_sys->h, &nal, &i_nal, &pic, &pic );
+            AdaptSpeed( p_enc, vlc_tick_now() - i_begin );
+        }
+        else
+            x264_encoder_encode( p_sys->h, &nal, &i_nal, &pic, &pic );
     } else {
         while( x264_encoder_delayed_frames( p_sys->h ) && i_nal == 0 ) {
             x264_encoder_encode( p_sys->h, &nal, &i_nal, NULL, &pic );
@@ -142,6 +142,7 @@ SegmentTracker::SegmentTracker(SharedResources *res,
     adaptationSet = adaptSet;
     synchronizationReferences = refs;
     format = StreamFormat::Type::Unknown;
+    lookahead = -1;
 }
 
 SegmentTracker::~SegmentTracker()
@@ -335,6 +336,36 @@ SegmentTracker::prepareChunk(bool switch_allowed, Position pos) const
     return ChunkEntry(segmentChunk, pos, startTime, duration, displayTime);
 }
 
+/**
+ * Extends the chunks sequence so that the next few segment downloads are
+ * already in flight while the front chunk gets demuxed. Keeps requests
+ * pipelined on high-RTT links instead of paying a round-trip per segment.
+ * Lookahead chunks are prepared without representation switching: the
+ * adaptation logic only picks a new representation at the queue head.
+ */
+void SegmentTracker::fillChunksSequence()
+{
+    if(lookahead < 0)
+        lookahead = var_InheritInteger(adaptationSet->getPlaylist()->getVLCObject(),
+                                       "adaptive-lookahead");
+
+    while(!chunkssequence.empty() && chunkssequence.back().isValid() &&
+          chunkssequence.size() < (size_t) lookahead + 1)
+    {
+        Position ahead = chunkssequence.back().pos;
+        ++ahead;
+        ChunkEntry prepared = prepareChunk(false, ahead);
+        /* Stop on unavailable segments or gaps: the consumption logic must
+         * resolve those on the live position, not on a prediction */
+        if(!prepared.isValid() || prepared.pos.number != ahead.number)
+        {
+            delete prepared.chunk;
+            break;
+        }
+        chunkssequence.push_back(prepared);
+    }
+}
+
 void SegmentTracker::resetChunksSequence()
 {
     while(!chunkssequence.empty())
@@ -354,6 +385,7 @@ ChunkInterface * SegmentTracker::getNextChunk(bool switch_allowed)
         ChunkEntry chunk = prepareChunk(switch_allowed, next);
         chunkssequence.push_back(chunk);
     }
+    fillChunksSequence();
 
     ChunkEntry chunk = chunkssequence.front();
     if(!chunk.isValid())
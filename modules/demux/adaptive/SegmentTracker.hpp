@@ -253,6 +253,7 @@ namespace adaptive
             };
             std::list<ChunkEntry> chunkssequence;
             ChunkEntry prepareChunk(bool switch_allowed, Position pos) const;
+            void fillChunksSequence();
             void resetChunksSequence();
             void setAdaptationLogic(AbstractAdaptationLogic *);
             void notify(const TrackerEvent &) const;
@@ -266,6 +267,7 @@ namespace adaptive
             AbstractAdaptationLogic *logic;
             const AbstractBufferingLogic *bufferingLogic;
             BaseAdaptationSet *adaptationSet;
+            int lookahead;
             std::list<SegmentTrackerListenerInterface *> listeners;
     };
 }
@@ -27,19 +27,101 @@
 #include "http/HTTPConnection.hpp"
 #include "encryption/Keyring.hpp"
 
+#include <vlc_cxx_helpers.hpp>
+
+#include <list>
+#include <new>
+
 using namespace adaptive;
 
+struct BandwidthGovernor::Session
+{
+    libvlc_int_t *instance;
+    unsigned priority;
+    size_t bps;
+    vlc_tick_t updated;
+};
+
+static vlc::threads::mutex governor_lock;
+static std::list<BandwidthGovernor::Session *> governor_sessions;
+
+BandwidthGovernor::Session *
+BandwidthGovernor::addSession(vlc_object_t *obj, unsigned priority)
+{
+    Session *s = new (std::nothrow) Session();
+    if(!s)
+        return nullptr;
+    s->instance = vlc_object_instance(obj);
+    s->priority = priority ? priority : 1;
+    s->bps = 0;
+    s->updated = 0;
+    vlc::threads::mutex_locker locker(governor_lock);
+    governor_sessions.push_back(s);
+    return s;
+}
+
+void BandwidthGovernor::removeSession(Session *s)
+{
+    if(!s)
+        return;
+    {
+        vlc::threads::mutex_locker locker(governor_lock);
+        governor_sessions.remove(s);
+    }
+    delete s;
+}
+
+void BandwidthGovernor::reportRate(Session *s, size_t bps)
+{
+    if(!s || !bps)
+        return;
+    vlc::threads::mutex_locker locker(governor_lock);
+    s->bps = bps;
+    s->updated = vlc_tick_now();
+}
+
+size_t BandwidthGovernor::getShare(const Session *session)
+{
+    if(!session)
+        return 0;
+    vlc::threads::mutex_locker locker(governor_lock);
+    const vlc_tick_t deadline = vlc_tick_now() - VLC_TICK_FROM_SEC(10);
+    size_t total = 0;
+    unsigned totalpriority = 0;
+    unsigned active = 0;
+    for(const Session *s : governor_sessions)
+    {
+        if(s->instance != session->instance)
+            continue;
+        /* don't reserve budget for paused or gone quiet sessions */
+        if(s != session && (s->updated == 0 || s->updated < deadline))
+            continue;
+        total += s->bps;
+        totalpriority += s->priority;
+        active++;
+    }
+    if(active < 2 || totalpriority == 0)
+        return 0;
+    size_t share = total * session->priority / totalpriority;
+    /* leave probing headroom above the fair share so the aggregate
+       can still ramp up to the real link capacity */
+    return share + share / 4;
+}
+
 SharedResources::SharedResources(AuthStorage *auth, Keyring *ring,
                                  AbstractConnectionManager *conn)
 {
     authStorage = auth;
     encryptionKeyring = ring;
     connManager = conn;
+    governorSession = nullptr;
 }
 
 SharedResources::~SharedResources()
 {
+    /* downloader threads report into the session, drop them first */
     delete connManager;
+    BandwidthGovernor::removeSession(governorSession);
     delete encryptionKeyring;
     delete authStorage;
 }
@@ -71,5 +153,9 @@ SharedResources * SharedResources::createDefault(vlc_object_t *obj,
     ConnectionParams params(playlisturl);
     if(params.isLocal())
         m->setLocalConnectionsAllowed();
-    return new SharedResources(auth, keyring, m);
+    SharedResources *resources = new SharedResources(auth, keyring, m);
+    resources->governorSession = BandwidthGovernor::addSession(obj,
+            (unsigned) var_InheritInteger(obj, "adaptive-bw-priority"));
+    m->setBandwidthSharing(resources->governorSession);
+    return resources;
 }
@@ -39,6 +39,21 @@ namespace adaptive
     using namespace http;
     using namespace encryption;
 
+    /* Arbitrates the measured link bandwidth between the adaptive sessions
+       of a same libvlc instance (mosaic/PiP walls). Each session gets a
+       share of the aggregate observed rate weighted by its priority, so
+       concurrent rate estimators stop fighting over the same link. */
+    class BandwidthGovernor
+    {
+        public:
+            struct Session;
+            static Session * addSession(vlc_object_t *, unsigned priority);
+            static void removeSession(Session *);
+            static void reportRate(Session *, size_t bps);
+            /* session budget in bps, 0 when unconstrained */
+            static size_t getShare(const Session *);
+    };
+
     class SharedResources
     {
         public:
@@ -54,6 +69,7 @@ namespace adaptive
             AuthStorage *authStorage;
             Keyring *encryptionKeyring;
             AbstractConnectionManager *connManager;
+            BandwidthGovernor::Session *governorSession;
     };
 }
 
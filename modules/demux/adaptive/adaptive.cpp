@@ -81,6 +81,21 @@ static void Close   (vlc_object_t *);
 #define ADAPT_ACCESS_TEXT N_("Use regular HTTP modules")
 #define ADAPT_ACCESS_LONGTEXT N_("Connect using HTTP access instead of custom HTTP code")
 
+#define ADAPT_LOOKAHEAD_TEXT N_("Segments downloaded in advance")
+#define ADAPT_LOOKAHEAD_LONGTEXT N_("Number of future segments kept " \
+    "downloading per stream. Pipelining hides the request round-trip " \
+    "time on high latency links, but delays bitrate switches.")
+
+#define ADAPT_LOOKAHEAD_BUDGET_TEXT N_("Lookahead byte budget (KiB)")
+#define ADAPT_LOOKAHEAD_BUDGET_LONGTEXT N_("Downloaded but not yet " \
+    "demuxed segment data shared by all streams. Downloads pause over " \
+    "this amount. 0 for unlimited.")
+
+#define ADAPT_BWPRIORITY_TEXT N_("Bandwidth sharing priority")
+#define ADAPT_BWPRIORITY_LONGTEXT N_("Relative weight of this stream when " \
+    "several adaptive streams of the instance share the link. Streams with " \
+    "a higher priority get a larger share of the measured bandwidth.")
+
 #define ADAPT_LOWLATENCY_TEXT N_("Low latency")
 #define ADAPT_LOWLATENCY_LONGTEXT N_("Overrides low latency parameters")
 
@@ -88,6 +103,7 @@ static const AbstractAdaptationLogic::LogicType pi_logics[] = {
                                 AbstractAdaptationLogic::LogicType::Default,
                                 AbstractAdaptationLogic::LogicType::Predictive,
                                 AbstractAdaptationLogic::LogicType::NearOptimal,
+                                AbstractAdaptationLogic::LogicType::BufferAware,
                                 AbstractAdaptationLogic::LogicType::RateBased,
                                 AbstractAdaptationLogic::LogicType::FixedRate,
                                 AbstractAdaptationLogic::LogicType::AlwaysLowest,
@@ -97,6 +113,7 @@ static const char *const ppsz_logics_values[] = {
                                 "",
                                 "predictive",
                                 "nearoptimal",
+                                "bufferaware",
                                 "rate",
                                 "fixedrate",
                                 "lowest",
@@ -105,6 +122,7 @@ static const char *const ppsz_logics_values[] = {
 static const char *const ppsz_logics[] = { N_("Default"),
                                            N_("Predictive"),
                                            N_("Near Optimal"),
+                                           N_("Buffer Aware Predictive"),
                                            N_("Bandwidth Adaptive"),
                                            N_("Fixed Bandwidth"),
                                            N_("Lowest Bandwidth/Quality"),
@@ -141,8 +159,17 @@ vlc_module_begin ()
         add_integer( "adaptive-maxbuffer",
                      MS_FROM_VLC_TICK(AbstractBufferingLogic::DEFAULT_MAX_BUFFERING),
                      ADAPT_MAXBUFFER_TEXT, nullptr );
+        add_integer( "adaptive-bw-priority", 1,
+                     ADAPT_BWPRIORITY_TEXT, ADAPT_BWPRIORITY_LONGTEXT );
+            change_integer_range( 1, 100 )
         add_integer( "adaptive-lowlatency", -1, ADAPT_LOWLATENCY_TEXT, ADAPT_LOWLATENCY_LONGTEXT );
             change_integer_list(rgi_latency, ppsz_latency)
+        add_integer( "adaptive-lookahead", 2,
+                     ADAPT_LOOKAHEAD_TEXT, ADAPT_LOOKAHEAD_LONGTEXT );
+            change_integer_range( 0, 16 )
+        add_integer( "adaptive-lookahead-budget", 1 << 15,
+                     ADAPT_LOOKAHEAD_BUDGET_TEXT, ADAPT_LOOKAHEAD_BUDGET_LONGTEXT );
+            change_integer_range( 0, 1 << 22 )
         set_callbacks( Open, Close )
 vlc_module_end ()
 
@@ -29,6 +29,7 @@
 #include "HTTPConnection.hpp"
 #include "HTTPConnectionManager.h"
 #include "Downloader.hpp"
+#include "../encryption/CommonEncryption.hpp"
 
 #include <vlc_common.h>
 #include <vlc_block.h>
@@ -36,6 +37,7 @@
 #include <algorithm>
 
 using namespace adaptive::http;
+using adaptive::encryption::CommonEncryptionSession;
 using vlc::threads::mutex_locker;
 
 AbstractChunkSource::AbstractChunkSource(ChunkType t, const BytesRange &range)
@@ -73,6 +75,16 @@ const StorageID & AbstractChunkSource::getStorageID() const
     return storeid;
 }
 
+void AbstractChunkSource::setCacheValidators(const CacheValidators &v)
+{
+    validators = v;
+}
+
+const CacheValidators & AbstractChunkSource::getCacheValidators() const
+{
+    return validators;
+}
+
 ChunkType AbstractChunkSource::getChunkType() const
 {
     return type;
@@ -104,6 +116,11 @@ size_t AbstractChunk::getBytesRead() const
     return this->bytesRead;
 }
 
+const CacheValidators & AbstractChunk::getCacheValidators() const
+{
+    return source->getCacheValidators();
+}
+
 uint64_t AbstractChunk::getStartByteInFile() const
 {
     if(!source || !source->getBytesRange().isValid())
@@ -299,7 +316,8 @@ bool HTTPChunkSource::prepare()
                 break;
         }
 
-        requeststatus = connection->request(connparams.getPath(), bytesRange);
+        requeststatus = connection->request(connparams.getPath(), bytesRange,
+                                            validators);
         if(requeststatus != RequestStatus::Success)
         {
             if(requeststatus == RequestStatus::Redirection)
@@ -316,6 +334,7 @@ bool HTTPChunkSource::prepare()
         /* Because we don't know Chunk size at start, we need to get size
                from content length */
         contentLength = connection->getContentLength();
+        validators = connection->getCacheValidators();
         prepared = true;
         responseTime = vlc_tick_now();
         return true;
@@ -336,6 +355,7 @@ HTTPChunkBufferedSource::HTTPChunkBufferedSource(const std::string& url, Abstrac
     HTTPChunkSource(url, manager, sourceid, type, range, access),
     p_head     (nullptr),
     pp_tail    (&p_head),
+    unread_accounted (0),
     buffered     (0)
 {
     done = false;
@@ -343,6 +363,33 @@ HTTPChunkBufferedSource::HTTPChunkBufferedSource(const std::string& url, Abstrac
     held = false;
     p_read = nullptr;
     inblockreadoffset = 0;
+    received = 0;
+    encryptionSession = nullptr;
+    p_staged = nullptr;
+}
+
+std::atomic<size_t> HTTPChunkBufferedSource::unread_total {0};
+
+size_t HTTPChunkBufferedSource::getUnreadBytesTotal()
+{
+    return unread_total.load(std::memory_order_relaxed);
+}
+
+/* Only media segments count against the shared lookahead byte budget:
+ * init/index chunks are small and may outlive reads through the cache. */
+void HTTPChunkBufferedSource::accountBuffered(size_t bytes)
+{
+    if(type != ChunkType::Segment)
+        return;
+    unread_accounted += bytes;
+    unread_total.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void HTTPChunkBufferedSource::accountConsumed(size_t bytes)
+{
+    bytes = std::min(bytes, unread_accounted);
+    unread_accounted -= bytes;
+    unread_total.fetch_sub(bytes, std::memory_order_relaxed);
 }
 
 HTTPChunkBufferedSource::~HTTPChunkBufferedSource()
@@ -351,6 +398,7 @@ HTTPChunkBufferedSource::~HTTPChunkBufferedSource()
     connManager->cancel(this);
 
     mutex_locker locker {lock};
+    accountConsumed(unread_accounted);
     done = true;
     while(held) /* wait release if not in queue but currently downloaded */
         avail.wait(lock);
@@ -363,6 +411,86 @@ HTTPChunkBufferedSource::~HTTPChunkBufferedSource()
         pp_tail = &p_head;
     }
     buffered = 0;
+
+    if(p_staged)
+        block_Release(p_staged);
+    delete encryptionSession;
+}
+
+void HTTPChunkBufferedSource::setEncryptionSession(CommonEncryptionSession *session)
+{
+    mutex_locker locker {lock};
+    delete encryptionSession;
+    encryptionSession = session;
+}
+
+/* Appends incoming ciphertext to the staging buffer and decrypts as much of
+ * it as can safely be published: CBC wants 16 bytes blocks, and the very
+ * last one must be known as such to strip the PKCS#7 padding, so a block
+ * tail is held back until more data or the end of transfer shows up.
+ * Returns decrypted data ready for the read chain. Needs lock held. */
+block_t * HTTPChunkBufferedSource::decryptStaged(block_t *p_new, bool b_last)
+{
+    if(p_new)
+    {
+        if(p_staged)
+        {
+            p_new = block_Realloc(p_new, p_staged->i_buffer, p_new->i_buffer);
+            if(!p_new)
+            {
+                block_Release(p_staged);
+                p_staged = nullptr;
+                return nullptr;
+            }
+            memcpy(p_new->p_buffer, p_staged->p_buffer, p_staged->i_buffer);
+            block_Release(p_staged);
+        }
+        p_staged = p_new;
+    }
+
+    if(!p_staged)
+        return nullptr;
+
+    size_t flushsize;
+    if(b_last)
+        flushsize = p_staged->i_buffer;
+    else if(p_staged->i_buffer > 16)
+        flushsize = (p_staged->i_buffer - 16) & ~(size_t)15;
+    else
+        flushsize = 0;
+
+    if(flushsize == 0)
+        return nullptr;
+
+    block_t *p_out;
+    if(flushsize == p_staged->i_buffer)
+    {
+        p_out = p_staged;
+        p_staged = nullptr;
+    }
+    else
+    {
+        p_out = block_Alloc(flushsize);
+        if(!p_out)
+            return nullptr;
+        memcpy(p_out->p_buffer, p_staged->p_buffer, flushsize);
+        p_staged->i_buffer -= flushsize;
+        memmove(p_staged->p_buffer, &p_staged->p_buffer[flushsize],
+                p_staged->i_buffer);
+    }
+
+    p_out->i_buffer = encryptionSession->decrypt(p_out->p_buffer,
+                                                 p_out->i_buffer, b_last);
+    if(b_last)
+        encryptionSession->close();
+
+    if(p_out->i_buffer == 0)
+    {
+        block_Release(p_out);
+        return nullptr;
+    }
+
+    return p_out;
 }
 
 bool HTTPChunkBufferedSource::isDone() const
@@ -399,8 +527,8 @@ void HTTPChunkBufferedSource::bufferize(size_t readsize)
         if(readsize < HTTPChunkSource::CHUNK_SIZE)
             readsize = HTTPChunkSource::CHUNK_SIZE;
 
-        if(contentLength && readsize > contentLength - buffered)
-            readsize = contentLength - buffered;
+        if(contentLength && readsize > contentLength - received)
+            readsize = contentLength - received;
     }
 
     block_t *p_block = block_Alloc(readsize);
@@ -417,15 +545,32 @@ void HTTPChunkBufferedSource::bufferize(size_t readsize)
         vlc_tick_t latency;
     } rate = {0,0,0};
 
-    ssize_t ret = connection->read(p_block->p_buffer, readsize);
+    /* Read whatever the transport already has: chunked transfers deliver
+     * CMAF chunks long before the segment is complete, and each block
+     * wakes up the demuxer straight away */
+    ssize_t ret = connection->readPartial(p_block->p_buffer, readsize);
     if(ret <= 0)
     {
         block_Release(p_block);
         p_block = nullptr;
         mutex_locker locker {lock};
+        /* transfer ended without announced length, flush what was staged */
+        if(encryptionSession)
+            p_block = decryptStaged(nullptr, true);
+        if(p_block)
+        {
+            buffered += p_block->i_buffer;
+            accountBuffered(p_block->i_buffer);
+            block_ChainLastAppend(&pp_tail, p_block);
+            if(p_read == nullptr)
+            {
+                p_read = p_block;
+                inblockreadoffset = 0;
+            }
+        }
         done = true;
         downloadEndTime = vlc_tick_now();
-        rate.size = buffered;
+        rate.size = received;
         rate.time = downloadEndTime - requestStartTime;
         rate.latency = responseTime - requestStartTime;
     }
@@ -433,18 +578,26 @@ void HTTPChunkBufferedSource::bufferize(size_t readsize)
     {
         p_block->i_buffer = (size_t) ret;
         mutex_locker locker {lock};
-        buffered += p_block->i_buffer;
-        block_ChainLastAppend(&pp_tail, p_block);
-        if(p_read == nullptr)
+        received += (size_t) ret;
+        const bool b_last = contentLength && received >= contentLength;
+        if(encryptionSession)
+            p_block = decryptStaged(p_block, b_last);
+        if(p_block)
         {
-            p_read = p_block;
-            inblockreadoffset = 0;
+            buffered += p_block->i_buffer;
+            accountBuffered(p_block->i_buffer);
+            block_ChainLastAppend(&pp_tail, p_block);
+            if(p_read == nullptr)
+            {
+                p_read = p_block;
+                inblockreadoffset = 0;
+            }
         }
-        if((size_t) ret < readsize)
+        if(b_last)
         {
             done = true;
             downloadEndTime = vlc_tick_now();
-            rate.size = buffered;
+            rate.size = received;
             rate.time = downloadEndTime - requestStartTime;
             rate.latency = responseTime - requestStartTime;
         }
@@ -493,6 +646,7 @@ block_t * HTTPChunkBufferedSource::readBlock()
     /* dequeue */
     p_block = block_Duplicate(p_read);
     consumed += p_block->i_buffer;
+    accountConsumed(p_block->i_buffer);
     p_read = p_read->p_next;
     inblockreadoffset = 0;
     if(p_read == nullptr && done)
@@ -531,6 +685,7 @@ block_t * HTTPChunkBufferedSource::read(size_t readsize)
     }
 
     consumed += copied;
+    accountConsumed(copied);
     p_block->i_buffer = copied;
 
     if(copied < readsize)
@@ -540,9 +695,12 @@ block_t * HTTPChunkBufferedSource::read(size_t readsize)
 }
 
 HTTPChunk::HTTPChunk(const std::string &url, AbstractConnectionManager *manager,
-                     const adaptive::ID &id, ChunkType type, const BytesRange &range):
+                     const adaptive::ID &id, ChunkType type, const BytesRange &range,
+                     const CacheValidators &validators):
     AbstractChunk(manager->makeSource(url, id, type, range))
 {
+    /* must be set before the downloader gets a chance to issue the request */
+    source->setCacheValidators(validators);
     manager->start(source);
 }
 
@@ -25,6 +25,7 @@
 #ifndef CHUNK_H_
 #define CHUNK_H_
 
+#include <atomic>
 #include <cstdint>
 #include <string>
 
@@ -37,6 +38,11 @@ typedef struct vlc_frame_t block_t;
 
 namespace adaptive
 {
+    namespace encryption
+    {
+        class CommonEncryptionSession;
+    }
+
     namespace http
     {
         class AbstractConnection;
@@ -75,6 +81,8 @@ namespace adaptive
                 const BytesRange &  getBytesRange   () const;
                 ChunkType           getChunkType    () const;
                 const StorageID &   getStorageID    () const;
+                void                setCacheValidators(const CacheValidators &);
+                const CacheValidators & getCacheValidators() const;
                 virtual std::string getContentType  () const override;
                 virtual RequestStatus getRequestStatus() const override;
                 virtual void        recycle() = 0;
@@ -86,6 +94,7 @@ namespace adaptive
                 ChunkType           type;
                 RequestStatus       requeststatus;
                 size_t              contentLength;
+                CacheValidators     validators;
                 BytesRange          bytesRange;
         };
 
@@ -99,6 +108,7 @@ namespace adaptive
                 virtual size_t        getBytesRead          () const override;
                 virtual bool          hasMoreData           () const override;
                 uint64_t              getStartByteInFile    () const;
+                const CacheValidators & getCacheValidators  () const;
 
                 virtual block_t *   readBlock       () override;
                 virtual block_t *   read            (size_t) override;
@@ -166,6 +176,14 @@ namespace adaptive
                 virtual bool       hasMoreData     () const  override;
                 virtual void        recycle() override;
 
+                /* Takes ownership. Must be set before the download starts:
+                 * blocks are then decrypted on the downloader thread as they
+                 * arrive, overlapped with the transfer */
+                void               setEncryptionSession(encryption::CommonEncryptionSession *);
+
+                /* Segment bytes downloaded but not read yet, all sources */
+                static size_t      getUnreadBytesTotal();
+
             protected:
                 HTTPChunkBufferedSource(const std::string &url, AbstractConnectionManager *,
                                         const ID &, ChunkType, const BytesRange &,
@@ -176,11 +194,19 @@ namespace adaptive
                 void               release();
 
             private:
+                void               accountBuffered(size_t);
+                void               accountConsumed(size_t);
+                block_t           *decryptStaged(block_t *, bool);
+                static std::atomic<size_t> unread_total;
+                size_t              unread_accounted;
                 block_t            *p_head; /* read cache buffer */
                 block_t           **pp_tail;
                 const block_t      *p_read;
                 size_t              inblockreadoffset;
                 size_t              buffered; /* read cache size */
+                size_t              received; /* transport bytes, ciphertext */
+                encryption::CommonEncryptionSession *encryptionSession;
+                block_t            *p_staged; /* ciphertext pending decryption */
                 bool                done;
                 bool                eof;
                 vlc::threads::condition_variable avail;
@@ -191,7 +217,8 @@ namespace adaptive
         {
             public:
                 HTTPChunk(const std::string &url, AbstractConnectionManager *,
-                          const ID &, ChunkType, const BytesRange &);
+                          const ID &, ChunkType, const BytesRange &,
+                          const CacheValidators & = CacheValidators());
                 virtual ~HTTPChunk();
 
             protected:
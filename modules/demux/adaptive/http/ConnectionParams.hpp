@@ -33,11 +33,21 @@ namespace adaptive
         {
             Success,
             Redirection,
+            NotModified,
             Unauthorized,
             NotFound,
             GenericError,
         };
 
+        class CacheValidators
+        {
+            /* ETag/Last-Modified pair for conditional requests */
+            public:
+                bool isSet() const { return !etag.empty() || !lastModified.empty(); }
+                std::string etag;
+                std::string lastModified;
+        };
+
         class BackendPrefInterface
         {
             /* Design Hack for now to force fallback on regular access
@@ -35,6 +35,13 @@ Downloader::Downloader()
     thread_handle_valid = false;
     current = nullptr;
     cancel_current = false;
+    byte_budget = 0; /* unlimited */
+}
+
+void Downloader::setByteBudget(size_t bytes)
+{
+    vlc::threads::mutex_locker locker {lock};
+    byte_budget = bytes;
 }
 
 bool Downloader::start()
@@ -111,8 +118,19 @@ void Downloader::Run()
         }
 
         current = chunks.front();
+
+        /* Hold off further transfers when the downloaded but unread segment
+         * data of the pipelined sources exceeds the shared byte budget.
+         * Reads from the demuxers bring the level back down. */
+        while(byte_budget && !killed && !cancel_current &&
+              current->getChunkType() == ChunkType::Segment &&
+              HTTPChunkBufferedSource::getUnreadBytesTotal() >= byte_budget)
+            wait_cond.timedwait(lock, vlc_tick_now() + VLC_TICK_FROM_MS(100));
+
+        bool b_transfer = !killed && !cancel_current;
         lock.unlock();
-        current->bufferize(HTTPChunkSource::CHUNK_SIZE);
+        if(b_transfer)
+            current->bufferize(HTTPChunkSource::CHUNK_SIZE);
         lock.lock();
         if(current->isDone() || cancel_current)
         {
@@ -40,6 +40,7 @@ namespace adaptive
                 bool start();
                 void schedule(HTTPChunkBufferedSource *);
                 void cancel(HTTPChunkBufferedSource *);
+                void setByteBudget(size_t);
 
             private:
                 static void * downloaderThread(void *);
@@ -52,6 +53,7 @@ namespace adaptive
                 bool         thread_handle_valid;
                 bool         killed;
                 bool         cancel_current;
+                size_t       byte_budget;
                 std::list<HTTPChunkBufferedSource *> chunks;
                 HTTPChunkBufferedSource *current;
         };
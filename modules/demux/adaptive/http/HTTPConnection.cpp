@@ -78,6 +78,11 @@ const std::string & AbstractConnection::getContentType() const
     return contentType;
 }
 
+const CacheValidators & AbstractConnection::getCacheValidators() const
+{
+    return validators;
+}
+
 const ConnectionParams & AbstractConnection::getRedirection() const
 {
     return locationparams;
@@ -132,6 +137,18 @@ class adaptive::http::LibVLCHTTPSource : public adaptive::AbstractSource
         {
             vlc_http_msg_add_header(req, "Accept-Encoding", "deflate, gzip");
             vlc_http_msg_add_header(req, "Cache-Control", "no-cache");
+            if(!conditional.etag.empty())
+            {
+                if (vlc_http_msg_add_header(req, "If-None-Match", "%s",
+                                            conditional.etag.c_str()))
+                    return -1;
+            }
+            else if(!conditional.lastModified.empty())
+            {
+                if (vlc_http_msg_add_header(req, "If-Modified-Since", "%s",
+                                            conditional.lastModified.c_str()))
+                    return -1;
+            }
             if(range.isValid())
             {
                 if(range.getEndByte() > 0)
@@ -187,15 +204,18 @@ class adaptive::http::LibVLCHTTPSource : public adaptive::AbstractSource
         size_t totalRead;
         struct vlc_http_mgr *http_mgr;
         BytesRange range;
+        CacheValidators conditional;
 
     public:
         struct vlc_http_resource *http_res;
         int create(const char *uri,const std::string &ua,
-                   const std::string &ref, const BytesRange &range)
+                   const std::string &ref, const BytesRange &range,
+                   const CacheValidators &conditional)
         {
             struct restuple *tpl = new struct restuple;
             tpl->source = this;
             this->range = range;
+            this->conditional = conditional;
             if (vlc_http_res_init(&tpl->resource, &this->callbacks, http_mgr, uri,
                                   ua.empty() ? nullptr : ua.c_str(),
                                   ref.empty() ? nullptr : ref.c_str()))
@@ -273,6 +293,7 @@ void LibVLCHTTPConnection::reset()
     }
     bytesRange = BytesRange();
     contentType = std::string();
+    validators = CacheValidators();
     bytesRead = 0;
     contentLength = 0;
 }
@@ -287,7 +308,8 @@ bool LibVLCHTTPConnection::canReuse(const ConnectionParams &params_) const
 }
 
 RequestStatus LibVLCHTTPConnection::request(const std::string &path,
-                                            const BytesRange &range)
+                                            const BytesRange &range,
+                                            const CacheValidators &conditional)
 {
     if(source->http_mgr == nullptr)
         return RequestStatus::GenericError;
@@ -303,7 +325,7 @@ RequestStatus LibVLCHTTPConnection::request(const std::string &path,
     else
         msg_Dbg(p_object, "Retrieving %s", params.getUrl().c_str());
 
-    if(source->create(params.getUrl().c_str(), useragent,referer, range))
+    if(source->create(params.getUrl().c_str(), useragent,referer, range, conditional))
         return RequestStatus::GenericError;
 
     struct vlc_credential crd;
@@ -374,6 +396,9 @@ RequestStatus LibVLCHTTPConnection::request(const std::string &path,
     if (status >= 400)
         return RequestStatus::GenericError;
 
+    if (status == 304) /* conditional request, content did not change */
+        return RequestStatus::NotModified;
+
     char *psz_redir = vlc_http_res_get_redirect(source->http_res);
     if(psz_redir)
     {
@@ -399,6 +424,14 @@ RequestStatus LibVLCHTTPConnection::request(const std::string &path,
     if(s)
         contentType = std::string(s);
 
+    s = vlc_http_msg_get_header(source->http_res->response, "ETag");
+    if(s)
+        validators.etag = std::string(s);
+
+    s = vlc_http_msg_get_header(source->http_res->response, "Last-Modified");
+    if(s)
+        validators.lastModified = std::string(s);
+
     s = vlc_http_msg_get_header(source->http_res->response, "Content-Encoding");
     if(s && stream && (strstr(s, "deflate") || strstr(s, "gzip")))
     {
@@ -420,6 +453,13 @@ ssize_t LibVLCHTTPConnection::read(void *p_buffer, size_t len)
     return read;
 }
 
+ssize_t LibVLCHTTPConnection::readPartial(void *p_buffer, size_t len)
+{
+    ssize_t read = vlc_stream_ReadPartial(stream, p_buffer, len);
+    bytesRead = source->totalRead;
+    return read;
+}
+
 void LibVLCHTTPConnection::setUsed( bool b )
 {
     available = !b;
@@ -461,7 +501,8 @@ bool StreamUrlConnection::canReuse(const ConnectionParams &params_) const
 }
 
 RequestStatus StreamUrlConnection::request(const std::string &path,
-                                           const BytesRange &range)
+                                           const BytesRange &range,
+                                           const CacheValidators &)
 {
     reset();
 
@@ -535,6 +576,34 @@ ssize_t StreamUrlConnection::read(void *p_buffer, size_t len)
     return ret;
 }
 
+ssize_t StreamUrlConnection::readPartial(void *p_buffer, size_t len)
+{
+    if( !p_streamurl )
+        return VLC_EGENERIC;
+
+    if(len == 0)
+        return VLC_SUCCESS;
+
+    const size_t toRead = (contentLength) ? contentLength - bytesRead : len;
+    if (toRead == 0)
+        return VLC_SUCCESS;
+
+    if(len > toRead)
+        len = toRead;
+
+    ssize_t ret = vlc_stream_ReadPartial(p_streamurl, p_buffer, len);
+    if(ret >= 0)
+        bytesRead += ret;
+
+    if(ret < 0 || (contentLength && contentLength == bytesRead)) /* set EOF */
+    {
+        reset();
+        return ret;
+    }
+
+    return ret;
+}
+
 void StreamUrlConnection::setUsed( bool b )
 {
     available = !b;
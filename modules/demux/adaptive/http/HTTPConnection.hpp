@@ -50,12 +50,17 @@ namespace adaptive
                 virtual bool    canReuse     (const ConnectionParams &) const = 0;
 
                 virtual RequestStatus request(const std::string& path,
-                                              const BytesRange & = BytesRange()) = 0;
+                                              const BytesRange & = BytesRange(),
+                                              const CacheValidators & = CacheValidators()) = 0;
                 virtual ssize_t read        (void *p_buffer, size_t len) = 0;
+                /* returns as soon as some data is available, without waiting
+                   for the full read size; needed for chunked transfers */
+                virtual ssize_t readPartial (void *p_buffer, size_t len) = 0;
 
                 virtual size_t  getContentLength() const;
                 virtual size_t  getBytesRead() const;
                 virtual const std::string & getContentType() const;
+                virtual const CacheValidators & getCacheValidators() const;
                 virtual const ConnectionParams &getRedirection() const;
                 virtual void    setUsed( bool ) = 0;
 
@@ -66,6 +71,7 @@ namespace adaptive
                 bool               available;
                 size_t             contentLength;
                 std::string        contentType;
+                CacheValidators    validators;
                 BytesRange         bytesRange;
                 size_t             bytesRead;
         };
@@ -79,8 +85,10 @@ namespace adaptive
                virtual ~LibVLCHTTPConnection();
                virtual bool    canReuse     (const ConnectionParams &) const override;
                virtual RequestStatus request(const std::string& path,
-                                             const BytesRange & = BytesRange()) override;
+                                             const BytesRange & = BytesRange(),
+                                             const CacheValidators & = CacheValidators()) override;
                virtual ssize_t read         (void *p_buffer, size_t len) override;
+               virtual ssize_t readPartial  (void *p_buffer, size_t len) override;
                virtual void    setUsed      ( bool ) override;
 
             private:
@@ -101,8 +109,10 @@ namespace adaptive
                 virtual bool    canReuse     (const ConnectionParams &) const override;
 
                 virtual RequestStatus request(const std::string& path,
-                                              const BytesRange & = BytesRange()) override;
+                                              const BytesRange & = BytesRange(),
+                                              const CacheValidators & = CacheValidators()) override;
                 virtual ssize_t read        (void *p_buffer, size_t len) override;
+                virtual ssize_t readPartial (void *p_buffer, size_t len) override;
 
                 virtual void    setUsed( bool ) override;
 
@@ -42,6 +42,7 @@ AbstractConnectionManager::AbstractConnectionManager(vlc_object_t *p_object_)
 {
     p_object = p_object_;
     rateObserver = nullptr;
+    governorSession = nullptr;
 }
 
 AbstractConnectionManager::~AbstractConnectionManager()
@@ -54,6 +55,20 @@ void AbstractConnectionManager::updateDownloadRate(const adaptive::ID &sourceid,
 {
     if(rateObserver)
     {
+        if(governorSession && time)
+        {
+            const size_t bps = CLOCK_FREQ * size * 8 / time;
+            BandwidthGovernor::reportRate(governorSession, bps);
+            const size_t share = BandwidthGovernor::getShare(governorSession);
+            if(share && bps > share)
+            {
+                /* scale the sample down so this session's estimator
+                   converges to its share of the link */
+                BwDebug(msg_Dbg(p_object, "governor caps %zuKbps sample to %zuKbps",
+                                bps / 1000, share / 1000));
+                size = share * time / (CLOCK_FREQ * 8);
+            }
+        }
         BwDebug(msg_Dbg(p_object,
                 "%" PRId64 "Kbps downloaded %zuKBytes in %" PRId64 "ms latency %" PRId64 "ms [%s]",
                 1000 * size * 8 / (time ? time : 1), size / 1024, MS_FROM_VLC_TICK(time),
@@ -67,6 +82,11 @@ void AbstractConnectionManager::setDownloadRateObserver(IDownloadRateObserver *o
     rateObserver = obs;
 }
 
+void AbstractConnectionManager::setBandwidthSharing(BandwidthGovernor::Session *session)
+{
+    governorSession = session;
+}
+
 void AbstractConnectionManager::deleteSource(AbstractChunkSource *source)
 {
     delete source;
@@ -78,6 +98,8 @@ HTTPConnectionManager::HTTPConnectionManager    (vlc_object_t *p_object_)
 {
     vlc_mutex_init(&lock);
     downloader = new Downloader();
+    downloader->setByteBudget((size_t)
+        var_InheritInteger(p_object_, "adaptive-lookahead-budget") << 10);
     downloaderhp = new Downloader();
     downloader->start();
     downloaderhp->start();
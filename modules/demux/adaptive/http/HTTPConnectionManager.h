@@ -26,6 +26,7 @@
 #define HTTPCONNECTIONMANAGER_H_
 
 #include "../logic/IDownloadRateObserver.h"
+#include "../SharedResources.hpp"
 #include "BytesRange.hpp"
 
 #include <vlc_common.h>
@@ -64,6 +65,7 @@ namespace adaptive
                 virtual void updateDownloadRate(const ID &, size_t,
                                                 vlc_tick_t, vlc_tick_t) override;
                 void setDownloadRateObserver(IDownloadRateObserver *);
+                void setBandwidthSharing(BandwidthGovernor::Session *);
 
             protected:
                 void deleteSource(AbstractChunkSource *);
@@ -71,6 +73,7 @@ namespace adaptive
 
             private:
                 IDownloadRateObserver                              *rateObserver;
+                BandwidthGovernor::Session                         *governorSession;
         };
 
         class HTTPConnectionManager : public AbstractConnectionManager
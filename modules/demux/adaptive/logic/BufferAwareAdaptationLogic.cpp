@@ -0,0 +1,243 @@
+/*
+ * BufferAwareAdaptationLogic.cpp
+ *****************************************************************************
+ * Copyright (C) 2026 - VideoLAN Authors
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "BufferAwareAdaptationLogic.hpp"
+#include "Representationselectors.hpp"
+
+#include "../playlist/BaseAdaptationSet.h"
+#include "../playlist/BaseRepresentation.h"
+#include "../tools/Debug.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace adaptive::logic;
+using namespace adaptive;
+
+/*
+ * Buffer occupancy aware selection on top of a conservative throughput
+ * predictor. The predictor is the minimum of a fast EWMA, a slow EWMA and
+ * the 25th percentile of the recent sample window, so a single lucky
+ * download cannot trigger an up-switch; the buffer watermarks add the
+ * hysteresis that keeps cellular links from oscillating between
+ * representations.
+ */
+
+#define EWMA_FAST_ALPHA  0.50f
+#define EWMA_SLOW_ALPHA  0.10f
+#define WINDOW_SIZE      16
+#define SAFETY_FACTOR    0.90f
+#define PANIC_FACTOR     0.70f
+
+BufferAwareContext::BufferAwareContext()
+    : buffering_level( 0 )
+    , buffering_target( VLC_TICK_FROM_SEC(30) )
+    , ewma_fast( 0.0f )
+    , ewma_slow( 0.0f )
+{ }
+
+BufferAwareAdaptationLogic::BufferAwareAdaptationLogic(vlc_object_t *obj)
+    : AbstractAdaptationLogic(obj)
+    , usedBps( 0 )
+{
+    vlc_mutex_init(&lock);
+}
+
+BufferAwareAdaptationLogic::~BufferAwareAdaptationLogic()
+{
+}
+
+unsigned BufferAwareAdaptationLogic::getPredictedBw(const BufferAwareContext &ctx) const
+{
+    if(ctx.window.empty())
+        return 0;
+
+    std::vector<unsigned> sorted(ctx.window.begin(), ctx.window.end());
+    std::vector<unsigned>::size_type idx = (sorted.size() - 1) / 4;
+    std::nth_element(sorted.begin(), sorted.begin() + idx, sorted.end());
+    float percentile = sorted[idx];
+
+    float predicted = std::min(ctx.ewma_fast, ctx.ewma_slow);
+    predicted = std::min(predicted, percentile);
+    return (unsigned) predicted;
+}
+
+unsigned BufferAwareAdaptationLogic::getAvailableBw(unsigned i_bw, const BaseRepresentation *curRep) const
+{
+    unsigned i_remain = i_bw;
+    if(i_remain > usedBps)
+        i_remain -= usedBps;
+    else
+        i_remain = 0;
+    if(curRep)
+        i_remain += curRep->getBandwidth();
+    return i_remain > i_bw ? i_remain : i_bw;
+}
+
+BaseRepresentation *BufferAwareAdaptationLogic::getNextRepresentation(BaseAdaptationSet *adaptSet, BaseRepresentation *prevRep)
+{
+    RepresentationSelector selector(maxwidth, maxheight);
+
+    BaseRepresentation *lowest = selector.lowest(adaptSet);
+    BaseRepresentation *highest = selector.highest(adaptSet);
+    if(lowest == nullptr || highest == nullptr)
+        return nullptr;
+
+    if(lowest == highest)
+        return lowest;
+
+    vlc_mutex_lock(&lock);
+
+    std::map<ID, BufferAwareContext>::iterator it = streams.find(adaptSet->getID());
+    if(it == streams.end())
+    {
+        vlc_mutex_unlock(&lock);
+        return lowest;
+    }
+    BufferAwareContext ctxcopy = (*it).second;
+    const unsigned bps = getAvailableBw(getPredictedBw(ctxcopy), prevRep);
+
+    vlc_mutex_unlock(&lock);
+
+    if(prevRep == nullptr) /* Starting */
+        return selector.select(adaptSet, bps);
+
+    const vlc_tick_t low_watermark = ctxcopy.buffering_target / 4;
+    const vlc_tick_t high_watermark = ctxcopy.buffering_target * 3 / 4;
+
+    BaseRepresentation *next;
+    if(ctxcopy.buffering_level < low_watermark)
+    {
+        /* The buffer is draining: switch down aggressively, and never up */
+        next = selector.select(adaptSet, (uint64_t)(bps * PANIC_FACTOR));
+        if(next->getBandwidth() > prevRep->getBandwidth())
+            next = prevRep;
+    }
+    else if(ctxcopy.buffering_level >= high_watermark)
+    {
+        /* Comfortable buffer: allow climbing one step at a time, and only
+         * when the predictor sustains the higher representation */
+        next = selector.higher(adaptSet, prevRep);
+        if(next->getBandwidth() > bps * SAFETY_FACTOR)
+            next = prevRep;
+    }
+    else
+    {
+        /* Mid buffer: hold, unless the current pick outruns the predictor */
+        next = prevRep;
+        if(prevRep->getBandwidth() > bps)
+            next = selector.select(adaptSet, (uint64_t)(bps * SAFETY_FACTOR));
+    }
+
+    BwDebug( msg_Info(p_obj, "buffering level %.2f%% pred %u kBps rep %ld kBps",
+             (float) 100 * ctxcopy.buffering_level / ctxcopy.buffering_target,
+             bps / 8000, next->getBandwidth() / 8000); );
+
+    return next;
+}
+
+void BufferAwareAdaptationLogic::updateDownloadRate(const ID &id, size_t dlsize,
+                                                    vlc_tick_t time, vlc_tick_t)
+{
+    if(time == 0)
+        return;
+
+    vlc_mutex_locker locker(&lock);
+    std::map<ID, BufferAwareContext>::iterator it = streams.find(id);
+    if(it == streams.end())
+        return;
+
+    BufferAwareContext &ctx = (*it).second;
+    const unsigned sample = CLOCK_FREQ * dlsize * 8 / time;
+
+    if(ctx.window.empty())
+    {
+        ctx.ewma_fast = sample;
+        ctx.ewma_slow = sample;
+    }
+    else
+    {
+        ctx.ewma_fast += EWMA_FAST_ALPHA * (sample - ctx.ewma_fast);
+        ctx.ewma_slow += EWMA_SLOW_ALPHA * (sample - ctx.ewma_slow);
+    }
+
+    ctx.window.push_back(sample);
+    if(ctx.window.size() > WINDOW_SIZE)
+        ctx.window.pop_front();
+}
+
+void BufferAwareAdaptationLogic::trackerEvent(const TrackerEvent &ev)
+{
+    switch(ev.getType())
+    {
+    case TrackerEvent::Type::RepresentationSwitch:
+        {
+            const RepresentationSwitchEvent &event =
+                    static_cast<const RepresentationSwitchEvent &>(ev);
+            vlc_mutex_locker locker(&lock);
+            if(event.prev)
+                usedBps -= event.prev->getBandwidth();
+            if(event.next)
+                usedBps += event.next->getBandwidth();
+        }
+        break;
+
+    case TrackerEvent::Type::BufferingStateUpdate:
+        {
+            const BufferingStateUpdatedEvent &event =
+                    static_cast<const BufferingStateUpdatedEvent &>(ev);
+            const ID &id = *event.id;
+            vlc_mutex_locker locker(&lock);
+            if(event.enabled)
+            {
+                if(streams.find(id) == streams.end())
+                {
+                    BufferAwareContext ctx;
+                    streams.insert(std::pair<ID, BufferAwareContext>(id, ctx));
+                }
+            }
+            else
+            {
+                std::map<ID, BufferAwareContext>::iterator it = streams.find(id);
+                if(it != streams.end())
+                    streams.erase(it);
+            }
+        }
+        break;
+
+    case TrackerEvent::Type::BufferingLevelChange:
+        {
+            const BufferingLevelChangedEvent &event =
+                    static_cast<const BufferingLevelChangedEvent &>(ev);
+            const ID &id = *event.id;
+            vlc_mutex_locker locker(&lock);
+            BufferAwareContext &ctx = streams[id];
+            ctx.buffering_level = event.current;
+            ctx.buffering_target = event.target;
+        }
+        break;
+
+    default:
+            break;
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ * BufferAwareAdaptationLogic.hpp
+ *****************************************************************************
+ * Copyright (C) 2026 - VideoLAN Authors
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+#ifndef BUFFERAWAREADAPTATIONLOGIC_HPP
+#define BUFFERAWAREADAPTATIONLOGIC_HPP
+
+#include "AbstractAdaptationLogic.h"
+#include <map>
+#include <deque>
+
+namespace adaptive
+{
+    namespace logic
+    {
+        class BufferAwareContext
+        {
+            friend class BufferAwareAdaptationLogic;
+
+            public:
+                BufferAwareContext();
+
+            private:
+                vlc_tick_t buffering_level;
+                vlc_tick_t buffering_target;
+                float ewma_fast;
+                float ewma_slow;
+                std::deque<unsigned> window;
+        };
+
+        class BufferAwareAdaptationLogic : public AbstractAdaptationLogic
+        {
+            public:
+                BufferAwareAdaptationLogic          (vlc_object_t *);
+                virtual ~BufferAwareAdaptationLogic ();
+
+                virtual BaseRepresentation* getNextRepresentation(BaseAdaptationSet *,
+                                                                  BaseRepresentation *) override;
+                virtual void                updateDownloadRate     (const ID &, size_t,
+                                                                    vlc_tick_t, vlc_tick_t) override;
+                virtual void                trackerEvent           (const TrackerEvent &) override;
+
+            private:
+                unsigned                    getPredictedBw(const BufferAwareContext &) const;
+                unsigned                    getAvailableBw(unsigned, const BaseRepresentation *) const;
+                std::map<adaptive::ID, BufferAwareContext> streams;
+                unsigned                    usedBps;
+                mutable vlc_mutex_t         lock;
+        };
+    }
+}
+
+#endif // BUFFERAWAREADAPTATIONLOGIC_HPP
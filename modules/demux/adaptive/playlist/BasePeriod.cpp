@@ -44,6 +44,17 @@ BasePeriod::BasePeriod(BasePlaylist *playlist_) :
     duration.Set(0);
     startTime.Set(0);
     playlist = playlist_;
+    sourceNodeHash = 0;
+}
+
+uint64_t BasePeriod::getSourceNodeHash() const
+{
+    return sourceNodeHash;
+}
+
+void BasePeriod::setSourceNodeHash(uint64_t hash)
+{
+    sourceNodeHash = hash;
 }
 
 BasePeriod::~BasePeriod ()
@@ -49,12 +49,18 @@ namespace adaptive
                 virtual vlc_tick_t getPeriodDuration() const override;
                 virtual BasePlaylist *getPlaylist() const override;
 
+                /* hash of the source document subtree, when the origin
+                   format supports it; lets updates skip unchanged periods */
+                uint64_t                            getSourceNodeHash() const;
+                void                                setSourceNodeHash(uint64_t);
+
                 Property<vlc_tick_t> duration;
                 Property<vlc_tick_t> startTime;
 
             private:
                 std::vector<BaseAdaptationSet *>    adaptationSets;
                 BasePlaylist *playlist;
+                uint64_t sourceNodeHash;
         };
     }
 }
@@ -164,7 +164,16 @@ void BasePlaylist::updateWith(BasePlaylist *updatedPlaylist)
     availabilityEndTime.Set(updatedPlaylist->availabilityEndTime.Get());
 
     for(size_t i = 0; i < periods.size() && i < updatedPlaylist->periods.size(); i++)
-        periods.at(i)->updateWith(updatedPlaylist->periods.at(i));
+    {
+        BasePeriod *local = periods.at(i);
+        BasePeriod *updated = updatedPlaylist->periods.at(i);
+        /* source subtree unchanged, keep the live objects untouched */
+        if(local->getSourceNodeHash() &&
+           local->getSourceNodeHash() == updated->getSourceNodeHash())
+            continue;
+        local->updateWith(updated);
+        local->setSourceNodeHash(updated->getSourceNodeHash());
+    }
 }
 
 void BasePlaylist::debug() const
@@ -191,6 +191,11 @@ std::string BaseRepresentation::contextualize(size_t, const std::string &compone
     return component;
 }
 
+UrlParseCache * BaseRepresentation::getUrlParseCache() const
+{
+    return &urlParseCache;
+}
+
 bool BaseRepresentation::bwCompare(const BaseRepresentation *a,
                                    const BaseRepresentation *b)
 {
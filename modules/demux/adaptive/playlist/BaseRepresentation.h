@@ -78,6 +78,8 @@ namespace adaptive
                 virtual std::string contextualize(size_t, const std::string &,
                                                   const SegmentTemplate *) const;
 
+                UrlParseCache * getUrlParseCache() const;
+
                 static bool         bwCompare(const BaseRepresentation *a,
                                               const BaseRepresentation *b);
 
@@ -93,6 +95,7 @@ namespace adaptive
                 BaseAdaptationSet                  *adaptationSet;
                 uint64_t                            bandwidth;
                 std::list<std::string>              codecs;
+                mutable UrlParseCache               urlParseCache;
         };
     }
 }
@@ -82,5 +82,15 @@ void SegmentChunk::setStreamFormat(const StreamFormat &f)
 void SegmentChunk::setEncryptionSession(CommonEncryptionSession *s)
 {
     delete encryptionSession;
-    encryptionSession = s;
+    encryptionSession = nullptr;
+
+    /* When the source buffers on the downloader thread, hand the session
+     * over so decryption overlaps with the transfer instead of stalling
+     * the demuxer at read time. Otherwise decrypt on read as before. */
+    HTTPChunkBufferedSource *bufsource =
+            dynamic_cast<HTTPChunkBufferedSource *>(source);
+    if(bufsource)
+        bufsource->setEncryptionSession(s);
+    else
+        encryptionSession = s;
 }
@@ -29,6 +29,34 @@
 
 using namespace adaptive::playlist;
 
+UrlParseCache::UrlParseCache()
+{
+    vlc_mutex_init(&lock);
+    b_valid = false;
+}
+
+UrlParseCache::~UrlParseCache()
+{
+    if(b_valid)
+        vlc_UrlClean(&url);
+}
+
+char * UrlParseCache::resolve(const std::string &newbase, const char *ref)
+{
+    vlc_mutex_locker locker(&lock);
+    if(!b_valid || base != newbase)
+    {
+        if(b_valid)
+            vlc_UrlClean(&url);
+        base = newbase;
+        /* a partially parsed base resolves the same way as with
+           vlc_uri_resolve() */
+        vlc_UrlParse(&url, base.c_str());
+        b_valid = true;
+    }
+    return vlc_uri_resolve_url(&url, ref);
+}
+
 Url::Url()
 {
 }
@@ -126,8 +154,10 @@ std::string Url::toString(size_t index, const BaseRepresentation *rep) const
         else
         {
             char *psz_fixup = vlc_uri_fixup( part.c_str() );
-            char *psz_resolved = vlc_uri_resolve( ret.c_str(),
-                                                  psz_fixup ? psz_fixup : part.c_str() );
+            const char *psz_ref = psz_fixup ? psz_fixup : part.c_str();
+            char *psz_resolved = rep
+                               ? rep->getUrlParseCache()->resolve( ret, psz_ref )
+                               : vlc_uri_resolve( ret.c_str(), psz_ref );
             free(psz_fixup);
             if( psz_resolved )
             {
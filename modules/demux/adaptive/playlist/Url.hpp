@@ -23,6 +23,7 @@
 #include <string>
 #include <vector>
 #include <vlc_common.h>
+#include <vlc_url.h>
 
 namespace adaptive
 {
@@ -31,6 +32,22 @@ namespace adaptive
         class SegmentTemplate;
         class BaseRepresentation;
 
+        /* Caches the last parsed base URL, as every segment of a
+           representation gets resolved against the same base */
+        class UrlParseCache
+        {
+            public:
+                UrlParseCache();
+                ~UrlParseCache();
+                char * resolve(const std::string &base, const char *ref);
+
+            private:
+                vlc_mutex_t lock;
+                std::string base;
+                vlc_url_t url;
+                bool b_valid;
+        };
+
         class Url
         {
             public:
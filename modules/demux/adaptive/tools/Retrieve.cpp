@@ -35,14 +35,18 @@ using namespace adaptive;
 using namespace adaptive::http;
 
 block_t * Retrieve::HTTP(SharedResources *resources, ChunkType type,
-                         const std::string &uri)
+                         const std::string &uri,
+                         CacheValidators *validators, RequestStatus *status)
 {
     HTTPChunk *datachunk;
     try
     {
         datachunk = new HTTPChunk(uri, resources->getConnManager(),
-                                  ID(), type, BytesRange());
+                                  ID(), type, BytesRange(),
+                                  validators ? *validators : CacheValidators());
     } catch (...) {
+        if(status)
+            *status = RequestStatus::GenericError;
         return nullptr;
     }
 
@@ -55,6 +59,11 @@ block_t * Retrieve::HTTP(SharedResources *resources, ChunkType type,
             break;
         block_ChainLastAppend(&pp_tail, p_block);
     }
+
+    if(status)
+        *status = datachunk->getRequestStatus();
+    if(validators)
+        *validators = datachunk->getCacheValidators();
     delete datachunk;
 
     return p_head ? block_ChainGather(p_head) : nullptr;
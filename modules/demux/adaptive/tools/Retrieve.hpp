@@ -29,12 +29,16 @@ namespace adaptive
     namespace http
     {
         enum class ChunkType;
+        enum class RequestStatus;
+        class CacheValidators;
     };
 
     class Retrieve
     {
         public:
-            static block_t * HTTP(SharedResources *, http::ChunkType, const std::string &uri);
+            static block_t * HTTP(SharedResources *, http::ChunkType, const std::string &uri,
+                                  http::CacheValidators * = nullptr,
+                                  http::RequestStatus * = nullptr);
     };
 }
 
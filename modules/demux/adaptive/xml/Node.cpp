@@ -119,6 +119,30 @@ void Node::setType(int type)
     this->type = type;
 }
 
+/* FNV-1a over a string, starting from a previous hash state */
+static uint64_t hash_continue(uint64_t h, const std::string &s)
+{
+    for(size_t i = 0; i < s.size(); i++)
+        h = (h ^ (unsigned char)s[i]) * 0x100000001b3ULL;
+    return h;
+}
+
+uint64_t Node::subtreeHash() const
+{
+    uint64_t h = hash_continue(0xcbf29ce484222325ULL, name);
+    std::map<std::string, std::string>::const_iterator it;
+    for(it = attributes.begin(); it != attributes.end(); ++it)
+    {
+        h = hash_continue(h, it->first);
+        h = hash_continue(h, it->second);
+    }
+    h = hash_continue(h, text);
+    std::vector<Node *>::const_iterator l;
+    for(l = subNodes.begin(); l != subNodes.end(); ++l)
+        h = ((*l)->subtreeHash() ^ h) * 0x100000001b3ULL;
+    return h;
+}
+
 std::vector<std::string> Node::toString(int indent) const
 {
     std::vector<std::string> ret;
@@ -25,6 +25,7 @@
 #ifndef NODE_H_
 #define NODE_H_
 
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <map>
@@ -53,6 +54,7 @@ namespace adaptive
                 int                                 getType() const;
                 void                                setType( int type );
                 std::vector<std::string>            toString(int) const;
+                uint64_t                            subtreeHash() const;
 
             private:
                 static const std::string            EmptyString;
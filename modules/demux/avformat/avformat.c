@@ -45,6 +45,10 @@ vlc_module_begin ()
     set_section( N_("Demuxer"), NULL )
     add_string( "avformat-format", NULL, FORMAT_TEXT, FORMAT_LONGTEXT )
     add_string( "avformat-options", NULL, AV_OPTIONS_TEXT, AV_OPTIONS_LONGTEXT )
+    add_integer( "avformat-probe-size", -1, PROBE_SIZE_TEXT,
+                 PROBE_SIZE_LONGTEXT )
+    add_integer( "avformat-probe-duration", -1, PROBE_DURATION_TEXT,
+                 PROBE_DURATION_LONGTEXT )
 
 #ifdef ENABLE_SOUT
     /* mux submodule */
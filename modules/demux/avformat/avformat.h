@@ -35,3 +35,12 @@ void avformat_CloseMux( vlc_object_t * );
 #define MUX_LONGTEXT N_("Force use of a specific avformat muxer.")
 #define FORMAT_TEXT N_( "Format name" )
 #define FORMAT_LONGTEXT N_( "Internal libavcodec format name" )
+#define PROBE_SIZE_TEXT N_( "Probing size" )
+#define PROBE_SIZE_LONGTEXT N_( "Maximum number of bytes read to determine " \
+    "the stream properties, or -1 for the libavformat default. Lower values " \
+    "speed up opening files with many tracks at the risk of missing some " \
+    "stream parameters." )
+#define PROBE_DURATION_TEXT N_( "Probing duration" )
+#define PROBE_DURATION_LONGTEXT N_( "Maximum duration analyzed to determine " \
+    "the stream properties, in milliseconds, or -1 for the libavformat " \
+    "default." )
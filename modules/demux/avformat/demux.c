@@ -36,6 +36,12 @@
 #include <vlc_input.h>
 #include <vlc_charset.h>
 #include <vlc_avcodec.h>
+#include <vlc_configuration.h>
+#include <vlc_fs.h>
+#include <vlc_hash.h>
+#include <vlc_strings.h>
+
+#include <sys/stat.h>
 
 #include "../../codec/avcodec/avcodec.h"
 #include "../../codec/avcodec/chroma.h"
@@ -230,6 +236,18 @@ static void FindStreamInfo( demux_t *p_demux, AVDictionary *options )
     demux_sys_t *p_sys = p_demux->p_sys;
     unsigned nb_streams = p_sys->ic->nb_streams;
 
+    /* Bound the stream analysis so that opening does not scale with the
+     * number of tracks. libavformat stops early once every stream has its
+     * parameters, so these are worst-case limits for broken files. */
+    int64_t i_probe_size = var_InheritInteger( p_demux, "avformat-probe-size" );
+    if( i_probe_size >= 0 )
+        p_sys->ic->probesize = i_probe_size;
+
+    int64_t i_probe_duration =
+        var_InheritInteger( p_demux, "avformat-probe-duration" );
+    if( i_probe_duration >= 0 )
+        p_sys->ic->max_analyze_duration = i_probe_duration * (AV_TIME_BASE / 1000);
+
     AVDictionary *streamsoptions[nb_streams ? nb_streams : 1];
 
     streamsoptions[0] = options;
@@ -256,6 +274,114 @@ static void FindStreamInfo( demux_t *p_demux, AVDictionary *options )
     }
 }
 
+/*****************************************************************************
+ * Probe cache
+ *****************************************************************************/
+
+/* Format detection results are remembered across runs, keyed by the file
+ * path and a hash of its head bytes, so that reopening the same file skips
+ * the probe. Only the detected format name can be restored: libavformat
+ * offers no way to inject a previous stream analysis back into a context.
+ * The file size and time are deliberately not part of the key, as the
+ * format of a growing file does not change while it is appended to. */
+
+static char *ProbeCachePath( void )
+{
+    char *psz_dir = config_GetUserDir( VLC_CACHE_DIR );
+    if( psz_dir == NULL )
+        return NULL;
+
+    char *psz_path;
+    if( asprintf( &psz_path, "%s" DIR_SEP "avformat-probe.cache",
+                  psz_dir ) == -1 )
+        psz_path = NULL;
+    free( psz_dir );
+    return psz_path;
+}
+
+static char *ProbeCacheKey( demux_t *p_demux,
+                            const uint8_t *p_head, size_t i_head )
+{
+    if( p_demux->psz_filepath == NULL )
+        return NULL; /* only plain files have a stable identity */
+
+    struct stat st;
+    if( vlc_stat( p_demux->psz_filepath, &st ) != 0 || !S_ISREG( st.st_mode ) )
+        return NULL;
+
+    vlc_hash_md5_t hash;
+    char psz_pathhash[VLC_HASH_MD5_DIGEST_HEX_SIZE];
+    char psz_headhash[VLC_HASH_MD5_DIGEST_HEX_SIZE];
+
+    vlc_hash_md5_Init( &hash );
+    vlc_hash_md5_Update( &hash, p_demux->psz_filepath,
+                         strlen( p_demux->psz_filepath ) );
+    vlc_hash_FinishHex( &hash, psz_pathhash );
+
+    vlc_hash_md5_Init( &hash );
+    vlc_hash_md5_Update( &hash, p_head, i_head );
+    vlc_hash_FinishHex( &hash, psz_headhash );
+
+    char *psz_key;
+    if( asprintf( &psz_key, "%s %s", psz_pathhash, psz_headhash ) == -1 )
+        psz_key = NULL;
+    return psz_key;
+}
+
+static char *ProbeCacheGet( vlc_object_t *p_this, const char *psz_key )
+{
+    char *psz_path = ProbeCachePath();
+    if( psz_path == NULL )
+        return NULL;
+
+    FILE *f = vlc_fopen( psz_path, "rt" );
+    free( psz_path );
+    if( f == NULL )
+        return NULL;
+
+    const size_t i_keylen = strlen( psz_key );
+    char psz_line[256];
+    char *psz_name = NULL;
+
+    while( fgets( psz_line, sizeof (psz_line), f ) != NULL )
+    {
+        if( strncmp( psz_line, psz_key, i_keylen ) != 0
+         || psz_line[i_keylen] != ' ' )
+            continue;
+        psz_line[strcspn( psz_line, "\n" )] = '\0';
+        psz_name = strdup( psz_line + i_keylen + 1 );
+        break;
+    }
+    fclose( f );
+
+    if( psz_name != NULL )
+        msg_Dbg( p_this, "probe cache: %s", psz_name );
+    return psz_name;
+}
+
+static void ProbeCacheStore( vlc_object_t *p_this,
+                             const char *psz_key, const char *psz_name )
+{
+    char *psz_path = ProbeCachePath();
+    if( psz_path == NULL )
+        return;
+
+    /* Start over rather than let the cache grow without bound */
+    struct stat st;
+    const char *psz_mode = "at";
+    if( vlc_stat( psz_path, &st ) == 0 && st.st_size > (256 << 10) )
+        psz_mode = "wt";
+
+    FILE *f = vlc_fopen( psz_path, psz_mode );
+    free( psz_path );
+    if( f == NULL )
+        return;
+
+    fprintf( f, "%s %s\n", psz_key, psz_name );
+    if( fclose( f ) == 0 )
+        msg_Dbg( p_this, "probe cache: stored %s", psz_name );
+}
+
 static int avformat_ProbeDemux( vlc_object_t *p_this,
                                 AVF_MAYBE_CONST AVInputFormat **pp_fmt,
                                 const char *psz_url )
@@ -292,9 +418,29 @@ static int avformat_ProbeDemux( vlc_object_t *p_this,
         free( psz_format );
     }
 
+    char *psz_key = NULL;
+    if( *pp_fmt == NULL )
+    {
+        psz_key = ProbeCacheKey( p_demux, pd.buf, pd.buf_size );
+        if( psz_key != NULL )
+        {
+            char *psz_cached = ProbeCacheGet( p_this, psz_key );
+            if( psz_cached != NULL )
+            {
+                *pp_fmt = av_find_input_format( psz_cached );
+                free( psz_cached );
+            }
+        }
+    }
+
     if( *pp_fmt == NULL )
+    {
         *pp_fmt = av_probe_input_format( &pd, 1 );
+        if( *pp_fmt != NULL && psz_key != NULL )
+            ProbeCacheStore( p_this, psz_key, (*pp_fmt)->name );
+    }
 
+    free( psz_key );
     free( pd.buf );
 
     if( *pp_fmt == NULL )
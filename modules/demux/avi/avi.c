@@ -209,7 +209,8 @@ static vlc_tick_t AVI_GetDPTS   ( avi_track_t *, int64_t i_count );
 static vlc_tick_t AVI_GetPTS    ( avi_track_t * );
 
 
-static int AVI_StreamChunkFind( demux_t *, avi_track_t * );
+static int AVI_StreamChunkFind( demux_t *, avi_track_t *,
+                                unsigned int, uint64_t );
 static int AVI_StreamChunkSet ( demux_t *, avi_track_t *, unsigned int i_ck );
 static int AVI_StreamBytesSet ( demux_t *, avi_track_t *, uint64_t i_byte );
 
@@ -1567,9 +1568,20 @@ static int Seek( demux_t *p_demux, vlc_tick_t i_date, double f_ratio, bool b_acc
             while( i_pos >= p_stream->idx.p_entry[p_stream->i_idxposc].i_pos +
                p_stream->idx.p_entry[p_stream->i_idxposc].i_length + 8 )
             {
-                /* search after i_idxposc */
-                if( AVI_StreamChunkSet( p_demux,
-                                        p_stream, p_stream->i_idxposc + 1 ) )
+                /* search after i_idxposc, extending the index up to the
+                 * estimated position in a single scan instead of chunk by
+                 * chunk */
+                unsigned int i_ck = p_stream->i_idxposc + 1;
+                if( i_ck >= p_stream->idx.i_size )
+                {
+                    if( AVI_StreamChunkFind( p_demux, p_stream, i_ck, i_pos ) )
+                    {
+                        msg_Warn( p_demux, "cannot seek" );
+                        goto failandresetpos;
+                    }
+                    i_ck = p_stream->idx.i_size - 1;
+                }
+                if( AVI_StreamChunkSet( p_demux, p_stream, i_ck ) )
                 {
                     msg_Warn( p_demux, "cannot seek" );
                     goto failandresetpos;
@@ -1855,13 +1867,19 @@ static vlc_tick_t AVI_GetPTS( avi_track_t *tk )
         return AVI_GetDPTS( tk, tk->i_idxposc );
 }
 
-static int AVI_StreamChunkFind( demux_t *p_demux, avi_track_t *tk )
+/* Scan the movi content forward from the last chunk discovered so far,
+ * appending every encountered chunk to the per-track indexes, until tk
+ * covers chunk i_ck at or beyond file position i_pos_min (pass 0 when only
+ * the chunk number matters). Everything found on the way is kept, so later
+ * seeks within the scanned range never touch the stream again. */
+static int AVI_StreamChunkFind( demux_t *p_demux, avi_track_t *tk,
+                                unsigned int i_ck, uint64_t i_pos_min )
 {
     demux_sys_t *p_sys = p_demux->p_sys;
     avi_packet_t avi_pk;
     unsigned short i_loop_count = 0;
 
-    /* find first chunk of i_stream that isn't in index */
+    /* find chunks of i_stream that aren't in the index yet */
 
     if( p_sys->i_movi_lastchunk_pos >= p_sys->i_movi_begin + 12 )
     {
@@ -1909,7 +1927,8 @@ static int AVI_StreamChunkFind( demux_t *p_demux, avi_track_t *tk )
             index.i_lengthtotal = index.i_length;
             avi_index_Append( &tk_pk->idx, &p_sys->i_movi_lastchunk_pos, &index );
 
-            if( tk_pk == tk )
+            if( tk_pk == tk && tk->idx.i_size > i_ck &&
+                index.i_pos + index.i_length + 8 > i_pos_min )
             {
                 return VLC_SUCCESS;
             }
@@ -1931,16 +1950,12 @@ static int AVI_StreamChunkSet( demux_t *p_demux, avi_track_t *p_stream,
 
     if(  i_ck >= p_stream->idx.i_size )
     {
-        p_stream->i_idxposc = p_stream->idx.i_size - 1;
-        do
+        /* extend the index up to i_ck in a single forward scan */
+        if( AVI_StreamChunkFind( p_demux, p_stream, i_ck, 0 ) )
         {
-            p_stream->i_idxposc++;
-            if( AVI_StreamChunkFind( p_demux, p_stream ) )
-            {
-                return VLC_EGENERIC;
-            }
-
-        } while( p_stream->i_idxposc < i_ck );
+            p_stream->i_idxposc = p_stream->idx.i_size;
+            return VLC_EGENERIC;
+        }
     }
 
     return VLC_SUCCESS;
@@ -1993,7 +2008,8 @@ static int AVI_StreamBytesSet( demux_t    *p_demux,
         do
         {
             p_stream->i_idxposc++;
-            if( AVI_StreamChunkFind( p_demux, p_stream ) )
+            if( AVI_StreamChunkFind( p_demux, p_stream,
+                                     p_stream->i_idxposc, 0 ) )
             {
                 return VLC_EGENERIC;
             }
@@ -56,6 +56,7 @@ DASHManager::DASHManager(demux_t *demux_,
                          AbstractAdaptationLogic::LogicType type) :
              PlaylistManager(demux_, res, mpd, factory, type)
 {
+    mpdSourceHash = 0;
 }
 
 DASHManager::~DASHManager   ()
@@ -93,9 +94,12 @@ bool DASHManager::updatePlaylist()
     {
         std::string url(p_demux->psz_url);
 
-        block_t *p_block = Retrieve::HTTP(resources, ChunkType::Playlist, url);
+        RequestStatus status = RequestStatus::Success;
+        block_t *p_block = Retrieve::HTTP(resources, ChunkType::Playlist, url,
+                                          &mpdValidators, &status);
         if(!p_block)
-            return false;
+            /* conditional reload told us the document did not change */
+            return status == RequestStatus::NotModified;
 
         stream_t *mpdstream = vlc_stream_MemoryNew(p_demux, p_block->p_buffer, p_block->i_buffer, true);
         if(!mpdstream)
@@ -112,6 +116,16 @@ bool DASHManager::updatePlaylist()
             return false;
         }
 
+        const uint64_t sourcehash = parser.getRootNode()->subtreeHash();
+        if(sourcehash == mpdSourceHash)
+        {
+            /* same document as last time, skip the full object rebuild */
+            vlc_stream_Delete(mpdstream);
+            block_Release(p_block);
+            return true;
+        }
+        mpdSourceHash = sourcehash;
+
         IsoffMainParser mpdparser(parser.getRootNode(), VLC_OBJECT(p_demux),
                                   mpdstream, Helper::getDirectoryPath(url).append("/"));
         MPD *newmpd = mpdparser.parse();
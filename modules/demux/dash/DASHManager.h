@@ -27,6 +27,7 @@
 
 #include "../adaptive/PlaylistManager.h"
 #include "../adaptive/logic/AbstractAdaptationLogic.h"
+#include "../adaptive/http/ConnectionParams.hpp"
 #include "mpd/MPD.h"
 
 namespace adaptive
@@ -59,6 +60,10 @@ namespace dash
 
         protected:
             virtual int doControl(int, va_list) override;
+
+        private:
+            http::CacheValidators mpdValidators;
+            uint64_t mpdSourceHash;
     };
 
 }
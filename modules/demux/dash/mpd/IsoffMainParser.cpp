@@ -166,6 +166,7 @@ void IsoffMainParser::parsePeriods(MPD *mpd, Node *root)
         BasePeriod *period = new (std::nothrow) BasePeriod(mpd);
         if (!period)
             continue;
+        period->setSourceNodeHash((*it)->subtreeHash());
         parseSegmentInformation(mpd, *it, period, &nextid);
         if((*it)->hasAttribute("start"))
             period->startTime.Set(IsoTime((*it)->getAttributeValue("start")));
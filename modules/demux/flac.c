@@ -70,6 +70,13 @@ typedef struct
     uint64_t i_byte_offset;
 } flac_seekpoint_t;
 
+typedef struct
+{
+    vlc_tick_t i_time;       /* timestamp of a synced frame */
+    uint64_t i_min_offset;   /* the frame starts at or after this offset */
+    uint64_t i_max_offset;   /* and was entirely read before this offset */
+} flac_cached_seekpoint_t;
+
 typedef struct
 {
     bool  b_start;
@@ -93,6 +100,10 @@ typedef struct
     int         i_seekpoint;
     flac_seekpoint_t **seekpoint;
 
+    /* positions learned from previous bisections */
+    int         i_seekcache;
+    flac_cached_seekpoint_t **seekcache;
+
     /* title/chapters seekpoints */
     int           i_title_seekpoints;
     seekpoint_t **pp_title_seekpoints;
@@ -149,6 +160,7 @@ static int Open( vlc_object_t * p_this )
     p_sys->p_es = NULL;
     p_sys->p_current_block = NULL;
     TAB_INIT( p_sys->i_seekpoint, p_sys->seekpoint );
+    TAB_INIT( p_sys->i_seekcache, p_sys->seekcache );
     TAB_INIT( p_sys->i_attachments, p_sys->attachments);
     TAB_INIT( p_sys->i_title_seekpoints, p_sys->pp_title_seekpoints );
     p_sys->i_cover_idx = 0;
@@ -201,6 +213,10 @@ static void Close( vlc_object_t * p_this )
         free(p_sys->seekpoint[i]);
     TAB_CLEAN( p_sys->i_seekpoint, p_sys->seekpoint );
 
+    for( int i = 0; i < p_sys->i_seekcache; i++ )
+        free(p_sys->seekcache[i]);
+    TAB_CLEAN( p_sys->i_seekcache, p_sys->seekcache );
+
     for( int i = 0; i < p_sys->i_attachments; i++ )
         vlc_input_attachment_Release( p_sys->attachments[i] );
     TAB_CLEAN( p_sys->i_attachments, p_sys->attachments);
@@ -262,6 +278,60 @@ static void Reset( demux_sys_t *p_sys )
     }
 }
 
+#define FLAC_SEEKCACHE_SIZE 256
+#define FLAC_SEEKCACHE_MERGE_TIME VLC_TICK_FROM_SEC(1)
+
+/* Remember where a bisection located a frame, so that following seeks can
+ * narrow or entirely skip the search. The frame timestamped i_time starts
+ * at or after i_min_offset and was entirely read before i_max_offset. */
+static void CacheSeekpoint( demux_t *p_demux, vlc_tick_t i_time,
+                            uint64_t i_min_offset, uint64_t i_max_offset )
+{
+    demux_sys_t *p_sys = p_demux->p_sys;
+    int i;
+
+    /* keep the cache sorted by time */
+    for( i = p_sys->i_seekcache - 1; i >= 0; i-- )
+    {
+        if( p_sys->seekcache[i]->i_time <= i_time )
+            break;
+    }
+
+    flac_cached_seekpoint_t *p_nearest = NULL;
+    if( i >= 0 &&
+        ( i + 1 >= p_sys->i_seekcache ||
+          i_time - p_sys->seekcache[i]->i_time <=
+          p_sys->seekcache[i+1]->i_time - i_time ) )
+        p_nearest = p_sys->seekcache[i];
+    else if( i + 1 < p_sys->i_seekcache )
+        p_nearest = p_sys->seekcache[i+1];
+
+    if( p_nearest )
+    {
+        /* overwrite the nearest entry when it is too close to be worth
+         * keeping both, or when the cache is full */
+        vlc_tick_t i_delta = p_nearest->i_time > i_time
+                           ? p_nearest->i_time - i_time
+                           : i_time - p_nearest->i_time;
+        if( i_delta < FLAC_SEEKCACHE_MERGE_TIME ||
+            p_sys->i_seekcache >= FLAC_SEEKCACHE_SIZE )
+        {
+            p_nearest->i_time = i_time;
+            p_nearest->i_min_offset = i_min_offset;
+            p_nearest->i_max_offset = i_max_offset;
+            return;
+        }
+    }
+
+    flac_cached_seekpoint_t *p_entry = malloc( sizeof(*p_entry) );
+    if( unlikely(p_entry == NULL) )
+        return;
+    p_entry->i_time = i_time;
+    p_entry->i_min_offset = i_min_offset;
+    p_entry->i_max_offset = i_max_offset;
+    TAB_INSERT( p_sys->i_seekcache, p_sys->seekcache, p_entry, i + 1 );
+}
+
 static int RefineSeek( demux_t *p_demux, vlc_tick_t i_time, double i_bytemicrorate,
                        uint64_t i_lowpos, uint64_t i_highpos )
 {
@@ -334,6 +404,10 @@ static int RefineSeek( demux_t *p_demux, vlc_tick_t i_time, double i_bytemicrora
             else b_found = true;
         }
 
+        if( b_found )
+            CacheSeekpoint( p_demux, p_block_out->i_dts,
+                            i_start_pos, vlc_stream_Tell( p_demux->s ) );
+
         if( p_block_out )
             block_Release( p_block_out );
         if( p_block_in )
@@ -489,6 +563,27 @@ static int ControlSetTime( demux_t *p_demux, vlc_tick_t i_time )
         i_start_pos = i_time / i_bytemicrorate;
     }
 
+    /* Narrow the search window with positions learned from previous
+     * bisections, so repeated seeks in the same area need few reads */
+    for( i = p_sys->i_seekcache - 1; i >= 0; i-- )
+    {
+        if( p_sys->seekcache[i]->i_time <= i_time )
+            break;
+    }
+    if( i >= 0 && p_sys->seekcache[i]->i_min_offset > i_lower )
+    {
+        i_lower = p_sys->seekcache[i]->i_min_offset;
+        i_start_pos = i_lower;
+    }
+    if( i + 1 < p_sys->i_seekcache &&
+        p_sys->seekcache[i+1]->i_max_offset < i_upper )
+        i_upper = p_sys->seekcache[i+1]->i_max_offset;
+
+    if( i_start_pos < i_lower )
+        i_start_pos = i_lower;
+    else if( i_start_pos > i_upper )
+        i_start_pos = i_upper;
+
     if( VLC_SUCCESS != vlc_stream_Seek( p_demux->s, i_start_pos ) )
         return VLC_EGENERIC;
 
@@ -30,6 +30,8 @@
 #include "../../adaptive/playlist/BaseAdaptationSet.h"
 #include "../../adaptive/playlist/SegmentList.h"
 
+#include <vlc_rand.h>
+
 #include <ctime>
 #include <limits>
 
@@ -46,6 +48,11 @@ HLSRepresentation::HLSRepresentation  ( BaseAdaptationSet *set ) :
     targetDuration = 0;
     streamFormat = StreamFormat::Type::Unknown;
     channels = 0;
+    canSkipUntil = 0;
+    /* desync reload times between concurrent sessions to a same origin */
+    reloadJitterPct = vlc_lrand48() % 31 - 15;
+    canBlockReload = false;
+    partTarget = 0;
 }
 
 HLSRepresentation::~HLSRepresentation ()
@@ -133,12 +140,20 @@ bool HLSRepresentation::needsUpdate(uint64_t number) const
     {
         const vlc_tick_t now = vlc_tick_now();
         const vlc_tick_t elapsed = now - lastUpdateTime;
-        vlc_tick_t duration = targetDuration
-                            ? vlc_tick_from_sec(targetDuration)
-                            : VLC_TICK_FROM_SEC(2);
+        const vlc_tick_t duration = targetDuration
+                                  ? vlc_tick_from_sec(targetDuration)
+                                  : VLC_TICK_FROM_SEC(2);
+        vlc_tick_t interval = duration;
         if(updateFailureCount)
-            duration /= 2;
-        if(elapsed < duration)
+            interval /= 2;
+        else if(canBlockReload)
+            /* the server withholds its reply until new data is published,
+               so it does the pacing for us; keep a small floor to avoid
+               hammering broken origins that answer straight away */
+            interval = partTarget ? partTarget : duration / 4;
+        else
+            interval += interval * reloadJitterPct / 100;
+        if(elapsed < interval)
             return false;
 
         if(number == std::numeric_limits<uint64_t>::max())
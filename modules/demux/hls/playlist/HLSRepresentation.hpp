@@ -70,6 +70,14 @@ namespace hls
                 unsigned updateFailureCount;
                 vlc_tick_t lastUpdateTime;
                 unsigned channels;
+                /* conditional reloads & EXT-X-SKIP delta updates */
+                std::string playlistETag;
+                std::string playlistLastModified;
+                time_t canSkipUntil;
+                int reloadJitterPct;
+                /* low-latency blocking reloads */
+                bool canBlockReload;
+                vlc_tick_t partTarget;
         };
     }
 }
@@ -224,7 +224,36 @@ void M3U8Parser::fillAdaptsetFromMediainfo(const AttributesTag *mediatag,
 
 bool M3U8Parser::appendSegmentsFromPlaylistURI(vlc_object_t *p_obj, HLSRepresentation *rep)
 {
-    block_t *p_block = Retrieve::HTTP(resources, ChunkType::Playlist, rep->getPlaylistUrl().toString());
+    std::string uri = rep->getPlaylistUrl().toString();
+    /* Delivery directives, in alphabetical order per RFC8216bis */
+    std::string query;
+    if(rep->initialized())
+    {
+        if(rep->canBlockReload)
+        {
+            /* Block the reload until the next media sequence is published */
+            const SegmentList *segmentList = rep->inheritSegmentList();
+            if(segmentList && !segmentList->getSegments().empty())
+                query += "_HLS_msn=" + std::to_string(
+                         segmentList->getSegments().back()->getSequenceNumber() + 1);
+        }
+        /* Ask the server to elide segments we already know about */
+        if(rep->canSkipUntil)
+        {
+            if(!query.empty())
+                query += "&";
+            query += "_HLS_skip=YES";
+        }
+    }
+    if(!query.empty())
+        uri += ((uri.find('?') != std::string::npos) ? "&" : "?") + query;
+
+    CacheValidators validators;
+    validators.etag = rep->playlistETag;
+    validators.lastModified = rep->playlistLastModified;
+    RequestStatus status = RequestStatus::Success;
+    block_t *p_block = Retrieve::HTTP(resources, ChunkType::Playlist, uri,
+                                      &validators, &status);
     if(p_block)
     {
         stream_t *substream = vlc_stream_MemoryNew(p_obj, p_block->p_buffer, p_block->i_buffer, true);
@@ -238,6 +267,13 @@ bool M3U8Parser::appendSegmentsFromPlaylistURI(vlc_object_t *p_obj, HLSRepresent
             releaseTagsList(tagslist);
         }
         block_Release(p_block);
+        rep->playlistETag = validators.etag;
+        rep->playlistLastModified = validators.lastModified;
+        return true;
+    }
+    else if(status == RequestStatus::NotModified)
+    {
+        /* same playlist, just come back at next refresh time */
         return true;
     }
     return false;
@@ -440,6 +476,36 @@ void M3U8Parser::parseSegments(vlc_object_t *, HLSRepresentation *rep, const std
                 discontinuitySequence = static_cast<const SingleValueTag *>(tag)->getValue().decimal();
                 break;
 
+            case AttributesTag::EXTXSERVERCONTROL:
+            {
+                const AttributesTag *ctrltag = static_cast<const AttributesTag *>(tag);
+                const Attribute *skipuntilAttr = ctrltag->getAttributeByName("CAN-SKIP-UNTIL");
+                rep->canSkipUntil = skipuntilAttr ? skipuntilAttr->floatingPoint() : 0;
+                const Attribute *blockAttr = ctrltag->getAttributeByName("CAN-BLOCK-RELOAD");
+                rep->canBlockReload = blockAttr && blockAttr->value == "YES";
+            }
+            break;
+
+            case AttributesTag::EXTXPARTINF:
+            {
+                const Attribute *parttargetAttr = static_cast<const AttributesTag *>(tag)
+                                                  ->getAttributeByName("PART-TARGET");
+                if(parttargetAttr)
+                    rep->partTarget = vlc_tick_from_sec(parttargetAttr->floatingPoint());
+            }
+            break;
+
+            case AttributesTag::EXTXSKIP:
+            {
+                /* delta update: account for the elided segments, the merge
+                 * will restamp against the ones we already have */
+                const Attribute *skippedAttr = static_cast<const AttributesTag *>(tag)
+                                               ->getAttributeByName("SKIPPED-SEGMENTS");
+                if(skippedAttr)
+                    sequenceNumber += skippedAttr->decimal();
+            }
+            break;
+
             case Tag::EXTXDISCONTINUITY:
                 discontinuity = true;
                 discontinuitySequence++;
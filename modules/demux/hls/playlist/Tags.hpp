@@ -99,6 +99,9 @@ namespace hls
                     EXTXSTART,
                     EXTXSTREAMINF,
                     EXTXSESSIONKEY,
+                    EXTXSERVERCONTROL,
+                    EXTXSKIP,
+                    EXTXPARTINF,
                 };
                 AttributesTag(int, const std::string &);
                 virtual ~AttributesTag();
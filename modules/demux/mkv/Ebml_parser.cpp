@@ -129,12 +129,17 @@ const EbmlSemanticContext Context_KaxSegmentVLC = EbmlSemanticContext(KaxSegment
                                                                       GetEbmlNoGlobal_Context,
                                                                       KaxSegment_Context.GetMaster());
 
+/* How far a lazy skip of an unknown element may jump when its parent size
+ * is unknown and the size field cannot be validated against it */
+#define MKV_LAZY_SKIP_MAX (4 << 20)
+
 EbmlElement *EbmlParser::Get( bool allow_overshoot )
 {
     int i_ulev = 0;
     int n_call = 0;
     EbmlElement *p_prev = NULL;
     bool do_read = true;
+    bool b_lazy_skip = true;
 
     if( mi_user_level != mi_level )
     {
@@ -202,11 +207,16 @@ next:
                 ? Context_KaxSegmentVLC
                 : EBML_CONTEXT(m_el[mi_level - 1]);
 
-        /* Ignore unknown level 0 or 1 elements */
+        /* Ignore unknown level 0 elements. Unknown level 1 elements are
+         * materialized as dummies so they can be skipped lazily from their
+         * size field, rather than have libebml scan byte per byte for the
+         * next known ID; the sanity checks below fall back to scanning
+         * when the size field cannot be trusted. */
         m_el[mi_level] = unlikely(!i_max_read) ? NULL :
                          m_es->FindNextElement( e_context,
                                                 i_ulev, i_max_read,
-                                                (  mb_dummy | (mi_level > 1) ), 1 );
+                                                (  mb_dummy | (mi_level > 1) |
+                                                  ((mi_level > 0) & b_lazy_skip) ), 1 );
 
         if( m_el[mi_level] == NULL )
         {
@@ -274,8 +284,9 @@ next:
         }
 
         if( n_call < M_EL_MAXSIZE && !b_bad_position && m_el[mi_level]->IsFiniteSize() &&
-            ( !m_el[mi_level-1]->IsFiniteSize() ||
-              m_el[mi_level]->GetEndPosition() <= m_el[mi_level-1]->GetEndPosition() ) )
+            ( m_el[mi_level-1]->IsFiniteSize() ?
+              m_el[mi_level]->GetEndPosition() <= m_el[mi_level-1]->GetEndPosition() :
+              m_el[mi_level]->GetSize() <= MKV_LAZY_SKIP_MAX ) )
         {
             /* The element fits inside its upper element */
             msg_Warn( p_demux, "Dummy element found %" PRIu64 "... skipping it",
@@ -321,6 +332,16 @@ next:
                 }
                 mb_keep = false;
             }
+
+            if( mi_level == 1 )
+            {
+                /* This dummy only exists for the lazy skip above and its
+                 * size field cannot be trusted: drop it and scan for the
+                 * next known ID as before */
+                delete m_el[mi_level];
+                m_el[mi_level] = NULL;
+                b_lazy_skip = false;
+            }
             goto next;
         }
     }
@@ -28,9 +28,14 @@
 #include "Ebml_parser.hpp"
 #include "Ebml_dispatcher.hpp"
 
+#include <vlc_configuration.h>
+#include <vlc_fs.h>
+
+#include <iomanip>
 #include <new>
 #include <iterator>
 #include <limits>
+#include <sstream>
 
 namespace mkv {
 
@@ -68,6 +73,8 @@ matroska_segment_c::matroska_segment_c( demux_sys_t & demuxer, EbmlStream & estr
 
 matroska_segment_c::~matroska_segment_c()
 {
+    SaveIndexCache();
+
     free( psz_writing_application );
     free( psz_muxing_application );
     free( psz_segment_filename );
@@ -85,6 +92,85 @@ matroska_segment_c::~matroska_segment_c()
 }
 
 
+/* Both sides of the seek index cache. Files without Cues otherwise need a
+ * cluster scan to rebuild the index on every open, which can take very long
+ * on large archives. The index is keyed by the (random) segment UID, so the
+ * cache survives renames and stays per-segment in multi-segment files. */
+
+std::string matroska_segment_c::IndexCachePath() const
+{
+    if( !p_segment_uid || p_segment_uid->GetSize() == 0 )
+        return std::string();
+
+    char *psz_dir = config_GetUserDir( VLC_CACHE_DIR );
+    if( psz_dir == NULL )
+        return std::string();
+
+    std::stringstream ss;
+    ss.imbue( std::locale("C") );
+    ss << psz_dir << DIR_SEP << "mkv-index" << DIR_SEP;
+    free( psz_dir );
+
+    const binary *p_uid = p_segment_uid->GetBuffer();
+    for( std::size_t i = 0; i < p_segment_uid->GetSize(); ++i )
+        ss << std::hex << std::setw( 2 ) << std::setfill( '0' )
+           << static_cast<unsigned>( p_uid[i] );
+    ss << ".idx";
+
+    return ss.str();
+}
+
+void matroska_segment_c::LoadIndexCache()
+{
+    if( b_cues || !sys.b_seekable ||
+        !var_InheritBool( &sys.demuxer, "mkv-index-cache" ) )
+        return;
+
+    std::string path = IndexCachePath();
+    if( path.empty() )
+        return;
+
+    FILE *file = vlc_fopen( path.c_str(), "rb" );
+    if( file == NULL )
+        return;
+
+    if( _seeker.load_index( file ) )
+        msg_Dbg( &sys.demuxer, "loaded seek index cache %s", path.c_str() );
+    else
+        msg_Warn( &sys.demuxer, "invalid seek index cache %s", path.c_str() );
+
+    fclose( file );
+}
+
+void matroska_segment_c::SaveIndexCache()
+{
+    if( b_cues || !b_preloaded || !sys.b_seekable || !_seeker.index_dirty() ||
+        !var_InheritBool( &sys.demuxer, "mkv-index-cache" ) )
+        return;
+
+    std::string path = IndexCachePath();
+    if( path.empty() )
+        return;
+
+    /* the directory half of the path */
+    std::string dir = path.substr( 0, path.find_last_of( DIR_SEP_CHAR ) );
+    vlc_mkdir( dir.c_str(), 0700 );
+
+    std::string tmp = path + ".tmp";
+    FILE *file = vlc_fopen( tmp.c_str(), "wb" );
+    if( file == NULL )
+        return;
+
+    bool ok = _seeker.save_index( file );
+    if( fclose( file ) != 0 )
+        ok = false;
+
+    if( !ok || vlc_rename( tmp.c_str(), path.c_str() ) != 0 )
+        vlc_unlink( tmp.c_str() );
+    else
+        msg_Dbg( &sys.demuxer, "saved seek index cache %s", path.c_str() );
+}
+
 /*****************************************************************************
  * Tools                                                                     *
  *****************************************************************************
@@ -687,6 +773,8 @@ bool matroska_segment_c::Preload( )
 
     b_preloaded = true;
 
+    LoadIndexCache();
+
     if( cluster )
         EnsureDuration();
 
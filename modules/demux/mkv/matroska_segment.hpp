@@ -144,6 +144,9 @@ public:
     bool PreloadClusters( uint64 i_cluster_position );
     void InformationCreate();
 
+    void LoadIndexCache();
+    void SaveIndexCache();
+
     bool Seek( demux_t &, vlc_tick_t i_mk_date, vlc_tick_t i_mk_time_offset, bool b_accurate );
 
     int BlockGet( KaxBlock * &, KaxSimpleBlock * &, KaxBlockAdditions * &,
@@ -159,6 +162,7 @@ public:
     bool SameFamily( const matroska_segment_c & of_segment ) const;
 
 private:
+    std::string IndexCachePath() const;
     void LoadCues( KaxCues *cues );
     void LoadTags( KaxTags *tags );
     bool LoadSeekHeadItem( const EbmlCallbacks & ClassInfos, int64_t i_element_position );
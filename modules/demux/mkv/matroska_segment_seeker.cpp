@@ -59,6 +59,8 @@ SegmentSeeker::add_cluster_position( fptr_t fpos )
       fpos
     );
 
+    _index_dirty = true;
+
     return _cluster_positions.insert( insertion_point, fpos );
 }
 
@@ -85,6 +87,7 @@ SegmentSeeker::add_cluster( KaxCluster * const p_cluster )
     else
     {
         it = _clusters.insert( cluster_map_t::value_type( cinfo.pts, cinfo ) ).first;
+        _index_dirty = true;
     }
 
     // ------------------------------------------------------------------
@@ -136,6 +139,8 @@ SegmentSeeker::add_seekpoint( track_id_t track_id, Seekpoint sp )
     {
         seekpoints.insert( it, sp );
     }
+
+    _index_dirty = true;
 }
 
 SegmentSeeker::tracks_seekpoint_t
@@ -403,6 +408,8 @@ SegmentSeeker::mark_range_as_searched( Range data )
 
     _ranges_searched.insert( std::upper_bound( _ranges_searched.begin(), _ranges_searched.end(), data ), data );
 
+    _index_dirty = true;
+
     {
         ranges_t merged;
 
@@ -530,4 +537,187 @@ SegmentSeeker::mkv_jump_to( matroska_segment_c& ms, fptr_t fpos )
         ms.es.I_O().setFilePointer( fpos );
 }
 
+/*****************************************************************************
+ * On-disk index cache (de)serialization
+ *
+ * Native-endian private cache, same machine reads it back. Sanity is
+ * enforced by magic/version and by capping element counts; anything odd
+ * makes load_index() fail and the index gets rebuilt by scanning.
+ *****************************************************************************/
+
+namespace {
+    const uint32_t INDEX_CACHE_MAGIC   = 0x584b4d49; /* "IMKX" */
+    const uint32_t INDEX_CACHE_VERSION = 1;
+    const uint32_t INDEX_CACHE_MAX_COUNT = 1 << 24;
+
+    template<class T>
+    bool write_value( FILE* file, T const& value )
+    {
+        return fwrite( &value, sizeof value, 1, file ) == 1;
+    }
+
+    template<class T>
+    bool read_value( FILE* file, T& value )
+    {
+        return fread( &value, sizeof value, 1, file ) == 1;
+    }
+
+    bool read_count( FILE* file, uint32_t& count )
+    {
+        return read_value( file, count ) && count <= INDEX_CACHE_MAX_COUNT;
+    }
+}
+
+bool
+SegmentSeeker::load_index( FILE* file )
+{
+    uint32_t magic, version, count;
+
+    if( !read_value( file, magic )   || magic   != INDEX_CACHE_MAGIC ||
+        !read_value( file, version ) || version != INDEX_CACHE_VERSION )
+        return false;
+
+    ranges_t ranges;
+    cluster_positions_t positions;
+    std::vector<Cluster> clusters;
+    tracks_seekpoints_t seekpoints;
+
+    if( !read_count( file, count ) )
+        return false;
+    for( uint32_t i = 0; i < count; ++i )
+    {
+        fptr_t start, end;
+        if( !read_value( file, start ) || !read_value( file, end ) )
+            return false;
+        ranges.push_back( Range( start, end ) );
+    }
+
+    if( !read_count( file, count ) )
+        return false;
+    for( uint32_t i = 0; i < count; ++i )
+    {
+        fptr_t fpos;
+        if( !read_value( file, fpos ) )
+            return false;
+        positions.push_back( fpos );
+    }
+
+    if( !read_count( file, count ) )
+        return false;
+    for( uint32_t i = 0; i < count; ++i )
+    {
+        Cluster cinfo;
+        if( !read_value( file, cinfo.fpos ) || !read_value( file, cinfo.pts ) ||
+            !read_value( file, cinfo.duration ) || !read_value( file, cinfo.size ) )
+            return false;
+        clusters.push_back( cinfo );
+    }
+
+    uint32_t track_count;
+    if( !read_count( file, track_count ) )
+        return false;
+    for( uint32_t i = 0; i < track_count; ++i )
+    {
+        uint32_t track_id;
+        if( !read_value( file, track_id ) || !read_count( file, count ) )
+            return false;
+
+        seekpoints_t& track_points = seekpoints[ track_id ];
+        for( uint32_t j = 0; j < count; ++j )
+        {
+            fptr_t fpos;
+            vlc_tick_t pts;
+            int32_t trust;
+            if( !read_value( file, fpos ) || !read_value( file, pts ) ||
+                !read_value( file, trust ) )
+                return false;
+            if( trust < Seekpoint::QUESTIONABLE || trust > Seekpoint::TRUSTED )
+                continue;
+            track_points.push_back( Seekpoint( fpos, pts,
+                static_cast<Seekpoint::TrustLevel>( trust ) ) );
+        }
+    }
+
+    /* all or nothing: merge only once the whole file parsed */
+
+    for( ranges_t::const_iterator it = ranges.begin(); it != ranges.end(); ++it )
+        mark_range_as_searched( *it );
+
+    for( cluster_positions_t::const_iterator it = positions.begin();
+         it != positions.end(); ++it )
+        add_cluster_position( *it );
+
+    for( std::vector<Cluster>::const_iterator it = clusters.begin();
+         it != clusters.end(); ++it )
+        _clusters.insert( cluster_map_t::value_type( it->pts, *it ) );
+
+    for( tracks_seekpoints_t::const_iterator it = seekpoints.begin();
+         it != seekpoints.end(); ++it )
+    {
+        for( seekpoints_t::const_iterator sp = it->second.begin();
+             sp != it->second.end(); ++sp )
+            add_seekpoint( it->first, *sp );
+    }
+
+    _index_dirty = false;
+    return true;
+}
+
+bool
+SegmentSeeker::save_index( FILE* file ) const
+{
+    if( !write_value( file, INDEX_CACHE_MAGIC ) ||
+        !write_value( file, INDEX_CACHE_VERSION ) )
+        return false;
+
+    if( !write_value( file, uint32_t( _ranges_searched.size() ) ) )
+        return false;
+    for( ranges_t::const_iterator it = _ranges_searched.begin();
+         it != _ranges_searched.end(); ++it )
+    {
+        if( !write_value( file, it->start ) || !write_value( file, it->end ) )
+            return false;
+    }
+
+    if( !write_value( file, uint32_t( _cluster_positions.size() ) ) )
+        return false;
+    for( cluster_positions_t::const_iterator it = _cluster_positions.begin();
+         it != _cluster_positions.end(); ++it )
+    {
+        if( !write_value( file, *it ) )
+            return false;
+    }
+
+    if( !write_value( file, uint32_t( _clusters.size() ) ) )
+        return false;
+    for( cluster_map_t::const_iterator it = _clusters.begin();
+         it != _clusters.end(); ++it )
+    {
+        Cluster const& cinfo = it->second;
+        if( !write_value( file, cinfo.fpos ) || !write_value( file, cinfo.pts ) ||
+            !write_value( file, cinfo.duration ) || !write_value( file, cinfo.size ) )
+            return false;
+    }
+
+    if( !write_value( file, uint32_t( _tracks_seekpoints.size() ) ) )
+        return false;
+    for( tracks_seekpoints_t::const_iterator it = _tracks_seekpoints.begin();
+         it != _tracks_seekpoints.end(); ++it )
+    {
+        if( !write_value( file, uint32_t( it->first ) ) ||
+            !write_value( file, uint32_t( it->second.size() ) ) )
+            return false;
+
+        for( seekpoints_t::const_iterator sp = it->second.begin();
+             sp != it->second.end(); ++sp )
+        {
+            if( !write_value( file, sp->fpos ) || !write_value( file, sp->pts ) ||
+                !write_value( file, int32_t( sp->trust_level ) ) )
+                return false;
+        }
+    }
+
+    return true;
+}
+
 } // namespace
@@ -119,11 +119,19 @@ class SegmentSeeker
         void mark_range_as_searched( Range );
         ranges_t get_search_areas( fptr_t start, fptr_t end ) const;
 
+        bool load_index( FILE * );
+        bool save_index( FILE * ) const;
+        bool index_dirty() const { return _index_dirty; }
+
     public:
         ranges_t            _ranges_searched;
         tracks_seekpoints_t _tracks_seekpoints;
         cluster_positions_t _cluster_positions;
         cluster_map_t       _clusters;
+
+    private:
+        /* index grew since construction/load, worth persisting */
+        bool                _index_dirty = false;
 };
 
 } // namespace
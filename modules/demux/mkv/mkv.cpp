@@ -81,6 +81,10 @@ vlc_module_begin ()
             N_("Preload clusters"),
             N_("Find all cluster positions by jumping cluster-to-cluster before playback") );
 
+    add_bool( "mkv-index-cache", true,
+            N_("Seek index cache"),
+            N_("Keep the cluster/keyframe seek index of files without Cues in the cache directory, so reopening them seeks without rescanning.") );
+
     add_shortcut( "mka", "mkv" )
     add_file_extension("mka")
     add_file_extension("mks")
@@ -526,7 +530,7 @@ static int Seek( demux_t *p_demux, vlc_tick_t i_mk_date, double f_percent, virtu
 }
 
 /* Needed by matroska_segment::Seek() and Seek */
-void BlockDecode( demux_t *p_demux, KaxBlock *block, KaxSimpleBlock *simpleblock,
+void BlockDecode( demux_t *p_demux, KaxBlock *&block, KaxSimpleBlock *simpleblock,
                   KaxBlockAdditions *additions,
                   vlc_tick_t i_pts, int64_t i_duration, bool b_key_picture,
                   bool b_discardable_picture )
@@ -595,6 +599,18 @@ void BlockDecode( demux_t *p_demux, KaxBlock *block, KaxSimpleBlock *simpleblock
             p_block = MemToBlock( data->Buffer(), data->Size(), track.p_compression_data->GetSize() + extra_data );
         else if( unlikely( track.fmt.i_codec == VLC_CODEC_WAVPACK ) )
             p_block = packetize_wavpack( track, data->Buffer(), data->Size() );
+        else if( block != NULL && i_number_frames == 1 && extra_data == 0 &&
+                 track.i_compression_type == MATROSKA_COMPRESSION_NONE )
+        {
+            /* We own the KaxBlock: hand its payload to the decoder without
+             * copying, the element is freed along with the frame.
+             * SimpleBlocks belong to the EBML parser and must be copied. */
+            p_block = ElementToBlock( block, data->Buffer(), data->Size() );
+            if( likely( p_block != NULL ) )
+                block = NULL;
+            else
+                p_block = MemToBlock( data->Buffer(), data->Size(), extra_data );
+        }
         else
             p_block = MemToBlock( data->Buffer(), data->Size(), extra_data );
 
@@ -119,7 +119,9 @@ enum
 
 using namespace LIBMATROSKA_NAMESPACE;
 
-void BlockDecode( demux_t *p_demux, KaxBlock *block, KaxSimpleBlock *simpleblock,
+/* May take ownership of the block (then reset to NULL) to pass its payload
+ * to the decoders without copying */
+void BlockDecode( demux_t *p_demux, KaxBlock *&block, KaxSimpleBlock *simpleblock,
                   KaxBlockAdditions *additions,
                   vlc_tick_t i_pts, vlc_tick_t i_duration, bool b_key_picture,
                   bool b_discardable_picture );
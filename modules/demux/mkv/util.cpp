@@ -164,6 +164,43 @@ block_t *MemToBlock( uint8_t *p_mem, size_t i_mem, size_t offset)
     return p_block;
 }
 
+namespace {
+
+struct ebml_frame_owner_t
+{
+    block_t      block;
+    EbmlElement *element;
+};
+
+void ElementBlockRelease( block_t *p_block )
+{
+    ebml_frame_owner_t *p_owner =
+        reinterpret_cast<ebml_frame_owner_t *>( p_block );
+    delete p_owner->element;
+    free( p_owner );
+}
+
+const struct vlc_block_callbacks element_block_cbs =
+{
+    ElementBlockRelease,
+};
+
+} // anonymous namespace
+
+/* Wraps a buffer owned by a libebml element into a block without copying.
+ * The element is deleted together with the block; on failure the caller
+ * keeps ownership of the element. */
+block_t *ElementToBlock( EbmlElement *element, uint8_t *p_mem, size_t i_mem )
+{
+    ebml_frame_owner_t *p_owner =
+        static_cast<ebml_frame_owner_t *>( malloc( sizeof( *p_owner ) ) );
+    if( unlikely( p_owner == NULL ) )
+        return NULL;
+
+    p_owner->element = element;
+    return block_Init( &p_owner->block, &element_block_cbs, p_mem, i_mem );
+}
+
 
 void handle_real_audio(demux_t * p_demux, mkv_track_t * p_tk, block_t * p_blk, vlc_tick_t i_pts)
 {
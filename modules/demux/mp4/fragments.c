@@ -55,6 +55,22 @@ mp4_fragments_index_t * MP4_Fragments_Index_New( unsigned i_tracks, unsigned i_n
     return p_index;
 }
 
+bool MP4_Fragments_Index_Grow( mp4_fragments_index_t *p_index, unsigned i_num )
+{
+    if( i_num <= p_index->i_entries || SIZE_MAX / i_num < p_index->i_tracks )
+        return false;
+    stime_t *p_times = realloc( p_index->p_times,
+                                (size_t)i_num * p_index->i_tracks * sizeof(*p_times) );
+    if( !p_times )
+        return false;
+    p_index->p_times = p_times;
+    uint64_t *pi_pos = realloc( p_index->pi_pos, i_num * sizeof(*pi_pos) );
+    if( !pi_pos )
+        return false;
+    p_index->pi_pos = pi_pos;
+    return true;
+}
+
 stime_t MP4_Fragment_Index_GetTrackStartTime( mp4_fragments_index_t *p_index,
                                               unsigned i_track_index, uint64_t i_moof_pos )
 {
@@ -34,6 +34,8 @@ typedef struct mp4_fragments_index_t
 
 void MP4_Fragments_Index_Delete( mp4_fragments_index_t *p_index );
 mp4_fragments_index_t * MP4_Fragments_Index_New( unsigned i_tracks, unsigned i_num );
+/* Grows storage up to i_num entries, i_entries is left untouched */
+bool MP4_Fragments_Index_Grow( mp4_fragments_index_t *p_index, unsigned i_num );
 
 stime_t MP4_Fragment_Index_GetTrackStartTime( mp4_fragments_index_t *p_index,
                                               unsigned i_track_index, uint64_t i_moof_pos );
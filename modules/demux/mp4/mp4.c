@@ -35,6 +35,7 @@
 #include <vlc_plugin.h>
 #include <vlc_dialog.h>
 #include <vlc_url.h>
+#include <vlc_executor.h>
 #include <assert.h>
 #include <limits.h>
 #include "meta.h"
@@ -58,6 +59,11 @@ static void Close( vlc_object_t * );
 
 #define MP4_ELST_TEXT       N_("Handle edit list")
 
+#define MP4_ASYNCINDEX_TEXT N_("Index fragments in the background")
+#define MP4_ASYNCINDEX_LONGTEXT N_( \
+    "Build the seek index of fragmented files on a worker thread, " \
+    "so playback starts without waiting for a full file scan.")
+
 #define HEIF_DURATION_TEXT N_("Duration in seconds")
 #define HEIF_DURATION_LONGTEXT N_( \
     "Duration in seconds before simulating an end of file. " \
@@ -78,6 +84,7 @@ vlc_module_begin ()
     set_section("Hacks", NULL)
     add_bool( CFG_PREFIX"m4a-audioonly", false, MP4_M4A_TEXT, MP4_M4A_LONGTEXT )
     add_bool( CFG_PREFIX"editlist", true, MP4_ELST_TEXT, MP4_ELST_TEXT )
+    add_bool( CFG_PREFIX"async-index", true, MP4_ASYNCINDEX_TEXT, MP4_ASYNCINDEX_LONGTEXT )
 
     add_submodule()
         set_subcategory( SUBCAT_INPUT_DEMUX )
@@ -150,6 +157,19 @@ typedef struct
 
     mp4_fragments_index_t *p_fragsindex;
 
+    struct
+    {
+        bool            b_deferred;  /* probing delegated to the worker */
+        bool            b_abort;
+        bool            b_done;
+        vlc_mutex_t     lock;
+        vlc_cond_t      wait;
+        stream_t        *s;          /* worker's private stream */
+        vlc_executor_t  *executor;
+        struct vlc_runnable runnable;
+        mp4_fragments_index_t *p_index; /* filled by worker, use under lock */
+    } asyncindex;
+
     ssize_t i_attachments;
     input_attachment_t **pp_attachments;
 } demux_sys_t;
@@ -194,6 +214,12 @@ static stime_t GetMoovTrackDuration( demux_sys_t *p_sys, unsigned i_track_ID );
 static int  ProbeFragments( demux_t *p_demux, bool b_force, bool *pb_fragmented );
 static int  ProbeFragmentsChecked( demux_t *p_demux );
 static int  ProbeIndex( demux_t *p_demux );
+static bool CanDeferFragsProbe( demux_t *p_demux );
+static int  ProbeFragmentsAsync( demux_t *p_demux );
+static int  ProbeFragmentsAsyncJoin( demux_t *p_demux );
+static void ProbeFragmentsAsyncAbort( demux_t *p_demux );
+static bool FragAsyncIndexLookup( demux_t *p_demux, stime_t *pi_time,
+                                  uint64_t *pi_pos, unsigned i_track_index );
 
 static int FragCreateTrunIndex( demux_t *, MP4_Box_t *, MP4_Box_t *, stime_t );
 
@@ -986,6 +1012,9 @@ static int Open( vlc_object_t * p_this )
     p_sys->context.i_lastseqnumber = UINT32_MAX;
     p_sys->i_attachments = -1;
 
+    vlc_mutex_init( &p_sys->asyncindex.lock );
+    vlc_cond_init( &p_sys->asyncindex.wait );
+
     p_demux->p_sys = p_sys;
 
     if( LoadInitFrag( p_demux ) != VLC_SUCCESS )
@@ -1308,7 +1337,13 @@ static int Open( vlc_object_t * p_this )
             {
                 /* Probe remaining to check if there's really fragments
                    or if that file is just ready to append fragments */
-                ProbeFragments( p_demux, (p_sys->i_duration == 0), &p_sys->b_fragmented );
+                p_sys->asyncindex.b_deferred = CanDeferFragsProbe( p_demux );
+                ProbeFragments( p_demux, (p_sys->i_duration == 0) &&
+                                !p_sys->asyncindex.b_deferred, &p_sys->b_fragmented );
+                if( p_sys->asyncindex.b_deferred &&
+                    ( !p_sys->b_fragmented || p_sys->b_fragments_probed ||
+                      ProbeFragmentsAsync( p_demux ) != VLC_SUCCESS ) )
+                    p_sys->asyncindex.b_deferred = false;
             }
 
             if( vlc_stream_Seek( p_demux->s, p_sys->p_moov->i_pos ) != VLC_SUCCESS )
@@ -2043,7 +2078,7 @@ static int FragSeekToTime( demux_t *p_demux, vlc_tick_t i_nztime, bool b_accurat
             /* Does only provide segment position and a sync sample time */
             msg_Dbg( p_demux, "seeking to sync point %" PRId64, i_sync_time );
         }
-        else if( !p_sys->b_fragments_probed )
+        else if( !p_sys->b_fragments_probed && !p_sys->asyncindex.b_deferred )
         {
             int i_ret = ProbeFragmentsChecked( p_demux );
             if( i_ret != VLC_SUCCESS )
@@ -2061,6 +2096,17 @@ static int FragSeekToTime( demux_t *p_demux, vlc_tick_t i_nztime, bool b_accurat
             msg_Dbg( p_demux, "seeking to fragment index pos %" PRId64 " %" PRId64, i64,
                      MP4_rescale_mtime( i_basetime, p_sys->i_timescale ) );
         }
+        else if( p_sys->asyncindex.b_deferred )
+        {
+            stime_t i_basetime = MP4_rescale_qtime( i_sync_time, p_sys->i_timescale );
+            if( !FragAsyncIndexLookup( p_demux, &i_basetime, &i64, i_seek_track_index ) )
+            {
+                p_sys->b_error = (vlc_stream_Seek( p_demux->s, i_backup_pos ) != VLC_SUCCESS);
+                return VLC_EGENERIC;
+            }
+            msg_Dbg( p_demux, "seeking to background index pos %" PRId64 " %" PRId64, i64,
+                     MP4_rescale_mtime( i_basetime, p_sys->i_timescale ) );
+        }
     }
 
     if( i64 == UINT64_MAX )
@@ -2348,6 +2394,8 @@ static void Close ( vlc_object_t * p_this )
 
     msg_Dbg( p_demux, "freeing all memory" );
 
+    ProbeFragmentsAsyncAbort( p_demux );
+
     FragResetContext( p_sys );
 
     MP4_BoxFree( p_sys->p_root );
@@ -4499,7 +4547,8 @@ static int ProbeFragments( demux_t *p_demux, bool b_force, bool *pb_fragmented )
     if( !p_vroot )
         return VLC_EGENERIC;
 
-    if( p_sys->b_seekable && (p_sys->b_fastseekable || b_force) )
+    if( p_sys->b_seekable &&
+        (b_force || (p_sys->b_fastseekable && !p_sys->asyncindex.b_deferred)) )
     {
         MP4_ReadBoxContainerChildren( p_demux->s, p_vroot, NULL ); /* Get the rest of the file */
         p_sys->b_fragments_probed = true;
@@ -4595,6 +4644,235 @@ static int ProbeFragments( demux_t *p_demux, bool b_force, bool *pb_fragmented )
     return VLC_SUCCESS;
 }
 
+static bool CanDeferFragsProbe( demux_t *p_demux )
+{
+    demux_sys_t *p_sys = p_demux->p_sys;
+    return p_sys->b_seekable && p_sys->b_fastseekable &&
+           p_sys->i_tracks > 0 && p_demux->psz_url != NULL &&
+           var_InheritBool( p_demux, CFG_PREFIX"async-index" );
+}
+
+static void ProbeFragmentsAsyncRun( void *p_userdata )
+{
+    demux_t *p_demux = p_userdata;
+    demux_sys_t *p_sys = p_demux->p_sys;
+    stream_t *s = p_sys->asyncindex.s;
+
+    mp4_fragments_index_t *p_index = NULL;
+    unsigned i_capacity = 0;
+    unsigned i_entry = 0;
+
+    stime_t *pi_track_times = calloc( p_sys->i_tracks, sizeof(*pi_track_times) );
+    if( pi_track_times )
+    for( ;; )
+    {
+        vlc_mutex_lock( &p_sys->asyncindex.lock );
+        const bool b_abort = p_sys->asyncindex.b_abort;
+        vlc_mutex_unlock( &p_sys->asyncindex.lock );
+        if( b_abort )
+            break;
+
+        MP4_Box_t *p_vroot = MP4_BoxNew( ATOM_root );
+        if( !p_vroot )
+            break;
+
+        /* Read forward including at most one moof, skipping mdat payloads */
+        const uint32_t stoplist[] = { ATOM_moof, 0 };
+        MP4_ReadBoxContainerChildren( s, p_vroot, stoplist );
+
+        MP4_Box_t *p_moof = p_vroot->p_first;
+        while( p_moof && p_moof->i_type != ATOM_moof )
+            p_moof = p_moof->p_next;
+        if( !p_moof )
+        {
+            MP4_BoxFree( p_vroot );
+            break;
+        }
+
+        if( i_entry == i_capacity ) /* Readers hold the lock, realloc under it */
+        {
+            unsigned i_newcapacity = i_capacity ? i_capacity * 2 : 64;
+            vlc_mutex_lock( &p_sys->asyncindex.lock );
+            if( !p_index )
+            {
+                p_index = MP4_Fragments_Index_New( p_sys->i_tracks, i_newcapacity );
+                if( p_index )
+                    p_index->i_entries = 0;
+                p_sys->asyncindex.p_index = p_index;
+            }
+            else if( !MP4_Fragments_Index_Grow( p_index, i_newcapacity ) )
+                i_newcapacity = i_capacity;
+            vlc_mutex_unlock( &p_sys->asyncindex.lock );
+            if( !p_index || i_newcapacity == i_capacity )
+            {
+                MP4_BoxFree( p_vroot );
+                break;
+            }
+            i_capacity = i_newcapacity;
+        }
+
+        stime_t i_last_time = 0;
+        for( unsigned i=0; i<p_sys->i_tracks; i++ )
+        {
+            MP4_Box_t *p_tfdt = NULL;
+            MP4_Box_t *p_traf = MP4_GetTrafByTrackID( p_moof, p_sys->track[i].i_track_ID );
+            if( p_traf )
+                p_tfdt = MP4_BoxGet( p_traf, "tfdt" );
+
+            if( p_tfdt && BOXDATA(p_tfdt) )
+            {
+                pi_track_times[i] = p_tfdt->data.p_tfdt->i_base_media_decode_time;
+            }
+            else if( i_entry == 0 ) /* Set first fragment time offset from moov */
+            {
+                stime_t i_duration = GetMoovTrackDuration( p_sys, p_sys->track[i].i_track_ID );
+                pi_track_times[i] = MP4_rescale( i_duration, p_sys->i_timescale, p_sys->track[i].i_timescale );
+            }
+
+            p_index->p_times[(size_t)i_entry * p_sys->i_tracks + i] =
+                    MP4_rescale( pi_track_times[i], p_sys->track[i].i_timescale, p_sys->i_timescale );
+
+            stime_t i_duration = 0;
+            if( GetMoofTrackDuration( p_sys->p_moov, p_moof, p_sys->track[i].i_track_ID, &i_duration ) )
+                pi_track_times[i] += i_duration;
+
+            stime_t i_movietime = MP4_rescale( pi_track_times[i], p_sys->track[i].i_timescale, p_sys->i_timescale );
+            if( i_last_time < i_movietime )
+                i_last_time = i_movietime;
+        }
+        p_index->pi_pos[i_entry] = p_moof->i_pos;
+
+        MP4_BoxFree( p_vroot );
+
+        /* Publish the entry, unblocking seeks waiting on that range */
+        vlc_mutex_lock( &p_sys->asyncindex.lock );
+        p_index->i_entries = ++i_entry;
+        if( p_index->i_last_time < i_last_time )
+            p_index->i_last_time = i_last_time;
+        vlc_cond_broadcast( &p_sys->asyncindex.wait );
+        vlc_mutex_unlock( &p_sys->asyncindex.lock );
+    }
+    free( pi_track_times );
+
+    msg_Dbg( p_demux, "background fragments probing done, %u entries", i_entry );
+
+    vlc_mutex_lock( &p_sys->asyncindex.lock );
+    p_sys->asyncindex.b_done = true;
+    vlc_cond_broadcast( &p_sys->asyncindex.wait );
+    vlc_mutex_unlock( &p_sys->asyncindex.lock );
+}
+
+static int ProbeFragmentsAsync( demux_t *p_demux )
+{
+    demux_sys_t *p_sys = p_demux->p_sys;
+
+    stream_t *s = vlc_stream_NewURL( p_demux, p_demux->psz_url );
+    if( !s )
+        return VLC_EGENERIC;
+
+    if( vlc_stream_Seek( s, p_sys->p_moov->i_pos + p_sys->p_moov->i_size ) != VLC_SUCCESS )
+    {
+        vlc_stream_Delete( s );
+        return VLC_EGENERIC;
+    }
+
+    p_sys->asyncindex.executor = vlc_executor_New( 1 );
+    if( !p_sys->asyncindex.executor )
+    {
+        vlc_stream_Delete( s );
+        return VLC_EGENERIC;
+    }
+
+    msg_Dbg( p_demux, "probing fragments in the background from %"PRIu64,
+             p_sys->p_moov->i_pos + p_sys->p_moov->i_size );
+
+    p_sys->asyncindex.s = s;
+    p_sys->asyncindex.runnable.run = ProbeFragmentsAsyncRun;
+    p_sys->asyncindex.runnable.userdata = p_demux;
+    vlc_executor_Submit( p_sys->asyncindex.executor, &p_sys->asyncindex.runnable );
+
+    return VLC_SUCCESS;
+}
+
+static int ProbeFragmentsAsyncJoin( demux_t *p_demux )
+{
+    demux_sys_t *p_sys = p_demux->p_sys;
+
+    vlc_mutex_lock( &p_sys->asyncindex.lock );
+    while( !p_sys->asyncindex.b_done )
+        vlc_cond_wait( &p_sys->asyncindex.wait, &p_sys->asyncindex.lock );
+    vlc_mutex_unlock( &p_sys->asyncindex.lock );
+
+    vlc_executor_Delete( p_sys->asyncindex.executor );
+    p_sys->asyncindex.executor = NULL;
+    vlc_stream_Delete( p_sys->asyncindex.s );
+    p_sys->asyncindex.s = NULL;
+
+    p_sys->p_fragsindex = p_sys->asyncindex.p_index;
+    p_sys->asyncindex.p_index = NULL;
+    p_sys->asyncindex.b_deferred = false;
+    p_sys->b_fragments_probed = true;
+
+#ifdef MP4_VERBOSE
+    if( p_sys->p_fragsindex )
+        MP4_Fragments_Index_Dump( VLC_OBJECT(p_demux), p_sys->p_fragsindex,
+                                  p_sys->i_timescale );
+#endif
+
+    if ( !MP4_BoxGet( p_sys->p_moov, "mvex/mehd") )
+           p_sys->i_cumulated_duration = GetCumulatedDuration( p_demux );
+
+    return VLC_SUCCESS;
+}
+
+static void ProbeFragmentsAsyncAbort( demux_t *p_demux )
+{
+    demux_sys_t *p_sys = p_demux->p_sys;
+
+    if( !p_sys->asyncindex.executor )
+        return;
+
+    vlc_mutex_lock( &p_sys->asyncindex.lock );
+    p_sys->asyncindex.b_abort = true;
+    vlc_mutex_unlock( &p_sys->asyncindex.lock );
+
+    vlc_executor_Delete( p_sys->asyncindex.executor );
+    p_sys->asyncindex.executor = NULL;
+    vlc_stream_Delete( p_sys->asyncindex.s );
+    p_sys->asyncindex.s = NULL;
+    MP4_Fragments_Index_Delete( p_sys->asyncindex.p_index );
+    p_sys->asyncindex.p_index = NULL;
+    p_sys->asyncindex.b_deferred = false;
+}
+
+static bool FragAsyncIndexLookup( demux_t *p_demux, stime_t *pi_time,
+                                  uint64_t *pi_pos, unsigned i_track_index )
+{
+    demux_sys_t *p_sys = p_demux->p_sys;
+
+    /* Only wait for the worker to cover the requested time */
+    vlc_mutex_lock( &p_sys->asyncindex.lock );
+    while( !p_sys->asyncindex.b_done &&
+           ( !p_sys->asyncindex.p_index ||
+             *pi_time >= p_sys->asyncindex.p_index->i_last_time ) )
+        vlc_cond_wait( &p_sys->asyncindex.wait, &p_sys->asyncindex.lock );
+
+    if( !p_sys->asyncindex.b_done )
+    {
+        bool b_found = MP4_Fragments_Index_Lookup( p_sys->asyncindex.p_index,
+                                                   pi_time, pi_pos, i_track_index );
+        vlc_mutex_unlock( &p_sys->asyncindex.lock );
+        return b_found;
+    }
+    vlc_mutex_unlock( &p_sys->asyncindex.lock );
+
+    /* Scan completed, adopt the index */
+    ProbeFragmentsAsyncJoin( p_demux );
+    return p_sys->p_fragsindex &&
+           MP4_Fragments_Index_Lookup( p_sys->p_fragsindex, pi_time, pi_pos,
+                                       i_track_index );
+}
+
 static int ProbeFragmentsChecked( demux_t *p_demux )
 {
     demux_sys_t *p_sys = p_demux->p_sys;
@@ -4602,6 +4880,9 @@ static int ProbeFragmentsChecked( demux_t *p_demux )
     if( p_sys->b_fragments_probed )
         return VLC_SUCCESS;
 
+    if( p_sys->asyncindex.b_deferred )
+        return ProbeFragmentsAsyncJoin( p_demux );
+
     if( !p_sys->b_fastseekable )
     {
         const char *psz_msg = _(
@@ -1481,6 +1481,36 @@ static void SendDataChain( demux_t *p_demux, ts_es_t *p_es, block_t *p_chain )
 {
     demux_sys_t *p_sys = p_demux->p_sys;
 
+    /* Fast path: when there is a single destination ES, the whole chain can
+     * be submitted at once, amortizing the es_out locking and clock
+     * bookkeeping over all the PES blocks. */
+    if( p_es->p_next == NULL && p_es->p_extraes == NULL )
+    {
+        if( !p_es->p_program->b_selected || !p_es->id )
+        {
+            block_ChainRelease( p_chain );
+            return;
+        }
+
+        for( block_t *p_block = p_chain; p_block; p_block = p_block->p_next )
+        {
+            /* clean up any private flag */
+            p_block->i_flags &= ~BLOCK_FLAG_PRIVATE_MASK;
+
+            if( p_sys->b_lowdelay )
+                p_block->i_flags |= BLOCK_FLAG_AU_END;
+
+            if( p_es->i_next_block_flags )
+            {
+                p_block->i_flags |= p_es->i_next_block_flags;
+                p_es->i_next_block_flags = 0;
+            }
+        }
+
+        es_out_SendBatch( p_demux->out, p_es->id, p_chain );
+        return;
+    }
+
     while( p_chain )
     {
         block_t *p_block = p_chain;
@@ -42,8 +42,10 @@ void ts_pid_list_Init( ts_pid_list_t *p_list )
     p_list->pp_all = NULL;
     p_list->i_all = 0;
     p_list->i_all_alloc = 0;
-    p_list->i_last_pid = 0;
-    p_list->p_last = NULL;
+    memset( p_list->lookup, 0, sizeof(p_list->lookup) );
+    p_list->lookup[0x0000] = &p_list->pat;
+    p_list->lookup[0x1FFB] = &p_list->base_si;
+    p_list->lookup[0x1FFF] = &p_list->dummy;
 }
 
 void ts_pid_list_Release( demux_t *p_demux, ts_pid_list_t *p_list )
@@ -80,38 +82,25 @@ static int ts_bsearch_searchkey_Compare( const void *key, const void *other )
 
 ts_pid_t * ts_pid_Get( ts_pid_list_t *p_list, uint16_t i_pid )
 {
-    switch( i_pid )
-    {
-        case 0:
-            return &p_list->pat;
-        case 0x1FFB:
-            return &p_list->base_si;
-        case 0x1FFF:
-            return &p_list->dummy;
-        default:
-            if( p_list->i_last_pid == i_pid )
-                return p_list->p_last;
-        break;
-    }
+    ts_pid_t *p_pid = p_list->lookup[i_pid & 0x1FFF];
+
+    if( likely(p_pid != NULL) )
+        return p_pid;
 
     size_t i_index = 0;
-    ts_pid_t *p_pid = NULL;
 
     if( p_list->pp_all )
-    {
+    {   /* The sorted array is only kept for iteration; locate the
+         * insertion point of the new PID */
         struct searchkey pidkey;
         pidkey.i_pid = i_pid;
         pidkey.pp_last = NULL;
 
-        ts_pid_t **pp_pidk = bsearch( &pidkey, p_list->pp_all, p_list->i_all,
-                                      sizeof(ts_pid_t *), ts_bsearch_searchkey_Compare );
-        if ( pp_pidk )
-            p_pid = *pp_pidk;
-        else
-            i_index = (pidkey.pp_last - p_list->pp_all); /* Last visited index */
+        bsearch( &pidkey, p_list->pp_all, p_list->i_all,
+                 sizeof(ts_pid_t *), ts_bsearch_searchkey_Compare );
+        i_index = (pidkey.pp_last - p_list->pp_all); /* Last visited index */
     }
 
-    if( p_pid == NULL )
     {
         if( p_list->i_all >= p_list->i_all_alloc )
         {
@@ -152,8 +141,7 @@ ts_pid_t * ts_pid_Get( ts_pid_list_t *p_list, uint16_t i_pid )
 
     }
 
-    p_list->p_last = p_pid;
-    p_list->i_last_pid = i_pid;
+    p_list->lookup[i_pid & 0x1FFF] = p_pid;
 
     return p_pid;
 }
@@ -94,10 +94,9 @@ struct ts_pid_list_t
     ts_pid_t **pp_all;
     int        i_all;
     int        i_all_alloc;
-    /* last recently used */
-    uint16_t   i_last_pid;
-    ts_pid_t  *p_last;
-
+    /* flat dispatch table over the whole 13 bit PID space, so the per-packet
+     * lookup is a single indexed load */
+    ts_pid_t  *lookup[8192];
 };
 
 /* opacified pid list */
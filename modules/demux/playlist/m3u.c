@@ -36,6 +36,17 @@
 
 #include "playlist.h"
 
+/* Entries delivered per ReadDir() call: large playlists are emitted in
+ * several chunks, so that the first items show up while the rest of the
+ * file is still streaming in */
+#define M3U_CHUNK_SIZE 512
+
+struct m3u_sys_s
+{
+    char *(*pf_dup)(const char *);
+    char *psz_group; /* group is a toggling tag, it persists across chunks */
+};
+
 /*****************************************************************************
  * Local prototypes
  *****************************************************************************/
@@ -112,14 +123,29 @@ int Import_M3U( vlc_object_t *p_this )
     if (offset && vlc_stream_Read(p_stream->s, NULL, offset) != offset)
         return VLC_EGENERIC;
 
+    struct m3u_sys_s *p_sys = malloc( sizeof(*p_sys) );
+    if( unlikely(p_sys == NULL) )
+        return VLC_ENOMEM;
+    p_sys->pf_dup = pf_dup;
+    p_sys->psz_group = NULL;
+
     msg_Dbg( p_stream, "found valid M3U playlist" );
-    p_stream->p_sys = pf_dup;
+    p_stream->p_sys = p_sys;
     p_stream->pf_readdir = ReadDir;
     p_stream->pf_control = PlaylistControl;
 
     return VLC_SUCCESS;
 }
 
+void Close_M3U( vlc_object_t *p_this )
+{
+    stream_t *p_stream = (stream_t *)p_this;
+    struct m3u_sys_s *p_sys = p_stream->p_sys;
+
+    free( p_sys->psz_group );
+    free( p_sys );
+}
+
 static bool ContainsURL(const uint8_t *p_peek, size_t i_peek)
 {
     const char *ps = (const char *)p_peek;
@@ -251,11 +277,12 @@ static int CreateEntry( input_item_node_t *p_node, const struct entry_meta_s *me
 
 static int ReadDir( stream_t *p_demux, input_item_node_t *p_subitems )
 {
+    struct m3u_sys_s *p_sys = p_demux->p_sys;
     char       *psz_line;
-    char       *psz_group = NULL; /* group is toggling tag */
     struct entry_meta_s meta;
     entry_meta_Init( &meta );
-    char *    (*pf_dup) (const char *) = p_demux->p_sys;
+    char *    (*pf_dup) (const char *) = p_sys->pf_dup;
+    unsigned    i_entries = 0;
 
     psz_line = vlc_stream_ReadLine( p_demux->s );
     while( psz_line )
@@ -289,8 +316,8 @@ static int ReadDir( stream_t *p_demux, input_item_node_t *p_subitems )
                 psz_parse += sizeof("EXTGRP:") - 1;
                 if( *psz_parse )
                 {
-                    free( psz_group );
-                    psz_group = pf_dup( psz_parse );
+                    free( p_sys->psz_group );
+                    p_sys->psz_group = pf_dup( psz_parse );
                 }
             }
             else if( !strncasecmp( psz_parse, "EXTVLCOPT:",
@@ -333,8 +360,8 @@ static int ReadDir( stream_t *p_demux, input_item_node_t *p_subitems )
             if( !meta.psz_name && psz_parse )
                 /* Use filename as name for relative entries */
                 meta.psz_name = strdup( psz_parse );
-            if( psz_group && !meta.psz_grouptitle )
-                meta.psz_grouptitle = strdup( psz_group );
+            if( p_sys->psz_group && !meta.psz_grouptitle )
+                meta.psz_grouptitle = strdup( p_sys->psz_group );
 
             meta.psz_mrl = ProcessMRL( psz_parse, p_demux->psz_url );
             free( psz_parse );
@@ -344,6 +371,14 @@ static int ReadDir( stream_t *p_demux, input_item_node_t *p_subitems )
             /* Cleanup state after entry */
             entry_meta_Clean( &meta );
             entry_meta_Init( &meta );
+
+            if( ++i_entries == M3U_CHUNK_SIZE )
+            {
+                /* Deliver the entries read so far, the caller reads the
+                 * rest by calling again */
+                free( psz_line );
+                return VLC_EAGAIN;
+            }
         }
 
  nextline:
@@ -355,7 +390,6 @@ static int ReadDir( stream_t *p_demux, input_item_node_t *p_subitems )
             /* Cleanup state */
             entry_meta_Clean( &meta );
             entry_meta_Init( &meta );
-            free( psz_group );
         }
     }
     return VLC_SUCCESS; /* Needed for correct operation of go back */
@@ -61,6 +61,7 @@ typedef struct
         webvtt_cue_t *p_array;
         size_t  i_alloc;
         size_t  i_count;
+        vlc_tick_t i_duration_max;
     } cues;
 
     struct
@@ -313,12 +314,34 @@ static int index_Compare( const void *a_, const void *b_ )
 
 static size_t getIndexByTime( demux_sys_t *p_sys, vlc_tick_t i_time )
 {
-    for( size_t i=0; i<p_sys->index.i_count; i++ )
+    /* binary search first entry not before i_time */
+    size_t i_low = 0;
+    size_t i_high = p_sys->index.i_count;
+    while( i_low < i_high )
+    {
+        size_t i_mid = i_low + (i_high - i_low) / 2;
+        if( p_sys->index.p_array[i_mid].time >= i_time )
+            i_high = i_mid;
+        else
+            i_low = i_mid + 1;
+    }
+    return ( i_low < p_sys->index.i_count ) ? i_low : 0;
+}
+
+static size_t getCueIndexByStartTime( demux_sys_t *p_sys, vlc_tick_t i_time )
+{
+    /* binary search first cue not starting before i_time */
+    size_t i_low = 0;
+    size_t i_high = p_sys->cues.i_count;
+    while( i_low < i_high )
     {
-        if( p_sys->index.p_array[i].time >= i_time )
-            return i;
+        size_t i_mid = i_low + (i_high - i_low) / 2;
+        if( p_sys->cues.p_array[i_mid].i_start >= i_time )
+            i_high = i_mid;
+        else
+            i_low = i_mid + 1;
     }
-    return 0;
+    return i_low;
 }
 
 static void BuildIndex( demux_t *p_demux )
@@ -344,6 +367,15 @@ static void BuildIndex( demux_t *p_demux )
         else
             p_sys->index.p_array[i].active = --i_overlaps;
     }
+
+    /* Remember the longest cue duration to bound active cues lookups */
+    p_sys->cues.i_duration_max = 0;
+    for( size_t i=0; i<p_sys->cues.i_count; i++ )
+    {
+        const webvtt_cue_t *p_cue = &p_sys->cues.p_array[i];
+        if( p_cue->i_stop - p_cue->i_start > p_sys->cues.i_duration_max )
+            p_sys->cues.i_duration_max = p_cue->i_stop - p_cue->i_start;
+    }
 }
 
 static block_t *demux_From( demux_t *p_demux, vlc_tick_t i_start )
@@ -352,7 +384,13 @@ static block_t *demux_From( demux_t *p_demux, vlc_tick_t i_start )
 
     block_t *p_list = NULL;
     block_t **pp_append = &p_list;
-    for( size_t i=0; i<p_sys->cues.i_count; i++ )
+    /* Cues are sorted by start time: none of those starting more than the
+     * longest cue duration before i_start can still be active */
+    size_t i_first = 0;
+    if( i_start > p_sys->cues.i_duration_max )
+        i_first = getCueIndexByStartTime( p_sys,
+                                          i_start - p_sys->cues.i_duration_max );
+    for( size_t i=i_first; i<p_sys->cues.i_count; i++ )
     {
         const webvtt_cue_t *p_cue = &p_sys->cues.p_array[i];
         if( p_cue->i_start > i_start )
@@ -221,6 +221,11 @@ struct intf_sys_t
     pl_item_names               pl_item_names;
     bool                        need_update;
     bool                        plidx_follow;
+
+    /* Something on screen changed; set from any thread, redrawn from the
+     * interface thread */
+    atomic_bool                 redraw;
+    vlc_player_timer_id        *player_timer;
 };
 
 /*****************************************************************************
@@ -377,6 +382,7 @@ playlist_on_items_added(vlc_playlist_t *playlist,
 
     intf_sys_t *sys = (intf_sys_t *)userdata;
     sys->need_update = true;
+    atomic_store_explicit(&sys->redraw, true, memory_order_relaxed);
 }
 
 static void
@@ -389,6 +395,27 @@ playlist_on_items_updated(vlc_playlist_t *playlist,
     VLC_UNUSED(index); VLC_UNUSED(items); VLC_UNUSED(count);
 
     ((intf_sys_t *)userdata)->need_update = true;
+    atomic_store_explicit(&((intf_sys_t *)userdata)->redraw, true,
+                          memory_order_relaxed);
+}
+
+/* Coalesced time/state updates from the player; the interface repaints on
+ * the next loop iteration instead of unconditionally every second */
+static void
+player_timer_on_update(const struct vlc_player_timer_point *value,
+                       void *userdata)
+{
+    VLC_UNUSED(value);
+    atomic_store_explicit(&((intf_sys_t *)userdata)->redraw, true,
+                          memory_order_relaxed);
+}
+
+static void
+player_timer_on_discontinuity(vlc_tick_t system_date, void *userdata)
+{
+    VLC_UNUSED(system_date);
+    atomic_store_explicit(&((intf_sys_t *)userdata)->redraw, true,
+                          memory_order_relaxed);
 }
 
 /* Playlist suxx */
@@ -1572,6 +1599,9 @@ static void HandleKey(intf_thread_t *intf)
     if (key == -1)
         return;
 
+    /* Any handled key may change what is displayed */
+    atomic_store_explicit(&sys->redraw, true, memory_order_relaxed);
+
     if (box == BOX_SEARCH || box == BOX_OPEN) {
         HandleEditBoxKey(intf, key, sys->box_type);
         return;
@@ -1646,6 +1676,8 @@ static void MsgCallback(void *data, int type, const vlc_log_t *msg,
         sys->i_msgs = 0;
 
     vlc_mutex_unlock(&sys->msg_lock);
+
+    atomic_store_explicit(&sys->redraw, true, memory_order_relaxed);
 }
 
 static const struct vlc_logger_operations log_ops = { MsgCallback, NULL };
@@ -1661,7 +1693,10 @@ static void *Run(void *data)
     intf_sys_t *sys = intf->p_sys;
 
     while (atomic_load_explicit(&sys->alive, memory_order_relaxed)) {
-        Redraw(intf);
+        /* Only repaint when something changed since the last pass; an idle
+         * interface just sleeps in getch() */
+        if (atomic_exchange_explicit(&sys->redraw, false, memory_order_relaxed))
+            Redraw(intf);
         HandleKey(intf);
     }
     return NULL;
@@ -1679,6 +1714,7 @@ static int Open(vlc_object_t *p_this)
         return VLC_ENOMEM;
 
     atomic_init(&sys->alive, true);
+    atomic_init(&sys->redraw, true);
     vlc_mutex_init(&sys->msg_lock);
 
     sys->verbosity = var_InheritInteger(intf, "verbose");
@@ -1728,8 +1764,25 @@ static int Open(vlc_object_t *p_this)
     if (!sys->playlist_listener)
         return err;
 
+    static struct vlc_player_timer_cbs const player_timer_cbs =
+    {
+        .on_update = player_timer_on_update,
+        .on_discontinuity = player_timer_on_discontinuity,
+    };
+    vlc_player_t *player = vlc_playlist_GetPlayer(sys->playlist);
+    sys->player_timer = vlc_player_AddTimer(player, VLC_TICK_FROM_SEC(1),
+                                            &player_timer_cbs, sys);
+    if (!sys->player_timer)
+    {
+        vlc_playlist_Lock(sys->playlist);
+        vlc_playlist_RemoveListener(sys->playlist, sys->playlist_listener);
+        vlc_playlist_Unlock(sys->playlist);
+        return err;
+    }
+
     if (vlc_clone(&sys->thread, Run, intf))
     {
+        vlc_player_RemoveTimer(player, sys->player_timer);
         vlc_playlist_Lock(sys->playlist);
         vlc_playlist_RemoveListener(sys->playlist, sys->playlist_listener);
         vlc_playlist_Unlock(sys->playlist);
@@ -1751,6 +1804,7 @@ static void Close(vlc_object_t *p_this)
     vlc_join(sys->thread, NULL);
 
     vlc_playlist_t *playlist = sys->playlist;
+    vlc_player_RemoveTimer(vlc_playlist_GetPlayer(playlist), sys->player_timer);
     vlc_playlist_Lock(playlist);
     vlc_playlist_RemoveListener(playlist, sys->playlist_listener);
     vlc_playlist_Unlock(playlist);
@@ -26,7 +26,11 @@ PlaylistItem::PlaylistItem(vlc_playlist_item_t* item)
     if (item)
     {
         d->item.reset(item);
-        sync();
+        /* Only the duration is needed up front (for the total duration of the
+         * playlist); the metadata strings are synced on first access */
+        input_item_t *media = vlc_playlist_item_GetMedia(item);
+        vlc_mutex_locker locker(&media->lock);
+        d->duration = media->i_duration;
     }
 }
 
@@ -42,21 +46,25 @@ void PlaylistItem::setSelected(bool selected)
 
 QString PlaylistItem::getTitle() const
 {
+    ensureSynced();
     return d->title;
 }
 
 QString PlaylistItem::getArtist() const
 {
+    ensureSynced();
     return d->artist;
 }
 
 QString PlaylistItem::getAlbum() const
 {
+    ensureSynced();
     return d->album;
 }
 
 QUrl PlaylistItem::getArtwork() const
 {
+    ensureSynced();
     return d->artwork;
 }
 
@@ -67,9 +75,18 @@ vlc_tick_t PlaylistItem::getDuration() const
 
 QUrl PlaylistItem::getUrl() const
 {
+    ensureSynced();
     return d->url;
 }
 
+void PlaylistItem::ensureSynced() const
+{
+    /* The cache is shared data, but it is only read and filled from the UI
+     * thread, so no synchronization is needed beyond the media lock */
+    if (!d->synced)
+        const_cast<PlaylistItem *>(this)->sync();
+}
+
 void PlaylistItem::sync() {
     input_item_t *media = vlc_playlist_item_GetMedia(d->item.get());
     vlc_mutex_locker locker(&media->lock);
@@ -86,6 +103,8 @@ void PlaylistItem::sync() {
     if (d->title.isNull())
         /* If there is no title, use the item name */
         d->title = media->psz_name;
+
+    d->synced = true;
 }
 
 PlaylistItem::operator bool() const
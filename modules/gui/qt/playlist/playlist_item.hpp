@@ -41,9 +41,10 @@ using PlaylistItemPtr = vlc_shared_data_ptr_type(vlc_playlist_item_t,
 /**
  * Playlist item wrapper.
  *
- * It contains both the PlaylistItemPtr and cached data saved while the playlist
- * is locked, so that the fields may be read without synchronization or race
- * conditions.
+ * It contains both the PlaylistItemPtr and cached data, so that the fields may
+ * be read without synchronization or race conditions. The metadata strings are
+ * only materialized on first access (from the UI thread): a huge playlist then
+ * costs one string cache per row actually displayed, not per item.
  */
 class PlaylistItem
 {
@@ -83,18 +84,21 @@ public:
     void sync();
 
 private:
+    void ensureSynced() const;
+
     struct Data : public QSharedData {
         PlaylistItemPtr item;
 
         bool selected = false;
 
-        /* cached values */
+        /* cached values, filled lazily by sync() */
+        bool synced = false;
         QString title;
         QString artist;
         QString album;
         QUrl artwork;
 
-        vlc_tick_t duration;
+        vlc_tick_t duration = 0;
 
         QUrl url;
     };
@@ -49,6 +49,7 @@ extern "C" char **environ;
 #include <QApplication>
 #include <QDate>
 #include <QMutex>
+#include <QTimer>
 #include <QtQuickControls2/QQuickStyle>
 #include <QLoggingCategory>
 
@@ -763,8 +764,12 @@ static void *Thread( void *obj )
         if( QDate::currentDate() >
              getSettings()->value( "updatedate" ).toDate().addDays( interval ) )
         {
-            /* The constructor of the update Dialog will do the 1st request */
-            UpdateDialog::getInstance( p_intf );
+            /* Defer the check until the interface has been up and idle for
+             * a while: no reason to hit the network while starting up.
+             * The constructor of the update Dialog will do the 1st request */
+            QTimer::singleShot( 60000, &app, [p_intf]() {
+                UpdateDialog::getInstance( p_intf );
+            } );
             getSettings()->setValue( "updatedate", QDate::currentDate() );
         }
     }
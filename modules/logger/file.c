@@ -35,6 +35,14 @@
 #include <assert.h>
 #include <errno.h>
 
+#ifdef HAVE_SYS_MMAN_H
+# include <stdatomic.h>
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
 static const char msg_type[4][9] = { "", " error", " warning", " debug" };
 
 typedef struct
@@ -126,6 +134,134 @@ static const struct vlc_logger_operations html_ops =
     Close
 };
 
+#ifdef HAVE_SYS_MMAN_H
+/*
+ * The ring mode maps a fixed-size file and writes records into it as a ring
+ * buffer. Records never hit the stdio path: formatting goes to the stack and
+ * one atomic addition reserves a span of the ring, so concurrent writers do
+ * not serialize on a lock. The pages are file-backed (MAP_SHARED), so the
+ * tail of the log survives a crash without any explicit flushing.
+ */
+#define RING_FILENAME "vlc-log.ring"
+#define RING_MAGIC "VLCRING1"
+
+struct ring_header
+{
+    char magic[8];
+    uint64_t size; /**< Size of the ring area, excluding this header */
+    _Atomic uint64_t head; /**< Total bytes written since initialization */
+};
+
+typedef struct
+{
+    struct ring_header *header;
+    char *ring;
+    uint64_t size;
+    int verbosity;
+} vlc_logger_ring_sys_t;
+
+static void LogRing(void *opaque, int type, const vlc_log_t *meta,
+                    const char *format, va_list ap)
+{
+    vlc_logger_ring_sys_t *sys = opaque;
+    char buf[1024];
+
+    if (sys->verbosity < type)
+        return;
+
+    int hlen = snprintf(buf, sizeof (buf) - 1, "%s%s: ",
+                        meta->psz_module, msg_type[type]);
+    if (hlen < 0 || (size_t)hlen >= sizeof (buf) - 1)
+        return;
+    int blen = vsnprintf(buf + hlen, sizeof (buf) - 1 - hlen, format, ap);
+    if (blen < 0)
+        return;
+
+    /* Long records are truncated to the formatting buffer */
+    size_t len = hlen + __MIN((size_t)blen, sizeof (buf) - 2 - hlen);
+    buf[len++] = '\n';
+
+    /* Reserve a span of the ring; concurrent writers get disjoint spans */
+    uint64_t head = atomic_fetch_add_explicit(&sys->header->head, len,
+                                              memory_order_relaxed);
+    size_t offset = head % sys->size;
+    size_t first = __MIN(len, sys->size - offset);
+
+    memcpy(sys->ring + offset, buf, first);
+    memcpy(sys->ring, buf + first, len - first);
+}
+
+static void CloseRing(void *opaque)
+{
+    vlc_logger_ring_sys_t *sys = opaque;
+
+    munmap(sys->header, sizeof (struct ring_header) + sys->size);
+    free(sys);
+}
+
+static const struct vlc_logger_operations ring_ops =
+{
+    LogRing,
+    CloseRing
+};
+
+static const struct vlc_logger_operations *OpenRing(vlc_object_t *obj,
+                                                    const char *filename,
+                                                    int verbosity,
+                                                    void **restrict sysp)
+{
+    uint64_t size = var_InheritInteger(obj, "logring-size");
+    if (size < 4096)
+        size = 4096;
+
+    vlc_logger_ring_sys_t *sys = malloc(sizeof (*sys));
+    if (unlikely(sys == NULL))
+        return NULL;
+
+    msg_Dbg(obj, "opening log ring `%s' (%"PRIu64" bytes)", filename, size);
+    int fd = vlc_open(filename, O_RDWR | O_CREAT, 0666);
+    if (fd == -1)
+    {
+        msg_Err(obj, "error opening log ring `%s': %s", filename,
+                vlc_strerror_c(errno));
+        free(sys);
+        return NULL;
+    }
+
+    size_t length = sizeof (struct ring_header) + size;
+    void *base = MAP_FAILED;
+
+    if (ftruncate(fd, length) == 0)
+        base = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    vlc_close(fd); /* the mapping keeps the file referenced */
+    if (base == MAP_FAILED)
+    {
+        msg_Err(obj, "error mapping log ring `%s': %s", filename,
+                vlc_strerror_c(errno));
+        free(sys);
+        return NULL;
+    }
+
+    sys->header = base;
+    sys->ring = (char *)base + sizeof (struct ring_header);
+    sys->size = size;
+    sys->verbosity = verbosity;
+
+    /* Keep appending to a ring from a previous run, otherwise (re)format */
+    if (memcmp(sys->header->magic, RING_MAGIC, sizeof (sys->header->magic))
+     || sys->header->size != size)
+    {
+        memcpy(sys->header->magic, RING_MAGIC, sizeof (sys->header->magic));
+        sys->header->size = size;
+        atomic_init(&sys->header->head, 0);
+        memset(sys->ring, 0, size);
+    }
+
+    *sysp = sys;
+    return &ring_ops;
+}
+#endif /* HAVE_SYS_MMAN_H */
+
 static const struct vlc_logger_operations *Open(vlc_object_t *obj,
                                                 void **restrict sysp)
 {
@@ -140,16 +276,13 @@ static const struct vlc_logger_operations *Open(vlc_object_t *obj,
 
     verbosity += VLC_MSG_ERR;
 
-    vlc_logger_sys_t *sys = malloc(sizeof (*sys));
-    if (unlikely(sys == NULL))
-        return NULL;
-
     const char *filename = TEXT_FILENAME;
     const char *header = TEXT_HEADER;
-
+    const char *footer = TEXT_FOOTER;
     const struct vlc_logger_operations *ops = &text_ops;
-    sys->footer = TEXT_FOOTER;
-    sys->verbosity = verbosity;
+#ifdef HAVE_SYS_MMAN_H
+    bool ring = false;
+#endif
 
     char *mode = var_InheritString(obj, "logmode");
     if (mode != NULL)
@@ -159,8 +292,15 @@ static const struct vlc_logger_operations *Open(vlc_object_t *obj,
             filename = HTML_FILENAME;
             header = HTML_HEADER;
             ops = &html_ops;
-            sys->footer = HTML_FOOTER;
+            footer = HTML_FOOTER;
+        }
+#ifdef HAVE_SYS_MMAN_H
+        else if (!strcmp(mode, "ring"))
+        {
+            filename = RING_FILENAME;
+            ring = true;
         }
+#endif
         else if (strcmp(mode, "text"))
             msg_Warn(obj, "invalid log mode \"%s\"", mode);
         free(mode);
@@ -182,6 +322,25 @@ static const struct vlc_logger_operations *Open(vlc_object_t *obj,
     if (path != NULL)
         filename = path;
 
+#ifdef HAVE_SYS_MMAN_H
+    if (ring)
+    {
+        ops = OpenRing(obj, filename, verbosity, sysp);
+        free(path);
+        return ops;
+    }
+#endif
+
+    vlc_logger_sys_t *sys = malloc(sizeof (*sys));
+    if (unlikely(sys == NULL))
+    {
+        free(path);
+        return NULL;
+    }
+
+    sys->footer = footer;
+    sys->verbosity = verbosity;
+
     /* Open the log file and remove any buffering for the stream */
     msg_Dbg(obj, "opening logfile `%s'", filename);
     sys->stream = vlc_fopen(filename, "at");
@@ -202,8 +361,16 @@ static const struct vlc_logger_operations *Open(vlc_object_t *obj,
     return ops;
 }
 
-static const char *const mode_list[] = { "text", "html" };
-static const char *const mode_list_text[] = { N_("Text"), N_("HTML") };
+static const char *const mode_list[] = { "text", "html",
+#ifdef HAVE_SYS_MMAN_H
+    "ring",
+#endif
+};
+static const char *const mode_list_text[] = { N_("Text"), N_("HTML"),
+#ifdef HAVE_SYS_MMAN_H
+    N_("Memory-mapped ring"),
+#endif
+};
 
 static const int verbosity_values[] = {
     -1,
@@ -224,6 +391,10 @@ static const char *const verbosity_text[] = { N_("Default"), N_("Info"), N_("Err
 #define LOGMODE_TEXT N_("Log format")
 #define LOGMODE_LONGTEXT N_("Specify the logging format.")
 
+#define LOGRING_SIZE_TEXT N_("Log ring size")
+#define LOGRING_SIZE_LONGTEXT N_("Size in bytes of the memory-mapped log " \
+    "ring. Older records are overwritten once the ring is full.")
+
 #define LOGVERBOSE_TEXT N_("Verbosity")
 #define LOGVERBOSE_LONGTEXT N_("Select the logging verbosity or " \
 "default to use the same verbosity given by --verbose.")
@@ -239,6 +410,8 @@ vlc_module_begin()
     add_savefile("logfile", NULL, LOGFILE_NAME_TEXT, LOGFILE_NAME_LONGTEXT)
     add_string("logmode", "text", LOGMODE_TEXT, LOGMODE_LONGTEXT)
         change_string_list(mode_list, mode_list_text)
+    add_integer("logring-size", 1 << 20, LOGRING_SIZE_TEXT,
+                LOGRING_SIZE_LONGTEXT)
     add_integer("log-verbose", -1, LOGVERBOSE_TEXT, LOGVERBOSE_LONGTEXT)
         change_integer_list(verbosity_values, verbosity_text)
 vlc_module_end ()
@@ -0,0 +1,202 @@
+/*****************************************************************************
+ * flamegraph.c: folded-stack tracer plugin
+ *****************************************************************************
+ * Copyright © 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <vlc_common.h>
+#include <vlc_plugin.h>
+#include <vlc_arrays.h>
+#include <vlc_fs.h>
+#include <vlc_memstream.h>
+#include <vlc_tracer.h>
+
+#include <stdarg.h>
+#include <errno.h>
+
+#define FOLDED_FILENAME "vlc-trace.folded"
+
+/*
+ * Aggregates trace records into the folded-stack format consumed by
+ * flamegraph.pl and similar tools.  Each record becomes one sample whose
+ * stack is built from its string entries in emission order, e.g.
+ * "vlc;video decoder;video/0 1234".  Samples are counted in a dictionary
+ * and the deltas are appended to the output file at a fixed interval;
+ * duplicate folded lines across flushes are summed by the tooling, so the
+ * file stays valid while it grows.
+ */
+
+typedef struct
+{
+    FILE *stream;
+    vlc_mutex_t lock;
+    vlc_dictionary_t counts;
+    vlc_tick_t interval;
+    vlc_tick_t deadline;
+} vlc_tracer_sys_t;
+
+static void FoldedPrintFrame(struct vlc_memstream *ms, const char *str)
+{
+    /* Frame separators and sample counts must not appear inside a frame */
+    for (; *str != '\0'; str++)
+    {
+        unsigned char c = *str;
+        if (c == ';' || c <= 0x20 || c == 0x7F)
+            c = '_';
+        vlc_memstream_putc(ms, c);
+    }
+}
+
+static void FlushCounts(vlc_tracer_sys_t *sys)
+{
+    const vlc_dictionary_t *counts = &sys->counts;
+
+    for (int i = 0; i < counts->i_size; i++)
+        for (const vlc_dictionary_entry_t *entry = counts->p_entries[i];
+             entry != NULL; entry = entry->p_next)
+            fprintf(sys->stream, "%s %" PRIu64 "\n", entry->psz_key,
+                    *(const uint64_t *)entry->p_value);
+
+    fflush(sys->stream);
+}
+
+static void FreeCount(void *value, void *obj)
+{
+    free(value);
+    (void) obj;
+}
+
+static void TraceFolded(void *opaque, vlc_tick_t ts, va_list entries)
+{
+    vlc_tracer_sys_t *sys = opaque;
+    struct vlc_memstream ms;
+
+    vlc_memstream_open(&ms);
+    vlc_memstream_puts(&ms, "vlc");
+
+    struct vlc_tracer_entry entry = va_arg(entries, struct vlc_tracer_entry);
+    while (entry.key != NULL)
+    {
+        /* Numeric entries are payload (pts, dts...), not pipeline stages */
+        if (entry.type == VLC_TRACER_STRING)
+        {
+            vlc_memstream_putc(&ms, ';');
+            FoldedPrintFrame(&ms, entry.value.string);
+        }
+        entry = va_arg(entries, struct vlc_tracer_entry);
+    }
+
+    if (vlc_memstream_close(&ms) != 0)
+        return;
+
+    vlc_mutex_lock(&sys->lock);
+    uint64_t *count = vlc_dictionary_value_for_key(&sys->counts, ms.ptr);
+    if (count != kVLCDictionaryNotFound)
+        (*count)++;
+    else
+    {
+        count = malloc(sizeof (*count));
+        if (likely(count != NULL))
+        {
+            *count = 1;
+            vlc_dictionary_insert(&sys->counts, ms.ptr, count);
+        }
+    }
+
+    if (ts >= sys->deadline)
+    {
+        FlushCounts(sys);
+        vlc_dictionary_clear(&sys->counts, FreeCount, NULL);
+        vlc_dictionary_init(&sys->counts, 0);
+        sys->deadline = ts + sys->interval;
+    }
+    vlc_mutex_unlock(&sys->lock);
+    free(ms.ptr);
+}
+
+static void Close(void *opaque)
+{
+    vlc_tracer_sys_t *sys = opaque;
+
+    FlushCounts(sys);
+    vlc_dictionary_clear(&sys->counts, FreeCount, NULL);
+    fclose(sys->stream);
+    free(sys);
+}
+
+static const struct vlc_tracer_operations folded_ops =
+{
+    TraceFolded,
+    Close
+};
+
+static const struct vlc_tracer_operations *Open(vlc_object_t *obj,
+                                                void **restrict sysp)
+{
+    vlc_tracer_sys_t *sys = malloc(sizeof (*sys));
+    if (unlikely(sys == NULL))
+        return NULL;
+
+    vlc_mutex_init(&sys->lock);
+    vlc_dictionary_init(&sys->counts, 0);
+    sys->interval =
+        vlc_tick_from_sec(var_InheritInteger(obj, "flame-tracer-interval"));
+    sys->deadline = vlc_tick_now() + sys->interval;
+
+    const char *filename = FOLDED_FILENAME;
+    char *path = var_InheritString(obj, "flame-tracer-file");
+    if (path != NULL)
+        filename = path;
+
+    msg_Dbg(obj, "opening trace file `%s'", filename);
+    sys->stream = vlc_fopen(filename, "at");
+    if (sys->stream == NULL)
+    {
+        msg_Err(obj, "error opening trace file `%s': %s", filename,
+                vlc_strerror_c(errno));
+        free(path);
+        free(sys);
+        return NULL;
+    }
+    free(path);
+
+    *sysp = sys;
+    return &folded_ops;
+}
+
+#define TRACEFILE_NAME_TEXT N_("Trace filename")
+#define TRACEFILE_NAME_LONGTEXT N_("Specify the folded-stack output filename.")
+#define FLUSH_INTERVAL_TEXT N_("Flush interval")
+#define FLUSH_INTERVAL_LONGTEXT N_("Interval in seconds between writes of " \
+    "the aggregated samples to the output file.")
+
+vlc_module_begin()
+    set_shortname(N_("Flame graph"))
+    set_description(N_("Folded-stack tracer"))
+    set_subcategory(SUBCAT_ADVANCED_MISC)
+    set_capability("tracer", 0)
+    set_callback(Open)
+
+    add_savefile("flame-tracer-file", NULL, TRACEFILE_NAME_TEXT,
+                 TRACEFILE_NAME_LONGTEXT)
+    add_integer("flame-tracer-interval", 10, FLUSH_INTERVAL_TEXT,
+                FLUSH_INTERVAL_LONGTEXT)
+vlc_module_end()
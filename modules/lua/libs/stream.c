@@ -238,7 +238,11 @@ static int vlclua_stream_readdir( lua_State *L )
     input_item_Release( p_input );
     if( !p_items )
         return vlclua_error( L );
-    if ( vlc_stream_ReadDir( *pp_stream, p_items ) )
+    int i_ret;
+    do /* drain incremental listings into a single node */
+        i_ret = vlc_stream_ReadDir( *pp_stream, p_items );
+    while ( i_ret == VLC_EAGAIN );
+    if ( i_ret != VLC_SUCCESS )
     {
         input_item_node_Delete( p_items );
         return vlclua_error( L );
@@ -574,17 +574,140 @@ int vlclua_add_modules_path( lua_State *L, const char *psz_filename )
     return 0;
 }
 
+/*****************************************************************************
+ * Compiled chunk cache
+ *****************************************************************************
+ * Scripts are compiled from source on every activation, and several users
+ * run the same file over and over (one meta fetcher pass per item, extension
+ * scans, stream filter probes). Keep the bytecode of recently used local
+ * scripts so repeated loads skip the parser; entries are dropped when the
+ * file's modification time changes.
+ */
+struct vlclua_chunk
+{
+    char *psz_path;
+    time_t date; /**< script mtime when it was compiled */
+    char *p_code;
+    size_t i_code;
+    struct vlclua_chunk *p_next;
+};
+
+#define LUA_CHUNK_CACHE_MAX 32
+
+static struct
+{
+    vlc_mutex_t lock;
+    struct vlclua_chunk *p_first;
+    size_t i_count;
+} chunk_cache = { VLC_STATIC_MUTEX, NULL, 0 };
+
+static void vlclua_chunk_delete( struct vlclua_chunk *p_chunk )
+{
+    free( p_chunk->psz_path );
+    free( p_chunk->p_code );
+    free( p_chunk );
+}
+
+static int vlclua_dump_chunk( lua_State *L, const void *p_data, size_t i_size,
+                              void *p_opaque )
+{
+    struct vlclua_chunk *p_chunk = p_opaque;
+    VLC_UNUSED( L );
+
+    char *p_code = realloc( p_chunk->p_code, p_chunk->i_code + i_size );
+    if( unlikely( p_code == NULL ) )
+        return 1;
+    memcpy( p_code + p_chunk->i_code, p_data, i_size );
+    p_chunk->p_code = p_code;
+    p_chunk->i_code += i_size;
+    return 0;
+}
+
+/** luaL_loadfile going through the process-wide bytecode cache */
+static int vlclua_loadfile_cached( lua_State *L, const char *psz_path )
+{
+    struct stat st;
+    if( vlc_stat( psz_path, &st ) )
+        return luaL_loadfile( L, psz_path );
+
+    vlc_mutex_lock( &chunk_cache.lock );
+    for( struct vlclua_chunk **pp = &chunk_cache.p_first; *pp != NULL;
+         pp = &(*pp)->p_next )
+    {
+        struct vlclua_chunk *p_chunk = *pp;
+        if( strcmp( p_chunk->psz_path, psz_path ) )
+            continue;
+        if( p_chunk->date != st.st_mtime )
+        {
+            /* The script was edited, recompile it */
+            *pp = p_chunk->p_next;
+            chunk_cache.i_count--;
+            vlclua_chunk_delete( p_chunk );
+            break;
+        }
+        /* Move to front so eviction stays least-recently-used */
+        *pp = p_chunk->p_next;
+        p_chunk->p_next = chunk_cache.p_first;
+        chunk_cache.p_first = p_chunk;
+        int i_ret = luaL_loadbuffer( L, p_chunk->p_code, p_chunk->i_code,
+                                     psz_path );
+        vlc_mutex_unlock( &chunk_cache.lock );
+        return i_ret;
+    }
+    vlc_mutex_unlock( &chunk_cache.lock );
+
+    int i_ret = luaL_loadfile( L, psz_path );
+    if( i_ret )
+        return i_ret;
+
+    /* Cache the compiled chunk; on failure the load still succeeded,
+     * only the cache misses out */
+    struct vlclua_chunk *p_chunk = calloc( 1, sizeof( *p_chunk ) );
+    if( unlikely( p_chunk == NULL ) )
+        return i_ret;
+    p_chunk->psz_path = strdup( psz_path );
+    p_chunk->date = st.st_mtime;
+#if LUA_VERSION_NUM >= 503
+    int i_dump = lua_dump( L, vlclua_dump_chunk, p_chunk, 0 );
+#else
+    int i_dump = lua_dump( L, vlclua_dump_chunk, p_chunk );
+#endif
+    if( i_dump || p_chunk->psz_path == NULL )
+    {
+        vlclua_chunk_delete( p_chunk );
+        return i_ret;
+    }
+
+    vlc_mutex_lock( &chunk_cache.lock );
+    p_chunk->p_next = chunk_cache.p_first;
+    chunk_cache.p_first = p_chunk;
+    if( ++chunk_cache.i_count > LUA_CHUNK_CACHE_MAX )
+    {
+        struct vlclua_chunk **pp = &chunk_cache.p_first;
+        while( ( *pp )->p_next != NULL )
+            pp = &( *pp )->p_next;
+        struct vlclua_chunk *p_last = *pp;
+        *pp = NULL;
+        chunk_cache.i_count--;
+        vlclua_chunk_delete( p_last );
+    }
+    vlc_mutex_unlock( &chunk_cache.lock );
+    return 0;
+}
+
 /** Replacement for luaL_dofile, using VLC's input capabilities */
 int vlclua_dofile( vlc_object_t *p_this, lua_State *L, const char *curi )
 {
     char *uri = ToLocaleDup( curi );
     if( !strstr( uri, "://" ) ) {
-        int ret = luaL_dofile( L, uri );
+        int ret = vlclua_loadfile_cached( L, uri ) ||
+                  lua_pcall( L, 0, LUA_MULTRET, 0 );
         free( uri );
         return ret;
     }
     if( !strncasecmp( uri, "file://", 7 ) ) {
-        int ret = luaL_dofile( L, uri + 7 );
+        int ret = vlclua_loadfile_cached( L, uri + 7 ) ||
+                  lua_pcall( L, 0, LUA_MULTRET, 0 );
         free( uri );
         return ret;
     }
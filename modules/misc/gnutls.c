@@ -375,12 +375,101 @@ static int gnutls_Handshake(vlc_tls_t *tls, char **restrict alp)
     return 0;
 }
 
+#define GNUTLS_TICKET_CACHE_SIZE 8
+
+/**
+ * Client-side TLS credentials private data
+ */
+typedef struct vlc_tls_client_sys
+{
+    gnutls_certificate_credentials_t x509;
+
+    /* Session resumption cache, keyed by server host name: reconnections
+     * to a known server present its ticket and skip the full handshake. */
+    struct
+    {
+        vlc_mutex_t lock;
+        struct gnutls_cached_ticket
+        {
+            char *host;
+            gnutls_datum_t data;
+        } entry[GNUTLS_TICKET_CACHE_SIZE]; /* most recently used first */
+    } cache;
+} vlc_tls_client_sys_t;
+
+static void gnutls_TicketGet(vlc_tls_client_t *crd, gnutls_session_t session,
+                             const char *host)
+{
+    vlc_tls_client_sys_t *sys = crd->sys;
+
+    vlc_mutex_lock(&sys->cache.lock);
+    for (unsigned i = 0; i < GNUTLS_TICKET_CACHE_SIZE; i++)
+    {
+        struct gnutls_cached_ticket *t = &sys->cache.entry[i];
+
+        if (t->host == NULL || strcmp(t->host, host))
+            continue;
+
+        int val = gnutls_session_set_data(session, t->data.data, t->data.size);
+        if (val != 0)
+            msg_Dbg(crd, "cannot offer TLS session resumption: %s",
+                    gnutls_strerror(val));
+        break;
+    }
+    vlc_mutex_unlock(&sys->cache.lock);
+}
+
+static void gnutls_TicketStore(vlc_tls_client_t *crd, gnutls_session_t session,
+                               const char *host)
+{
+    vlc_tls_client_sys_t *sys = crd->sys;
+    gnutls_datum_t data;
+
+    /* With TLS 1.3 on a non-blocking session, the ticket may not have been
+     * received yet; then nothing is cached and the next connection simply
+     * performs a full handshake. */
+    if (gnutls_session_get_data2(session, &data) != 0)
+        return;
+    if (data.size == 0)
+    {
+        gnutls_free(data.data);
+        return;
+    }
+
+    char *dup = strdup(host);
+    if (unlikely(dup == NULL))
+    {
+        gnutls_free(data.data);
+        return;
+    }
+
+    struct gnutls_cached_ticket old;
+    unsigned i;
+
+    vlc_mutex_lock(&sys->cache.lock);
+    /* refresh the entry for this host if any, else evict the oldest one */
+    for (i = 0; i < GNUTLS_TICKET_CACHE_SIZE - 1; i++)
+        if (sys->cache.entry[i].host != NULL
+         && strcmp(sys->cache.entry[i].host, host) == 0)
+            break;
+
+    old = sys->cache.entry[i];
+    memmove(&sys->cache.entry[1], &sys->cache.entry[0], i * sizeof (old));
+    sys->cache.entry[0].host = dup;
+    sys->cache.entry[0].data = data;
+    vlc_mutex_unlock(&sys->cache.lock);
+
+    free(old.host);
+    gnutls_free(old.data.data);
+}
+
 static vlc_tls_t *gnutls_ClientSessionOpen(vlc_tls_client_t *crd,
                                            vlc_tls_t *sk, const char *hostname,
                                            const char *const *alpn)
 {
+    vlc_tls_client_sys_t *sys = crd->sys;
     vlc_tls_gnutls_t *priv = gnutls_SessionOpen(VLC_OBJECT(crd), GNUTLS_CLIENT,
-                                                crd->sys, sk, alpn);
+                                                sys->x509, sk, alpn);
     if (priv == NULL)
         return NULL;
 
@@ -390,9 +479,13 @@ static vlc_tls_t *gnutls_ClientSessionOpen(vlc_tls_client_t *crd,
     gnutls_dh_set_prime_bits (session, 1024);
 
     if (likely(hostname != NULL))
+    {
         /* fill Server Name Indication */
         gnutls_server_name_set (session, GNUTLS_NAME_DNS,
                                 hostname, strlen (hostname));
+        /* offer to resume an earlier session with this host */
+        gnutls_TicketGet(crd, session, hostname);
+    }
 
     return &priv->tls;
 }
@@ -408,8 +501,19 @@ static int gnutls_ClientHandshake(vlc_tls_t *tls,
     if (val)
         return val;
 
-    /* certificates chain verification */
     gnutls_session_t session = priv->session;
+    vlc_tls_client_t *crd = (vlc_tls_client_t *)obj;
+
+    if (host != NULL && gnutls_session_is_resumed(session))
+    {
+        /* The certificate was already verified when the session being
+         * resumed was established. */
+        msg_Dbg(obj, "TLS session resumed with %s", host);
+        gnutls_TicketStore(crd, session, host);
+        return 0;
+    }
+
+    /* certificates chain verification */
     unsigned status;
 
     val = gnutls_certificate_verify_peers3 (session, host, &status);
@@ -421,7 +525,11 @@ static int gnutls_ClientHandshake(vlc_tls_t *tls,
     }
 
     if (status == 0) /* Good certificate */
+    {
+        if (host != NULL)
+            gnutls_TicketStore(crd, session, host);
         return 0;
+    }
 
     /* Bad certificate */
     gnutls_datum_t desc;
@@ -459,6 +567,7 @@ static int gnutls_ClientHandshake(vlc_tls_t *tls,
     {
         case 0:
             msg_Dbg(obj, "certificate key match for %s", host);
+            gnutls_TicketStore(crd, session, host);
             return 0;
         case GNUTLS_E_NO_CERTIFICATE_FOUND:
             msg_Dbg(obj, "no known certificates for %s", host);
@@ -533,9 +642,15 @@ error:
 
 static void gnutls_ClientDestroy(vlc_tls_client_t *crd)
 {
-    gnutls_certificate_credentials_t x509 = crd->sys;
+    vlc_tls_client_sys_t *sys = crd->sys;
 
-    gnutls_certificate_free_credentials(x509);
+    for (unsigned i = 0; i < GNUTLS_TICKET_CACHE_SIZE; i++)
+    {
+        free(sys->cache.entry[i].host);
+        gnutls_free(sys->cache.entry[i].data.data);
+    }
+    gnutls_certificate_free_credentials(sys->x509);
+    free(sys);
 }
 
 static const struct vlc_tls_client_operations gnutls_ClientOps =
@@ -588,8 +703,18 @@ static int OpenClient(vlc_tls_client_t *crd)
     gnutls_certificate_set_verify_flags (x509,
                                          GNUTLS_VERIFY_ALLOW_X509_V1_CA_CRT);
 
+    vlc_tls_client_sys_t *sys = calloc(1, sizeof (*sys));
+    if (unlikely(sys == NULL))
+    {
+        gnutls_certificate_free_credentials(x509);
+        return VLC_ENOMEM;
+    }
+
+    sys->x509 = x509;
+    vlc_mutex_init(&sys->cache.lock);
+
     crd->ops = &gnutls_ClientOps;
-    crd->sys = x509;
+    crd->sys = sys;
     return VLC_SUCCESS;
 }
 
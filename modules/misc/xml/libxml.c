@@ -116,7 +116,6 @@ static void ReaderErrorHandler( void *p_arg, const char *p_msg,
 typedef struct
 {
     xmlTextReaderPtr xml;
-    char *node;
 } xml_reader_sys_t;
 
 static int ReaderUseDTD ( xml_reader_t *p_reader )
@@ -137,9 +136,6 @@ static int ReaderNextNode( xml_reader_t *p_reader, const char **pval )
     const xmlChar *node;
     int ret;
 
-    free( p_sys->node );
-    p_sys->node = NULL;
-
 skip:
     switch( xmlTextReaderRead( p_sys->xml ) )
     {
@@ -177,10 +173,13 @@ skip:
     if( unlikely(node == NULL) )
         return XML_READER_ERROR;
 
-    p_sys->node = strdup( (const char *)node );
+    /* The string belongs to libxml and remains valid until the next
+     * xmlTextReaderRead(), which matches the xml_ReaderNextNode() contract:
+     * no need to copy it. Element names even live in the reader dictionary
+     * for the whole lifetime of the reader. */
     if( pval != NULL )
-        *pval = p_sys->node;
-    return likely(p_sys->node != NULL) ? ret : XML_READER_ERROR;
+        *pval = (const char *)node;
+    return ret;
 }
 
 static const char *ReaderNextAttr( xml_reader_t *p_reader, const char **pval )
@@ -243,7 +242,6 @@ static int ReaderOpen( vlc_object_t *p_this )
                                   ReaderErrorHandler, p_reader );
 
     p_sys->xml = p_libxml_reader;
-    p_sys->node = NULL;
     p_reader->p_sys = p_sys;
     p_reader->pf_next_node = ReaderNextNode;
     p_reader->pf_next_attr = ReaderNextAttr;
@@ -259,7 +257,6 @@ static void ReaderClose( vlc_object_t *p_this )
     xml_reader_sys_t *p_sys = p_reader->p_sys;
 
     xmlFreeTextReader( p_sys->xml );
-    free( p_sys->node );
     free( p_sys );
 
     /* /!\
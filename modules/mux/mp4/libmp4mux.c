@@ -197,15 +197,18 @@ bool mp4mux_track_AddSample(mp4mux_trackinfo_t *t, const mp4mux_sample_t *entry)
     /* XXX: -1 to always have 2 entry for easy adding of empty SPU */
     if (t->i_samples_count + 2 >= t->i_samples_max)
     {
-        if(t->i_samples_max + 1000 < t->i_samples_max)
+        /* Grow geometrically: constant increments make appending quadratic
+         * over the hundreds of thousands of samples of a long recording */
+        unsigned i_samples_max = t->i_samples_max ? t->i_samples_max * 2 : 1000;
+        if(i_samples_max < t->i_samples_max)
             return false;
         mp4mux_sample_t *p_realloc = vlc_reallocarray(t->samples,
-                                                      t->i_samples_max + 1000,
+                                                      i_samples_max,
                                                       sizeof(*p_realloc));
         if(!p_realloc)
             return false;
         t->samples = p_realloc;
-        t->i_samples_max += 1000;
+        t->i_samples_max = i_samples_max;
     }
     t->samples[t->i_samples_count++] = *entry;
     if(!t->b_hasbframes && entry->i_pts_dts != 0)
@@ -1609,6 +1612,16 @@ static int64_t GetScaledEntryDuration( const mp4mux_sample_t *p_entry, uint32_t
     return i_scaled;
 }
 
+/* Raise the reallocation increment of a box about to receive per-sample
+ * entries. With the default 1 KiB step, filling a multi-megabyte table
+ * copies the whole buffer thousands of times, which dominates the close
+ * time of long recordings. */
+static void box_sizehint(bo_t *box, size_t i_size)
+{
+    if(box && i_size > box->basesize)
+        box->basesize = i_size;
+}
+
 static bo_t *GetStblBox(vlc_object_t *p_obj, mp4mux_trackinfo_t *p_track, bool b_mov, bool b_stco64)
 {
     /* sample description */
@@ -1638,6 +1651,7 @@ static bo_t *GetStblBox(vlc_object_t *p_obj, mp4mux_trackinfo_t *p_track, bool b
         bo_free(stsd);
         return NULL;
     }
+    box_sizehint(stco, (b_stco64 ? 8 : 4) * (size_t)p_track->i_samples_count);
     bo_add_32be(stco, 0);     // entry-count (fixed latter)
 
     /* sample to chunk table */
@@ -1648,6 +1662,7 @@ static bo_t *GetStblBox(vlc_object_t *p_obj, mp4mux_trackinfo_t *p_track, bool b
         bo_free(stsd);
         return NULL;
     }
+    box_sizehint(stsc, 12 * (size_t)p_track->i_samples_count);
     bo_add_32be(stsc, 0);     // entry-count (fixed latter)
 
     unsigned i_chunk = 0;
@@ -1695,6 +1710,7 @@ static bo_t *GetStblBox(vlc_object_t *p_obj, mp4mux_trackinfo_t *p_track, bool b
         bo_free(stsc);
         return NULL;
     }
+    box_sizehint(stts, 8 * (size_t)p_track->i_samples_count);
     bo_add_32be(stts, 0);     // entry-count (fixed latter)
 
     vlc_tick_t i_total_mtime = 0;
@@ -1731,6 +1747,7 @@ static bo_t *GetStblBox(vlc_object_t *p_obj, mp4mux_trackinfo_t *p_track, bool b
     bo_t *ctts = NULL;
     if ( p_track->b_hasbframes && (ctts = box_full_new("ctts", 0, 0)) )
     {
+        box_sizehint(ctts, 8 * (size_t)p_track->i_samples_count);
         bo_add_32be(ctts, 0);
         i_index = 0;
         for (unsigned i = 0; i < p_track->i_samples_count; i_index++)
@@ -1756,6 +1773,7 @@ static bo_t *GetStblBox(vlc_object_t *p_obj, mp4mux_trackinfo_t *p_track, bool b
         bo_free(stts);
         return NULL;
     }
+    box_sizehint(stsz, 4 * (size_t)p_track->i_samples_count);
     int i_size = 0;
     for (unsigned i = 0; i < p_track->i_samples_count; i++)
     {
@@ -1795,6 +1813,7 @@ static bo_t *GetStblBox(vlc_object_t *p_obj, mp4mux_trackinfo_t *p_track, bool b
                     stss = box_full_new("stss", 0, 0);
                     if(!stss)
                         break;
+                    box_sizehint(stss, 4 * (size_t)p_track->i_samples_count);
                     bo_add_32be(stss, 0); /* fixed later */
                 }
                 bo_add_32be(stss, 1 + i);
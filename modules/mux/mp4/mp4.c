@@ -386,7 +386,7 @@ static void Close(vlc_object_t *p_this)
         /* Make space, move MDAT data by moov size towards the end */
         while (i_mdatsize > 0)
         {
-            size_t i_chunk = __MIN(32768, i_mdatsize);
+            size_t i_chunk = __MIN(1 << 20, i_mdatsize);
             block_t *p_buf = block_Alloc(i_chunk);
             sout_AccessOutSeek(p_mux->p_access,
                                 p_sys->i_mdat_pos + i_mdatsize - i_chunk);
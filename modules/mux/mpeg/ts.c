@@ -1129,6 +1129,37 @@ static block_t *Encap_J2K( block_t *p_data, const es_format_t *p_fmt )
 }
 
 /* returns true if needs more data */
+/* Binary min-heap of input indexes keyed by pending PES DTS, so electing
+ * the next stream to packetize is O(log n) instead of a scan over every
+ * ES of every service for each 188 byte packet */
+static inline vlc_tick_t MuxGetPesDts( sout_mux_t *p_mux, int i_index )
+{
+    const sout_input_sys_t *p_stream =
+        (sout_input_sys_t *)p_mux->pp_inputs[i_index]->p_sys;
+    return p_stream->state.i_pes_dts;
+}
+
+static void MuxHeapSiftDown( sout_mux_t *p_mux, int *p_heap, int i_count, int i )
+{
+    for (;;)
+    {
+        int i_child = 2 * i + 1;
+        if( i_child >= i_count )
+            break;
+        if( i_child + 1 < i_count &&
+            MuxGetPesDts( p_mux, p_heap[i_child + 1] ) <
+            MuxGetPesDts( p_mux, p_heap[i_child] ) )
+            i_child++;
+        if( MuxGetPesDts( p_mux, p_heap[i] ) <=
+            MuxGetPesDts( p_mux, p_heap[i_child] ) )
+            break;
+        int i_tmp = p_heap[i];
+        p_heap[i] = p_heap[i_child];
+        p_heap[i_child] = i_tmp;
+        i = i_child;
+    }
+}
+
 static bool MuxStreams(sout_mux_t *p_mux )
 {
     sout_mux_sys_t  *p_sys = p_mux->p_sys;
@@ -1433,34 +1464,31 @@ static bool MuxStreams(sout_mux_t *p_mux )
     /* msg_Dbg( p_mux, "estimated pck=%d", i_packet_count ); */
 
     const vlc_tick_t i_pcr_dts = p_pcr_stream->state.i_pes_dts;
-    for (;;)
+
+    int p_heap[p_mux->i_nb_inputs];
+    int i_heap_count = 0;
+    for (int i = 0; i < p_mux->i_nb_inputs; i++ )
     {
-        int          i_stream = -1;
-        vlc_tick_t   i_dts = 0;
-        sout_input_sys_t *p_stream;
+        if( MuxGetPesDts( p_mux, i ) != 0 )
+            p_heap[i_heap_count++] = i;
+    }
+    for (int i = i_heap_count / 2 - 1; i >= 0; i-- )
+        MuxHeapSiftDown( p_mux, p_heap, i_heap_count, i );
 
-        /* Select stream (lowest dts) */
-        for (int i = 0; i < p_mux->i_nb_inputs; i++ )
-        {
-            p_stream = (sout_input_sys_t*)p_mux->pp_inputs[i]->p_sys;
+    for (;;)
+    {
+        if( i_heap_count == 0 )
+            break;
 
-            if( p_stream->state.i_pes_dts == 0 )
-            {
-                continue;
-            }
+        /* Stream with the lowest dts */
+        sout_input_sys_t *p_stream =
+            (sout_input_sys_t*)p_mux->pp_inputs[p_heap[0]]->p_sys;
+        sout_input_t *p_input = p_mux->pp_inputs[p_heap[0]];
 
-            if( i_stream == -1 || p_stream->state.i_pes_dts < i_dts )
-            {
-                i_stream = i;
-                i_dts = p_stream->state.i_pes_dts;
-            }
-        }
-        if( i_stream == -1 || i_dts > i_pcr_dts + i_pcr_length )
+        if( p_stream->state.i_pes_dts > i_pcr_dts + i_pcr_length )
         {
             break;
         }
-        p_stream = (sout_input_sys_t*)p_mux->pp_inputs[i_stream]->p_sys;
-        sout_input_t *p_input = p_mux->pp_inputs[i_stream];
 
         /* do we need to issue pcr */
         bool b_pcr = false;
@@ -1505,6 +1533,11 @@ static bool MuxStreams(sout_mux_t *p_mux )
 
         /* */
         BufferChainAppend( &chain_ts, p_ts );
+
+        /* TSNew advanced (or exhausted) this stream's PES DTS */
+        if( p_stream->state.i_pes_dts == 0 )
+            p_heap[0] = p_heap[--i_heap_count];
+        MuxHeapSiftDown( p_mux, p_heap, i_heap_count, 0 );
     }
 
     /* 4: date and send */
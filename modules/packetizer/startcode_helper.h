@@ -31,6 +31,9 @@
 
 #  ifdef HAS_ATTRIBUTE_VECTORSIZE
     typedef unsigned char v16qu __attribute__((__vector_size__(16)));
+#    ifdef CAN_COMPILE_AVX2
+    typedef unsigned char v32qu __attribute__((__vector_size__(32)));
+#    endif
 #  endif
 #endif
 
@@ -117,6 +120,81 @@ static inline const uint8_t * startcode_FindAnnexB_SSE2( const uint8_t *p, const
     return NULL;
 }
 
+#ifdef CAN_COMPILE_AVX2
+
+__attribute__ ((__target__ ("avx2")))
+static inline const uint8_t * startcode_FindAnnexB_AVX2( const uint8_t *p, const uint8_t *end )
+{
+    /* First align to 32 */
+    /* Skipping this step and doing unaligned loads isn't faster */
+    const uint8_t *alignedend = p + 32 - ((intptr_t)p & 31);
+    for (end -= 3; p < alignedend && p <= end; p++) {
+        if (p[0] == 0 && p[1] == 0 && p[2] == 1)
+            return p;
+    }
+
+    if( p == end )
+        return NULL;
+
+    alignedend = end - ((intptr_t) end & 31);
+    if( alignedend > p )
+    {
+#  ifdef HAS_ATTRIBUTE_VECTORSIZE
+        const v32qu zeros = { 0 };
+#  endif
+
+        for( ; p < alignedend; p += 32)
+        {
+            uint32_t match;
+#  ifdef HAS_ATTRIBUTE_VECTORSIZE
+            asm volatile(
+                "vmovdqa   0(%[v]),  %%ymm0\n"
+                "vpcmpeqb %[czero],  %%ymm0, %%ymm0\n"
+                "vpmovmskb %%ymm0,   %[match]\n" /* mask will be in reversed match order */
+                : [match]"=r"(match)
+                : [v]"r"(p), [czero]"x"(zeros)
+                : "ymm0"
+            );
+#  else
+            asm volatile(
+                "vpxor     %%ymm1,   %%ymm1, %%ymm1\n"
+                "vmovdqa   0(%[v]),  %%ymm0\n"
+                "vpcmpeqb  %%ymm1,   %%ymm0, %%ymm0\n"
+                "vpmovmskb %%ymm0,   %[match]\n" /* mask will be in reversed match order */
+                : [match]"=r"(match)
+                : [v]"r"(p)
+                : "ymm0", "ymm1"
+            );
+#  endif
+            if( match & 0x0000000F )
+                TRY_MATCH(p, 0);
+            if( match & 0x000000F0 )
+                TRY_MATCH(p, 4);
+            if( match & 0x00000F00 )
+                TRY_MATCH(p, 8);
+            if( match & 0x0000F000 )
+                TRY_MATCH(p, 12);
+            if( match & 0x000F0000 )
+                TRY_MATCH(p, 16);
+            if( match & 0x00F00000 )
+                TRY_MATCH(p, 20);
+            if( match & 0x0F000000 )
+                TRY_MATCH(p, 24);
+            if( match & 0xF0000000 )
+                TRY_MATCH(p, 28);
+        }
+    }
+
+    for (; p <= end; p++) {
+        if (p[0] == 0 && p[1] == 0 && p[2] == 1)
+            return p;
+    }
+
+    return NULL;
+}
+
+#endif
+
 #endif
 
 /* That code is adapted from libav's ff_avc_find_startcode_internal
@@ -153,6 +231,10 @@ static inline const uint8_t * startcode_FindAnnexB_Bits( const uint8_t *p, const
 #ifdef CAN_COMPILE_SSE2
 static inline const uint8_t * startcode_FindAnnexB( const uint8_t *p, const uint8_t *end )
 {
+#  ifdef CAN_COMPILE_AVX2
+    if (vlc_CPU_AVX2())
+        return startcode_FindAnnexB_AVX2(p, end);
+#  endif
     if (vlc_CPU_SSE2())
         return startcode_FindAnnexB_SSE2(p, end);
     else
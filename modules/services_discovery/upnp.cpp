@@ -55,6 +55,8 @@ const char* CONTENT_DIRECTORY_SERVICE_TYPE = "urn:schemas-upnp-org:service:Conte
 const char* SATIP_SERVER_DEVICE_TYPE = "urn:ses-com:device:SatIPServer:1";
 
 #define UPNP_SEARCH_TIMEOUT_SECONDS 15
+/* Number of entries requested per ContentDirectory Browse action */
+#define BROWSE_PAGE_SIZE  500
 #define SATIP_CHANNEL_LIST N_("SAT>IP channel list")
 #define SATIP_CHANNEL_LIST_URL N_("Custom SAT>IP channel list URL")
 
@@ -1276,34 +1278,37 @@ browseActionCleanup:
  */
 bool MediaServer::fetchContents()
 {
-    std::string StartingIndex = "0";
-    std::string RequestedCount = "5000";
-    const char* psz_TotalMatches = "0";
-    const char* psz_NumberReturned = "0";
-    long  l_reqCount = 0;
-
-    do
+    /* Browse in fixed-size pages: the server starts answering after
+     * producing one page worth of metadata instead of serializing the
+     * whole container, and a stuck listing can be interrupted between
+     * two pages. "0" as "no-limit" is not understood by some servers,
+     * hence an explicit count. */
+    long l_startingIndex = 0;
+    long l_pageSize = BROWSE_PAGE_SIZE;
+
+    for( ;; )
     {
+        std::string StartingIndex = std::to_string( l_startingIndex );
+        std::string RequestedCount = std::to_string( l_pageSize );
+
         IXML_Document* p_response = _browseAction( m_psz_objectId,
                                                   "BrowseDirectChildren",
                                                   "*",
                                                   StartingIndex.c_str(),
-                                                  // Some servers don't understand "0" as "no-limit"
-                                                  RequestedCount.c_str(), /* RequestedCount */
+                                                  RequestedCount.c_str(),
                                                   "" /* SortCriteria */
                                                   );
         if ( !p_response )
         {
             msg_Err( m_access, "No response from browse() action" );
-            return false;
+            return l_startingIndex > 0;
         }
 
-        psz_TotalMatches = xml_getChildElementValue( (IXML_Element*)p_response, "TotalMatches" );
-        psz_NumberReturned = xml_getChildElementValue( (IXML_Element*)p_response, "NumberReturned" );
+        const char* psz_TotalMatches = xml_getChildElementValue( (IXML_Element*)p_response, "TotalMatches" );
+        const char* psz_NumberReturned = xml_getChildElementValue( (IXML_Element*)p_response, "NumberReturned" );
 
-        StartingIndex = std::to_string(  std::stol(psz_NumberReturned) + std::stol(StartingIndex) );
-        l_reqCount = std::stol(psz_TotalMatches) - std::stol(StartingIndex) ;
-        RequestedCount = std::to_string(l_reqCount);
+        long l_totalMatches = psz_TotalMatches ? atol( psz_TotalMatches ) : 0;
+        long l_numberReturned = psz_NumberReturned ? atol( psz_NumberReturned ) : 0;
 
         IXML_Document* p_result = parseBrowseResult( p_response );
 
@@ -1312,7 +1317,7 @@ bool MediaServer::fetchContents()
         if ( !p_result )
         {
             msg_Err( m_access, "browse() response parsing failed" );
-            return false;
+            return l_startingIndex > 0;
         }
 
 #ifndef NDEBUG
@@ -1339,8 +1344,20 @@ bool MediaServer::fetchContents()
         }
 
         ixmlDocument_free( p_result );
+
+        /* A server returning less than asked for, without advertising a
+         * total, has nothing left to send */
+        if ( l_numberReturned <= 0 ||
+             ( l_totalMatches <= 0 && l_numberReturned < l_pageSize ) )
+            break;
+
+        l_startingIndex += l_numberReturned;
+        if ( l_totalMatches > 0 && l_startingIndex >= l_totalMatches )
+            break;
+
+        if ( vlc_killed() )
+            break;
     }
-    while( l_reqCount );
     return true;
 }
 
@@ -78,6 +78,9 @@ struct private_sys_t
     uint8_t buffer[ 8192 ];
     bool b_seekable_source;
     bool b_seekable_archive;
+    bool b_stream_at_entry;
+
+    struct archive_cache_node* p_cache_node;
 
     libarchive_callback_t** pp_callback_data;
     size_t i_callback_data;
@@ -91,6 +94,224 @@ struct libarchive_callback_t {
 
 /* ------------------------------------------------------------------------- */
 
+/* Entry offset cache
+ *
+ * libarchive only exposes sequential header iteration, so locating entry N
+ * means parsing the N-1 headers before it, on every single open. Header
+ * positions encountered while browsing or scanning an archive are therefore
+ * remembered per source URL: a later open of a known entry seeks the source
+ * straight to its header and reads from there, without a scan. Positions are
+ * only meaningful - and only recorded - for single-volume archives without a
+ * compression filter on a seekable source. */
+
+struct archive_cache_entry
+{
+    char* psz_path;
+    uint64_t i_position;
+};
+
+struct archive_cache_node
+{
+    char* psz_url;
+    struct archive_cache_entry* p_entries;
+    size_t i_entries;
+    bool b_scanning;
+    struct archive_cache_node* p_next;
+};
+
+#define ARCHIVE_CACHE_MAX 8
+
+static struct
+{
+    vlc_mutex_t lock;
+    struct archive_cache_node* p_list;
+    size_t i_count;
+} offset_cache = { VLC_STATIC_MUTEX, NULL, 0 };
+
+static struct archive_cache_node* archive_cache_Find( const char* psz_url )
+{
+    for( struct archive_cache_node* p_node = offset_cache.p_list;
+         p_node; p_node = p_node->p_next )
+    {
+        if( strcmp( p_node->psz_url, psz_url ) == 0 )
+            return p_node;
+    }
+    return NULL;
+}
+
+/**
+ * Starts (re)recording entry positions of an archive.
+ *
+ * Any previously recorded positions for the URL are dropped, so that a
+ * rescan never duplicates them.
+ */
+static struct archive_cache_node* archive_cache_StartScan( const char* psz_url )
+{
+    vlc_mutex_lock( &offset_cache.lock );
+
+    struct archive_cache_node* p_node = archive_cache_Find( psz_url );
+    if( p_node )
+    {
+        if( p_node->b_scanning ) /* scanned concurrently, do not interfere */
+        {
+            vlc_mutex_unlock( &offset_cache.lock );
+            return NULL;
+        }
+
+        for( size_t i = 0; i < p_node->i_entries; ++i )
+            free( p_node->p_entries[i].psz_path );
+        free( p_node->p_entries );
+        p_node->p_entries = NULL;
+        p_node->i_entries = 0;
+        p_node->b_scanning = true;
+
+        vlc_mutex_unlock( &offset_cache.lock );
+        return p_node;
+    }
+
+    if( offset_cache.i_count >= ARCHIVE_CACHE_MAX )
+    {   /* evict the oldest idle archive */
+        struct archive_cache_node** pp_prev = &offset_cache.p_list;
+
+        for( struct archive_cache_node* p_victim = offset_cache.p_list;
+             p_victim; pp_prev = &p_victim->p_next, p_victim = p_victim->p_next )
+        {
+            if( p_victim->b_scanning || p_victim->p_next != NULL )
+                continue;
+
+            *pp_prev = NULL;
+            for( size_t i = 0; i < p_victim->i_entries; ++i )
+                free( p_victim->p_entries[i].psz_path );
+            free( p_victim->p_entries );
+            free( p_victim->psz_url );
+            free( p_victim );
+            offset_cache.i_count--;
+            break;
+        }
+    }
+
+    p_node = calloc( 1, sizeof( *p_node ) );
+    if( likely( p_node ) )
+    {
+        p_node->psz_url = strdup( psz_url );
+        if( unlikely( !p_node->psz_url ) )
+        {
+            free( p_node );
+            p_node = NULL;
+        }
+        else
+        {
+            p_node->b_scanning = true;
+            p_node->p_next = offset_cache.p_list;
+            offset_cache.p_list = p_node;
+            offset_cache.i_count++;
+        }
+    }
+
+    vlc_mutex_unlock( &offset_cache.lock );
+    return p_node;
+}
+
+static void archive_cache_Append( struct archive_cache_node* p_node,
+  const char* psz_path, uint64_t i_position )
+{
+    vlc_mutex_lock( &offset_cache.lock );
+
+    struct archive_cache_entry* p_entries = realloc( p_node->p_entries,
+      sizeof( *p_entries ) * ( p_node->i_entries + 1 ) );
+
+    if( likely( p_entries ) )
+    {
+        p_entries[ p_node->i_entries ].psz_path = strdup( psz_path );
+        p_entries[ p_node->i_entries ].i_position = i_position;
+
+        if( likely( p_entries[ p_node->i_entries ].psz_path ) )
+            p_node->i_entries++;
+        p_node->p_entries = p_entries;
+    }
+
+    vlc_mutex_unlock( &offset_cache.lock );
+}
+
+static void archive_cache_EndScan( struct archive_cache_node* p_node )
+{
+    vlc_mutex_lock( &offset_cache.lock );
+    p_node->b_scanning = false;
+    vlc_mutex_unlock( &offset_cache.lock );
+}
+
+/** Looks up the header position of an entry, UINT64_MAX if unknown */
+static uint64_t archive_cache_Lookup( const char* psz_url,
+  const char* psz_path )
+{
+    uint64_t i_position = UINT64_MAX;
+
+    if( psz_url == NULL )
+        return i_position;
+
+    vlc_mutex_lock( &offset_cache.lock );
+
+    struct archive_cache_node* p_node = archive_cache_Find( psz_url );
+    if( p_node )
+    {
+        for( size_t i = 0; i < p_node->i_entries; ++i )
+        {
+            if( strcmp( p_node->p_entries[i].psz_path, psz_path ) == 0 )
+            {
+                i_position = p_node->p_entries[i].i_position;
+                break;
+            }
+        }
+    }
+
+    vlc_mutex_unlock( &offset_cache.lock );
+    return i_position;
+}
+
+/**
+ * Starts recording entry positions, if they would be usable at all.
+ *
+ * Positions reported by libarchive are offsets within the (possibly
+ * decompressed, possibly concatenated) archive byte stream, so they only
+ * translate to source offsets for a plain single-volume archive. Opens
+ * started from a cached position must not record either, as their
+ * positions would be relative to the entry rather than the archive.
+ */
+static void archive_cache_BeginRecording( private_sys_t* p_sys )
+{
+    if( p_sys->b_stream_at_entry
+     || p_sys->i_callback_data != 1
+     || !p_sys->b_seekable_source
+     || p_sys->source->psz_url == NULL )
+        return;
+
+    if( archive_filter_code( p_sys->p_archive, 0 ) != ARCHIVE_FILTER_NONE )
+        return;
+
+    p_sys->p_cache_node = archive_cache_StartScan( p_sys->source->psz_url );
+}
+
+static void archive_cache_Record( private_sys_t* p_sys,
+  struct archive_entry* p_entry )
+{
+    la_int64_t i_position = archive_read_header_position( p_sys->p_archive );
+    char const* psz_path = archive_entry_pathname( p_entry );
+
+    if( i_position >= 0 && psz_path != NULL )
+        archive_cache_Append( p_sys->p_cache_node, psz_path, i_position );
+}
+
+static void archive_cache_EndRecording( private_sys_t* p_sys )
+{
+    if( p_sys->p_cache_node )
+    {
+        archive_cache_EndScan( p_sys->p_cache_node );
+        p_sys->p_cache_node = NULL;
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+
 static int libarchive_exit_cb( libarchive_t* p_arc, void* p_obj )
 {
     VLC_UNUSED( p_arc );
@@ -270,7 +491,12 @@ static int archive_init( private_sys_t* p_sys, stream_t* source )
         p_sys->b_seekable_source = false;
     }
 
-    if( p_sys->b_seekable_source )
+    /* When the source was positioned right at a cached entry header, the
+     * archive must be read strictly sequentially from there: with a seek
+     * callback installed, libarchive would jump around the whole archive
+     * (e.g. read the zip central directory) and scan for the entry anyway. */
+
+    if( p_sys->b_seekable_source && !p_sys->b_stream_at_entry )
     {
         if( archive_read_set_seek_callback( p_sys->p_archive,
             libarchive_seek_cb ) )
@@ -340,23 +566,40 @@ static int archive_seek_subentry( private_sys_t* p_sys, char const* psz_subentry
     struct archive_entry* entry;
     int archive_status;
 
+    archive_cache_BeginRecording( p_sys );
+
     while( !( archive_status = archive_read_next_header( p_arc, &entry ) ) )
     {
         char const* entry_path = archive_entry_pathname( entry );
 
+        if( p_sys->p_cache_node )
+            archive_cache_Record( p_sys, entry );
+
         if( strcmp( entry_path, psz_subentry ) == 0 )
         {
             p_sys->p_entry = archive_entry_clone( entry );
 
             if( unlikely( !p_sys->p_entry ) )
+            {
+                archive_cache_EndRecording( p_sys );
                 return VLC_ENOMEM;
+            }
+
+            break;
+        }
 
+        if( p_sys->b_stream_at_entry )
+        {   /* the cached position no longer matches this entry, bail out so
+             * that the caller falls back to a full scan */
+            archive_status = ARCHIVE_FATAL;
             break;
         }
 
         archive_read_data_skip( p_arc );
     }
 
+    archive_cache_EndRecording( p_sys );
+
     switch( archive_status )
     {
         case ARCHIVE_WARN:
@@ -387,6 +630,9 @@ static int archive_extractor_reset( stream_extractor_t* p_extractor )
 {
     private_sys_t* p_sys = p_extractor->p_sys;
 
+    /* a reset always reopens the whole archive, seeking and all */
+    p_sys->b_stream_at_entry = false;
+
     if( vlc_stream_Seek( p_extractor->source, 0 )
         || archive_clean( p_sys )
         || archive_init( p_sys, p_extractor->source )
@@ -531,6 +777,8 @@ static int ReadDir( stream_directory_t* p_directory, input_item_node_t* p_node )
     struct archive_entry* entry;
     int archive_status;
 
+    archive_cache_BeginRecording( p_sys );
+
     while( !( archive_status = archive_read_next_header( p_arc, &entry ) ) )
     {
         if( archive_entry_filetype( entry ) == AE_IFDIR )
@@ -541,6 +789,9 @@ static int ReadDir( stream_directory_t* p_directory, input_item_node_t* p_node )
         if( unlikely( !path ) )
             break;
 
+        if( p_sys->p_cache_node )
+            archive_cache_Record( p_sys, entry );
+
         char*       mrl  = vlc_stream_extractor_CreateMRL( p_directory, path );
 
         if( unlikely( !mrl ) )
@@ -569,6 +820,8 @@ static int ReadDir( stream_directory_t* p_directory, input_item_node_t* p_node )
             break;
     }
 
+    archive_cache_EndRecording( p_sys );
+
     vlc_readdir_helper_finish( &rdh, archive_status == ARCHIVE_EOF );
     return archive_status == ARCHIVE_EOF ? VLC_SUCCESS : VLC_EGENERIC;
 }
@@ -683,6 +936,7 @@ static int Seek( stream_extractor_t* p_extractor, uint64_t i_req )
 static void CommonClose( private_sys_t* p_sys )
 {
     p_sys->b_dead = true;
+    archive_cache_EndRecording( p_sys );
     archive_clean( p_sys );
 
     for( size_t i = 0; i < p_sys->i_callback_data; ++i )
@@ -707,7 +961,8 @@ static void ExtractorClose( vlc_object_t* p_obj )
     return CommonClose( p_extractor->p_sys );
 }
 
-static private_sys_t* CommonOpen( vlc_object_t* p_obj, stream_t* source  )
+static private_sys_t* CommonOpen( vlc_object_t* p_obj, stream_t* source,
+                                  bool b_stream_at_entry )
 {
     if( probe( source ) )
         return NULL;
@@ -717,6 +972,8 @@ static private_sys_t* CommonOpen( vlc_object_t* p_obj, stream_t* source  )
     if( p_sys == NULL )
         return NULL;
 
+    p_sys->b_stream_at_entry = b_stream_at_entry;
+
     if( archive_init( p_sys, source ) )
     {
         CommonClose( p_sys );
@@ -729,7 +986,7 @@ static private_sys_t* CommonOpen( vlc_object_t* p_obj, stream_t* source  )
 static int DirectoryOpen( vlc_object_t* p_obj )
 {
     stream_directory_t* p_directory = (void*)p_obj;
-    private_sys_t* p_sys = CommonOpen( p_obj, p_directory->source );
+    private_sys_t* p_sys = CommonOpen( p_obj, p_directory->source, false );
 
     if( p_sys == NULL )
         return VLC_EGENERIC;
@@ -743,15 +1000,43 @@ static int DirectoryOpen( vlc_object_t* p_obj )
 static int ExtractorOpen( vlc_object_t* p_obj )
 {
     stream_extractor_t* p_extractor = (void*)p_obj;
-    private_sys_t* p_sys = CommonOpen( p_obj, p_extractor->source );
+    private_sys_t* p_sys = NULL;
 
-    if( p_sys == NULL )
-        return VLC_EGENERIC;
+    /* If a previous browse or scan recorded where this entry lives, seek the
+     * source straight to its header and read sequentially from there,
+     * instead of scanning every preceding header. */
+
+    uint64_t i_position = archive_cache_Lookup( p_extractor->source->psz_url,
+                                                p_extractor->identifier );
 
-    if( archive_seek_subentry( p_sys, p_extractor->identifier ) )
+    if( i_position != UINT64_MAX
+     && vlc_stream_Seek( p_extractor->source, i_position ) == 0 )
     {
-        CommonClose( p_sys );
-        return VLC_EGENERIC;
+        p_sys = CommonOpen( p_obj, p_extractor->source, true );
+
+        if( p_sys != NULL
+         && archive_seek_subentry( p_sys, p_extractor->identifier ) )
+        {   /* stale position, e.g. the archive was modified */
+            CommonClose( p_sys );
+            p_sys = NULL;
+        }
+    }
+
+    if( p_sys == NULL )
+    {
+        if( vlc_stream_Seek( p_extractor->source, 0 ) )
+            return VLC_EGENERIC;
+
+        p_sys = CommonOpen( p_obj, p_extractor->source, false );
+
+        if( p_sys == NULL )
+            return VLC_EGENERIC;
+
+        if( archive_seek_subentry( p_sys, p_extractor->identifier ) )
+        {
+            CommonClose( p_sys );
+            return VLC_EGENERIC;
+        }
     }
 
     p_extractor->p_sys = p_sys;
@@ -65,7 +65,6 @@
  *
  *  TODO: - with access non seekable: use all space available for only one ring, but
  *          we have to support seekable/non-seekable switch on the fly.
- *        - compute a good value for i_read_size
  *        - ?
  */
 #define STREAM_READ_ATONCE 1024
@@ -103,6 +102,7 @@ typedef struct
         uint64_t i_read_count;
         uint64_t i_bytes;
         vlc_tick_t i_read_time;
+        vlc_tick_t i_latency; /* EWMA of a single read call duration */
     } stat;
 } stream_sys_t;
 
@@ -132,6 +132,8 @@ static int AStreamRefillStream(stream_t *s)
         if (vlc_killed())
             return VLC_EGENERIC;
 
+        vlc_tick_t before = vlc_tick_now();
+
         i_read = __MIN(i_toread, STREAM_CACHE_TRACK_SIZE - i_off);
         i_read = vlc_stream_Read(s->s, &tk->p_buffer[i_off], i_read);
 
@@ -143,6 +145,9 @@ static int AStreamRefillStream(stream_t *s)
         else if (i_read == 0)
             return VLC_SUCCESS;
 
+        sys->stat.i_latency +=
+            (vlc_tick_now() - before - sys->stat.i_latency) / 8;
+
         /* Update end */
         tk->i_end += i_read;
 
@@ -163,6 +168,21 @@ static int AStreamRefillStream(stream_t *s)
     }
 
     sys->stat.i_read_time += vlc_tick_now() - start;
+
+    /* Size reads to the bandwidth-delay product of the source, so that the
+     * per-request latency is amortized on high-latency links (HTTP on object
+     * storage) while local sources keep the small default */
+    if (sys->stat.i_read_time > 0)
+    {
+        uint64_t i_byterate = (CLOCK_FREQ * sys->stat.i_bytes) /
+                              sys->stat.i_read_time;
+        uint64_t i_bdp = (i_byterate * (uint64_t)sys->stat.i_latency) /
+                         CLOCK_FREQ;
+        uint64_t i_target = VLC_CLIP(i_bdp, STREAM_READ_ATONCE,
+                                     STREAM_CACHE_TRACK_SIZE / 8);
+
+        sys->i_read_size = (3 * (uint64_t)sys->i_read_size + i_target) / 4;
+    }
     return VLC_SUCCESS;
 }
 
@@ -278,8 +298,8 @@ static ssize_t AStreamReadStream(stream_t *s, void *buf, size_t len)
     if (tk->i_end + i_copy <= tk->i_start + sys->i_offset + len)
     {
         const size_t i_read_requested = VLC_CLIP(len - i_copy,
-                                                 STREAM_READ_ATONCE / 2,
-                                                 STREAM_READ_ATONCE * 10);
+                                                 sys->i_read_size / 2,
+                                                 (size_t)sys->i_read_size * 10);
         if (sys->i_used < i_read_requested)
             sys->i_used = i_read_requested;
 
@@ -396,7 +416,8 @@ static int AStreamSeekStream(stream_t *s, uint64_t i_pos)
             uint64_t i_skip = i_pos - tk->i_end;
             while (i_skip > 0)
             {
-                const int i_read_max = __MIN(10 * STREAM_READ_ATONCE, i_skip);
+                const int i_read_max = __MIN(10 * (uint64_t)sys->i_read_size,
+                                             i_skip);
                 int i_read = 0;
                 if ((i_read = AStreamReadStream(s, NULL, i_read_max)) < 0)
                 {
@@ -434,8 +455,8 @@ static int AStreamSeekStream(stream_t *s, uint64_t i_pos)
      */
     if (tk->i_end < tk->i_start + sys->i_offset + sys->i_read_size)
     {
-        if (sys->i_used < STREAM_READ_ATONCE / 2)
-            sys->i_used = STREAM_READ_ATONCE / 2;
+        if (sys->i_used < sys->i_read_size / 2)
+            sys->i_used = sys->i_read_size / 2;
 
         if (AStreamRefillStream(s))
             return VLC_EGENERIC;
@@ -505,6 +526,7 @@ static int Open(vlc_object_t *obj)
     sys->stat.i_bytes = 0;
     sys->stat.i_read_time = 0;
     sys->stat.i_read_count = 0;
+    sys->stat.i_latency = 0;
 
     msg_Dbg(s, "Using stream method for AStream*");
 
@@ -0,0 +1,530 @@
+/*****************************************************************************
+ * multiread.c: parallel ranged download stream filter
+ *****************************************************************************
+ * Copyright © 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vlc_common.h>
+#include <vlc_plugin.h>
+#include <vlc_stream.h>
+#include <vlc_list.h>
+#include <vlc_interrupt.h>
+
+/*
+ * A single connection caps throughput at one TCP window per round-trip.
+ * When the source is seekable without penalty and its size is known, this
+ * filter opens several independent connections to the same URL and fetches
+ * consecutive chunks in parallel, reassembling them in order for the reader.
+ */
+
+#define MAX_WORKERS 16
+
+typedef struct
+{
+    struct vlc_list node; /* in stream_sys_t.chunks, offset ascending */
+    uint64_t offset;
+    size_t   length; /* expected number of bytes */
+    size_t   filled; /* bytes fetched so far */
+    bool     error;
+    bool     zombie; /* discarded by a seek while being fetched */
+    uint8_t  data[];
+} chunk_t;
+
+struct worker
+{
+    stream_t        *stream; /* owner (for p_sys and logging) */
+    stream_t        *input;  /* private connection to the source URL */
+    vlc_thread_t     thread;
+    vlc_interrupt_t *interrupt;
+};
+
+typedef struct
+{
+    vlc_mutex_t lock;
+    vlc_cond_t  wait_data; /* reader waits for workers */
+    vlc_cond_t  wait_work; /* workers wait for the reader */
+
+    bool        error;
+    bool        paused;
+    bool        killed;
+
+    bool        can_pause;
+    bool        can_pace;
+    uint64_t    size;
+    vlc_tick_t  pts_delay;
+    char       *content_type;
+    size_t      chunk_size;
+
+    uint64_t    stream_offset; /* read position */
+    uint64_t    next_offset;   /* first byte not claimed by any chunk */
+    struct vlc_list chunks;    /* claimed chunks, offset ascending */
+    unsigned    chunk_count;
+    unsigned    max_chunks;
+
+    struct worker workers[MAX_WORKERS];
+    unsigned    worker_count;
+} stream_sys_t;
+
+static chunk_t *ChunkClaim(stream_sys_t *sys)
+{
+    assert(sys->next_offset < sys->size);
+
+    size_t length = __MIN(sys->chunk_size, sys->size - sys->next_offset);
+    chunk_t *chunk = malloc(sizeof (*chunk) + length);
+    if (unlikely(chunk == NULL))
+        return NULL;
+
+    chunk->offset = sys->next_offset;
+    chunk->length = length;
+    chunk->filled = 0;
+    chunk->error = false;
+    chunk->zombie = false;
+    /* Offsets are claimed monotonically, so appending keeps the order */
+    vlc_list_append(&chunk->node, &sys->chunks);
+    sys->chunk_count++;
+    sys->next_offset += length;
+    return chunk;
+}
+
+static void ChunkDelete(stream_sys_t *sys, chunk_t *chunk)
+{
+    vlc_list_remove(&chunk->node);
+    assert(sys->chunk_count > 0);
+    sys->chunk_count--;
+    free(chunk);
+}
+
+static void ChunkFetch(struct worker *w, chunk_t *chunk)
+{
+    stream_sys_t *sys = w->stream->p_sys;
+
+    vlc_mutex_unlock(&sys->lock);
+
+    bool error = vlc_stream_Seek(w->input, chunk->offset) != VLC_SUCCESS;
+
+    while (!error && chunk->filled < chunk->length)
+    {
+        if (vlc_killed())
+        {
+            error = true;
+            break;
+        }
+
+        ssize_t val = vlc_stream_ReadPartial(w->input,
+                                             chunk->data + chunk->filled,
+                                             chunk->length - chunk->filled);
+        if (val < 0)
+            continue;
+        if (val == 0)
+        {   /* The source is shorter than it claimed */
+            error = true;
+            break;
+        }
+
+        vlc_mutex_lock(&sys->lock);
+        if (chunk->zombie)
+        {   /* The reader sought away; drop the fetch */
+            ChunkDelete(sys, chunk);
+            return;
+        }
+        chunk->filled += val;
+        if (chunk->filled >= chunk->length)
+        {   /* Complete: ownership reverts to the list. The reader may
+             * delete the chunk as soon as the lock is dropped, so it must
+             * not be touched again past this block. */
+            vlc_cond_signal(&sys->wait_data);
+            return;
+        }
+        /* Data in the frontmost chunk is readable before it completes */
+        vlc_cond_signal(&sys->wait_data);
+        vlc_mutex_unlock(&sys->lock);
+    }
+
+    /* Only reachable with an incomplete chunk, which the reader never
+     * deletes: it is either zombie (then this worker owns it) or still
+     * listed as in progress. */
+    vlc_mutex_lock(&sys->lock);
+    if (chunk->zombie)
+    {
+        ChunkDelete(sys, chunk);
+        return;
+    }
+    assert(error);
+    chunk->error = true;
+    if (!vlc_killed())
+        msg_Err(w->stream, "cannot fetch range at %"PRIu64, chunk->offset);
+    vlc_cond_signal(&sys->wait_data);
+}
+
+static void *Worker(void *data)
+{
+    struct worker *w = data;
+    stream_sys_t *sys = w->stream->p_sys;
+
+    vlc_thread_set_name("vlc-multiread");
+    vlc_interrupt_set(w->interrupt);
+
+    vlc_mutex_lock(&sys->lock);
+    while (!sys->killed && !vlc_killed())
+    {
+        if (sys->paused || sys->error || sys->next_offset >= sys->size
+         || sys->chunk_count >= sys->max_chunks)
+        {
+            vlc_cond_wait(&sys->wait_work, &sys->lock);
+            continue;
+        }
+
+        chunk_t *chunk = ChunkClaim(sys);
+        if (unlikely(chunk == NULL))
+        {
+            sys->error = true;
+            vlc_cond_signal(&sys->wait_data);
+            break;
+        }
+
+        ChunkFetch(w, chunk);
+    }
+    /* Make sure the reader does not wait for this worker forever */
+    sys->error = true;
+    vlc_cond_signal(&sys->wait_data);
+    vlc_mutex_unlock(&sys->lock);
+    return NULL;
+}
+
+/**
+ * Finds the claimed chunk containing a given byte offset.
+ */
+static chunk_t *ChunkFind(stream_sys_t *sys, uint64_t offset)
+{
+    chunk_t *chunk;
+
+    vlc_list_foreach(chunk, &sys->chunks, node)
+        if (!chunk->zombie
+         && chunk->offset <= offset && offset < chunk->offset + chunk->length)
+            return chunk;
+    return NULL;
+}
+
+static ssize_t Read(stream_t *stream, void *buf, size_t buflen)
+{
+    stream_sys_t *sys = stream->p_sys;
+    size_t copy = 0;
+
+    if (buflen == 0)
+        return 0;
+
+    vlc_mutex_lock(&sys->lock);
+    for (;;)
+    {
+        if (sys->stream_offset >= sys->size)
+            break; /* EOF */
+
+        chunk_t *chunk = ChunkFind(sys, sys->stream_offset);
+        if (chunk != NULL)
+        {
+            if (chunk->error || sys->error)
+                break;
+
+            size_t skip = sys->stream_offset - chunk->offset;
+            if (chunk->filled > skip)
+            {
+                copy = __MIN(chunk->filled - skip, buflen);
+                memcpy(buf, chunk->data + skip, copy);
+                sys->stream_offset += copy;
+
+                /* Discard fully consumed chunks, making room for fetches */
+                if (sys->stream_offset == chunk->offset + chunk->length)
+                {
+                    ChunkDelete(sys, chunk);
+                    vlc_cond_signal(&sys->wait_work);
+                }
+                break;
+            }
+        }
+        else
+        {
+            if (sys->error)
+                break;
+            /* Wake a worker in case all of them are idle */
+            vlc_cond_signal(&sys->wait_work);
+        }
+
+        void *data[2];
+
+        /* Forward interruptions to a worker; it fails its fetch, sets the
+         * error flag and wakes us up. */
+        vlc_interrupt_forward_start(sys->workers[0].interrupt, data);
+        vlc_cond_wait(&sys->wait_data, &sys->lock);
+        vlc_interrupt_forward_stop(data);
+    }
+    vlc_mutex_unlock(&sys->lock);
+    return copy;
+}
+
+static int Seek(stream_t *stream, uint64_t offset)
+{
+    stream_sys_t *sys = stream->p_sys;
+    chunk_t *chunk;
+
+    vlc_mutex_lock(&sys->lock);
+    sys->stream_offset = offset;
+
+    if (ChunkFind(sys, offset) == NULL && offset < sys->size)
+    {   /* Discard the pipeline and restart claiming from the seek point.
+         * In-flight chunks are marked and freed by their worker. */
+        vlc_list_foreach(chunk, &sys->chunks, node)
+        {
+            if (chunk->zombie)
+                continue;
+            if (chunk->filled >= chunk->length || chunk->error)
+                ChunkDelete(sys, chunk);
+            else
+                chunk->zombie = true;
+        }
+        sys->next_offset = offset;
+    }
+    else
+    {   /* Seek within claimed data: just drop the chunks behind us */
+        vlc_list_foreach(chunk, &sys->chunks, node)
+        {
+            if (chunk->zombie || chunk->offset + chunk->length > offset)
+                continue;
+            if (chunk->filled >= chunk->length || chunk->error)
+                ChunkDelete(sys, chunk);
+            else
+                chunk->zombie = true;
+        }
+    }
+    vlc_cond_broadcast(&sys->wait_work);
+    vlc_mutex_unlock(&sys->lock);
+    return 0;
+}
+
+static int Control(stream_t *stream, int query, va_list args)
+{
+    stream_sys_t *sys = stream->p_sys;
+
+    switch (query)
+    {
+        case STREAM_CAN_SEEK:
+        case STREAM_CAN_FASTSEEK:
+            *va_arg(args, bool *) = true;
+            break;
+        case STREAM_CAN_PAUSE:
+            *va_arg(args, bool *) = sys->can_pause;
+            break;
+        case STREAM_CAN_CONTROL_PACE:
+            *va_arg(args, bool *) = sys->can_pace;
+            break;
+        case STREAM_GET_SIZE:
+            *va_arg(args, uint64_t *) = sys->size;
+            break;
+        case STREAM_GET_PTS_DELAY:
+            *va_arg(args, vlc_tick_t *) = sys->pts_delay;
+            break;
+        case STREAM_GET_CONTENT_TYPE:
+            if (sys->content_type == NULL)
+                return VLC_EGENERIC;
+            *va_arg(args, char **) = strdup(sys->content_type);
+            return VLC_SUCCESS;
+        case STREAM_SET_PAUSE_STATE:
+        {
+            bool paused = va_arg(args, unsigned);
+
+            vlc_mutex_lock(&sys->lock);
+            sys->paused = paused;
+            vlc_cond_broadcast(&sys->wait_work);
+            vlc_mutex_unlock(&sys->lock);
+            break;
+        }
+        case STREAM_GET_TITLE_INFO:
+        case STREAM_GET_TITLE:
+        case STREAM_GET_SEEKPOINT:
+        case STREAM_GET_META:
+        case STREAM_GET_SIGNAL:
+        case STREAM_GET_TAGS:
+        case STREAM_GET_TYPE:
+        case STREAM_SET_TITLE:
+        case STREAM_SET_SEEKPOINT:
+        case STREAM_SET_PRIVATE_ID_STATE:
+        case STREAM_SET_PRIVATE_ID_CA:
+        case STREAM_GET_PRIVATE_ID_STATE:
+            return VLC_EGENERIC;
+        default:
+            msg_Err(stream, "unimplemented query (%d) in control", query);
+            return VLC_EGENERIC;
+    }
+    return VLC_SUCCESS;
+}
+
+static int Open(vlc_object_t *obj)
+{
+    stream_t *stream = (stream_t *)obj;
+    bool fast_seek;
+
+    if (vlc_stream_Control(stream->s, STREAM_CAN_FASTSEEK, &fast_seek))
+        return VLC_EGENERIC; /* not a byte stream */
+    if (!fast_seek)
+        return VLC_EGENERIC;
+
+    /* Parallel ranges only pay off against remote servers. Local files seek
+     * fast too, but the operating system already reads them ahead, and extra
+     * file descriptors would buy nothing. */
+    if (stream->psz_url == NULL
+     || (strncasecmp(stream->psz_url, "http://", 7) != 0
+      && strncasecmp(stream->psz_url, "https://", 8) != 0))
+        return VLC_EGENERIC;
+
+    int64_t conns = var_InheritInteger(obj, "multiread-connections");
+    if (conns < 2)
+        return VLC_EGENERIC; /* disabled */
+    if (conns > MAX_WORKERS)
+        conns = MAX_WORKERS;
+
+    uint64_t size;
+    if (vlc_stream_Control(stream->s, STREAM_GET_SIZE, &size) || size == 0)
+        return VLC_EGENERIC; /* cannot issue ranges without a known size */
+
+    size_t chunk_size = var_InheritInteger(obj, "multiread-chunk-size") << 10u;
+    if (size <= chunk_size)
+        return VLC_EGENERIC; /* too small to split */
+
+    stream_sys_t *sys = calloc(1, sizeof (*sys));
+    if (unlikely(sys == NULL))
+        return VLC_ENOMEM;
+
+    sys->size = size;
+    sys->chunk_size = chunk_size;
+    sys->max_chunks = 2 * conns;
+    vlc_stream_Control(stream->s, STREAM_CAN_PAUSE, &sys->can_pause);
+    vlc_stream_Control(stream->s, STREAM_CAN_CONTROL_PACE, &sys->can_pace);
+    vlc_stream_Control(stream->s, STREAM_GET_PTS_DELAY, &sys->pts_delay);
+    if (vlc_stream_Control(stream->s, STREAM_GET_CONTENT_TYPE,
+                           &sys->content_type))
+        sys->content_type = NULL;
+
+    vlc_list_init(&sys->chunks);
+    vlc_mutex_init(&sys->lock);
+    vlc_cond_init(&sys->wait_data);
+    vlc_cond_init(&sys->wait_work);
+
+    stream->p_sys = sys;
+
+    for (unsigned i = 0; i < (unsigned)conns; i++)
+    {
+        struct worker *w = &sys->workers[i];
+
+        w->stream = stream;
+        w->input = vlc_stream_NewURL(obj, stream->psz_url);
+        if (w->input == NULL)
+            goto error;
+
+        w->interrupt = vlc_interrupt_create();
+        if (unlikely(w->interrupt == NULL))
+        {
+            vlc_stream_Delete(w->input);
+            goto error;
+        }
+
+        if (vlc_clone(&w->thread, Worker, w))
+        {
+            vlc_interrupt_destroy(w->interrupt);
+            vlc_stream_Delete(w->input);
+            goto error;
+        }
+        sys->worker_count++;
+    }
+
+    msg_Dbg(stream, "using %u connections, %zu KiB chunks",
+            sys->worker_count, sys->chunk_size >> 10u);
+    stream->pf_read = Read;
+    stream->pf_seek = Seek;
+    stream->pf_control = Control;
+    return VLC_SUCCESS;
+
+error:
+    vlc_mutex_lock(&sys->lock);
+    sys->killed = true;
+    vlc_cond_broadcast(&sys->wait_work);
+    vlc_mutex_unlock(&sys->lock);
+
+    for (unsigned i = 0; i < sys->worker_count; i++)
+    {
+        struct worker *w = &sys->workers[i];
+
+        vlc_interrupt_kill(w->interrupt);
+        vlc_join(w->thread, NULL);
+        vlc_interrupt_destroy(w->interrupt);
+        vlc_stream_Delete(w->input);
+    }
+    free(sys->content_type);
+    free(sys);
+    return VLC_EGENERIC;
+}
+
+static void Close(vlc_object_t *obj)
+{
+    stream_t *stream = (stream_t *)obj;
+    stream_sys_t *sys = stream->p_sys;
+    chunk_t *chunk;
+
+    vlc_mutex_lock(&sys->lock);
+    sys->killed = true;
+    vlc_cond_broadcast(&sys->wait_work);
+    vlc_mutex_unlock(&sys->lock);
+
+    for (unsigned i = 0; i < sys->worker_count; i++)
+    {
+        struct worker *w = &sys->workers[i];
+
+        vlc_interrupt_kill(w->interrupt);
+        vlc_join(w->thread, NULL);
+        vlc_interrupt_destroy(w->interrupt);
+        vlc_stream_Delete(w->input);
+    }
+
+    vlc_list_foreach(chunk, &sys->chunks, node)
+        ChunkDelete(sys, chunk);
+
+    free(sys->content_type);
+    free(sys);
+}
+
+vlc_module_begin()
+    set_subcategory(SUBCAT_INPUT_STREAM_FILTER)
+    set_capability("stream_filter", 0)
+    add_shortcut("multiread")
+
+    set_description(N_("Parallel range download filter"))
+    set_callbacks(Open, Close)
+
+    add_integer("multiread-connections", 0, N_("Parallel connections"),
+                N_("Number of parallel connections for ranged downloads "
+                   "(0 or 1 to disable)"))
+        change_integer_range(0, MAX_WORKERS)
+    add_integer("multiread-chunk-size", 1 << 12, N_("Chunk size"),
+                N_("Range request chunk size (KiB)"))
+        change_integer_range(64, 1 << 18)
+vlc_module_end()
@@ -31,7 +31,9 @@
 #include <vlc_plugin.h>
 
 #include <assert.h>
+#include <stdatomic.h>
 #include <vlc_stream.h>
+#include <vlc_block.h>
 #include <vlc_input_item.h>
 #include <vlc_fs.h>
 
@@ -42,20 +44,62 @@
 static int  Open ( vlc_object_t * );
 static void Close( vlc_object_t * );
 
+#define ROTATE_SIZE_TEXT N_("Record file size limit (MiB)")
+#define ROTATE_SIZE_LONGTEXT N_( \
+    "Start a new record file once the current one reaches this size, " \
+    "in mebibytes. 0 disables size based rotation." )
+#define ROTATE_TIME_TEXT N_("Record file duration limit (seconds)")
+#define ROTATE_TIME_LONGTEXT N_( \
+    "Start a new record file once the current one is older than this " \
+    "duration, in seconds. 0 disables time based rotation." )
+
 vlc_module_begin()
     set_subcategory( SUBCAT_INPUT_STREAM_FILTER )
     set_description( N_("Internal stream record") )
     set_capability( "stream_filter", 0 )
     set_callbacks( Open, Close )
+    add_integer( "record-rotate-size", 0, ROTATE_SIZE_TEXT,
+                 ROTATE_SIZE_LONGTEXT )
+    add_integer( "record-rotate-time", 0, ROTATE_TIME_TEXT,
+                 ROTATE_TIME_LONGTEXT )
 vlc_module_end()
 
 /*****************************************************************************
  *
  *****************************************************************************/
+
+/* Maximum number of bytes queued to the writer thread. Data read while the
+ * queue is full is dropped from the record (never from playback). */
+#define RECORD_QUEUE_MAX (16 * 1024 * 1024)
+
 typedef struct
 {
-    FILE *f;        /* TODO it could be replaced by access_output_t one day */
-    bool b_error;
+    /* Set when recording, read lock-free on the input thread */
+    atomic_bool b_recording;
+
+    vlc_thread_t thread;
+
+    vlc_mutex_t lock;
+    vlc_cond_t  wait;
+    /* Queue of pending blocks, guarded by lock */
+    block_t  *p_first;
+    block_t **pp_last;
+    size_t    i_queued;   /* Bytes currently queued */
+    uint64_t  i_dropped;  /* Bytes dropped on queue overflow */
+    bool      b_drop;     /* Currently dropping (for begin/end logging) */
+    bool      b_stop;
+
+    /* Writer thread only */
+    FILE      *f;          /* TODO it could be replaced by access_output_t one day */
+    bool       b_error;
+    uint64_t   i_file_size;
+    vlc_tick_t i_file_date;
+
+    /* Configuration, set at Start() */
+    char      *psz_dir_path;
+    char      *psz_extension;
+    uint64_t   i_rotate_size;    /* Bytes, 0 to disable */
+    vlc_tick_t i_rotate_time;    /* 0 to disable */
 } stream_sys_t;
 
 
@@ -68,7 +112,8 @@ static int  Control( stream_t *, int i_query, va_list );
 
 static int  Start  ( stream_t *, const char *dir_path, const char *psz_extension );
 static int  Stop   ( stream_t * );
-static void Write  ( stream_t *, const uint8_t *p_buffer, size_t i_buffer );
+static void Enqueue( stream_t *, const uint8_t *p_buffer, size_t i_buffer );
+static void *Thread( void * );
 
 /****************************************************************************
  * Open
@@ -83,6 +128,9 @@ static int Open ( vlc_object_t *p_this )
     if( !p_sys )
         return VLC_ENOMEM;
 
+    atomic_init( &p_sys->b_recording, false );
+    vlc_mutex_init( &p_sys->lock );
+    vlc_cond_init( &p_sys->wait );
     p_sys->f = NULL;
 
     /* */
@@ -101,7 +149,7 @@ static void Close( vlc_object_t *p_this )
     stream_t *s = (stream_t*)p_this;
     stream_sys_t *p_sys = s->p_sys;
 
-    if( p_sys->f )
+    if( atomic_load( &p_sys->b_recording ) )
         Stop( s );
 
     free( p_sys );
@@ -116,11 +164,11 @@ static ssize_t Read( stream_t *s, void *p_read, size_t i_read )
     void *p_record = p_read;
     const ssize_t i_record = vlc_stream_Read( s->s, p_record, i_read );
 
-    /* Dump read data */
-    if( p_sys->f )
+    /* Queue read data to the writer thread */
+    if( atomic_load_explicit( &p_sys->b_recording, memory_order_relaxed ) )
     {
         if( p_record && i_record > 0 )
-            Write( s, p_record, i_record );
+            Enqueue( s, p_record, i_record );
     }
 
     return i_record;
@@ -145,7 +193,7 @@ static int Control( stream_t *s, int i_query, va_list args )
         psz_extension = va_arg( args, const char* );
     }
 
-    if( !sys->f == !b_active )
+    if( atomic_load( &sys->b_recording ) == b_active )
         return VLC_SUCCESS;
 
     if( b_active )
@@ -169,12 +217,45 @@ static void set_record_file_var(vlc_object_t *obj, const char *file)
 /****************************************************************************
  * Helpers
  ****************************************************************************/
-static int Start( stream_t *s, const char *dir_path, const char *psz_extension )
+
+/* Open the (initial or rotated) record file. Called without the lock held,
+ * from the input thread at Start() and from the writer thread on rotation. */
+static int OpenFile( stream_t *s )
 {
     stream_sys_t *p_sys = s->p_sys;
 
-    char *psz_file;
-    FILE *f;
+    /* Create file name
+     * TODO allow prefix configuration */
+    char *psz_file = input_item_CreateFilename( s->p_input_item,
+                                                p_sys->psz_dir_path,
+                                                INPUT_RECORD_PREFIX,
+                                                p_sys->psz_extension );
+    if( !psz_file )
+        return VLC_ENOMEM;
+
+    FILE *f = vlc_fopen( psz_file, "wb" );
+    if( !f )
+    {
+        free( psz_file );
+        return VLC_EGENERIC;
+    }
+
+    /* signal new record file */
+    set_record_file_var(VLC_OBJECT(s), psz_file);
+
+    msg_Dbg( s, "Recording into %s", psz_file );
+    free( psz_file );
+
+    p_sys->f = f;
+    p_sys->b_error = false;
+    p_sys->i_file_size = 0;
+    p_sys->i_file_date = vlc_tick_now();
+    return VLC_SUCCESS;
+}
+
+static int Start( stream_t *s, const char *dir_path, const char *psz_extension )
+{
+    stream_sys_t *p_sys = s->p_sys;
 
     /* */
     if( !psz_extension )
@@ -193,58 +274,139 @@ static int Start( stream_t *s, const char *dir_path, const char *psz_extension )
     if( dir_path == NULL )
         return VLC_ENOMEM;
 
-    /* Create file name
-     * TODO allow prefix configuration */
-    psz_file = input_item_CreateFilename( s->p_input_item, dir_path,
-                                          INPUT_RECORD_PREFIX, psz_extension );
-
+    p_sys->psz_dir_path = strdup( dir_path );
+    p_sys->psz_extension = strdup( psz_extension );
     free( psz_path );
+    if( !p_sys->psz_dir_path || !p_sys->psz_extension )
+        goto error;
 
-    if( !psz_file )
-        return VLC_ENOMEM;
+    p_sys->i_rotate_size =
+        (uint64_t)var_InheritInteger( s, "record-rotate-size" ) << 20;
+    p_sys->i_rotate_time =
+        VLC_TICK_FROM_SEC( var_InheritInteger( s, "record-rotate-time" ) );
 
-    f = vlc_fopen( psz_file, "wb" );
-    if( !f )
+    if( OpenFile( s ) )
+        goto error;
+
+    /* */
+    p_sys->p_first = NULL;
+    p_sys->pp_last = &p_sys->p_first;
+    p_sys->i_queued = 0;
+    p_sys->i_dropped = 0;
+    p_sys->b_drop = false;
+    p_sys->b_stop = false;
+
+    if( vlc_clone( &p_sys->thread, Thread, s ) )
     {
-        free( psz_file );
-        return VLC_EGENERIC;
+        fclose( p_sys->f );
+        p_sys->f = NULL;
+        goto error;
     }
 
-    /* signal new record file */
-    set_record_file_var(VLC_OBJECT(s), psz_file);
-
-    msg_Dbg( s, "Recording into %s", psz_file );
-    free( psz_file );
-
-    /* */
-    p_sys->f = f;
-    p_sys->b_error = false;
+    atomic_store( &p_sys->b_recording, true );
     return VLC_SUCCESS;
+
+error:
+    free( p_sys->psz_dir_path );
+    free( p_sys->psz_extension );
+    p_sys->psz_dir_path = p_sys->psz_extension = NULL;
+    return VLC_EGENERIC;
 }
+
 static int Stop( stream_t *s )
 {
     stream_sys_t *p_sys = s->p_sys;
 
-    assert( p_sys->f );
+    assert( atomic_load( &p_sys->b_recording ) );
+    atomic_store( &p_sys->b_recording, false );
+
+    /* The writer drains the queue before exiting */
+    vlc_mutex_lock( &p_sys->lock );
+    p_sys->b_stop = true;
+    vlc_cond_signal( &p_sys->wait );
+    vlc_mutex_unlock( &p_sys->lock );
+    vlc_join( p_sys->thread, NULL );
 
+    if( p_sys->i_dropped > 0 )
+        msg_Warn( s, "Recording dropped %"PRIu64" bytes (writer too slow)",
+                  p_sys->i_dropped );
     msg_Dbg( s, "Recording completed" );
-    fclose( p_sys->f );
-    p_sys->f = NULL;
+
+    if( p_sys->f )
+    {
+        fclose( p_sys->f );
+        p_sys->f = NULL;
+    }
+    free( p_sys->psz_dir_path );
+    free( p_sys->psz_extension );
+    p_sys->psz_dir_path = p_sys->psz_extension = NULL;
     return VLC_SUCCESS;
 }
 
-static void Write( stream_t *s, const uint8_t *p_buffer, size_t i_buffer )
+/* Queue a copy of the read data, never blocking the input thread: on
+ * overflow, the data is dropped from the record and accounted for */
+static void Enqueue( stream_t *s, const uint8_t *p_buffer, size_t i_buffer )
 {
     stream_sys_t *p_sys = s->p_sys;
 
-    assert( p_sys->f );
+    if( i_buffer == 0 )
+        return;
+
+    block_t *p_block = block_Alloc( i_buffer );
 
-    if( i_buffer > 0 )
+    vlc_mutex_lock( &p_sys->lock );
+    if( unlikely(p_block == NULL)
+     || p_sys->i_queued + i_buffer > RECORD_QUEUE_MAX )
+    {
+        p_sys->i_dropped += i_buffer;
+        if( !p_sys->b_drop )
+        {
+            p_sys->b_drop = true;
+            msg_Warn( s, "Failed to record data (begin): writer too slow" );
+        }
+        vlc_mutex_unlock( &p_sys->lock );
+        if( p_block )
+            block_Release( p_block );
+        return;
+    }
+    if( p_sys->b_drop )
+    {
+        p_sys->b_drop = false;
+        msg_Warn( s, "Failed to record data (end)" );
+    }
+
+    memcpy( p_block->p_buffer, p_buffer, i_buffer );
+    block_ChainLastAppend( &p_sys->pp_last, p_block );
+    p_sys->i_queued += i_buffer;
+    vlc_cond_signal( &p_sys->wait );
+    vlc_mutex_unlock( &p_sys->lock );
+}
+
+/* Writer thread side: dump one block, rotating the file when configured */
+static void WriteBlock( stream_t *s, block_t *p_block )
+{
+    stream_sys_t *p_sys = s->p_sys;
+
+    if( ( p_sys->i_rotate_size != 0
+       && p_sys->i_file_size + p_block->i_buffer > p_sys->i_rotate_size )
+     || ( p_sys->i_rotate_time != 0
+       && vlc_tick_now() - p_sys->i_file_date >= p_sys->i_rotate_time ) )
+    {
+        if( p_sys->f )
+            fclose( p_sys->f );
+        p_sys->f = NULL;
+        if( OpenFile( s ) )
+            msg_Err( s, "Failed to rotate record file" );
+    }
+
+    if( p_sys->f )
     {
         const bool b_previous_error = p_sys->b_error;
-        const size_t i_written = fwrite( p_buffer, 1, i_buffer, p_sys->f );
+        const size_t i_written =
+            fwrite( p_block->p_buffer, 1, p_block->i_buffer, p_sys->f );
 
-        p_sys->b_error = i_written != i_buffer;
+        p_sys->b_error = i_written != p_block->i_buffer;
+        p_sys->i_file_size += i_written;
 
         /* TODO maybe a intf_UserError or something like that ? */
         if( p_sys->b_error && !b_previous_error )
@@ -252,4 +414,41 @@ static void Write( stream_t *s, const uint8_t *p_buffer, size_t i_buffer )
         else if( !p_sys->b_error && b_previous_error )
             msg_Err( s, "Failed to record data (end)" );
     }
+
+    block_Release( p_block );
+}
+
+static void *Thread( void *data )
+{
+    stream_t *s = data;
+    stream_sys_t *p_sys = s->p_sys;
+
+    vlc_mutex_lock( &p_sys->lock );
+    for( ;; )
+    {
+        while( p_sys->p_first == NULL && !p_sys->b_stop )
+            vlc_cond_wait( &p_sys->wait, &p_sys->lock );
+
+        if( p_sys->p_first == NULL )
+            break; /* Stopped and drained */
+
+        block_t *p_chain = p_sys->p_first;
+        p_sys->p_first = NULL;
+        p_sys->pp_last = &p_sys->p_first;
+        p_sys->i_queued = 0;
+        vlc_mutex_unlock( &p_sys->lock );
+
+        while( p_chain != NULL )
+        {
+            block_t *p_block = p_chain;
+            p_chain = p_block->p_next;
+            p_block->p_next = NULL;
+
+            WriteBlock( s, p_block );
+        }
+
+        vlc_mutex_lock( &p_sys->lock );
+    }
+    vlc_mutex_unlock( &p_sys->lock );
+    return NULL;
 }
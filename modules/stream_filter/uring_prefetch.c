@@ -0,0 +1,383 @@
+/*****************************************************************************
+ * uring_prefetch.c: io_uring read-ahead for local files
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <liburing.h>
+
+#include <vlc_common.h>
+#include <vlc_plugin.h>
+#include <vlc_stream.h>
+#include <vlc_fs.h>
+
+/* Unlike the prefetch filter, which serializes blocking reads on a worker
+ * thread, this filter keeps several read requests queued in the kernel at
+ * once, so that storage latency overlaps with demuxing. It reads from its
+ * own file descriptor and therefore only applies directly on top of a plain
+ * local file access. */
+
+struct uring_slot
+{
+    unsigned char *buffer;
+    uint64_t       offset;  /* file offset covered by this request */
+    size_t         length;  /* bytes requested */
+    ssize_t        result;  /* read(2)-style result, valid once ready */
+    bool           pending; /* submitted, completion not yet reaped */
+    bool           ready;   /* completion reaped */
+};
+
+typedef struct
+{
+    struct io_uring    ring;
+    int                fd;
+    uint64_t           size;          /* file size (clamped on short read) */
+    uint64_t           offset;        /* downstream read position */
+    uint64_t           submit_offset; /* next chunk to queue */
+    size_t             chunk;         /* bytes per request */
+    unsigned           depth;         /* slot count == queue depth */
+    unsigned           head;          /* slot owning the lowest queued chunk */
+    unsigned           queued;        /* slots in flight or ready */
+    struct uring_slot *slots;
+} stream_sys_t;
+
+/**
+ * Queues read requests until the submission window is full or the end of
+ * file is reached, then submits them in one system call.
+ */
+static void PipelineFill(stream_t *stream)
+{
+    stream_sys_t *sys = stream->p_sys;
+    unsigned submitted = 0;
+
+    while (sys->queued < sys->depth && sys->submit_offset < sys->size)
+    {
+        struct io_uring_sqe *sqe = io_uring_get_sqe(&sys->ring);
+        if (sqe == NULL)
+            break; /* submission ring full - should not happen */
+
+        unsigned idx = (sys->head + sys->queued) % sys->depth;
+        struct uring_slot *slot = &sys->slots[idx];
+        size_t length = sys->chunk;
+
+        if (length > sys->size - sys->submit_offset)
+            length = sys->size - sys->submit_offset;
+
+        slot->offset = sys->submit_offset;
+        slot->length = length;
+        slot->pending = true;
+        slot->ready = false;
+        io_uring_prep_read(sqe, sys->fd, slot->buffer, length, slot->offset);
+        io_uring_sqe_set_data64(sqe, idx);
+
+        sys->submit_offset += length;
+        sys->queued++;
+        submitted++;
+    }
+
+    if (submitted > 0)
+        io_uring_submit(&sys->ring);
+}
+
+static void ReapCompletion(stream_sys_t *sys, struct io_uring_cqe *cqe)
+{
+    struct uring_slot *slot = &sys->slots[io_uring_cqe_get_data64(cqe)];
+
+    assert(slot->pending);
+    slot->result = cqe->res;
+    slot->pending = false;
+    slot->ready = true;
+    io_uring_cqe_seen(&sys->ring, cqe);
+}
+
+/**
+ * Drains already available completions, then waits for the head slot
+ * if requested and still in flight.
+ */
+static int PipelineReap(stream_t *stream, bool wait)
+{
+    stream_sys_t *sys = stream->p_sys;
+    struct io_uring_cqe *cqe;
+
+    while (io_uring_peek_cqe(&sys->ring, &cqe) == 0)
+        ReapCompletion(sys, cqe);
+
+    while (wait && sys->queued > 0 && sys->slots[sys->head].pending)
+    {
+        int val = io_uring_wait_cqe(&sys->ring, &cqe);
+        if (val != 0)
+        {
+            if (val == -EINTR)
+                continue;
+            msg_Err(stream, "cannot wait for completion: %s",
+                    vlc_strerror_c(-val));
+            return VLC_EGENERIC;
+        }
+        ReapCompletion(sys, cqe);
+    }
+    return VLC_SUCCESS;
+}
+
+/**
+ * Waits out every in-flight request so that all slots can be requeued.
+ */
+static void PipelineDrain(stream_t *stream)
+{
+    stream_sys_t *sys = stream->p_sys;
+
+    for (unsigned i = 0; i < sys->depth; i++)
+    {
+        struct uring_slot *slot = &sys->slots[i];
+
+        while (slot->pending)
+        {
+            struct io_uring_cqe *cqe;
+            int val = io_uring_wait_cqe(&sys->ring, &cqe);
+
+            if (val != 0)
+            {
+                if (val == -EINTR)
+                    continue;
+                msg_Err(stream, "cannot drain completions: %s",
+                        vlc_strerror_c(-val));
+                return;
+            }
+            ReapCompletion(sys, cqe);
+        }
+        slot->ready = false;
+    }
+    sys->queued = 0;
+}
+
+static ssize_t Read(stream_t *stream, void *buf, size_t buflen)
+{
+    stream_sys_t *sys = stream->p_sys;
+
+    if (buflen == 0 || sys->offset >= sys->size)
+        return 0;
+
+    PipelineFill(stream);
+
+    struct uring_slot *slot;
+    for (;;)
+    {
+        if (sys->queued == 0)
+            return 0;
+        if (PipelineReap(stream, true) != VLC_SUCCESS)
+            return 0;
+
+        slot = &sys->slots[sys->head];
+        if (slot->result < 0)
+        {
+            msg_Err(stream, "read error: %s", vlc_strerror_c(-slot->result));
+            return 0;
+        }
+        if (slot->result == 0)
+        {   /* File truncated behind our back */
+            sys->size = slot->offset;
+            return 0;
+        }
+        if (sys->offset < slot->offset + (uint64_t)slot->result)
+            break;
+
+        /* Head slot fully consumed (or skipped by a forward seek) */
+        slot->ready = false;
+        sys->head = (sys->head + 1) % sys->depth;
+        sys->queued--;
+
+        if ((size_t)slot->result < slot->length)
+        {   /* Mid-file short read: the following slots were issued on the
+             * assumption of a full-length result and no longer line up
+             * with the read position. Restart the pipeline there. */
+            PipelineDrain(stream);
+            sys->head = 0;
+            sys->submit_offset = sys->offset - (sys->offset % sys->chunk);
+        }
+        PipelineFill(stream);
+    }
+
+    assert(sys->offset >= slot->offset);
+
+    size_t skip = sys->offset - slot->offset;
+    size_t copy = slot->result - skip;
+    if (copy > buflen)
+        copy = buflen;
+
+    memcpy(buf, slot->buffer + skip, copy);
+    sys->offset += copy;
+    return copy;
+}
+
+static int Seek(stream_t *stream, uint64_t offset)
+{
+    stream_sys_t *sys = stream->p_sys;
+
+    /* Within the queued window, already fetched data stays valid and Read()
+     * skips over it. Otherwise restart the pipeline at the target. */
+    if (sys->queued == 0 || offset < sys->slots[sys->head].offset
+     || offset >= sys->submit_offset)
+    {
+        PipelineDrain(stream);
+        sys->head = 0;
+        sys->submit_offset = offset - (offset % sys->chunk);
+    }
+
+    sys->offset = offset;
+    return 0;
+}
+
+static int Control(stream_t *stream, int query, va_list args)
+{
+    stream_sys_t *sys = stream->p_sys;
+
+    switch (query)
+    {
+        case STREAM_CAN_SEEK:
+        case STREAM_CAN_FASTSEEK:
+            *va_arg(args, bool *) = true;
+            break;
+        case STREAM_GET_SIZE:
+            *va_arg(args, uint64_t *) = sys->size;
+            break;
+        default:
+            return vlc_stream_vaControl(stream->s, query, args);
+    }
+    return VLC_SUCCESS;
+}
+
+static int Open(vlc_object_t *obj)
+{
+    stream_t *stream = (stream_t *)obj;
+
+    if (!var_InheritBool(obj, "uring-prefetch"))
+        return VLC_EGENERIC;
+
+    /* Only applicable straight on top of the access: any stream filter
+     * below would transform the byte stream, and reading the file directly
+     * would bypass it. This also keeps the filter from stacking onto
+     * itself. */
+    if (stream->s->s != NULL || stream->psz_filepath == NULL)
+        return VLC_EGENERIC;
+
+    int fd = vlc_open(stream->psz_filepath, O_RDONLY | O_NONBLOCK);
+    if (fd == -1)
+        return VLC_EGENERIC;
+
+    struct stat st;
+    if (fstat(fd, &st) || !S_ISREG(st.st_mode) || st.st_size <= 0)
+    {
+        vlc_close(fd);
+        return VLC_EGENERIC;
+    }
+
+    stream_sys_t *sys = malloc(sizeof (*sys));
+    if (unlikely(sys == NULL))
+    {
+        vlc_close(fd);
+        return VLC_ENOMEM;
+    }
+
+    sys->fd = fd;
+    sys->size = st.st_size;
+    sys->offset = 0;
+    sys->submit_offset = 0;
+    sys->chunk = var_InheritInteger(obj, "uring-prefetch-buffer-size") << 10u;
+    sys->depth = var_InheritInteger(obj, "uring-prefetch-depth");
+    sys->head = 0;
+    sys->queued = 0;
+
+    sys->slots = calloc(sys->depth, sizeof (*sys->slots));
+    if (sys->slots == NULL)
+        goto error;
+
+    for (unsigned i = 0; i < sys->depth; i++)
+    {
+        sys->slots[i].buffer = malloc(sys->chunk);
+        if (sys->slots[i].buffer == NULL)
+            goto error;
+    }
+
+    int val = io_uring_queue_init(sys->depth, &sys->ring, 0);
+    if (val != 0)
+    {
+        msg_Dbg(stream, "cannot create io_uring queue: %s",
+                vlc_strerror_c(-val));
+        goto error;
+    }
+
+    msg_Dbg(stream, "using %u requests of %zu bytes", sys->depth, sys->chunk);
+    stream->p_sys = sys;
+    stream->pf_read = Read;
+    stream->pf_seek = Seek;
+    stream->pf_control = Control;
+    return VLC_SUCCESS;
+
+error:
+    if (sys->slots != NULL)
+        for (unsigned i = 0; i < sys->depth; i++)
+            free(sys->slots[i].buffer);
+    free(sys->slots);
+    free(sys);
+    vlc_close(fd);
+    return VLC_EGENERIC;
+}
+
+static void Close(vlc_object_t *obj)
+{
+    stream_t *stream = (stream_t *)obj;
+    stream_sys_t *sys = stream->p_sys;
+
+    PipelineDrain(stream);
+    io_uring_queue_exit(&sys->ring);
+    vlc_close(sys->fd);
+
+    for (unsigned i = 0; i < sys->depth; i++)
+        free(sys->slots[i].buffer);
+    free(sys->slots);
+    free(sys);
+}
+
+vlc_module_begin()
+    set_subcategory(SUBCAT_INPUT_STREAM_FILTER)
+    set_capability("stream_filter", 0)
+
+    set_description(N_("io_uring stream prefetch filter"))
+    set_callbacks(Open, Close)
+
+    add_bool("uring-prefetch", false, N_("io_uring prefetching"),
+             N_("Read ahead on local files with asynchronous io_uring "
+                "requests instead of relying on kernel readahead"))
+    add_integer("uring-prefetch-depth", 8, N_("Queue depth"),
+                N_("Number of read requests kept in flight"))
+        change_integer_range(1, 64)
+    add_integer("uring-prefetch-buffer-size", 256, N_("Request size"),
+                N_("Buffer size per read request (KiB)"))
+        change_integer_range(4, 1 << 14)
+vlc_module_end()
@@ -818,6 +818,7 @@ bool sout_stream_sys_t::startSoutChain(sout_stream_t *p_stream,
     out_streams = new_streams;
     spu_streams_count = 0;
     transcoding_state = new_transcoding_state;
+    var_SetInteger( p_stream, SOUT_CFG_PREFIX "transcoding", transcoding_state );
 
     access_out_live.prepare( p_stream, mime );
 
@@ -1086,6 +1087,19 @@ bool sout_stream_sys_t::UpdateOutput( sout_stream_t *p_stream )
           << "std{mux=" << ( is_webm ? DEFAULT_MUXER_WEBM : DEFAULT_MUXER )
           << ",access=chromecast-http}";
 
+    /* Make the passthrough vs transcode decision auditable: transcoding
+     * multiplies CPU usage, remuxing does not. */
+    if ( p_original_video )
+        msg_Info( p_stream, "video track %4.4s: %s",
+                  (const char*)&p_original_video->i_codec,
+                  ( new_transcoding_state & TRANSCODING_VIDEO ) ?
+                  "transcoding" : "remuxing (passthrough)" );
+    if ( p_original_audio )
+        msg_Info( p_stream, "audio track %4.4s: %s",
+                  (const char*)&p_original_audio->i_codec,
+                  ( new_transcoding_state & TRANSCODING_AUDIO ) ?
+                  "transcoding" : "remuxing (passthrough)" );
+
     if ( !startSoutChain( p_stream, new_streams, ssout.str(),
                           new_transcoding_state ) )
         p_intf->requestPlayerStop();
@@ -1303,6 +1317,10 @@ static int Open(vlc_object_t *p_this)
 
     var_Create(p_stream, SOUT_CFG_PREFIX "access-out-sys", VLC_VAR_ADDRESS);
 
+    /* TRANSCODING_NONE/_VIDEO/_AUDIO mask of the running session, so that
+     * applications can check whether the passthrough fast path engaged */
+    var_Create(p_stream, SOUT_CFG_PREFIX "transcoding", VLC_VAR_INTEGER);
+
     // Set the sout callbacks.
     p_stream->ops = &ops;
     p_stream->p_sys = p_sys;
@@ -28,6 +28,8 @@
 # include "config.h"
 #endif
 
+#include <stdatomic.h>
+
 #include <vlc_common.h>
 #include <vlc_plugin.h>
 #include <vlc_sout.h>
@@ -67,6 +69,8 @@ typedef struct
 
     int             i_nb_select;
     char            **ppsz_select;
+
+    bool            b_shared; /**< Share payloads instead of duplicating */
 } sout_stream_sys_t;
 
 typedef struct
@@ -78,6 +82,66 @@ typedef struct
 static bool ESSelected( struct vlc_logger *, const es_format_t *fmt,
                         char *psz_select );
 
+/*****************************************************************************
+ * Shared payload references (shared option)
+ *
+ * Each branch receives a lightweight frame pointing into the payload of the
+ * original block, which is released when the last reference is. This assumes
+ * the branches do not modify the payload in place: the standard muxers only
+ * read it, but a branch that scrambles or rewrites data (e.g. ts with CSA
+ * encryption) requires the default copying behavior.
+ *****************************************************************************/
+typedef struct
+{
+    block_t     *p_parent; /**< Owner of the shared payload */
+    atomic_uint refs;
+} shared_payload_t;
+
+typedef struct
+{
+    block_t          frame;
+    shared_payload_t *p_payload;
+} block_ref_t;
+
+static void SharedPayloadRelease( shared_payload_t *p_payload )
+{
+    if( atomic_fetch_sub_explicit( &p_payload->refs, 1,
+                                   memory_order_acq_rel ) == 1 )
+    {
+        block_Release( p_payload->p_parent );
+        free( p_payload );
+    }
+}
+
+static void BlockRefRelease( block_t *p_block )
+{
+    block_ref_t *p_ref = (block_ref_t *)p_block;
+    shared_payload_t *p_payload = p_ref->p_payload;
+
+    free( p_ref );
+    SharedPayloadRelease( p_payload );
+}
+
+static const struct vlc_frame_callbacks block_ref_cbs =
+{
+    .free = BlockRefRelease,
+};
+
+static block_t *BlockRefNew( shared_payload_t *p_payload )
+{
+    block_ref_t *p_ref = malloc( sizeof( *p_ref ) );
+    if( unlikely(p_ref == NULL) )
+        return NULL;
+
+    block_t *p_parent = p_payload->p_parent;
+    block_Init( &p_ref->frame, &block_ref_cbs,
+                p_parent->p_buffer, p_parent->i_buffer );
+    block_CopyProperties( &p_ref->frame, p_parent );
+    p_ref->p_payload = p_payload;
+    atomic_fetch_add_explicit( &p_payload->refs, 1, memory_order_relaxed );
+    return &p_ref->frame;
+}
+
 /*****************************************************************************
  * Control
  *****************************************************************************/
@@ -126,6 +190,7 @@ static int Open( vlc_object_t *p_this )
 
     TAB_INIT( p_sys->i_nb_streams, p_sys->pp_streams );
     TAB_INIT( p_sys->i_nb_select, p_sys->ppsz_select );
+    p_sys->b_shared = false;
 
     char **ppsz_select = NULL;
 
@@ -164,6 +229,11 @@ static int Open( vlc_object_t *p_this )
                 }
             }
         }
+        else if( !strcmp( p_cfg->psz_name, "shared" ) )
+        {
+            msg_Dbg( p_stream, " * sharing payloads across branches" );
+            p_sys->b_shared = true;
+        }
         else
         {
             msg_Err( p_stream, " * ignore unknown option `%s'", p_cfg->psz_name );
@@ -299,6 +369,35 @@ static int Send( sout_stream_t *p_stream, void *_id, block_t *p_buffer )
 
         p_buffer->p_next = NULL;
 
+        if( p_sys->b_shared )
+        {
+            shared_payload_t *p_payload = malloc( sizeof( *p_payload ) );
+            if( likely(p_payload != NULL) )
+            {
+                p_payload->p_parent = p_buffer;
+                atomic_init( &p_payload->refs, 1 );
+
+                for( i_stream = 0; i_stream < p_sys->i_nb_streams; i_stream++ )
+                {
+                    if( !id->pp_ids[i_stream] )
+                        continue;
+
+                    block_t *p_ref = BlockRefNew( p_payload );
+                    if( p_ref )
+                        sout_StreamIdSend( p_sys->pp_streams[i_stream],
+                                           id->pp_ids[i_stream], p_ref );
+                }
+
+                /* Drop the creation reference, releasing the payload if no
+                 * branch took one */
+                SharedPayloadRelease( p_payload );
+
+                p_buffer = p_next;
+                continue;
+            }
+            /* Fall back to the copying path */
+        }
+
         for( i_stream = 0; i_stream < p_sys->i_nb_streams - 1; i_stream++ )
         {
             p_dup_stream = p_sys->pp_streams[i_stream];
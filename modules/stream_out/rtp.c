@@ -60,6 +60,10 @@
 #ifdef HAVE_LINUX_DCCP_H
 #   include <linux/dccp.h>
 #endif
+#if defined(__linux__) && defined(SO_TXTIME)
+#   include <linux/net_tstamp.h> /* struct sock_txtime, SCM_TXTIME */
+#   define HAVE_TXTIME 1
+#endif
 #ifndef IPPROTO_DCCP
 # define IPPROTO_DCCP 33
 #endif
@@ -129,6 +133,14 @@
     "Default caching value for outbound RTP streams. This " \
     "value should be set in milliseconds." )
 
+#define BURST_TEXT N_("Pacing burst window (ms)")
+#define BURST_LONGTEXT N_( \
+    "Send packets due within this window in one batch instead of waking " \
+    "up for each of them. On Linux, the per-packet transmission time is " \
+    "handed to the kernel (SO_TXTIME) so a fq or etf qdisc still paces " \
+    "the batch accurately; elsewhere packets may leave up to the window " \
+    "early. 0 paces packet per packet." )
+
 #define PROTO_TEXT N_("Transport protocol")
 #define PROTO_LONGTEXT N_( \
     "This selects which transport protocol to use for RTP." )
@@ -215,6 +227,8 @@ vlc_module_begin ()
               RTCP_MUX_TEXT, RTCP_MUX_LONGTEXT )
     add_integer( SOUT_CFG_PREFIX "caching", MS_FROM_VLC_TICK(DEFAULT_PTS_DELAY),
                  CACHING_TEXT, CACHING_LONGTEXT )
+    add_integer( SOUT_CFG_PREFIX "burst", 0,
+                 BURST_TEXT, BURST_LONGTEXT )
     add_integer( "rtsp-timeout", 60, RTSP_TIMEOUT_TEXT,
                  RTSP_TIMEOUT_LONGTEXT )
     add_string( "sout-rtsp-user", "",
@@ -314,6 +328,7 @@ typedef struct rtp_sink_t
 {
     int rtp_fd;
     rtcp_sender_t *rtcp;
+    bool txtime; /* Kernel paces the packets from their transmission time */
 } rtp_sink_t;
 
 struct sout_stream_id_sys_t
@@ -354,6 +369,7 @@ struct sout_stream_id_sys_t
     } listen;
 
     vlc_tick_t        i_caching;
+    vlc_tick_t        i_burst;
 };
 
 static int Control(sout_stream_t *stream, int query, va_list args)
@@ -945,6 +961,8 @@ static void *Add( sout_stream_t *p_stream, const es_format_t *p_fmt )
     id->b_first_packet = true;
     id->i_caching =
         VLC_TICK_FROM_MS(var_GetInteger( p_stream, SOUT_CFG_PREFIX "caching"));
+    id->i_burst =
+        VLC_TICK_FROM_MS(var_GetInteger( p_stream, SOUT_CFG_PREFIX "burst"));
 
     vlc_rand_bytes (&id->i_sequence, sizeof (id->i_sequence));
     vlc_rand_bytes (id->ssrc, sizeof (id->ssrc));
@@ -1324,6 +1342,85 @@ static int  HttpCallback( httpd_file_sys_t *p_args,
 /****************************************************************************
  * RTP send
  ****************************************************************************/
+/** How many RTP packets may be sent to a sink with a single system call */
+#define RTP_BATCH_MAX 32
+
+/* Sends a batch of RTP packets to one sink.
+ * Returns true if the connection is broken. */
+static bool SinkSend( int fd, block_t *const *outv, unsigned outc,
+                      vlc_tick_t i_caching, bool b_txtime )
+{
+#ifndef HAVE_TXTIME
+    (void) i_caching; (void) b_txtime;
+#endif
+#ifdef HAVE_SENDMMSG
+    if( outc > 1 )
+    {
+        struct mmsghdr msgv[RTP_BATCH_MAX];
+        struct iovec iov[RTP_BATCH_MAX];
+#ifdef HAVE_TXTIME
+        union
+        {
+            char buf[CMSG_SPACE(sizeof (uint64_t))];
+            struct cmsghdr align;
+        } ctl[RTP_BATCH_MAX];
+#endif
+
+        for( unsigned i = 0; i < outc; i++ )
+        {
+            iov[i] = (struct iovec){ outv[i]->p_buffer, outv[i]->i_buffer };
+            msgv[i] = (struct mmsghdr){
+                .msg_hdr = { .msg_iov = &iov[i], .msg_iovlen = 1 },
+            };
+
+#ifdef HAVE_TXTIME
+            if( b_txtime )
+            {
+                /* Let the qdisc release each packet at its due time, even
+                 * though the whole batch is handed over at once. The clock
+                 * matches vlc_tick_now() (CLOCK_MONOTONIC). */
+                msgv[i].msg_hdr.msg_control = ctl[i].buf;
+                msgv[i].msg_hdr.msg_controllen = sizeof (ctl[i].buf);
+
+                struct cmsghdr *cmsg = CMSG_FIRSTHDR( &msgv[i].msg_hdr );
+                cmsg->cmsg_level = SOL_SOCKET;
+                cmsg->cmsg_type = SCM_TXTIME;
+                cmsg->cmsg_len = CMSG_LEN(sizeof (uint64_t));
+
+                uint64_t ns = NS_FROM_VLC_TICK( outv[i]->i_dts + i_caching );
+                memcpy( CMSG_DATA( cmsg ), &ns, sizeof (ns) );
+            }
+#endif
+        }
+
+        /* Packets past a partial send are dropped, like any send error */
+        if( sendmmsg( fd, msgv, outc, 0 ) >= 0 )
+            return false;
+        /* Nothing was sent: diagnose the error packet by packet */
+    }
+#endif
+    bool dead = false;
+
+    for( unsigned i = 0; i < outc; i++ )
+    {
+        if( send( fd, outv[i]->p_buffer, outv[i]->i_buffer, 0 ) == -1
+         && net_errno != EAGAIN && net_errno != EWOULDBLOCK
+         && net_errno != ENOBUFS && net_errno != ENOMEM )
+        {
+            int type;
+            getsockopt( fd, SOL_SOCKET, SO_TYPE,
+                        &type, &(socklen_t){ sizeof(type) });
+            if( type == SOCK_DGRAM )
+                /* ICMP soft error: ignore and retry */
+                send( fd, outv[i]->p_buffer, outv[i]->i_buffer, 0 );
+            else
+                /* Broken connection */
+                dead = true;
+        }
+    }
+    return dead;
+}
+
 static void* ThreadSend( void *data )
 {
     vlc_thread_set_name("vlc-rt-send");
@@ -1362,7 +1459,32 @@ static void* ThreadSend( void *data )
 #endif
         vlc_tick_wait (out->i_dts + i_caching);
 
-        ssize_t len = out->i_buffer;
+        block_t *outv[RTP_BATCH_MAX];
+        unsigned outc = 0;
+
+        outv[outc++] = out;
+
+#ifdef HAVE_SENDMMSG
+        /* Opportunistically batch the packets that are already due — or due
+         * within the burst window — so that one system call per sink sends
+         * them all */
+# ifdef HAVE_SRTP
+        if( id->srtp == NULL ) /* SRTP rewrites packets one by one */
+# endif
+        {
+            vlc_tick_t limit = vlc_tick_now() + id->i_burst;
+
+            vlc_queue_Lock( &id->queue );
+            while( outc < RTP_BATCH_MAX )
+            {
+                block_t *next = (block_t *)id->queue.first;
+                if( next == NULL || next->i_dts + i_caching > limit )
+                    break;
+                outv[outc++] = vlc_queue_DequeueUnlocked( &id->queue );
+            }
+            vlc_queue_Unlock( &id->queue );
+        }
+#endif
 
         vlc_mutex_lock( &id->lock_sink );
         unsigned deadc = 0; /* How many dead sockets? */
@@ -1373,26 +1495,19 @@ static void* ThreadSend( void *data )
 #ifdef HAVE_SRTP
             if( !id->srtp ) /* FIXME: SRTCP support */
 #endif
-                SendRTCP( id->sinkv[i].rtcp, out );
+                for( unsigned j = 0; j < outc; j++ )
+                    SendRTCP( id->sinkv[i].rtcp, outv[j] );
 
-            if( send( id->sinkv[i].rtp_fd, out->p_buffer, len, 0 ) == -1
-             && net_errno != EAGAIN && net_errno != EWOULDBLOCK
-             && net_errno != ENOBUFS && net_errno != ENOMEM )
-            {
-                int type;
-                getsockopt( id->sinkv[i].rtp_fd, SOL_SOCKET, SO_TYPE,
-                            &type, &(socklen_t){ sizeof(type) });
-                if( type == SOCK_DGRAM )
-                    /* ICMP soft error: ignore and retry */
-                    send( id->sinkv[i].rtp_fd, out->p_buffer, len, 0 );
-                else
-                    /* Broken connection */
-                    deadv[deadc++] = id->sinkv[i].rtp_fd;
-            }
+            if( SinkSend( id->sinkv[i].rtp_fd, outv, outc,
+                          i_caching, id->sinkv[i].txtime ) )
+                deadv[deadc++] = id->sinkv[i].rtp_fd;
         }
-        id->i_seq_sent_next = ntohs(((uint16_t *) out->p_buffer)[1]) + 1;
+        id->i_seq_sent_next =
+            ntohs(((uint16_t *) outv[outc - 1]->p_buffer)[1]) + 1;
         vlc_mutex_unlock( &id->lock_sink );
-        block_Release( out );
+
+        for( unsigned j = 0; j < outc; j++ )
+            block_Release( outv[j] );
 
         for( unsigned i = 0; i < deadc; i++ )
         {
@@ -1429,12 +1544,26 @@ static void *rtp_listen_thread( void *data )
 
 int rtp_add_sink( sout_stream_id_sys_t *id, int fd, bool rtcp_mux, uint16_t *seq )
 {
-    rtp_sink_t sink = { fd, NULL };
+    rtp_sink_t sink = { .rtp_fd = fd };
     sink.rtcp = OpenRTCP( VLC_OBJECT( id->p_stream ), fd, IPPROTO_UDP,
                           rtcp_mux );
     if( sink.rtcp == NULL )
         msg_Err( id->p_stream, "RTCP failed!" );
 
+#ifdef HAVE_TXTIME
+    if( id->i_burst > 0 )
+    {
+        struct sock_txtime txtime = { .clockid = CLOCK_MONOTONIC };
+
+        if( setsockopt( fd, SOL_SOCKET, SO_TXTIME,
+                        &txtime, sizeof( txtime ) ) == 0 )
+            sink.txtime = true;
+        else
+            msg_Dbg( id->p_stream, "SO_TXTIME unavailable: %s",
+                     vlc_strerror_c(errno) );
+    }
+#endif
+
     vlc_mutex_lock( &id->lock_sink );
     TAB_APPEND(id->sinkc, id->sinkv, sink);
     if( seq != NULL )
@@ -1445,7 +1574,7 @@ int rtp_add_sink( sout_stream_id_sys_t *id, int fd, bool rtcp_mux, uint16_t *seq
 
 void rtp_del_sink( sout_stream_id_sys_t *id, int fd )
 {
-    rtp_sink_t sink = { fd, NULL };
+    rtp_sink_t sink = { .rtp_fd = fd };
 
     /* NOTE: must be safe to use if fd is not included */
     vlc_mutex_lock( &id->lock_sink );
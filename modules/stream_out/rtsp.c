@@ -34,6 +34,7 @@
 #include <vlc_sout.h>
 
 #include <vlc_httpd.h>
+#include <vlc_arrays.h>
 #include <vlc_url.h>
 #include <vlc_charset.h>
 #include <vlc_fs.h>
@@ -66,9 +67,13 @@ struct rtsp_stream_t
 
     int             sessionc;
     rtsp_session_t **sessionv;
+    /* by-name lookup, so that keepalives from hundreds of clients do not
+     * scan the whole session table under the lock */
+    vlc_dictionary_t session_dict;
 
     vlc_tick_t      timeout;
     vlc_timer_t     timer;
+    bool            timer_armed;
 };
 
 
@@ -91,6 +96,7 @@ rtsp_stream_t *RtspSetup( vlc_object_t *owner, const char *path )
 
     rtsp->owner = owner;
     vlc_mutex_init( &rtsp->lock );
+    vlc_dictionary_init( &rtsp->session_dict, 0 );
 
     rtsp->timeout = vlc_tick_from_sec(__MAX(0,var_InheritInteger(owner, "rtsp-timeout")));
     if (rtsp->timeout != 0)
@@ -147,6 +153,7 @@ void RtspUnsetup( rtsp_stream_t *rtsp )
     if (rtsp->timeout != 0)
         vlc_timer_destroy(rtsp->timer);
 
+    vlc_dictionary_clear( &rtsp->session_dict, NULL, NULL );
     free( rtsp->psz_path );
     free( rtsp );
 }
@@ -171,6 +178,7 @@ struct rtsp_session_t
 {
     rtsp_stream_t *stream;
     uint64_t       id;
+    char           name[17]; /* id as sent on the wire, dictionary key */
     vlc_tick_t     last_seen; /* for timeouts */
 
     /* output (id-access) */
@@ -307,10 +315,12 @@ static void RtspUpdateTimer( rtsp_stream_t *rtsp )
     {
         timeout += rtsp->timeout;
         vlc_timer_schedule(rtsp->timer, true, timeout, VLC_TIMER_FIRE_ONCE);
+        rtsp->timer_armed = true;
     }
     else
     {
         vlc_timer_disarm(rtsp->timer);
+        rtsp->timer_armed = false;
     }
 }
 
@@ -339,10 +349,12 @@ rtsp_session_t *RtspClientNew( rtsp_stream_t *rtsp )
 
     s->stream = rtsp;
     vlc_rand_bytes (&s->id, sizeof (s->id));
+    snprintf( s->name, sizeof (s->name), "%"PRIx64, s->id );
     s->trackc = 0;
     s->trackv = NULL;
 
     TAB_APPEND( rtsp->sessionc, rtsp->sessionv, s );
+    vlc_dictionary_insert( &rtsp->session_dict, s->name, s );
 
     return s;
 }
@@ -354,7 +366,6 @@ rtsp_session_t *RtspClientGet( rtsp_stream_t *rtsp, const char *name )
 {
     char *end;
     uint64_t id;
-    int i;
 
     if( name == NULL )
         return NULL;
@@ -364,13 +375,11 @@ rtsp_session_t *RtspClientGet( rtsp_stream_t *rtsp, const char *name )
     if( errno || *end )
         return NULL;
 
-    /* FIXME: use a hash/dictionary */
-    for( i = 0; i < rtsp->sessionc; i++ )
-    {
-        if( rtsp->sessionv[i]->id == id )
-            return rtsp->sessionv[i];
-    }
-    return NULL;
+    /* Look up by the canonical spelling of the ID, so that variants such as
+     * leading zeroes still match the session */
+    char key[17];
+    snprintf( key, sizeof (key), "%"PRIx64, id );
+    return vlc_dictionary_value_for_key( &rtsp->session_dict, key );
 }
 
 
@@ -380,6 +389,8 @@ void RtspClientDel( rtsp_stream_t *rtsp, rtsp_session_t *session )
 {
     int i;
     TAB_REMOVE( rtsp->sessionc, rtsp->sessionv, session );
+    vlc_dictionary_remove_value_for_key( &rtsp->session_dict, session->name,
+                                         NULL, NULL );
 
     for( i = 0; i < session->trackc; i++ )
         RtspTrackClose( &session->trackv[i] );
@@ -392,11 +403,17 @@ void RtspClientDel( rtsp_stream_t *rtsp, rtsp_session_t *session )
 /** rtsp must be locked */
 static void RtspClientAlive( rtsp_session_t *session )
 {
-    if (session->stream->timeout == 0)
+    rtsp_stream_t *rtsp = session->stream;
+
+    if (rtsp->timeout == 0)
         return;
 
     session->last_seen = vlc_tick_now();
-    RtspUpdateTimer(session->stream);
+    /* Refreshing a session only moves its expiry further away, so an
+     * already armed timer can at worst fire early and find nothing to
+     * reap; no need to rescan every session on each request. */
+    if (!rtsp->timer_armed)
+        RtspUpdateTimer(rtsp);
 }
 
 static int dup_socket(int oldfd)
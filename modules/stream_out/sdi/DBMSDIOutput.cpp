@@ -55,6 +55,7 @@
 
 #define DECKLINK_CARD_BUFFER (CLOCK_FREQ)
 #define DECKLINK_PREROLL (CLOCK_FREQ*3/4)
+#define DECKLINK_PREROLL_MIN (CLOCK_FREQ/10)
 #define DECKLINK_SCHED_OFFSET (CLOCK_FREQ/20)
 
 static_assert(DECKLINK_CARD_BUFFER > DECKLINK_PREROLL + DECKLINK_SCHED_OFFSET, "not in card buffer limits");
@@ -71,6 +72,14 @@ DBMSDIOutput::DBMSDIOutput(sout_stream_t *p_stream) :
     lasttimestamp = 0;
     b_running = false;
     streamStartTime = VLC_TICK_INVALID;
+    prerollLength = VLC_TICK_FROM_MS(var_InheritInteger(p_stream, CFG_PREFIX "buffer"));
+    prerollLength = VLC_CLIP(prerollLength, DECKLINK_PREROLL_MIN,
+                             DECKLINK_CARD_BUFFER - DECKLINK_SCHED_OFFSET);
+    stats.dropped = stats.late = stats.underruns = stats.published = 0;
+    stats.b_underrun = false;
+    var_Create(p_stream, CFG_PREFIX "dropped-frames", VLC_VAR_INTEGER);
+    var_Create(p_stream, CFG_PREFIX "late-frames", VLC_VAR_INTEGER);
+    var_Create(p_stream, CFG_PREFIX "underruns", VLC_VAR_INTEGER);
     vlc_mutex_init(&feeder.lock);
     vlc_cond_init(&feeder.cond);
     feeder.canceled = false;
@@ -91,6 +100,10 @@ DBMSDIOutput::~DBMSDIOutput()
         vlc_join(feeder.thread, NULL);
     }
 
+    if(stats.dropped || stats.late || stats.underruns)
+        msg_Warn(p_stream, "playback had %u dropped / %u late frames, %u underruns",
+                 stats.dropped, stats.late, stats.underruns);
+
     es_format_Clean(&video.configuredfmt);
     if(p_output)
     {
@@ -162,6 +175,10 @@ HRESULT STDMETHODCALLTYPE DBMSDIOutput::ScheduledFrameCompleted
     bool b_active;
 #endif
     vlc_mutex_locker locker(&feeder.lock);
+    if(result == bmdOutputFrameDropped)
+        stats.dropped++;
+    else if(result == bmdOutputFrameDisplayedLate)
+        stats.late++;
     if((S_OK == p_output->IsScheduledPlaybackRunning(&b_active)) && b_active)
         vlc_cond_signal(&feeder.cond);
 
@@ -612,9 +629,21 @@ int DBMSDIOutput::Process()
     return VLC_SUCCESS;
 }
 
+/** feeder must be locked */
+void DBMSDIOutput::publishStats()
+{
+    unsigned total = stats.dropped + stats.late + stats.underruns;
+    if(total == stats.published)
+        return;
+    stats.published = total;
+    var_SetInteger(p_stream, CFG_PREFIX "dropped-frames", stats.dropped);
+    var_SetInteger(p_stream, CFG_PREFIX "late-frames", stats.late);
+    var_SetInteger(p_stream, CFG_PREFIX "underruns", stats.underruns);
+}
+
 int DBMSDIOutput::doSchedule()
 {
-    const vlc_tick_t preroll = DECKLINK_PREROLL;
+    const vlc_tick_t preroll = prerollLength;
     vlc_tick_t next = videoBuffer.NextPictureTime();
     if(next == VLC_TICK_INVALID ||
        (!b_running && !ReachedPlaybackTime(next + preroll + SAMPLES_PER_FRAME*CLOCK_FREQ/48000)))
@@ -633,6 +662,23 @@ int DBMSDIOutput::doSchedule()
     if(S_OK != p_output->GetBufferedVideoFrameCount(&bufferedFramesCount))
         return VLC_EGENERIC;
 
+    if(b_running)
+    {
+        if(bufferedFramesCount == 0)
+        {
+            if(!stats.b_underrun)
+            {
+                stats.b_underrun = true;
+                stats.underruns++;
+                msg_Warn(p_stream, "scheduled frames exhausted (underrun %u)",
+                         stats.underruns);
+            }
+        }
+        else
+            stats.b_underrun = false;
+        publishStats();
+    }
+
     uint32_t bufferedFramesTarget = (uint64_t)timescale*preroll/frameduration/CLOCK_FREQ;
     if( bufferedFramesTarget > bufferedFramesCount )
     {
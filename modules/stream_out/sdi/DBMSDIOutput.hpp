@@ -66,6 +66,15 @@ namespace sdi_sout
             } clock;
             bool b_running;
             vlc_tick_t streamStartTime;
+            vlc_tick_t prerollLength;
+            struct
+            {
+                unsigned dropped;
+                unsigned late;
+                unsigned underruns;
+                unsigned published; /* sum of the above, last pushed to vars */
+                bool b_underrun;
+            } stats;
             int StartPlayback();
             struct
             {
@@ -80,6 +89,7 @@ namespace sdi_sout
             int doProcessVideo(picture_t *, block_t *);
             int FeedOneFrame();
             int FeedAudio(vlc_tick_t, vlc_tick_t, bool);
+            void publishStats();
             void checkClockDrift();
             bool isDrained();
     };
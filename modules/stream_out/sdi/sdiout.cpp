@@ -50,6 +50,12 @@
 
 #define NOSIGNAL_IMAGE_TEXT N_("Picture to display on input signal loss")
 
+#define BUFFER_TEXT N_("Scheduled playback buffer (ms)")
+#define BUFFER_LONGTEXT N_(\
+    "Duration of video and audio scheduled ahead in the card. " \
+    "Larger values survive longer scheduling hiccups in the " \
+    "feeding process, at the cost of output latency.")
+
 #define CARD_INDEX_TEXT N_("Output card")
 #define CARD_INDEX_LONGTEXT N_(\
     "DeckLink output card, if multiple exist. " \
@@ -173,6 +179,8 @@ vlc_module_begin ()
     set_section(N_("DeckLink General Options"), NULL)
     add_integer(CFG_PREFIX "card-index", 0,
                 CARD_INDEX_TEXT, CARD_INDEX_LONGTEXT)
+    add_integer_with_range(CFG_PREFIX "buffer", 750, 100, 950,
+                BUFFER_TEXT, BUFFER_LONGTEXT)
 
     set_section(N_("DeckLink Video Options"), NULL)
     add_string(CFG_PREFIX "video-connection", "sdi",
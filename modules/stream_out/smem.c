@@ -46,12 +46,15 @@
 # include "config.h"
 #endif
 
+#include <stdatomic.h>
+
 #include <vlc_common.h>
 #include <vlc_plugin.h>
 #include <vlc_sout.h>
 #include <vlc_block.h>
 #include <vlc_codec.h>
 #include <vlc_aout.h>
+#include <vlc_interrupt.h>
 
 /*****************************************************************************
  * Module descriptor
@@ -79,6 +82,14 @@
 #define T_AUDIO_DATA N_( "Audio callback data" )
 #define LT_AUDIO_DATA N_( "Data for the audio callback function." )
 
+#define T_VIDEO_RING N_( "Video output ring" )
+#define LT_VIDEO_RING N_( "Address of a lock-free FIFO receiving the video " \
+                          "buffers instead of the render callbacks." )
+
+#define T_AUDIO_RING N_( "Audio output ring" )
+#define LT_AUDIO_RING N_( "Address of a lock-free FIFO receiving the audio " \
+                          "buffers instead of the render callbacks." )
+
 #define T_TIME_SYNC N_( "Time Synchronized output" )
 #define LT_TIME_SYNC N_( "Time Synchronisation option for output. " \
                         "If true, stream will render as usual, else " \
@@ -109,6 +120,10 @@ vlc_module_begin ()
         change_volatile()
     add_string( SOUT_PREFIX_AUDIO "data", "0", T_AUDIO_DATA, LT_VIDEO_DATA )
         change_volatile()
+    add_string( SOUT_PREFIX_VIDEO "ring", "0", T_VIDEO_RING, LT_VIDEO_RING )
+        change_volatile()
+    add_string( SOUT_PREFIX_AUDIO "ring", "0", T_AUDIO_RING, LT_AUDIO_RING )
+        change_volatile()
     add_bool( SOUT_CFG_PREFIX "time-sync", true, T_TIME_SYNC, LT_TIME_SYNC )
         change_private()
     set_callbacks( Open, Close )
@@ -120,7 +135,8 @@ vlc_module_end ()
  *****************************************************************************/
 static const char *const ppsz_sout_options[] = {
     "video-prerender-callback", "audio-prerender-callback",
-    "video-postrender-callback", "audio-postrender-callback", "video-data", "audio-data", "time-sync", NULL
+    "video-postrender-callback", "audio-postrender-callback", "video-data", "audio-data",
+    "video-ring", "audio-ring", "time-sync", NULL
 };
 
 static void *Add( sout_stream_t *, const es_format_t * );
@@ -139,6 +155,32 @@ typedef struct
     void *p_data;
 } sout_stream_id_sys_t;
 
+/**
+ * Lock-free output FIFO.
+ *
+ * Instead of being handed each buffer through the render callbacks, the
+ * application can share a single-producer single-consumer byte FIFO by
+ * passing its address (as a decimal string, like the callbacks) in the
+ * "video-ring" or "audio-ring" option. VLC appends buffers at \ref head,
+ * the application consumes them from \ref tail; both offsets are
+ * free-running and wrap modulo 2^32, so \ref size must be a power of two.
+ * Each buffer is stored as a 16-byte header - 64-bit PTS, 32-bit payload
+ * size, 32 reserved bits - followed by the payload, wrapping byte-wise.
+ *
+ * The matching postrender callback then becomes a batched watermark
+ * notification: it is invoked with a NULL buffer, once whenever the fill
+ * level crosses \ref watermark rather than once per buffer, with the fill
+ * level as the size argument. The prerender callback is not used.
+ */
+struct vlc_smem_ring
+{
+    uint32_t size; /**< Capacity of data[] in bytes, a power of two */
+    uint32_t watermark; /**< Notification threshold, in bytes */
+    _Atomic uint32_t head; /**< Free-running write offset, VLC-owned */
+    _Atomic uint32_t tail; /**< Free-running read offset, application-owned */
+    uint8_t data[];
+};
+
 typedef struct
 {
     vlc_mutex_t *p_lock;
@@ -146,6 +188,8 @@ typedef struct
     void ( *pf_audio_prerender_callback ) ( void* p_audio_data, uint8_t** pp_pcm_buffer, size_t size );
     void ( *pf_video_postrender_callback ) ( void* p_video_data, uint8_t* p_pixel_buffer, int width, int height, int pixel_pitch, size_t size, vlc_tick_t pts );
     void ( *pf_audio_postrender_callback ) ( void* p_audio_data, uint8_t* p_pcm_buffer, unsigned int channels, unsigned int rate, unsigned int nb_samples, unsigned int bits_per_sample, size_t size, vlc_tick_t pts );
+    struct vlc_smem_ring *video_ring;
+    struct vlc_smem_ring *audio_ring;
     bool time_sync;
 } sout_stream_sys_t;
 
@@ -188,6 +232,84 @@ void AudioPostrenderDefaultCallback( void* p_audio_data, uint8_t* p_pcm_buffer,
     VLC_UNUSED( bits_per_sample ); VLC_UNUSED( size ); VLC_UNUSED( pts );
 }
 
+/*****************************************************************************
+ * Lock-free FIFO helpers
+ *****************************************************************************/
+
+static void RingWrite( struct vlc_smem_ring *ring, uint32_t offset,
+                       const void *data, size_t length )
+{
+    offset &= ring->size - 1;
+
+    size_t contig = ring->size - offset;
+    if( length <= contig )
+        memcpy( ring->data + offset, data, length );
+    else
+    {
+        memcpy( ring->data + offset, data, contig );
+        memcpy( ring->data, (const uint8_t *)data + contig, length - contig );
+    }
+}
+
+/**
+ * Appends one buffer to the FIFO.
+ * @param pi_used fill level after the append, in bytes [OUT]
+ * @return true if the watermark was crossed upward by this append
+ */
+static bool RingPush( sout_stream_t *p_stream, struct vlc_smem_ring *ring,
+                      const block_t *p_buffer, size_t *pi_used )
+{
+    const size_t i_need = 16 + p_buffer->i_buffer;
+    uint32_t head = atomic_load_explicit( &ring->head, memory_order_relaxed );
+    uint32_t used;
+
+    if( i_need > ring->size )
+    {
+        msg_Err( p_stream, "buffer of %zu bytes does not fit in the ring",
+                 p_buffer->i_buffer );
+        *pi_used = 0;
+        return false;
+    }
+
+    for( ;; )
+    {
+        uint32_t tail = atomic_load_explicit( &ring->tail,
+                                              memory_order_acquire );
+        used = head - tail;
+        if( ring->size - used >= i_need )
+            break;
+        if( vlc_killed() )
+        {   /* Stalled consumer: drop the buffer rather than block stopping */
+            *pi_used = 0;
+            return false;
+        }
+        /* Full FIFO. A consumer keeping up never gets VLC here. */
+        vlc_tick_sleep( VLC_TICK_FROM_MS(1) );
+    }
+
+    uint8_t header[16];
+    int64_t pts = p_buffer->i_pts;
+    uint32_t payload = p_buffer->i_buffer, reserved = 0;
+    memcpy( header, &pts, 8 );
+    memcpy( header + 8, &payload, 4 );
+    memcpy( header + 12, &reserved, 4 );
+
+    RingWrite( ring, head, header, 16 );
+    RingWrite( ring, head + 16, p_buffer->p_buffer, payload );
+    atomic_store_explicit( &ring->head, head + i_need, memory_order_release );
+
+    *pi_used = used + i_need;
+    return used < ring->watermark && used + i_need >= ring->watermark;
+}
+
+static int RingCheck( sout_stream_t *p_stream, const struct vlc_smem_ring *ring )
+{
+    if( ring == NULL || ( ring->size != 0 && !( ring->size & (ring->size - 1) ) ) )
+        return VLC_SUCCESS;
+    msg_Err( p_stream, "ring size %"PRIu32" not a power of two", ring->size );
+    return VLC_EGENERIC;
+}
+
 static int Control(sout_stream_t *stream, int query, va_list args)
 {
     sout_stream_sys_t *sys = stream->p_sys;
@@ -252,6 +374,21 @@ static int Open( vlc_object_t *p_this )
     if (p_sys->pf_audio_postrender_callback == NULL)
         p_sys->pf_audio_postrender_callback = AudioPostrenderDefaultCallback;
 
+    psz_tmp = var_GetString( p_stream, SOUT_PREFIX_VIDEO "ring" );
+    p_sys->video_ring = (void *)(intptr_t)atoll( psz_tmp );
+    free( psz_tmp );
+
+    psz_tmp = var_GetString( p_stream, SOUT_PREFIX_AUDIO "ring" );
+    p_sys->audio_ring = (void *)(intptr_t)atoll( psz_tmp );
+    free( psz_tmp );
+
+    if( RingCheck( p_stream, p_sys->video_ring )
+     || RingCheck( p_stream, p_sys->audio_ring ) )
+    {
+        free( p_sys );
+        return VLC_EGENERIC;
+    }
+
     /* Setting stream out module callbacks */
     p_stream->ops = &ops;
     return VLC_SUCCESS;
@@ -378,6 +515,18 @@ static int SendVideo( sout_stream_t *p_stream, void *_id, block_t *p_buffer )
     size_t i_size = p_buffer->i_buffer;
     uint8_t* p_pixels = NULL;
 
+    if( p_sys->video_ring != NULL )
+    {
+        size_t i_used;
+
+        if( RingPush( p_stream, p_sys->video_ring, p_buffer, &i_used ) )
+            p_sys->pf_video_postrender_callback( id->p_data, NULL,
+                                                 id->format.video.i_width, id->format.video.i_height,
+                                                 id->format.video.i_bits_per_pixel, i_used, p_buffer->i_pts );
+        block_ChainRelease( p_buffer );
+        return VLC_SUCCESS;
+    }
+
     /* Calling the prerender callback to get user buffer */
     p_sys->pf_video_prerender_callback( id->p_data, &p_pixels, i_size );
 
@@ -414,6 +563,18 @@ static int SendAudio( sout_stream_t *p_stream, void *_id, block_t *p_buffer )
         return VLC_EGENERIC;
     }
 
+    if( p_sys->audio_ring != NULL )
+    {
+        size_t i_used;
+
+        if( RingPush( p_stream, p_sys->audio_ring, p_buffer, &i_used ) )
+            p_sys->pf_audio_postrender_callback( id->p_data, NULL,
+                                                 id->format.audio.i_channels, id->format.audio.i_rate, 0,
+                                                 id->format.audio.i_bitspersample, i_used, p_buffer->i_pts );
+        block_ChainRelease( p_buffer );
+        return VLC_SUCCESS;
+    }
+
     i_samples = i_size / ( ( id->format.audio.i_bitspersample / 8 ) * id->format.audio.i_channels );
     /* Calling the prerender callback to get user buffer */
     p_sys->pf_audio_prerender_callback( id->p_data, &p_pcm_buffer, i_size );
@@ -311,17 +311,29 @@ static void* EncoderThread( void *obj )
         while( !p_enc->b_abort &&
                (p_pic = picture_fifo_Pop( p_enc->pp_pics )) == NULL )
             vlc_cond_wait( &p_enc->cond, &p_enc->lock_out );
-        vlc_sem_post( &p_enc->picture_pool_has_room );
 
         if( p_pic )
         {
-            /* release lock while encoding */
-            vlc_mutex_unlock( &p_enc->lock_out );
-            p_block = vlc_encoder_EncodeVideo( p_enc->p_encoder, p_pic );
-            picture_Release( p_pic );
-            vlc_mutex_lock( &p_enc->lock_out );
-
-            block_ChainAppend( &p_enc->p_buffers, p_block );
+            /* Drain the whole backlog in one burst: the output chain is
+             * spliced once per burst instead of walked on every append */
+            block_t *p_chain = NULL;
+            block_t **pp_chain_last = &p_chain;
+
+            do
+            {
+                vlc_sem_post( &p_enc->picture_pool_has_room );
+                /* release lock while encoding */
+                vlc_mutex_unlock( &p_enc->lock_out );
+                p_block = vlc_encoder_EncodeVideo( p_enc->p_encoder, p_pic );
+                picture_Release( p_pic );
+                if( p_block )
+                    block_ChainLastAppend( &pp_chain_last, p_block );
+                vlc_mutex_lock( &p_enc->lock_out );
+            }
+            while( !p_enc->b_abort &&
+                   (p_pic = picture_fifo_Pop( p_enc->pp_pics )) != NULL );
+
+            block_ChainAppend( &p_enc->p_buffers, p_chain );
         }
 
         if( p_enc->b_abort )
@@ -412,18 +424,16 @@ int transcode_encoder_video_open( transcode_encoder_t *p_enc,
     p_enc->p_buffers = NULL;
     p_enc->b_abort = false;
 
-    if( p_cfg->video.threads.i_count > 0 )
-    {
-        if( vlc_clone( &p_enc->thread, EncoderThread, p_enc ) )
-        {
-            if (p_enc->p_encoder->ops->close)
-                p_enc->p_encoder->ops->close(p_enc->p_encoder);
-            module_unneed( p_enc->p_encoder, p_enc->p_encoder->p_module );
-            p_enc->p_encoder->p_module = NULL;
-            return VLC_EGENERIC;
-        }
+    /* Always decouple the encoder from the filter output through the bounded
+     * picture fifo, even when no extra encoder threads are requested:
+     * encoder lookahead stalls (x264) then delay the decoder by at most
+     * pool-size pictures instead of propagating directly to the read path */
+    if( vlc_clone( &p_enc->thread, EncoderThread, p_enc ) == 0 )
         p_enc->b_threaded = true;
-    }
+    else
+        /* Keep the synchronous path as fallback */
+        msg_Warn( p_enc->p_encoder, "cannot spawn encoder thread, "
+                  "encoding synchronously" );
 
     return VLC_SUCCESS;
 }
@@ -145,30 +145,92 @@ static int Control(sout_stream_t *stream, int query, va_list args)
     return VLC_SUCCESS;
 }
 
+#define UDP_IOV_MAX 16
+
+/**
+ * Gathers the head of a block chain into an iovec array, one datagram of at
+ * most the MTU, and returns the first block not included.
+ */
+static block_t *GatherDatagram(struct sout_stream_udp *sys, block_t *block,
+                               struct iovec *iov, unsigned *restrict iovlen)
+{
+    unsigned n = 0;
+    size_t tosend = 0;
+
+    /* Count how many blocks to gather */
+    do {
+        if (n >= UDP_IOV_MAX)
+            break;
+        if (block->i_buffer + tosend > sys->mtu && likely(n > 0))
+            break;
+
+        iov[n].iov_base = block->p_buffer;
+        iov[n].iov_len = block->i_buffer;
+        n++;
+        tosend += block->i_buffer;
+        block = block->p_next;
+    } while (block != NULL);
+
+    *iovlen = n;
+    return block;
+}
+
+#ifdef HAVE_SENDMMSG
+# define UDP_BATCH_MAX 32
+
 static ssize_t AccessOutWrite(sout_access_out_t *access, block_t *block)
 {
     struct sout_stream_udp *sys = access->p_sys;
     ssize_t total = 0;
 
     while (block != NULL) {
-        struct iovec iov[16];
+        struct mmsghdr msgv[UDP_BATCH_MAX];
+        struct iovec iov[UDP_BATCH_MAX][UDP_IOV_MAX];
+        unsigned msgc = 0;
         block_t *unsent = block;
-        unsigned iovlen = 0;
-        size_t tosend = 0;
 
-        /* Count how many blocks to gather */
+        /* Gather as many datagrams as possible for a single system call */
+        do {
+            unsigned iovlen;
+
+            unsent = GatherDatagram(sys, unsent, iov[msgc], &iovlen);
+            msgv[msgc].msg_hdr = (struct msghdr){
+                .msg_iov = iov[msgc], .msg_iovlen = iovlen,
+            };
+            msgv[msgc].msg_len = 0;
+            msgc++;
+        } while (unsent != NULL && msgc < UDP_BATCH_MAX);
+
+        /* Send */
+        int sent = sendmmsg(sys->fd, msgv, msgc, 0);
+
+        if (sent < 0)
+            msg_Err(access, "send error: %s", vlc_strerror_c(errno));
+        else
+            for (int i = 0; i < sent; i++)
+                total += msgv[i].msg_len;
+
+        /* Free */
         do {
-            if (iovlen >= ARRAY_SIZE(iov))
-                break;
-            if (unsent->i_buffer + tosend > sys->mtu && likely(iovlen > 0))
-                break;
-
-            iov[iovlen].iov_base = unsent->p_buffer;
-            iov[iovlen].iov_len = unsent->i_buffer;
-            iovlen++;
-            tosend += unsent->i_buffer;
-            unsent = unsent->p_next;
-        } while (unsent != NULL);
+            block_t *next = block->p_next;
+
+            block_Release(block);
+            block = next;
+        } while (block != unsent);
+    }
+
+    return total;
+}
+#else /* !HAVE_SENDMMSG */
+static ssize_t AccessOutWrite(sout_access_out_t *access, block_t *block)
+{
+    struct sout_stream_udp *sys = access->p_sys;
+    ssize_t total = 0;
+
+    while (block != NULL) {
+        struct iovec iov[UDP_IOV_MAX];
+        unsigned iovlen;
+        block_t *unsent = GatherDatagram(sys, block, iov, &iovlen);
 
         /* Send */
         struct msghdr hdr = { .msg_iov = iov, .msg_iovlen = iovlen };
@@ -190,6 +252,7 @@ static ssize_t AccessOutWrite(sout_access_out_t *access, block_t *block)
 
     return total;
 }
+#endif
 
 static void Close(vlc_object_t *obj)
 {
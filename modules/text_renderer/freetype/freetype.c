@@ -41,6 +41,8 @@
 #include <vlc_subpicture.h>
 #include <vlc_text_style.h>                                   /* text_style_t*/
 #include <vlc_charset.h>
+#include <vlc_hash.h>
+#include <vlc_strings.h>                         /* vlc_hex_encode_binary */
 
 #include <assert.h>
 
@@ -973,6 +975,120 @@ static size_t SegmentsToTextAndStyles( filter_t *p_filter, const text_segment_t
     return i_nb_char;
 }
 
+/* Number of rendered regions kept around. Sized for ticker/teletext like
+ * content where the same handful of lines is re-submitted every update. */
+#define REGION_CACHE_SIZE 32
+
+/* A fully rendered region. The picture is shared with the outgoing
+ * subpictures through its refcount, so serving a cache hit neither
+ * allocates nor touches FreeType. */
+typedef struct
+{
+    picture_t     *p_picture;
+    video_format_t fmt;
+    int            i_x_delta;
+    int            i_y_delta;
+} rendered_region_t;
+
+static void ReleaseRenderedRegion( void *priv, void *value )
+{
+    VLC_UNUSED(priv);
+    rendered_region_t *p_cached = value;
+    picture_Release( p_cached->p_picture );
+    video_format_Clean( &p_cached->fmt );
+    free( p_cached );
+}
+
+static void HashStyle( vlc_hash_md5_t *ctx, const text_style_t *p_style )
+{
+    if( p_style->psz_fontname )
+        vlc_hash_md5_Update( ctx, p_style->psz_fontname,
+                             strlen( p_style->psz_fontname ) + 1 );
+    if( p_style->psz_monofontname )
+        vlc_hash_md5_Update( ctx, p_style->psz_monofontname,
+                             strlen( p_style->psz_monofontname ) + 1 );
+    /* Styles are calloc'ed, the padding of the scalar tail is deterministic */
+    vlc_hash_md5_Update( ctx, &p_style->i_features,
+                         sizeof(*p_style) - offsetof(text_style_t, i_features) );
+}
+
+/*****************************************************************************
+ * Hash everything the rendering depends on: the text segments with their
+ * styles, the live default/forced styles and the output parameters.
+ *****************************************************************************/
+static void RenderKey( filter_t *p_filter,
+                       const subpicture_region_t *p_region_in,
+                       const subpicture_region_t *p_region_out,
+                       const vlc_fourcc_t *p_chroma_list,
+                       unsigned i_max_width, unsigned i_max_height,
+                       char psz_key[VLC_HASH_MD5_DIGEST_HEX_SIZE] )
+{
+    filter_sys_t *p_sys = p_filter->p_sys;
+    vlc_hash_md5_t ctx;
+    vlc_hash_md5_Init( &ctx );
+
+    for( const text_segment_t *s = p_region_in->p_text; s != NULL; s = s->p_next )
+    {
+        if( s->psz_text )
+            vlc_hash_md5_Update( &ctx, s->psz_text, strlen( s->psz_text ) + 1 );
+        if( s->style )
+            HashStyle( &ctx, s->style );
+        for( const text_segment_ruby_t *p_ruby = s->p_ruby;
+                                        p_ruby; p_ruby = p_ruby->p_next )
+        {
+            if( p_ruby->psz_base )
+                vlc_hash_md5_Update( &ctx, p_ruby->psz_base,
+                                     strlen( p_ruby->psz_base ) + 1 );
+            if( p_ruby->psz_rt )
+                vlc_hash_md5_Update( &ctx, p_ruby->psz_rt,
+                                     strlen( p_ruby->psz_rt ) + 1 );
+        }
+    }
+
+    /* Segment styles are merged over these at layout time */
+    HashStyle( &ctx, p_sys->p_default_style );
+    HashStyle( &ctx, p_sys->p_forced_style );
+
+    if( p_chroma_list )
+        for( const vlc_fourcc_t *p_chroma = p_chroma_list; *p_chroma != 0; p_chroma++ )
+            vlc_hash_md5_Update( &ctx, p_chroma, sizeof(*p_chroma) );
+
+    struct
+    {
+        unsigned i_max_width, i_max_height;
+        int i_scale, i_outline_thickness, i_font_default_size;
+        int i_align, i_text_align, i_reg_max_width, i_reg_max_height;
+        bool b_balanced, b_grid, b_noregionbg;
+        vlc_fourcc_t i_forced_chroma;
+        unsigned i_sar_num, i_sar_den;
+        video_transfer_func_t transfer;
+        video_color_primaries_t primaries;
+        video_color_space_t space;
+    } params;
+    memset( &params, 0, sizeof(params) );
+    params.i_max_width = i_max_width;
+    params.i_max_height = i_max_height;
+    params.i_scale = p_sys->i_scale;
+    params.i_outline_thickness = p_sys->i_outline_thickness;
+    params.i_font_default_size = p_sys->i_font_default_size;
+    params.i_align = p_region_out->i_align;
+    params.i_text_align = p_region_out->i_text_align;
+    params.i_reg_max_width = p_region_in->i_max_width;
+    params.i_reg_max_height = p_region_in->i_max_height;
+    params.b_balanced = p_region_in->b_balanced_text;
+    params.b_grid = p_region_in->b_gridmode;
+    params.b_noregionbg = p_region_out->b_noregionbg;
+    params.i_forced_chroma = p_sys->i_forced_chroma;
+    params.i_sar_num = p_region_out->fmt.i_sar_num;
+    params.i_sar_den = p_region_out->fmt.i_sar_den;
+    params.transfer = p_region_out->fmt.transfer;
+    params.primaries = p_region_out->fmt.primaries;
+    params.space = p_region_out->fmt.space;
+    vlc_hash_md5_Update( &ctx, &params, sizeof(params) );
+
+    vlc_hash_FinishHex( &ctx, psz_key );
+}
+
 /**
  * This function renders a text subpicture region into another one.
  * It also calculates the size needed for this string, and renders the
@@ -1005,6 +1121,41 @@ static int Render( filter_t *p_filter, subpicture_region_t *p_region_out,
         p_sys->i_font_default_size = i_font_default_size;
     }
 
+    unsigned i_max_width = p_filter->fmt_out.video.i_visible_width;
+    if( p_region_in->i_max_width > 0 && (unsigned) p_region_in->i_max_width < i_max_width )
+        i_max_width = p_region_in->i_max_width;
+    else if( p_region_in->i_x > 0 && (unsigned)p_region_in->i_x < i_max_width )
+        i_max_width -= p_region_in->i_x;
+
+    unsigned i_max_height = p_filter->fmt_out.video.i_visible_height;
+    if( p_region_in->i_max_height > 0 && (unsigned) p_region_in->i_max_height < i_max_height )
+        i_max_height = p_region_in->i_max_height;
+    else if( p_region_in->i_y > 0 && (unsigned)p_region_in->i_y < i_max_height )
+        i_max_height -= p_region_in->i_y;
+
+    char psz_key[VLC_HASH_MD5_DIGEST_HEX_SIZE];
+    if( p_sys->region_cache )
+    {
+        RenderKey( p_filter, p_region_in, p_region_out, p_chroma_list,
+                   i_max_width, i_max_height, psz_key );
+
+        const rendered_region_t *p_cached =
+            vlc_lru_Get( p_sys->region_cache, psz_key );
+        if( p_cached )
+        {
+            /* Unchanged line: serve the previous rendering as is */
+            video_format_Clean( &p_region_out->fmt );
+            if( video_format_Copy( &p_region_out->fmt, &p_cached->fmt ) == VLC_SUCCESS )
+            {
+                p_region_out->p_picture = picture_Hold( p_cached->p_picture );
+                p_region_out->i_x = p_cached->i_x_delta + p_region_in->i_x;
+                p_region_out->i_y = p_cached->i_y_delta + p_region_in->i_y;
+                return VLC_SUCCESS;
+            }
+            /* Fall through and render again */
+        }
+    }
+
     layout_text_block_t text_block = { 0 };
     text_block.b_balanced = p_region_in->b_balanced_text;
     text_block.b_grid = p_region_in->b_gridmode;
@@ -1022,18 +1173,6 @@ static int Render( filter_t *p_filter, subpicture_region_t *p_region_out,
     FT_BBox bbox;
     int i_max_face_height;
 
-    unsigned i_max_width = p_filter->fmt_out.video.i_visible_width;
-    if( p_region_in->i_max_width > 0 && (unsigned) p_region_in->i_max_width < i_max_width )
-        i_max_width = p_region_in->i_max_width;
-    else if( p_region_in->i_x > 0 && (unsigned)p_region_in->i_x < i_max_width )
-        i_max_width -= p_region_in->i_x;
-
-    unsigned i_max_height = p_filter->fmt_out.video.i_visible_height;
-    if( p_region_in->i_max_height > 0 && (unsigned) p_region_in->i_max_height < i_max_height )
-        i_max_height = p_region_in->i_max_height;
-    else if( p_region_in->i_y > 0 && (unsigned)p_region_in->i_y < i_max_height )
-        i_max_height -= p_region_in->i_y;
-
     text_block.i_max_width = i_max_width;
     text_block.i_max_height = i_max_height;
     rv = LayoutTextBlock( p_filter, &text_block, &text_block.p_laid, &bbox, &i_max_face_height );
@@ -1183,6 +1322,23 @@ static int Render( filter_t *p_filter, subpicture_region_t *p_region_out,
         rv = VLC_EGENERIC;
     }
 
+    if( rv == VLC_SUCCESS && p_sys->region_cache )
+    {
+        rendered_region_t *p_cached = malloc( sizeof(*p_cached) );
+        if( p_cached )
+        {
+            if( video_format_Copy( &p_cached->fmt, &p_region_out->fmt ) == VLC_SUCCESS )
+            {
+                p_cached->p_picture = picture_Hold( p_region_out->p_picture );
+                p_cached->i_x_delta = p_region_out->i_x - p_region_in->i_x;
+                p_cached->i_y_delta = p_region_out->i_y - p_region_in->i_y;
+                vlc_lru_Insert( p_sys->region_cache, psz_key, p_cached );
+            }
+            else
+                free( p_cached );
+        }
+    }
+
     FreeLines( text_block.p_laid );
 
     free( text_block.p_uchars );
@@ -1231,6 +1387,10 @@ static int Create( filter_t *p_filter )
     if( !p_sys->ftcache )
         goto error;
 
+    /* Rendering can proceed without the cache on allocation failure */
+    p_sys->region_cache = vlc_lru_New( REGION_CACHE_SIZE,
+                                       ReleaseRenderedRegion, NULL );
+
     p_sys->i_scale = 100;
 
     /* default style to apply to incomplete segments styles */
@@ -1297,6 +1457,9 @@ static void Destroy( filter_t *p_filter )
         DumpFamilies( p_sys->fs );
 #endif
 
+    if( p_sys->region_cache )
+        vlc_lru_Release( p_sys->region_cache );
+
     if( p_sys->ftcache )
         vlc_ftcache_Delete( p_sys->ftcache );
 
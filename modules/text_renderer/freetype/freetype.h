@@ -73,6 +73,7 @@ typedef uint32_t uni_char_t;
 #endif
 
 #include "ftcache.h"
+#include "lru.h"
 
 typedef struct vlc_font_select_t vlc_font_select_t;
 
@@ -113,6 +114,10 @@ typedef struct
     vlc_font_select_t *fs;
     vlc_ftcache_t     *ftcache;
 
+    /* Rendered regions, keyed by a hash of the text, styles and render
+     * parameters, so unchanged lines are served without a layout pass */
+    vlc_lru           *region_cache;
+
 } filter_sys_t;
 
 /**
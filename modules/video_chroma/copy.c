@@ -51,28 +51,36 @@ static void CopyPlane(uint8_t *dst, size_t dst_pitch,
 #define ASSERT_3PLANES ASSERT_2PLANES; \
     ASSERT_PLANE(2)
 
-int CopyInitCache(copy_cache_t *cache, unsigned width)
+int CopyInitCacheThreaded(copy_cache_t *cache, unsigned width,
+                          vlc_plane_copier_t *copier)
 {
+    unsigned workers = copier ? vlc_plane_copier_GetWorkerCount(copier) : 1;
 #ifdef CAN_COMPILE_SSE2
-    cache->size = __MAX((width + 0x3f) & ~ 0x3f, 16384);
+    /* Each worker streams through its own chunk of the bounce buffer */
+    cache->size = __MAX((width + 0x3f) & ~ 0x3f, 16384) * workers;
     cache->buffer = aligned_alloc(64, cache->size);
     if (!cache->buffer)
         return VLC_EGENERIC;
 #else
-    (void) cache; (void) width;
+    (void) width; (void) workers;
 #endif
+    cache->copier = copier;
     return VLC_SUCCESS;
 }
 
+int CopyInitCache(copy_cache_t *cache, unsigned width)
+{
+    return CopyInitCacheThreaded(cache, width, NULL);
+}
+
 void CopyCleanCache(copy_cache_t *cache)
 {
 #ifdef CAN_COMPILE_SSE2
     aligned_free(cache->buffer);
     cache->buffer = NULL;
     cache->size   = 0;
-#else
-    (void) cache;
 #endif
+    cache->copier = NULL;
 }
 
 #ifdef CAN_COMPILE_SSE2
@@ -460,10 +468,10 @@ static void SSE_SplitUV(uint8_t *dstu, size_t dstu_pitch,
 #undef LOAD64
 }
 
-static void SSE_CopyPlane(uint8_t *dst, size_t dst_pitch,
-                          const uint8_t *src, size_t src_pitch,
-                          uint8_t *cache, size_t cache_size,
-                          unsigned height, int bitshift)
+static void SSE_CopyPlaneSingle(uint8_t *dst, size_t dst_pitch,
+                                const uint8_t *src, size_t src_pitch,
+                                uint8_t *cache, size_t cache_size,
+                                unsigned height, int bitshift)
 {
     const size_t copy_pitch = __MIN(src_pitch, dst_pitch);
     assert(copy_pitch > 0);
@@ -491,6 +499,57 @@ static void SSE_CopyPlane(uint8_t *dst, size_t dst_pitch,
     }
 }
 
+struct sse_copy_plane_job {
+    uint8_t *dst;
+    size_t dst_pitch;
+    const uint8_t *src;
+    size_t src_pitch;
+    uint8_t *cache;
+    size_t cache_size; /* per slice */
+    unsigned height;
+    int bitshift;
+};
+
+static void SSE_CopyPlaneSlice(void *opaque, unsigned slice, unsigned count)
+{
+    const struct sse_copy_plane_job *job = opaque;
+    const unsigned first = (uint64_t)job->height * slice / count;
+    const unsigned last = (uint64_t)job->height * (slice + 1) / count;
+
+    if (last <= first)
+        return;
+    SSE_CopyPlaneSingle(job->dst + (size_t)first * job->dst_pitch, job->dst_pitch,
+                        job->src + (size_t)first * job->src_pitch, job->src_pitch,
+                        job->cache + slice * job->cache_size, job->cache_size,
+                        last - first, job->bitshift);
+}
+
+static void SSE_CopyPlane(uint8_t *dst, size_t dst_pitch,
+                          const uint8_t *src, size_t src_pitch,
+                          const copy_cache_t *cache,
+                          unsigned height, int bitshift)
+{
+    if (cache->copier != NULL)
+    {
+        const unsigned count = vlc_plane_copier_GetWorkerCount(cache->copier);
+        /* Every slice streams through its own 64 bytes aligned chunk */
+        const size_t chunk = (cache->size / count) & ~(size_t)0x3f;
+        const unsigned w16 = (__MIN(src_pitch, dst_pitch) + 15) & ~15;
+
+        if (count > 1 && chunk >= w16 && height >= 16 * count)
+        {
+            struct sse_copy_plane_job job = {
+                dst, dst_pitch, src, src_pitch,
+                cache->buffer, chunk, height, bitshift,
+            };
+            vlc_plane_copier_Run(cache->copier, SSE_CopyPlaneSlice, &job);
+            return;
+        }
+    }
+    SSE_CopyPlaneSingle(dst, dst_pitch, src, src_pitch,
+                        cache->buffer, cache->size, height, bitshift);
+}
+
 static void
 SSE_InterleavePlanes(uint8_t *dst, size_t dst_pitch,
                      const uint8_t *srcu, size_t srcu_pitch,
@@ -563,8 +622,7 @@ static void SSE_Copy420_P_to_P(picture_t *dst, const uint8_t *src[static 3],
     for (unsigned n = 0; n < 3; n++) {
         const unsigned d = n > 0 ? 2 : 1;
         SSE_CopyPlane(dst->p[n].p_pixels, dst->p[n].i_pitch,
-                      src[n], src_pitch[n],
-                      cache->buffer, cache->size,
+                      src[n], src_pitch[n], cache,
                       (height+d-1)/d, 0);
     }
 }
@@ -575,9 +633,9 @@ static void SSE_Copy420_SP_to_SP(picture_t *dst, const uint8_t *src[static 2],
                                  const copy_cache_t *cache)
 {
     SSE_CopyPlane(dst->p[0].p_pixels, dst->p[0].i_pitch, src[0], src_pitch[0],
-                  cache->buffer, cache->size, height, 0);
+                  cache, height, 0);
     SSE_CopyPlane(dst->p[1].p_pixels, dst->p[1].i_pitch, src[1], src_pitch[1],
-                  cache->buffer, cache->size, (height+1) / 2, 0);
+                  cache, (height+1) / 2, 0);
 }
 
 static void
@@ -586,7 +644,7 @@ SSE_Copy420_SP_to_P(picture_t *dest, const uint8_t *src[static 2],
                     uint8_t pixel_size, int bitshift, const copy_cache_t *cache)
 {
     SSE_CopyPlane(dest->p[0].p_pixels, dest->p[0].i_pitch,
-                  src[0], src_pitch[0], cache->buffer, cache->size, height, bitshift);
+                  src[0], src_pitch[0], cache, height, bitshift);
 
     SSE_SplitPlanes(dest->p[1].p_pixels, dest->p[1].i_pitch,
                     dest->p[2].p_pixels, dest->p[2].i_pitch,
@@ -600,7 +658,7 @@ static void SSE_Copy420_P_to_SP(picture_t *dst, const uint8_t *src[static 3],
                                 int bitshift, const copy_cache_t *cache)
 {
     SSE_CopyPlane(dst->p[0].p_pixels, dst->p[0].i_pitch, src[0], src_pitch[0],
-                  cache->buffer, cache->size, height, bitshift);
+                  cache, height, bitshift);
     SSE_InterleavePlanes(dst->p[1].p_pixels, dst->p[1].i_pitch,
                          src[U_PLANE], src_pitch[U_PLANE],
                          src[V_PLANE], src_pitch[V_PLANE],
@@ -651,7 +709,7 @@ void CopyPacked(picture_t *dst, const uint8_t *src, const size_t src_pitch,
 #ifdef CAN_COMPILE_SSE2
     if (vlc_CPU_SSE4_1())
         return SSE_CopyPlane(dst->p[0].p_pixels, dst->p[0].i_pitch, src, src_pitch,
-                             cache->buffer, cache->size, height, 0);
+                             cache, height, 0);
 #else
     (void) cache;
 #endif
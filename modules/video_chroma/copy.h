@@ -33,12 +33,17 @@ typedef struct {
 # ifdef CAN_COMPILE_SSE2
     uint8_t *buffer;
     size_t  size;
-# else
-    char dummy;
 # endif
+    /* Optional worker pool slicing the plane copies, NULL to copy from the
+     * calling thread only. Not owned by the cache. */
+    vlc_plane_copier_t *copier;
 } copy_cache_t;
 
 int  CopyInitCache(copy_cache_t *cache, unsigned width);
+/* Same as CopyInitCache(), with a bounce buffer large enough for every
+ * worker of the copier to stream its own slice */
+int  CopyInitCacheThreaded(copy_cache_t *cache, unsigned width,
+                           vlc_plane_copier_t *copier);
 void CopyCleanCache(copy_cache_t *cache);
 
 /* YUVY/RGB copies */
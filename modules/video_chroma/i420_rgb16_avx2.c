@@ -0,0 +1,384 @@
+/*****************************************************************************
+ * i420_rgb16_avx2.c : YUV to bitmap RGB conversion module for vlc
+ *****************************************************************************
+ * Copyright (C) 2000-2024 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <vlc_common.h>
+#include <vlc_filter.h>
+#include <vlc_picture.h>
+#include <vlc_cpu.h>
+
+#include "i420_rgb.h"
+#ifdef PLUGIN_AVX2
+# include "i420_rgb_avx2.h"
+# define VLC_TARGET VLC_AVX2
+#endif
+
+/*****************************************************************************
+ * SetOffset: build offset array for conversion functions
+ *****************************************************************************
+ * This function will build an offset array used in later conversion functions.
+ * It will also set horizontal and vertical scaling indicators.
+ *****************************************************************************/
+static void SetOffset( int i_width, int i_height, int i_pic_width,
+                       int i_pic_height, bool *pb_hscale,
+                       unsigned int *pi_vscale, int *p_offset )
+{
+    /*
+     * Prepare horizontal offset array
+     */
+    if( i_pic_width - i_width == 0 )
+    {   /* No horizontal scaling: YUV conversion is done directly to picture */
+        *pb_hscale = 0;
+    }
+    else if( i_pic_width - i_width > 0 )
+    {   /* Prepare scaling array for horizontal extension */
+        int i_scale_count = i_pic_width;
+
+        *pb_hscale = 1;
+        for( int i_x = i_width; i_x--; )
+        {
+            while( (i_scale_count -= i_width) > 0 )
+            {
+                *p_offset++ = 0;
+            }
+            *p_offset++ = 1;
+            i_scale_count += i_pic_width;
+        }
+    }
+    else /* if( i_pic_width - i_width < 0 ) */
+    {   /* Prepare scaling array for horizontal reduction */
+        int i_scale_count = i_pic_width;
+
+        *pb_hscale = 1;
+        for( int i_x = i_pic_width; i_x--; )
+        {
+            *p_offset = 1;
+            while( (i_scale_count -= i_pic_width) > 0 )
+            {
+                *p_offset += 1;
+            }
+            p_offset++;
+            i_scale_count += i_width;
+        }
+    }
+
+    /*
+     * Set vertical scaling indicator
+     */
+    if( i_pic_height - i_height == 0 )
+        *pi_vscale = 0;
+    else if( i_pic_height - i_height > 0 )
+        *pi_vscale = 1;
+    else /* if( i_pic_height - i_height < 0 ) */
+        *pi_vscale = -1;
+}
+
+/* All conversion functions share the same skeleton: 32 pixels per AVX2
+ * iteration, trailing pixels handled by rewinding the source pointers and
+ * redoing unaligned conversions over the last complete vector. */
+#define AVX2_CONVERSION( INIT, UNPACK, BPP )                                \
+    i_rewind = (-(p_filter->fmt_in.video.i_x_offset +                       \
+                  p_filter->fmt_in.video.i_visible_width)) & 31;            \
+                                                                            \
+    p_buffer = b_hscale ? p_buffer_start : p_pic;                           \
+                                                                            \
+    for( i_y = 0; i_y < (p_filter->fmt_in.video.i_y_offset +                \
+                         p_filter->fmt_in.video.i_visible_height); i_y++ )  \
+    {                                                                       \
+        p_pic_start = p_pic;                                                \
+                                                                            \
+        for ( i_x = (p_filter->fmt_in.video.i_x_offset +                    \
+                     p_filter->fmt_in.video.i_visible_width)/32; i_x--; )   \
+        {                                                                   \
+            AVX2_CALL (                                                     \
+                INIT                                                        \
+                AVX2_YUV_MUL                                                \
+                AVX2_YUV_ADD                                                \
+                UNPACK                                                      \
+            );                                                              \
+            p_y += 32;                                                      \
+            p_u += 16;                                                      \
+            p_v += 16;                                                      \
+            p_buffer += 32;                                                 \
+        }                                                                   \
+        /* Here we do some unaligned reads and duplicate conversions, but   \
+         * at least we have all the pixels */                               \
+        if( i_rewind )                                                      \
+        {                                                                   \
+            p_y -= i_rewind;                                                \
+            p_u -= i_rewind >> 1;                                           \
+            p_v -= i_rewind >> 1;                                           \
+            p_buffer -= i_rewind;                                           \
+                                                                            \
+            AVX2_CALL (                                                     \
+                INIT                                                        \
+                AVX2_YUV_MUL                                                \
+                AVX2_YUV_ADD                                                \
+                UNPACK                                                      \
+            );                                                              \
+            p_y += 32;                                                      \
+            p_u += 16;                                                      \
+            p_v += 16;                                                      \
+        }                                                                   \
+        SCALE_WIDTH;                                                        \
+        SCALE_HEIGHT( 420, BPP );                                           \
+                                                                            \
+        p_y += i_source_margin;                                             \
+        if( i_y % 2 )                                                       \
+        {                                                                   \
+            p_u += i_source_margin_c;                                       \
+            p_v += i_source_margin_c;                                       \
+        }                                                                   \
+        p_buffer = b_hscale ? p_buffer_start : p_pic;                       \
+    }                                                                       \
+                                                                            \
+    /* make sure all AVX2 stores are visible thereafter */                  \
+    AVX2_END;
+
+VLC_TARGET
+void I420_R5G5B5( filter_t *p_filter, picture_t *p_src, picture_t *p_dest )
+{
+    filter_sys_t *p_sys = p_filter->p_sys;
+
+    /* We got this one from the old arguments */
+    uint16_t *p_pic = (uint16_t*)p_dest->p->p_pixels;
+    uint8_t  *p_y   = p_src->Y_PIXELS;
+    uint8_t  *p_u   = p_src->U_PIXELS;
+    uint8_t  *p_v   = p_src->V_PIXELS;
+
+    bool  b_hscale;                         /* horizontal scaling type */
+    unsigned int i_vscale;                          /* vertical scaling type */
+    unsigned int i_x, i_y;                /* horizontal and vertical indexes */
+
+    int         i_right_margin;
+    int         i_rewind;
+    int         i_scale_count;                       /* scale modulo counter */
+    int         i_chroma_width = (p_filter->fmt_in.video.i_x_offset + p_filter->fmt_in.video.i_visible_width) / 2; /* chroma width */
+    uint16_t *  p_pic_start;       /* beginning of the current line for copy */
+
+    /* Conversion buffer pointer */
+    uint16_t *  p_buffer_start;
+    uint16_t *  p_buffer;
+
+    /* Offset array pointer */
+    int *       p_offset_start = p_sys->p_offset;
+    int *       p_offset;
+
+    const int i_source_margin = p_src->p[0].i_pitch
+                                 - p_src->p[0].i_visible_pitch
+                                 - p_filter->fmt_in.video.i_x_offset;
+    const int i_source_margin_c = p_src->p[1].i_pitch
+                                 - p_src->p[1].i_visible_pitch
+                                 - ( p_filter->fmt_in.video.i_x_offset / 2 );
+
+    i_right_margin = p_dest->p->i_pitch - p_dest->p->i_visible_pitch;
+
+    /* Rule: when a picture of size (x1,y1) with aspect ratio r1 is rendered
+     * on a picture of size (x2,y2) with aspect ratio r2, if x1 grows to x1'
+     * then y1 grows to y1' = x1' * y2/x2 * r2/r1 */
+    SetOffset( (p_filter->fmt_in.video.i_x_offset + p_filter->fmt_in.video.i_visible_width),
+               (p_filter->fmt_in.video.i_y_offset + p_filter->fmt_in.video.i_visible_height),
+               (p_filter->fmt_out.video.i_x_offset + p_filter->fmt_out.video.i_visible_width),
+               (p_filter->fmt_out.video.i_y_offset + p_filter->fmt_out.video.i_visible_height),
+               &b_hscale, &i_vscale, p_offset_start );
+
+    if(b_hscale &&
+       AllocateOrGrow(&p_sys->p_buffer, &p_sys->i_buffer_size,
+                      p_filter->fmt_in.video.i_x_offset +
+                      p_filter->fmt_in.video.i_visible_width,
+                      p_sys->i_bytespp))
+        return;
+    else p_buffer_start = (uint16_t*)p_sys->p_buffer;
+
+    /*
+     * Perform conversion
+     */
+    i_scale_count = ( i_vscale == 1 ) ?
+                    (p_filter->fmt_out.video.i_y_offset + p_filter->fmt_out.video.i_visible_height) :
+                    (p_filter->fmt_in.video.i_y_offset + p_filter->fmt_in.video.i_visible_height);
+
+#ifdef PLUGIN_AVX2
+    AVX2_CONVERSION( AVX2_INIT_16, AVX2_UNPACK_15, 2 );
+#endif
+}
+
+VLC_TARGET
+void I420_R5G6B5( filter_t *p_filter, picture_t *p_src, picture_t *p_dest )
+{
+    filter_sys_t *p_sys = p_filter->p_sys;
+
+    /* We got this one from the old arguments */
+    uint16_t *p_pic = (uint16_t*)p_dest->p->p_pixels;
+    uint8_t  *p_y   = p_src->Y_PIXELS;
+    uint8_t  *p_u   = p_src->U_PIXELS;
+    uint8_t  *p_v   = p_src->V_PIXELS;
+
+    bool  b_hscale;                         /* horizontal scaling type */
+    unsigned int i_vscale;                          /* vertical scaling type */
+    unsigned int i_x, i_y;                /* horizontal and vertical indexes */
+
+    int         i_right_margin;
+    int         i_rewind;
+    int         i_scale_count;                       /* scale modulo counter */
+    int         i_chroma_width = (p_filter->fmt_in.video.i_x_offset + p_filter->fmt_in.video.i_visible_width) / 2; /* chroma width */
+    uint16_t *  p_pic_start;       /* beginning of the current line for copy */
+
+    /* Conversion buffer pointer */
+    uint16_t *  p_buffer_start;
+    uint16_t *  p_buffer;
+
+    /* Offset array pointer */
+    int *       p_offset_start = p_sys->p_offset;
+    int *       p_offset;
+
+    const int i_source_margin = p_src->p[0].i_pitch
+                                 - p_src->p[0].i_visible_pitch
+                                 - p_filter->fmt_in.video.i_x_offset;
+    const int i_source_margin_c = p_src->p[1].i_pitch
+                                 - p_src->p[1].i_visible_pitch
+                                 - ( p_filter->fmt_in.video.i_x_offset / 2 );
+
+    i_right_margin = p_dest->p->i_pitch - p_dest->p->i_visible_pitch;
+
+    /* Rule: when a picture of size (x1,y1) with aspect ratio r1 is rendered
+     * on a picture of size (x2,y2) with aspect ratio r2, if x1 grows to x1'
+     * then y1 grows to y1' = x1' * y2/x2 * r2/r1 */
+    SetOffset( (p_filter->fmt_in.video.i_x_offset + p_filter->fmt_in.video.i_visible_width),
+               (p_filter->fmt_in.video.i_y_offset + p_filter->fmt_in.video.i_visible_height),
+               (p_filter->fmt_out.video.i_x_offset + p_filter->fmt_out.video.i_visible_width),
+               (p_filter->fmt_out.video.i_y_offset + p_filter->fmt_out.video.i_visible_height),
+               &b_hscale, &i_vscale, p_offset_start );
+
+    if(b_hscale &&
+       AllocateOrGrow(&p_sys->p_buffer, &p_sys->i_buffer_size,
+                      p_filter->fmt_in.video.i_x_offset +
+                      p_filter->fmt_in.video.i_visible_width,
+                      p_sys->i_bytespp))
+        return;
+    else p_buffer_start = (uint16_t*)p_sys->p_buffer;
+
+    /*
+     * Perform conversion
+     */
+    i_scale_count = ( i_vscale == 1 ) ?
+                    (p_filter->fmt_out.video.i_y_offset + p_filter->fmt_out.video.i_visible_height) :
+                    (p_filter->fmt_in.video.i_y_offset + p_filter->fmt_in.video.i_visible_height);
+
+#ifdef PLUGIN_AVX2
+    AVX2_CONVERSION( AVX2_INIT_16, AVX2_UNPACK_16, 2 );
+#endif
+}
+
+#define I420_RGB32_COMMON( UNPACK )                                          \
+    filter_sys_t *p_sys = p_filter->p_sys;                                   \
+                                                                             \
+    /* We got this one from the old arguments */                             \
+    uint32_t *p_pic = (uint32_t*)p_dest->p->p_pixels;                        \
+    uint8_t  *p_y   = p_src->Y_PIXELS;                                       \
+    uint8_t  *p_u   = p_src->U_PIXELS;                                       \
+    uint8_t  *p_v   = p_src->V_PIXELS;                                       \
+                                                                             \
+    bool  b_hscale;                         /* horizontal scaling type */    \
+    unsigned int i_vscale;                       /* vertical scaling type */ \
+    unsigned int i_x, i_y;             /* horizontal and vertical indexes */ \
+                                                                             \
+    int         i_right_margin;                                              \
+    int         i_rewind;                                                    \
+    int         i_scale_count;                    /* scale modulo counter */ \
+    int         i_chroma_width = (p_filter->fmt_in.video.i_x_offset + p_filter->fmt_in.video.i_visible_width) / 2; /* chroma width */ \
+    uint32_t *  p_pic_start;    /* beginning of the current line for copy */ \
+                                                                             \
+    /* Conversion buffer pointer */                                          \
+    uint32_t *  p_buffer_start;                                              \
+    uint32_t *  p_buffer;                                                    \
+                                                                             \
+    /* Offset array pointer */                                               \
+    int *       p_offset_start = p_sys->p_offset;                            \
+    int *       p_offset;                                                    \
+                                                                             \
+    const int i_source_margin = p_src->p[0].i_pitch                          \
+                                 - p_src->p[0].i_visible_pitch               \
+                                 - p_filter->fmt_in.video.i_x_offset;        \
+    const int i_source_margin_c = p_src->p[1].i_pitch                        \
+                                 - p_src->p[1].i_visible_pitch               \
+                                 - ( p_filter->fmt_in.video.i_x_offset / 2 ); \
+                                                                             \
+    i_right_margin = p_dest->p->i_pitch - p_dest->p->i_visible_pitch;        \
+                                                                             \
+    /* Rule: when a picture of size (x1,y1) with aspect ratio r1 is rendered \
+     * on a picture of size (x2,y2) with aspect ratio r2, if x1 grows to x1' \
+     * then y1 grows to y1' = x1' * y2/x2 * r2/r1 */                         \
+    SetOffset( (p_filter->fmt_in.video.i_x_offset + p_filter->fmt_in.video.i_visible_width), \
+               (p_filter->fmt_in.video.i_y_offset + p_filter->fmt_in.video.i_visible_height), \
+               (p_filter->fmt_out.video.i_x_offset + p_filter->fmt_out.video.i_visible_width), \
+               (p_filter->fmt_out.video.i_y_offset + p_filter->fmt_out.video.i_visible_height), \
+               &b_hscale, &i_vscale, p_offset_start );                       \
+                                                                             \
+    if(b_hscale &&                                                           \
+       AllocateOrGrow(&p_sys->p_buffer, &p_sys->i_buffer_size,               \
+                      p_filter->fmt_in.video.i_x_offset +                    \
+                      p_filter->fmt_in.video.i_visible_width,                \
+                      p_sys->i_bytespp))                                     \
+        return;                                                              \
+    else p_buffer_start = (uint32_t*)p_sys->p_buffer;                        \
+                                                                             \
+    /*                                                                       \
+     * Perform conversion                                                    \
+     */                                                                      \
+    i_scale_count = ( i_vscale == 1 ) ?                                      \
+                    (p_filter->fmt_out.video.i_y_offset + p_filter->fmt_out.video.i_visible_height) : \
+                    (p_filter->fmt_in.video.i_y_offset + p_filter->fmt_in.video.i_visible_height); \
+                                                                             \
+    AVX2_CONVERSION( AVX2_INIT_32, UNPACK, 4 );
+
+VLC_TARGET
+void I420_A8R8G8B8( filter_t *p_filter, picture_t *p_src, picture_t *p_dest )
+{
+#ifdef PLUGIN_AVX2
+    I420_RGB32_COMMON( AVX2_UNPACK_32_ARGB );
+#endif
+}
+
+VLC_TARGET
+void I420_R8G8B8A8( filter_t *p_filter, picture_t *p_src, picture_t *p_dest )
+{
+#ifdef PLUGIN_AVX2
+    I420_RGB32_COMMON( AVX2_UNPACK_32_RGBA );
+#endif
+}
+
+VLC_TARGET
+void I420_B8G8R8A8( filter_t *p_filter, picture_t *p_src, picture_t *p_dest )
+{
+#ifdef PLUGIN_AVX2
+    I420_RGB32_COMMON( AVX2_UNPACK_32_BGRA );
+#endif
+}
+
+VLC_TARGET
+void I420_A8B8G8R8( filter_t *p_filter, picture_t *p_src, picture_t *p_dest )
+{
+#ifdef PLUGIN_AVX2
+    I420_RGB32_COMMON( AVX2_UNPACK_32_ABGR );
+#endif
+}
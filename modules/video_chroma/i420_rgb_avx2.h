@@ -0,0 +1,154 @@
+/*****************************************************************************
+ * i420_rgb_avx2.h: AVX2 YUV transformation intrinsics
+ *****************************************************************************
+ * Copyright (C) 1999-2024 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+#ifdef HAVE_AVX2_INTRINSICS
+
+/* AVX2 intrinsics, converting 32 pixels per iteration.
+ *
+ * The math is strictly the one of i420_rgb_sse2.h, promoted to 256 bits
+ * wide registers: the luma vector holds 32 Y samples, the chroma vectors
+ * hold one 16 bits word per pair of pixels, and the per-channel results
+ * are repacked to pixel order before store.  Only unaligned fetch/store
+ * forms are used, the penalty for them is negligible on AVX2 hardware. */
+
+#include <immintrin.h>
+
+#if defined(__AVX2__)
+# define VLC_AVX2
+#else
+# define VLC_AVX2 __attribute__ ((__target__ ("avx2")))
+#endif
+
+#define AVX2_CALL(AVX2_INSTRUCTIONS)        \
+    do {                                    \
+        __m256i y_even, y_odd;              \
+        __m256i c_blue, c_green, c_red;     \
+        __m256i b8, g8, r8;                 \
+        __m256i t0, t1, t2, t3;             \
+        AVX2_INSTRUCTIONS                   \
+    } while(0)
+
+#define AVX2_END  _mm_sfence()
+
+#define AVX2_INIT_16                                                        \
+    c_blue = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)p_u));   \
+    c_red  = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)p_v));   \
+    y_even = _mm256_loadu_si256((const __m256i *)p_y);                      \
+    _mm_prefetch((const char *)p_buffer, _MM_HINT_NTA);
+
+#define AVX2_INIT_32 AVX2_INIT_16
+
+#define AVX2_YUV_MUL                                                        \
+    /* convert the chroma part */                                           \
+    c_blue  = _mm256_slli_epi16(_mm256_subs_epi16(c_blue,                   \
+                  _mm256_set1_epi16(0x0080)), 3);                           \
+    c_red   = _mm256_slli_epi16(_mm256_subs_epi16(c_red,                    \
+                  _mm256_set1_epi16(0x0080)), 3);                           \
+    c_green = _mm256_adds_epi16(                                            \
+                  _mm256_mulhi_epi16(c_blue,                                \
+                      _mm256_set1_epi16((int16_t)0xf37d)),                  \
+                  _mm256_mulhi_epi16(c_red,                                 \
+                      _mm256_set1_epi16((int16_t)0xe5fc)));                 \
+    c_blue  = _mm256_mulhi_epi16(c_blue, _mm256_set1_epi16(0x4093));        \
+    c_red   = _mm256_mulhi_epi16(c_red,  _mm256_set1_epi16(0x3312));        \
+    /* convert the luma part */                                             \
+    y_even  = _mm256_subs_epu8(y_even, _mm256_set1_epi8(0x10));             \
+    y_odd   = _mm256_srli_epi16(y_even, 8);                                 \
+    y_even  = _mm256_and_si256(y_even, _mm256_set1_epi16(0x00ff));          \
+    y_even  = _mm256_mulhi_epi16(_mm256_slli_epi16(y_even, 3),              \
+                                 _mm256_set1_epi16(0x253f));                \
+    y_odd   = _mm256_mulhi_epi16(_mm256_slli_epi16(y_odd, 3),               \
+                                 _mm256_set1_epi16(0x253f));
+
+/* Add luma, limit to 0..255 and interleave even and odd pixels back to
+ * pixel order, leaving one byte per pixel in each channel vector */
+#define AVX2_CHANNEL(dst, chroma)                                           \
+    dst = _mm256_packus_epi16(                                              \
+        _mm256_unpacklo_epi16(_mm256_adds_epi16(chroma, y_even),            \
+                              _mm256_adds_epi16(chroma, y_odd)),            \
+        _mm256_unpackhi_epi16(_mm256_adds_epi16(chroma, y_even),            \
+                              _mm256_adds_epi16(chroma, y_odd)));
+
+#define AVX2_YUV_ADD                                                        \
+    AVX2_CHANNEL(b8, c_blue)                                                \
+    AVX2_CHANNEL(g8, c_green)                                               \
+    AVX2_CHANNEL(r8, c_red)
+
+/* Pack to 15/16 bits per pixel, green mask/shift makes the difference.
+ * t0/t1 accumulate the low/high pixel halves, t2 is a channel scratch. */
+#define AVX2_UNPACK_16_GENERIC(GMASK, GSHIFT, RSHIFT)                       \
+    t3 = _mm256_setzero_si256();                                            \
+    t2 = _mm256_unpacklo_epi8(b8, t3);                                      \
+    t0 = _mm256_srli_epi16(_mm256_and_si256(t2,                             \
+             _mm256_set1_epi16(0x00f8)), 3);                                \
+    t2 = _mm256_unpackhi_epi8(b8, t3);                                      \
+    t1 = _mm256_srli_epi16(_mm256_and_si256(t2,                             \
+             _mm256_set1_epi16(0x00f8)), 3);                                \
+    t2 = _mm256_unpacklo_epi8(g8, t3);                                      \
+    t0 = _mm256_or_si256(t0, _mm256_slli_epi16(_mm256_and_si256(t2,         \
+             _mm256_set1_epi16(GMASK)), GSHIFT));                           \
+    t2 = _mm256_unpackhi_epi8(g8, t3);                                      \
+    t1 = _mm256_or_si256(t1, _mm256_slli_epi16(_mm256_and_si256(t2,         \
+             _mm256_set1_epi16(GMASK)), GSHIFT));                           \
+    t2 = _mm256_unpacklo_epi8(r8, t3);                                      \
+    t0 = _mm256_or_si256(t0, _mm256_slli_epi16(_mm256_and_si256(t2,         \
+             _mm256_set1_epi16(0x00f8)), RSHIFT));                          \
+    t2 = _mm256_unpackhi_epi8(r8, t3);                                      \
+    t1 = _mm256_or_si256(t1, _mm256_slli_epi16(_mm256_and_si256(t2,         \
+             _mm256_set1_epi16(0x00f8)), RSHIFT));                          \
+    /* t0 holds pixels 0-7|16-23, t1 8-15|24-31 */                          \
+    _mm256_storeu_si256((__m256i *)p_buffer,                                \
+                        _mm256_permute2x128_si256(t0, t1, 0x20));           \
+    _mm256_storeu_si256((__m256i *)(p_buffer + 16),                         \
+                        _mm256_permute2x128_si256(t0, t1, 0x31));
+
+#define AVX2_UNPACK_15 AVX2_UNPACK_16_GENERIC(0x00f8, 2, 7)
+#define AVX2_UNPACK_16 AVX2_UNPACK_16_GENERIC(0x00fc, 3, 8)
+
+/* Interleave the four byte channels, in memory order, to 32 bits pixels.
+ * The channel registers are dead once t0..t3 are built and get recycled
+ * as quadword holders. */
+#define AVX2_UNPACK_32_GENERIC(C0, C1, C2, C3)                              \
+    t0 = _mm256_unpacklo_epi8(C0, C1);                                      \
+    t1 = _mm256_unpackhi_epi8(C0, C1);                                      \
+    t2 = _mm256_unpacklo_epi8(C2, C3);                                      \
+    t3 = _mm256_unpackhi_epi8(C2, C3);                                      \
+    b8 = _mm256_unpacklo_epi16(t0, t2); /* px  0-3 |16-19 */                \
+    g8 = _mm256_unpackhi_epi16(t0, t2); /* px  4-7 |20-23 */                \
+    r8 = _mm256_unpacklo_epi16(t1, t3); /* px  8-11|24-27 */                \
+    t0 = _mm256_unpackhi_epi16(t1, t3); /* px 12-15|28-31 */                \
+    _mm256_storeu_si256((__m256i *)p_buffer,                                \
+                        _mm256_permute2x128_si256(b8, g8, 0x20));           \
+    _mm256_storeu_si256((__m256i *)(p_buffer + 8),                          \
+                        _mm256_permute2x128_si256(r8, t0, 0x20));           \
+    _mm256_storeu_si256((__m256i *)(p_buffer + 16),                         \
+                        _mm256_permute2x128_si256(b8, g8, 0x31));           \
+    _mm256_storeu_si256((__m256i *)(p_buffer + 24),                         \
+                        _mm256_permute2x128_si256(r8, t0, 0x31));
+
+#define AVX2_UNPACK_32_ARGB \
+    AVX2_UNPACK_32_GENERIC(b8, g8, r8, _mm256_setzero_si256())
+#define AVX2_UNPACK_32_RGBA \
+    AVX2_UNPACK_32_GENERIC(_mm256_setzero_si256(), b8, g8, r8)
+#define AVX2_UNPACK_32_BGRA \
+    AVX2_UNPACK_32_GENERIC(_mm256_setzero_si256(), r8, g8, b8)
+#define AVX2_UNPACK_32_ABGR \
+    AVX2_UNPACK_32_GENERIC(r8, g8, b8, _mm256_setzero_si256())
+
+#endif
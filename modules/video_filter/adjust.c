@@ -219,63 +219,9 @@ static void Destroy( filter_t *p_filter )
 /*****************************************************************************
  * Run the filter on a Planar YUV picture
  *****************************************************************************/
-static void FilterPlanar( filter_t *p_filter, picture_t *p_pic, picture_t *p_outpic )
+static void FilterPlanarLuma( picture_t *p_pic, picture_t *p_outpic,
+                              const int *pi_luma, bool b_16bit )
 {
-    /* The full range will only be used for 10-bit */
-    int pi_luma[1024];
-    int pi_gamma[1024];
-
-    filter_sys_t *p_sys = p_filter->p_sys;
-
-    bool b_16bit;
-    float f_range;
-    switch( p_filter->fmt_in.video.i_chroma )
-    {
-        CASE_PLANAR_YUV10
-            b_16bit = true;
-            f_range = 1024.f;
-            break;
-        CASE_PLANAR_YUV9
-            b_16bit = true;
-            f_range = 512.f;
-            break;
-        default:
-            b_16bit = false;
-            f_range = 256.f;
-    }
-
-    const float f_max = f_range - 1.f;
-    const unsigned i_max = f_max;
-    const int i_range = f_range;
-    const unsigned i_size = i_range;
-    const unsigned i_mid = i_range >> 1;
-
-    /* Get variables */
-    int32_t i_cont = lroundf( atomic_load_explicit( &p_sys->f_contrast, memory_order_relaxed ) * f_max );
-    int32_t i_lum = lroundf( (atomic_load_explicit( &p_sys->f_brightness, memory_order_relaxed ) - 1.f) * f_max );
-    float f_hue = atomic_load_explicit( &p_sys->f_hue, memory_order_relaxed ) * (float)(M_PI / 180.);
-    int i_sat = (int)( atomic_load_explicit( &p_sys->f_saturation, memory_order_relaxed ) * f_range );
-    float f_gamma = 1.f / atomic_load_explicit( &p_sys->f_gamma, memory_order_relaxed );
-
-    /* Contrast is a fast but kludged function, so I put this gap to be
-     * cleaner :) */
-    i_lum += i_mid - i_cont / 2;
-
-    /* Fill the gamma lookup table */
-    for( unsigned i = 0 ; i < i_size; i++ )
-    {
-        pi_gamma[ i ] = VLC_CLIP( powf(i / f_max, f_gamma) * f_max, 0, i_max );
-    }
-
-    /* Fill the luma lookup table */
-    for( unsigned i = 0 ; i < i_size; i++ )
-    {
-        pi_luma[ i ] = pi_gamma[VLC_CLIP( (int)(i_lum + i_cont * i / i_range), 0, (int) i_max )];
-    }
-
-    /*
-     * Do the Y plane
-     */
     if ( b_16bit )
     {
         uint16_t *p_in, *p_in_end, *p_line_end;
@@ -348,32 +294,117 @@ static void FilterPlanar( filter_t *p_filter, picture_t *p_pic, picture_t *p_out
                    - p_outpic->p[Y_PLANE].i_visible_pitch;
         }
     }
+}
 
-    /*
-     * Do the U and V planes
-     */
+struct adjust_job
+{
+    filter_sys_t *p_sys;
+    picture_t *p_pic;
+    picture_t *p_outpic;
+    const int *pi_luma;
+    bool b_16bit;
+    bool b_clip;
+    int i_sin, i_cos, i_sat, i_x, i_y;
+};
+
+static void FilterPlanarSlice( void *opaque, unsigned i_slice, unsigned i_count )
+{
+    const struct adjust_job *p_job = opaque;
+    picture_t in_band, out_band;
+
+    PictureBand( &in_band, p_job->p_pic, i_slice, i_count );
+    PictureBand( &out_band, p_job->p_outpic, i_slice, i_count );
+
+    FilterPlanarLuma( &in_band, &out_band, p_job->pi_luma, p_job->b_16bit );
+
+    /* Currently no errors are implemented in the functions, if any are added
+     * check them here */
+    if ( p_job->b_clip )
+        p_job->p_sys->pf_process_sat_hue_clip( &in_band, &out_band,
+                                               p_job->i_sin, p_job->i_cos,
+                                               p_job->i_sat,
+                                               p_job->i_x, p_job->i_y );
+    else
+        p_job->p_sys->pf_process_sat_hue( &in_band, &out_band,
+                                          p_job->i_sin, p_job->i_cos,
+                                          p_job->i_sat,
+                                          p_job->i_x, p_job->i_y );
+}
 
-    int i_sin = sinf(f_hue) * f_max;
-    int i_cos = cosf(f_hue) * f_max;
+static void FilterPlanar( filter_t *p_filter, picture_t *p_pic, picture_t *p_outpic )
+{
+    /* The full range will only be used for 10-bit */
+    int pi_luma[1024];
+    int pi_gamma[1024];
 
-    /* pow(2, (bpp * 2) - 1) */
-    int i_x = ( cosf(f_hue) + sinf(f_hue) ) * f_range * i_mid;
-    int i_y = ( cosf(f_hue) - sinf(f_hue) ) * f_range * i_mid;
+    filter_sys_t *p_sys = p_filter->p_sys;
 
-    if ( i_sat > i_range )
+    bool b_16bit;
+    float f_range;
+    switch( p_filter->fmt_in.video.i_chroma )
     {
-        /* Currently no errors are implemented in the function, if any are added
-         * check them here */
-        p_sys->pf_process_sat_hue_clip( p_pic, p_outpic, i_sin, i_cos, i_sat,
-                                        i_x, i_y );
+        CASE_PLANAR_YUV10
+            b_16bit = true;
+            f_range = 1024.f;
+            break;
+        CASE_PLANAR_YUV9
+            b_16bit = true;
+            f_range = 512.f;
+            break;
+        default:
+            b_16bit = false;
+            f_range = 256.f;
     }
-    else
+
+    const float f_max = f_range - 1.f;
+    const unsigned i_max = f_max;
+    const int i_range = f_range;
+    const unsigned i_size = i_range;
+    const unsigned i_mid = i_range >> 1;
+
+    /* Get variables */
+    int32_t i_cont = lroundf( atomic_load_explicit( &p_sys->f_contrast, memory_order_relaxed ) * f_max );
+    int32_t i_lum = lroundf( (atomic_load_explicit( &p_sys->f_brightness, memory_order_relaxed ) - 1.f) * f_max );
+    float f_hue = atomic_load_explicit( &p_sys->f_hue, memory_order_relaxed ) * (float)(M_PI / 180.);
+    int i_sat = (int)( atomic_load_explicit( &p_sys->f_saturation, memory_order_relaxed ) * f_range );
+    float f_gamma = 1.f / atomic_load_explicit( &p_sys->f_gamma, memory_order_relaxed );
+
+    /* Contrast is a fast but kludged function, so I put this gap to be
+     * cleaner :) */
+    i_lum += i_mid - i_cont / 2;
+
+    /* Fill the gamma lookup table */
+    for( unsigned i = 0 ; i < i_size; i++ )
     {
-        /* Currently no errors are implemented in the function, if any are added
-         * check them here */
-        p_sys->pf_process_sat_hue( p_pic, p_outpic, i_sin, i_cos, i_sat,
-                                        i_x, i_y );
+        pi_gamma[ i ] = VLC_CLIP( powf(i / f_max, f_gamma) * f_max, 0, i_max );
     }
+
+    /* Fill the luma lookup table */
+    for( unsigned i = 0 ; i < i_size; i++ )
+    {
+        pi_luma[ i ] = pi_gamma[VLC_CLIP( (int)(i_lum + i_cont * i / i_range), 0, (int) i_max )];
+    }
+
+    /*
+     * Do the Y, U and V planes, split in horizontal bands over the shared
+     * filter worker pool. Every band only touches its own rows.
+     */
+    struct adjust_job job = {
+        .p_sys = p_sys,
+        .p_pic = p_pic,
+        .p_outpic = p_outpic,
+        .pi_luma = pi_luma,
+        .b_16bit = b_16bit,
+        .b_clip = i_sat > i_range,
+        .i_sin = sinf(f_hue) * f_max,
+        .i_cos = cosf(f_hue) * f_max,
+        .i_sat = i_sat,
+        /* pow(2, (bpp * 2) - 1) */
+        .i_x = ( cosf(f_hue) + sinf(f_hue) ) * f_range * i_mid,
+        .i_y = ( cosf(f_hue) - sinf(f_hue) ) * f_range * i_mid,
+    };
+
+    filter_RunSlices( p_filter, FilterPlanarSlice, &job );
 }
 
 /*****************************************************************************
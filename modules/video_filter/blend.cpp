@@ -31,8 +31,18 @@
 #include <vlc_plugin.h>
 #include <vlc_filter.h>
 #include <vlc_picture.h>
+#include <vlc_cpu.h>
 #include "filter_picture.h"
 
+#ifdef CAN_COMPILE_SSE2
+# include <emmintrin.h>
+# if defined(__SSE2__)
+#  define VLC_BLEND_SSE2
+# else
+#  define VLC_BLEND_SSE2 __attribute__ ((__target__ ("sse2")))
+# endif
+#endif
+
 /*****************************************************************************
  * Module descriptor
  *****************************************************************************/
@@ -79,6 +89,18 @@ public:
     {
         return fmt;
     }
+    const picture_t *getPicture() const
+    {
+        return picture;
+    }
+    unsigned getX() const
+    {
+        return x;
+    }
+    unsigned getY() const
+    {
+        return y;
+    }
     bool isFull(unsigned) const
     {
         return true;
@@ -560,6 +582,193 @@ void Blend(const CPicture &dst_data, const CPicture &src_data,
 typedef void (*blend_function_t)(const CPicture &dst_data, const CPicture &src_data,
                                  unsigned width, unsigned height, int alpha);
 
+#ifdef CAN_COMPILE_SSE2
+/*****************************************************************************
+ * SSE2 specializations for the subtitle rendering hot path (YUVA source
+ * blended onto a planar or semi-planar 4:2:0 destination). The fixed point
+ * math matches div255()/merge() bit for bit.
+ *****************************************************************************/
+
+VLC_BLEND_SSE2
+static inline __m128i SSE2_Div255(__m128i v)
+{
+    /* same as div255(): ((v >> 8) + v + 1) >> 8 on each 16 bits lane */
+    v = _mm_add_epi16(v, _mm_add_epi16(_mm_srli_epi16(v, 8),
+                                       _mm_set1_epi16(1)));
+    return _mm_srli_epi16(v, 8);
+}
+
+/* Applies the global alpha to 16 per-pixel alpha bytes */
+VLC_BLEND_SSE2
+static inline __m128i SSE2_Alpha(__m128i a8, __m128i galpha)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = SSE2_Div255(_mm_mullo_epi16(_mm_unpacklo_epi8(a8, zero), galpha));
+    __m128i hi = SSE2_Div255(_mm_mullo_epi16(_mm_unpackhi_epi8(a8, zero), galpha));
+    return _mm_packus_epi16(lo, hi);
+}
+
+/* Blends 16 source bytes onto 16 destination bytes with per-byte alpha */
+VLC_BLEND_SSE2
+static inline __m128i SSE2_Merge(__m128i d8, __m128i s8, __m128i a8)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i f255 = _mm_set1_epi16(255);
+    __m128i a, r_lo, r_hi;
+
+    a = _mm_unpacklo_epi8(a8, zero);
+    r_lo = _mm_add_epi16(_mm_mullo_epi16(_mm_sub_epi16(f255, a),
+                                         _mm_unpacklo_epi8(d8, zero)),
+                         _mm_mullo_epi16(_mm_unpacklo_epi8(s8, zero), a));
+    a = _mm_unpackhi_epi8(a8, zero);
+    r_hi = _mm_add_epi16(_mm_mullo_epi16(_mm_sub_epi16(f255, a),
+                                         _mm_unpackhi_epi8(d8, zero)),
+                         _mm_mullo_epi16(_mm_unpackhi_epi8(s8, zero), a));
+    return _mm_packus_epi16(SSE2_Div255(r_lo), SSE2_Div255(r_hi));
+}
+
+/* Gathers the 16 even bytes out of 32 */
+VLC_BLEND_SSE2
+static inline __m128i SSE2_GatherEven(const uint8_t *p)
+{
+    const __m128i mask = _mm_set1_epi16(0x00ff);
+    __m128i lo = _mm_and_si128(_mm_loadu_si128((const __m128i *)p), mask);
+    __m128i hi = _mm_and_si128(_mm_loadu_si128((const __m128i *)(p + 16)), mask);
+    return _mm_packus_epi16(lo, hi);
+}
+
+VLC_BLEND_SSE2
+static void SSE2_BlendLumaRow(uint8_t *dst, const uint8_t *src,
+                              const uint8_t *srca, unsigned width, int alpha)
+{
+    const __m128i galpha = _mm_set1_epi16(alpha);
+    unsigned x = 0;
+
+    for (; x + 16 <= width; x += 16) {
+        __m128i a = SSE2_Alpha(_mm_loadu_si128((const __m128i *)&srca[x]), galpha);
+        __m128i s = _mm_loadu_si128((const __m128i *)&src[x]);
+        __m128i d = _mm_loadu_si128((const __m128i *)&dst[x]);
+        _mm_storeu_si128((__m128i *)&dst[x], SSE2_Merge(d, s, a));
+    }
+    for (; x < width; x++) {
+        unsigned a = div255(alpha * srca[x]);
+        if (a > 0)
+            merge(&dst[x], src[x], a);
+    }
+}
+
+/* Blends one planar chroma row, the source plane and alpha being sampled
+ * every other byte (4:4:4 source onto a 4:2:0 destination) */
+VLC_BLEND_SSE2
+static void SSE2_BlendChromaRow(uint8_t *dst, const uint8_t *src,
+                                const uint8_t *srca, unsigned cwidth, int alpha)
+{
+    const __m128i galpha = _mm_set1_epi16(alpha);
+    unsigned c = 0;
+
+    for (; c + 16 <= cwidth; c += 16) {
+        __m128i a = SSE2_Alpha(SSE2_GatherEven(&srca[2 * c]), galpha);
+        __m128i s = SSE2_GatherEven(&src[2 * c]);
+        __m128i d = _mm_loadu_si128((const __m128i *)&dst[c]);
+        _mm_storeu_si128((__m128i *)&dst[c], SSE2_Merge(d, s, a));
+    }
+    for (; c < cwidth; c++) {
+        unsigned a = div255(alpha * srca[2 * c]);
+        if (a > 0)
+            merge(&dst[c], src[2 * c], a);
+    }
+}
+
+/* Same for an interleaved chroma row (NV12/NV21 destination) */
+VLC_BLEND_SSE2
+static void SSE2_BlendChromaRowNV(uint8_t *dst, const uint8_t *srcu,
+                                  const uint8_t *srcv, const uint8_t *srca,
+                                  unsigned cwidth, int alpha)
+{
+    const __m128i galpha = _mm_set1_epi16(alpha);
+    unsigned c = 0;
+
+    for (; c + 16 <= cwidth; c += 16) {
+        __m128i a = SSE2_Alpha(SSE2_GatherEven(&srca[2 * c]), galpha);
+        __m128i u = SSE2_GatherEven(&srcu[2 * c]);
+        __m128i v = SSE2_GatherEven(&srcv[2 * c]);
+        __m128i d0 = _mm_loadu_si128((const __m128i *)&dst[2 * c]);
+        __m128i d1 = _mm_loadu_si128((const __m128i *)&dst[2 * c + 16]);
+        _mm_storeu_si128((__m128i *)&dst[2 * c],
+                         SSE2_Merge(d0, _mm_unpacklo_epi8(u, v),
+                                    _mm_unpacklo_epi8(a, a)));
+        _mm_storeu_si128((__m128i *)&dst[2 * c + 16],
+                         SSE2_Merge(d1, _mm_unpackhi_epi8(u, v),
+                                    _mm_unpackhi_epi8(a, a)));
+    }
+    for (; c < cwidth; c++) {
+        unsigned a = div255(alpha * srca[2 * c]);
+        if (a > 0) {
+            merge(&dst[2 * c + 0], srcu[2 * c], a);
+            merge(&dst[2 * c + 1], srcv[2 * c], a);
+        }
+    }
+}
+
+/* Blends a YUVA source onto a planar (swap_uv selects YV12) or semi-planar
+ * (swap_uv selects NV21) 4:2:0 destination. Chroma is merged on even
+ * destination rows/columns only, like the generic code path. */
+template <bool semi_planar, bool swap_uv>
+VLC_BLEND_SSE2
+static void BlendYUVAToYUV420SSE2(const CPicture &dst_data, const CPicture &src_data,
+                                  unsigned width, unsigned height, int alpha)
+{
+    const picture_t *dstp = dst_data.getPicture();
+    const picture_t *srcp = src_data.getPicture();
+    const unsigned dst_x = dst_data.getX();
+    const unsigned dst_y = dst_data.getY();
+    const unsigned src_x = src_data.getX();
+    const unsigned src_y = src_data.getY();
+
+    /* parity of the first destination column deciding chroma merges */
+    const unsigned dx0 = dst_x & 1;
+    const unsigned cwidth = width > dx0 ? (width - dx0 + 1) / 2 : 0;
+
+    for (unsigned y = 0; y < height; y++) {
+        const unsigned dy = dst_y + y;
+        const unsigned sy = src_y + y;
+        uint8_t *dst_luma =
+            &dstp->p[0].p_pixels[dy * dstp->p[0].i_pitch + dst_x];
+        const uint8_t *src_luma =
+            &srcp->p[0].p_pixels[sy * srcp->p[0].i_pitch + src_x];
+        const uint8_t *src_alpha =
+            &srcp->p[3].p_pixels[sy * srcp->p[3].i_pitch + src_x];
+
+        SSE2_BlendLumaRow(dst_luma, src_luma, src_alpha, width, alpha);
+
+        if ((dy & 1) || cwidth == 0)
+            continue;
+
+        const uint8_t *src_u =
+            &srcp->p[1].p_pixels[sy * srcp->p[1].i_pitch + src_x + dx0];
+        const uint8_t *src_v =
+            &srcp->p[2].p_pixels[sy * srcp->p[2].i_pitch + src_x + dx0];
+
+        if (semi_planar) {
+            uint8_t *dst_uv =
+                &dstp->p[1].p_pixels[(dy / 2) * dstp->p[1].i_pitch + dst_x + dx0];
+            SSE2_BlendChromaRowNV(dst_uv, swap_uv ? src_v : src_u,
+                                  swap_uv ? src_u : src_v,
+                                  src_alpha + dx0, cwidth, alpha);
+        } else {
+            const unsigned u_plane = swap_uv ? 2 : 1;
+            const unsigned v_plane = swap_uv ? 1 : 2;
+            uint8_t *dst_u = &dstp->p[u_plane]
+                .p_pixels[(dy / 2) * dstp->p[u_plane].i_pitch + (dst_x + dx0) / 2];
+            uint8_t *dst_v = &dstp->p[v_plane]
+                .p_pixels[(dy / 2) * dstp->p[v_plane].i_pitch + (dst_x + dx0) / 2];
+            SSE2_BlendChromaRow(dst_u, src_u, src_alpha + dx0, cwidth, alpha);
+            SSE2_BlendChromaRow(dst_v, src_v, src_alpha + dx0, cwidth, alpha);
+        }
+    }
+}
+#endif /* CAN_COMPILE_SSE2 */
+
 namespace {
 
 static const struct {
@@ -636,13 +845,61 @@ static const struct {
 #undef YUV
 };
 
+#ifdef CAN_COMPILE_SSE2
+/* Vectorized replacements for the most common subtitle blending cases,
+ * picked over the generic entries when the CPU supports SSE2 */
+static const struct {
+    vlc_fourcc_t     dst;
+    vlc_fourcc_t     src;
+    blend_function_t blend;
+} blends_sse2[] = {
+    { VLC_CODEC_I420, VLC_CODEC_YUVA, BlendYUVAToYUV420SSE2<false, false> },
+    { VLC_CODEC_J420, VLC_CODEC_YUVA, BlendYUVAToYUV420SSE2<false, false> },
+    { VLC_CODEC_YV12, VLC_CODEC_YUVA, BlendYUVAToYUV420SSE2<false, true>  },
+    { VLC_CODEC_NV12, VLC_CODEC_YUVA, BlendYUVAToYUV420SSE2<true,  false> },
+    { VLC_CODEC_NV21, VLC_CODEC_YUVA, BlendYUVAToYUV420SSE2<true,  true>  },
+};
+#endif
+
 struct filter_sys_t {
-    filter_sys_t() : blend(NULL)
+    filter_sys_t() : blend(NULL), copier(NULL)
     {
     }
     blend_function_t blend;
+    /* Worker pool slicing the blend in horizontal bands, NULL to blend on
+     * the calling thread only */
+    vlc_plane_copier_t *copier;
+};
+
+/* Context of one sliced blend, passed to the copier workers */
+struct blend_job {
+    blend_function_t blend;
+    const picture_t *dst;
+    const video_format_t *dst_fmt;
+    unsigned dst_x, dst_y;
+    const picture_t *src;
+    const video_format_t *src_fmt;
+    unsigned src_x, src_y;
+    unsigned width, height;
+    int alpha;
 };
 
+/* Each luma row is blended by a single worker, and chroma is only written
+ * from the even (or modulo ry) destination rows, so bands can split at any
+ * line without two workers sharing a chroma line. */
+static void BlendSlice(void *opaque, unsigned slice, unsigned count)
+{
+    const blend_job *job = static_cast<const blend_job *>(opaque);
+    const unsigned first = (uint64_t)job->height * slice / count;
+    const unsigned last = (uint64_t)job->height * (slice + 1) / count;
+
+    if (last <= first)
+        return;
+    job->blend(CPicture(job->dst, job->dst_fmt, job->dst_x, job->dst_y + first),
+               CPicture(job->src, job->src_fmt, job->src_x, job->src_y + first),
+               job->width, last - first, job->alpha);
+}
+
 } // namespace
 
 /**
@@ -670,12 +927,24 @@ static void DoBlend(filter_t *filter,
     video_format_FixRgb(&filter->fmt_out.video);
     video_format_FixRgb(&filter->fmt_in.video);
 
-    sys->blend(CPicture(dst, &filter->fmt_out.video,
-                        filter->fmt_out.video.i_x_offset + x_offset,
-                        filter->fmt_out.video.i_y_offset + y_offset),
-               CPicture(src, &filter->fmt_in.video,
-                        filter->fmt_in.video.i_x_offset,
-                        filter->fmt_in.video.i_y_offset),
+    const unsigned dst_x = filter->fmt_out.video.i_x_offset + x_offset;
+    const unsigned dst_y = filter->fmt_out.video.i_y_offset + y_offset;
+    const unsigned src_x = filter->fmt_in.video.i_x_offset;
+    const unsigned src_y = filter->fmt_in.video.i_y_offset;
+
+    if (sys->copier != NULL && height >= 64) {
+        blend_job job = {
+            sys->blend,
+            dst, &filter->fmt_out.video, dst_x, dst_y,
+            src, &filter->fmt_in.video, src_x, src_y,
+            (unsigned)width, (unsigned)height, alpha,
+        };
+        vlc_plane_copier_Run(sys->copier, BlendSlice, &job);
+        return;
+    }
+
+    sys->blend(CPicture(dst, &filter->fmt_out.video, dst_x, dst_y),
+               CPicture(src, &filter->fmt_in.video, src_x, src_y),
                width, height, alpha);
 }
 
@@ -699,6 +968,15 @@ static int Open(filter_t *filter)
             sys->blend = blends[i].blend;
     }
 
+#ifdef CAN_COMPILE_SSE2
+    if (vlc_CPU_SSE2()) {
+        for (size_t i = 0; i < sizeof(blends_sse2) / sizeof(*blends_sse2); i++) {
+            if (blends_sse2[i].src == src && blends_sse2[i].dst == dst)
+                sys->blend = blends_sse2[i].blend;
+        }
+    }
+#endif
+
     if (!sys->blend) {
        msg_Err(filter, "no matching alpha blending routine (chroma: %4.4s -> %4.4s)",
                (char *)&src, (char *)&dst);
@@ -706,6 +984,11 @@ static int Open(filter_t *filter)
         return VLC_EGENERIC;
     }
 
+    /* Slicing only pays off when full pictures get blended (dual burned-in
+     * subtitles on UHD output), keep small blends single threaded */
+    if (filter->fmt_out.video.i_visible_height >= 720)
+        sys->copier = vlc_plane_copier_New(0);
+
     filter->ops = &filter_ops.ops;
     filter->p_sys          = sys;
     return VLC_SUCCESS;
@@ -714,5 +997,7 @@ static int Open(filter_t *filter)
 static void Close(filter_t *filter)
 {
     filter_sys_t *p_sys = reinterpret_cast<filter_sys_t *>( filter->p_sys );
+    if (p_sys->copier != NULL)
+        vlc_plane_copier_Delete(p_sys->copier);
     delete p_sys;
 }
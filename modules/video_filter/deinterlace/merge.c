@@ -121,6 +121,61 @@ void Merge16BitSSE2( void *_p_dest, const void *_p_s1, const void *_p_s2,
 
 #endif
 
+#if defined(CAN_COMPILE_AVX2)
+void Merge8BitAVX2( void *_p_dest, const void *_p_s1, const void *_p_s2,
+                    size_t i_bytes )
+{
+    uint8_t *p_dest = _p_dest;
+    const uint8_t *p_s1 = _p_s1;
+    const uint8_t *p_s2 = _p_s2;
+
+    for( ; i_bytes > 0 && ((uintptr_t)p_s1 & 31); i_bytes-- )
+        *p_dest++ = ( *p_s1++ + *p_s2++ ) >> 1;
+
+    for( ; i_bytes >= 32; i_bytes -= 32 )
+    {
+        __asm__  __volatile__( "vmovdqu %2, %%ymm1;"
+                               "vpavgb %1, %%ymm1, %%ymm1;"
+                               "vmovdqu %%ymm1, %0" :"=m" (*p_dest):
+                                                 "m" (*p_s1),
+                                                 "m" (*p_s2) : "xmm1" );
+        p_dest += 32;
+        p_s1 += 32;
+        p_s2 += 32;
+    }
+
+    for( ; i_bytes > 0; i_bytes-- )
+        *p_dest++ = ( *p_s1++ + *p_s2++ ) >> 1;
+}
+
+void Merge16BitAVX2( void *_p_dest, const void *_p_s1, const void *_p_s2,
+                     size_t i_bytes )
+{
+    uint16_t *p_dest = _p_dest;
+    const uint16_t *p_s1 = _p_s1;
+    const uint16_t *p_s2 = _p_s2;
+
+    size_t i_words = i_bytes / 2;
+    for( ; i_words > 0 && ((uintptr_t)p_s1 & 31); i_words-- )
+        *p_dest++ = ( *p_s1++ + *p_s2++ ) >> 1;
+
+    for( ; i_words >= 16; i_words -= 16 )
+    {
+        __asm__  __volatile__( "vmovdqu %2, %%ymm1;"
+                               "vpavgw %1, %%ymm1, %%ymm1;"
+                               "vmovdqu %%ymm1, %0" :"=m" (*p_dest):
+                                                 "m" (*p_s1),
+                                                 "m" (*p_s2) : "xmm1" );
+        p_dest += 16;
+        p_s1 += 16;
+        p_s2 += 16;
+    }
+
+    for( ; i_words > 0; i_words-- )
+        *p_dest++ = ( *p_s1++ + *p_s2++ ) >> 1;
+}
+#endif
+
 #ifdef CAN_COMPILE_C_ALTIVEC
 VLC_ALTIVEC
 void MergeAltivec( void *_p_dest, const void *_p_s1,
@@ -200,3 +255,12 @@ void EndSSE( void )
     __asm__ __volatile__( "sfence" ::: "memory" );
 }
 #endif
+
+#if defined(CAN_COMPILE_AVX2)
+void EndAVX2( void )
+{
+    /* Leave the upper YMM halves clean to avoid AVX/SSE transition
+     * penalties in whatever code runs next. */
+    __asm__ __volatile__( "vzeroupper" ::: "memory" );
+}
+#endif
@@ -162,6 +162,27 @@ void Merge8BitSSE2( void *, const void *, const void *, size_t );
 void Merge16BitSSE2( void *, const void *, const void *, size_t );
 #endif
 
+#if defined(CAN_COMPILE_AVX2)
+/**
+ * AVX2 routine to blend pixels from two picture lines.
+ *
+ * @param _p_dest Target
+ * @param _p_s1 Source line A
+ * @param _p_s2 Source line B
+ * @param i_bytes Number of bytes to merge
+ */
+void Merge8BitAVX2( void *, const void *, const void *, size_t );
+/**
+ * AVX2 routine to blend pixels from two picture lines.
+ *
+ * @param _p_dest Target
+ * @param _p_s1 Source line A
+ * @param _p_s2 Source line B
+ * @param i_bytes Number of bytes to merge
+ */
+void Merge16BitAVX2( void *, const void *, const void *, size_t );
+#endif
+
 /*****************************************************************************
  * EndMerge routines
  *****************************************************************************/
@@ -179,4 +200,18 @@ void Merge16BitSSE2( void *, const void *, const void *, size_t );
 void EndSSE( void );
 #endif
 
+#if defined(CAN_COMPILE_AVX2)
+/**
+ * AVX2 merge finalization routine.
+ *
+ * Should be called after an AVX2 merge is finished.
+ * This cleans the upper YMM halves (by executing the "vzeroupper"
+ * instruction), avoiding AVX/SSE transition penalties afterwards.
+ *
+ * The EndMerge() macro detects whether this is needed, and calls if it is,
+ * so just use that.
+ */
+void EndAVX2( void );
+#endif
+
 #endif
@@ -49,7 +49,7 @@
 
 #define CASE_PLANAR_YUV                     \
         CASE_PLANAR_YUV_SQUARE              \
-        CASE_PLANAR_YUV_NONSQUARE
+        CASE_PLANAR_YUV_NONSQUARE
 
 #define CASE_PACKED_YUV_422                 \
         case VLC_CODEC_UYVY:   \
@@ -151,6 +151,29 @@ static inline void rgb_to_yuv( uint8_t *y, uint8_t *u, uint8_t *v,
     *v =   ( ( 112 * r -  94 * g -  18 * b + 128 ) >> 8 ) + 128 ;
 }
 
+/**
+ * Shallow per-band view of a picture, for use with filter_RunSlices().
+ *
+ * Each plane is cut at the same i_slice/i_count fractions of its visible
+ * lines, so the bands of the input and output pictures always match,
+ * whatever the chroma subsampling.
+ */
+static inline void PictureBand( picture_t *p_band, const picture_t *p_pic,
+                                unsigned i_slice, unsigned i_count )
+{
+    *p_band = *p_pic;
+
+    for( int i = 0; i < p_band->i_planes; i++ )
+    {
+        plane_t *p = &p_band->p[i];
+        const int i_first = (int64_t)p->i_visible_lines * i_slice / i_count;
+        const int i_last = (int64_t)p->i_visible_lines * (i_slice + 1) / i_count;
+
+        p->p_pixels += (size_t)i_first * p->i_pitch;
+        p->i_lines = p->i_visible_lines = i_last - i_first;
+    }
+}
+
 /*****************************************************************************
  *
  *****************************************************************************/
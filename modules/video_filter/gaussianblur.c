@@ -178,12 +178,100 @@ static void Destroy( filter_t *p_filter )
     free( p_sys );
 }
 
+struct gaussianblur_job
+{
+    const filter_sys_t *p_sys;
+    const plane_t *p_in_plane;
+    const plane_t *p_out_plane;
+    int x_factor;
+    int y_factor;
+};
+
+/* Horizontal convolution pass: fills the intermediate buffer. Each band
+ * only writes its own rows. */
+static void GaussianHorizSlice( void *opaque, unsigned i_slice,
+                                unsigned i_count )
+{
+    const struct gaussianblur_job *p_job = opaque;
+    const filter_sys_t *p_sys = p_job->p_sys;
+    const int i_dim = p_sys->i_dim;
+    const type_t *pt_distribution = p_sys->pt_distribution;
+    type_t *pt_buffer = p_sys->pt_buffer;
+
+    const uint8_t *p_in = p_job->p_in_plane->p_pixels;
+    const int i_visible_lines = p_job->p_in_plane->i_visible_lines;
+    const int i_visible_pitch = p_job->p_in_plane->i_visible_pitch;
+    const int i_in_pitch = p_job->p_in_plane->i_pitch;
+    const int x_factor = p_job->x_factor;
+
+    const int i_first = (int64_t)i_visible_lines * i_slice / i_count;
+    const int i_last = (int64_t)i_visible_lines * (i_slice + 1) / i_count;
+
+    for( int i_line = i_first; i_line < i_last; i_line++ )
+    {
+        for( int i_col = 0; i_col < i_visible_pitch; i_col++ )
+        {
+            type_t t_value = 0;
+            const int c = i_line*i_in_pitch+i_col;
+            for( int x = __MAX( -i_dim, -i_col*(x_factor+1) );
+                 x <= __MIN( i_dim, (i_visible_pitch - i_col)*(x_factor+1) + 1 );
+                 x++ )
+            {
+                t_value += pt_distribution[x+i_dim] *
+                           p_in[c+(x>>x_factor)];
+            }
+            pt_buffer[c] = t_value;
+        }
+    }
+}
+
+/* Vertical convolution pass: reads the intermediate buffer across band
+ * boundaries, so it must only run once the horizontal pass is complete. */
+static void GaussianVertSlice( void *opaque, unsigned i_slice,
+                               unsigned i_count )
+{
+    const struct gaussianblur_job *p_job = opaque;
+    const filter_sys_t *p_sys = p_job->p_sys;
+    const int i_dim = p_sys->i_dim;
+    const type_t *pt_distribution = p_sys->pt_distribution;
+    const type_t *pt_buffer = p_sys->pt_buffer;
+    const type_t *pt_scale = p_sys->pt_scale;
+
+    uint8_t *p_out = p_job->p_out_plane->p_pixels;
+    const int i_out_pitch = p_job->p_out_plane->i_pitch;
+    const int i_visible_lines = p_job->p_in_plane->i_visible_lines;
+    const int i_visible_pitch = p_job->p_in_plane->i_visible_pitch;
+    const int i_in_pitch = p_job->p_in_plane->i_pitch;
+    const int x_factor = p_job->x_factor;
+    const int y_factor = p_job->y_factor;
+
+    const int i_first = (int64_t)i_visible_lines * i_slice / i_count;
+    const int i_last = (int64_t)i_visible_lines * (i_slice + 1) / i_count;
+
+    for( int i_line = i_first; i_line < i_last; i_line++ )
+    {
+        for( int i_col = 0; i_col < i_visible_pitch; i_col++ )
+        {
+            type_t t_value = 0;
+            const int c = i_line*i_in_pitch+i_col;
+            for( int y = __MAX( -i_dim, (-i_line)*(y_factor+1) );
+                 y <= __MIN( i_dim, (i_visible_lines - i_line)*(y_factor+1) - 1 );
+                 y++ )
+            {
+                t_value += pt_distribution[y+i_dim] *
+                           pt_buffer[c+(y>>y_factor)*i_in_pitch];
+            }
+
+            const type_t t_scale = pt_scale[(i_line<<y_factor)*(i_in_pitch<<x_factor)+(i_col<<x_factor)];
+            p_out[i_line * i_out_pitch + i_col] = (uint8_t)(t_value / t_scale); // FIXME wouldn't it be better to round instead of trunc ?
+        }
+    }
+}
+
 static void Filter( filter_t *p_filter, picture_t *p_pic, picture_t *p_outpic )
 {
     filter_sys_t *p_sys = p_filter->p_sys;
     const int i_dim = p_sys->i_dim;
-    type_t *pt_buffer;
-    type_t *pt_scale;
     const type_t *pt_distribution = p_sys->pt_distribution;
 
     if( !p_sys->pt_buffer )
@@ -193,7 +281,6 @@ static void Filter( filter_t *p_filter, picture_t *p_pic, picture_t *p_outpic )
                                p_pic->p[Y_PLANE].i_pitch * sizeof( type_t ) );
     }
 
-    pt_buffer = p_sys->pt_buffer;
     if( !p_sys->pt_scale )
     {
         const int i_visible_lines = p_pic->p[Y_PLANE].i_visible_lines;
@@ -201,7 +288,7 @@ static void Filter( filter_t *p_filter, picture_t *p_pic, picture_t *p_outpic )
         const int i_pitch = p_pic->p[Y_PLANE].i_pitch;
 
         p_sys->pt_scale = xmalloc( i_visible_lines * i_pitch * sizeof( type_t ) );
-        pt_scale = p_sys->pt_scale;
+        type_t *pt_scale = p_sys->pt_scale;
 
         for( int i_line = 0; i_line < i_visible_lines; i_line++ )
         {
@@ -226,53 +313,22 @@ static void Filter( filter_t *p_filter, picture_t *p_pic, picture_t *p_outpic )
         }
     }
 
-    pt_scale = p_sys->pt_scale;
     for( int i_plane = 0 ; i_plane < p_pic->i_planes ; i_plane++ )
     {
-
-        uint8_t *p_in = p_pic->p[i_plane].p_pixels;
-        uint8_t *p_out = p_outpic->p[i_plane].p_pixels;
-
         const int i_visible_lines = p_pic->p[i_plane].i_visible_lines;
         const int i_visible_pitch = p_pic->p[i_plane].i_visible_pitch;
-        const int i_in_pitch = p_pic->p[i_plane].i_pitch;
-
-        const int x_factor = p_pic->p[Y_PLANE].i_visible_pitch/i_visible_pitch-1;
-        const int y_factor = p_pic->p[Y_PLANE].i_visible_lines/i_visible_lines-1;
-
-        for( int i_line = 0; i_line < i_visible_lines; i_line++ )
-        {
-            for( int i_col = 0; i_col < i_visible_pitch; i_col++ )
-            {
-                type_t t_value = 0;
-                const int c = i_line*i_in_pitch+i_col;
-                for( int x = __MAX( -i_dim, -i_col*(x_factor+1) );
-                     x <= __MIN( i_dim, (i_visible_pitch - i_col)*(x_factor+1) + 1 );
-                     x++ )
-                {
-                    t_value += pt_distribution[x+i_dim] *
-                               p_in[c+(x>>x_factor)];
-                }
-                pt_buffer[c] = t_value;
-            }
-        }
-        for( int i_line = 0; i_line < i_visible_lines; i_line++ )
-        {
-            for( int i_col = 0; i_col < i_visible_pitch; i_col++ )
-            {
-                type_t t_value = 0;
-                const int c = i_line*i_in_pitch+i_col;
-                for( int y = __MAX( -i_dim, (-i_line)*(y_factor+1) );
-                     y <= __MIN( i_dim, (i_visible_lines - i_line)*(y_factor+1) - 1 );
-                     y++ )
-                {
-                    t_value += pt_distribution[y+i_dim] *
-                               pt_buffer[c+(y>>y_factor)*i_in_pitch];
-                }
 
-                const type_t t_scale = pt_scale[(i_line<<y_factor)*(i_in_pitch<<x_factor)+(i_col<<x_factor)];
-                p_out[i_line * p_outpic->p[i_plane].i_pitch + i_col] = (uint8_t)(t_value / t_scale); // FIXME wouldn't it be better to round instead of trunc ?
-            }
-        }
+        struct gaussianblur_job job = {
+            .p_sys = p_sys,
+            .p_in_plane = &p_pic->p[i_plane],
+            .p_out_plane = &p_outpic->p[i_plane],
+            .x_factor = p_pic->p[Y_PLANE].i_visible_pitch/i_visible_pitch-1,
+            .y_factor = p_pic->p[Y_PLANE].i_visible_lines/i_visible_lines-1,
+        };
+
+        /* The two passes are separate jobs: the vertical pass may only
+         * start once the whole intermediate buffer has been filled. */
+        filter_RunSlices( p_filter, GaussianHorizSlice, &job );
+        filter_RunSlices( p_filter, GaussianVertSlice, &job );
     }
 }
@@ -161,9 +161,10 @@ static void Close( filter_t *filter )
     }
 }
 
-static int Open( vlc_object_t *obj )
+static int OpenCommon( filter_t *filter, const char *glfilters_config,
+                       bool is_converter )
 {
-    filter_t *filter = (filter_t *)obj;
+    vlc_object_t *obj = VLC_OBJECT(filter);
 
     filter_sys_t *sys
         = filter->p_sys
@@ -195,6 +196,16 @@ static int Open( vlc_object_t *obj )
         goto gl_create_failure;
     }
 
+    if (is_converter
+     && filter->fmt_out.video.i_chroma != sys->gl->offscreen_chroma_out)
+    {
+        /* A converter must honour the output format it was given */
+        msg_Dbg(obj, "offscreen output chroma %4.4s does not match %4.4s",
+                (const char *)&sys->gl->offscreen_chroma_out,
+                (const char *)&filter->fmt_out.video.i_chroma);
+        goto make_current_failure;
+    }
+
     if (vlc_gl_MakeCurrent (sys->gl) != VLC_SUCCESS)
     {
         msg_Err(obj, "Failed to gl make current");
@@ -217,22 +228,10 @@ static int Open( vlc_object_t *obj )
         goto gl_interop_failure;
     }
 
-    config_ChainParse(filter, OPENGL_CFG_PREFIX, opengl_options, filter->p_cfg);
-
-    char *glfilters_config =
-        var_InheritString(filter, OPENGL_CFG_PREFIX "filter");
-    if (!glfilters_config)
-    {
-        msg_Err(obj, "No filters requested");
-        goto filter_config_failure;
-    }
-
-
     sys->filters = vlc_gl_filters_New(sys->gl, api, sys->interop);
     if (!sys->filters)
     {
         msg_Err(obj, "Could not create filters");
-        free(glfilters_config);
         goto filters_new_failure;
     }
 
@@ -242,10 +241,8 @@ static int Open( vlc_object_t *obj )
     if (ret != VLC_SUCCESS)
     {
         msg_Err(obj, "Could not load filters: %s", glfilters_config);
-        free(glfilters_config);
         goto filters_load_failure;
     }
-    free(glfilters_config);
 
     if (sys->gl->offscreen_vflip)
     {
@@ -272,11 +269,14 @@ static int Open( vlc_object_t *obj )
         .close = Close,
     };
     filter->ops = &ops;
-    filter->fmt_out.video.orientation = ORIENT_NORMAL;
+    if (!is_converter)
+    {
+        filter->fmt_out.video.orientation = ORIENT_NORMAL;
 
-    filter->fmt_out.video.i_chroma
-        = filter->fmt_out.i_codec
-        = sys->gl->offscreen_chroma_out;
+        filter->fmt_out.video.i_chroma
+            = filter->fmt_out.i_codec
+            = sys->gl->offscreen_chroma_out;
+    }
 
     filter->vctx_out = sys->gl->offscreen_vctx_out;
 
@@ -287,7 +287,6 @@ filters_load_failure:
     vlc_gl_filters_Delete(sys->filters);
 
 filters_new_failure:
-filter_config_failure:
     vlc_gl_interop_Delete(sys->interop);
 
 gl_interop_failure:
@@ -303,6 +302,43 @@ gl_create_failure:
     return VLC_EGENERIC;
 }
 
+static int Open( vlc_object_t *obj )
+{
+    filter_t *filter = (filter_t *)obj;
+
+    config_ChainParse(filter, OPENGL_CFG_PREFIX, opengl_options, filter->p_cfg);
+
+    char *glfilters_config =
+        var_InheritString(filter, OPENGL_CFG_PREFIX "filter");
+    if (!glfilters_config)
+    {
+        msg_Err(obj, "No filters requested");
+        return VLC_EGENERIC;
+    }
+
+    int ret = OpenCommon(filter, glfilters_config, false);
+    free(glfilters_config);
+    return ret;
+}
+
+static int OpenConverter( filter_t *filter )
+{
+    const vlc_fourcc_t chroma = filter->fmt_in.video.i_chroma;
+
+    /* Cover the common software decoder outputs; anything else falls back
+     * to the CPU converters. */
+    if (chroma != VLC_CODEC_I420 && chroma != VLC_CODEC_NV12
+     && chroma != VLC_CODEC_P010)
+        return VLC_EGENERIC;
+
+    /* The "draw" pass does not rotate */
+    if (filter->fmt_in.video.orientation != ORIENT_NORMAL
+     || filter->fmt_out.video.orientation != ORIENT_NORMAL)
+        return VLC_EGENERIC;
+
+    return OpenCommon(filter, "draw", true);
+}
+
 #define FILTER_LIST_TEXT N_( "OpenGL filter" )
 #define FILTER_LIST_LONGTEXT N_( "List of OpenGL filters to execute" )
 
@@ -315,4 +351,7 @@ vlc_module_begin()
     set_callback( Open )
     add_module_list( "opengl-filter", "opengl filter", NULL,
                      FILTER_LIST_TEXT, FILTER_LIST_LONGTEXT )
+    add_submodule()
+        set_description( N_("OpenGL video converter") )
+        set_callback_video_converter( OpenConverter, 160 )
 vlc_module_end()
@@ -46,6 +46,12 @@ typedef struct {
     GLsizei  width;
     GLsizei  height;
 
+    /* Picture whose pixels the texture holds, and the offset it was
+       uploaded with. The reference is held so that the pointer cannot be
+       recycled for another picture while the texture is alive. */
+    picture_t *picture;
+    size_t   pixels_offset;
+
     float    alpha;
 
     float    top;
@@ -204,6 +210,8 @@ vlc_gl_sub_renderer_Delete(struct vlc_gl_sub_renderer *sr)
 
     for (unsigned i = 0; i < sr->region_count; ++i)
     {
+        if (sr->regions[i].picture)
+            picture_Release(sr->regions[i].picture);
         if (sr->regions[i].texture)
             sr->vt->DeleteTextures(1, &sr->regions[i].texture);
     }
@@ -256,7 +264,32 @@ vlc_gl_sub_renderer_Prepare(struct vlc_gl_sub_renderer *sr, subpicture_t *subpic
             glr->right  =  2.0 * (r->i_x + r->fmt.i_visible_width ) / subpicture->i_original_picture_width  - 1.0;
             glr->bottom = -2.0 * (r->i_y + r->fmt.i_visible_height) / subpicture->i_original_picture_height + 1.0;
 
+            const size_t pixels_offset =
+                r->fmt.i_y_offset * r->p_picture->p->i_pitch +
+                r->fmt.i_x_offset * r->p_picture->p->i_pixel_pitch;
+
             glr->texture = 0;
+
+            /* Rendered region pictures are immutable and kept across calls
+               as long as the region content does not change. If the same
+               picture comes back, the matching texture already holds its
+               pixels: reuse it and skip the upload. */
+            for (int j = 0; j < last_count; j++) {
+                if (last[j].texture &&
+                    last[j].picture == r->p_picture &&
+                    last[j].pixels_offset == pixels_offset &&
+                    last[j].width  == glr->width &&
+                    last[j].height == glr->height) {
+                    glr->texture = last[j].texture;
+                    glr->picture = last[j].picture;
+                    memset(&last[j], 0, sizeof(last[j]));
+                    break;
+                }
+            }
+            glr->pixels_offset = pixels_offset;
+            if (glr->picture)
+                continue;
+
             /* Try to recycle the textures allocated by the previous
                call to this function. */
             for (int j = 0; j < last_count; j++) {
@@ -264,14 +297,13 @@ vlc_gl_sub_renderer_Prepare(struct vlc_gl_sub_renderer *sr, subpicture_t *subpic
                     last[j].width  == glr->width &&
                     last[j].height == glr->height) {
                     glr->texture = last[j].texture;
+                    if (last[j].picture)
+                        picture_Release(last[j].picture);
                     memset(&last[j], 0, sizeof(last[j]));
                     break;
                 }
             }
 
-            const size_t pixels_offset =
-                r->fmt.i_y_offset * r->p_picture->p->i_pitch +
-                r->fmt.i_x_offset * r->p_picture->p->i_pixel_pitch;
             if (!glr->texture)
             {
                 /* Could not recycle a previous texture, generate a new one. */
@@ -292,6 +324,7 @@ vlc_gl_sub_renderer_Prepare(struct vlc_gl_sub_renderer *sr, subpicture_t *subpic
                                                     r->p_picture, &pixels_offset);
             if (ret != VLC_SUCCESS)
                 break;
+            glr->picture = picture_Hold(r->p_picture);
         }
     }
     else
@@ -301,6 +334,8 @@ vlc_gl_sub_renderer_Prepare(struct vlc_gl_sub_renderer *sr, subpicture_t *subpic
     }
 
     for (int i = 0; i < last_count; i++) {
+        if (last[i].picture)
+            picture_Release(last[i].picture);
         if (last[i].texture)
             vlc_gl_interop_DeleteTextures(interop, &last[i].texture);
     }
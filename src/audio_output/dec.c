@@ -66,6 +66,12 @@ struct vlc_aout_stream
         vlc_mutex_t lock; /* Guard first_pts, last_drift, rate_system_ts,
                              rate_audio_ts, system_ts, audio_ts */
 
+        /* Seqlock allowing the decoder thread to read the timing point
+         * without taking the lock, so that it never waits for the output
+         * thread reporting a timing update (writers stay serialized by the
+         * lock above). */
+        atomic_uint seq;
+
         vlc_tick_t last_drift;
 
         vlc_tick_t first_pts;
@@ -117,6 +123,49 @@ static inline struct vlc_tracer *aout_stream_tracer(vlc_aout_stream *stream)
         vlc_object_get_tracer(VLC_OBJECT(aout_stream_aout(stream)));
 }
 
+/* Must be called with timing.lock held, around writes of the fields read by
+ * stream_TimingRead() */
+static void stream_TimingWriteBegin(vlc_aout_stream *stream)
+{
+    vlc_mutex_assert(&stream->timing.lock);
+    unsigned seq = atomic_load_explicit(&stream->timing.seq,
+                                        memory_order_relaxed);
+    atomic_store_explicit(&stream->timing.seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+static void stream_TimingWriteEnd(vlc_aout_stream *stream)
+{
+    unsigned seq = atomic_load_explicit(&stream->timing.seq,
+                                        memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&stream->timing.seq, seq + 1, memory_order_relaxed);
+}
+
+/* Lock-free snapshot of the last timing point published by
+ * vlc_aout_stream_NotifyTiming() */
+static void stream_TimingRead(vlc_aout_stream *stream,
+                              vlc_tick_t *system_ts, vlc_tick_t *audio_ts,
+                              vlc_tick_t *last_drift)
+{
+    for (;;)
+    {
+        unsigned seq1 = atomic_load_explicit(&stream->timing.seq,
+                                             memory_order_acquire);
+        if (seq1 & 1)
+            continue; /* a write is in progress, retry */
+
+        *system_ts = stream->timing.system_ts;
+        *audio_ts = stream->timing.audio_ts;
+        *last_drift = stream->timing.last_drift;
+
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&stream->timing.seq,
+                                 memory_order_relaxed) == seq1)
+            break; /* no write overlapped the copy: snapshot consistent */
+    }
+}
+
 static int stream_GetDelay(vlc_aout_stream *stream, vlc_tick_t *delay)
 {
     audio_output_t *aout = aout_stream_aout(stream);
@@ -124,15 +173,10 @@ static int stream_GetDelay(vlc_aout_stream *stream, vlc_tick_t *delay)
     if (aout->time_get != NULL)
         return aout->time_get(aout, delay);
 
-    vlc_mutex_lock(&stream->timing.lock);
-    vlc_tick_t system_ts = stream->timing.system_ts;
-    vlc_tick_t audio_ts = stream->timing.audio_ts;
+    vlc_tick_t system_ts, audio_ts, last_drift;
+    stream_TimingRead(stream, &system_ts, &audio_ts, &last_drift);
     if (system_ts == VLC_TICK_INVALID)
-    {
-        vlc_mutex_unlock(&stream->timing.lock);
         return -1;
-    }
-    vlc_mutex_unlock(&stream->timing.lock);
 
     /* Interpolate the last updated point. */
     vlc_tick_t system_now = vlc_tick_now();
@@ -160,10 +204,12 @@ static void stream_Discontinuity(vlc_aout_stream *stream)
     stream->original_pts = VLC_TICK_INVALID;
 
     vlc_mutex_lock(&stream->timing.lock);
+    stream_TimingWriteBegin(stream);
     stream->timing.first_pts = VLC_TICK_INVALID;
     stream->timing.last_drift = VLC_TICK_INVALID;
     stream->timing.system_ts = VLC_TICK_INVALID;
     stream->timing.audio_ts = VLC_TICK_INVALID;
+    stream_TimingWriteEnd(stream);
     vlc_mutex_unlock(&stream->timing.lock);
     stream->timing.played_samples = 0;
 }
@@ -268,6 +314,7 @@ vlc_aout_stream * vlc_aout_stream_New(audio_output_t *p_aout,
     stream->timing.rate = 1.f;
 
     vlc_mutex_init(&stream->timing.lock);
+    atomic_init(&stream->timing.seq, 0);
 
     stream->sync.rate = 1.f;
     stream->sync.resamp_type = AOUT_RESAMPLING_NONE;
@@ -611,9 +658,9 @@ static void stream_Synchronize(vlc_aout_stream *stream, vlc_tick_t system_now,
 
     if (aout->time_get == NULL)
     {
-        vlc_mutex_lock(&stream->timing.lock);
-        bool is_drifting = stream->timing.last_drift != VLC_TICK_INVALID;
-        vlc_mutex_unlock(&stream->timing.lock);
+        vlc_tick_t system_ts, audio_ts, last_drift;
+        stream_TimingRead(stream, &system_ts, &audio_ts, &last_drift);
+        bool is_drifting = last_drift != VLC_TICK_INVALID;
 
         if (!is_drifting)
         {
@@ -689,11 +736,14 @@ void vlc_aout_stream_NotifyTiming(vlc_aout_stream *stream, vlc_tick_t system_ts,
                    * stream->timing.rate;
     }
 
+    vlc_tick_t drift = vlc_clock_Update(stream->sync.clock, system_ts,
+                                        audio_ts, stream->timing.rate);
+
+    stream_TimingWriteBegin(stream);
     stream->timing.system_ts = system_ts;
     stream->timing.audio_ts = audio_ts;
-    stream->timing.last_drift =
-        vlc_clock_Update(stream->sync.clock, system_ts,
-                         audio_ts, stream->timing.rate);
+    stream->timing.last_drift = drift;
+    stream_TimingWriteEnd(stream);
     vlc_mutex_unlock(&stream->timing.lock);
 }
 
@@ -787,16 +837,21 @@ int vlc_aout_stream_Play(vlc_aout_stream *stream, block_t *block)
 
         /* Update the clock immediately with the new rate, instead of waiting
          * for a timing update that could come too late (after 1second). */
-        stream->timing.last_drift =
+        vlc_tick_t drift =
             vlc_clock_Update(stream->sync.clock, play_date, original_pts,
                              stream->sync.rate);
+        stream_TimingWriteBegin(stream);
+        stream->timing.last_drift = drift;
+        stream_TimingWriteEnd(stream);
         vlc_mutex_unlock(&stream->timing.lock);
     }
 
     if (stream->timing.first_pts == VLC_TICK_INVALID)
     {
         vlc_mutex_lock(&stream->timing.lock);
+        stream_TimingWriteBegin(stream);
         stream->timing.first_pts = original_pts;
+        stream_TimingWriteEnd(stream);
         vlc_mutex_unlock(&stream->timing.lock);
     }
 
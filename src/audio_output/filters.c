@@ -368,6 +368,8 @@ struct aout_filters
     filter_t *rate_filter; /**< The filter adjusting samples count
         (either the scaletempo filter or a resampler) */
     struct aout_filter resampler; /**< The resampler */
+    struct aout_filter cheap_resampler; /**< Linear resampler used instead of
+        the configured one for micro drift corrections */
     int resampling; /**< Current resampling (Hz) */
     const vlc_clock_t *clock_source;
 
@@ -552,6 +554,7 @@ aout_filters_t *aout_FiltersNewWithClock(vlc_object_t *obj, const vlc_clock_t *c
 
     filters->rate_filter = NULL;
     aout_filter_Init(&filters->resampler, NULL);
+    aout_filter_Init(&filters->cheap_resampler, NULL);
     filters->resampling = 0;
     filters->count = 0;
     filters->clock_source = clock;
@@ -683,6 +686,17 @@ aout_filters_t *aout_FiltersNewWithClock(vlc_object_t *obj, const vlc_clock_t *c
     if (filters->rate_filter == NULL)
         filters->rate_filter = filters->resampler.f;
 
+    if (filters->resampler.f != NULL && input_format.i_rate == outfmt->i_rate)
+    {
+        /* The resampler only performs drift corrections here. Sub-0.1%
+         * ratio corrections do not need the configured high-quality
+         * resampler, so give aout_FiltersPlay() a cheap linear one to
+         * switch to per block. */
+        filters->cheap_resampler.f = aout_filter_Create(obj, NULL,
+                "audio resampler", "ugly", &input_format, &output_format,
+                NULL, true);
+    }
+
     return filters;
 
 error:
@@ -753,6 +767,8 @@ void aout_FiltersDelete (vlc_object_t *obj, aout_filters_t *filters)
 {
     if (filters->resampler.f != NULL)
         aout_FiltersPipelineDestroy(&filters->resampler, 1);
+    if (filters->cheap_resampler.f != NULL)
+        aout_FiltersPipelineDestroy(&filters->cheap_resampler, 1);
     aout_FiltersPipelineDestroy (filters->tab, filters->count);
     var_DelCallback(obj, "visual", VisualizationCallback, NULL);
     free (filters);
@@ -795,9 +811,21 @@ block_t *aout_FiltersPlay(aout_filters_t *filters, block_t *block, float rate)
     if (filters->resampler.f != NULL)
     {   /* NOTE: the resampler needs to run even if resampling is 0.
          * The decoder and output rates can still be different. */
-        filters->resampler.f->fmt_in.audio.i_rate += filters->resampling;
-        block = aout_FiltersPipelinePlay (&filters->resampler, 1, block);
-        filters->resampler.f->fmt_in.audio.i_rate -= filters->resampling;
+        struct aout_filter *resampler = &filters->resampler;
+
+        /* Drift corrections below 0.1% of the rate go through the cheap
+         * linear resampler: the configured one is only worth its cost for
+         * real rate conversions. The selection cannot apply when the rate
+         * override above targets the resampler itself. */
+        if (filters->cheap_resampler.f != NULL
+         && (rate == 1.f || filters->rate_filter != filters->resampler.f)
+         && (unsigned)abs (filters->resampling) * 1000
+                <= resampler->f->fmt_in.audio.i_rate)
+            resampler = &filters->cheap_resampler;
+
+        resampler->f->fmt_in.audio.i_rate += filters->resampling;
+        block = aout_FiltersPipelinePlay (resampler, 1, block);
+        resampler->f->fmt_in.audio.i_rate -= filters->resampling;
     }
 
     if (nominal_rate != 0)
@@ -850,6 +878,8 @@ void aout_FiltersFlush (aout_filters_t *filters)
 
     if (filters->resampler.f != NULL)
         aout_FiltersPipelineFlush (&filters->resampler, 1);
+    if (filters->cheap_resampler.f != NULL)
+        aout_FiltersPipelineFlush (&filters->cheap_resampler, 1);
 }
 
 void aout_FiltersChangeViewpoint (aout_filters_t *filters,
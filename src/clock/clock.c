@@ -31,6 +31,10 @@
 
 #define COEFF_THRESHOLD 0.2 /* between 0.8 and 1.2 */
 
+/* Averaging ranges of the coefficient moving average, per profile */
+#define COEFF_RANGE_SMOOTH 10
+#define COEFF_RANGE_AGGRESSIVE 3
+
 struct vlc_clock_main_t
 {
     struct vlc_logger *logger;
@@ -56,8 +60,16 @@ struct vlc_clock_main_t
 
     vlc_tick_t pause_date;
 
+    /* Ring of the last master updates, cf. vlc_clock_main_GetStats() */
+    struct vlc_clock_update_point history[VLC_CLOCK_MAIN_HISTORY_COUNT];
+    size_t history_index;
+    size_t history_count;
+
     unsigned wait_sync_ref_priority;
     clock_point_t wait_sync_ref; /* When the master */
+    /* Externally shared timebase for the monotonic mode, cf.
+     * vlc_clock_main_SetExternalOrigin() */
+    clock_point_t external_origin;
     clock_point_t first_pcr;
     vlc_tick_t output_dejitter; /* Delay used to absorb the output clock jitter */
     vlc_tick_t input_dejitter; /* Delay used to absorb the input jitter */
@@ -98,6 +110,9 @@ static void vlc_clock_main_reset(vlc_clock_main_t *main_clock)
     AvgResetAndFill(&main_clock->coeff_avg, main_clock->coeff);
     main_clock->offset = VLC_TICK_INVALID;
 
+    /* The history points are no longer coherent with the new reference */
+    main_clock->history_index = main_clock->history_count = 0;
+
     main_clock->wait_sync_ref_priority = UINT_MAX;
     main_clock->wait_sync_ref =
         main_clock->last = clock_point_Create(VLC_TICK_INVALID, VLC_TICK_INVALID);
@@ -140,6 +155,12 @@ static vlc_tick_t vlc_clock_master_update(vlc_clock_t *clock,
      * anything but only notify the new clock point. */
     if (system_now != VLC_TICK_MAX)
     {
+        /* Sync error against the previous prediction, kept for the stats */
+        const vlc_tick_t predicted = main_stream_to_system(main_clock, ts);
+        const vlc_tick_t update_drift = predicted == VLC_TICK_INVALID ?
+            VLC_TICK_INVALID : system_now - predicted;
+        double update_instant_coeff = main_clock->coeff;
+
         if (main_clock->offset != VLC_TICK_INVALID
          && ts != main_clock->last.stream)
         {
@@ -177,6 +198,7 @@ static vlc_tick_t vlc_clock_master_update(vlc_clock_t *clock,
                 {
                     AvgUpdate(&main_clock->coeff_avg, instant_coeff);
                     main_clock->coeff = AvgGet(&main_clock->coeff_avg);
+                    update_instant_coeff = instant_coeff;
                 }
             }
         }
@@ -196,6 +218,20 @@ static vlc_tick_t vlc_clock_master_update(vlc_clock_t *clock,
                              VLC_TRACE("offset", main_clock->offset),
                              VLC_TRACE_END);
 
+        struct vlc_clock_update_point *point =
+            &main_clock->history[main_clock->history_index];
+        point->system = system_now;
+        point->stream = ts;
+        point->rate = rate;
+        point->instant_coeff = update_instant_coeff;
+        point->coeff = main_clock->coeff;
+        point->offset = main_clock->offset;
+        point->drift = update_drift;
+        main_clock->history_index =
+            (main_clock->history_index + 1) % VLC_CLOCK_MAIN_HISTORY_COUNT;
+        if (main_clock->history_count < VLC_CLOCK_MAIN_HISTORY_COUNT)
+            main_clock->history_count++;
+
         main_clock->last = clock_point_Create(system_now, ts);
 
         main_clock->rate = rate;
@@ -272,6 +308,12 @@ vlc_clock_monotonic_to_system_locked(vlc_clock_t *clock, vlc_tick_t now,
 {
     vlc_clock_main_t *main_clock = clock->owner;
 
+    /* With a shared origin, every instance converts a given ts to the same
+     * system time: bypass the local reference point selection entirely */
+    if (main_clock->external_origin.system != VLC_TICK_INVALID)
+        return (ts - main_clock->external_origin.stream) / rate
+             + main_clock->external_origin.system;
+
     if (clock->priority < main_clock->wait_sync_ref_priority)
     {
         /* XXX: This input_delay calculation is needed until we (finally) get
@@ -451,15 +493,19 @@ vlc_clock_main_t *vlc_clock_main_New(struct vlc_logger *parent_logger, struct vl
 
     main_clock->first_pcr =
         clock_point_Create(VLC_TICK_INVALID, VLC_TICK_INVALID);
+    main_clock->external_origin =
+        clock_point_Create(VLC_TICK_INVALID, VLC_TICK_INVALID);
     main_clock->wait_sync_ref_priority = UINT_MAX;
     main_clock->wait_sync_ref = main_clock->last =
         clock_point_Create(VLC_TICK_INVALID, VLC_TICK_INVALID);
 
+    main_clock->history_index = main_clock->history_count = 0;
+
     main_clock->pause_date = VLC_TICK_INVALID;
     main_clock->input_dejitter = DEFAULT_PTS_DELAY;
     main_clock->output_dejitter = AOUT_MAX_PTS_ADVANCE * 2;
 
-    AvgInit(&main_clock->coeff_avg, 10);
+    AvgInit(&main_clock->coeff_avg, COEFF_RANGE_SMOOTH);
     AvgResetAndFill(&main_clock->coeff_avg, main_clock->coeff);
 
     return main_clock;
@@ -488,6 +534,15 @@ void vlc_clock_main_SetFirstPcr(vlc_clock_main_t *main_clock,
     vlc_mutex_unlock(&main_clock->lock);
 }
 
+void vlc_clock_main_SetExternalOrigin(vlc_clock_main_t *main_clock,
+                                      vlc_tick_t system_ts, vlc_tick_t ts)
+{
+    vlc_mutex_lock(&main_clock->lock);
+    main_clock->external_origin = clock_point_Create(system_ts, ts);
+    vlc_cond_broadcast(&main_clock->cond);
+    vlc_mutex_unlock(&main_clock->lock);
+}
+
 void vlc_clock_main_SetInputDejitter(vlc_clock_main_t *main_clock,
                                      vlc_tick_t delay)
 {
@@ -504,6 +559,43 @@ void vlc_clock_main_SetDejitter(vlc_clock_main_t *main_clock,
     vlc_mutex_unlock(&main_clock->lock);
 }
 
+void vlc_clock_main_SetProfile(vlc_clock_main_t *main_clock,
+                               enum vlc_clock_main_profile profile)
+{
+    const int range = profile == VLC_CLOCK_MAIN_PROFILE_AGGRESSIVE ?
+        COEFF_RANGE_AGGRESSIVE : COEFF_RANGE_SMOOTH;
+
+    vlc_mutex_lock(&main_clock->lock);
+    /* Change the averaging range but keep the current coefficient as the
+     * starting point, cf. vlc_clock_main_reset() */
+    AvgInit(&main_clock->coeff_avg, range);
+    AvgResetAndFill(&main_clock->coeff_avg, main_clock->coeff);
+    vlc_mutex_unlock(&main_clock->lock);
+}
+
+void vlc_clock_main_GetStats(vlc_clock_main_t *main_clock,
+                             struct vlc_clock_main_stats *stats)
+{
+    vlc_mutex_lock(&main_clock->lock);
+    stats->coeff = main_clock->coeff;
+    stats->rate = main_clock->rate;
+    stats->offset = main_clock->offset;
+    stats->history_count = main_clock->history_count;
+
+    /* Unroll the ring from the oldest to the newest point */
+    const size_t first = (main_clock->history_index
+                          + VLC_CLOCK_MAIN_HISTORY_COUNT
+                          - main_clock->history_count)
+                       % VLC_CLOCK_MAIN_HISTORY_COUNT;
+    for (size_t i = 0; i < main_clock->history_count; i++)
+        stats->history[i] =
+            main_clock->history[(first + i) % VLC_CLOCK_MAIN_HISTORY_COUNT];
+
+    stats->last_drift = main_clock->history_count > 0 ?
+        stats->history[main_clock->history_count - 1].drift : VLC_TICK_INVALID;
+    vlc_mutex_unlock(&main_clock->lock);
+}
+
 void vlc_clock_main_ChangePause(vlc_clock_main_t *main_clock, vlc_tick_t now,
                                 bool paused)
 {
@@ -528,6 +620,9 @@ void vlc_clock_main_ChangePause(vlc_clock_main_t *main_clock, vlc_tick_t now,
             main_clock->first_pcr.system += delay;
         if (main_clock->wait_sync_ref.system != VLC_TICK_INVALID)
             main_clock->wait_sync_ref.system += delay;
+        /* The external origin is deliberately not shifted: it is shared with
+         * other instances that did not pause, catching up after the resume
+         * keeps the instances aligned */
         main_clock->pause_date = VLC_TICK_INVALID;
         vlc_cond_broadcast(&main_clock->cond);
     }
@@ -30,6 +30,55 @@ enum vlc_clock_master_source
     VLC_CLOCK_MASTER_MONOTONIC,
 };
 
+/**
+ * Smoothing profile of the main clock controller
+ *
+ * It selects how fast the moving average driving the clock coefficient reacts
+ * to new master updates.
+ */
+enum vlc_clock_main_profile
+{
+    /** Long averaging window: favors stability over reactivity (default) */
+    VLC_CLOCK_MAIN_PROFILE_SMOOTH = 0,
+    /** Short averaging window: converges faster after drift at the price of
+     * more jitter in the regulation */
+    VLC_CLOCK_MAIN_PROFILE_AGGRESSIVE,
+};
+
+/** Number of master updates kept in the correction history */
+#define VLC_CLOCK_MAIN_HISTORY_COUNT 32
+
+/**
+ * One master clock update, as recorded in the correction history
+ */
+struct vlc_clock_update_point
+{
+    vlc_tick_t system; /**< system time of the update */
+    vlc_tick_t stream; /**< stream time of the update */
+    double rate; /**< playback rate at the update */
+    double instant_coeff; /**< raw coefficient computed from this update */
+    double coeff; /**< smoothed coefficient applied after this update */
+    vlc_tick_t offset; /**< linear function offset applied after this update */
+    vlc_tick_t drift; /**< system_now - predicted system time, or
+                           VLC_TICK_INVALID if there was no prediction */
+};
+
+/**
+ * Statistics of the main clock regulation
+ */
+struct vlc_clock_main_stats
+{
+    double coeff; /**< coefficient currently applied */
+    double rate; /**< playback rate currently applied */
+    vlc_tick_t offset; /**< offset currently applied, or VLC_TICK_INVALID */
+    vlc_tick_t last_drift; /**< drift of the last master update, or
+                                VLC_TICK_INVALID */
+
+    /** Last updates, from oldest to newest */
+    struct vlc_clock_update_point history[VLC_CLOCK_MAIN_HISTORY_COUNT];
+    size_t history_count; /**< number of valid history entries */
+};
+
 /**
  * Callbacks for the owner of the main clock
  */
@@ -74,6 +123,26 @@ void vlc_clock_main_SetFirstPcr(vlc_clock_main_t *main_clock,
 void vlc_clock_main_SetInputDejitter(vlc_clock_main_t *main_clock,
                                      vlc_tick_t delay);
 
+/**
+ * This function sets a timebase origin shared with other instances
+ *
+ * Once set, the monotonic conversion maps the stream time @p ts to the
+ * system time @p system_ts, instead of electing a local reference point.
+ * Several instances fed the same origin (distributed out of band by the
+ * caller) therefore render a given timestamp at the same system time, which
+ * keeps genlocked outputs such as video walls aligned. The processes must
+ * share the system clock returned by vlc_tick_now().
+ *
+ * Only effective when the tracks follow the monotonic clock (cf.
+ * VLC_CLOCK_MASTER_MONOTONIC); a master output or input would override the
+ * common timebase with its own measurements.
+ *
+ * The origin survives a clock reset and is not shifted on pause/resume, so
+ * that the instance catches up with its peers after a local stall.
+ */
+void vlc_clock_main_SetExternalOrigin(vlc_clock_main_t *main_clock,
+                                      vlc_tick_t system_ts, vlc_tick_t ts);
+
 /**
  * This function sets the dejitter delay to absorb the clock jitter
  *
@@ -82,6 +151,24 @@ void vlc_clock_main_SetInputDejitter(vlc_clock_main_t *main_clock,
 void vlc_clock_main_SetDejitter(vlc_clock_main_t *main_clock, vlc_tick_t dejitter);
 
 
+/**
+ * This function selects the smoothing profile of the clock controller
+ *
+ * The profile only affects how future master updates are averaged, the
+ * current coefficient is kept as the starting point.
+ */
+void vlc_clock_main_SetProfile(vlc_clock_main_t *main_clock,
+                               enum vlc_clock_main_profile profile);
+
+/**
+ * This function reads the current regulation statistics
+ *
+ * It snapshots the applied coefficient, rate and offset along with the
+ * history of the last master updates, cf. struct vlc_clock_main_stats.
+ */
+void vlc_clock_main_GetStats(vlc_clock_main_t *main_clock,
+                             struct vlc_clock_main_stats *stats);
+
 /**
  * This function allows changing the pause status.
  */
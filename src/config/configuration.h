@@ -32,12 +32,15 @@ struct vlc_param {
         char *_Atomic str; /**< Current value (if character string) */
     } value;
 
+    _Atomic bool dirty; /**< Modified since the last successful save */
+
     struct vlc_plugin_t *owner;
     unsigned char shortname; /**< Optional short option name */
     unsigned internal:1; /**< Hidden from preferences and help */
     unsigned unsaved:1; /**< Not stored in persistent configuration */
     unsigned safe:1; /**< Safe for untrusted provisioning (playlists) */
     unsigned obsolete:1; /**< Ignored for backward compatibility */
+    unsigned seen:1; /**< Transient marker for the configuration writer */
     struct module_config_t item;
 };
 
@@ -27,6 +27,7 @@
 #include <stdatomic.h>
 #include <vlc_common.h>
 #include <vlc_actions.h>
+#include <vlc_arrays.h>
 #include <vlc_modules.h>
 #include <vlc_plugin.h>
 
@@ -144,9 +145,12 @@ int vlc_param_SetString(struct vlc_param *param, const char *value)
 
 void config_PutPsz(const char *psz_name, const char *psz_value)
 {
+    struct vlc_param *param = vlc_param_Find(psz_name);
+
     vlc_mutex_lock(&config_lock);
-    vlc_param_SetString(vlc_param_Find(psz_name), psz_value);
+    vlc_param_SetString(param, psz_value);
     vlc_mutex_unlock(&config_lock);
+    atomic_store_explicit(&param->dirty, true, memory_order_relaxed);
     atomic_store_explicit(&config_dirty, true, memory_order_release);
 }
 
@@ -168,6 +172,7 @@ void config_PutInt(const char *name, int64_t i_value)
     vlc_mutex_lock(&config_lock);
     p_config->value.i = i_value;
     vlc_mutex_unlock(&config_lock);
+    atomic_store_explicit(&param->dirty, true, memory_order_relaxed);
     atomic_store_explicit(&config_dirty, true, memory_order_release);
 }
 
@@ -192,6 +197,7 @@ void config_PutFloat(const char *name, float f_value)
     vlc_mutex_lock(&config_lock);
     p_config->value.f = f_value;
     vlc_mutex_unlock(&config_lock);
+    atomic_store_explicit(&param->dirty, true, memory_order_relaxed);
     atomic_store_explicit(&config_dirty, true, memory_order_release);
 }
 
@@ -382,28 +388,10 @@ error:
     return -1;
 }
 
-static int confcmp (const void *a, const void *b)
-{
-    const struct vlc_param *const *ca = a, *const *cb = b;
-
-    return strcmp ((*ca)->item.psz_name, (*cb)->item.psz_name);
-}
-
-static int confnamecmp (const void *key, const void *elem)
-{
-    const struct vlc_param *const *conf = elem;
-
-    return strcmp (key, (*conf)->item.psz_name);
-}
-
-static struct
-{
-    struct vlc_param **list;
-    size_t count;
-} config = { NULL, 0 };
+static vlc_dictionary_t config_index = { 0, NULL };
 
 /**
- * Index the configuration items by name for faster lookups.
+ * Index the configuration items by name for constant time lookups.
  */
 int config_SortConfig (void)
 {
@@ -413,11 +401,12 @@ int config_SortConfig (void)
     for (p = vlc_plugins; p != NULL; p = p->next)
         nconf += p->conf.count;
 
-    struct vlc_param **clist = vlc_alloc(nconf, sizeof (*clist));
-    if (unlikely(clist == NULL))
+    /* Size the table for the final item count upfront, so that insertions
+     * never trigger a rehash */
+    vlc_dictionary_init (&config_index, nconf ? (int)nconf : 1);
+    if (unlikely(config_index.i_size == 0))
         return VLC_ENOMEM;
 
-    size_t index = 0;
     for (p = vlc_plugins; p != NULL; p = p->next)
     {
         for (size_t i = 0; i < p->conf.size; i++)
@@ -427,36 +416,21 @@ int config_SortConfig (void)
 
             if (!CONFIG_ITEM(item->i_type))
                 continue; /* ignore hints */
-            assert(index < nconf);
-            clist[index++] = param;
+            vlc_dictionary_insert (&config_index, item->psz_name, param);
         }
     }
-
-    qsort (clist, nconf, sizeof (*clist), confcmp);
-
-    config.list = clist;
-    config.count = nconf;
     return VLC_SUCCESS;
 }
 
 void config_UnsortConfig (void)
 {
-    struct vlc_param **clist;
-
-    clist = config.list;
-    config.list = NULL;
-    config.count = 0;
-
-    free (clist);
+    vlc_dictionary_clear (&config_index, NULL, NULL);
 }
 
 struct vlc_param *vlc_param_Find(const char *name)
 {
-    struct vlc_param *const *p;
-
     assert(name != NULL);
-    p = bsearch (name, config.list, config.count, sizeof (*p), confnamecmp);
-    return (p != NULL) ? *p : NULL;
+    return vlc_dictionary_value_for_key (&config_index, name);
 }
 
 module_config_t *config_FindConfig(const char *name)
@@ -521,6 +495,8 @@ void config_ResetAll(void)
             else
             if (IsConfigStringType (p_config->i_type))
                 vlc_param_SetString(param, p_config->orig.psz);
+
+            atomic_store_explicit(&param->dirty, true, memory_order_relaxed);
         }
     }
     vlc_mutex_unlock(&config_lock);
@@ -336,6 +336,194 @@ config_Write (FILE *file, const char *desc, const char *type,
 }
 
 
+/* Writes a full entry (description comment plus value) for one option.
+ * The value is commented out when it matches the built-in default, as a
+ * hand-editable reminder of the option name. Caller holds the RCU read
+ * side for the sake of string values. */
+static int config_WriteEntry (FILE *file, const struct vlc_param *param)
+{
+    const module_config_t *p_item = &param->item;
+
+    if (IsConfigIntegerType (p_item->i_type))
+    {
+        int64_t val = atomic_load_explicit(&param->value.i,
+                                           memory_order_relaxed);
+        return config_Write (file, p_item->psz_text,
+                             (CONFIG_CLASS(p_item->i_type) == CONFIG_ITEM_BOOL)
+                                  ? N_("boolean") : N_("integer"),
+                             val == p_item->orig.i,
+                             p_item->psz_name, "%"PRId64, val);
+    }
+
+    if (IsConfigFloatType (p_item->i_type))
+    {
+        float val = atomic_load_explicit(&param->value.f,
+                                         memory_order_relaxed);
+        return config_Write (file, p_item->psz_text, N_("float"),
+                             val == p_item->orig.f,
+                             p_item->psz_name, "%f", val);
+    }
+
+    const char *val = atomic_load_explicit(&param->value.str,
+                                           memory_order_relaxed);
+    const char *orig = p_item->orig.psz;
+
+    if (val == NULL)
+        val = "";
+    if (orig == NULL)
+        orig = "";
+
+    assert(IsConfigStringType(p_item->i_type));
+    return config_Write(file, p_item->psz_text, N_("string"),
+                        strcmp(val, orig) == 0, p_item->psz_name, "%s", val);
+}
+
+/* Rewrites an existing "name=value" line with the current value of the
+ * option. Unlike config_WriteEntry(), this does not emit the description
+ * comment: the one from the previous file revision is preserved as-is. */
+static int config_PatchEntry (FILE *file, const struct vlc_param *param)
+{
+    const module_config_t *p_item = &param->item;
+
+    if (IsConfigIntegerType (p_item->i_type))
+    {
+        int64_t val = atomic_load_explicit(&param->value.i,
+                                           memory_order_relaxed);
+        return fprintf (file, "%s%s=%"PRId64"\n",
+                        (val == p_item->orig.i) ? "#" : "",
+                        p_item->psz_name, val);
+    }
+
+    if (IsConfigFloatType (p_item->i_type))
+    {
+        float val = atomic_load_explicit(&param->value.f,
+                                         memory_order_relaxed);
+        return fprintf (file, "%s%s=%f\n",
+                        (val == p_item->orig.f) ? "#" : "",
+                        p_item->psz_name, val);
+    }
+
+    const char *val = atomic_load_explicit(&param->value.str,
+                                           memory_order_relaxed);
+    const char *orig = p_item->orig.psz;
+
+    if (val == NULL)
+        val = "";
+    if (orig == NULL)
+        orig = "";
+
+    assert(IsConfigStringType(p_item->i_type));
+    return fprintf (file, "%s%s=%s\n", (strcmp(val, orig) == 0) ? "#" : "",
+                    p_item->psz_name, val);
+}
+
+/**
+ * Patches an existing configuration file rather than regenerating it.
+ *
+ * The previous file contents are copied over, substituting the current
+ * value of every option line encountered; everything else (comments,
+ * section headers, unknown entries) is preserved verbatim. Options
+ * modified since the last save that the file does not mention yet are
+ * appended afterwards, so the amount of work is proportional to the
+ * existing file rather than to the full registered option set.
+ */
+static int config_PatchConfigFile (FILE *src, FILE *dst)
+{
+    char *line = NULL;
+    size_t bufsize;
+    ssize_t linelen;
+    int ret = 0;
+
+    while (ret == 0 && (linelen = getline (&line, &bufsize, src)) != -1)
+    {
+        struct vlc_param *param = NULL;
+        char *name = line;
+
+        if (name[0] == '#') /* value kept at default, or plain comment */
+            name++;
+
+        char *ptr = strchr (name, '=');
+        if (ptr != NULL)
+        {
+            *ptr = '\0';
+            param = vlc_param_Find (name);
+            *ptr = '=';
+        }
+
+        if (param == NULL || !CONFIG_ITEM(param->item.i_type)
+         || param->obsolete || param->unsaved)
+        {   /* Not a live option entry: copy verbatim */
+            if (fwrite (line, 1, linelen, dst) != (size_t)linelen)
+                ret = -1;
+            continue;
+        }
+
+        param->seen = true;
+        if (config_PatchEntry (dst, param) < 0)
+            ret = -1;
+    }
+    free (line);
+
+    if (ferror (src))
+        ret = -1;
+
+    /* Append modified options that the file does not mention yet */
+    for (vlc_plugin_t *p = vlc_plugins; ret == 0 && p != NULL; p = p->next)
+    {
+        bool header = false;
+
+        for (struct vlc_param *param = p->conf.params,
+                              *end = param + p->conf.size;
+             param < end;
+             param++)
+        {
+            if (!CONFIG_ITEM(param->item.i_type)
+             || param->obsolete || param->unsaved || param->seen
+             || !atomic_load_explicit(&param->dirty, memory_order_relaxed))
+                continue;
+
+            if (!header)
+            {
+                module_t *p_parser = p->module;
+
+                fprintf (dst, "[%s]", module_get_object (p_parser));
+                if (p_parser->psz_longname)
+                    fprintf (dst, " # %s\n\n", p_parser->psz_longname);
+                else
+                    fprintf (dst, "\n\n");
+                header = true;
+            }
+
+            if (config_WriteEntry (dst, param))
+            {
+                ret = -1;
+                break;
+            }
+        }
+    }
+
+    /* Reset the transient markers for the next save */
+    for (vlc_plugin_t *p = vlc_plugins; p != NULL; p = p->next)
+        for (struct vlc_param *param = p->conf.params,
+                              *end = param + p->conf.size;
+             param < end;
+             param++)
+            param->seen = false;
+
+    return ret;
+}
+
+/* Flags every option as saved, once the file has been committed. */
+static void config_MarkSaved (void)
+{
+    for (vlc_plugin_t *p = vlc_plugins; p != NULL; p = p->next)
+        for (struct vlc_param *param = p->conf.params,
+                              *end = param + p->conf.size;
+             param < end;
+             param++)
+            atomic_store_explicit(&param->dirty, false, memory_order_relaxed);
+}
+
 static int config_PrepareDir (libvlc_int_t *obj)
 {
     char *psz_configdir = config_GetUserDir (VLC_CONFIG_DIR);
@@ -407,82 +595,55 @@ int (config_SaveConfigFile) (libvlc_int_t *p_this)
         goto error;
     }
 
-    fprintf( file,
-        "\xEF\xBB\xBF###\n"
-        "###  "PACKAGE_NAME" "PACKAGE_VERSION"\n"
-        "###\n"
-        "\n"
-        "###\n"
-        "### lines beginning with a '#' character are comments\n"
-        "###\n"
-        "\n" );
-
     /* Ensure consistent number formatting... */
     locale_t loc = newlocale (LC_NUMERIC_MASK, "C", NULL);
     locale_t baseloc = uselocale (loc);
+    int werr = 0;
 
     vlc_rcu_read_lock(); /* preserve string values */
 
-    /* Look for the selected module, if NULL then save everything */
-    for (vlc_plugin_t *p = vlc_plugins; p != NULL; p = p->next)
-    {
-        module_t *p_parser = p->module;
-
-        if (p->conf.count == 0)
-            continue;
-
-        fprintf( file, "[%s]", module_get_object (p_parser) );
-        if( p_parser->psz_longname )
-            fprintf( file, " # %s\n\n", p_parser->psz_longname );
-        else
-            fprintf( file, "\n\n" );
-
-        for (struct vlc_param *param = p->conf.params,
-                              *end = param + p->conf.size;
-             param < end;
-             param++)
+    FILE *prev = vlc_fopen (permanent, "rt");
+    if (prev != NULL)
+    {   /* Patch the existing file: only changed entries are rewritten */
+        werr = config_PatchConfigFile (prev, file);
+        fclose (prev);
+    }
+    else
+    {   /* No previous file: dump the whole option set */
+        fprintf( file,
+            "\xEF\xBB\xBF###\n"
+            "###  "PACKAGE_NAME" "PACKAGE_VERSION"\n"
+            "###\n"
+            "\n"
+            "###\n"
+            "### lines beginning with a '#' character are comments\n"
+            "###\n"
+            "\n" );
+
+        for (vlc_plugin_t *p = vlc_plugins; p != NULL; p = p->next)
         {
-            module_config_t *p_item = &param->item;
+            module_t *p_parser = p->module;
 
-            if (!CONFIG_ITEM(p_item->i_type)   /* ignore hint */
-             || param->obsolete                /* ignore deprecated option */
-             || param->unsaved)                /* ignore volatile option */
+            if (p->conf.count == 0)
                 continue;
 
-            if (IsConfigIntegerType (p_item->i_type))
-            {
-                int64_t val = atomic_load_explicit(&param->value.i,
-                                                   memory_order_relaxed);
-                config_Write (file, p_item->psz_text,
-                             (CONFIG_CLASS(p_item->i_type) == CONFIG_ITEM_BOOL)
-                                  ? N_("boolean") : N_("integer"),
-                              val == p_item->orig.i,
-                              p_item->psz_name, "%"PRId64, val);
-            }
-            else
-            if (IsConfigFloatType (p_item->i_type))
-            {
-                float val = atomic_load_explicit(&param->value.f,
-                                                 memory_order_relaxed);
-                config_Write (file, p_item->psz_text, N_("float"),
-                              val == p_item->orig.f,
-                              p_item->psz_name, "%f", val);
-            }
+            fprintf( file, "[%s]", module_get_object (p_parser) );
+            if( p_parser->psz_longname )
+                fprintf( file, " # %s\n\n", p_parser->psz_longname );
             else
+                fprintf( file, "\n\n" );
+
+            for (struct vlc_param *param = p->conf.params,
+                                  *end = param + p->conf.size;
+                 param < end;
+                 param++)
             {
-                const char *val = atomic_load_explicit(&param->value.str,
-                                                       memory_order_relaxed);
-                const char *orig = p_item->orig.psz;
-
-                if (val == NULL)
-                    val = "";
-                if (orig == NULL)
-                    orig = "";
-
-                assert(IsConfigStringType(p_item->i_type));
-                config_Write(file, p_item->psz_text, N_("string"),
-                             strcmp(val, orig) == 0, p_item->psz_name, "%s",
-                             val);
+                if (!CONFIG_ITEM(param->item.i_type) /* ignore hint */
+                 || param->obsolete          /* ignore deprecated option */
+                 || param->unsaved)          /* ignore volatile option */
+                    continue;
+
+                config_WriteEntry (file, param);
             }
         }
     }
@@ -498,7 +659,7 @@ int (config_SaveConfigFile) (libvlc_int_t *p_this)
      * Flush to disk and replace atomically
      */
     fflush (file); /* Flush from run-time */
-    if (ferror (file))
+    if (werr || ferror (file))
     {
         vlc_unlink (temporary);
         vlc_mutex_unlock (&lock);
@@ -521,6 +682,7 @@ int (config_SaveConfigFile) (libvlc_int_t *p_this)
 #if !defined (_WIN32) && !defined (__OS2__)
     fclose (file);
 #endif
+    config_MarkSaved ();
 
     free (temporary);
     free (permanent);
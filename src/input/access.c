@@ -29,6 +29,7 @@
 #include <string.h>
 
 #include <vlc_common.h>
+#include <vlc_access.h>
 #include <vlc_url.h>
 #include <vlc_modules.h>
 #include <vlc_interrupt.h>
@@ -207,6 +208,152 @@ int access_vaDirectoryControlHelper( stream_t *p_access, int i_query, va_list ar
      return VLC_SUCCESS;
 }
 
+/*****************************************************************************
+ * Access block recycling pool
+ *****************************************************************************/
+
+/* Match the alignment and pre/post padding guarantees of vlc_frame_Alloc()
+ * (see src/misc/frame.c) so pooled blocks are interchangeable */
+#define ACCESS_POOL_ALIGN   32
+#define ACCESS_POOL_PADDING 32
+
+struct vlc_access_pool
+{
+    vlc_mutex_t lock;
+    struct vlc_access_pool_block *free_list;
+    unsigned count;    /**< Idle blocks on free_list */
+    unsigned depth;    /**< Maximum idle blocks kept */
+    size_t capacity;   /**< Payload capacity of a pooled block */
+    unsigned refs;     /**< Owner plus blocks held downstream */
+    bool closed;       /**< Owner reference released */
+    uintmax_t hits;
+    uintmax_t misses;
+};
+
+struct vlc_access_pool_block
+{
+    block_t frame;
+    struct vlc_access_pool *pool;
+    struct vlc_access_pool_block *next;
+    uint8_t buffer[];
+};
+
+struct vlc_access_pool *vlc_access_pool_New(size_t capacity, unsigned depth)
+{
+    struct vlc_access_pool *pool = malloc(sizeof (*pool));
+    if (unlikely(pool == NULL))
+        return NULL;
+
+    vlc_mutex_init(&pool->lock);
+    pool->free_list = NULL;
+    pool->count = 0;
+    pool->depth = depth;
+    pool->capacity = capacity;
+    pool->refs = 1; /* owner */
+    pool->closed = false;
+    pool->hits = 0;
+    pool->misses = 0;
+    return pool;
+}
+
+static void vlc_access_pool_BlockFree(block_t *frame)
+{
+    struct vlc_access_pool_block *block =
+        container_of(frame, struct vlc_access_pool_block, frame);
+    struct vlc_access_pool *pool = block->pool;
+
+    vlc_mutex_lock(&pool->lock);
+    if (!pool->closed && pool->count < pool->depth)
+    {
+        block->next = pool->free_list;
+        pool->free_list = block;
+        pool->count++;
+        pool->refs--;
+        vlc_mutex_unlock(&pool->lock);
+        return;
+    }
+
+    unsigned refs = --pool->refs;
+    vlc_mutex_unlock(&pool->lock);
+
+    free(block);
+    if (refs == 0)
+        free(pool);
+}
+
+static const struct vlc_frame_callbacks vlc_access_pool_cbs =
+{
+    vlc_access_pool_BlockFree,
+};
+
+block_t *vlc_access_pool_Block(struct vlc_access_pool *pool, size_t size)
+{
+    if (unlikely(size > pool->capacity))
+        return block_Alloc(size); /* oversized requests bypass the pool */
+
+    struct vlc_access_pool_block *block;
+
+    vlc_mutex_lock(&pool->lock);
+    assert(!pool->closed);
+    block = pool->free_list;
+    if (block != NULL)
+    {
+        pool->free_list = block->next;
+        pool->count--;
+        pool->refs++;
+        pool->hits++;
+    }
+    else
+        pool->misses++;
+    vlc_mutex_unlock(&pool->lock);
+
+    if (block == NULL)
+    {
+        block = malloc(sizeof (*block) + ACCESS_POOL_ALIGN
+                     + (2 * ACCESS_POOL_PADDING) + pool->capacity);
+        if (unlikely(block == NULL))
+            return NULL;
+        block->pool = pool;
+
+        vlc_mutex_lock(&pool->lock);
+        pool->refs++;
+        vlc_mutex_unlock(&pool->lock);
+    }
+
+    block_t *frame = block_Init(&block->frame, &vlc_access_pool_cbs,
+                                block->buffer, ACCESS_POOL_ALIGN
+                                + (2 * ACCESS_POOL_PADDING) + pool->capacity);
+    frame->p_buffer += ACCESS_POOL_PADDING + ACCESS_POOL_ALIGN - 1;
+    frame->p_buffer = (void *)(((uintptr_t)frame->p_buffer)
+                               & ~(uintptr_t)(ACCESS_POOL_ALIGN - 1));
+    frame->i_buffer = size;
+    return frame;
+}
+
+void vlc_access_pool_Release(struct vlc_access_pool *pool, stream_t *access)
+{
+    vlc_mutex_lock(&pool->lock);
+    pool->closed = true;
+    struct vlc_access_pool_block *list = pool->free_list;
+    pool->free_list = NULL;
+    pool->count = 0;
+    unsigned refs = --pool->refs;
+    uintmax_t hits = pool->hits, misses = pool->misses;
+    vlc_mutex_unlock(&pool->lock);
+
+    if (access != NULL && hits + misses > 0)
+        msg_Dbg(access, "block pool: %ju/%ju reads recycled (%.1f%%)",
+                hits, hits + misses, 100. * hits / (hits + misses));
+
+    for (struct vlc_access_pool_block *next; list != NULL; list = next)
+    {
+        next = list->next;
+        free(list);
+    }
+    if (refs == 0)
+        free(pool);
+}
+
 /* Block access */
 static block_t *AStreamReadBlock(stream_t *s, bool *restrict eof)
 {
@@ -53,6 +53,7 @@
 #include "resource.h"
 #include "libvlc.h"
 
+#include "../misc/latency.h"
 #include "../video_output/vout_internal.h"
 
 
@@ -120,6 +121,10 @@ struct vlc_input_decoder_t
     vlc_clock_t     *p_clock;
     const char *psz_id;
 
+    /* Target decoded lead over the playback clock, 0 to decode as fast as
+     * the fifo and the output allow. Constant after creation. */
+    vlc_tick_t i_pacing_lead;
+
     const struct vlc_input_decoder_callbacks *cbs;
     void *cbs_userdata;
 
@@ -148,6 +153,25 @@ struct vlc_input_decoder_t
     /* fifo */
     block_fifo_t *p_fifo;
 
+    /* Monotonic enqueue dates of the frames in the fifo, used to trace the
+     * queue latency. Guarded by the fifo lock. Pairing with the fifo is
+     * strictly FIFO: once the ring overflows, newer frames are left unstamped
+     * (and counted) until the fifo has drained them in order. */
+    struct
+    {
+        vlc_tick_t date[64];
+        size_t head;
+        size_t count;
+        size_t unstamped;
+    } queue_stamps;
+
+    /* Enqueue date of the frame most recently handed to the decoder module,
+     * used to stamp the latency tag of the output pictures. Written by the
+     * DecoderThread, read by the ModuleThread (any thread for asynchronous
+     * decoders), hence the atomic. Decoder reordering makes the pairing
+     * approximate, which is fine for statistics. */
+    _Atomic vlc_tick_t last_input_date;
+
     /* Lock for communication with decoder thread */
     vlc_cond_t  wait_request;
     vlc_cond_t  wait_acknowledge;
@@ -636,13 +660,16 @@ static int ModuleThread_UpdateVideoFormat( decoder_t *p_dec, vlc_video_context *
             dpb_size = 2;
             break;
         }
-        picture_pool_t *pool = picture_pool_NewFromFormat( &p_dec->fmt_out.video,
-                            dpb_size + p_dec->i_extra_picture_buffers + 1 );
+        /* Let the pool grow a few pictures past the DPB estimate on demand,
+         * rather than stalling the decoder when the estimate is short. */
+        unsigned pool_size = dpb_size + p_dec->i_extra_picture_buffers + 1;
+        picture_pool_t *pool = picture_pool_NewGrowable( &p_dec->fmt_out.video,
+                            pool_size, pool_size + 8 );
 
         if( pool == NULL)
         {
-            msg_Err(p_dec, "Failed to create a pool of %d %4.4s pictures",
-                           dpb_size + p_dec->i_extra_picture_buffers + 1,
+            msg_Err(p_dec, "Failed to create a pool of %u %4.4s pictures",
+                           pool_size,
                            (char*)&p_dec->fmt_out.video.i_chroma);
             vlc_fifo_Unlock(p_owner->p_fifo);
             goto error;
@@ -1230,7 +1257,12 @@ static void ModuleThread_QueueCc( decoder_t *p_videodec, vlc_frame_t *p_cc,
     }
 }
 
-static int ModuleThread_PlayVideo( vlc_input_decoder_t *p_owner, picture_t *p_picture )
+/* Queues p_picture on p_chain for a batched vout handoff; the caller hands
+ * the chain to the vout with vout_PutPictureChain() afterwards. Pictures
+ * batched so far are pushed early whenever ordering against a vout flush,
+ * or a potentially long wait, requires it. */
+static int ModuleThread_PlayVideo( vlc_input_decoder_t *p_owner, picture_t *p_picture,
+                                   vlc_picture_chain_t *p_chain )
 {
     decoder_t *p_dec = &p_owner->dec;
 
@@ -1266,7 +1298,11 @@ static int ModuleThread_PlayVideo( vlc_input_decoder_t *p_owner, picture_t *p_pi
         msg_Dbg( p_dec, "end of video preroll" );
 
         if( p_vout )
+        {
+            if( !vlc_picture_chain_IsEmpty( p_chain ) )
+                vout_PutPictureChain( p_vout, p_chain );
             vout_FlushAll( p_vout );
+        }
     }
 
     if( p_owner->b_first && p_owner->b_waiting )
@@ -1277,6 +1313,8 @@ static int ModuleThread_PlayVideo( vlc_input_decoder_t *p_owner, picture_t *p_pi
     }
     else
     {
+        if( p_vout != NULL && !vlc_picture_chain_IsEmpty( p_chain ) )
+            vout_PutPictureChain( p_vout, p_chain );
         DecoderWaitUnblock( p_owner );
     }
 
@@ -1293,9 +1331,11 @@ static int ModuleThread_PlayVideo( vlc_input_decoder_t *p_owner, picture_t *p_pi
     if( p_picture->b_still )
     {
         /* Ensure no earlier higher pts breaks still state */
+        if( !vlc_picture_chain_IsEmpty( p_chain ) )
+            vout_PutPictureChain( p_vout, p_chain );
         vout_Flush( p_vout, p_picture->date );
     }
-    vout_PutPicture( p_vout, p_picture );
+    vlc_picture_chain_Append( p_chain, p_picture );
 
     return VLC_SUCCESS;
 }
@@ -1314,21 +1354,65 @@ static void ModuleThread_QueueVideo( decoder_t *p_dec, picture_t *p_pic )
 
     vlc_fifo_Lock( p_owner->p_fifo );
 
-    int success = ModuleThread_PlayVideo( p_owner, p_pic );
+    vlc_picture_chain_t chain;
+    vlc_picture_chain_Init( &chain );
+
+    unsigned lost = 0;
+    while( p_pic != NULL )
+    {
+        picture_t *p_next = p_pic->p_next;
+        p_pic->p_next = NULL;
+
+        struct vlc_latency_tag *tag =
+            picture_AttachNewAncillary( p_pic, VLC_ANCILLARY_ID_LATENCY,
+                                        sizeof( *tag ) );
+        if( likely(tag != NULL) )
+        {
+            tag->demux = atomic_load_explicit( &p_owner->last_input_date,
+                                               memory_order_relaxed );
+            tag->decode = vlc_tick_now();
+            tag->filter = VLC_TICK_INVALID;
+        }
+
+        if( ModuleThread_PlayVideo( p_owner, p_pic, &chain ) != VLC_SUCCESS )
+            lost++;
+        p_pic = p_next;
+    }
+
+    /* Hand the whole batch over with a single vout wakeup */
+    if( p_owner->p_vout != NULL && !vlc_picture_chain_IsEmpty( &chain ) )
+        vout_PutPictureChain( p_owner->p_vout, &chain );
 
     unsigned displayed = 0;
     unsigned vout_lost = 0;
     unsigned vout_late = 0;
+    unsigned vout_degraded = 0;
+    struct vlc_latency_histogram latency = { 0 };
     if( p_owner->p_vout != NULL )
     {
-        vout_GetResetStatistic( p_owner->p_vout, &displayed, &vout_lost, &vout_late );
+        vout_GetResetStatistic( p_owner->p_vout, &displayed, &vout_lost,
+                                &vout_late, &vout_degraded, &latency );
     }
-    if (success != VLC_SUCCESS)
-        vout_lost++;
+    vout_lost += lost;
+
+    unsigned pool_occupancy = 0;
+    unsigned pool_starved = 0;
+    vlc_tick_t pool_waited = 0;
+    if( p_owner->out_pool != NULL )
+    {
+        unsigned pool_in_use;
+        picture_pool_GetResetStats( p_owner->out_pool, &pool_occupancy,
+                                    &pool_in_use, &pool_starved, &pool_waited );
+        (void) pool_in_use;
+    }
+
+    unsigned fifo_depth = vlc_fifo_GetCount( p_owner->p_fifo );
 
     vlc_fifo_Unlock(p_owner->p_fifo);
 
-    decoder_Notify(p_owner, on_new_video_stats, 1, vout_lost, displayed, vout_late);
+    decoder_Notify(p_owner, on_new_video_stats, 1, vout_lost, displayed, vout_late,
+                   vout_degraded, fifo_depth, pool_occupancy, pool_starved,
+                   pool_waited, &latency);
 }
 
 static vlc_decoder_device * thumbnailer_get_device( decoder_t *p_dec )
@@ -1532,7 +1616,19 @@ static void DecoderThread_DecodeBlock( vlc_input_decoder_t *p_owner, vlc_frame_t
                             frame->i_pts, frame->i_dts );
     }
 
-    int ret = p_dec->pf_decode( p_dec, frame );
+    int ret;
+    if( tracer != NULL )
+    {
+        /* For asynchronous decoders, this only measures the submission time */
+        vlc_tick_t start = vlc_tick_now();
+        ret = p_dec->pf_decode( p_dec, frame );
+        vlc_tracer_Trace( tracer, VLC_TRACE("type", "DEC"),
+                          VLC_TRACE("id", p_owner->psz_id),
+                          VLC_TRACE("decode_time", vlc_tick_now() - start),
+                          VLC_TRACE_END );
+    }
+    else
+        ret = p_dec->pf_decode( p_dec, frame );
     switch( ret )
     {
         case VLCDEC_SUCCESS:
@@ -1697,6 +1793,101 @@ static void DecoderThread_Flush( vlc_input_decoder_t *p_owner )
  *
  * \param p_dec the decoder
  */
+/* Called with the fifo locked */
+static void DecoderFifo_StampFrame( vlc_input_decoder_t *p_owner )
+{
+    if( p_owner->queue_stamps.unstamped > 0
+     || p_owner->queue_stamps.count >= ARRAY_SIZE(p_owner->queue_stamps.date) )
+    {
+        p_owner->queue_stamps.unstamped++;
+        return;
+    }
+
+    size_t i = (p_owner->queue_stamps.head + p_owner->queue_stamps.count)
+             % ARRAY_SIZE(p_owner->queue_stamps.date);
+    p_owner->queue_stamps.date[i] = vlc_tick_now();
+    p_owner->queue_stamps.count++;
+}
+
+/* Called with the fifo locked. Returns VLC_TICK_INVALID if the enqueue date
+ * of the dequeued frame is unknown (ring overflow). */
+static vlc_tick_t DecoderFifo_UnstampFrame( vlc_input_decoder_t *p_owner )
+{
+    if( p_owner->queue_stamps.count == 0 )
+    {
+        if( p_owner->queue_stamps.unstamped > 0 )
+            p_owner->queue_stamps.unstamped--;
+        return VLC_TICK_INVALID;
+    }
+
+    vlc_tick_t date = p_owner->queue_stamps.date[p_owner->queue_stamps.head];
+    p_owner->queue_stamps.head = (p_owner->queue_stamps.head + 1)
+                               % ARRAY_SIZE(p_owner->queue_stamps.date);
+    p_owner->queue_stamps.count--;
+    return date;
+}
+
+/* Called with the fifo locked, whenever the fifo is emptied at once */
+static void DecoderFifo_ResetStamps( vlc_input_decoder_t *p_owner )
+{
+    p_owner->queue_stamps.head = 0;
+    p_owner->queue_stamps.count = 0;
+    p_owner->queue_stamps.unstamped = 0;
+}
+
+/* Upper bound on a single pacing wait: the stream to system time conversion
+ * can change whenever the clock gets (re)synchronized, so the slack is
+ * re-evaluated periodically rather than slept on in one go. */
+#define PACING_RECHECK_PERIOD VLC_TICK_FROM_MS(250)
+
+/**
+ * Postpones decoding while enough output is already decoded ahead.
+ *
+ * Decoding as fast as the fifo and the output pools allow oscillates between
+ * decode bursts, which fill the pools and peak the CPU and memory use, and
+ * sleeps. Instead, wait until the frame is due within the configured lead of
+ * the playback clock. Control requests (flush, pause, rate change, drain,
+ * abort) wake the wait up through vlc_fifo_Signal() and are re-checked.
+ */
+static void DecoderThread_Pace( vlc_input_decoder_t *p_owner,
+                                const vlc_frame_t *frame )
+{
+    if( p_owner->i_pacing_lead == 0 || p_owner->p_clock == NULL
+     || frame == NULL )
+        return;
+
+    vlc_tick_t ts = frame->i_pts != VLC_TICK_INVALID ? frame->i_pts
+                                                     : frame->i_dts;
+    if( ts == VLC_TICK_INVALID )
+        return;
+
+    vlc_fifo_Lock( p_owner->p_fifo );
+    while( !p_owner->flushing && !p_owner->aborting && !p_owner->paused
+        && !p_owner->b_waiting && !p_owner->b_draining
+        && p_owner->frames_countdown == 0 )
+    {
+        float rate = p_owner->output_rate;
+        vlc_fifo_Unlock( p_owner->p_fifo );
+
+        vlc_tick_t now = vlc_tick_now();
+        vlc_tick_t date = vlc_clock_ConvertToSystem( p_owner->p_clock, now,
+                                                     ts, rate );
+        vlc_fifo_Lock( p_owner->p_fifo );
+
+        if( date == VLC_TICK_MAX ) /* no conversion possible */
+            break;
+
+        vlc_tick_t deadline = date - p_owner->i_pacing_lead;
+        if( deadline <= now )
+            break;
+
+        if( deadline > now + PACING_RECHECK_PERIOD )
+            deadline = now + PACING_RECHECK_PERIOD;
+        vlc_fifo_TimedWait( p_owner->p_fifo, deadline );
+    }
+    vlc_fifo_Unlock( p_owner->p_fifo );
+}
+
 static void *DecoderThread( void *p_data )
 {
     vlc_input_decoder_t *p_owner = (vlc_input_decoder_t *)p_data;
@@ -1780,8 +1971,29 @@ static void *DecoderThread( void *p_data )
              * drain. Pass frame = NULL to decoder just once. */
         }
 
+        vlc_tick_t queued_date = frame != NULL
+            ? DecoderFifo_UnstampFrame( p_owner ) : VLC_TICK_INVALID;
+
         vlc_fifo_Unlock( p_owner->p_fifo );
 
+        if( frame != NULL )
+            atomic_store_explicit( &p_owner->last_input_date, queued_date,
+                                   memory_order_relaxed );
+
+        if( queued_date != VLC_TICK_INVALID )
+        {
+            struct vlc_tracer *tracer =
+                vlc_object_get_tracer( &p_owner->dec.obj );
+            if( tracer != NULL )
+                vlc_tracer_Trace( tracer, VLC_TRACE("type", "DEC"),
+                                  VLC_TRACE("id", p_owner->psz_id),
+                                  VLC_TRACE("queue_latency",
+                                            vlc_tick_now() - queued_date),
+                                  VLC_TRACE_END );
+        }
+
+        DecoderThread_Pace( p_owner, frame );
+
         DecoderThread_ProcessInput( p_owner, frame );
 
         vlc_fifo_Lock(p_owner->p_fifo);
@@ -1870,6 +2082,20 @@ CreateDecoder( vlc_object_t *p_parent, const struct vlc_input_decoder_cfg *cfg )
     p_owner->psz_id = cfg->str_id;
     p_owner->p_clock = cfg->clock;
     p_owner->i_preroll_end = PREROLL_NONE;
+    atomic_init( &p_owner->last_input_date, VLC_TICK_INVALID );
+
+    /* Pacing only makes sense for clocked playback to an output */
+    p_owner->i_pacing_lead = 0;
+    if( cfg->sout == NULL && cfg->input_type != INPUT_TYPE_THUMBNAILING )
+    {
+        int64_t lead_ms = 0;
+        if( fmt->i_cat == VIDEO_ES )
+            lead_ms = var_InheritInteger( p_dec, "video-decode-lead" );
+        else if( fmt->i_cat == AUDIO_ES )
+            lead_ms = var_InheritInteger( p_dec, "audio-decode-lead" );
+        if( lead_ms > 0 )
+            p_owner->i_pacing_lead = VLC_TICK_FROM_MS( lead_ms );
+    }
     p_owner->p_resource = cfg->resource;
     p_owner->cbs = cfg->cbs;
     p_owner->cbs_userdata = cfg->cbs_data;
@@ -1908,6 +2134,8 @@ CreateDecoder( vlc_object_t *p_parent, const struct vlc_input_decoder_cfg *cfg )
 
     es_format_Init( &p_owner->fmt, fmt->i_cat, 0 );
 
+    DecoderFifo_ResetStamps( p_owner );
+
     /* decoder fifo */
     p_owner->p_fifo = block_FifoNew();
     if( unlikely(p_owner->p_fifo == NULL) )
@@ -2294,6 +2522,7 @@ void vlc_input_decoder_Decode( vlc_input_decoder_t *p_owner, vlc_frame_t *frame,
             msg_Warn( &p_owner->dec, "decoder/packetizer fifo full (data not "
                       "consumed quickly enough), resetting fifo!" );
             block_ChainRelease( vlc_fifo_DequeueAllUnlocked( p_owner->p_fifo ) );
+            DecoderFifo_ResetStamps( p_owner );
             frame->i_flags |= BLOCK_FLAG_DISCONTINUITY;
         }
     }
@@ -2307,6 +2536,7 @@ void vlc_input_decoder_Decode( vlc_input_decoder_t *p_owner, vlc_frame_t *frame,
     }
 
     vlc_fifo_QueueUnlocked( p_owner->p_fifo, frame );
+    DecoderFifo_StampFrame( p_owner );
     vlc_fifo_Unlock( p_owner->p_fifo );
 }
 
@@ -2374,6 +2604,7 @@ void vlc_input_decoder_Flush( vlc_input_decoder_t *p_owner )
 
     /* Empty the fifo */
     block_ChainRelease( vlc_fifo_DequeueAllUnlocked( p_owner->p_fifo ) );
+    DecoderFifo_ResetStamps( p_owner );
 
     /* Don't need to wait for the DecoderThread to flush. Indeed, if called a
      * second time, this function will clear the FIFO again before anything was
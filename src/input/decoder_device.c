@@ -31,6 +31,20 @@ struct vlc_decoder_device_priv
 {
     struct vlc_decoder_device device;
     vlc_atomic_rc_t rc;
+    bool shared;
+};
+
+/* Process-wide decoder device broker, enabled with --dec-dev-shared.
+ * All creators then share the first device successfully opened, including
+ * across libvlc instances, so that N players cost a single GPU context.
+ * The device is still destroyed once the last user releases it. */
+static struct
+{
+    vlc_mutex_t lock;
+    vlc_decoder_device *device;
+} broker = {
+    .lock = VLC_STATIC_MUTEX,
+    .device = NULL,
 };
 
 static int decoder_device_Open(void *func, bool forced, va_list ap)
@@ -45,8 +59,8 @@ static int decoder_device_Open(void *func, bool forced, va_list ap)
     return ret;
 }
 
-vlc_decoder_device *
-vlc_decoder_device_Create(vlc_object_t *o, vlc_window_t *window)
+static vlc_decoder_device *
+decoder_device_New(vlc_object_t *o, vlc_window_t *window)
 {
     struct vlc_decoder_device_priv *priv =
             vlc_custom_create(o, sizeof (*priv), "decoder device");
@@ -65,9 +79,36 @@ vlc_decoder_device_Create(vlc_object_t *o, vlc_window_t *window)
     }
     assert(priv->device.ops != NULL);
     vlc_atomic_rc_init(&priv->rc);
+    priv->shared = false;
     return &priv->device;
 }
 
+vlc_decoder_device *
+vlc_decoder_device_Create(vlc_object_t *o, vlc_window_t *window)
+{
+    if (!var_InheritBool(o, "dec-dev-shared"))
+        return decoder_device_New(o, window);
+
+    vlc_mutex_lock(&broker.lock);
+    vlc_decoder_device *device = broker.device;
+    if (device != NULL)
+        vlc_decoder_device_Hold(device);
+    else
+    {
+        device = decoder_device_New(o, window);
+        if (device != NULL)
+        {
+            struct vlc_decoder_device_priv *priv =
+                    container_of(device, struct vlc_decoder_device_priv,
+                                 device);
+            priv->shared = true;
+            broker.device = device;
+        }
+    }
+    vlc_mutex_unlock(&broker.lock);
+    return device;
+}
+
 vlc_decoder_device *
 vlc_decoder_device_Hold(vlc_decoder_device *device)
 {
@@ -82,13 +123,28 @@ vlc_decoder_device_Release(vlc_decoder_device *device)
 {
     struct vlc_decoder_device_priv *priv =
             container_of(device, struct vlc_decoder_device_priv, device);
-    if (vlc_atomic_rc_dec(&priv->rc))
+
+    if (priv->shared)
     {
-        if (device->ops->close != NULL)
-            device->ops->close(device);
-        vlc_objres_clear(VLC_OBJECT(device));
-        vlc_object_delete(device);
+        /* Hold the broker lock over the last decrement, so that no other
+         * thread can grab the dying device from the broker. */
+        vlc_mutex_lock(&broker.lock);
+        if (!vlc_atomic_rc_dec(&priv->rc))
+        {
+            vlc_mutex_unlock(&broker.lock);
+            return;
+        }
+        assert(broker.device == device);
+        broker.device = NULL;
+        vlc_mutex_unlock(&broker.lock);
     }
+    else if (!vlc_atomic_rc_dec(&priv->rc))
+        return;
+
+    if (device->ops->close != NULL)
+        device->ops->close(device);
+    vlc_objres_clear(VLC_OBJECT(device));
+    vlc_object_delete(device);
 }
 
 /* video context */
@@ -218,14 +218,18 @@ int demux_Demux(demux_t *demux)
         if (unlikely(node == NULL))
             return VLC_DEMUXER_EGENERIC;
 
-        if (vlc_stream_ReadDir(demux, node)) {
+        int ret = vlc_stream_ReadDir(demux, node);
+        if (ret != VLC_SUCCESS && ret != VLC_EAGAIN) {
              input_item_node_Delete(node);
              return VLC_DEMUXER_EGENERIC;
         }
 
         if (es_out_Control(demux->out, ES_OUT_POST_SUBNODE, node))
             input_item_node_Delete(node);
-        return VLC_DEMUXER_EOF;
+
+        /* on VLC_EAGAIN, the node only contains a part of the entries:
+         * demux again to read the rest */
+        return ret == VLC_EAGAIN ? VLC_DEMUXER_SUCCESS : VLC_DEMUXER_EOF;
     }
 
     return VLC_DEMUXER_SUCCESS;
@@ -31,12 +31,25 @@
 #include <vlc_common.h>
 #include <vlc_demux.h>
 #include "demux.h"
+#include "stream.h"
+
+/* Make a stalled chained demuxer backpressure the sender rather than
+ * accumulate data without bound. */
+#define VLC_DEMUX_CHAINED_CAPACITY (16 << 20)
+
+/* Queued bytes before an inline chained demuxer is actually created, so that
+ * the demuxer has enough data at hand to probe the stream format. */
+#define VLC_DEMUX_CHAINED_PROBE_MIN (16 << 10)
 
 struct vlc_demux_chained_t
 {
     vlc_stream_fifo_t *writer;
     stream_t *reader;
 
+    demux_t *demux; /**< Inline mode only (no thread) */
+    bool threaded;
+    vlc_tick_t next_update;
+
     vlc_thread_t thread;
     vlc_mutex_t  lock;
 
@@ -99,8 +112,10 @@ static void *vlc_demux_chained_Thread(void *data)
     return NULL;
 }
 
-vlc_demux_chained_t *vlc_demux_chained_New(vlc_object_t *parent,
-                                           const char *name, es_out_t *out)
+static vlc_demux_chained_t *vlc_demux_chained_Create(vlc_object_t *parent,
+                                                     const char *name,
+                                                     es_out_t *out,
+                                                     bool threaded)
 {
     vlc_demux_chained_t *dc = malloc(sizeof (*dc) + strlen(name) + 1);
     if (unlikely(dc == NULL))
@@ -113,6 +128,9 @@ vlc_demux_chained_t *vlc_demux_chained_New(vlc_object_t *parent,
         return NULL;
     }
 
+    dc->demux = NULL;
+    dc->threaded = threaded;
+    dc->next_update = 0;
     dc->stats.position = 0.;
     dc->stats.length = 0;
     dc->stats.time = 0;
@@ -121,19 +139,115 @@ vlc_demux_chained_t *vlc_demux_chained_New(vlc_object_t *parent,
 
     vlc_mutex_init(&dc->lock);
 
-    if (vlc_clone(&dc->thread, vlc_demux_chained_Thread, dc))
+    if (threaded)
     {
-        vlc_stream_Delete(dc->reader);
-        vlc_stream_fifo_Close(dc->writer);
-        free(dc);
-        dc = NULL;
+        vlc_stream_fifo_SetCapacity(dc->writer, VLC_DEMUX_CHAINED_CAPACITY);
+
+        if (vlc_clone(&dc->thread, vlc_demux_chained_Thread, dc))
+        {
+            vlc_stream_Delete(dc->reader);
+            vlc_stream_fifo_Close(dc->writer);
+            free(dc);
+            dc = NULL;
+        }
     }
+    else
+        /* The sender drives the demuxer, so reads must never wait for it. */
+        vlc_stream_fifo_SetNonBlocking(dc->writer);
+
     return dc;
 }
 
+vlc_demux_chained_t *vlc_demux_chained_New(vlc_object_t *parent,
+                                           const char *name, es_out_t *out)
+{
+    return vlc_demux_chained_Create(parent, name, out, true);
+}
+
+vlc_demux_chained_t *vlc_demux_chained_NewInline(vlc_object_t *parent,
+                                                 const char *name,
+                                                 es_out_t *out)
+{
+    return vlc_demux_chained_Create(parent, name, out, false);
+}
+
+static int vlc_demux_chained_CreateDemux(vlc_demux_chained_t *dc)
+{
+    demux_t *demux = demux_New(VLC_OBJECT(dc->reader), dc->name, "vlc://nop",
+                               dc->reader, dc->out);
+    if (demux == NULL)
+    {
+        vlc_stream_Delete(dc->reader);
+        dc->reader = NULL;
+        return VLC_EGENERIC;
+    }
+
+    /* Stream FIFO cannot apply DVB filters.
+     * Get all programs and let the E/S output sort them out. */
+    demux_Control(demux, DEMUX_SET_GROUP_ALL);
+    dc->demux = demux;
+    return VLC_SUCCESS;
+}
+
+static void vlc_demux_chained_Pump(vlc_demux_chained_t *dc)
+{
+    while (vlc_stream_fifo_QueuedBytes(dc->writer) > 0)
+    {
+        if (demux_TestAndClearFlags(dc->demux, UINT_MAX)
+         || vlc_tick_now() >= dc->next_update)
+        {
+            double newpos;
+            vlc_tick_t newlen;
+            vlc_tick_t newtime;
+
+            if (demux_Control(dc->demux, DEMUX_GET_POSITION, &newpos))
+                newpos = 0.;
+            if (demux_Control(dc->demux, DEMUX_GET_LENGTH, &newlen))
+                newlen = 0;
+            if (demux_Control(dc->demux, DEMUX_GET_TIME, &newtime))
+                newtime = 0;
+
+            vlc_mutex_lock(&dc->lock);
+            dc->stats.position = newpos;
+            dc->stats.length = newlen;
+            dc->stats.time = newtime;
+            vlc_mutex_unlock(&dc->lock);
+
+            dc->next_update = vlc_tick_now() + VLC_TICK_FROM_MS(250);
+        }
+
+        if (demux_Demux(dc->demux) <= 0)
+            break;
+    }
+}
+
 void vlc_demux_chained_Send(vlc_demux_chained_t *dc, block_t *block)
 {
+    if (dc->threaded)
+    {
+        vlc_stream_fifo_Queue(dc->writer, block);
+        return;
+    }
+
+    if (dc->reader == NULL && dc->demux == NULL)
+    {   /* inline demuxer creation failed earlier */
+        block_Release(block);
+        return;
+    }
+
     vlc_stream_fifo_Queue(dc->writer, block);
+
+    if (dc->demux == NULL)
+    {
+        if (vlc_stream_fifo_QueuedBytes(dc->writer)
+                < VLC_DEMUX_CHAINED_PROBE_MIN)
+            return; /* wait for enough data to probe the format */
+
+        if (vlc_demux_chained_CreateDemux(dc))
+            return;
+    }
+
+    vlc_demux_chained_Pump(dc);
 }
 
 int vlc_demux_chained_ControlVa(vlc_demux_chained_t *dc, int query, va_list ap)
@@ -164,6 +278,24 @@ int vlc_demux_chained_ControlVa(vlc_demux_chained_t *dc, int query, va_list ap)
 void vlc_demux_chained_Delete(vlc_demux_chained_t *dc)
 {
     vlc_stream_fifo_Close(dc->writer);
-    vlc_join(dc->thread, NULL);
+
+    if (dc->threaded)
+        vlc_join(dc->thread, NULL);
+    else
+    {
+        /* Flush: a short stream may never have reached the probe
+         * threshold, so the demuxer may not even exist yet. */
+        if (dc->demux == NULL && dc->reader != NULL
+         && vlc_stream_fifo_QueuedBytes(dc->writer) > 0)
+            vlc_demux_chained_CreateDemux(dc);
+
+        if (dc->demux != NULL)
+        {
+            while (demux_Demux(dc->demux) > 0);
+            demux_Delete(dc->demux);
+        }
+        else if (dc->reader != NULL)
+            vlc_stream_Delete(dc->reader);
+    }
     free(dc);
 }
@@ -28,6 +28,7 @@
 # include "config.h"
 #endif
 
+#include <stdalign.h>
 #include <stdio.h>
 #include <assert.h>
 #include <vlc_common.h>
@@ -45,6 +46,7 @@
 #include "input_internal.h"
 #include "../clock/input_clock.h"
 #include "../clock/clock.h"
+#include "../misc/latency.h"
 #include "decoder.h"
 #include "es_out.h"
 #include "event.h"
@@ -59,8 +61,13 @@
 /*****************************************************************************
  * Local prototypes
  *****************************************************************************/
+struct es_out_pool;
+
 typedef struct
 {
+    /* Pool this program is carved from */
+    struct es_out_pool *pool;
+
     /* Program context */
     input_source_t *source;
 
@@ -107,6 +114,9 @@ struct es_out_id_t
 {
     vlc_es_id_t id;
 
+    /* Pool this track is carved from */
+    struct es_out_pool *pool;
+
     /* weak reference, used by input_decoder_callbacks and vlc_clock_cbs */
     es_out_t *out;
 
@@ -191,6 +201,10 @@ typedef struct
     struct vlc_list es;
     struct vlc_list es_slaves; /* Dynamically created es on regular es selection */
 
+    /* Bookkeeping pools */
+    struct es_out_pool *es_pool;
+    struct es_out_pool *pgrm_pool;
+
     /* mode gestion */
     bool  b_active;
     int         i_mode;
@@ -236,6 +250,125 @@ typedef struct
     es_out_t out;
 } es_out_sys_t;
 
+/*****************************************************************************
+ * Bookkeeping pool
+ *****************************************************************************/
+
+/* Number of objects allocated per slab */
+#define ES_OUT_POOL_CHUNK 32
+
+struct es_out_pool_slab
+{
+    struct es_out_pool_slab *next;
+    max_align_t data[];
+};
+
+struct es_out_pool_entry
+{
+    struct es_out_pool_entry *next;
+};
+
+/**
+ * Size-classed recycling pool for es_out bookkeeping structures.
+ *
+ * EsOutAdd() and EsOutProgramAdd() allocate one es_out_id_t or es_out_pgrm_t
+ * per track or program; on MPTS streams with hundreds of services, the churn
+ * of individual heap allocations shows up in the demux thread. Objects are
+ * therefore carved out of larger slabs and recycled through a free list.
+ * Track structures are refcounted and can outlive the es_out (see
+ * vlc_es_id_Hold()), so the pool is refcounted likewise and only vanishes
+ * with its last object.
+ */
+struct es_out_pool
+{
+    vlc_atomic_rc_t rc;
+    vlc_mutex_t lock;
+    size_t obj_size;
+    struct es_out_pool_entry *free_list;
+    struct es_out_pool_slab *slabs;
+};
+
+static struct es_out_pool *EsOutPoolNew(size_t obj_size)
+{
+    struct es_out_pool *pool = malloc(sizeof (*pool));
+    if (unlikely(pool == NULL))
+        return NULL;
+
+    /* Keep any object suitably aligned within a slab */
+    obj_size = (obj_size + alignof (max_align_t) - 1)
+               & ~(alignof (max_align_t) - 1);
+
+    vlc_atomic_rc_init(&pool->rc);
+    vlc_mutex_init(&pool->lock);
+    pool->obj_size = obj_size;
+    pool->free_list = NULL;
+    pool->slabs = NULL;
+    return pool;
+}
+
+static void EsOutPoolRelease(struct es_out_pool *pool)
+{
+    if (!vlc_atomic_rc_dec(&pool->rc))
+        return;
+
+    for (struct es_out_pool_slab *slab = pool->slabs, *next; slab != NULL;
+         slab = next)
+    {
+        next = slab->next;
+        free(slab);
+    }
+    free(pool);
+}
+
+static void *EsOutPoolAlloc(struct es_out_pool *pool)
+{
+    struct es_out_pool_entry *entry;
+
+    vlc_mutex_lock(&pool->lock);
+    entry = pool->free_list;
+    if (entry == NULL)
+    {
+        struct es_out_pool_slab *slab =
+            malloc(sizeof (*slab) + ES_OUT_POOL_CHUNK * pool->obj_size);
+        if (unlikely(slab == NULL))
+        {
+            vlc_mutex_unlock(&pool->lock);
+            return NULL;
+        }
+
+        slab->next = pool->slabs;
+        pool->slabs = slab;
+
+        unsigned char *base = (unsigned char *)slab->data;
+        for (size_t i = 1; i < ES_OUT_POOL_CHUNK; i++)
+        {
+            struct es_out_pool_entry *e =
+                (struct es_out_pool_entry *)(base + i * pool->obj_size);
+            e->next = pool->free_list;
+            pool->free_list = e;
+        }
+        entry = (struct es_out_pool_entry *)base;
+    }
+    else
+        pool->free_list = entry->next;
+    vlc_mutex_unlock(&pool->lock);
+
+    vlc_atomic_rc_inc(&pool->rc);
+    return entry;
+}
+
+static void EsOutPoolFree(struct es_out_pool *pool, void *obj)
+{
+    struct es_out_pool_entry *entry = obj;
+
+    vlc_mutex_lock(&pool->lock);
+    entry->next = pool->free_list;
+    pool->free_list = entry;
+    vlc_mutex_unlock(&pool->lock);
+
+    EsOutPoolRelease(pool);
+}
+
 static void         EsOutDelLocked( es_out_t *, es_out_id_t * );
 static void         EsOutDel    ( es_out_t *, es_out_id_t * );
 
@@ -395,7 +528,12 @@ decoder_on_thumbnail_ready(vlc_input_decoder_t *decoder, picture_t *pic, void *u
 
 static void
 decoder_on_new_video_stats(vlc_input_decoder_t *decoder, unsigned decoded, unsigned lost,
-                           unsigned displayed, unsigned late, void *userdata)
+                           unsigned displayed, unsigned late, unsigned degraded,
+                           unsigned fifo_depth,
+                           unsigned pool_occupancy, unsigned pool_starved,
+                           vlc_tick_t pool_waited,
+                           const struct vlc_latency_histogram *latency,
+                           void *userdata)
 {
     (void) decoder;
 
@@ -418,6 +556,23 @@ decoder_on_new_video_stats(vlc_input_decoder_t *decoder, unsigned decoded, unsig
                               memory_order_relaxed);
     atomic_fetch_add_explicit(&stats->late_pictures, late,
                               memory_order_relaxed);
+    atomic_fetch_add_explicit(&stats->degraded_pictures, degraded,
+                              memory_order_relaxed);
+    atomic_store_explicit(&stats->decoder_queue_depth, fifo_depth,
+                          memory_order_relaxed);
+    atomic_store_explicit(&stats->pool_occupancy, pool_occupancy,
+                          memory_order_relaxed);
+    atomic_fetch_add_explicit(&stats->pool_starved, pool_starved,
+                              memory_order_relaxed);
+    atomic_fetch_add_explicit(&stats->pool_wait_duration, pool_waited,
+                              memory_order_relaxed);
+    atomic_fetch_add_explicit(&stats->display_latency_samples,
+                              latency->samples, memory_order_relaxed);
+    atomic_fetch_add_explicit(&stats->display_latency_sum, latency->sum,
+                              memory_order_relaxed);
+    for (size_t i = 0; i < ARRAY_SIZE(stats->display_latency_histogram); i++)
+        atomic_fetch_add_explicit(&stats->display_latency_histogram[i],
+                                  latency->buckets[i], memory_order_relaxed);
 }
 
 static void
@@ -585,7 +740,7 @@ static void EsRelease(es_out_id_t *es)
         es_format_Clean(&es->fmt);
         input_source_Release(es->id.source);
         free(es->id.str_id);
-        free(es);
+        EsOutPoolFree(es->pool, es);
     }
 }
 
@@ -606,6 +761,9 @@ static void EsOutDelete( es_out_t *out )
     EsOutPropsCleanup( &p_sys->audio );
     EsOutPropsCleanup( &p_sys->sub );
 
+    EsOutPoolRelease( p_sys->es_pool );
+    EsOutPoolRelease( p_sys->pgrm_pool );
+
     free( p_sys );
 }
 
@@ -617,7 +775,7 @@ static void ProgramDelete( es_out_pgrm_t *p_pgrm )
         vlc_meta_Delete( p_pgrm->p_meta );
     input_source_Release( p_pgrm->source );
 
-    free( p_pgrm );
+    EsOutPoolFree( p_pgrm->pool, p_pgrm );
 }
 
 static void EsOutTerminate( es_out_t *out )
@@ -1441,11 +1599,12 @@ static es_out_pgrm_t *EsOutProgramAdd( es_out_t *out, input_source_t *source, in
     if( EsOutIsGroupSticky( out, source, i_group ) )
         return NULL;
 
-    es_out_pgrm_t *p_pgrm = malloc( sizeof( es_out_pgrm_t ) );
+    es_out_pgrm_t *p_pgrm = EsOutPoolAlloc( p_sys->pgrm_pool );
     if( !p_pgrm )
         return NULL;
 
     /* Init */
+    p_pgrm->pool = p_sys->pgrm_pool;
     p_pgrm->source = source;
     p_pgrm->i_id = i_group;
     p_pgrm->i_es = 0;
@@ -1460,7 +1619,7 @@ static es_out_pgrm_t *EsOutProgramAdd( es_out_t *out, input_source_t *source, in
     p_pgrm->p_main_clock = vlc_clock_main_New( p_input->obj.logger, tracer );
     if( !p_pgrm->p_main_clock )
     {
-        free( p_pgrm );
+        EsOutPoolFree( p_pgrm->pool, p_pgrm );
         return NULL;
     }
 
@@ -1468,7 +1627,7 @@ static es_out_pgrm_t *EsOutProgramAdd( es_out_t *out, input_source_t *source, in
     if( !p_pgrm->p_input_clock )
     {
         vlc_clock_main_Delete( p_pgrm->p_main_clock );
-        free( p_pgrm );
+        EsOutPoolFree( p_pgrm->pool, p_pgrm );
         return NULL;
     }
 
@@ -1485,6 +1644,23 @@ static es_out_pgrm_t *EsOutProgramAdd( es_out_t *out, input_source_t *source, in
     if (input_priv(p_input)->b_low_delay)
         vlc_clock_main_SetDejitter(p_pgrm->p_main_clock, 0);
 
+    /* Shared timebase for synchronized instances (video walls), only
+     * effective with the monotonic clock master */
+    char *psz_origin = var_InheritString( p_input, "clock-external-origin" );
+    if( psz_origin != NULL )
+    {
+        long long system_us, stream_us;
+        if( sscanf( psz_origin, "%lld:%lld", &system_us, &stream_us ) == 2 )
+            vlc_clock_main_SetExternalOrigin( p_pgrm->p_main_clock,
+                                              VLC_TICK_FROM_US( system_us ),
+                                              VLC_TICK_FROM_US( stream_us )
+                                              + VLC_TICK_0 );
+        else
+            msg_Warn( p_input, "invalid clock-external-origin, expecting "
+                      "\"<system>:<stream>\" in microseconds" );
+        free( psz_origin );
+    }
+
     /* Append it */
     vlc_list_append(&p_pgrm->node, &p_sys->programs);
 
@@ -2063,18 +2239,19 @@ static es_out_id_t *EsOutAddLocked( es_out_t *out, input_source_t *source,
         return NULL;
     }
 
-    es_out_id_t   *es = malloc( sizeof( *es ) );
+    es_out_id_t   *es = EsOutPoolAlloc( p_sys->es_pool );
     es_out_pgrm_t *p_pgrm;
 
     if( !es )
         return NULL;
 
+    es->pool = p_sys->es_pool;
     es->out = out;
     es->id.source = input_source_Hold( source );
 
     if( es_format_Copy( &es->fmt, fmt ) != VLC_SUCCESS )
     {
-        free( es );
+        EsOutPoolFree( es->pool, es );
         return NULL;
     }
 
@@ -2096,7 +2273,7 @@ static es_out_id_t *EsOutAddLocked( es_out_t *out, input_source_t *source,
     {
         es_format_Clean( &es->fmt );
         input_source_Release( es->id.source );
-        free( es );
+        EsOutPoolFree( es->pool, es );
         return NULL;
     }
 
@@ -2109,7 +2286,7 @@ static es_out_id_t *EsOutAddLocked( es_out_t *out, input_source_t *source,
             es_format_Clean( &es->fmt );
             input_source_Release( es->id.source );
             free( str_id );
-            free( es );
+            EsOutPoolFree( es->pool, es );
             return NULL;
         }
         /* Increase ref count for program */
@@ -2868,19 +3045,9 @@ static void EsOutCreateCCChannels( es_out_t *out, vlc_fourcc_t codec, uint64_t i
     }
 }
 
-/**
- * Send a block for the given es_out
- *
- * \param out the es_out to send from
- * \param es the es_out_id
- * \param p_block the data block to send
- */
-static int EsOutSend( es_out_t *out, es_out_id_t *es, block_t *p_block )
+static void EsOutSendStats( input_thread_t *p_input, es_out_id_t *es,
+                            const block_t *p_block )
 {
-    es_out_sys_t *p_sys = container_of(out, es_out_sys_t, out);
-    input_thread_t *p_input = p_sys->p_input;
-
-    assert( p_block->p_next == NULL );
     struct vlc_tracer *tracer = vlc_object_get_tracer( &p_input->obj );
 
     if ( tracer != NULL )
@@ -2894,6 +3061,12 @@ static int EsOutSend( es_out_t *out, es_out_id_t *es, block_t *p_block )
     {
         input_rate_Add( &stats->demux_bitrate, p_block->i_buffer );
 
+        /* Update the per-ES decoder input rates */
+        if( es->fmt.i_cat == VIDEO_ES )
+            input_rate_Add( &stats->video_es_bitrate, p_block->i_buffer );
+        else if( es->fmt.i_cat == AUDIO_ES )
+            input_rate_Add( &stats->audio_es_bitrate, p_block->i_buffer );
+
         /* Update number of corrupted data packats */
         if( p_block->i_flags & BLOCK_FLAG_CORRUPTED )
             atomic_fetch_add_explicit(&stats->demux_corrupted, 1,
@@ -2904,14 +3077,19 @@ static int EsOutSend( es_out_t *out, es_out_id_t *es, block_t *p_block )
             atomic_fetch_add_explicit(&stats->demux_discontinuity, 1,
                                       memory_order_relaxed);
     }
+}
 
-    vlc_mutex_lock( &p_sys->lock );
+static int EsOutSendLocked( es_out_t *out, es_out_id_t *es, block_t *p_block )
+{
+    es_out_sys_t *p_sys = container_of(out, es_out_sys_t, out);
+    input_thread_t *p_input = p_sys->p_input;
+
+    vlc_mutex_assert( &p_sys->lock );
 
     /* Drop all ESes except the video one in case of next-frame */
     if( p_sys->p_next_frame_es != NULL && p_sys->p_next_frame_es != es )
     {
         block_Release( p_block );
-        vlc_mutex_unlock( &p_sys->lock );
         return VLC_SUCCESS;
     }
 
@@ -2945,7 +3123,6 @@ static int EsOutSend( es_out_t *out, es_out_id_t *es, block_t *p_block )
     if( !es->p_dec )
     {
         block_Release( p_block );
-        vlc_mutex_unlock( &p_sys->lock );
         return VLC_SUCCESS;
     }
 
@@ -2997,9 +3174,56 @@ static int EsOutSend( es_out_t *out, es_out_id_t *es, block_t *p_block )
         EsOutCreateCCChannels( out, VLC_CODEC_CEA608, status.cc.desc.i_608_channels,
                                _("Closed captions %u"), es );
 
+    return VLC_SUCCESS;
+}
+
+/**
+ * Send a block for the given es_out
+ *
+ * \param out the es_out to send from
+ * \param es the es_out_id
+ * \param p_block the data block to send
+ */
+static int EsOutSend( es_out_t *out, es_out_id_t *es, block_t *p_block )
+{
+    es_out_sys_t *p_sys = container_of(out, es_out_sys_t, out);
+    int ret;
+
+    assert( p_block->p_next == NULL );
+
+    EsOutSendStats( p_sys->p_input, es, p_block );
+
+    vlc_mutex_lock( &p_sys->lock );
+    ret = EsOutSendLocked( out, es, p_block );
     vlc_mutex_unlock( &p_sys->lock );
 
-    return VLC_SUCCESS;
+    return ret;
+}
+
+/**
+ * Send a whole chain of blocks for the given es_out
+ *
+ * Unlike repeated es_out_Send() calls, the es_out lock is taken and the
+ * clock/preroll bookkeeping amortized over the whole chain.
+ */
+static int EsOutSendBatch( es_out_t *out, es_out_id_t *es, block_t *p_chain )
+{
+    es_out_sys_t *p_sys = container_of(out, es_out_sys_t, out);
+    int ret = VLC_SUCCESS;
+
+    vlc_mutex_lock( &p_sys->lock );
+    while( p_chain != NULL )
+    {
+        block_t *p_next = p_chain->p_next;
+
+        p_chain->p_next = NULL;
+        EsOutSendStats( p_sys->p_input, es, p_chain );
+        ret = EsOutSendLocked( out, es, p_chain );
+        p_chain = p_next;
+    }
+    vlc_mutex_unlock( &p_sys->lock );
+
+    return ret;
 }
 
 static void
@@ -4020,6 +4244,7 @@ static const struct es_out_callbacks es_out_cbs =
 {
     .add = EsOutAdd,
     .send = EsOutSend,
+    .send_batch = EsOutSendBatch,
     .del = EsOutDel,
     .control = EsOutControl,
     .destroy = EsOutDelete,
@@ -4036,6 +4261,18 @@ es_out_t *input_EsOutNew( input_thread_t *p_input, input_source_t *main_source,
     if( !p_sys )
         return NULL;
 
+    p_sys->es_pool = EsOutPoolNew( sizeof( es_out_id_t ) );
+    p_sys->pgrm_pool = EsOutPoolNew( sizeof( es_out_pgrm_t ) );
+    if( !p_sys->es_pool || !p_sys->pgrm_pool )
+    {
+        if( p_sys->es_pool )
+            EsOutPoolRelease( p_sys->es_pool );
+        if( p_sys->pgrm_pool )
+            EsOutPoolRelease( p_sys->pgrm_pool );
+        free( p_sys );
+        return NULL;
+    }
+
     p_sys->out.cbs = &es_out_cbs;
 
     vlc_mutex_init( &p_sys->lock );
@@ -240,6 +240,11 @@ typedef struct
     ts_storage_t   *p_storage_r;
     ts_storage_t   *p_storage_w;
 
+    /* Drained segments kept for reuse, to avoid recreating a temporary file
+     * and reallocating the command buffer on every rollover */
+    ts_storage_t   *p_storage_free;
+    unsigned       i_storage_free;
+
     vlc_tick_t     i_cmd_delay;
 
 } ts_thread_t;
@@ -295,6 +300,7 @@ static void         *TsRun( void * );
 
 static ts_storage_t *TsStorageNew( const char *psz_path, int64_t i_tmp_size_max );
 static void         TsStorageDelete( ts_storage_t * );
+static void         TsStorageRecycle( ts_thread_t *, ts_storage_t * );
 static void         TsStoragePack( ts_storage_t *p_storage );
 static bool         TsStorageIsFull( ts_storage_t *, const ts_cmd_t *p_cmd );
 static bool         TsStorageIsEmpty( ts_storage_t * );
@@ -931,6 +937,8 @@ static int TsStart( es_out_t *p_out )
     p_ts->i_cmd_delay = 0;
     p_ts->p_storage_r = NULL;
     p_ts->p_storage_w = NULL;
+    p_ts->p_storage_free = NULL;
+    p_ts->i_storage_free = 0;
 
     p_sys->b_delayed = true;
     if( vlc_clone( &p_ts->thread, TsRun, p_ts ) )
@@ -978,6 +986,12 @@ static void TsStop( ts_thread_t *p_ts )
     assert( !p_ts->p_storage_r || !p_ts->p_storage_r->p_next );
     if( p_ts->p_storage_r )
         TsStorageDelete( p_ts->p_storage_r );
+    while( p_ts->p_storage_free )
+    {
+        ts_storage_t *p_next = p_ts->p_storage_free->p_next;
+        TsStorageDelete( p_ts->p_storage_free );
+        p_ts->p_storage_free = p_next;
+    }
     vlc_mutex_unlock( &p_ts->lock );
 
     TsDestroy( p_ts );
@@ -988,7 +1002,19 @@ static void TsPushCmd( ts_thread_t *p_ts, ts_cmd_t *p_cmd )
 
     if( !p_ts->p_storage_w || TsStorageIsFull( p_ts->p_storage_w, p_cmd ) )
     {
-        ts_storage_t *p_storage = TsStorageNew( p_ts->psz_tmp_path, p_ts->i_tmp_size_max );
+        ts_storage_t *p_storage;
+
+        if( p_ts->p_storage_free )
+        {
+            /* Reuse a drained segment: its temporary file and command buffer
+             * are already allocated, rollover stays allocation free */
+            p_storage = p_ts->p_storage_free;
+            p_ts->p_storage_free = p_storage->p_next;
+            p_ts->i_storage_free--;
+            p_storage->p_next = NULL;
+        }
+        else
+            p_storage = TsStorageNew( p_ts->psz_tmp_path, p_ts->i_tmp_size_max );
 
         if( !p_storage )
         {
@@ -1032,7 +1058,7 @@ static int TsPopCmdLocked( ts_thread_t *p_ts, ts_cmd_t *p_cmd, bool b_flush )
         if( !p_next )
             break;
 
-        TsStorageDelete( p_ts->p_storage_r );
+        TsStorageRecycle( p_ts, p_ts->p_storage_r );
         p_ts->p_storage_r = p_next;
     }
 
@@ -1316,6 +1342,44 @@ static void TsStorageDelete( ts_storage_t *p_storage )
     free( p_storage );
 }
 
+#define TS_STORAGE_FREE_MAX 2
+
+static void TsStorageRecycle( ts_thread_t *p_ts, ts_storage_t *p_storage )
+{
+    assert( TsStorageIsEmpty( p_storage ) );
+
+    if( p_ts->i_storage_free >= TS_STORAGE_FREE_MAX )
+    {
+        TsStorageDelete( p_storage );
+        return;
+    }
+
+    /* Grow the command buffer back if the segment was packed while queued */
+    const size_t i_prealloc = TS_STORAGE_COMMAND_PREALLOC * MAX_COMMAND_SIZE;
+    if( p_storage->i_cmd_buf < i_prealloc )
+    {
+        uint8_t *p_realloc = realloc( p_storage->p_cmd_buf, i_prealloc );
+        if( !p_realloc )
+        {
+            TsStorageDelete( p_storage );
+            return;
+        }
+        p_storage->p_cmd_buf = p_realloc;
+        p_storage->i_cmd_buf = i_prealloc;
+    }
+
+    /* The temporary file is kept at its final size and rewritten in place,
+     * so the disk blocks are reused without further allocation */
+    rewind( p_storage->p_filew );
+    rewind( p_storage->p_filer );
+    p_storage->i_file_size = 0;
+    p_storage->p_cmd_r = p_storage->p_cmd_w = p_storage->p_cmd_buf;
+
+    p_storage->p_next = p_ts->p_storage_free;
+    p_ts->p_storage_free = p_storage;
+    p_ts->i_storage_free++;
+}
+
 static void TsStoragePack( ts_storage_t *p_storage )
 {
     /* Try to release a bit of memory */
@@ -43,6 +43,7 @@
 #include "resource.h"
 #include "stream.h"
 #include "stream_output/stream_output.h"
+#include "../libvlc.h"
 
 #include <vlc_aout.h>
 #include <vlc_dialog.h>
@@ -421,6 +422,19 @@ static void *Run( void *data )
 
     vlc_thread_set_name("vlc-input");
 
+    /* Pin the whole pipeline early: the demux, decoder and output threads
+     * spawned from here inherit the affinity mask, and first-touch keeps
+     * their buffers on the same node. */
+    int64_t numa_node = var_InheritInteger( p_input, "input-numa-node" );
+    if( numa_node >= 0 )
+    {
+        if( vlc_threads_SetNumaNode( numa_node ) == VLC_SUCCESS )
+            msg_Dbg( p_input, "input pinned to NUMA node %"PRId64, numa_node );
+        else
+            msg_Warn( p_input, "cannot pin input to NUMA node %"PRId64,
+                      numa_node );
+    }
+
     vlc_interrupt_set(&priv->interrupt);
 
     if( !Init( p_input ) )
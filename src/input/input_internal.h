@@ -716,6 +716,8 @@ typedef struct input_rate_t
 struct input_stats {
     input_rate_t input_bitrate;
     input_rate_t demux_bitrate;
+    input_rate_t video_es_bitrate;
+    input_rate_t audio_es_bitrate;
     atomic_uintmax_t demux_corrupted;
     atomic_uintmax_t demux_discontinuity;
     atomic_uintmax_t decoded_audio;
@@ -725,6 +727,14 @@ struct input_stats {
     atomic_uintmax_t displayed_pictures;
     atomic_uintmax_t late_pictures;
     atomic_uintmax_t lost_pictures;
+    atomic_uintmax_t degraded_pictures;
+    atomic_uintmax_t decoder_queue_depth;
+    atomic_uintmax_t pool_occupancy;
+    atomic_uintmax_t pool_starved;
+    atomic_uintmax_t pool_wait_duration;
+    atomic_uintmax_t display_latency_samples;
+    atomic_uintmax_t display_latency_sum;
+    atomic_uintmax_t display_latency_histogram[INPUT_STATS_LATENCY_BUCKETS];
 };
 
 struct input_stats *input_stats_Create(void);
@@ -37,6 +37,7 @@
 #include "item.h"
 #include "info.h"
 #include "input_internal.h"
+#include "../misc/rcu.h"
 
 struct input_item_opaque
 {
@@ -267,6 +268,78 @@ char *input_item_GetTitleFbName( input_item_t *p_item )
     return psz_ret;
 }
 
+/* Immutable refcounted string, shared with the borrowers of the item name
+ * and URI (see input_item_HoldName()) */
+struct item_string
+{
+    vlc_atomic_rc_t rc;
+    char psz_text[];
+};
+
+static struct item_string *item_string_New( const char *psz_value )
+{
+    size_t i_len = strlen( psz_value ) + 1;
+    struct item_string *str = malloc( sizeof( *str ) + i_len );
+    if( likely(str != NULL) )
+    {
+        vlc_atomic_rc_init( &str->rc );
+        memcpy( str->psz_text, psz_value, i_len );
+    }
+    return str;
+}
+
+static void item_string_Release( struct item_string *str )
+{
+    if( str != NULL && vlc_atomic_rc_dec( &str->rc ) )
+        free( str );
+}
+
+/* Replaces a shared copy with the current value of the matching plain field.
+ * Must be called with the item lock held, so that the shared copies are
+ * updated in the same order as the plain fields. The previous copy is
+ * returned: it can only be released after an RCU grace period, once the item
+ * lock has been dropped. */
+static struct item_string *item_string_Exchange( struct item_string *_Atomic *shadow,
+                                                 const char *psz_value )
+{
+    struct item_string *str =
+        ( psz_value != NULL ) ? item_string_New( psz_value ) : NULL;
+    return atomic_exchange_explicit( shadow, str, memory_order_release );
+}
+
+static const char *item_string_Hold( struct item_string *_Atomic *shadow )
+{
+    struct item_string *str;
+
+    vlc_rcu_read_lock();
+    str = atomic_load_explicit( shadow, memory_order_acquire );
+    if( str != NULL )
+        vlc_atomic_rc_inc( &str->rc );
+    vlc_rcu_read_unlock();
+
+    return ( str != NULL ) ? str->psz_text : NULL;
+}
+
+const char *input_item_HoldName( input_item_t *p_item )
+{
+    return item_string_Hold( &item_owner(p_item)->shadow_name );
+}
+
+const char *input_item_HoldURI( input_item_t *p_item )
+{
+    return item_string_Hold( &item_owner(p_item)->shadow_uri );
+}
+
+void input_item_ReleaseString( const char *psz_value )
+{
+    if( psz_value == NULL )
+        return;
+
+    struct item_string *str = (struct item_string *)
+        (void *)((char *)psz_value - offsetof(struct item_string, psz_text));
+    item_string_Release( str );
+}
+
 char *input_item_GetName( input_item_t *p_item )
 {
     vlc_mutex_lock( &p_item->lock );
@@ -283,7 +356,16 @@ void input_item_SetName( input_item_t *p_item, const char *psz_name )
     free( p_item->psz_name );
     p_item->psz_name = strdup( psz_name );
 
+    struct item_string *old =
+        item_string_Exchange( &item_owner(p_item)->shadow_name,
+                              p_item->psz_name );
     vlc_mutex_unlock( &p_item->lock );
+
+    if( old != NULL )
+    {
+        vlc_rcu_synchronize();
+        item_string_Release( old );
+    }
 }
 
 char *input_item_GetURI( input_item_t *p_i )
@@ -361,7 +443,19 @@ void input_item_SetURI( input_item_t *p_i, const char *psz_uri )
             p_i->psz_name=NULL; /* recover from undefined value */
     }
 
+    input_item_owner_t *owner = item_owner(p_i);
+    struct item_string *old_uri =
+        item_string_Exchange( &owner->shadow_uri, p_i->psz_uri );
+    struct item_string *old_name =
+        item_string_Exchange( &owner->shadow_name, p_i->psz_name );
     vlc_mutex_unlock( &p_i->lock );
+
+    if( old_uri != NULL || old_name != NULL )
+    {
+        vlc_rcu_synchronize();
+        item_string_Release( old_uri );
+        item_string_Release( old_name );
+    }
 }
 
 vlc_tick_t input_item_GetDuration( input_item_t *p_i )
@@ -456,6 +550,12 @@ void input_item_Release( input_item_t *p_item )
 
     vlc_event_manager_fini( &p_item->event_manager );
 
+    /* No borrower can hold a reference on the item any longer */
+    item_string_Release( atomic_load_explicit( &owner->shadow_name,
+                                               memory_order_relaxed ) );
+    item_string_Release( atomic_load_explicit( &owner->shadow_uri,
+                                               memory_order_relaxed ) );
+
     free( p_item->psz_name );
     free( p_item->psz_uri );
     free( p_item->p_stats );
@@ -1039,6 +1139,8 @@ input_item_NewExt( const char *psz_uri, const char *psz_name,
         return NULL;
 
     vlc_atomic_rc_init( &owner->rc );
+    atomic_init( &owner->shadow_name, NULL );
+    atomic_init( &owner->shadow_uri, NULL );
 
     input_item_t *p_input = &owner->item;
     vlc_event_manager_t * p_em = &p_input->event_manager;
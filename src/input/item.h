@@ -30,10 +30,18 @@ void input_item_SetErrorWhenReading( input_item_t *p_i, bool b_error );
 void input_item_UpdateTracksInfo( input_item_t *item, const es_format_t *fmt );
 bool input_item_ShouldPreparseSubItems( input_item_t *p_i );
 
+struct item_string;
+
 typedef struct input_item_owner
 {
     input_item_t item;
     vlc_atomic_rc_t rc;
+
+    /* Refcounted shared copies of item.psz_name and item.psz_uri, read
+     * lock-free by input_item_HoldName()/input_item_HoldURI() under RCU.
+     * Updated by the setters with the item lock held. */
+    struct item_string *_Atomic shadow_name;
+    struct item_string *_Atomic shadow_uri;
 } input_item_owner_t;
 
 # define item_owner(item) ((struct input_item_owner *)(item))
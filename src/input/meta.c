@@ -45,6 +45,86 @@ struct vlc_meta_t
     int i_status;
 };
 
+/**
+ * Interned meta values
+ *
+ * Meta values are highly redundant across items (same artist, album, genre,
+ * publisher... repeated over a whole playlist), so they are refcounted and
+ * shared through a global pool instead of being duplicated per item.
+ */
+
+#define META_INTERN_BUCKETS 1024
+
+struct vlc_meta_value
+{
+    struct vlc_meta_value *p_next;
+    unsigned i_refs;
+    char psz_text[];
+};
+
+static struct vlc_meta_value *intern_buckets[META_INTERN_BUCKETS];
+static vlc_mutex_t intern_lock = VLC_STATIC_MUTEX;
+
+/**
+ * Returns a shared copy of \p psz_val.
+ * It must be released with vlc_meta_InternRelease().
+ */
+static char *vlc_meta_InternHold( const char *psz_val )
+{
+    struct vlc_meta_value **pp_entry =
+        &intern_buckets[DictHash( psz_val, META_INTERN_BUCKETS )];
+    char *psz_ret = NULL;
+
+    vlc_mutex_lock( &intern_lock );
+    for( ; *pp_entry != NULL; pp_entry = &(*pp_entry)->p_next )
+    {
+        if( !strcmp( (*pp_entry)->psz_text, psz_val ) )
+        {
+            (*pp_entry)->i_refs++;
+            psz_ret = (*pp_entry)->psz_text;
+            break;
+        }
+    }
+
+    if( psz_ret == NULL )
+    {
+        size_t i_len = strlen( psz_val ) + 1;
+        struct vlc_meta_value *p_value = malloc( sizeof(*p_value) + i_len );
+        if( likely(p_value) )
+        {
+            p_value->p_next = NULL;
+            p_value->i_refs = 1;
+            memcpy( p_value->psz_text, psz_val, i_len );
+            *pp_entry = p_value;
+            psz_ret = p_value->psz_text;
+        }
+    }
+    vlc_mutex_unlock( &intern_lock );
+
+    return psz_ret;
+}
+
+static void vlc_meta_InternRelease( char *psz_val )
+{
+    if( psz_val == NULL )
+        return;
+
+    struct vlc_meta_value *p_value = (struct vlc_meta_value *)
+        (void *)(psz_val - offsetof(struct vlc_meta_value, psz_text));
+
+    vlc_mutex_lock( &intern_lock );
+    if( --p_value->i_refs == 0 )
+    {
+        struct vlc_meta_value **pp_entry =
+            &intern_buckets[DictHash( psz_val, META_INTERN_BUCKETS )];
+        while( *pp_entry != p_value )
+            pp_entry = &(*pp_entry)->p_next;
+        *pp_entry = p_value->p_next;
+        free( p_value );
+    }
+    vlc_mutex_unlock( &intern_lock );
+}
+
 const char *vlc_meta_TypeToString(vlc_meta_type_t meta_type)
 {
     static const char posix_names[VLC_META_TYPE_COUNT][18] =
@@ -105,18 +185,18 @@ vlc_meta_t *vlc_meta_New( void )
     return m;
 }
 
-/* Free a dictionary key allocated by strdup() in vlc_meta_AddExtra() */
-static void vlc_meta_FreeExtraKey( void *p_data, void *p_obj )
+/* Release a value interned by vlc_meta_AddExtra() */
+static void vlc_meta_ReleaseExtraValue( void *p_data, void *p_obj )
 {
     VLC_UNUSED( p_obj );
-    free( p_data );
+    vlc_meta_InternRelease( p_data );
 }
 
 void vlc_meta_Delete( vlc_meta_t *m )
 {
     for( int i = 0; i < VLC_META_TYPE_COUNT ; i++ )
-        free( m->ppsz_meta[i] );
-    vlc_dictionary_clear( &m->extra_tags, vlc_meta_FreeExtraKey, NULL );
+        vlc_meta_InternRelease( m->ppsz_meta[i] );
+    vlc_dictionary_clear( &m->extra_tags, vlc_meta_ReleaseExtraValue, NULL );
     free( m );
 }
 
@@ -128,9 +208,11 @@ void vlc_meta_Delete( vlc_meta_t *m )
 
 void vlc_meta_Set( vlc_meta_t *p_meta, vlc_meta_type_t meta_type, const char *psz_val )
 {
-    free( p_meta->ppsz_meta[meta_type] );
     assert( psz_val == NULL || IsUTF8( psz_val ) );
-    p_meta->ppsz_meta[meta_type] = psz_val ? strdup( psz_val ) : NULL;
+    /* Hold first: psz_val may alias the currently stored value */
+    char *psz_new = psz_val ? vlc_meta_InternHold( psz_val ) : NULL;
+    vlc_meta_InternRelease( p_meta->ppsz_meta[meta_type] );
+    p_meta->ppsz_meta[meta_type] = psz_new;
 }
 
 const char *vlc_meta_Get( const vlc_meta_t *p_meta, vlc_meta_type_t meta_type )
@@ -143,8 +225,8 @@ void vlc_meta_AddExtra( vlc_meta_t *m, const char *psz_name, const char *psz_val
     char *psz_oldvalue = (char *)vlc_dictionary_value_for_key( &m->extra_tags, psz_name );
     if( psz_oldvalue != kVLCDictionaryNotFound )
         vlc_dictionary_remove_value_for_key( &m->extra_tags, psz_name,
-                                            vlc_meta_FreeExtraKey, NULL );
-    vlc_dictionary_insert( &m->extra_tags, psz_name, strdup(psz_value) );
+                                            vlc_meta_ReleaseExtraValue, NULL );
+    vlc_dictionary_insert( &m->extra_tags, psz_name, vlc_meta_InternHold(psz_value) );
 }
 
 const char * vlc_meta_GetExtra( const vlc_meta_t *m, const char *psz_name )
@@ -188,8 +270,10 @@ void vlc_meta_Merge( vlc_meta_t *dst, const vlc_meta_t *src )
     {
         if( src->ppsz_meta[i] )
         {
-            free( dst->ppsz_meta[i] );
-            dst->ppsz_meta[i] = strdup( src->ppsz_meta[i] );
+            /* Holding the source value only bumps its refcount */
+            char *psz_new = vlc_meta_InternHold( src->ppsz_meta[i] );
+            vlc_meta_InternRelease( dst->ppsz_meta[i] );
+            dst->ppsz_meta[i] = psz_new;
         }
     }
 
@@ -198,10 +282,10 @@ void vlc_meta_Merge( vlc_meta_t *dst, const vlc_meta_t *src )
     for( int i = 0; ppsz_all_keys && ppsz_all_keys[i]; i++ )
     {
         /* Always try to remove the previous value */
-        vlc_dictionary_remove_value_for_key( &dst->extra_tags, ppsz_all_keys[i], vlc_meta_FreeExtraKey, NULL );
+        vlc_dictionary_remove_value_for_key( &dst->extra_tags, ppsz_all_keys[i], vlc_meta_ReleaseExtraValue, NULL );
 
         void *p_value = vlc_dictionary_value_for_key( &src->extra_tags, ppsz_all_keys[i] );
-        vlc_dictionary_insert( &dst->extra_tags, ppsz_all_keys[i], strdup( (const char*)p_value ) );
+        vlc_dictionary_insert( &dst->extra_tags, ppsz_all_keys[i], vlc_meta_InternHold( p_value ) );
         free( ppsz_all_keys[i] );
     }
     free( ppsz_all_keys );
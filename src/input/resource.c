@@ -72,6 +72,10 @@ struct input_resource_t
     vout_thread_t   *p_vout_dummy;
     struct vout_resource *vout_rsc_free;
 
+    /* Decoder device salvaged from a destroyed vout, handed over to the
+     * next vout created so hardware contexts survive input restarts */
+    vlc_decoder_device *p_dec_device;
+
     /* This lock is used to protect vout resources access (for hold)
      * It is a special case because of embed video (possible deadlock
      * between vout window request and vout holds in some(qt) interface)
@@ -146,6 +150,20 @@ static void DestroySout( input_resource_t *p_resource )
     p_resource->p_sout = NULL;
 }
 
+/* Keep a reference to the decoder device of a vout about to be closed,
+ * to spare the hardware context re-initialization on the next vout */
+static void StashDecoderDevice( input_resource_t *p_resource,
+                                vout_thread_t *p_vout )
+{
+    vlc_decoder_device *device = vout_PeekDevice( p_vout );
+    if( device == NULL )
+        return;
+
+    if( p_resource->p_dec_device != NULL )
+        vlc_decoder_device_Release( p_resource->p_dec_device );
+    p_resource->p_dec_device = device;
+}
+
 /* */
 static void DestroyVout( input_resource_t *p_resource )
 {
@@ -334,6 +352,8 @@ void input_resource_Release( input_resource_t *p_resource )
 
     DestroySout( p_resource );
     DestroyVout( p_resource );
+    if( p_resource->p_dec_device != NULL )
+        vlc_decoder_device_Release( p_resource->p_dec_device );
     if( p_resource->p_aout != NULL )
         aout_Release( p_resource->p_aout );
 
@@ -395,6 +415,7 @@ static void input_resource_PutVoutLocked(input_resource_t *p_resource,
         vlc_mutex_unlock(&p_resource->lock_hold);
 
         vout_Stop(vout);
+        StashDecoderDevice(p_resource, vout);
         vout_Close(vout);
     }
 }
@@ -439,6 +460,13 @@ RequestVoutRsc(input_resource_t *p_resource)
             return NULL;
         }
 
+        if (p_resource->p_dec_device != NULL)
+        {
+            /* Reseed the new vout with the salvaged decoder device */
+            vout_AdoptDevice(vout, p_resource->p_dec_device);
+            p_resource->p_dec_device = NULL;
+        }
+
         vout_rsc->order = vlc_list_is_empty( &p_resource->vout_rscs ) ?
             VLC_VOUT_ORDER_PRIMARY : VLC_VOUT_ORDER_SECONDARY;
 
@@ -59,6 +59,9 @@ struct input_stats *input_stats_Create(void)
 
     input_rate_Init(&stats->input_bitrate);
     input_rate_Init(&stats->demux_bitrate);
+    input_rate_Init(&stats->video_es_bitrate);
+    input_rate_Init(&stats->audio_es_bitrate);
+    atomic_init(&stats->decoder_queue_depth, 0);
     atomic_init(&stats->demux_corrupted, 0);
     atomic_init(&stats->demux_discontinuity, 0);
     atomic_init(&stats->decoded_audio, 0);
@@ -68,6 +71,14 @@ struct input_stats *input_stats_Create(void)
     atomic_init(&stats->displayed_pictures, 0);
     atomic_init(&stats->late_pictures, 0);
     atomic_init(&stats->lost_pictures, 0);
+    atomic_init(&stats->degraded_pictures, 0);
+    atomic_init(&stats->pool_occupancy, 0);
+    atomic_init(&stats->pool_starved, 0);
+    atomic_init(&stats->pool_wait_duration, 0);
+    atomic_init(&stats->display_latency_samples, 0);
+    atomic_init(&stats->display_latency_sum, 0);
+    for (size_t i = 0; i < ARRAY_SIZE(stats->display_latency_histogram); i++)
+        atomic_init(&stats->display_latency_histogram[i], 0);
     return stats;
 }
 
@@ -94,6 +105,20 @@ void input_stats_Compute(struct input_stats *stats, input_stats_t *st)
     st->i_demux_discontinuity = atomic_load_explicit(
                     &stats->demux_discontinuity, memory_order_relaxed);
 
+    /* Decoders */
+    vlc_mutex_lock(&stats->video_es_bitrate.lock);
+    st->i_video_es_read_bytes = stats->video_es_bitrate.value;
+    st->f_video_es_bitrate = stats_GetRate(&stats->video_es_bitrate);
+    vlc_mutex_unlock(&stats->video_es_bitrate.lock);
+
+    vlc_mutex_lock(&stats->audio_es_bitrate.lock);
+    st->i_audio_es_read_bytes = stats->audio_es_bitrate.value;
+    st->f_audio_es_bitrate = stats_GetRate(&stats->audio_es_bitrate);
+    vlc_mutex_unlock(&stats->audio_es_bitrate.lock);
+
+    st->i_decoder_queue_depth = atomic_load_explicit(
+                    &stats->decoder_queue_depth, memory_order_relaxed);
+
     /* Aout */
     st->i_decoded_audio = atomic_load_explicit(&stats->decoded_audio,
                                                memory_order_relaxed);
@@ -111,6 +136,21 @@ void input_stats_Compute(struct input_stats *stats, input_stats_t *st)
                                                     memory_order_relaxed);
     st->i_lost_pictures = atomic_load_explicit(&stats->lost_pictures,
                                                memory_order_relaxed);
+    st->i_degraded_pictures = atomic_load_explicit(&stats->degraded_pictures,
+                                                   memory_order_relaxed);
+    st->i_pool_occupancy = atomic_load_explicit(&stats->pool_occupancy,
+                                                memory_order_relaxed);
+    st->i_pool_starved = atomic_load_explicit(&stats->pool_starved,
+                                              memory_order_relaxed);
+    st->i_pool_wait_duration = atomic_load_explicit(&stats->pool_wait_duration,
+                                                    memory_order_relaxed);
+    st->i_display_latency_samples = atomic_load_explicit(
+                    &stats->display_latency_samples, memory_order_relaxed);
+    st->i_display_latency_sum = atomic_load_explicit(
+                    &stats->display_latency_sum, memory_order_relaxed);
+    for (size_t i = 0; i < ARRAY_SIZE(stats->display_latency_histogram); i++)
+        st->i_display_latency_histogram[i] = atomic_load_explicit(
+                    &stats->display_latency_histogram[i], memory_order_relaxed);
 }
 
 /** Update a counter element with new values
@@ -36,6 +36,29 @@ void *vlc_stream_Private(stream_t *stream);
 /* */
 void stream_CommonDelete( stream_t *s );
 
+/**
+ * Bounds the write side of a FIFO stream.
+ *
+ * Once more than @c capacity bytes are queued, vlc_stream_fifo_Queue() waits
+ * for the read side to dequeue data before accepting more, so that a stalled
+ * reader backpressures the writer instead of growing the queue without limit.
+ */
+void vlc_stream_fifo_SetCapacity(vlc_stream_fifo_t *writer, size_t capacity);
+
+/**
+ * Makes the read side of a FIFO stream non-blocking.
+ *
+ * Reading from an empty FIFO then reports end-of-stream rather than waiting
+ * for data. This is only meaningful when the writer also drives the reads and
+ * thus knows how much data is available, as with an inline chained demuxer.
+ */
+void vlc_stream_fifo_SetNonBlocking(vlc_stream_fifo_t *writer);
+
+/**
+ * Returns the number of queued bytes in a FIFO stream.
+ */
+size_t vlc_stream_fifo_QueuedBytes(vlc_stream_fifo_t *writer);
+
 stream_t *vlc_stream_AttachmentNew(vlc_object_t *p_this,
                                    input_attachment_t *attachment);
 
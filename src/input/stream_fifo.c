@@ -36,6 +36,9 @@
 
 struct vlc_stream_fifo {
     vlc_queue_t queue;
+    size_t bytes; /**< Number of queued bytes */
+    size_t capacity; /**< Queued bytes limit (SIZE_MAX: unbounded) */
+    bool blocking; /**< Whether the read side waits for data */
     bool eof;
 };
 
@@ -58,8 +61,11 @@ static void vlc_stream_fifo_Destroy(stream_t *s)
 
     vlc_queue_Lock(&writer->queue);
     block = vlc_queue_DequeueAllUnlocked(&writer->queue);
+    writer->bytes = 0;
     closed = writer->eof;
     writer->eof = true;
+    /* Unblock a writer waiting for queue space */
+    vlc_queue_Signal(&writer->queue);
     vlc_queue_Unlock(&writer->queue);
 
     block_ChainRelease(block);
@@ -72,10 +78,22 @@ static void vlc_stream_fifo_Destroy(stream_t *s)
 static block_t *vlc_stream_fifo_Block(stream_t *s, bool *restrict eof)
 {
     struct vlc_stream_fifo *sys = vlc_stream_fifo_Writer(s);
-    block_t *block = vlc_queue_DequeueKillable(&sys->queue, &sys->eof);
+    block_t *block;
 
-    if (block == NULL)
+    vlc_queue_Lock(&sys->queue);
+    while (vlc_queue_IsEmpty(&sys->queue) && !sys->eof && sys->blocking)
+        vlc_queue_Wait(&sys->queue);
+
+    block = vlc_queue_DequeueUnlocked(&sys->queue);
+    if (block != NULL) {
+        sys->bytes -= block->i_buffer;
+        /* Unblock a writer waiting for queue space */
+        vlc_queue_Signal(&sys->queue);
+    } else
+        /* In non-blocking mode, an empty queue also reads as end-of-stream:
+         * the caller drives the read side and knows when data was queued. */
         *eof = true;
+    vlc_queue_Unlock(&sys->queue);
 
     return block;
 }
@@ -110,6 +128,9 @@ vlc_stream_fifo_t *vlc_stream_fifo_New(vlc_object_t *parent, stream_t **reader)
         return NULL;
 
     vlc_queue_Init(&writer->queue, offsetof (block_t, p_next));
+    writer->bytes = 0;
+    writer->capacity = SIZE_MAX;
+    writer->blocking = true;
     writer->eof = false;
 
     struct vlc_stream_fifo_private *sys;
@@ -129,12 +150,45 @@ vlc_stream_fifo_t *vlc_stream_fifo_New(vlc_object_t *parent, stream_t **reader)
     return writer;
 }
 
+void vlc_stream_fifo_SetCapacity(vlc_stream_fifo_t *writer, size_t capacity)
+{
+    vlc_queue_Lock(&writer->queue);
+    writer->capacity = capacity;
+    vlc_queue_Unlock(&writer->queue);
+}
+
+void vlc_stream_fifo_SetNonBlocking(vlc_stream_fifo_t *writer)
+{
+    vlc_queue_Lock(&writer->queue);
+    writer->blocking = false;
+    vlc_queue_Unlock(&writer->queue);
+}
+
+size_t vlc_stream_fifo_QueuedBytes(vlc_stream_fifo_t *writer)
+{
+    size_t bytes;
+
+    vlc_queue_Lock(&writer->queue);
+    bytes = writer->bytes;
+    vlc_queue_Unlock(&writer->queue);
+    return bytes;
+}
+
 int vlc_stream_fifo_Queue(vlc_stream_fifo_t *writer, block_t *block)
 {
+    size_t bytes = 0;
+
+    for (block_t *b = block; b != NULL; b = b->p_next)
+        bytes += b->i_buffer;
+
     vlc_queue_Lock(&writer->queue);
+    while (!writer->eof && writer->bytes >= writer->capacity)
+        vlc_queue_Wait(&writer->queue);
+
     if (likely(!writer->eof))
     {
         vlc_queue_EnqueueUnlocked(&writer->queue, block);
+        writer->bytes += bytes;
         block = NULL;
     }
     vlc_queue_Unlock(&writer->queue);
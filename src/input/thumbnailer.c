@@ -26,6 +26,7 @@
 
 #include <vlc_thumbnailer.h>
 #include <vlc_executor.h>
+#include <vlc_cpu.h>
 #include "input_internal.h"
 
 struct vlc_thumbnailer_t
@@ -65,7 +66,14 @@ struct vlc_thumbnailer_request_t
      * VLC_TICK_INVALID means no timeout
      */
     vlc_tick_t timeout;
+    /**
+     * Absolute deadline shared by a whole batch, or VLC_TICK_INVALID for
+     * standalone requests (which count their timeout from execution start)
+     */
+    vlc_tick_t deadline;
     vlc_thumbnailer_cb cb;
+    vlc_thumbnailer_batch_cb batch_cb;
+    size_t index; /**< position in the batch, for batch_cb */
     void* userdata;
 
     vlc_mutex_t lock;
@@ -98,8 +106,11 @@ TaskNew(vlc_thumbnailer_t *thumbnailer, input_item_t *item,
     task->seek_target = seek_target;
     task->fast_seek = fast_seek;
     task->cb = cb;
+    task->batch_cb = NULL;
+    task->index = 0;
     task->userdata = userdata;
     task->timeout = timeout;
+    task->deadline = VLC_TICK_INVALID;
 
     vlc_mutex_init(&task->lock);
     vlc_cond_init(&task->cond_ended);
@@ -125,6 +136,11 @@ TaskRelease(task_t *task)
 
 static void NotifyThumbnail(task_t *task, picture_t *pic)
 {
+    if (task->batch_cb != NULL)
+    {
+        task->batch_cb(task->userdata, task->index, pic);
+        return;
+    }
     assert(task->cb);
     task->cb(task->userdata, pic);
 }
@@ -169,6 +185,19 @@ RunnableRun(void *userdata)
     vlc_thumbnailer_t *thumbnailer = task->thumbnailer;
 
     vlc_tick_t now = vlc_tick_now();
+    vlc_tick_t deadline;
+
+    if (task->deadline != VLC_TICK_INVALID)
+    {
+        /* Batch requests share one absolute deadline, counted from
+         * submission rather than from execution start */
+        deadline = task->deadline;
+        if (now >= deadline) /* the batch deadline elapsed while queued */
+            goto error;
+    }
+    else
+        deadline = (task->timeout != VLC_TICK_INVALID) ? now + task->timeout
+                                                       : VLC_TICK_INVALID;
 
     input_thread_t* input =
             input_Create( thumbnailer->parent, on_thumbnailer_input_event, task,
@@ -192,14 +221,13 @@ RunnableRun(void *userdata)
     }
 
     vlc_mutex_lock(&task->lock);
-    if (task->timeout == VLC_TICK_INVALID)
+    if (deadline == VLC_TICK_INVALID)
     {
         while (task->status == RUNNING)
             vlc_cond_wait(&task->cond_ended, &task->lock);
     }
     else
     {
-        vlc_tick_t deadline = now + task->timeout;
         int timeout = 0;
         while (task->status == RUNNING && timeout == 0)
             timeout =
@@ -220,7 +248,13 @@ RunnableRun(void *userdata)
     input_Stop(input);
     input_Close(input);
 
+    TaskRelease(task);
+    return;
+
 error:
+    /* Batch entries always report completion, even without a pipeline */
+    if (task->batch_cb != NULL)
+        NotifyThumbnail(task, NULL);
     TaskRelease(task);
 }
 
@@ -281,6 +315,41 @@ vlc_thumbnailer_RequestByPos( vlc_thumbnailer_t *thumbnailer,
                          userdata);
 }
 
+int
+vlc_thumbnailer_RequestBatch( vlc_thumbnailer_t *thumbnailer,
+                              const struct vlc_thumbnailer_batch_item *items,
+                              size_t count,
+                              enum vlc_thumbnailer_seek_speed speed,
+                              vlc_tick_t timeout,
+                              vlc_thumbnailer_batch_cb cb, void* userdata )
+{
+    bool fast_seek = speed == VLC_THUMBNAILER_SEEK_FAST;
+    vlc_tick_t deadline = (timeout != VLC_TICK_INVALID)
+                        ? vlc_tick_now() + timeout : VLC_TICK_INVALID;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        struct seek_target seek_target = {
+            .type = VLC_THUMBNAILER_SEEK_TIME,
+            .time = items[i].time,
+        };
+        task_t *task = TaskNew(thumbnailer, items[i].item, seek_target,
+                               fast_seek, NULL, userdata, VLC_TICK_INVALID);
+        if (!task)
+            return VLC_ENOMEM;
+
+        task->batch_cb = cb;
+        task->index = i;
+        task->deadline = deadline;
+
+        /* Batch tasks are fire-and-forget: the executor holds the only
+         * reference, so no request object is returned to destroy */
+        vlc_executor_Submit(thumbnailer->executor, &task->runnable);
+    }
+
+    return VLC_SUCCESS;
+}
+
 void vlc_thumbnailer_DestroyRequest( vlc_thumbnailer_t* thumbnailer, task_t* task )
 {
     bool canceled = vlc_executor_Cancel(thumbnailer->executor, &task->runnable);
@@ -303,7 +372,16 @@ vlc_thumbnailer_t *vlc_thumbnailer_Create( vlc_object_t* parent)
     if ( unlikely( thumbnailer == NULL ) )
         return NULL;
 
-    thumbnailer->executor = vlc_executor_New(1);
+    int max_threads = var_InheritInteger(parent, "thumbnailer-threads");
+    if (max_threads < 1)
+    {
+        /* Each pipeline runs its own input and decoders: cap well below
+         * the core count to leave room for playback */
+        unsigned count = vlc_GetCPUCount() / 2;
+        max_threads = (count < 4) ? ((count < 1) ? 1 : (int)count) : 4;
+    }
+
+    thumbnailer->executor = vlc_executor_New(max_threads);
     if (!thumbnailer->executor)
     {
         free(thumbnailer);
@@ -55,6 +55,7 @@
  *****************************************************************************/
 
 static void* Manage( void * );
+static vlm_media_sys_t *vlm_ControlMediaGetById( vlm_t *p_vlm, int64_t id );
 
 static void player_on_state_changed(vlc_player_t *player,
                                     enum vlc_player_state new_state, void *data)
@@ -97,6 +98,15 @@ static void player_on_state_changed(vlc_player_t *player,
 
     vlc_mutex_lock( &p_vlm->lock_manage );
     p_vlm->input_state_changed = true;
+    /* Flag this media so the manage thread only visits the broadcasts that
+     * actually changed instead of rescanning the whole media list. */
+    int i;
+    for( i = 0; i < p_vlm->i_state_changed_media; i++ )
+        if( p_vlm->state_changed_media[i] == p_media->cfg.id )
+            break;
+    if( i == p_vlm->i_state_changed_media )
+        TAB_APPEND( p_vlm->i_state_changed_media, p_vlm->state_changed_media,
+                    p_media->cfg.id );
     vlc_cond_signal( &p_vlm->wait_manage );
     vlc_mutex_unlock( &p_vlm->lock_manage );
 }
@@ -140,6 +150,7 @@ vlm_t *vlm_New( libvlc_int_t *libvlc, const char *psz_vlmconf )
     p_vlm->users = 1;
     p_vlm->input_state_changed = false;
     p_vlm->exiting = false;
+    TAB_INIT( p_vlm->i_state_changed_media, p_vlm->state_changed_media );
     p_vlm->i_id = 1;
     TAB_INIT( p_vlm->i_media, p_vlm->media );
     TAB_INIT( p_vlm->i_schedule, p_vlm->schedule );
@@ -215,6 +226,7 @@ void vlm_Delete( vlm_t *p_vlm )
     vlc_mutex_unlock( &vlm_mutex );
 
     vlc_join( p_vlm->thread, NULL );
+    TAB_CLEAN( p_vlm->i_state_changed_media, p_vlm->state_changed_media );
     vlc_object_delete(p_vlm);
 }
 
@@ -250,12 +262,26 @@ static void* Manage( void* p_object )
     {
         char **ppsz_scheduled_commands = NULL;
         int    i_scheduled_commands = 0;
+        int64_t *pi_changed_media;
+        int      i_changed_media;
+
+        /* Grab the media flagged by the player state callback; the others
+         * cannot have an instance needing a restart, so a pass only visits
+         * the broadcasts that changed instead of the whole media list. */
+        vlc_mutex_lock( &vlm->lock_manage );
+        pi_changed_media = vlm->state_changed_media;
+        i_changed_media = vlm->i_state_changed_media;
+        TAB_INIT( vlm->i_state_changed_media, vlm->state_changed_media );
+        vlc_mutex_unlock( &vlm->lock_manage );
 
         /* destroy the inputs that wants to die, and launch the next input */
         vlc_mutex_lock( &vlm->lock );
-        for( int i = 0; i < vlm->i_media; i++ )
+        for( int i = 0; i < i_changed_media; i++ )
         {
-            vlm_media_sys_t *p_media = vlm->media[i];
+            vlm_media_sys_t *p_media =
+                vlm_ControlMediaGetById( vlm, pi_changed_media[i] );
+            if( p_media == NULL ) /* deleted since the state change */
+                continue;
 
             for( int j = 0; j < p_media->i_instance; )
             {
@@ -286,6 +312,7 @@ static void* Manage( void* p_object )
                 }
             }
         }
+        free( pi_changed_media );
 
         /* scheduling */
         time_t now, nextschedule = 0;
@@ -87,6 +87,10 @@ struct vlm_t
     /* tell vlm thread there is work to do */
     bool         input_state_changed;
     bool         exiting;
+    /* media whose player state changed since the last manage pass,
+     * protected by lock_manage */
+    int          i_state_changed_media;
+    int64_t     *state_changed_media;
     /* */
     int64_t        i_id;
 
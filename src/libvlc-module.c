@@ -90,6 +90,12 @@ static const char *const ppsz_snap_formats[] =
     "This is the verbosity level (0=only errors and " \
     "standard messages, 1=warnings, 2=debug).")
 
+#define LOG_ASYNC_TEXT N_("Asynchronous logging")
+#define LOG_ASYNC_LONGTEXT N_( \
+    "Queue log messages to a dedicated logger thread instead of writing " \
+    "them from the emitting thread. Messages are dropped rather than " \
+    "blocking time-sensitive threads when the queue is full.")
+
 #define OPEN_TEXT N_("Default stream")
 #define OPEN_LONGTEXT N_( \
     "This stream will always be opened at VLC startup." )
@@ -555,6 +561,18 @@ static const char *const fit_descriptions[] = {
     "This defines the maximum input delay jitter that the synchronization " \
     "algorithms should try to compensate (in milliseconds)." )
 
+#define VIDEO_DECODE_LEAD_TEXT N_("Video decode lead")
+#define VIDEO_DECODE_LEAD_LONGTEXT N_( \
+    "How far ahead of the playback clock the video decoder is allowed to " \
+    "run, in milliseconds. Pacing the decoder smooths the CPU load and " \
+    "bounds the number of decoded pictures held in memory. 0 decodes as " \
+    "fast as the output allows." )
+
+#define AUDIO_DECODE_LEAD_TEXT N_("Audio decode lead")
+#define AUDIO_DECODE_LEAD_LONGTEXT N_( \
+    "How far ahead of the playback clock the audio decoder is allowed to " \
+    "run, in milliseconds. 0 decodes as fast as the output allows." )
+
 #define CLOCK_MASTER_TEXT N_("Clock master source")
 #define CLOCK_MASTER_LONGTEXT N_( "Select the clock master source:\n" \
     "auto: best clock source, input if the access can't be paced " \
@@ -576,6 +594,14 @@ static const char *const ppsz_clock_master_descriptions[] = {
     N_("Monotonic")
 };
 
+#define CLOCK_EXTERNAL_ORIGIN_TEXT N_("External clock origin")
+#define CLOCK_EXTERNAL_ORIGIN_LONGTEXT N_( \
+    "Shared timebase origin, as \"<system>:<stream>\" in microseconds, " \
+    "mapping the stream time to the monotonic system clock. Instances " \
+    "given the same origin render a given timestamp at the same system " \
+    "time, which keeps several players synchronized (video walls). Only " \
+    "used with the monotonic clock master." )
+
 static const int pi_clock_values[] = { -1, 0, 1 };
 static const char *const ppsz_clock_descriptions[] =
 { N_("Default"), N_("Disable"), N_("Enable") };
@@ -681,6 +707,22 @@ static const char *const ppsz_prefres[] = {
     "Try to minimize delay along decoding chain."\
     "Might break with non compliant streams.")
 
+#define THREAD_AFFINITY_TEXT N_("Thread class CPU affinity mask")
+#define THREAD_AFFINITY_LONGTEXT N_( \
+    "Bitmask of the CPUs the threads of this class may run on " \
+    "(0 to leave the scheduler free).")
+
+#define THREAD_RT_PRIORITY_TEXT N_("Thread class real-time priority")
+#define THREAD_RT_PRIORITY_LONGTEXT N_( \
+    "Round-robin real-time priority applied to the threads of this class " \
+    "(0 to keep default scheduling). Requires the appropriate privileges.")
+
+#define INPUT_NUMA_NODE_TEXT N_("Input NUMA node")
+#define INPUT_NUMA_NODE_LONGTEXT N_( \
+    "Pin the input thread, and the decoding pipeline threads it spawns, " \
+    "to the CPUs of this NUMA node (-1 to disable). Buffers allocated by " \
+    "the pinned pipeline then stay on the same node.")
+
 #define INPUT_REPEAT_TEXT N_("Input repetitions")
 #define INPUT_REPEAT_LONGTEXT N_( \
     "Number of time the same input will be repeated")
@@ -1004,6 +1046,14 @@ static const char* const ppsz_restore_playback_desc[] = {
 #define DEC_DEV_TEXT N_("Preferred decoder hardware device")
 #define DEC_DEV_LONGTEXT N_("This allows hardware decoding when available.")
 
+#define DEC_DEV_SHARED_TEXT N_("Share the decoder hardware device")
+#define DEC_DEV_SHARED_LONGTEXT N_( \
+    "Share a single decoder hardware device across the whole process, " \
+    "including between libvlc instances, instead of creating one per " \
+    "video output. This reduces GPU context memory when running many " \
+    "players, but is only suitable for devices that do not depend on " \
+    "the video window.")
+
 /*****************************************************************************
  * Sout
  ****************************************************************************/
@@ -1104,6 +1154,12 @@ static const char* const ppsz_restore_playback_desc[] = {
     "Scan plugin directories for new plugins at startup. " \
     "This increases the startup time of VLC.")
 
+#define PLUGINS_MANIFEST_TEXT N_("Plugins preload manifest")
+#define PLUGINS_MANIFEST_LONGTEXT N_( \
+    "Load only the plugins listed in this file (one shared object path " \
+    "per line) instead of scanning the plugin directories. " \
+    "This minimizes the startup time of fixed-function setups.")
+
 #define KEYSTORE_TEXT N_("Preferred keystore list")
 #define KEYSTORE_LONGTEXT N_( \
     "List of keystores that VLC will use in priority." )
@@ -1183,7 +1239,13 @@ static const char *const clock_sources_text[] = {
 
 #define PREPARSE_THREADS_TEXT N_( "Preparsing threads" )
 #define PREPARSE_THREADS_LONGTEXT N_( \
-    "Maximum number of threads used to preparse items" )
+    "Maximum number of threads used to preparse items " \
+    "(0 scales with the number of CPU cores)" )
+
+#define THUMBNAILER_THREADS_TEXT N_( "Thumbnailer threads" )
+#define THUMBNAILER_THREADS_LONGTEXT N_( \
+    "Maximum number of thumbnailing pipelines running in parallel " \
+    "(0 scales with the number of CPU cores)" )
 
 #define FETCH_ART_THREADS_TEXT N_( "Fetch-art threads" )
 #define FETCH_ART_THREADS_LONGTEXT N_( \
@@ -1263,6 +1325,12 @@ static const char *const psz_recursive_list_text[] = {
     "The media library is automatically saved and reloaded each time you " \
     "start VLC." )
 
+#define ML_PAUSE_SCAN_TEXT N_("Pause media library scan during playback")
+#define ML_PAUSE_SCAN_LONGTEXT N_( \
+    "Pause background media library discovery, parsing and thumbnailing " \
+    "while a media is playing, so that scanning does not compete with " \
+    "playback for disk and CPU." )
+
 #define PLTREE_TEXT N_("Display playlist tree")
 #define PLTREE_LONGTEXT N_( \
     "The playlist can use a tree to categorize some items, like the " \
@@ -1836,6 +1904,9 @@ vlc_module_begin ()
     add_bool( "low-delay", false, INPUT_LOWDELAY_TEXT,
               INPUT_LOWDELAY_LONGTEXT )
         change_safe ()
+    add_integer( "input-numa-node", -1,
+                 INPUT_NUMA_NODE_TEXT, INPUT_NUMA_NODE_LONGTEXT )
+        change_safe ()
 
     set_section( N_( "Playback control" ) , NULL)
     add_integer( "input-repeat", 0,
@@ -1972,9 +2043,17 @@ vlc_module_begin ()
     add_integer( "clock-jitter", 5000, CLOCK_JITTER_TEXT,
               CLOCK_JITTER_LONGTEXT )
         change_safe()
+    add_integer( "video-decode-lead", 500, VIDEO_DECODE_LEAD_TEXT,
+              VIDEO_DECODE_LEAD_LONGTEXT )
+        change_safe()
+    add_integer( "audio-decode-lead", 500, AUDIO_DECODE_LEAD_TEXT,
+              AUDIO_DECODE_LEAD_LONGTEXT )
+        change_safe()
     add_string( "clock-master", "auto",
                  CLOCK_MASTER_TEXT, CLOCK_MASTER_LONGTEXT )
         change_string_list( ppsz_clock_master_values, ppsz_clock_master_descriptions )
+    add_string( "clock-external-origin", NULL,
+                 CLOCK_EXTERNAL_ORIGIN_TEXT, CLOCK_EXTERNAL_ORIGIN_LONGTEXT )
 
     add_directory("input-record-path", NULL,
                   INPUT_RECORD_PATH_TEXT, INPUT_RECORD_PATH_LONGTEXT)
@@ -2006,6 +2085,8 @@ vlc_module_begin ()
     add_bool( "hw-dec", true, HW_DEC_TEXT, HW_DEC_LONGTEXT )
     add_obsolete_string( "encoder" ) /* since 4.0.0 */
     add_module("dec-dev", "decoder device", "any", DEC_DEV_TEXT, DEC_DEV_LONGTEXT)
+    add_bool("dec-dev-shared", false, DEC_DEV_SHARED_TEXT,
+             DEC_DEV_SHARED_LONGTEXT)
 
     //set_subcategory( SUBCAT_INPUT_SCODEC )
     set_subcategory( SUBCAT_INPUT_STREAM_FILTER )
@@ -2068,6 +2149,9 @@ vlc_module_begin ()
     add_bool( "plugins-scan", true, PLUGINS_SCAN_TEXT,
               PLUGINS_SCAN_LONGTEXT )
         change_volatile ()
+    add_loadfile( "plugins-manifest", NULL, PLUGINS_MANIFEST_TEXT,
+                  PLUGINS_MANIFEST_LONGTEXT )
+        change_volatile ()
 #endif
     add_string( "keystore", NULL, KEYSTORE_TEXT,
                 KEYSTORE_LONGTEXT )
@@ -2079,6 +2163,23 @@ vlc_module_begin ()
     add_obsolete_integer( "rt-offset" ) /* since 4.0.0 */
 #endif
 
+    add_integer( "decode-affinity", 0, THREAD_AFFINITY_TEXT,
+                 THREAD_AFFINITY_LONGTEXT )
+    add_integer( "render-affinity", 0, THREAD_AFFINITY_TEXT,
+                 THREAD_AFFINITY_LONGTEXT )
+    add_integer( "audio-affinity", 0, THREAD_AFFINITY_TEXT,
+                 THREAD_AFFINITY_LONGTEXT )
+    add_integer( "network-affinity", 0, THREAD_AFFINITY_TEXT,
+                 THREAD_AFFINITY_LONGTEXT )
+    add_integer( "decode-rt-priority", 0, THREAD_RT_PRIORITY_TEXT,
+                 THREAD_RT_PRIORITY_LONGTEXT )
+    add_integer( "render-rt-priority", 0, THREAD_RT_PRIORITY_TEXT,
+                 THREAD_RT_PRIORITY_LONGTEXT )
+    add_integer( "audio-rt-priority", 0, THREAD_RT_PRIORITY_TEXT,
+                 THREAD_RT_PRIORITY_LONGTEXT )
+    add_integer( "network-rt-priority", 0, THREAD_RT_PRIORITY_TEXT,
+                 THREAD_RT_PRIORITY_LONGTEXT )
+
 #if defined(HAVE_DBUS)
     add_obsolete_bool( "inhibit" ) /* since 3.0.0 */
 #endif
@@ -2129,6 +2230,8 @@ vlc_module_begin ()
     add_bool( "dbus", false, DBUS_TEXT, DBUS_LONGTEXT )
 #endif
     add_bool( "media-library", false, ML_TEXT, ML_LONGTEXT )
+    add_bool( "media-library-pause-on-playback", true, ML_PAUSE_SCAN_TEXT,
+              ML_PAUSE_SCAN_LONGTEXT )
     add_bool( "playlist-tree", false, PLTREE_TEXT, PLTREE_LONGTEXT )
 
     add_string( "open", "", OPEN_TEXT, OPEN_LONGTEXT )
@@ -2139,9 +2242,12 @@ vlc_module_begin ()
     add_integer( "preparse-timeout", 5000, PREPARSE_TIMEOUT_TEXT,
                  PREPARSE_TIMEOUT_LONGTEXT )
 
-    add_integer( "preparse-threads", 1, PREPARSE_THREADS_TEXT,
+    add_integer( "preparse-threads", 0, PREPARSE_THREADS_TEXT,
                  PREPARSE_THREADS_LONGTEXT )
 
+    add_integer( "thumbnailer-threads", 1, THUMBNAILER_THREADS_TEXT,
+                 THUMBNAILER_THREADS_LONGTEXT )
+
     add_integer( "fetch-art-threads", 1, FETCH_ART_THREADS_TEXT,
                  FETCH_ART_THREADS_LONGTEXT )
 
@@ -2199,6 +2305,7 @@ vlc_module_begin ()
     add_obsolete_string( "pidfile" ) /* since 4.0.0 */
 #endif
 
+    add_bool( "log-async", false, LOG_ASYNC_TEXT, LOG_ASYNC_LONGTEXT )
     add_bool( "color", true, COLOR_TEXT, COLOR_LONGTEXT )
     add_obsolete_bool( "advanced" ) /* since 4.0.0 */
     add_bool( "interact", true, INTERACTION_TEXT,
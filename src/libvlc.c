@@ -55,12 +55,14 @@
 
 #include <vlc_actions.h>
 #include <vlc_charset.h>
+#include <vlc_picture.h>
 #include <vlc_dialog.h>
 #include <vlc_keystore.h>
 #include <vlc_fs.h>
 #include <vlc_cpu.h>
 #include <vlc_url.h>
 #include <vlc_modules.h>
+#include <vlc_tracer.h>
 #include <vlc_media_library.h>
 #include <vlc_thumbnailer.h>
 
@@ -75,6 +77,23 @@
  *****************************************************************************/
 static void GetFilenames  ( libvlc_int_t *, unsigned, const char *const [] );
 
+/**
+ * Dumps a census of live objects and pool usage to the message log.
+ *
+ * Triggered with var_TriggerCallback( p_libvlc, "census" ), typically from
+ * a control interface, to watch for leaks on long-running instances. It
+ * only reads a few counters, so it is cheap enough to run periodically.
+ */
+static int CensusCallback( vlc_object_t *obj, const char *name,
+                           vlc_value_t oldval, vlc_value_t newval, void *data )
+{
+    vlc_objects_DumpCensus( obj );
+    vlc_frame_PoolDumpStats( obj );
+    vlc_picture_PoolDumpStats( obj );
+    VLC_UNUSED(name); VLC_UNUSED(oldval); VLC_UNUSED(newval); VLC_UNUSED(data);
+    return VLC_SUCCESS;
+}
+
 /**
  * Allocate a blank libvlc instance, also setting the exit handler.
  * Vlc's threading system must have been initialized first
@@ -91,6 +110,8 @@ libvlc_int_t * libvlc_InternalCreate( void )
 
     priv = libvlc_priv (p_libvlc);
     vlc_mutex_init(&priv->lock);
+    vlc_mutex_init(&priv->slice_pool_lock);
+    priv->slice_pool = NULL;
     priv->interfaces = NULL;
     priv->main_playlist = NULL;
     priv->p_vlm = NULL;
@@ -133,6 +154,9 @@ int libvlc_InternalInit( libvlc_int_t *p_libvlc, int i_argc,
     char        *psz_val;
     int          i_ret = VLC_EGENERIC;
 
+    /* Startup phase timing, reported once initialization completes */
+    const vlc_tick_t ts_start = vlc_tick_now();
+
     if (unlikely(vlc_LogPreinit(p_libvlc)))
         return VLC_ENOMEM;
 
@@ -160,6 +184,8 @@ int libvlc_InternalInit( libvlc_int_t *p_libvlc, int i_argc,
      */
     module_LoadPlugins (p_libvlc);
 
+    const vlc_tick_t ts_plugins = vlc_tick_now();
+
     /*
      * Fully process command line settings.
      * Results are stored as runtime state within `p_libvlc` object variables.
@@ -179,6 +205,8 @@ int libvlc_InternalInit( libvlc_int_t *p_libvlc, int i_argc,
             config_LoadConfigFile( p_libvlc );
     }
 
+    const vlc_tick_t ts_config = vlc_tick_now();
+
     vlc_LogInit(p_libvlc);
     vlc_tracer_Init(p_libvlc);
 
@@ -246,6 +274,10 @@ int libvlc_InternalInit( libvlc_int_t *p_libvlc, int i_argc,
     var_Create( p_libvlc, "window", VLC_VAR_STRING );
     var_Create( p_libvlc, "vout-cb-type", VLC_VAR_INTEGER );
 
+    /* on-demand live object and pool census, see CensusCallback() */
+    var_Create( p_libvlc, "census", VLC_VAR_VOID );
+    var_AddCallback( p_libvlc, "census", CensusCallback, NULL );
+
     /* NOTE: Because the playlist and interfaces start before this function
      * returns control to the application (DESIGN BUG!), all these variables
      * must be created (in place of libvlc_new()) and set to VLC defaults
@@ -278,12 +310,16 @@ int libvlc_InternalInit( libvlc_int_t *p_libvlc, int i_argc,
     }
 #endif
 
+    const vlc_tick_t ts_core = vlc_tick_now();
+
     /*
      * Load background interfaces
      */
     libvlc_AddInterfaces(p_libvlc, "extraintf");
     libvlc_AddInterfaces(p_libvlc, "control");
 
+    const vlc_tick_t ts_intf = vlc_tick_now();
+
 #ifdef __APPLE__
     var_Create( p_libvlc, "drawable-view-top", VLC_VAR_INTEGER );
     var_Create( p_libvlc, "drawable-view-left", VLC_VAR_INTEGER );
@@ -327,6 +363,26 @@ int libvlc_InternalInit( libvlc_int_t *p_libvlc, int i_argc,
     /* Create a variable for showing the main interface */
     var_Create(p_libvlc, "intf-show", VLC_VAR_VOID);
 
+    /* Report how the startup time breaks down across phases, so that a
+     * slow cold start can be attributed without patching in printf()s. */
+    const vlc_tick_t ts_end = vlc_tick_now();
+    struct vlc_tracer *tracer = vlc_object_get_tracer( VLC_OBJECT(p_libvlc) );
+    if( tracer != NULL )
+        vlc_tracer_Trace( tracer, VLC_TRACE("type", "INIT"),
+                          VLC_TRACE("plugins", ts_plugins - ts_start),
+                          VLC_TRACE("config", ts_config - ts_plugins),
+                          VLC_TRACE("core", ts_core - ts_config),
+                          VLC_TRACE("interfaces", ts_intf - ts_core),
+                          VLC_TRACE("total", ts_end - ts_start),
+                          VLC_TRACE_END );
+    msg_Dbg( p_libvlc, "startup: %"PRId64" ms (plugins: %"PRId64" ms, "
+             "config: %"PRId64" ms, core: %"PRId64" ms, "
+             "interfaces: %"PRId64" ms)", MS_FROM_VLC_TICK(ts_end - ts_start),
+             MS_FROM_VLC_TICK(ts_plugins - ts_start),
+             MS_FROM_VLC_TICK(ts_config - ts_plugins),
+             MS_FROM_VLC_TICK(ts_core - ts_config),
+             MS_FROM_VLC_TICK(ts_intf - ts_core) );
+
     return VLC_SUCCESS;
 
 error:
@@ -384,9 +440,17 @@ void libvlc_InternalCleanup( libvlc_int_t *p_libvlc )
     if ( priv->p_media_library )
         libvlc_MlRelease( priv->p_media_library );
 
+    /* All filters are gone along with the players using them */
+    if( priv->slice_pool != NULL )
+        vlc_plane_copier_Delete( priv->slice_pool );
+
     if( priv->media_source_provider )
         vlc_media_source_provider_Delete( priv->media_source_provider );
 
+    var_DelCallback( p_libvlc, "census", CensusCallback, NULL );
+
+    vlc_frame_PoolDumpStats( VLC_OBJECT(p_libvlc) );
+
     libvlc_InternalActionsClean( p_libvlc );
 
     /* Save the configuration */
@@ -40,12 +40,46 @@ void system_End(void);
 #endif
 void vlc_CPU_dump(vlc_object_t *);
 
+/* Frame pool statistics (src/misc/frame.c) */
+void vlc_frame_PoolDumpStats(vlc_object_t *);
+
+/* Picture pool statistics (src/misc/picture_pool.c) */
+void vlc_picture_PoolDumpStats(vlc_object_t *);
+
+/* Live object census (src/misc/objects.c) */
+void vlc_objects_DumpCensus(vlc_object_t *);
+
 /*
  * Threads subsystem
  */
 
 void vlc_threads_setup (libvlc_int_t *);
 
+/**
+ * Restricts the calling thread to the CPUs of a NUMA node.
+ *
+ * Threads spawned afterwards inherit the affinity mask, and first-touch
+ * placement then keeps their allocations on the same node.
+ *
+ * \return VLC_SUCCESS on success, an error if the node does not exist or
+ * the platform does not support CPU affinity.
+ */
+int vlc_threads_SetNumaNode(unsigned node);
+
+/**
+ * Caches the per-class thread placement configuration
+ * (--decode-affinity, --render-rt-priority, ...).
+ *
+ * Must be called before the pipeline threads are created.
+ */
+void vlc_threads_ReadClassConfig(libvlc_int_t *);
+
+/**
+ * Applies the configured affinity mask and real-time priority of the thread
+ * class matching \p name, if any, to the calling thread.
+ */
+void vlc_threads_ApplyClass(const char *name);
+
 void vlc_trace (const char *fn, const char *file, unsigned line);
 #define vlc_backtrace() vlc_trace(__func__, __FILE__, __LINE__)
 
@@ -193,6 +227,9 @@ typedef struct libvlc_priv_t
     struct vlc_thumbnailer_t *p_thumbnailer; ///< Lazily instantiated media thumbnailer
     struct vlc_tracer *tracer; ///< Tracer callbacks
 
+    vlc_mutex_t slice_pool_lock; ///< protect slice_pool creation and use
+    struct vlc_plane_copier *slice_pool; ///< Lazily created filter worker pool
+
     /* Exit callback */
     vlc_exit_t       exit;
 } libvlc_priv_t;
@@ -28,6 +28,7 @@
 #include <vlc_common.h>
 #include <vlc_arrays.h>
 #include <vlc_atomic.h>
+#include <vlc_diffutil.h>
 #include <vlc_input_item.h>
 #include <vlc_threads.h>
 #include "libvlc.h"
@@ -46,6 +47,11 @@ typedef struct
     struct vlc_list listeners; /**< list of vlc_media_tree_listener_id.node */
     vlc_mutex_t lock;
     vlc_atomic_rc_t rc;
+
+    /* media whose subtree is currently arriving in chunks (see pf_readdir),
+     * so that only the first chunk resets the children */
+    input_item_t **pp_pending_subtrees;
+    int i_pending_subtrees;
 } media_tree_private_t;
 
 #define mt_priv(mt) container_of(mt, media_tree_private_t, public_data)
@@ -60,6 +66,7 @@ vlc_media_tree_New(void)
     vlc_mutex_init(&priv->lock);
     vlc_atomic_rc_init(&priv->rc);
     vlc_list_init(&priv->listeners);
+    TAB_INIT(priv->i_pending_subtrees, priv->pp_pending_subtrees);
 
     vlc_media_tree_t *tree = &priv->public_data;
     input_item_node_t *root = &tree->root;
@@ -145,11 +152,145 @@ vlc_media_tree_ClearChildren(input_item_node_t *root)
     root->i_children = 0;
 }
 
+static bool
+media_subtree_is_pending(media_tree_private_t *priv, const input_item_t *media)
+{
+    for (int i = 0; i < priv->i_pending_subtrees; ++i)
+        if (priv->pp_pending_subtrees[i] == media)
+            return true;
+    return false;
+}
+
+static void
+media_subtree_remove_pending(media_tree_private_t *priv, input_item_t *media)
+{
+    if (media_subtree_is_pending(priv, media))
+    {
+        TAB_REMOVE(priv->i_pending_subtrees, priv->pp_pending_subtrees, media);
+        input_item_Release(media);
+    }
+}
+
+static uint32_t
+media_tree_diff_GetSize(const void *list)
+{
+    return ((const input_item_node_t *)list)->i_children;
+}
+
+static bool
+media_tree_diff_IsSame(const void *list_old, uint32_t index_old,
+                       const void *list_new, uint32_t index_new)
+{
+    input_item_t *old = ((const input_item_node_t *)list_old)
+                            ->pp_children[index_old]->p_item;
+    input_item_t *new = ((const input_item_node_t *)list_new)
+                            ->pp_children[index_new]->p_item;
+    if (old == new)
+        return true;
+    /* A refresh discovers new input items for the same medias: match them by
+     * URI (immutable for discovered medias) to keep the existing nodes */
+    return old->psz_uri && new->psz_uri && !strcmp(old->psz_uri, new->psz_uri);
+}
+
+/**
+ * Replace the children of a node, notifying minimal deltas.
+ *
+ * Compute the diff between the current children of subtree_root and the ones
+ * of the incoming node, then notify only the insertions and removals, so that
+ * listeners displaying a large (e.g. UPnP) directory redraw O(changes) items
+ * on a refresh instead of the whole list.
+ */
+static void
+vlc_media_tree_RefreshSubtree(vlc_media_tree_t *tree,
+                              input_item_node_t *subtree_root,
+                              input_item_node_t *incoming)
+{
+    vlc_media_tree_AssertLocked(tree);
+
+    static const vlc_diffutil_callback_t diffop = {
+        .getOldSize = media_tree_diff_GetSize,
+        .getNewSize = media_tree_diff_GetSize,
+        .isSame = media_tree_diff_IsSame,
+    };
+
+    diffutil_snake_t *snake =
+        vlc_diffutil_build_snake(&diffop, subtree_root, incoming);
+    vlc_diffutil_changelist_t *changes = snake == NULL ? NULL :
+        vlc_diffutil_build_change_list(snake, &diffop, subtree_root, incoming,
+                                       VLC_DIFFUTIL_RESULT_AGGREGATE);
+    if (unlikely(changes == NULL))
+    {
+        /* Fall back to a full reset on allocation failure */
+        vlc_diffutil_free_snake(snake);
+        vlc_media_tree_ClearChildren(subtree_root);
+        vlc_media_tree_AddSubtree(subtree_root, incoming);
+        vlc_media_tree_Notify(tree, on_children_reset, subtree_root);
+        return;
+    }
+
+    for (size_t i = 0; i < changes->size; ++i)
+    {
+        const vlc_diffutil_change_t *change = &changes->data[i];
+        switch (change->type)
+        {
+            case VLC_DIFFUTIL_OP_INSERT:
+            {
+                uint32_t index = change->op.insert.index;
+                uint32_t added = 0;
+                for (uint32_t j = 0; j < change->count; ++j)
+                {
+                    input_item_node_t *from =
+                        incoming->pp_children[change->op.insert.y + j];
+                    input_item_node_t *child =
+                        input_item_node_Create(from->p_item);
+                    if (unlikely(!child))
+                        continue;
+                    vlc_media_tree_AddSubtree(child, from);
+                    TAB_INSERT(subtree_root->i_children,
+                               subtree_root->pp_children, child,
+                               (int)(index + added));
+                    added++;
+                }
+                if (added > 0)
+                    vlc_media_tree_Notify(tree, on_children_added,
+                                          subtree_root,
+                                          &subtree_root->pp_children[index],
+                                          added);
+                break;
+            }
+            case VLC_DIFFUTIL_OP_REMOVE:
+            {
+                uint32_t index = change->op.remove.index;
+                assert(index + change->count
+                        <= (uint32_t)subtree_root->i_children);
+                vlc_media_tree_Notify(tree, on_children_removed, subtree_root,
+                                      &subtree_root->pp_children[index],
+                                      change->count);
+                for (uint32_t j = 0; j < change->count; ++j)
+                {
+                    input_item_node_t *child =
+                        subtree_root->pp_children[index];
+                    TAB_ERASE(subtree_root->i_children,
+                              subtree_root->pp_children, (int)index);
+                    input_item_node_Delete(child);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    vlc_diffutil_free_change_list(changes);
+    vlc_diffutil_free_snake(snake);
+}
+
 static void
 media_subtree_changed(input_item_t *media, input_item_node_t *node,
                       void *userdata)
 {
     vlc_media_tree_t *tree = userdata;
+    media_tree_private_t *priv = mt_priv(tree);
 
     vlc_media_tree_Lock(tree);
     input_item_node_t *subtree_root;
@@ -162,9 +303,35 @@ media_subtree_changed(input_item_t *media, input_item_node_t *node,
         return;
     }
 
-    vlc_media_tree_ClearChildren(subtree_root);
+    /* the subtree may arrive in several chunks: only the first one replaces
+     * the previous children, the following ones are appended */
+    if (!media_subtree_is_pending(priv, media))
+    {
+        input_item_Hold(media);
+        TAB_APPEND(priv->i_pending_subtrees, priv->pp_pending_subtrees, media);
+
+        if (subtree_root->i_children > 0)
+        {
+            /* refresh of an already populated node: notify minimal deltas
+             * instead of resetting everything */
+            vlc_media_tree_RefreshSubtree(tree, subtree_root, node);
+            vlc_media_tree_Unlock(tree);
+            return;
+        }
+
+        vlc_media_tree_AddSubtree(subtree_root, node);
+        vlc_media_tree_Notify(tree, on_children_reset, subtree_root);
+        vlc_media_tree_Unlock(tree);
+        return;
+    }
+
+    /* subsequent chunk: the new children are appended, notify only them */
+    int first = subtree_root->i_children;
     vlc_media_tree_AddSubtree(subtree_root, node);
-    vlc_media_tree_Notify(tree, on_children_reset, subtree_root);
+    if (subtree_root->i_children > first)
+        vlc_media_tree_Notify(tree, on_children_added, subtree_root,
+                              &subtree_root->pp_children[first],
+                              (size_t)(subtree_root->i_children - first));
     vlc_media_tree_Unlock(tree);
 }
 
@@ -174,8 +341,13 @@ media_subtree_preparse_ended(input_item_t *media,
                              void *user_data)
 {
     vlc_media_tree_t *tree = user_data;
+    media_tree_private_t *priv = mt_priv(tree);
 
     vlc_media_tree_Lock(tree);
+
+    /* the subtree of this media, if any, is complete */
+    media_subtree_remove_pending(priv, media);
+
     input_item_node_t *subtree_root;
     /* TODO retrieve the node without traversing the tree */
     bool found = vlc_media_tree_FindNodeByMedia(&tree->root, media,
@@ -203,6 +375,10 @@ vlc_media_tree_Delete(vlc_media_tree_t *tree)
     vlc_list_foreach(listener, &priv->listeners, node)
         free(listener);
     vlc_list_init(&priv->listeners); /* reset */
+    while (priv->i_pending_subtrees)
+        input_item_Release(
+                priv->pp_pending_subtrees[--priv->i_pending_subtrees]);
+    TAB_CLEAN(priv->i_pending_subtrees, priv->pp_pending_subtrees);
     vlc_media_tree_DestroyRootNode(tree);
     free(tree);
 }
@@ -54,6 +54,24 @@ vlc_ancillary_CreateWithFreeCb(void *data,
     return ancillary;
 }
 
+struct vlc_ancillary *
+vlc_ancillary_CreateWithSize(vlc_ancillary_id id, size_t size)
+{
+    assert(size > 0);
+
+    struct vlc_ancillary *ancillary = malloc(sizeof(*ancillary) + size);
+
+    if (ancillary == NULL)
+        return NULL;
+
+    vlc_atomic_rc_init(&ancillary->rc);
+    ancillary->id = id;
+    ancillary->data = ancillary + 1;
+    ancillary->free_cb = NULL; /* freed along with the ancillary */
+
+    return ancillary;
+}
+
 void
 vlc_ancillary_Release(struct vlc_ancillary *ancillary)
 {
@@ -0,0 +1,157 @@
+/*****************************************************************************
+ * misc/chan.c: bounded inter-thread channels
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <errno.h>
+#include <stdlib.h>
+
+#include <vlc_common.h>
+#include <vlc_chan.h>
+#include <vlc_interrupt.h>
+#include <vlc_threads.h>
+
+/*
+ * The blocking logic is carried by two semaphores so that both directions
+ * benefit from vlc_sem_wait_i11e(): "slots" counts the free capacity and is
+ * waited on by the sender, "entries" counts the queued entries and is waited
+ * on by the receiver. Closing posts one extra token on each semaphore; a
+ * waiter waking up on that token re-posts it before bailing out, so the
+ * wake-up cascades to any other waiter.
+ */
+struct vlc_chan
+{
+    vlc_sem_t slots;
+    vlc_sem_t entries;
+
+    vlc_mutex_t lock;
+    /** Ring buffer of queued entries, protected by lock */
+    void **ring;
+    size_t capacity;
+    /** Index of the oldest entry */
+    size_t head;
+    /** Number of queued entries */
+    size_t count;
+    bool closed;
+};
+
+vlc_chan_t *vlc_chan_New(size_t capacity)
+{
+    assert(capacity > 0);
+
+    vlc_chan_t *chan = malloc(sizeof (*chan));
+    if (unlikely(chan == NULL))
+        return NULL;
+
+    chan->ring = vlc_alloc(capacity, sizeof (void *));
+    if (unlikely(chan->ring == NULL))
+    {
+        free(chan);
+        return NULL;
+    }
+
+    vlc_sem_init(&chan->slots, capacity);
+    vlc_sem_init(&chan->entries, 0);
+    vlc_mutex_init(&chan->lock);
+    chan->capacity = capacity;
+    chan->head = 0;
+    chan->count = 0;
+    chan->closed = false;
+
+    return chan;
+}
+
+void vlc_chan_Delete(vlc_chan_t *chan)
+{
+    free(chan->ring);
+    free(chan);
+}
+
+int vlc_chan_Send(vlc_chan_t *chan, void *entry)
+{
+    assert(entry != NULL);
+
+    int ret = vlc_sem_wait_i11e(&chan->slots);
+    if (ret != 0)
+        return ret;
+
+    vlc_mutex_lock(&chan->lock);
+    if (chan->closed)
+    {
+        vlc_mutex_unlock(&chan->lock);
+        /* Pass the close token on to the next pending sender */
+        vlc_sem_post(&chan->slots);
+        return EPIPE;
+    }
+
+    chan->ring[(chan->head + chan->count) % chan->capacity] = entry;
+    chan->count++;
+    vlc_mutex_unlock(&chan->lock);
+
+    vlc_sem_post(&chan->entries);
+    return 0;
+}
+
+int vlc_chan_Recv(vlc_chan_t *chan, void **entry)
+{
+    int ret = vlc_sem_wait_i11e(&chan->entries);
+    if (ret != 0)
+    {
+        *entry = NULL;
+        return ret;
+    }
+
+    vlc_mutex_lock(&chan->lock);
+    if (chan->count == 0)
+    {
+        /* Woken up by the close token with the channel drained */
+        assert(chan->closed);
+        vlc_mutex_unlock(&chan->lock);
+        /* Pass the close token on to the next pending receiver */
+        vlc_sem_post(&chan->entries);
+        *entry = NULL;
+        return EPIPE;
+    }
+
+    *entry = chan->ring[chan->head];
+    chan->head = (chan->head + 1) % chan->capacity;
+    chan->count--;
+    vlc_mutex_unlock(&chan->lock);
+
+    vlc_sem_post(&chan->slots);
+    return 0;
+}
+
+void vlc_chan_Close(vlc_chan_t *chan)
+{
+    vlc_mutex_lock(&chan->lock);
+    bool was_closed = chan->closed;
+    chan->closed = true;
+    vlc_mutex_unlock(&chan->lock);
+
+    if (!was_closed)
+    {
+        vlc_sem_post(&chan->slots);
+        vlc_sem_post(&chan->entries);
+    }
+}
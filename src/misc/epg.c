@@ -201,21 +201,53 @@ void vlc_epg_Delete( vlc_epg_t *p_epg )
     free( p_epg );
 }
 
+/* Bisects the events (sorted by start time, see vlc_epg_AddEvent) for the
+ * last event starting at or before i_time.
+ * Returns -1 when all the events start after i_time. */
+static ssize_t vlc_epg_FindLastStartedIndex( const vlc_epg_t *p_epg,
+                                             int64_t i_time )
+{
+    if( p_epg->i_event == 0 || p_epg->pp_event[0]->i_start > i_time )
+        return -1;
+
+    size_t i_lower = 0;
+    size_t i_upper = p_epg->i_event - 1;
+
+    while( i_lower < i_upper )
+    {
+        size_t i_split = ( i_lower + i_upper + 1 ) / 2;
+
+        if( p_epg->pp_event[i_split]->i_start <= i_time )
+            i_lower = i_split;
+        else
+            i_upper = i_split - 1;
+    }
+    return i_lower;
+}
+
 void vlc_epg_SetCurrent( vlc_epg_t *p_epg, int64_t i_start )
 {
-    size_t i;
     p_epg->p_current = NULL;
     if( i_start < 0 )
         return;
 
-    for( i = 0; i < p_epg->i_event; i++ )
-    {
-        if( p_epg->pp_event[i]->i_start == i_start )
-        {
-            p_epg->p_current = p_epg->pp_event[i];
-            break;
-        }
-    }
+    ssize_t i_pos = vlc_epg_FindLastStartedIndex( p_epg, i_start );
+    if( i_pos >= 0 && p_epg->pp_event[i_pos]->i_start == i_start )
+        p_epg->p_current = p_epg->pp_event[i_pos];
+}
+
+const vlc_epg_event_t * vlc_epg_GetEvent( const vlc_epg_t *p_epg,
+                                          int64_t i_time )
+{
+    ssize_t i_pos = vlc_epg_FindLastStartedIndex( p_epg, i_time );
+    if( i_pos < 0 )
+        return NULL;
+
+    const vlc_epg_event_t *p_evt = p_epg->pp_event[i_pos];
+    /* There can be a gap between two consecutive events */
+    if( i_time >= p_evt->i_start + (int64_t) p_evt->i_duration )
+        return NULL;
+    return p_evt;
 }
 
 vlc_epg_t * vlc_epg_Duplicate( const vlc_epg_t *p_src )
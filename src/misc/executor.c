@@ -70,6 +70,9 @@ struct vlc_executor {
     /** Wait for the executor to be idle (i.e. unfinished == 0) */
     vlc_cond_t idle_wait;
 
+    /** Queue of vlc_runnable, drained before the normal queue */
+    struct vlc_list queue_urgent;
+
     /** Queue of vlc_runnable */
     struct vlc_list queue;
 
@@ -81,11 +84,15 @@ struct vlc_executor {
 };
 
 static void
-QueuePush(vlc_executor_t *executor, struct vlc_runnable *runnable)
+QueuePush(vlc_executor_t *executor, struct vlc_runnable *runnable,
+          enum vlc_executor_priority priority)
 {
     vlc_mutex_assert(&executor->lock);
 
-    vlc_list_append(&runnable->node, &executor->queue);
+    if (priority == VLC_EXECUTOR_PRIORITY_URGENT)
+        vlc_list_append(&runnable->node, &executor->queue_urgent);
+    else
+        vlc_list_append(&runnable->node, &executor->queue);
     vlc_cond_signal(&executor->queue_wait);
 }
 
@@ -94,15 +101,19 @@ QueueTake(vlc_executor_t *executor)
 {
     vlc_mutex_assert(&executor->lock);
 
-    while (!executor->closing && vlc_list_is_empty(&executor->queue))
+    while (!executor->closing && vlc_list_is_empty(&executor->queue_urgent)
+                              && vlc_list_is_empty(&executor->queue))
         vlc_cond_wait(&executor->queue_wait, &executor->lock);
 
     if (executor->closing)
         return NULL;
 
     struct vlc_runnable *runnable =
-        vlc_list_first_entry_or_null(&executor->queue, struct vlc_runnable,
-                                     node);
+        vlc_list_first_entry_or_null(&executor->queue_urgent,
+                                     struct vlc_runnable, node);
+    if (!runnable)
+        runnable = vlc_list_first_entry_or_null(&executor->queue,
+                                                struct vlc_runnable, node);
     assert(runnable);
     vlc_list_remove(&runnable->node);
 
@@ -188,6 +199,7 @@ vlc_executor_New(unsigned max_threads)
     executor->unfinished = 0;
 
     vlc_list_init(&executor->threads);
+    vlc_list_init(&executor->queue_urgent);
     vlc_list_init(&executor->queue);
 
     vlc_cond_init(&executor->idle_wait);
@@ -207,13 +219,15 @@ vlc_executor_New(unsigned max_threads)
 }
 
 void
-vlc_executor_Submit(vlc_executor_t *executor, struct vlc_runnable *runnable)
+vlc_executor_SubmitWithPriority(vlc_executor_t *executor,
+                                struct vlc_runnable *runnable,
+                                enum vlc_executor_priority priority)
 {
     vlc_mutex_lock(&executor->lock);
 
     assert(!executor->closing);
 
-    QueuePush(executor, runnable);
+    QueuePush(executor, runnable, priority);
 
     if (++executor->unfinished > executor->nthreads
             && executor->nthreads < executor->max_threads)
@@ -223,6 +237,13 @@ vlc_executor_Submit(vlc_executor_t *executor, struct vlc_runnable *runnable)
     vlc_mutex_unlock(&executor->lock);
 }
 
+void
+vlc_executor_Submit(vlc_executor_t *executor, struct vlc_runnable *runnable)
+{
+    vlc_executor_SubmitWithPriority(executor, runnable,
+                                    VLC_EXECUTOR_PRIORITY_NORMAL);
+}
+
 bool
 vlc_executor_Cancel(vlc_executor_t *executor, struct vlc_runnable *runnable)
 {
@@ -264,6 +285,7 @@ vlc_executor_Delete(vlc_executor_t *executor)
     executor->closing = true;
 
     /* All the tasks must be canceled on delete */
+    assert(vlc_list_is_empty(&executor->queue_urgent));
     assert(vlc_list_is_empty(&executor->queue));
 
     vlc_mutex_unlock(&executor->lock);
@@ -283,6 +305,7 @@ vlc_executor_Delete(vlc_executor_t *executor)
     }
 
     /* The queue must still be empty (no runnable submitted a new runnable) */
+    assert(vlc_list_is_empty(&executor->queue_urgent));
     assert(vlc_list_is_empty(&executor->queue));
 
     /* There are no tasks anymore */
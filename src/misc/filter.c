@@ -181,6 +181,31 @@ void filter_DeleteBlend( vlc_blender_t *p_blend )
     vlc_object_delete(p_blend);
 }
 
+void filter_RunSlices( filter_t *p_filter,
+                       void (*work)( void *, unsigned, unsigned ),
+                       void *opaque )
+{
+    libvlc_priv_t *priv = libvlc_priv( vlc_object_instance( p_filter ) );
+
+    /* The pool runs one job at a time: concurrent filter chains take
+     * turns. Slice jobs are short and memory bound, so letting them
+     * compete for the bus would not be any faster. */
+    vlc_mutex_lock( &priv->slice_pool_lock );
+    if( priv->slice_pool == NULL )
+        priv->slice_pool = vlc_plane_copier_New( 0 );
+
+    if( priv->slice_pool != NULL )
+    {
+        vlc_plane_copier_Run( priv->slice_pool, work, opaque );
+        vlc_mutex_unlock( &priv->slice_pool_lock );
+    }
+    else
+    {
+        vlc_mutex_unlock( &priv->slice_pool_lock );
+        work( opaque, 0, 1 );
+    }
+}
+
 /* */
 #include <vlc_video_splitter.h>
 
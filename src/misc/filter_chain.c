@@ -29,9 +29,12 @@
 #include <vlc_modules.h>
 #include <vlc_mouse.h>
 #include <vlc_spu.h>
+#include <vlc_tracer.h>
 #include <libvlc.h>
 #include <assert.h>
 
+#include "latency.h"
+
 typedef struct chained_filter_t
 {
     /* Public part of the filter structure */
@@ -203,6 +206,57 @@ void filter_chain_Reset( filter_chain_t *p_chain,
     es_format_Copy( &p_chain->fmt_out, p_fmt_out );
 }
 
+/**
+ * Checks whether two video formats share the same memory layout, ignoring
+ * fields (aspect ratio, frame rate) that filters can absorb in place.
+ */
+static bool FormatLayoutEquals( const video_format_t *p_a,
+                                const video_format_t *p_b )
+{
+    video_format_t a = *p_a;
+
+    a.i_sar_num = p_b->i_sar_num;
+    a.i_sar_den = p_b->i_sar_den;
+    return video_format_IsSimilar( &a, p_b );
+}
+
+/** Copies the benign (non-layout) fields of a video format. */
+static void FormatCopyBenign( video_format_t *p_dst,
+                              const video_format_t *p_src )
+{
+    p_dst->i_sar_num = p_src->i_sar_num;
+    p_dst->i_sar_den = p_src->i_sar_den;
+    p_dst->i_frame_rate = p_src->i_frame_rate;
+    p_dst->i_frame_rate_base = p_src->i_frame_rate_base;
+}
+
+bool filter_chain_UpdateSourceFormat( filter_chain_t *p_chain,
+                                      const es_format_t *p_fmt_in,
+                                      vlc_video_context *vctx_in )
+{
+    if( p_fmt_in->i_cat != VIDEO_ES || p_chain->fmt_in.i_cat != VIDEO_ES )
+        return false;
+    if( vctx_in != p_chain->vctx_in )
+        return false;
+    if( !FormatLayoutEquals( &p_fmt_in->video, &p_chain->fmt_in.video ) )
+        return false;
+
+    /* The layout is unchanged: patch the benign fields through the chain
+     * instead of tearing it down. Loaded filters keep their state (and the
+     * deinterlacer its history), so no frame is lost on e.g. a SAR update
+     * from a repeated H.264 SPS. */
+    es_format_Clean( &p_chain->fmt_in );
+    es_format_Copy( &p_chain->fmt_in, p_fmt_in );
+
+    for( chained_filter_t *f = p_chain->first; f != NULL; f = f->next )
+    {
+        FormatCopyBenign( &f->filter.fmt_in.video, &p_fmt_in->video );
+        FormatCopyBenign( &f->filter.fmt_out.video, &p_fmt_in->video );
+    }
+    FormatCopyBenign( &p_chain->fmt_out.video, &p_fmt_in->video );
+    return true;
+}
+
 static filter_t *filter_chain_AppendInner( filter_chain_t *chain,
     const char *name, const char *capability, const config_chain_t *cfg,
     const es_format_t *fmt_out )
@@ -279,6 +333,18 @@ static filter_t *filter_chain_AppendInner( filter_chain_t *chain,
     msg_Dbg( chain->obj, "Filter '%s' (%p) appended to chain",
              (name != NULL) ? name : module_GetShortName(filter->p_module),
              (void *)filter );
+
+    if( fmt_in->i_cat == VIDEO_ES
+     && vctx_in != NULL && filter->vctx_out == NULL )
+    {
+        unsigned copies = filter_chain_GetVideoCopyCount( chain );
+        if( copies > 1 )
+            msg_Warn( chain->obj, "filter '%s' downloads opaque pictures to "
+                      "CPU memory (%u copies per frame in the chain)",
+                      (name != NULL) ? name
+                                     : module_GetShortName(filter->p_module),
+                      copies );
+    }
     return filter;
 
 error:
@@ -422,12 +488,57 @@ vlc_video_context *filter_chain_GetVideoCtxOut(const filter_chain_t *p_chain)
     return p_chain->vctx_in;
 }
 
+unsigned filter_chain_GetVideoCopyCount( const filter_chain_t *p_chain )
+{
+    vlc_video_context *vctx = p_chain->vctx_in;
+    unsigned copies = 0;
+
+    for( chained_filter_t *f = p_chain->first; f != NULL; f = f->next )
+    {
+        /* A filter with an opaque input but no output video context has to
+         * download every surface to CPU memory. */
+        if( vctx != NULL && f->filter.vctx_out == NULL )
+            copies++;
+        vctx = f->filter.vctx_out;
+    }
+    return copies;
+}
+
+static picture_t *FilterVideo( filter_t *p_filter, picture_t *p_pic )
+{
+    struct vlc_tracer *tracer = vlc_object_get_tracer( &p_filter->obj );
+    if( tracer == NULL )
+        return p_filter->ops->filter_video( p_filter, p_pic );
+
+    vlc_tick_t start = vlc_tick_now();
+    p_pic = p_filter->ops->filter_video( p_filter, p_pic );
+    vlc_tracer_Trace( tracer, VLC_TRACE("type", "FILTER"),
+                      VLC_TRACE("id", p_filter->psz_name != NULL
+                                ? p_filter->psz_name
+                                : module_GetShortName(p_filter->p_module)),
+                      VLC_TRACE("filter_time", vlc_tick_now() - start),
+                      VLC_TRACE_END );
+    return p_pic;
+}
+
+/* Stamp the filter chain output date on the latency tag, if any */
+static void FilterChainStampLatency( picture_t *p_pic )
+{
+    struct vlc_ancillary *ancillary =
+        picture_GetAncillary( p_pic, VLC_ANCILLARY_ID_LATENCY );
+    if( ancillary != NULL )
+    {
+        struct vlc_latency_tag *tag = vlc_ancillary_GetData( ancillary );
+        tag->filter = vlc_tick_now();
+    }
+}
+
 static picture_t *FilterChainVideoFilter( chained_filter_t *f, picture_t *p_pic )
 {
     for( ; f != NULL; f = f->next )
     {
         filter_t *p_filter = &f->filter;
-        p_pic = p_filter->ops->filter_video( p_filter, p_pic );
+        p_pic = FilterVideo( p_filter, p_pic );
         if( !p_pic )
             break;
         if( !vlc_picture_chain_IsEmpty( &f->pending ) )
@@ -446,7 +557,10 @@ picture_t *filter_chain_VideoFilter( filter_chain_t *p_chain, picture_t *p_pic )
     {
         p_pic = FilterChainVideoFilter( p_chain->first, p_pic );
         if( p_pic )
+        {
+            FilterChainStampLatency( p_pic );
             return p_pic;
+        }
     }
     for( chained_filter_t *b = p_chain->last; b != NULL; b = b->prev )
     {
@@ -456,7 +570,10 @@ picture_t *filter_chain_VideoFilter( filter_chain_t *p_chain, picture_t *p_pic )
 
         p_pic = FilterChainVideoFilter( b->next, p_pic );
         if( p_pic )
+        {
+            FilterChainStampLatency( p_pic );
             return p_pic;
+        }
     }
     return NULL;
 }
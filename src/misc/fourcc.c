@@ -35,24 +35,48 @@
 
 #include "fourcc_tables.h"
 
-static int fourcc_cmp(const void *key, const void *ent)
+static uint32_t fourcc_hash(const void *key)
 {
-    return memcmp(key, ent, 4);
+    /* Endian-independent: combines the four bytes in memory order, so that
+     * it matches the index generated by fourcc_gen.c on the build host */
+    const unsigned char *b = key;
+    uint32_t x = (uint32_t)b[0] | ((uint32_t)b[1] << 8)
+               | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+    return x * 2654435761U; /* Knuth multiplicative hash */
+}
+
+static const void *LookupIndex(const void *key, const void *entv,
+                               size_t entsize, const uint16_t *slots,
+                               uint32_t mask)
+{
+    /* Linear probing; 0xffff marks an empty slot (see fourcc_gen.c) */
+    for (uint32_t h = fourcc_hash(key) & mask;; h = (h + 1) & mask)
+    {
+        uint16_t i = slots[h];
+        if (i == 0xffff)
+            return NULL;
+
+        const void *ent = (const char *)entv + (i * entsize);
+        if (memcmp(key, ent, 4) == 0)
+            return ent;
+    }
 }
 
 static vlc_fourcc_t Lookup(vlc_fourcc_t fourcc, const char **restrict dsc,
-                           const struct fourcc_mapping *mapv, size_t mapc,
-                           const struct fourcc_desc *dscv, size_t dscc)
+                           const struct fourcc_mapping *mapv,
+                           const uint16_t *mapidx, uint32_t mapmask,
+                           const struct fourcc_desc *dscv,
+                           const uint16_t *dscidx, uint32_t dscmask)
 {
     const struct fourcc_mapping *mapping;
     const struct fourcc_desc *desc;
 
-    mapping = bsearch(&fourcc, mapv, mapc, sizeof (*mapv), fourcc_cmp);
+    mapping = LookupIndex(&fourcc, mapv, sizeof (*mapv), mapidx, mapmask);
     if (mapping != NULL)
     {
         if (dsc != NULL)
         {
-            desc = bsearch(&fourcc, dscv, dscc, sizeof (*dscv), fourcc_cmp);
+            desc = LookupIndex(&fourcc, dscv, sizeof (*dscv), dscidx, dscmask);
             if (desc != NULL)
             {
                 *dsc = desc->desc;
@@ -62,7 +86,7 @@ static vlc_fourcc_t Lookup(vlc_fourcc_t fourcc, const char **restrict dsc,
         fourcc = mapping->fourcc;
     }
 
-    desc = bsearch(&fourcc, dscv, dscc, sizeof (*dscv), fourcc_cmp);
+    desc = LookupIndex(&fourcc, dscv, sizeof (*dscv), dscidx, dscmask);
     if (desc == NULL)
         return 0; /* Unknown FourCC */
     if (dsc != NULL)
@@ -72,20 +96,26 @@ static vlc_fourcc_t Lookup(vlc_fourcc_t fourcc, const char **restrict dsc,
 
 static vlc_fourcc_t LookupVideo(vlc_fourcc_t fourcc, const char **restrict dsc)
 {
-    return Lookup(fourcc, dsc, mapping_video, ARRAY_SIZE(mapping_video),
-                  desc_video, ARRAY_SIZE(desc_video));
+    return Lookup(fourcc, dsc, mapping_video, mapping_video_index,
+                  ARRAY_SIZE(mapping_video_index) - 1,
+                  desc_video, desc_video_index,
+                  ARRAY_SIZE(desc_video_index) - 1);
 }
 
 static vlc_fourcc_t LookupAudio(vlc_fourcc_t fourcc, const char **restrict dsc)
 {
-    return Lookup(fourcc, dsc, mapping_audio, ARRAY_SIZE(mapping_audio),
-                  desc_audio, ARRAY_SIZE(desc_audio));
+    return Lookup(fourcc, dsc, mapping_audio, mapping_audio_index,
+                  ARRAY_SIZE(mapping_audio_index) - 1,
+                  desc_audio, desc_audio_index,
+                  ARRAY_SIZE(desc_audio_index) - 1);
 }
 
 static vlc_fourcc_t LookupSpu(vlc_fourcc_t fourcc, const char **restrict dsc)
 {
-    return Lookup(fourcc, dsc, mapping_spu, ARRAY_SIZE(mapping_spu),
-                  desc_spu, ARRAY_SIZE(desc_spu));
+    return Lookup(fourcc, dsc, mapping_spu, mapping_spu_index,
+                  ARRAY_SIZE(mapping_spu_index) - 1,
+                  desc_spu, desc_spu_index,
+                  ARRAY_SIZE(desc_spu_index) - 1);
 }
 
 static vlc_fourcc_t LookupCat(vlc_fourcc_t fourcc, const char **restrict dsc,
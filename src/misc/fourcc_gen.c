@@ -64,6 +64,53 @@ static int cmp_entry(const void *a, const void *b)
     return d;
 }
 
+/* Endian-independent: hashes the four bytes in memory order, so that the
+ * table generated on the build host matches the target (see fourcc.c) */
+static uint32_t hash_fourcc(const char *b)
+{
+    uint32_t x = (uint32_t)(unsigned char)b[0]
+               | ((uint32_t)(unsigned char)b[1] << 8)
+               | ((uint32_t)(unsigned char)b[2] << 16)
+               | ((uint32_t)(unsigned char)b[3] << 24);
+    return x * 2654435761U; /* Knuth multiplicative hash */
+}
+
+/* Emit an open-addressing (linear probing) hash index over the entries just
+ * emitted, mapping a FourCC hash to its position in the table. 0xffff marks
+ * an empty slot. The load factor stays below 50%. */
+static void emit_index(const char *kind, const char *name,
+                       const char (*aliases)[4], size_t n)
+{
+    size_t size = 4;
+    while (size < 2 * n)
+        size *= 2;
+
+    uint16_t *slots = malloc(size * sizeof (*slots));
+    if (slots == NULL)
+        abort();
+    memset(slots, 0xff, size * sizeof (*slots));
+
+    for (size_t i = 0; i < n; i++)
+    {
+        assert(i < 0xffff);
+
+        uint32_t h = hash_fourcc(aliases[i]) & (size - 1);
+        while (slots[h] != 0xffff)
+            h = (h + 1) & (size - 1);
+        slots[h] = i;
+    }
+
+    printf("static const uint16_t %s_%s_index[%zu] = {", kind, name, size);
+    for (size_t i = 0; i < size; i++)
+    {
+        if ((i % 8) == 0)
+            printf("\n   ");
+        printf(" 0x%04x,", slots[i]);
+    }
+    puts("\n};");
+    free(slots);
+}
+
 static void process_list(const char *name, const staticentry_t *list, size_t n)
 {
     struct entry *entries = malloc(sizeof (*entries) * n);
@@ -105,6 +152,11 @@ static void process_list(const char *name, const staticentry_t *list, size_t n)
     if (dups > 0)
         exit(1);
 
+    char (*aliases)[4] = malloc(sizeof (*aliases) * n);
+    if (aliases == NULL)
+        abort();
+    size_t count = 0;
+
     printf("static const struct fourcc_mapping mapping_%s[] = {\n", name);
     for (size_t i = 0; i < n; i++)
     {
@@ -115,8 +167,12 @@ static void process_list(const char *name, const staticentry_t *list, size_t n)
                entries[i].alias[0], entries[i].alias[1], entries[i].alias[2],
                entries[i].alias[3], entries[i].fourcc[0], entries[i].fourcc[1],
                entries[i].fourcc[2], entries[i].fourcc[3]);
+        memcpy(aliases[count++], entries[i].alias, 4);
     }
     puts("};");
+    emit_index("mapping", name, aliases, count);
+
+    count = 0;
     printf("static const struct fourcc_desc desc_%s[] = {\n", name);
     for (size_t i = 0; i < n; i++)
     {
@@ -125,9 +181,12 @@ static void process_list(const char *name, const staticentry_t *list, size_t n)
         printf("    { { { 0x%02hhx, 0x%02hhx, 0x%02hhx, 0x%02hhx } }, "
                "\"%s\" },\n", entries[i].alias[0], entries[i].alias[1],
                entries[i].alias[2], entries[i].alias[3], entries[i].desc);
+        memcpy(aliases[count++], entries[i].alias, 4);
     }
     puts("};");
+    emit_index("desc", name, aliases, count);
 
+    free(aliases);
     free(entries);
     fprintf(stderr, "%s: %zu entries\n", name, n);
 }
@@ -37,6 +37,7 @@
 #include <vlc_fs.h>
 
 #include "ancillary.h"
+#include "../libvlc.h" /* for vlc_frame_PoolDumpStats() */
 
 #ifndef NDEBUG
 static void vlc_frame_Check (vlc_frame_t *frame)
@@ -91,10 +92,134 @@ vlc_frame_t *vlc_frame_Init(vlc_frame_t *restrict f, const struct vlc_frame_call
     return f;
 }
 
+/*
+ * Thread-local, size-classed cache of generic frames.
+ *
+ * Demuxers allocate tens of thousands of short-lived frames per second, most
+ * of them of a handful of recurring sizes. Allocations are rounded up to a
+ * power-of-two size class and released frames are kept on a per-thread free
+ * list of their class, so that the steady-state demux loop recycles frames
+ * instead of hitting malloc(). Frames larger than the biggest class bypass
+ * the cache.
+ */
+#define VLC_FRAME_POOL_SHIFT_MIN  9 /* 512 bytes */
+#define VLC_FRAME_POOL_SHIFT_MAX 16 /* 64 KiB */
+#define VLC_FRAME_POOL_CLASSES \
+    (VLC_FRAME_POOL_SHIFT_MAX - VLC_FRAME_POOL_SHIFT_MIN + 1)
+/** Frames cached per thread and per size class */
+#define VLC_FRAME_POOL_DEPTH 16
+
+struct vlc_frame_pool
+{
+    struct
+    {
+        vlc_frame_t *frames; /**< Free list, chained through p_next */
+        size_t count;
+    } classes[VLC_FRAME_POOL_CLASSES];
+};
+
+static atomic_uintmax_t vlc_frame_pool_hits = 0;
+static atomic_uintmax_t vlc_frame_pool_misses = 0;
+
+static vlc_threadvar_t vlc_frame_pool_key;
+static int vlc_frame_pool_key_error;
+static vlc_once_t vlc_frame_pool_once = VLC_STATIC_ONCE;
+
+static void vlc_frame_pool_Destroy(void *data)
+{
+    struct vlc_frame_pool *pool = data;
+
+    for (size_t i = 0; i < VLC_FRAME_POOL_CLASSES; i++)
+        for (vlc_frame_t *f = pool->classes[i].frames, *next; f != NULL;
+             f = next)
+        {
+            next = f->p_next;
+            free (f);
+        }
+    free (pool);
+}
+
+static void vlc_frame_pool_CreateKey(void *data)
+{
+    (void) data;
+    vlc_frame_pool_key_error = vlc_threadvar_create(&vlc_frame_pool_key,
+                                                    vlc_frame_pool_Destroy);
+}
+
+static struct vlc_frame_pool *vlc_frame_pool_Get(void)
+{
+    vlc_once(&vlc_frame_pool_once, vlc_frame_pool_CreateKey, NULL);
+    if (unlikely(vlc_frame_pool_key_error != 0))
+        return NULL;
+
+    struct vlc_frame_pool *pool = vlc_threadvar_get(vlc_frame_pool_key);
+    if (unlikely(pool == NULL))
+    {
+        pool = calloc (1, sizeof (*pool));
+        if (pool != NULL && vlc_threadvar_set(vlc_frame_pool_key, pool) != 0)
+        {
+            free (pool);
+            pool = NULL;
+        }
+    }
+    return pool;
+}
+
+/** Rounds *alloc up to its size class, returns the class index or -1 */
+static int vlc_frame_pool_ClassFor(size_t *restrict alloc)
+{
+    for (int shift = VLC_FRAME_POOL_SHIFT_MIN;
+         shift <= VLC_FRAME_POOL_SHIFT_MAX; shift++)
+        if (*alloc <= ((size_t)1 << shift))
+        {
+            *alloc = (size_t)1 << shift;
+            return shift - VLC_FRAME_POOL_SHIFT_MIN;
+        }
+    return -1;
+}
+
+/** Returns the class index if alloc is exactly a class size, -1 otherwise */
+static int vlc_frame_pool_ClassMatch(size_t alloc)
+{
+    if (alloc < ((size_t)1 << VLC_FRAME_POOL_SHIFT_MIN)
+     || alloc > ((size_t)1 << VLC_FRAME_POOL_SHIFT_MAX)
+     || (alloc & (alloc - 1)) != 0)
+        return -1;
+    return ctz(alloc) - VLC_FRAME_POOL_SHIFT_MIN;
+}
+
+void vlc_frame_PoolDumpStats(vlc_object_t *obj)
+{
+    uintmax_t hits = atomic_load_explicit(&vlc_frame_pool_hits,
+                                          memory_order_relaxed);
+    uintmax_t misses = atomic_load_explicit(&vlc_frame_pool_misses,
+                                            memory_order_relaxed);
+
+    if (hits + misses > 0)
+        msg_Dbg(obj, "frame pool: %ju/%ju allocations recycled (%.1f%%)",
+                hits, hits + misses, 100. * hits / (hits + misses));
+}
+
 static void vlc_frame_generic_Release (vlc_frame_t *frame)
 {
     /* That is always true for frames allocated with vlc_frame_Alloc(). */
     assert (frame->p_start == (unsigned char *)(frame + 1));
+
+    /* vlc_frame_Alloc() rounds up to the class size, so the original
+     * allocation size can be recovered from i_size */
+    int cls = vlc_frame_pool_ClassMatch(sizeof (*frame) + frame->i_size);
+    if (cls >= 0)
+    {
+        struct vlc_frame_pool *pool = vlc_frame_pool_Get();
+        if (likely(pool != NULL)
+         && pool->classes[cls].count < VLC_FRAME_POOL_DEPTH)
+        {
+            frame->p_next = pool->classes[cls].frames;
+            pool->classes[cls].frames = frame;
+            pool->classes[cls].count++;
+            return;
+        }
+    }
     free (frame);
 }
 
@@ -120,14 +245,34 @@ vlc_frame_t *vlc_frame_Alloc (size_t size)
     }
 
     /* 2 * VLC_FRAME_PADDING: pre + post padding */
-    const size_t alloc = sizeof (vlc_frame_t) + VLC_FRAME_ALIGN + (2 * VLC_FRAME_PADDING)
-                       + size;
+    size_t alloc = sizeof (vlc_frame_t) + VLC_FRAME_ALIGN + (2 * VLC_FRAME_PADDING)
+                 + size;
     if (unlikely(alloc <= size))
         return NULL;
 
-    vlc_frame_t *f = malloc (alloc);
-    if (unlikely(f == NULL))
-        return NULL;
+    vlc_frame_t *f = NULL;
+    int cls = vlc_frame_pool_ClassFor(&alloc);
+    if (likely(cls >= 0))
+    {
+        struct vlc_frame_pool *pool = vlc_frame_pool_Get();
+        if (likely(pool != NULL) && pool->classes[cls].frames != NULL)
+        {
+            f = pool->classes[cls].frames;
+            pool->classes[cls].frames = f->p_next;
+            pool->classes[cls].count--;
+            atomic_fetch_add_explicit(&vlc_frame_pool_hits, 1,
+                                      memory_order_relaxed);
+        }
+    }
+
+    if (f == NULL)
+    {
+        f = malloc (alloc);
+        if (unlikely(f == NULL))
+            return NULL;
+        atomic_fetch_add_explicit(&vlc_frame_pool_misses, 1,
+                                  memory_order_relaxed);
+    }
 
     vlc_frame_Init(f, &vlc_frame_generic_cbs, f + 1, alloc - sizeof (*f));
     static_assert ((VLC_FRAME_PADDING % VLC_FRAME_ALIGN) == 0,
@@ -28,8 +28,10 @@
 #include <stdio.h>
 #include <string.h>
 #include <assert.h>
+#include <time.h>
 
 #include <vlc_common.h>
+#include <vlc_arrays.h>
 #include <vlc_messages.h>
 #include <vlc_strings.h>
 #include <vlc_http.h>
@@ -40,6 +42,7 @@ typedef struct http_cookie_t
     char *psz_value;
     char *psz_domain;
     char *psz_path;
+    time_t expiry; /* absolute expiry time, 0 for a session cookie */
     bool b_host_only;
     bool b_secure;
 } http_cookie_t;
@@ -255,6 +258,28 @@ static http_cookie_t *cookie_parse(const char *value,
     /* Get secure flag */
     cookie->b_secure = cookie_has_attribute(value, "secure");
 
+    /* Get expiry from Max-Age (RFC 6265 section 5.2.2). Expires dates are
+     * not parsed: Max-Age takes precedence over them anyway and the jar is
+     * never persisted across runs. */
+    char *max_age = cookie_get_attribute_value(value, "max-age");
+    cookie->expiry = 0;
+    if (max_age != NULL)
+    {
+        char *end;
+        long long sec = strtoll(max_age, &end, 10);
+
+        if (end != max_age)
+        {
+            if (sec <= 0) /* how a server deletes a cookie */
+                cookie->expiry = 1;
+            else if (sec >= INT32_MAX)
+                cookie->expiry = time(NULL) + INT32_MAX;
+            else
+                cookie->expiry = time(NULL) + (time_t)sec;
+        }
+        free(max_age);
+    }
+
     return cookie;
 
 error:
@@ -264,18 +289,87 @@ error:
 
 struct vlc_http_cookie_jar_t
 {
-    vlc_array_t cookies;
+    /* Cookies bucketed per domain: keys are lower-cased domain names,
+     * values are vlc_array_t of http_cookie_t. A lookup only probes the
+     * suffixes of the request host instead of scanning the whole jar. */
+    vlc_dictionary_t domains;
     vlc_mutex_t lock;
+    time_t next_expiry; /* earliest expiry in the jar, 0 if none */
 };
 
+/* Domain names match case-insensitively: normalize the bucket key */
+static char *cookie_domain_key( const char *domain )
+{
+    char *key = strdup( domain );
+    if( likely(key != NULL) )
+        for( char *p = key; *p != '\0'; p++ )
+            if( *p >= 'A' && *p <= 'Z' )
+                *p += 'a' - 'A';
+    return key;
+}
+
+static void jar_destroy_bucket( void *value, void *obj )
+{
+    vlc_array_t *bucket = value;
+
+    (void) obj;
+    for( size_t i = 0; i < vlc_array_count( bucket ); i++ )
+        cookie_destroy( vlc_array_item_at_index( bucket, i ) );
+    vlc_array_clear( bucket );
+    free( bucket );
+}
+
+/* Drop every expired cookie in one pass. Called with the jar locked, and
+ * only once the earliest known expiry has passed, so that lookups do not
+ * pay a per-cookie expiry check. */
+static void jar_sweep_expired( vlc_http_cookie_jar_t *jar, time_t now )
+{
+    char **keys = vlc_dictionary_all_keys( &jar->domains );
+    if( keys == NULL )
+        return; /* OOM: retry at the next lookup */
+
+    jar->next_expiry = 0;
+    for( int i = 0; keys[i] != NULL; i++ )
+    {
+        vlc_array_t *bucket =
+            vlc_dictionary_value_for_key( &jar->domains, keys[i] );
+
+        for( size_t j = vlc_array_count( bucket ); j-- > 0; )
+        {
+            http_cookie_t *cookie = vlc_array_item_at_index( bucket, j );
+
+            if( cookie->expiry == 0 )
+                continue;
+            if( cookie->expiry <= now )
+            {
+                vlc_array_remove( bucket, j );
+                cookie_destroy( cookie );
+            }
+            else if( jar->next_expiry == 0 || cookie->expiry < jar->next_expiry )
+                jar->next_expiry = cookie->expiry;
+        }
+
+        if( vlc_array_count( bucket ) == 0 )
+        {
+            vlc_dictionary_remove_value_for_key( &jar->domains, keys[i],
+                                                 NULL, NULL );
+            vlc_array_clear( bucket );
+            free( bucket );
+        }
+        free( keys[i] );
+    }
+    free( keys );
+}
+
 vlc_http_cookie_jar_t * vlc_http_cookies_new(void)
 {
     vlc_http_cookie_jar_t * jar = malloc( sizeof( vlc_http_cookie_jar_t ) );
     if ( unlikely(jar == NULL) )
         return NULL;
 
-    vlc_array_init( &jar->cookies );
+    vlc_dictionary_init( &jar->domains, 0 );
     vlc_mutex_init( &jar->lock );
+    jar->next_expiry = 0;
 
     return jar;
 }
@@ -285,10 +379,7 @@ void vlc_http_cookies_destroy( vlc_http_cookie_jar_t * p_jar )
     if ( !p_jar )
         return;
 
-    for( size_t i = 0; i < vlc_array_count( &p_jar->cookies ); i++ )
-        cookie_destroy( vlc_array_item_at_index( &p_jar->cookies, i ) );
-
-    vlc_array_clear( &p_jar->cookies );
+    vlc_dictionary_clear( &p_jar->domains, jar_destroy_bucket, NULL );
 
     free( p_jar );
 }
@@ -316,34 +407,70 @@ bool vlc_http_cookies_store(vlc_http_cookie_jar_t *p_jar, const char *cookies,
         return false;
     }
 
-    vlc_mutex_lock( &p_jar->lock );
-
-    for( size_t i = 0; i < vlc_array_count( &p_jar->cookies ); i++ )
+    char *key = cookie_domain_key( cookie->psz_domain );
+    if( unlikely(key == NULL) )
     {
-        http_cookie_t *iter = vlc_array_item_at_index( &p_jar->cookies, i );
+        cookie_destroy( cookie );
+        return false;
+    }
 
-        assert( iter->psz_name );
-        assert( iter->psz_domain );
-        assert( iter->psz_path );
+    time_t now = time( NULL );
 
-        bool domains_match =
-            vlc_ascii_strcasecmp( cookie->psz_domain, iter->psz_domain ) == 0;
-        bool paths_match = strcmp( cookie->psz_path, iter->psz_path ) == 0;
-        bool names_match = strcmp( cookie->psz_name, iter->psz_name ) == 0;
-        if( domains_match && paths_match && names_match )
+    vlc_mutex_lock( &p_jar->lock );
+
+    if( p_jar->next_expiry != 0 && p_jar->next_expiry <= now )
+        jar_sweep_expired( p_jar, now );
+
+    vlc_array_t *bucket = vlc_dictionary_value_for_key( &p_jar->domains, key );
+    if( bucket != NULL )
+        for( size_t i = 0; i < vlc_array_count( bucket ); i++ )
         {
-            /* Remove previous value for this cookie */
-            vlc_array_remove( &p_jar->cookies, i );
-            cookie_destroy(iter);
-            break;
+            http_cookie_t *iter = vlc_array_item_at_index( bucket, i );
+
+            assert( iter->psz_name );
+            assert( iter->psz_path );
+
+            /* The domains already match: they share the bucket */
+            if( strcmp( cookie->psz_path, iter->psz_path ) == 0
+             && strcmp( cookie->psz_name, iter->psz_name ) == 0 )
+            {
+                /* Remove previous value for this cookie */
+                vlc_array_remove( bucket, i );
+                cookie_destroy( iter );
+                break;
+            }
         }
-    }
 
-    bool b_ret = (vlc_array_append( &p_jar->cookies, cookie ) == 0);
-    if( !b_ret )
+    bool b_ret;
+    if( cookie->expiry != 0 && cookie->expiry <= now )
+    {
+        /* An already expired cookie is a deletion request */
         cookie_destroy( cookie );
+        b_ret = true;
+    }
+    else
+    {
+        if( bucket == NULL )
+        {
+            bucket = malloc( sizeof( *bucket ) );
+            if( likely(bucket != NULL) )
+            {
+                vlc_array_init( bucket );
+                vlc_dictionary_insert( &p_jar->domains, key, bucket );
+            }
+        }
+
+        b_ret = bucket != NULL && vlc_array_append( bucket, cookie ) == 0;
+        if( !b_ret )
+            cookie_destroy( cookie );
+        else if( cookie->expiry != 0
+              && ( p_jar->next_expiry == 0
+                || cookie->expiry < p_jar->next_expiry ) )
+            p_jar->next_expiry = cookie->expiry;
+    }
 
     vlc_mutex_unlock( &p_jar->lock );
+    free( key );
 
     return b_ret;
 }
@@ -353,31 +480,56 @@ char *vlc_http_cookies_fetch(vlc_http_cookie_jar_t *p_jar, bool secure,
 {
     char *psz_cookiebuf = NULL;
 
+    if( host == NULL || path == NULL )
+        return NULL;
+
+    char *key = cookie_domain_key( host );
+    if( unlikely(key == NULL) )
+        return NULL;
+
+    time_t now = time( NULL );
+
     vlc_mutex_lock( &p_jar->lock );
 
-    for( size_t i = 0; i < vlc_array_count( &p_jar->cookies ); i++ )
+    if( p_jar->next_expiry != 0 && p_jar->next_expiry <= now )
+        jar_sweep_expired( p_jar, now );
+
+    /* Only suffixes of the host name can hold matching cookies
+     * (RFC 6265 section 5.1.3): probe those buckets, not the whole jar. */
+    for( const char *domain = key; domain != NULL; )
     {
-        const http_cookie_t * cookie = vlc_array_item_at_index( &p_jar->cookies, i );
-        if (cookie_should_be_sent(cookie, secure, host, path))
+        vlc_array_t *bucket =
+            vlc_dictionary_value_for_key( &p_jar->domains, domain );
+
+        for( size_t i = 0; bucket != NULL && i < vlc_array_count( bucket ); i++ )
         {
-            char *psz_updated_buf = NULL;
-            if ( asprintf(&psz_updated_buf, "%s%s%s=%s",
-                          psz_cookiebuf ? psz_cookiebuf : "",
-                          psz_cookiebuf ? "; " : "",
-                          cookie->psz_name ? cookie->psz_name : "",
-                          cookie->psz_value ? cookie->psz_value : "") == -1 )
+            const http_cookie_t *cookie = vlc_array_item_at_index( bucket, i );
+            if (cookie_should_be_sent(cookie, secure, host, path))
             {
-                // TODO: report error
+                char *psz_updated_buf = NULL;
+                if ( asprintf(&psz_updated_buf, "%s%s%s=%s",
+                              psz_cookiebuf ? psz_cookiebuf : "",
+                              psz_cookiebuf ? "; " : "",
+                              cookie->psz_name ? cookie->psz_name : "",
+                              cookie->psz_value ? cookie->psz_value : "") == -1 )
+                {
+                    // TODO: report error
+                    free( psz_cookiebuf );
+                    vlc_mutex_unlock( &p_jar->lock );
+                    free( key );
+                    return NULL;
+                }
                 free( psz_cookiebuf );
-                vlc_mutex_unlock( &p_jar->lock );
-                return NULL;
+                psz_cookiebuf = psz_updated_buf;
             }
-            free( psz_cookiebuf );
-            psz_cookiebuf = psz_updated_buf;
         }
+
+        const char *dot = strchr( domain, '.' );
+        domain = ( dot != NULL ) ? dot + 1 : NULL;
     }
 
     vlc_mutex_unlock( &p_jar->lock );
+    free( key );
 
     return psz_cookiebuf;
 }
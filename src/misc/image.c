@@ -76,9 +76,9 @@ static picture_t *ImageConvert( image_handler_t *, picture_t *,
 static decoder_t *CreateDecoder( image_handler_t *, const es_format_t * );
 static encoder_t *CreateEncoder( vlc_object_t *, const video_format_t *,
                                  const video_format_t * );
-static filter_t *CreateConverter( vlc_object_t *, const es_format_t *,
-                                  struct vlc_video_context *,
-                                  const video_format_t * );
+static filter_t *GetConverter( image_handler_t *, const es_format_t *,
+                               struct vlc_video_context *,
+                               const video_format_t * );
 static void DeleteConverter( filter_t * );
 
 vlc_fourcc_t image_Type2Fourcc( const char * );
@@ -125,7 +125,9 @@ void image_HandlerDelete( image_handler_t *p_image )
     }
     if( p_image->p_enc )
         vlc_encoder_Destroy( p_image->p_enc );
-    if( p_image->p_converter ) DeleteConverter( p_image->p_converter );
+    for( size_t i = 0; i < ARRAY_SIZE(p_image->converters); i++ )
+        if( p_image->converters[i] )
+            DeleteConverter( p_image->converters[i] );
 
     picture_fifo_Delete( p_image->outfifo );
 
@@ -248,39 +250,16 @@ static picture_t *ImageRead( image_handler_t *p_image, block_t *p_block,
         p_image->p_dec->fmt_out.video.i_width != p_fmt_out->i_width ||
         p_image->p_dec->fmt_out.video.i_height != p_fmt_out->i_height )
     {
-        if( p_image->p_converter &&
-            ( p_image->p_converter->fmt_in.video.i_chroma !=
-              p_image->p_dec->fmt_out.video.i_chroma ||
-              p_image->p_converter->fmt_out.video.i_chroma != p_fmt_out->i_chroma ) )
+        filter_t *p_converter =
+            GetConverter( p_image, &p_image->p_dec->fmt_out,
+                          picture_GetVideoContext(p_pic), p_fmt_out );
+        if( !p_converter )
         {
-            /* We need to restart a new filter */
-            DeleteConverter( p_image->p_converter );
-            p_image->p_converter = NULL;
-        }
-
-        /* Start a filter */
-        if( !p_image->p_converter )
-        {
-            p_image->p_converter =
-                CreateConverter( p_image->p_parent, &p_image->p_dec->fmt_out,
-                                 picture_GetVideoContext(p_pic), p_fmt_out );
-
-            if( !p_image->p_converter )
-            {
-                picture_Release( p_pic );
-                return NULL;
-            }
-        }
-        else
-        {
-            /* Filters should handle on-the-fly size changes */
-            es_format_Clean( &p_image->p_converter->fmt_in );
-            es_format_Copy( &p_image->p_converter->fmt_in, &p_image->p_dec->fmt_out );
-            video_format_Clean( &p_image->p_converter->fmt_out.video );
-            video_format_Copy( &p_image->p_converter->fmt_out.video, p_fmt_out);
+            picture_Release( p_pic );
+            return NULL;
         }
 
-        p_pic = p_image->p_converter->ops->filter_video( p_image->p_converter, p_pic );
+        p_pic = p_converter->ops->filter_video( p_converter, p_pic );
         assert(p_pic == NULL || !picture_HasChainedPics(p_pic)); // no chaining
     }
     else
@@ -406,46 +385,22 @@ static block_t *ImageWrite( image_handler_t *p_image, picture_t *p_pic,
        !BitMapFormatIsSimilar( &p_image->p_enc->fmt_in.video, p_fmt_in ) )
     {
 
-        if( p_image->p_converter &&
-            ( p_image->p_converter->fmt_in.video.i_chroma != p_fmt_in->i_chroma ||
-              p_image->p_converter->fmt_out.video.i_chroma !=
-              p_image->p_enc->fmt_in.video.i_chroma ||
-             !BitMapFormatIsSimilar( &p_image->p_converter->fmt_in.video, p_fmt_in ) ) )
-        {
-            /* We need to restart a new filter */
-            DeleteConverter( p_image->p_converter );
-            p_image->p_converter = NULL;
-        }
+        es_format_t fmt_in;
+        es_format_Init( &fmt_in, VIDEO_ES, p_fmt_in->i_chroma );
+        fmt_in.video = *p_fmt_in;
 
-        /* Start a filter */
-        if( !p_image->p_converter )
+        filter_t *p_converter =
+            GetConverter( p_image, &fmt_in, picture_GetVideoContext(p_pic),
+                          &p_image->p_enc->fmt_in.video );
+        if( !p_converter )
         {
-            es_format_t fmt_in;
-            es_format_Init( &fmt_in, VIDEO_ES, p_fmt_in->i_chroma );
-            fmt_in.video = *p_fmt_in;
-
-            p_image->p_converter =
-                CreateConverter( p_image->p_parent, &fmt_in,
-                                 picture_GetVideoContext(p_pic), &p_image->p_enc->fmt_in.video );
-
-            if( !p_image->p_converter )
-            {
-                picture_Release(p_pic);
-                return NULL;
-            }
-        }
-        else
-        {
-            /* Filters should handle on-the-fly size changes */
-            es_format_Clean( &p_image->p_converter->fmt_in );
-            es_format_InitFromVideo( &p_image->p_converter->fmt_in, p_fmt_in );
-            es_format_Clean( &p_image->p_converter->fmt_out );
-            es_format_Copy( &p_image->p_converter->fmt_out, &p_image->p_enc->fmt_in );
+            picture_Release(p_pic);
+            return NULL;
         }
 
         /* Hold the picture there to let the caller release its own picture,
          * since filters will consume the picture. */
-        p_pic = p_image->p_converter->ops->filter_video( p_image->p_converter, p_pic );
+        p_pic = p_converter->ops->filter_video( p_converter, p_pic );
         assert(p_pic == NULL || !picture_HasChainedPics(p_pic)); // no chaining
     }
 
@@ -539,43 +494,19 @@ static picture_t *ImageConvert( image_handler_t *p_image, picture_t *p_pic,
     if( !p_fmt_out->i_sar_num ) p_fmt_out->i_sar_num = p_fmt_in->i_sar_num;
     if( !p_fmt_out->i_sar_den ) p_fmt_out->i_sar_den = p_fmt_in->i_sar_den;
 
-    if( p_image->p_converter &&
-        ( p_image->p_converter->fmt_in.video.i_chroma != p_fmt_in->i_chroma ||
-          p_image->p_converter->fmt_out.video.i_chroma != p_fmt_out->i_chroma ) )
-    {
-        /* We need to restart a new filter */
-        DeleteConverter( p_image->p_converter );
-        p_image->p_converter = NULL;
-    }
-
-    /* Start a filter */
-    if( !p_image->p_converter )
-    {
-        es_format_t fmt_in;
-        es_format_Init( &fmt_in, VIDEO_ES, p_fmt_in->i_chroma );
-        fmt_in.video = *p_fmt_in;
-
-        p_image->p_converter =
-            CreateConverter( p_image->p_parent, &fmt_in,
-                             picture_GetVideoContext(p_pic), p_fmt_out );
+    es_format_t fmt_in;
+    es_format_Init( &fmt_in, VIDEO_ES, p_fmt_in->i_chroma );
+    fmt_in.video = *p_fmt_in;
 
-        if( !p_image->p_converter )
-        {
-            return NULL;
-        }
-    }
-    else
-    {
-        /* Filters should handle on-the-fly size changes */
-        es_format_Clean( &p_image->p_converter->fmt_in );
-        es_format_InitFromVideo( &p_image->p_converter->fmt_in, p_fmt_in );
-        es_format_Clean( &p_image->p_converter->fmt_out );
-        es_format_InitFromVideo( &p_image->p_converter->fmt_out, p_fmt_out );
-    }
+    filter_t *p_converter =
+        GetConverter( p_image, &fmt_in, picture_GetVideoContext(p_pic),
+                      p_fmt_out );
+    if( !p_converter )
+        return NULL;
 
     picture_Hold( p_pic );
 
-    p_pic = p_image->p_converter->ops->filter_video( p_image->p_converter, p_pic );
+    p_pic = p_converter->ops->filter_video( p_converter, p_pic );
     assert(p_pic == NULL || !picture_HasChainedPics(p_pic)); // no chaining
     return p_pic;
 }
@@ -799,6 +730,58 @@ static filter_t *CreateConverter( vlc_object_t *p_this,
     return p_filter;
 }
 
+/* Looks up a matching converter in the handler cache, building and caching
+ * a new one on miss. The cache is keyed by input/output chroma and size so
+ * alternating conversions (e.g. decode-side then encode-side of a thumbnail)
+ * do not tear each other's filter chain down. */
+static filter_t *GetConverter( image_handler_t *p_image,
+                               const es_format_t *p_fmt_in,
+                               struct vlc_video_context *p_vctx_in,
+                               const video_format_t *p_fmt_out )
+{
+    const size_t i_last = ARRAY_SIZE(p_image->converters) - 1;
+    filter_t *p_converter;
+
+    for( size_t i = 0; i <= i_last; i++ )
+    {
+        p_converter = p_image->converters[i];
+        if( p_converter == NULL )
+            continue;
+
+        const video_format_t *p_in = &p_converter->fmt_in.video;
+        const video_format_t *p_out = &p_converter->fmt_out.video;
+
+        if( p_in->i_chroma == p_fmt_in->video.i_chroma &&
+            p_in->i_width == p_fmt_in->video.i_width &&
+            p_in->i_height == p_fmt_in->video.i_height &&
+            p_out->i_chroma == p_fmt_out->i_chroma &&
+            p_out->i_width == p_fmt_out->i_width &&
+            p_out->i_height == p_fmt_out->i_height &&
+            BitMapFormatIsSimilar( p_in, &p_fmt_in->video ) &&
+            BitMapFormatIsSimilar( p_out, p_fmt_out ) )
+        {
+            /* Move to the front (most recently used) */
+            memmove( &p_image->converters[1], &p_image->converters[0],
+                     i * sizeof (filter_t *) );
+            p_image->converters[0] = p_converter;
+            return p_converter;
+        }
+    }
+
+    p_converter = CreateConverter( p_image->p_parent, p_fmt_in, p_vctx_in,
+                                   p_fmt_out );
+    if( p_converter == NULL )
+        return NULL;
+
+    /* Evict the least recently used entry */
+    if( p_image->converters[i_last] )
+        DeleteConverter( p_image->converters[i_last] );
+    memmove( &p_image->converters[1], &p_image->converters[0],
+             i_last * sizeof (filter_t *) );
+    p_image->converters[0] = p_converter;
+    return p_converter;
+}
+
 static void DeleteConverter( filter_t * p_filter )
 {
     if( p_filter->p_module )
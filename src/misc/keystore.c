@@ -287,7 +287,8 @@ smb_split_domain(vlc_credential *p_credential)
 }
 
 static void
-credential_find_keystore(vlc_credential *p_credential, vlc_keystore *p_keystore)
+credential_find_keystore(vlc_credential *p_credential, vlc_keystore *p_keystore,
+                         bool b_memory_keystore)
 {
     const vlc_url_t *p_url = p_credential->p_url;
 
@@ -342,6 +343,7 @@ credential_find_keystore(vlc_credential *p_credential, vlc_keystore *p_keystore)
             p_credential->psz_realm = p_entry->ppsz_values[KEY_REALM];
             p_credential->psz_authtype = p_entry->ppsz_values[KEY_AUTHTYPE];
             p_credential->b_from_keystore = true;
+            p_credential->b_from_memory_keystore = b_memory_keystore;
         }
     }
 }
@@ -390,6 +392,7 @@ vlc_credential_get(vlc_credential *p_credential, vlc_object_t *p_parent,
     }
 
     p_credential->b_from_keystore = false;
+    p_credential->b_from_memory_keystore = false;
     /* Don't set username to NULL, we may want to use the last one set */
     p_credential->psz_password = NULL;
 
@@ -441,7 +444,7 @@ vlc_credential_get(vlc_credential *p_credential, vlc_object_t *p_parent,
         {
             vlc_keystore *p_keystore = get_memory_keystore(p_parent);
             if (p_keystore != NULL)
-                credential_find_keystore(p_credential, p_keystore);
+                credential_find_keystore(p_credential, p_keystore, true);
             p_credential->i_get_order++;
             break;
         }
@@ -450,7 +453,8 @@ vlc_credential_get(vlc_credential *p_credential, vlc_object_t *p_parent,
             if (p_credential->p_keystore == NULL)
                 p_credential->p_keystore = vlc_keystore_create(p_parent);
             if (p_credential->p_keystore != NULL)
-                credential_find_keystore(p_credential, p_credential->p_keystore);
+                credential_find_keystore(p_credential, p_credential->p_keystore,
+                                         false);
 
             if (vlc_killed())
                 return -EINTR;
@@ -502,31 +506,9 @@ vlc_credential_get(vlc_credential *p_credential, vlc_object_t *p_parent,
     return is_credential_valid(p_credential) ? 0 : -ENOENT;
 }
 
-#undef vlc_credential_store
-bool
-vlc_credential_store(vlc_credential *p_credential, vlc_object_t *p_parent)
+static bool
+credential_store(vlc_credential *p_credential, vlc_keystore *p_keystore)
 {
-    if (!is_credential_valid(p_credential))
-        return false;
-    /* Don't need to store again */
-    if (p_credential->b_from_keystore)
-        return p_credential->b_from_keystore;
-
-    vlc_keystore *p_keystore;
-    if (p_credential->b_store)
-    {
-        /* Store in permanent keystore */
-        assert(p_credential->p_keystore != NULL);
-        p_keystore = p_credential->p_keystore;
-    }
-    else
-    {
-        /* Store in memory keystore */
-        p_keystore = get_memory_keystore(p_parent);
-    }
-    if (p_keystore == NULL)
-        return false;
-
     const vlc_url_t *p_url = p_credential->p_url;
 
     char *psz_path = NULL;
@@ -580,3 +562,43 @@ vlc_credential_store(vlc_credential *p_credential, vlc_object_t *p_parent)
     free(psz_path);
     return b_ret;
 }
+
+#undef vlc_credential_store
+bool
+vlc_credential_store(vlc_credential *p_credential, vlc_object_t *p_parent)
+{
+    if (!is_credential_valid(p_credential))
+        return false;
+
+    if (p_credential->b_from_keystore)
+    {
+        /* Already stored, but credentials unlocked from the agent-backed
+         * keystore are mirrored into the in-process memory keystore, so
+         * that further lookups within this session (e.g. mounting sibling
+         * shares of the same server) skip the agent roundtrip. */
+        if (!p_credential->b_from_memory_keystore)
+        {
+            vlc_keystore *p_keystore = get_memory_keystore(p_parent);
+            if (p_keystore != NULL)
+                credential_store(p_credential, p_keystore);
+        }
+        return true;
+    }
+
+    vlc_keystore *p_keystore;
+    if (p_credential->b_store)
+    {
+        /* Store in permanent keystore */
+        assert(p_credential->p_keystore != NULL);
+        p_keystore = p_credential->p_keystore;
+    }
+    else
+    {
+        /* Store in memory keystore */
+        p_keystore = get_memory_keystore(p_parent);
+    }
+    if (p_keystore == NULL)
+        return false;
+
+    return credential_store(p_credential, p_keystore);
+}
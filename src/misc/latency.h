@@ -0,0 +1,64 @@
+/*****************************************************************************
+ * latency.h: video pipeline latency accounting
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifndef LIBVLC_LATENCY_H
+#define LIBVLC_LATENCY_H 1
+
+#include <vlc_ancillary.h>
+#include <vlc_input_item.h>
+
+/**
+ * Ancillary stamped by the decoder on every output picture to measure the
+ * end-to-end pipeline latency. All dates are system times (vlc_tick_now()).
+ */
+#define VLC_ANCILLARY_ID_LATENCY VLC_ANCILLARY_ID('l','t','c','y')
+
+struct vlc_latency_tag
+{
+    vlc_tick_t demux;  /**< frame handed over by the demuxer, or
+                            VLC_TICK_INVALID if unknown */
+    vlc_tick_t decode; /**< picture output by the decoder */
+    vlc_tick_t filter; /**< picture output by the filter chain, or
+                            VLC_TICK_INVALID if not filtered yet */
+};
+
+/**
+ * Latency histogram, drained from the video output into the input
+ * statistics (see input_stats_t). Bucket N counts samples below
+ * 10 ms << N, the last bucket everything above.
+ */
+struct vlc_latency_histogram
+{
+    vlc_tick_t sum;
+    uint64_t samples;
+    uint64_t buckets[INPUT_STATS_LATENCY_BUCKETS];
+};
+
+static inline size_t vlc_latency_HistogramBucket(vlc_tick_t latency)
+{
+    vlc_tick_t bound = VLC_TICK_FROM_MS(10);
+
+    for (size_t i = 0; i < INPUT_STATS_LATENCY_BUCKETS - 1; i++, bound *= 2)
+        if (latency < bound)
+            return i;
+    return INPUT_STATS_LATENCY_BUCKETS - 1;
+}
+
+#endif
@@ -31,6 +31,7 @@
 # include "config.h"
 #endif
 
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <stdarg.h>                                       /* va_list for BSD */
 #include <unistd.h>
@@ -417,6 +418,178 @@ static struct vlc_logger *vlc_LogModuleCreate(vlc_object_t *parent)
     return &module->frontend;
 }
 
+/**
+ * Asynchronous message log.
+ *
+ * A message log that formats messages on the calling thread, then queues the
+ * records to a bounded lock-free ring drained by a dedicated thread, so that
+ * slow sinks do not delay time-sensitive threads. Records are dropped (and
+ * accounted for) rather than blocking when the ring is full.
+ */
+#define VLC_LOG_ASYNC_SIZE 256 /* must be a power of two */
+
+struct vlc_log_async_entry {
+    atomic_size_t sequence;
+    int type;
+    vlc_log_t meta;
+    char *msg;
+};
+
+struct vlc_logger_async {
+    struct vlc_logger frontend;
+    struct vlc_logger *sink;
+    vlc_thread_t thread;
+    vlc_sem_t ready; /* one token per queued record, plus one to terminate */
+    atomic_size_t head; /* next slot for producers to claim */
+    size_t tail; /* only used by the drain thread */
+    atomic_uintmax_t dropped;
+    struct vlc_log_async_entry ring[VLC_LOG_ASYNC_SIZE];
+};
+
+static void vlc_vaLogAsync(void *d, int type, const vlc_log_t *item,
+                           const char *format, va_list ap)
+{
+    struct vlc_logger *logger = d;
+    struct vlc_logger_async *async =
+        container_of(logger, struct vlc_logger_async, frontend);
+    struct vlc_log_async_entry *entry;
+    size_t pos = atomic_load_explicit(&async->head, memory_order_relaxed);
+
+    for (;;) {
+        entry = &async->ring[pos % VLC_LOG_ASYNC_SIZE];
+
+        size_t seq = atomic_load_explicit(&entry->sequence,
+                                          memory_order_acquire);
+        intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+
+        if (dif == 0) {
+            if (atomic_compare_exchange_weak_explicit(&async->head, &pos,
+                                                      pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed))
+                break;
+        } else if (dif < 0) {
+            /* Ring full: drop the record rather than block the caller */
+            atomic_fetch_add_explicit(&async->dropped, 1,
+                                      memory_order_relaxed);
+            return;
+        } else
+            pos = atomic_load_explicit(&async->head, memory_order_relaxed);
+    }
+
+    entry->type = type;
+    entry->meta = *item;
+    /* NOTE: Object types and module names are static constant (as with the
+     * early log), but the header is not. */
+    entry->meta.psz_header =
+        item->psz_header != NULL ? strdup(item->psz_header) : NULL;
+    if (vasprintf(&entry->msg, format, ap) == -1)
+        entry->msg = NULL;
+
+    atomic_store_explicit(&entry->sequence, pos + 1, memory_order_release);
+    vlc_sem_post(&async->ready);
+}
+
+static void vlc_LogAsyncReportDropped(struct vlc_logger_async *async)
+{
+    uintmax_t dropped = atomic_exchange_explicit(&async->dropped, 0,
+                                                 memory_order_relaxed);
+    if (dropped == 0)
+        return;
+
+    vlc_log_t meta = {
+        .i_object_id = (uintptr_t)(void *)async,
+        .psz_object_type = "logger",
+        .psz_module = "core",
+        .line = -1,
+        .tid = vlc_thread_id(),
+    };
+    vlc_LogCallback(async->sink, VLC_MSG_WARN, &meta,
+                    "%ju log messages dropped (ring full)", dropped);
+}
+
+static bool vlc_LogAsyncDrainOne(struct vlc_logger_async *async)
+{
+    struct vlc_log_async_entry *entry =
+        &async->ring[async->tail % VLC_LOG_ASYNC_SIZE];
+    size_t seq = atomic_load_explicit(&entry->sequence, memory_order_acquire);
+
+    if (seq != async->tail + 1)
+        return false;
+
+    vlc_LogCallback(async->sink, entry->type, &entry->meta, "%s",
+                    (entry->msg != NULL) ? entry->msg : "message lost");
+    free(entry->msg);
+    free((char *)entry->meta.psz_header); // local copy
+
+    atomic_store_explicit(&entry->sequence,
+                          async->tail + VLC_LOG_ASYNC_SIZE,
+                          memory_order_release);
+    async->tail++;
+    return true;
+}
+
+static void *vlc_LogAsyncThread(void *d)
+{
+    struct vlc_logger_async *async = d;
+
+    vlc_thread_set_name("vlc-logger");
+
+    for (;;) {
+        vlc_sem_wait(&async->ready);
+
+        /* No record for this token: it was posted to terminate. Producers are
+         * all gone by then (see vlc_LogSwitch()), the ring is empty. */
+        if (!vlc_LogAsyncDrainOne(async))
+            break;
+
+        vlc_LogAsyncReportDropped(async);
+    }
+
+    vlc_LogAsyncReportDropped(async);
+    return NULL;
+}
+
+static void vlc_LogAsyncClose(void *d)
+{
+    struct vlc_logger *logger = d;
+    struct vlc_logger_async *async =
+        container_of(logger, struct vlc_logger_async, frontend);
+
+    vlc_sem_post(&async->ready);
+    vlc_join(async->thread, NULL);
+
+    vlc_LogDestroy(async->sink);
+    free(async);
+}
+
+static const struct vlc_logger_operations async_ops = {
+    vlc_vaLogAsync,
+    vlc_LogAsyncClose,
+};
+
+static struct vlc_logger *vlc_LogAsyncCreate(struct vlc_logger *sink)
+{
+    struct vlc_logger_async *async = malloc(sizeof (*async));
+    if (unlikely(async == NULL))
+        return NULL;
+
+    async->frontend.ops = &async_ops;
+    async->sink = sink;
+    vlc_sem_init(&async->ready, 0);
+    atomic_init(&async->head, 0);
+    async->tail = 0;
+    atomic_init(&async->dropped, 0);
+    for (size_t i = 0; i < VLC_LOG_ASYNC_SIZE; i++)
+        atomic_init(&async->ring[i].sequence, i);
+
+    if (vlc_clone(&async->thread, vlc_LogAsyncThread, async)) {
+        free(async);
+        return NULL;
+    }
+    return &async->frontend;
+}
+
 /**
  * Initializes the messages logging subsystem and drain the early messages to
  * the configured log.
@@ -426,6 +599,11 @@ void vlc_LogInit(libvlc_int_t *vlc)
     struct vlc_logger *logger = vlc_LogModuleCreate(VLC_OBJECT(vlc));
     if (logger == NULL)
         logger = &discard_log;
+    else if (var_InheritBool(vlc, "log-async")) {
+        struct vlc_logger *async = vlc_LogAsyncCreate(logger);
+        if (async != NULL)
+            logger = async;
+    }
 
     vlc_LogSwitch(vlc->obj.logger, logger);
 }
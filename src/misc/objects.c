@@ -58,6 +58,71 @@
 #define vlc_children_foreach(pos, priv) \
     while (((void)(pos), (void)(priv), 0))
 
+/*****************************************************************************
+ * Live object census
+ *****************************************************************************/
+/* One slot per distinct type name, created on first use and never freed:
+ * the set of type names is small and fixed, and immortal slots let
+ * vlc_objects_DumpCensus() run without touching any object. Object
+ * creation is low-rate (objects back modules and pipeline stages, not
+ * packets), so a mutex-protected list lookup per creation is cheap. */
+struct vlc_object_census
+{
+    struct vlc_object_census *next;
+    const char *typename;
+    atomic_uintmax_t count;
+};
+
+static struct vlc_object_census *census_list = NULL;
+static vlc_mutex_t census_lock = VLC_STATIC_MUTEX;
+
+static struct vlc_object_census *vlc_census_slot(const char *typename)
+{
+    struct vlc_object_census *slot;
+
+    vlc_mutex_lock(&census_lock);
+    for (slot = census_list; slot != NULL; slot = slot->next)
+        if (!strcmp(slot->typename, typename))
+            break;
+
+    if (slot == NULL)
+    {
+        slot = malloc(sizeof (*slot));
+        if (likely(slot != NULL))
+        {   /* Type names are static strings (see vlc_custom_create()),
+             * so keeping the pointer is safe. */
+            slot->typename = typename;
+            atomic_init(&slot->count, 0);
+            slot->next = census_list;
+            census_list = slot;
+        }
+    }
+    vlc_mutex_unlock(&census_lock);
+    return slot;
+}
+
+/**
+ * Logs the number of live objects of each type.
+ *
+ * This only reads a handful of counters, so it is cheap enough to trigger
+ * periodically on production instances to spot object leaks (see the
+ * "census" variable on the libvlc object).
+ */
+void vlc_objects_DumpCensus(vlc_object_t *obj)
+{
+    vlc_mutex_lock(&census_lock);
+    for (const struct vlc_object_census *slot = census_list; slot != NULL;
+         slot = slot->next)
+    {
+        uintmax_t count = atomic_load_explicit(&slot->count,
+                                               memory_order_relaxed);
+        if (count > 0)
+            msg_Dbg(obj, "%4ju live object(s) of type \"%s\"", count,
+                    slot->typename);
+    }
+    vlc_mutex_unlock(&census_lock);
+}
+
 int vlc_object_init(vlc_object_t *restrict obj, vlc_object_t *parent,
                     const char *typename)
 {
@@ -66,11 +131,23 @@ int vlc_object_init(vlc_object_t *restrict obj, vlc_object_t *parent,
         return -1;
 
     priv->parent = parent;
+    /* The root of the tree is the object without a parent (see
+     * libvlc_InternalCreate()), so the cached instance pointer can be
+     * inherited rather than recomputed by walking the parent chain. */
+    priv->libvlc = (parent != NULL) ? vlc_internals(parent)->libvlc
+                                    : (libvlc_int_t *)obj;
     priv->typename = typename;
     priv->var_root = NULL;
     vlc_mutex_init (&priv->var_lock);
+    atomic_init (&priv->var_snapshot, NULL);
     priv->resources = NULL;
 
+    /* On allocation failure, the object simply goes uncounted. */
+    priv->census = vlc_census_slot((typename != NULL) ? typename : "generic");
+    if (likely(priv->census != NULL))
+        atomic_fetch_add_explicit(&priv->census->count, 1,
+                                  memory_order_relaxed);
+
     obj->priv = priv;
     obj->force = false;
 
@@ -116,6 +193,11 @@ vlc_object_t *(vlc_object_parent)(vlc_object_t *obj)
     return vlc_internals(obj)->parent;
 }
 
+libvlc_int_t *(vlc_object_instance)(vlc_object_t *obj)
+{
+    return vlc_internals(obj)->libvlc;
+}
+
 struct vlc_tracer *vlc_object_get_tracer(vlc_object_t *obj)
 {
     libvlc_int_t *vlc = vlc_object_instance(obj);
@@ -129,6 +211,10 @@ void vlc_object_deinit(vlc_object_t *obj)
 
     assert(priv->resources == NULL);
 
+    if (likely(priv->census != NULL))
+        atomic_fetch_sub_explicit(&priv->census->count, 1,
+                                  memory_order_relaxed);
+
     /* Destroy the associated variables. */
     int canc = vlc_savecancel();
     var_DestroyAll(obj);
@@ -484,21 +484,16 @@ picture_AttachAncillary(picture_t *pic, struct vlc_ancillary *ancillary)
 void *
 picture_AttachNewAncillary(picture_t *pic, vlc_ancillary_id id, size_t size)
 {
-    void *data = malloc(size);
-    if (!data)
+    struct vlc_ancillary *ancillary = vlc_ancillary_CreateWithSize(id, size);
+    if (!ancillary)
         return NULL;
 
-    struct vlc_ancillary *ancillary = vlc_ancillary_Create(data, id);
-    if (!ancillary) {
-        free(data);
-        return NULL;
-    }
-
     if (picture_AttachAncillary(pic, ancillary) != 0) {
         vlc_ancillary_Release(ancillary);
         return NULL;
     }
 
+    void *data = vlc_ancillary_GetData(ancillary);
     vlc_ancillary_Release(ancillary);
 
     return data;
@@ -29,6 +29,7 @@
 # include "config.h"
 #endif
 #include <assert.h>
+#include <stdatomic.h>
 
 #include <vlc_common.h>
 #include <vlc_picture_fifo.h>
@@ -36,9 +37,36 @@
 /*****************************************************************************
  *
  *****************************************************************************/
+
+/* Ring size of the lock-free SPSC variant. Must be a power of two, and
+ * comfortably larger than any decoder/display picture pool, so that the
+ * locked overflow path is effectively never taken. */
+#define PICTURE_FIFO_SPSC_SIZE 64
+
 struct picture_fifo_t {
     vlc_mutex_t lock;
     vlc_picture_chain_t pics;
+
+    /**
+     * Lock-free SPSC ring (NULL for the mutex variant).
+     *
+     * The producer owns write_idx, the consumer owns read_idx; each reads
+     * the index of the other side with acquire semantics. Should the ring
+     * ever fill up, pictures overflow into the mutex-protected chain and
+     * keep doing so until the chain has drained back to empty, so arrival
+     * order is preserved; the consumer only looks at the chain when the
+     * overflow counter is non-zero, so the common paths never touch the
+     * mutex.
+     */
+    picture_t **ring;
+    atomic_uint read_idx;
+    atomic_uint write_idx;
+    atomic_uint overflow;
+
+    /** Consumer-only chain of pictures kept back by a filtered flush */
+    vlc_picture_chain_t pending;
+    /** Number of pictures in pending, so IsEmpty() works from any thread */
+    atomic_uint pending_count;
 };
 
 static void PictureFifoReset(picture_fifo_t *fifo)
@@ -62,18 +90,112 @@ picture_fifo_t *picture_fifo_New(void)
         return NULL;
 
     vlc_mutex_init(&fifo->lock);
+    fifo->ring = NULL;
     PictureFifoReset(fifo);
     return fifo;
 }
 
+picture_fifo_t *picture_fifo_NewSPSC(void)
+{
+    picture_fifo_t *fifo = picture_fifo_New();
+    if (!fifo)
+        return NULL;
+
+    fifo->ring = vlc_alloc(PICTURE_FIFO_SPSC_SIZE, sizeof (*fifo->ring));
+    if (!fifo->ring) {
+        /* Downgrade to the mutex variant rather than failing */
+        return fifo;
+    }
+
+    atomic_init(&fifo->read_idx, 0);
+    atomic_init(&fifo->write_idx, 0);
+    atomic_init(&fifo->overflow, 0);
+    vlc_picture_chain_Init(&fifo->pending);
+    atomic_init(&fifo->pending_count, 0);
+    return fifo;
+}
+
 void picture_fifo_Push(picture_fifo_t *fifo, picture_t *picture)
 {
+    if (fifo->ring != NULL) {
+        assert(!picture_HasChainedPics(picture));
+
+        /* While pictures sit in the overflow chain, newer ones must keep
+         * going there as well: the consumer drains the ring before the
+         * chain, so using the ring again would let them overtake the
+         * overflowed ones. Only this thread ever increments the counter,
+         * so a relaxed read cannot miss its own overflows. */
+        if (likely(atomic_load_explicit(&fifo->overflow,
+                                        memory_order_relaxed) == 0)) {
+            unsigned write_idx = atomic_load_explicit(&fifo->write_idx,
+                                                      memory_order_relaxed);
+            unsigned read_idx = atomic_load_explicit(&fifo->read_idx,
+                                                     memory_order_acquire);
+            if (likely(write_idx - read_idx < PICTURE_FIFO_SPSC_SIZE)) {
+                fifo->ring[write_idx % PICTURE_FIFO_SPSC_SIZE] = picture;
+                atomic_store_explicit(&fifo->write_idx, write_idx + 1,
+                                      memory_order_release);
+                return;
+            }
+        }
+
+        /* Ring full, or still draining an earlier overflow: append to the
+         * locked chain. The counter is bumped before the consumer can pop
+         * the ring entries again, so it cannot miss the overflowed
+         * pictures. */
+        vlc_mutex_lock(&fifo->lock);
+        PictureFifoPush(fifo, picture);
+        atomic_fetch_add_explicit(&fifo->overflow, 1, memory_order_release);
+        vlc_mutex_unlock(&fifo->lock);
+        return;
+    }
+
     vlc_mutex_lock(&fifo->lock);
     PictureFifoPush(fifo, picture);
     vlc_mutex_unlock(&fifo->lock);
 }
+
+/* Pop from the SPSC ring proper (not the pending/overflow chains). */
+static picture_t *PictureFifoPopRing(picture_fifo_t *fifo)
+{
+    unsigned read_idx = atomic_load_explicit(&fifo->read_idx,
+                                             memory_order_relaxed);
+    unsigned write_idx = atomic_load_explicit(&fifo->write_idx,
+                                              memory_order_acquire);
+    if (read_idx == write_idx)
+        return NULL;
+
+    picture_t *picture = fifo->ring[read_idx % PICTURE_FIFO_SPSC_SIZE];
+    atomic_store_explicit(&fifo->read_idx, read_idx + 1,
+                          memory_order_release);
+    return picture;
+}
+
 picture_t *picture_fifo_Pop(picture_fifo_t *fifo)
 {
+    if (fifo->ring != NULL) {
+        picture_t *picture = vlc_picture_chain_PopFront(&fifo->pending);
+        if (picture != NULL) {
+            atomic_fetch_sub_explicit(&fifo->pending_count, 1,
+                                      memory_order_relaxed);
+            return picture;
+        }
+
+        picture = PictureFifoPopRing(fifo);
+        if (picture != NULL)
+            return picture;
+
+        if (atomic_load_explicit(&fifo->overflow, memory_order_acquire) > 0) {
+            vlc_mutex_lock(&fifo->lock);
+            picture = PictureFifoPop(fifo);
+            if (picture != NULL)
+                atomic_fetch_sub_explicit(&fifo->overflow, 1,
+                                          memory_order_relaxed);
+            vlc_mutex_unlock(&fifo->lock);
+        }
+        return picture;
+    }
+
     vlc_mutex_lock(&fifo->lock);
     picture_t *picture = PictureFifoPop(fifo);
     vlc_mutex_unlock(&fifo->lock);
@@ -82,6 +204,20 @@ picture_t *picture_fifo_Pop(picture_fifo_t *fifo)
 }
 bool picture_fifo_IsEmpty(picture_fifo_t *fifo)
 {
+    if (fifo->ring != NULL) {
+        if (atomic_load_explicit(&fifo->pending_count,
+                                 memory_order_acquire) > 0)
+            return false;
+        if (atomic_load_explicit(&fifo->overflow, memory_order_acquire) > 0)
+            return false;
+
+        unsigned read_idx = atomic_load_explicit(&fifo->read_idx,
+                                                 memory_order_relaxed);
+        unsigned write_idx = atomic_load_explicit(&fifo->write_idx,
+                                                  memory_order_acquire);
+        return read_idx == write_idx;
+    }
+
     vlc_mutex_lock(&fifo->lock);
     bool empty = vlc_picture_chain_IsEmpty( &fifo->pics );
     vlc_mutex_unlock(&fifo->lock);
@@ -96,24 +232,60 @@ void picture_fifo_Flush(picture_fifo_t *fifo, vlc_tick_t date, bool flush_before
 
     vlc_picture_chain_Init(&flush_chain);
 
-    vlc_mutex_lock(&fifo->lock);
-    if (date == VLC_TICK_INVALID)
-        vlc_picture_chain_GetAndClear(&fifo->pics, &flush_chain);
-    else {
+    if (fifo->ring != NULL) {
+        /* Drain everything queued so far into a consumer-local chain;
+         * pictures to keep go back to the consumer-only pending chain,
+         * preserving their order, so the producer side is never touched. */
         vlc_picture_chain_t filter_chain;
-        vlc_picture_chain_GetAndClear(&fifo->pics, &filter_chain);
+        vlc_picture_chain_Init(&filter_chain);
+
+        vlc_picture_chain_GetAndClear(&fifo->pending, &filter_chain);
+        atomic_store_explicit(&fifo->pending_count, 0, memory_order_relaxed);
+        while ((picture = PictureFifoPopRing(fifo)) != NULL)
+            vlc_picture_chain_Append(&filter_chain, picture);
+        if (atomic_load_explicit(&fifo->overflow, memory_order_acquire) > 0) {
+            vlc_mutex_lock(&fifo->lock);
+            while ((picture = PictureFifoPop(fifo)) != NULL) {
+                atomic_fetch_sub_explicit(&fifo->overflow, 1,
+                                          memory_order_relaxed);
+                vlc_picture_chain_Append(&filter_chain, picture);
+            }
+            vlc_mutex_unlock(&fifo->lock);
+        }
 
-        while ( !vlc_picture_chain_IsEmpty( &filter_chain ) ) {
-            picture = vlc_picture_chain_PopFront( &filter_chain );
+        while (!vlc_picture_chain_IsEmpty(&filter_chain)) {
+            picture = vlc_picture_chain_PopFront(&filter_chain);
 
-            if (( flush_before && picture->date <= date) ||
+            if (date == VLC_TICK_INVALID ||
+                ( flush_before && picture->date <= date) ||
                 (!flush_before && picture->date >= date))
-                vlc_picture_chain_Append( &flush_chain, picture );
-            else
-                PictureFifoPush(fifo, picture);
+                vlc_picture_chain_Append(&flush_chain, picture);
+            else {
+                vlc_picture_chain_Append(&fifo->pending, picture);
+                atomic_fetch_add_explicit(&fifo->pending_count, 1,
+                                          memory_order_release);
+            }
         }
+    } else {
+        vlc_mutex_lock(&fifo->lock);
+        if (date == VLC_TICK_INVALID)
+            vlc_picture_chain_GetAndClear(&fifo->pics, &flush_chain);
+        else {
+            vlc_picture_chain_t filter_chain;
+            vlc_picture_chain_GetAndClear(&fifo->pics, &filter_chain);
+
+            while ( !vlc_picture_chain_IsEmpty( &filter_chain ) ) {
+                picture = vlc_picture_chain_PopFront( &filter_chain );
+
+                if (( flush_before && picture->date <= date) ||
+                    (!flush_before && picture->date >= date))
+                    vlc_picture_chain_Append( &flush_chain, picture );
+                else
+                    PictureFifoPush(fifo, picture);
+            }
+        }
+        vlc_mutex_unlock(&fifo->lock);
     }
-    vlc_mutex_unlock(&fifo->lock);
 
     while ((picture = vlc_picture_chain_PopFront(&flush_chain)) != NULL)
         picture_Release(picture);
@@ -121,5 +293,6 @@ void picture_fifo_Flush(picture_fifo_t *fifo, vlc_tick_t date, bool flush_before
 void picture_fifo_Delete(picture_fifo_t *fifo)
 {
     picture_fifo_Flush(fifo, VLC_TICK_INVALID, true);
+    free(fifo->ring);
     free(fifo);
 }
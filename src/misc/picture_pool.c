@@ -34,18 +34,34 @@
 #include <vlc_picture_pool.h>
 #include <vlc_atomic.h>
 #include "picture.h"
+#include "../libvlc.h" /* for vlc_picture_PoolDumpStats() */
 
 #define POOL_MAX (CHAR_BIT * sizeof (unsigned long long))
 
 static_assert ((POOL_MAX & (POOL_MAX - 1)) == 0, "Not a power of two");
 
+/* Process-wide pool usage for vlc_picture_PoolDumpStats(). Pools are owned
+ * by their respective video outputs and cannot be enumerated from here, so
+ * aggregate counters are maintained instead; relaxed ordering is fine for
+ * monotonic bookkeeping that is only ever read for display. */
+static atomic_size_t pool_live_count = 0;
+static atomic_size_t pool_picture_count = 0;
+static atomic_size_t pool_lent_count = 0;
+
 struct picture_pool_t {
     vlc_mutex_t lock;
     vlc_cond_t  wait;
 
     unsigned long long available;
+    unsigned long long allocated;
     vlc_atomic_rc_t    refs;
     unsigned short     picture_count;
+    unsigned short     max_count;
+    unsigned short     target_count;
+    bool               growable;
+    video_format_t     fmt;
+    vlc_tick_t         wait_length;
+    unsigned           starved_count;
     picture_t  *picture[];
 };
 
@@ -54,13 +70,25 @@ static void picture_pool_Destroy(picture_pool_t *pool)
     if (!vlc_atomic_rc_dec(&pool->refs))
         return;
 
+    atomic_fetch_sub_explicit(&pool_live_count, 1, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&pool_picture_count, pool->picture_count,
+                              memory_order_relaxed);
+
+    if (pool->growable)
+        video_format_Clean(&pool->fmt);
     aligned_free(pool);
 }
 
 void picture_pool_Release(picture_pool_t *pool)
 {
-    for (unsigned i = 0; i < pool->picture_count; i++)
+    unsigned long long allocated = pool->allocated;
+
+    while (allocated != 0) {
+        int i = ctz(allocated);
+
+        allocated &= ~(1ULL << i);
         picture_Release(pool->picture[i]);
+    }
     picture_pool_Destroy(pool);
 }
 
@@ -76,13 +104,45 @@ static void picture_pool_ReleaseClone(picture_t *clone)
 
     vlc_mutex_lock(&pool->lock);
     assert(!(pool->available & (1ULL << offset)));
-    pool->available |= 1ULL << offset;
-    vlc_cond_signal(&pool->wait);
+    if (pool->picture_count > pool->target_count) {
+        /* Shrink back toward the target size once the burst is over. */
+        picture_Release(pool->picture[offset]);
+        pool->picture[offset] = NULL;
+        pool->allocated &= ~(1ULL << offset);
+        pool->picture_count--;
+        atomic_fetch_sub_explicit(&pool_picture_count, 1,
+                                  memory_order_relaxed);
+    } else {
+        pool->available |= 1ULL << offset;
+        vlc_cond_signal(&pool->wait);
+    }
     vlc_mutex_unlock(&pool->lock);
 
+    atomic_fetch_sub_explicit(&pool_lent_count, 1, memory_order_relaxed);
     picture_pool_Destroy(pool);
 }
 
+/** Allocates an extra picture, within the pool size budget.
+ * The pool lock must be held. */
+static bool picture_pool_GrowLocked(picture_pool_t *pool)
+{
+    if (pool->picture_count >= pool->max_count)
+        return false;
+    assert(pool->growable);
+
+    int i = ctz(~pool->allocated);
+    picture_t *picture = picture_NewFromFormat(&pool->fmt);
+    if (picture == NULL)
+        return false;
+
+    pool->picture[i] = picture;
+    pool->allocated |= 1ULL << i;
+    pool->available |= 1ULL << i;
+    pool->picture_count++;
+    atomic_fetch_add_explicit(&pool_picture_count, 1, memory_order_relaxed);
+    return true;
+}
+
 static picture_t *picture_pool_ClonePicture(picture_pool_t *pool,
                                             unsigned offset)
 {
@@ -94,17 +154,18 @@ static picture_t *picture_pool_ClonePicture(picture_pool_t *pool,
     if (clone != NULL) {
         assert(!picture_HasChainedPics(clone));
         vlc_atomic_rc_inc(&pool->refs);
+        atomic_fetch_add_explicit(&pool_lent_count, 1, memory_order_relaxed);
     }
     return clone;
 }
 
-picture_pool_t *picture_pool_New(unsigned count, picture_t *const *tab)
+static picture_pool_t *picture_pool_Alloc(unsigned count, unsigned slots,
+                                          picture_t *const *tab)
 {
-    if (unlikely(count > POOL_MAX))
-        return NULL;
+    assert(count <= slots && slots <= POOL_MAX);
 
     picture_pool_t *pool;
-    size_t size = sizeof (*pool) + count * sizeof (picture_t *);
+    size_t size = sizeof (*pool) + slots * sizeof (picture_t *);
 
     size += (-size) & (POOL_MAX - 1);
     pool = aligned_alloc(POOL_MAX, size);
@@ -117,12 +178,30 @@ picture_pool_t *picture_pool_New(unsigned count, picture_t *const *tab)
         pool->available = ~0ULL;
     else
         pool->available = (1ULL << count) - 1;
+    pool->allocated = pool->available;
     vlc_atomic_rc_init(&pool->refs);
     pool->picture_count = count;
+    pool->max_count = count;
+    pool->target_count = count;
+    pool->growable = false;
+    pool->wait_length = 0;
+    pool->starved_count = 0;
     memcpy(pool->picture, tab, count * sizeof (picture_t *));
+
+    atomic_fetch_add_explicit(&pool_live_count, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&pool_picture_count, count,
+                              memory_order_relaxed);
     return pool;
 }
 
+picture_pool_t *picture_pool_New(unsigned count, picture_t *const *tab)
+{
+    if (unlikely(count > POOL_MAX))
+        return NULL;
+
+    return picture_pool_Alloc(count, count, tab);
+}
+
 picture_pool_t *picture_pool_NewFromFormat(const video_format_t *fmt,
                                            unsigned count)
 {
@@ -152,6 +231,45 @@ error:
     return NULL;
 }
 
+picture_pool_t *picture_pool_NewGrowable(const video_format_t *fmt,
+                                         unsigned count, unsigned max_count)
+{
+    if (count == 0 || max_count < count)
+        vlc_assert_unreachable();
+    if (unlikely(count > POOL_MAX))
+        return NULL;
+    if (max_count > POOL_MAX)
+        max_count = POOL_MAX;
+
+    picture_t *picture[POOL_MAX];
+    unsigned i;
+
+    for (i = 0; i < count; i++) {
+        picture[i] = picture_NewFromFormat(fmt);
+        if (picture[i] == NULL)
+            goto error;
+    }
+
+    /* Reserve all the slots up front: the pool address is baked into the
+     * clones, so the array can never be reallocated when growing. */
+    picture_pool_t *pool = picture_pool_Alloc(count, max_count, picture);
+    if (!pool)
+        goto error;
+
+    if (video_format_Copy(&pool->fmt, fmt) != VLC_SUCCESS) {
+        picture_pool_Release(pool);
+        return NULL;
+    }
+    pool->growable = true;
+    pool->max_count = max_count;
+    return pool;
+
+error:
+    while (i > 0)
+        picture_Release(picture[--i]);
+    return NULL;
+}
+
 picture_pool_t *picture_pool_Reserve(picture_pool_t *master, unsigned count)
 {
     if (count == 0)
@@ -186,8 +304,9 @@ picture_t *picture_pool_Get(picture_pool_t *pool)
     vlc_mutex_lock(&pool->lock);
     assert(vlc_atomic_rc_get(&pool->refs) > 0);
 
-    if (pool->available == 0)
+    if (pool->available == 0 && !picture_pool_GrowLocked(pool))
     {
+        pool->starved_count++;
         vlc_mutex_unlock(&pool->lock);
         return NULL;
     }
@@ -204,8 +323,14 @@ picture_t *picture_pool_Wait(picture_pool_t *pool)
     vlc_mutex_lock(&pool->lock);
     assert(vlc_atomic_rc_get(&pool->refs) > 0);
 
-    while (pool->available == 0)
-        vlc_cond_wait(&pool->wait, &pool->lock);
+    if (pool->available == 0 && !picture_pool_GrowLocked(pool)) {
+        vlc_tick_t start = vlc_tick_now();
+
+        pool->starved_count++;
+        while (pool->available == 0)
+            vlc_cond_wait(&pool->wait, &pool->lock);
+        pool->wait_length += vlc_tick_now() - start;
+    }
 
     int i = ctz(pool->available);
     pool->available &= ~(1ULL << i);
@@ -218,3 +343,32 @@ unsigned picture_pool_GetSize(const picture_pool_t *pool)
 {
     return pool->picture_count;
 }
+
+void picture_pool_GetResetStats(picture_pool_t *pool, unsigned *restrict count,
+                                unsigned *restrict in_use,
+                                unsigned *restrict starved,
+                                vlc_tick_t *restrict waited)
+{
+    vlc_mutex_lock(&pool->lock);
+    *count = pool->picture_count;
+    *in_use = pool->picture_count - vlc_popcount(pool->available);
+    *starved = pool->starved_count;
+    *waited = pool->wait_length;
+    pool->starved_count = 0;
+    pool->wait_length = 0;
+    vlc_mutex_unlock(&pool->lock);
+}
+
+void vlc_picture_PoolDumpStats(vlc_object_t *obj)
+{
+    size_t pools = atomic_load_explicit(&pool_live_count,
+                                        memory_order_relaxed);
+    size_t pictures = atomic_load_explicit(&pool_picture_count,
+                                           memory_order_relaxed);
+    size_t lent = atomic_load_explicit(&pool_lent_count,
+                                       memory_order_relaxed);
+
+    if (pools > 0)
+        msg_Dbg(obj, "picture pools: %zu pool(s) holding %zu picture(s), "
+                "%zu in use", pools, pictures, lent);
+}
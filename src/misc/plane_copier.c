@@ -0,0 +1,231 @@
+/*****************************************************************************
+ * misc/plane_copier.c: multithreaded picture plane copy
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+
+#include <vlc_common.h>
+#include <vlc_picture.h>
+#include <vlc_threads.h>
+#include <vlc_cpu.h>
+
+/* Spawning a thread per core gives diminishing returns: the copy is memory
+ * bound and saturates the bus long before that. */
+#define PLANE_COPIER_MAX_AUTO_WORKERS 4
+
+/* Below this many lines in the largest plane, the synchronization overhead
+ * is not worth slicing the copy. */
+#define PLANE_COPIER_MIN_LINES 256
+
+struct vlc_plane_copier {
+    vlc_mutex_t lock;
+
+    /** Wait for a new job (generation bump) or closing */
+    vlc_cond_t job_wait;
+
+    /** Wait for the current job completion (busy == 0) */
+    vlc_cond_t done_wait;
+
+    /** Total number of workers, including the calling thread */
+    unsigned nb_workers;
+
+    /** Incremented for each vlc_plane_copier_Run() call */
+    unsigned generation;
+
+    /** Next slice index to hand out, counting down */
+    unsigned pending;
+
+    /** Number of slices handed out but not completed */
+    unsigned busy;
+
+    /** Current job */
+    void (*work)(void *, unsigned, unsigned);
+    void *opaque;
+
+    /** True once deletion is requested */
+    bool closing;
+
+    /** nb_workers - 1 spawned threads */
+    vlc_thread_t threads[];
+};
+
+static void *WorkerThread(void *userdata)
+{
+    vlc_plane_copier_t *copier = userdata;
+    unsigned generation = 0;
+
+    vlc_thread_set_name("vlc-plane-copy");
+
+    vlc_mutex_lock(&copier->lock);
+    for (;;)
+    {
+        while (!copier->closing && copier->generation == generation)
+            vlc_cond_wait(&copier->job_wait, &copier->lock);
+
+        if (copier->closing)
+            break;
+
+        generation = copier->generation;
+        assert(copier->pending > 0);
+        unsigned slice = --copier->pending;
+        void (*work)(void *, unsigned, unsigned) = copier->work;
+        void *opaque = copier->opaque;
+        vlc_mutex_unlock(&copier->lock);
+
+        work(opaque, slice, copier->nb_workers);
+
+        vlc_mutex_lock(&copier->lock);
+        assert(copier->busy > 0);
+        if (--copier->busy == 0)
+            vlc_cond_signal(&copier->done_wait);
+    }
+    vlc_mutex_unlock(&copier->lock);
+
+    return NULL;
+}
+
+vlc_plane_copier_t *vlc_plane_copier_New(unsigned nb_workers)
+{
+    if (nb_workers == 0)
+        nb_workers = __MIN(vlc_GetCPUCount(), PLANE_COPIER_MAX_AUTO_WORKERS);
+
+    vlc_plane_copier_t *copier =
+        malloc(sizeof (*copier) + (nb_workers - 1) * sizeof (vlc_thread_t));
+    if (unlikely(copier == NULL))
+        return NULL;
+
+    vlc_mutex_init(&copier->lock);
+    vlc_cond_init(&copier->job_wait);
+    vlc_cond_init(&copier->done_wait);
+    copier->generation = 0;
+    copier->pending = 0;
+    copier->busy = 0;
+    copier->closing = false;
+
+    /* The calling thread is a worker, so failing to spawn threads only
+     * degrades parallelism. */
+    unsigned spawned;
+    for (spawned = 0; spawned + 1 < nb_workers; spawned++)
+        if (vlc_clone(&copier->threads[spawned], WorkerThread, copier))
+            break;
+
+    copier->nb_workers = spawned + 1;
+    return copier;
+}
+
+void vlc_plane_copier_Delete(vlc_plane_copier_t *copier)
+{
+    vlc_mutex_lock(&copier->lock);
+    assert(copier->busy == 0);
+    copier->closing = true;
+    vlc_cond_broadcast(&copier->job_wait);
+    vlc_mutex_unlock(&copier->lock);
+
+    for (unsigned i = 0; i + 1 < copier->nb_workers; i++)
+        vlc_join(copier->threads[i], NULL);
+
+    free(copier);
+}
+
+unsigned vlc_plane_copier_GetWorkerCount(const vlc_plane_copier_t *copier)
+{
+    return copier->nb_workers;
+}
+
+void vlc_plane_copier_Run(vlc_plane_copier_t *copier,
+                          void (*work)(void *, unsigned, unsigned),
+                          void *opaque)
+{
+    const unsigned nb_workers = copier->nb_workers;
+
+    if (nb_workers > 1)
+    {
+        vlc_mutex_lock(&copier->lock);
+        assert(copier->busy == 0);
+        copier->work = work;
+        copier->opaque = opaque;
+        copier->pending = nb_workers - 1;
+        copier->busy = nb_workers - 1;
+        copier->generation++;
+        vlc_cond_broadcast(&copier->job_wait);
+        vlc_mutex_unlock(&copier->lock);
+    }
+
+    /* The last slice runs on the calling thread */
+    work(opaque, nb_workers - 1, nb_workers);
+
+    if (nb_workers > 1)
+    {
+        vlc_mutex_lock(&copier->lock);
+        while (copier->busy > 0)
+            vlc_cond_wait(&copier->done_wait, &copier->lock);
+        vlc_mutex_unlock(&copier->lock);
+    }
+}
+
+struct plane_copy_job {
+    picture_t *dst;
+    const picture_t *src;
+};
+
+static void CopyPixelsSlice(void *opaque, unsigned slice, unsigned count)
+{
+    const struct plane_copy_job *job = opaque;
+
+    for (int i = 0; i < job->src->i_planes; i++)
+    {
+        plane_t dst = job->dst->p[i];
+        plane_t src = job->src->p[i];
+        const int lines = __MIN(dst.i_visible_lines, src.i_visible_lines);
+        const int first = (int)((int64_t)lines * slice / count);
+        const int last = (int)((int64_t)lines * (slice + 1) / count);
+
+        if (last <= first)
+            continue;
+
+        dst.p_pixels += (size_t)first * dst.i_pitch;
+        dst.i_lines = dst.i_visible_lines = last - first;
+        src.p_pixels += (size_t)first * src.i_pitch;
+        src.i_lines = src.i_visible_lines = last - first;
+
+        plane_CopyPixels(&dst, &src);
+    }
+}
+
+void vlc_plane_copier_CopyPixels(vlc_plane_copier_t *copier,
+                                 picture_t *p_dst, const picture_t *p_src)
+{
+    struct plane_copy_job job = { p_dst, p_src };
+
+    if (copier->nb_workers > 1 &&
+        p_src->p[0].i_visible_lines >= PLANE_COPIER_MIN_LINES)
+        vlc_plane_copier_Run(copier, CopyPixelsSlice, &job);
+    else
+        for (int i = 0; i < p_src->i_planes; i++)
+            plane_CopyPixels(p_dst->p + i, p_src->p + i);
+
+    assert(p_dst->context == NULL);
+
+    if (p_src->context != NULL)
+        p_dst->context = p_src->context->copy(p_src->context);
+}
@@ -23,18 +23,156 @@
 # include <config.h>
 #endif
 
+#include <stdint.h>
+#include <string.h>
+
 #include <vlc_common.h>
 #include <vlc_sort.h>
 
-static thread_local struct
+/*
+ * Introspective sort: median-of-three quicksort, switching to insertion sort
+ * on small partitions and to heapsort when the recursion depth shows that the
+ * pivots are being defeated. This guarantees O(n log n) in the worst case and
+ * passes the comparison context natively, unlike the previous implementation
+ * which trampolined qsort() through thread-local state.
+ */
+
+/* Below this partition length, insertion sort wins */
+#define SORT_INSERTION_MAX 24
+
+struct sort_ctx
 {
+    size_t size; /**< size of one element */
     int (*compar)(const void *, const void *, void *);
     void *arg;
-} state;
+};
+
+static void sort_swap(char *a, char *b, size_t size)
+{
+    while (size >= sizeof (uintptr_t))
+    {
+        uintptr_t t;
+
+        memcpy(&t, a, sizeof (t));
+        memcpy(a, b, sizeof (t));
+        memcpy(b, &t, sizeof (t));
+        a += sizeof (t);
+        b += sizeof (t);
+        size -= sizeof (t);
+    }
+    while (size-- > 0)
+    {
+        char t = *a;
+
+        *a++ = *b;
+        *b++ = t;
+    }
+}
+
+static void sort_insertion(char *base, size_t nmemb,
+                           const struct sort_ctx *ctx)
+{
+    const size_t size = ctx->size;
+
+    for (size_t i = 1; i < nmemb; i++)
+        for (size_t j = i;
+             j > 0 && ctx->compar(base + j * size, base + (j - 1) * size,
+                                  ctx->arg) < 0; j--)
+            sort_swap(base + j * size, base + (j - 1) * size, size);
+}
+
+static void sort_sift_down(char *base, size_t root, size_t end,
+                           const struct sort_ctx *ctx)
+{
+    const size_t size = ctx->size;
 
-static int compar_wrapper(const void *a, const void *b)
+    for (;;)
+    {
+        size_t child = 2 * root + 1;
+
+        if (child >= end)
+            break;
+        if (child + 1 < end
+         && ctx->compar(base + child * size, base + (child + 1) * size,
+                        ctx->arg) < 0)
+            child++;
+        if (ctx->compar(base + root * size, base + child * size,
+                        ctx->arg) >= 0)
+            break;
+        sort_swap(base + root * size, base + child * size, size);
+        root = child;
+    }
+}
+
+static void sort_heap(char *base, size_t nmemb, const struct sort_ctx *ctx)
+{
+    const size_t size = ctx->size;
+
+    for (size_t start = nmemb / 2; start-- > 0;)
+        sort_sift_down(base, start, nmemb, ctx);
+    for (size_t end = nmemb; end-- > 1;)
+    {
+        sort_swap(base, base + end * size, size);
+        sort_sift_down(base, 0, end, ctx);
+    }
+}
+
+static void sort_intro(char *base, size_t nmemb, unsigned budget,
+                       const struct sort_ctx *ctx)
 {
-    return state.compar(a, b, state.arg);
+    const size_t size = ctx->size;
+
+    while (nmemb > SORT_INSERTION_MAX)
+    {
+        if (budget-- == 0)
+        {   /* Pathological pivots (sorted runs, duplicates, crafted input):
+             * finish in guaranteed O(n log n) */
+            sort_heap(base, nmemb, ctx);
+            return;
+        }
+
+        /* Median of first, middle and last element as the pivot, moved to
+         * the last slot so it stays put during the partition scan */
+        char *lo = base;
+        char *mid = base + (nmemb / 2) * size;
+        char *hi = base + (nmemb - 1) * size;
+
+        if (ctx->compar(mid, lo, ctx->arg) < 0)
+            sort_swap(mid, lo, size);
+        if (ctx->compar(hi, mid, ctx->arg) < 0)
+            sort_swap(hi, mid, size);
+        if (ctx->compar(mid, lo, ctx->arg) < 0)
+            sort_swap(mid, lo, size);
+        sort_swap(mid, hi, size);
+
+        size_t store = 0;
+
+        for (size_t i = 0; i < nmemb - 1; i++)
+            if (ctx->compar(base + i * size, hi, ctx->arg) < 0)
+            {
+                if (i != store)
+                    sort_swap(base + i * size, base + store * size, size);
+                store++;
+            }
+        sort_swap(base + store * size, hi, size);
+
+        /* Recurse into the smaller partition, iterate on the larger one,
+         * to bound the stack depth to O(log n) */
+        size_t right = nmemb - store - 1;
+
+        if (store < right)
+        {
+            sort_intro(base, store, budget, ctx);
+            base += (store + 1) * size;
+            nmemb = right;
+        }
+        else
+        {
+            sort_intro(base + (store + 1) * size, right, budget, ctx);
+            nmemb = store;
+        }
+    }
+    sort_insertion(base, nmemb, ctx);
 }
 
 /* Follow the upcoming POSIX prototype, coming from GNU/libc.
@@ -44,15 +182,15 @@ VLC_WEAK void vlc_qsort(void *base, size_t nmemb, size_t size,
                         int (*compar)(const void *, const void *, void *),
                         void *arg)
 {
-    int (*saved_compar)(const void *, const void *, void *) = state.compar;
-    void *saved_arg = state.arg;
+    if (nmemb < 2 || size == 0)
+        return;
 
-    state.compar = compar;
-    state.arg = arg;
+    struct sort_ctx ctx = { size, compar, arg };
 
-    qsort(base, nmemb, size, compar_wrapper);
+    /* 2 * log2(nmemb) levels of bad pivots before heapsort takes over */
+    unsigned budget = 0;
+    for (size_t n = nmemb; n > 1; n >>= 1)
+        budget += 2;
 
-    /* Restore state for nested reentrant calls */
-    state.compar = saved_compar;
-    state.arg = saved_arg;
+    sort_intro(base, nmemb, budget, &ctx);
 }
@@ -26,6 +26,11 @@
 #include <errno.h>
 #include <limits.h>
 #include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef __linux__
+# include <sched.h>
+#endif
 
 #include <vlc_common.h>
 #include <vlc_atomic.h>
@@ -541,3 +546,153 @@ void vlc_once_complete(vlc_once_t *restrict once)
             vlc_assert_unreachable();
     }
 }
+
+/*** Thread placement ***/
+
+int vlc_threads_SetNumaNode(unsigned node)
+{
+#if defined (__linux__)
+    char path[64];
+
+    snprintf(path, sizeof (path),
+             "/sys/devices/system/node/node%u/cpulist", node);
+
+    FILE *stream = fopen(path, "rte");
+    if (stream == NULL)
+        return VLC_EGENERIC;
+
+    char list[256];
+    char *line = fgets(list, sizeof (list), stream);
+
+    fclose(stream);
+    if (line == NULL)
+        return VLC_EGENERIC;
+
+    cpu_set_t set;
+    unsigned count = 0;
+
+    CPU_ZERO(&set);
+
+    for (char *buf, *range = strtok_r(list, ",\n", &buf);
+         range != NULL;
+         range = strtok_r(NULL, ",\n", &buf))
+    {
+        unsigned first, last;
+
+        switch (sscanf(range, "%u-%u", &first, &last))
+        {
+            case 1:
+                last = first;
+                /* fall through */
+            case 2:
+                for (unsigned cpu = first;
+                     cpu <= last && cpu < CPU_SETSIZE; cpu++)
+                {
+                    CPU_SET(cpu, &set);
+                    count++;
+                }
+                break;
+        }
+    }
+
+    if (count == 0 || sched_setaffinity(0, sizeof (set), &set) != 0)
+        return VLC_EGENERIC;
+    return VLC_SUCCESS;
+#else
+    (void) node;
+    return VLC_EGENERIC;
+#endif
+}
+
+/*** Pipeline thread classes ***/
+
+enum vlc_thread_class
+{
+    VLC_THREAD_CLASS_DECODE,
+    VLC_THREAD_CLASS_RENDER,
+    VLC_THREAD_CLASS_AUDIO,
+    VLC_THREAD_CLASS_NETWORK,
+    VLC_THREAD_CLASS_COUNT
+};
+
+static const char vlc_thread_class_names[VLC_THREAD_CLASS_COUNT][8] = {
+    "decode", "render", "audio", "network",
+};
+
+/* Written once by vlc_threads_ReadClassConfig() before the pipeline threads
+ * exist, then only read, from vlc_thread_set_name(). */
+static struct
+{
+    uint64_t cpu_mask;
+    int rt_priority;
+} vlc_thread_classes[VLC_THREAD_CLASS_COUNT];
+
+void vlc_threads_ReadClassConfig(libvlc_int_t *obj)
+{
+    for (unsigned i = 0; i < VLC_THREAD_CLASS_COUNT; i++)
+    {
+        char name[24];
+
+        snprintf(name, sizeof (name), "%s-affinity",
+                 vlc_thread_class_names[i]);
+        vlc_thread_classes[i].cpu_mask = var_InheritInteger(obj, name);
+
+        snprintf(name, sizeof (name), "%s-rt-priority",
+                 vlc_thread_class_names[i]);
+        vlc_thread_classes[i].rt_priority = var_InheritInteger(obj, name);
+    }
+}
+
+void vlc_threads_ApplyClass(const char *name)
+{
+#if defined (__linux__)
+    /* Pipeline threads are recognized by their (prefix of a) name. */
+    static const struct
+    {
+        char prefix[16];
+        enum vlc_thread_class class;
+    } vlc_thread_class_matches[] = {
+        { "vlc-dec",         VLC_THREAD_CLASS_DECODE  },
+        { "vlc-vout",        VLC_THREAD_CLASS_RENDER  },
+        { "vlc-spu",         VLC_THREAD_CLASS_RENDER  },
+        { "vlc-plane-copy",  VLC_THREAD_CLASS_RENDER  },
+        { "vlc-aout",        VLC_THREAD_CLASS_AUDIO   },
+        { "vlc-getaddrinfo", VLC_THREAD_CLASS_NETWORK },
+        { "vlc-httpd",       VLC_THREAD_CLASS_NETWORK },
+        { "vlc-sap",         VLC_THREAD_CLASS_NETWORK },
+    };
+
+    for (size_t i = 0; i < ARRAY_SIZE(vlc_thread_class_matches); i++)
+    {
+        const char *prefix = vlc_thread_class_matches[i].prefix;
+
+        if (strncmp(name, prefix, strlen(prefix)) != 0)
+            continue;
+
+        enum vlc_thread_class class = vlc_thread_class_matches[i].class;
+        uint64_t mask = vlc_thread_classes[class].cpu_mask;
+        int priority = vlc_thread_classes[class].rt_priority;
+
+        if (mask != 0)
+        {
+            cpu_set_t set;
+
+            CPU_ZERO(&set);
+            for (unsigned cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; cpu++)
+                if (mask & (UINT64_C(1) << cpu))
+                    CPU_SET(cpu, &set);
+            sched_setaffinity(0, sizeof (set), &set);
+        }
+
+        if (priority > 0)
+        {
+            struct sched_param param = { .sched_priority = priority };
+
+            sched_setscheduler(0, SCHED_RR, &param);
+        }
+        break;
+    }
+#else
+    (void) name;
+#endif
+}
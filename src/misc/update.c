@@ -40,10 +40,14 @@
 
 #include <assert.h>
 
+#include <sys/stat.h>
+#include <time.h>
+
 #include <vlc_pgpkey.h>
 #include <vlc_stream.h>
 #include <vlc_strings.h>
 #include <vlc_fs.h>
+#include <vlc_configuration.h>
 #include <vlc_dialog.h>
 #include <vlc_interface.h>
 
@@ -85,6 +89,13 @@
 # define UPDATE_VLC_STATUS_URL "http://update.videolan.org/vlc/status" UPDATE_OS_SUFFIX
 #endif
 
+/* An authenticated status file is cached here, so that repeated checks
+ * within a day reuse it instead of hitting the network and redoing the
+ * PGP verification. The cache directory has the same integrity as the
+ * configuration: whoever can tamper with it can already do worse. */
+#define UPDATE_CACHE_FILE "update-status"
+#define UPDATE_CACHE_AGE  (24 * 60 * 60) /* seconds */
+
 #define dialog_FatalWait( p_obj, psz_title, psz_fmt, ... ) \
     vlc_dialog_wait_question( p_obj, VLC_DIALOG_QUESTION_CRITICAL, "OK", NULL, \
                               NULL, psz_title, psz_fmt, ##__VA_ARGS__ );
@@ -171,69 +182,35 @@ static void EmptyRelease( update_t *p_update )
 }
 
 /**
- * Get the update file and parse it
+ * Parse a status file
  * p_update has to be locked when calling this function
  *
  * \param p_update pointer to update struct
- * \return true if the update is valid and authenticated
+ * \param psz_update_data status file content
+ * \return true if the file was well formed
  */
-static bool GetUpdateFile( update_t *p_update )
+static bool ParseStatusFile( update_t *p_update, const char *psz_update_data )
 {
-    stream_t *p_stream = NULL;
-    char *psz_version_line = NULL;
-    char *psz_update_data = NULL;
-
-    p_stream = vlc_stream_NewURL( p_update->p_libvlc, UPDATE_VLC_STATUS_URL );
-    if( !p_stream )
-    {
-        msg_Err( p_update->p_libvlc, "Failed to open %s for reading",
-                 UPDATE_VLC_STATUS_URL );
-        goto error;
-    }
-
-    uint64_t i_read;
-    if( vlc_stream_GetSize( p_stream, &i_read ) || i_read >= UINT16_MAX )
-    {
-        msg_Err(p_update->p_libvlc, "Status file too large");
-        goto error;
-    }
-
-    psz_update_data = malloc( i_read + 1 ); /* terminating '\0' */
-    if( !psz_update_data )
-        goto error;
-
-    if( vlc_stream_Read( p_stream, psz_update_data,
-                         i_read ) != (ssize_t)i_read )
-    {
-        msg_Err( p_update->p_libvlc, "Couldn't download update file %s",
-                UPDATE_VLC_STATUS_URL );
-        goto error;
-    }
-    psz_update_data[i_read] = '\0';
-
-    vlc_stream_Delete( p_stream );
-    p_stream = NULL;
-
     /* first line : version number */
-    char *psz_update_data_parser = psz_update_data;
+    const char *psz_update_data_parser = psz_update_data;
     size_t i_len = strcspn( psz_update_data, "\r\n" );
     psz_update_data_parser += i_len;
     while( *psz_update_data_parser == '\r' || *psz_update_data_parser == '\n' )
         psz_update_data_parser++;
 
-    if( !(psz_version_line = malloc( i_len + 1)) )
-        goto error;
-    strncpy( psz_version_line, psz_update_data, i_len );
-    psz_version_line[i_len] = '\0';
+    char *psz_version_line = strndup( psz_update_data, i_len );
+    if( !psz_version_line )
+        return false;
 
     p_update->release.i_extra = 0;
     int ret = sscanf( psz_version_line, "%i.%i.%i.%i",
                     &p_update->release.i_major, &p_update->release.i_minor,
                     &p_update->release.i_revision, &p_update->release.i_extra);
+    free( psz_version_line );
     if( ret != 3 && ret != 4 )
     {
-            msg_Err( p_update->p_libvlc, "Update version false formatted" );
-            goto error;
+        msg_Err( p_update->p_libvlc, "Update version false formatted" );
+        return false;
     }
 
     /* second line : URL */
@@ -242,14 +219,12 @@ static bool GetUpdateFile( update_t *p_update )
     {
         msg_Err( p_update->p_libvlc, "Update file %s is corrupted: URL missing",
                  UPDATE_VLC_STATUS_URL );
-
-        goto error;
+        return false;
     }
 
-    if( !(p_update->release.psz_url = malloc( i_len + 1)) )
-        goto error;
-    strncpy( p_update->release.psz_url, psz_update_data_parser, i_len );
-    p_update->release.psz_url[i_len] = '\0';
+    p_update->release.psz_url = strndup( psz_update_data_parser, i_len );
+    if( !p_update->release.psz_url )
+        return false;
 
     psz_update_data_parser += i_len;
     while( *psz_update_data_parser == '\r' || *psz_update_data_parser == '\n' )
@@ -262,13 +237,150 @@ static bool GetUpdateFile( update_t *p_update )
         msg_Err( p_update->p_libvlc,
                 "Update file %s is corrupted: description missing",
                 UPDATE_VLC_STATUS_URL );
+        return false;
+    }
+
+    p_update->release.psz_desc = strndup( psz_update_data_parser, i_len );
+    if( !p_update->release.psz_desc )
+        return false;
+
+    return true;
+}
+
+static char *update_CachePath( void )
+{
+    char *psz_cachedir = config_GetUserDir( VLC_CACHE_DIR );
+    if( psz_cachedir == NULL )
+        return NULL;
+    vlc_mkdir( psz_cachedir, 0700 );
+
+    char *psz_path;
+    if( asprintf( &psz_path, "%s" DIR_SEP UPDATE_CACHE_FILE,
+                  psz_cachedir ) == -1 )
+        psz_path = NULL;
+    free( psz_cachedir );
+    return psz_path;
+}
+
+/**
+ * Load a status file from the cache, if it is still fresh.
+ *
+ * \return the status file content, or NULL if absent or stale
+ */
+static char *update_CacheLoad( void )
+{
+    char *psz_path = update_CachePath();
+    if( psz_path == NULL )
+        return NULL;
+
+    char *psz_data = NULL;
+    struct stat st;
+
+    if( vlc_stat( psz_path, &st ) == 0
+     && st.st_size > 0 && st.st_size < UINT16_MAX
+     && time( NULL ) - st.st_mtime <= UPDATE_CACHE_AGE )
+    {
+        FILE *file = vlc_fopen( psz_path, "rb" );
+        if( file != NULL )
+        {
+            psz_data = malloc( st.st_size + 1 );
+            if( psz_data != NULL )
+            {
+                if( fread( psz_data, 1, st.st_size, file )
+                        == (size_t)st.st_size )
+                    psz_data[st.st_size] = '\0';
+                else
+                    FREENULL( psz_data );
+            }
+            fclose( file );
+        }
+    }
+
+    free( psz_path );
+    return psz_data;
+}
+
+/**
+ * Store an authenticated status file in the cache. Best effort: failing
+ * to cache only means the next check downloads again.
+ */
+static void update_CacheStore( const char *psz_data )
+{
+    char *psz_path = update_CachePath();
+    if( psz_path == NULL )
+        return;
+
+    FILE *file = vlc_fopen( psz_path, "wb" );
+    if( file != NULL )
+    {
+        if( fwrite( psz_data, 1, strlen( psz_data ), file )
+                != strlen( psz_data ) )
+            vlc_unlink( psz_path );
+        fclose( file );
+    }
+    free( psz_path );
+}
+
+/**
+ * Get the update file and parse it
+ * p_update has to be locked when calling this function
+ *
+ * \param p_update pointer to update struct
+ * \return true if the update is valid and authenticated
+ */
+static bool GetUpdateFile( update_t *p_update )
+{
+    stream_t *p_stream = NULL;
+    char *psz_update_data = NULL;
+
+    /* Reuse a recently authenticated status file without touching the
+     * network or the signature again */
+    psz_update_data = update_CacheLoad();
+    if( psz_update_data != NULL )
+    {
+        if( ParseStatusFile( p_update, psz_update_data ) )
+        {
+            msg_Dbg( p_update->p_libvlc, "reusing cached update status" );
+            free( psz_update_data );
+            return true;
+        }
+        EmptyRelease( p_update );
+        FREENULL( psz_update_data );
+    }
+
+    p_stream = vlc_stream_NewURL( p_update->p_libvlc, UPDATE_VLC_STATUS_URL );
+    if( !p_stream )
+    {
+        msg_Err( p_update->p_libvlc, "Failed to open %s for reading",
+                 UPDATE_VLC_STATUS_URL );
+        goto error;
+    }
+
+    uint64_t i_read;
+    if( vlc_stream_GetSize( p_stream, &i_read ) || i_read >= UINT16_MAX )
+    {
+        msg_Err(p_update->p_libvlc, "Status file too large");
+        goto error;
+    }
+
+    psz_update_data = malloc( i_read + 1 ); /* terminating '\0' */
+    if( !psz_update_data )
+        goto error;
+
+    if( vlc_stream_Read( p_stream, psz_update_data,
+                         i_read ) != (ssize_t)i_read )
+    {
+        msg_Err( p_update->p_libvlc, "Couldn't download update file %s",
+                UPDATE_VLC_STATUS_URL );
         goto error;
     }
+    psz_update_data[i_read] = '\0';
 
-    if( !(p_update->release.psz_desc = malloc( i_len + 1)) )
+    vlc_stream_Delete( p_stream );
+    p_stream = NULL;
+
+    if( !ParseStatusFile( p_update, psz_update_data ) )
         goto error;
-    strncpy( p_update->release.psz_desc, psz_update_data_parser, i_len );
-    p_update->release.psz_desc[i_len] = '\0';
 
     /* Now that we know the status is valid, we must download its signature
      * to authenticate it */
@@ -365,7 +477,7 @@ static bool GetUpdateFile( update_t *p_update )
     {
         msg_Info( p_update->p_libvlc, "Status file authenticated" );
         free( p_hash );
-        free( psz_version_line );
+        update_CacheStore( psz_update_data );
         free( psz_update_data );
         return true;
     }
@@ -373,7 +485,6 @@ static bool GetUpdateFile( update_t *p_update )
 error:
     if( p_stream )
         vlc_stream_Delete( p_stream );
-    free( psz_version_line );
     free( psz_update_data );
     return false;
 }
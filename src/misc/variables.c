@@ -34,6 +34,7 @@
 #include <float.h>
 #include <math.h>
 #include <limits.h>
+#include <stdatomic.h>
 
 #include <vlc_common.h>
 #include <vlc_arrays.h>
@@ -41,6 +42,7 @@
 #include "libvlc.h"
 #include "variables.h"
 #include "config/configuration.h"
+#include "rcu.h"
 
 typedef struct callback_entry_t
 {
@@ -72,6 +74,9 @@ struct variable_t
     /** The variable's exported value */
     vlc_value_t  val;
 
+    /** Mirror of the value for the wait-free scalar read path */
+    atomic_uint_least64_t cached;
+
     /** The variable display name, mainly for use by the interfaces */
     char *       psz_text;
 
@@ -157,6 +162,97 @@ static variable_t *Lookup( vlc_object_t *obj, const char *psz_name )
     return (pp_var != NULL) ? *pp_var : NULL;
 }
 
+/**
+ * Immutable, RCU-published array of the object variables, sorted by name.
+ *
+ * Writers (var_Create(), var_Destroy()) rebuild and republish the snapshot
+ * under the variables lock, then reclaim the previous one after a grace
+ * period. Readers can thus look up a variable without taking the lock.
+ */
+struct var_snapshot
+{
+    size_t count;
+    variable_t *vars[];
+};
+
+static thread_local void *twalk_ctx;
+
+typedef DECL_ARRAY(variable_t *) variable_array_t;
+
+static void TwalkCollectVars(const void *data, const VISIT which,
+                             const int depth)
+{
+    if (which != postorder && which != leaf)
+        return;
+    (void) depth;
+
+    variable_t *var = *(variable_t *const *)data;
+    variable_array_t *vars = twalk_ctx;
+
+    ARRAY_APPEND(*vars, var);
+}
+
+/**
+ * Publishes an up-to-date snapshot of the variables tree.
+ *
+ * The variables lock must be held. The caller must reclaim the returned
+ * previous snapshot with free() after vlc_rcu_synchronize().
+ */
+static struct var_snapshot *VarSnapshotPublish(vlc_object_internals_t *priv)
+{
+    struct var_snapshot *snap = NULL;
+    variable_array_t vars;
+
+    ARRAY_INIT(vars);
+    twalk_ctx = &vars;
+    twalk(priv->var_root, TwalkCollectVars);
+
+    if (vars.i_size > 0)
+    {
+        snap = malloc(sizeof (*snap) + vars.i_size * sizeof (variable_t *));
+        if (likely(snap != NULL))
+        {
+            snap->count = vars.i_size;
+            memcpy(snap->vars, vars.p_elems,
+                   vars.i_size * sizeof (variable_t *));
+        }
+        /* On allocation failure, readers fall back to the locked path. */
+    }
+    ARRAY_RESET(vars);
+
+    return atomic_exchange_explicit(&priv->var_snapshot, snap,
+                                    memory_order_acq_rel);
+}
+
+static int varsnapcmp(const void *key, const void *entry)
+{
+    variable_t *const *pv = entry;
+
+    return strcmp(key, (*pv)->psz_name);
+}
+
+static variable_t *VarSnapshotLookup(const struct var_snapshot *snap,
+                                     const char *name)
+{
+    variable_t **pv = bsearch(name, snap->vars, snap->count,
+                              sizeof (*snap->vars), varsnapcmp);
+    return (pv != NULL) ? *pv : NULL;
+}
+
+static_assert (sizeof (vlc_value_t) == sizeof (uint_least64_t),
+               "unexpected variable value size");
+
+/**
+ * Mirrors the (updated) variable value into its atomic shadow copy.
+ */
+static void VarPublishValue(variable_t *var)
+{
+    uint_least64_t bits = 0;
+
+    memcpy(&bits, &var->val, sizeof (var->val));
+    atomic_store_explicit(&var->cached, bits, memory_order_release);
+}
+
 static void Destroy( variable_t *p_var )
 {
     p_var->ops->pf_free( &p_var->val );
@@ -349,11 +445,15 @@ int (var_Create)( vlc_object_t *p_this, const char *psz_name, int i_type )
     }
 
     vlc_cond_init(&p_var->wait);
+    atomic_init(&p_var->cached, 0);
 
     if (i_type & VLC_VAR_DOINHERIT)
         var_Inherit(p_this, psz_name, i_type, &p_var->val);
 
+    VarPublishValue(p_var);
+
     vlc_object_internals_t *p_priv = vlc_internals( p_this );
+    struct var_snapshot *p_oldsnap = NULL;
     void **pp_var;
     variable_t *p_oldvar;
     int ret = VLC_SUCCESS;
@@ -364,7 +464,10 @@ int (var_Create)( vlc_object_t *p_this, const char *psz_name, int i_type )
     if( unlikely(pp_var == NULL) )
         ret = VLC_ENOMEM;
     else if( (p_oldvar = *pp_var) == p_var ) /* Variable create */
+    {
+        p_oldsnap = VarSnapshotPublish( p_priv );
         p_var = NULL; /* Variable created */
+    }
     else /* Variable already exists */
     {
         assert (((i_type ^ p_oldvar->i_type) & VLC_VAR_CLASS) == 0);
@@ -373,6 +476,12 @@ int (var_Create)( vlc_object_t *p_this, const char *psz_name, int i_type )
     }
     vlc_mutex_unlock( &p_priv->var_lock );
 
+    if( p_oldsnap != NULL )
+    {
+        vlc_rcu_synchronize();
+        free( p_oldsnap );
+    }
+
     /* If we did not need to create a new variable, free everything... */
     if( p_var != NULL )
         Destroy( p_var );
@@ -381,6 +490,7 @@ int (var_Create)( vlc_object_t *p_this, const char *psz_name, int i_type )
 
 void (var_Destroy)(vlc_object_t *p_this, const char *psz_name)
 {
+    struct var_snapshot *p_oldsnap = NULL;
     variable_t *p_var;
 
     assert( p_this );
@@ -395,6 +505,7 @@ void (var_Destroy)(vlc_object_t *p_this, const char *psz_name)
     {
         assert(!p_var->b_incallback);
         tdelete( p_var, &p_priv->var_root, varcmp );
+        p_oldsnap = VarSnapshotPublish( p_priv );
     }
     else
     {
@@ -404,7 +515,12 @@ void (var_Destroy)(vlc_object_t *p_this, const char *psz_name)
     vlc_mutex_unlock( &p_priv->var_lock );
 
     if( p_var != NULL )
+    {   /* Wait for lock-free readers of the old snapshot (and thus of the
+         * removed variable) before releasing either of them. */
+        vlc_rcu_synchronize();
+        free( p_oldsnap );
         Destroy( p_var );
+    }
 }
 
 static void CleanupVar( void *var )
@@ -415,6 +531,15 @@ static void CleanupVar( void *var )
 void var_DestroyAll( vlc_object_t *obj )
 {
     vlc_object_internals_t *priv = vlc_internals( obj );
+    struct var_snapshot *snap;
+
+    snap = atomic_exchange_explicit(&priv->var_snapshot, NULL,
+                                    memory_order_acq_rel);
+    if (snap != NULL)
+    {
+        vlc_rcu_synchronize();
+        free(snap);
+    }
 
     tdestroy( priv->var_root, CleanupVar );
     priv->var_root = NULL;
@@ -457,6 +582,7 @@ int (var_Change)(vlc_object_t *p_this, const char *psz_name, int i_action, ...)
             assert(p_var->ops->pf_free == FreeDummy);
             p_var->step = va_arg(ap, vlc_value_t);
             CheckValue( p_var, &p_var->val );
+            VarPublishValue( p_var );
             break;
         case VLC_VAR_GETSTEP:
             switch (p_var->i_type & VLC_VAR_TYPE)
@@ -541,6 +667,7 @@ int (var_Change)(vlc_object_t *p_this, const char *psz_name, int i_action, ...)
             CheckValue( p_var, &newval );
             /* Set the variable */
             p_var->val = newval;
+            VarPublishValue( p_var );
             /* Free data if needed */
             p_var->ops->pf_free( &oldval );
             break;
@@ -643,6 +770,7 @@ int (var_GetAndSet)(vlc_object_t *p_this, const char *psz_name, int i_action,
 
     /*  Check boundaries */
     CheckValue( p_var, &p_var->val );
+    VarPublishValue( p_var );
     *p_val = p_var->val;
 
     /* Deal with callbacks.*/
@@ -707,6 +835,7 @@ int (var_SetChecked)(vlc_object_t *p_this, const char *psz_name,
 
     /* Set the variable */
     p_var->val = val;
+    VarPublishValue( p_var );
 
     /* Deal with callbacks */
     TriggerCallback( p_this, p_var, psz_name, oldval );
@@ -732,6 +861,39 @@ int (var_GetChecked)(vlc_object_t *p_this, const char *psz_name,
     variable_t *p_var;
     int err = VLC_SUCCESS;
 
+    /* Wait-free read path for scalar types: writers publish both the
+     * variables snapshot and the value shadow copies, so readers need not
+     * content for the variables lock. Strings are duplicated, and thus still
+     * require the lock to keep the original alive. */
+    vlc_rcu_read_lock();
+
+    const struct var_snapshot *snap =
+        atomic_load_explicit(&p_priv->var_snapshot, memory_order_acquire);
+    if (snap != NULL)
+    {
+        p_var = VarSnapshotLookup(snap, psz_name);
+
+        if (p_var != NULL)
+        {
+            int i_class = p_var->i_type & VLC_VAR_CLASS;
+
+            if (i_class != VLC_VAR_STRING && i_class != VLC_VAR_VOID)
+            {
+                assert( expected_type == 0 || i_class == expected_type );
+
+                uint_least64_t bits =
+                    atomic_load_explicit(&p_var->cached,
+                                         memory_order_acquire);
+                memcpy(p_val, &bits, sizeof (bits));
+                vlc_rcu_read_unlock();
+                return VLC_SUCCESS;
+            }
+        }
+        /* Fall through: missing variables might have been created since the
+         * snapshot was taken, so recheck under the lock. */
+    }
+    vlc_rcu_read_unlock();
+
     p_var = Lookup( p_this, psz_name );
     if( p_var != NULL )
     {
@@ -1137,8 +1299,6 @@ error:
     return VLC_EGENERIC;
 }
 
-static thread_local void *twalk_ctx;
-
 static void TwalkGetNames(const void *data, const VISIT which, const int depth)
 {
     if (which != postorder && which != leaf)
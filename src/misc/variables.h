@@ -23,9 +23,12 @@
 #ifndef LIBVLC_VARIABLES_H
 # define LIBVLC_VARIABLES_H 1
 
+# include <stdatomic.h>
+
 # include <vlc_list.h>
 
 struct vlc_res;
+struct vlc_object_census;
 
 /**
  * Private LibVLC data for each object.
@@ -35,14 +38,20 @@ typedef struct vlc_object_internals vlc_object_internals_t;
 struct vlc_object_internals
 {
     vlc_object_t *parent; /**< Parent object (or NULL) */
+    libvlc_int_t *libvlc; /**< Root of the object tree (constant) */
     const char *typename; /**< Object type human-readable name */
 
     /* Object variables */
     void           *var_root;
     vlc_mutex_t     var_lock;
+    /** RCU-published sorted snapshot of the variables (see variables.c) */
+    void *_Atomic   var_snapshot;
 
     /* Object resources */
     struct vlc_res *resources;
+
+    /** Live-object census slot for this type name (see objects.c) */
+    struct vlc_object_census *census;
 };
 
 # define vlc_internals(o) ((o)->priv)
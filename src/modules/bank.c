@@ -296,6 +296,16 @@ typedef enum
     CACHE_WRITE_FILE = 0x4,
 } cache_mode_t;
 
+/** Plug-in file awaiting (parallel) loading */
+typedef struct vlc_plugin_candidate
+{
+    char *abspath;
+    char *relpath;
+    int64_t mtime;
+    uint64_t size;
+    vlc_plugin_t *plugin;
+} vlc_plugin_candidate_t;
+
 typedef struct module_bank
 {
     libvlc_int_t *obj;
@@ -304,11 +314,35 @@ typedef struct module_bank
 
     size_t        size;
     vlc_plugin_t **plugins;
-    vlc_plugin_t *cache;
+    vlc_cache_t  *cache;
+
+    vlc_plugin_candidate_t *candv;
+    size_t        candc;
 } module_bank_t;
 
+/**
+ * Appends a plug-in (and all its modules) to the bank and, if the cache is to
+ * be regenerated, to the to-be-saved plug-ins list.
+ */
+static void module_StorePlugin(module_bank_t *bank, vlc_plugin_t *plugin)
+{
+    vlc_plugin_store(plugin);
+
+    if (bank->mode & CACHE_WRITE_FILE) /* Add entry to to-be-saved cache */
+    {
+        bank->plugins = xrealloc(bank->plugins,
+                                 (bank->size + 1) * sizeof (vlc_plugin_t *));
+        bank->plugins[bank->size] = plugin;
+        bank->size++;
+    }
+}
+
 /**
  * Scans a plug-in from a file.
+ *
+ * If the plug-in descriptor is not in the cache, loading the shared object is
+ * deferred to module_LoadDeferredPlugins() so that several files can be
+ * mapped and parsed in parallel.
  */
 static int AllocatePluginFile (module_bank_t *bank, const char *abspath,
                                const char *relpath, const struct stat *st)
@@ -318,7 +352,7 @@ static int AllocatePluginFile (module_bank_t *bank, const char *abspath,
     /* Check our plugins cache first then load plugin if needed */
     if (bank->mode & CACHE_READ_FILE)
     {
-        plugin = vlc_cache_lookup(&bank->cache, relpath);
+        plugin = vlc_cache_lookup(bank->cache, relpath);
 
         if (plugin != NULL
          && (plugin->mtime != (int64_t)st->st_mtime
@@ -331,38 +365,112 @@ static int AllocatePluginFile (module_bank_t *bank, const char *abspath,
         }
     }
 
-    if (plugin == NULL)
+    if (plugin != NULL)
     {
-        char *path = strdup(relpath);
-        if (path == NULL)
-            return -1;
+        module_StorePlugin(bank, plugin);
+        return 0;
+    }
+
+    /* Cache miss: defer the actual loading to the worker pool */
+    vlc_plugin_candidate_t *candv = realloc(bank->candv,
+                                  (bank->candc + 1) * sizeof (*bank->candv));
+    if (unlikely(candv == NULL))
+        return -1;
+    bank->candv = candv;
+
+    vlc_plugin_candidate_t *cand = &candv[bank->candc];
 
-        plugin = module_InitDynamic(bank->obj, abspath, true);
+    cand->abspath = strdup(abspath);
+    cand->relpath = strdup(relpath);
+    cand->mtime = st->st_mtime;
+    cand->size = st->st_size;
+    cand->plugin = NULL;
 
+    if (unlikely(cand->abspath == NULL || cand->relpath == NULL))
+    {
+        free(cand->abspath);
+        free(cand->relpath);
+        return -1;
+    }
+
+    bank->candc++;
+    return 0;
+}
+
+static atomic_size_t loader_next;
+
+static void *module_LoaderThread(void *data)
+{
+    module_bank_t *bank = data;
+    size_t i;
+
+    while ((i = atomic_fetch_add_explicit(&loader_next, 1,
+                                          memory_order_relaxed)) < bank->candc)
+    {
+        vlc_plugin_candidate_t *cand = &bank->candv[i];
+        vlc_plugin_t *plugin = module_InitDynamic(bank->obj, cand->abspath,
+                                                  true);
         if (plugin != NULL)
         {
-            plugin->path = path;
-            plugin->mtime = st->st_mtime;
-            plugin->size = st->st_size;
+            plugin->path = cand->relpath;
+            plugin->mtime = cand->mtime;
+            plugin->size = cand->size;
+            cand->relpath = NULL;
         }
-        else free(path);
+        cand->plugin = plugin;
     }
+    return NULL;
+}
 
-    if (plugin == NULL)
-        return -1;
+/**
+ * Loads the plug-ins whose descriptors were not found in the cache.
+ *
+ * The candidate shared objects are mapped and parsed by a pool of worker
+ * threads, so that a cold start scales with the CPU count rather than with
+ * the cumulated file system latency. Results are merged into the bank in
+ * scan order, on the scanning thread, under the modules lock (held by the
+ * caller of module_LoadPlugins()).
+ */
+static void module_LoadDeferredPlugins(module_bank_t *bank)
+{
+    if (bank->candc == 0)
+        return;
 
-    vlc_plugin_store(plugin);
+    unsigned nthreads = vlc_GetCPUCount();
+    if (nthreads > bank->candc)
+        nthreads = bank->candc;
 
-    if (bank->mode & CACHE_WRITE_FILE) /* Add entry to to-be-saved cache */
+    atomic_store_explicit(&loader_next, 0, memory_order_relaxed);
+
+    vlc_thread_t *threads = vlc_alloc(nthreads, sizeof (*threads));
+    unsigned spawned = 0;
+
+    if (likely(threads != NULL))
+        for (; spawned < nthreads; spawned++)
+            if (vlc_clone(&threads[spawned], module_LoaderThread, bank))
+                break;
+
+    /* The scanning thread joins the pool: this also covers thread creation
+     * failure, in which case the candidates are simply loaded serially. */
+    module_LoaderThread(bank);
+
+    for (unsigned i = 0; i < spawned; i++)
+        vlc_join(threads[i], NULL);
+    free(threads);
+
+    for (size_t i = 0; i < bank->candc; i++)
     {
-        bank->plugins = xrealloc(bank->plugins,
-                                 (bank->size + 1) * sizeof (vlc_plugin_t *));
-        bank->plugins[bank->size] = plugin;
-        bank->size++;
+        vlc_plugin_candidate_t *cand = &bank->candv[i];
+
+        if (cand->plugin != NULL)
+            module_StorePlugin(bank, cand->plugin);
+        free(cand->abspath);
+        free(cand->relpath);
     }
 
-    /* TODO: deal with errors */
-    return  0;
+    free(bank->candv);
+    bank->candv = NULL;
+    bank->candc = 0;
 }
 
 #ifdef __APPLE__
@@ -533,19 +641,21 @@ static void AllocatePluginPath(libvlc_int_t *obj, const char *path,
 
         /* Don't go deeper than 5 subdirectories */
         AllocatePluginDir(&bank, 5, path, NULL);
+
+        module_LoadDeferredPlugins(&bank);
     }
 
-    /* Deal with unmatched cache entries from cache file */
-    while (bank.cache != NULL)
+    /* Deal with unmatched cache entries from cache file. When the directory
+     * was scanned, unmatched entries are stale and simply discarded without
+     * ever being decoded. */
+    if (!(mode & CACHE_SCAN_DIR))
     {
-        vlc_plugin_t *plugin = bank.cache;
+        vlc_plugin_t *plugin;
 
-        bank.cache = plugin->next;
-        if (mode & CACHE_SCAN_DIR)
-            vlc_plugin_destroy(plugin);
-        else
+        while ((plugin = vlc_cache_drain(bank.cache)) != NULL)
             vlc_plugin_store(plugin);
     }
+    vlc_cache_delete(bank.cache);
 
     if (mode & CACHE_WRITE_FILE)
         CacheSave(obj, path, bank.plugins, bank.size);
@@ -553,6 +663,72 @@ static void AllocatePluginPath(libvlc_int_t *obj, const char *path,
     free(bank.plugins);
 }
 
+/**
+ * Loads the plug-ins listed in a preload manifest.
+ *
+ * The manifest is a plain text file naming one plug-in shared object per
+ * line; empty lines and lines starting with '#' are ignored, and relative
+ * paths are resolved against the directory containing the manifest. Only
+ * the listed plug-ins are registered: directory scanning and the plug-ins
+ * cache are bypassed entirely, which gets the bank load time of a
+ * fixed-function setup close to that of a static build. As with a normal
+ * scan, the plug-ins are merely described here and activated on demand.
+ */
+static void AllocatePluginManifest(libvlc_int_t *obj, const char *manifest)
+{
+    FILE *stream = vlc_fopen(manifest, "rt");
+    if (stream == NULL)
+    {
+        msg_Err(obj, "cannot open plug-ins manifest %s", manifest);
+        return;
+    }
+
+    msg_Dbg(obj, "loading plug-ins manifest %s", manifest);
+
+    const char *end = strrchr(manifest, DIR_SEP_CHAR);
+    int dirlen = (end != NULL) ? (int)(end - manifest + 1) : 0;
+
+    char *line = NULL;
+    size_t linecap = 0;
+    ssize_t linelen;
+    size_t count = 0;
+
+    while ((linelen = getline(&line, &linecap, stream)) != -1)
+    {
+        if (linelen > 0 && line[linelen - 1] == '\n')
+            line[--linelen] = '\0';
+        if (linelen == 0 || line[0] == '#')
+            continue;
+
+        char *abspath;
+        if (line[0] == DIR_SEP_CHAR)
+            abspath = strdup(line);
+        else if (asprintf(&abspath, "%.*s%s", dirlen, manifest, line) == -1)
+            abspath = NULL;
+        if (unlikely(abspath == NULL))
+            break;
+
+        vlc_plugin_t *plugin = module_InitDynamic(obj, abspath, true);
+        if (plugin != NULL)
+        {
+            plugin->abspath = abspath;
+            plugin->path = strdup(line);
+            vlc_plugin_store(plugin);
+            count++;
+        }
+        else
+        {
+            msg_Warn(obj, "cannot load manifest plug-in %s", abspath);
+            free(abspath);
+        }
+    }
+
+    free(line);
+    fclose(stream);
+
+    msg_Dbg(obj, "manifest: %zu plug-ins loaded", count);
+}
+
 /**
  * Enumerates all dynamic plug-ins that can be found.
  *
@@ -566,6 +742,15 @@ static void AllocateAllPlugins (libvlc_int_t *p_this)
     char *paths;
     cache_mode_t mode = 0;
 
+    /* A preload manifest replaces directory scanning and the cache */
+    char *manifest = var_InheritString(p_this, "plugins-manifest");
+    if (manifest != NULL)
+    {
+        AllocatePluginManifest(p_this, manifest);
+        free(manifest);
+        return;
+    }
+
     if (var_InheritBool(p_this, "plugins-cache"))
         mode |= CACHE_READ_FILE;
     if (var_InheritBool(p_this, "plugins-scan"))
@@ -57,7 +57,7 @@
 #ifdef HAVE_DYNAMIC_PLUGINS
 /* Sub-version number
  * (only used to avoid breakage in dev version when cache structure changes) */
-#define CACHE_SUBVERSION_NUM 36
+#define CACHE_SUBVERSION_NUM 37
 
 /* Cache filename */
 #define CACHE_NAME "plugins.dat"
@@ -323,7 +323,7 @@ error:
     return -1;
 }
 
-static vlc_plugin_t *vlc_cache_load_plugin(block_t *file)
+static vlc_plugin_t *vlc_cache_load_plugin(block_t *file, const char *path)
 {
     vlc_plugin_t *plugin = vlc_plugin_create();
     if (unlikely(plugin == NULL))
@@ -341,11 +341,6 @@ static vlc_plugin_t *vlc_cache_load_plugin(block_t *file)
 
     LOAD_STRING(plugin->textdomain);
 
-    const char *path;
-    LOAD_STRING(path);
-    if (path == NULL)
-        goto error;
-
     plugin->path = strdup(path);
     if (unlikely(plugin->path == NULL))
         goto error;
@@ -364,16 +359,124 @@ error:
     return NULL;
 }
 
+/** A not-yet-decoded plug-in descriptor within the cache file mapping */
+struct vlc_cache_entry
+{
+    const char *path; /**< Plug-in path (points into the backing mapping) */
+    const unsigned char *data; /**< Serialized descriptor */
+    size_t length; /**< Byte length of the serialized descriptor */
+};
+
+struct vlc_cache
+{
+    char *dir; /**< Plug-ins base directory */
+    struct vlc_cache_entry *entries;
+    size_t count;
+};
+
+/**
+ * Decodes (and consumes) one cache entry into a plug-in descriptor.
+ */
+static vlc_plugin_t *vlc_cache_decode(vlc_cache_t *cache,
+                                      struct vlc_cache_entry *entry)
+{
+    /* The backing file mapping outlives the bank, so the decoded descriptor
+     * can reference strings within the entry in place. */
+    block_t frag = {
+        .p_buffer = (unsigned char *)entry->data,
+        .i_buffer = entry->length,
+    };
+
+    vlc_plugin_t *plugin = vlc_cache_load_plugin(&frag, entry->path);
+
+    entry->path = NULL; /* mark entry as consumed */
+
+    if (plugin == NULL)
+        return NULL;
+
+    if (unlikely(asprintf(&plugin->abspath, "%s" DIR_SEP "%s", cache->dir,
+                          plugin->path) == -1))
+    {
+        plugin->abspath = NULL;
+        vlc_plugin_destroy(plugin);
+        return NULL;
+    }
+
+    return plugin;
+}
+
+/**
+ * Looks up a plugin file in the cache.
+ *
+ * The matching descriptor, if any, is decoded on the spot and removed from
+ * the cache. Entries that are never looked up are never decoded, so stale or
+ * unmatched records cost neither CPU time nor page-ins from the mapping.
+ */
+vlc_plugin_t *vlc_cache_lookup(vlc_cache_t *cache, const char *path)
+{
+    if (cache == NULL)
+        return NULL;
+
+    for (size_t i = 0; i < cache->count; i++)
+    {
+        struct vlc_cache_entry *entry = &cache->entries[i];
+
+        if (entry->path != NULL && !strcmp(entry->path, path))
+            return vlc_cache_decode(cache, entry);
+    }
+
+    return NULL;
+}
+
+/**
+ * Decodes and removes the next remaining cache entry.
+ *
+ * This is used when the plug-ins directory is not scanned, and the cache is
+ * the only source of plug-in descriptors.
+ *
+ * \return a decoded plug-in descriptor, or NULL once the cache is empty
+ */
+vlc_plugin_t *vlc_cache_drain(vlc_cache_t *cache)
+{
+    if (cache == NULL)
+        return NULL;
+
+    for (size_t i = 0; i < cache->count; i++)
+    {
+        struct vlc_cache_entry *entry = &cache->entries[i];
+
+        if (entry->path == NULL)
+            continue;
+
+        vlc_plugin_t *plugin = vlc_cache_decode(cache, entry);
+        if (plugin != NULL)
+            return plugin;
+    }
+
+    return NULL;
+}
+
+void vlc_cache_delete(vlc_cache_t *cache)
+{
+    if (cache == NULL)
+        return;
+
+    free(cache->entries);
+    free(cache->dir);
+    free(cache);
+}
+
 /**
  * Loads a plugins cache file.
  *
- * This function will load the plugin cache if present and valid. This cache
+ * This function indexes the plugin cache if present and valid. The index
  * will in turn be queried by AllocateAllPlugins() to see if it needs to
  * actually load the dynamically loadable module.
- * This allows us to only fully load plugins when they are actually used.
+ * Individual descriptors are only decoded when (and if) they are looked up,
+ * so loading boils down to mapping the file and walking the record headers.
  */
-vlc_plugin_t *vlc_cache_load(libvlc_int_t *p_this, const char *dir,
-                             block_t **backingp)
+vlc_cache_t *vlc_cache_load(libvlc_int_t *p_this, const char *dir,
+                            block_t **backingp)
 {
     char *psz_filename;
 
@@ -443,24 +546,47 @@ vlc_plugin_t *vlc_cache_load(libvlc_int_t *p_this, const char *dir,
         return NULL;
     }
 
-    vlc_plugin_t *cache = NULL;
+    vlc_cache_t *cache = malloc(sizeof (*cache));
+    if (unlikely(cache == NULL))
+    {
+        block_Release(file);
+        return NULL;
+    }
+
+    cache->dir = strdup(dir);
+    cache->entries = NULL;
+    cache->count = 0;
 
+    if (unlikely(cache->dir == NULL))
+        goto error;
+
+    /* Index the records: each one is a path and a length-prefixed blob,
+     * decoded later on demand. */
     while (file->i_buffer > 0)
     {
-        vlc_plugin_t *plugin = vlc_cache_load_plugin(file);
-        if (plugin == NULL)
+        uint32_t length;
+        const char *path;
+
+        if (vlc_cache_load_immediate(&length, file, sizeof (length)))
+            goto error;
+        if (vlc_cache_load_string(&path, file) || path == NULL)
+            goto error;
+        if (file->i_buffer < length)
             goto error;
 
-        if (unlikely(asprintf(&plugin->abspath, "%s" DIR_SEP "%s", dir,
-                              plugin->path) == -1))
-        {
-            plugin->abspath = NULL;
-            vlc_plugin_destroy(plugin);
+        struct vlc_cache_entry *entries = realloc(cache->entries,
+                               (cache->count + 1) * sizeof (*cache->entries));
+        if (unlikely(entries == NULL))
             goto error;
-        }
 
-        plugin->next = cache;
-        cache = plugin;
+        cache->entries = entries;
+        entries[cache->count].path = path;
+        entries[cache->count].data = file->p_buffer;
+        entries[cache->count].length = length;
+        cache->count++;
+
+        file->p_buffer += length;
+        file->i_buffer -= length;
     }
 
     file->p_next = *backingp;
@@ -469,8 +595,7 @@ vlc_plugin_t *vlc_cache_load(libvlc_int_t *p_this, const char *dir,
 
 error:
     msg_Warn( p_this, "plugins cache not loaded (corrupted)" );
-
-    /* TODO: cleanup */
+    vlc_cache_delete(cache);
     block_Release(file);
     return NULL;
 }
@@ -623,6 +748,15 @@ static int CacheSaveBank(FILE *file, vlc_plugin_t *const *cache, size_t n)
     {
         const vlc_plugin_t *plugin = cache[i];
         uint32_t count = plugin->modules_count;
+        uint32_t reclen = 0;
+        long lenpos, datapos, endpos;
+
+        /* Record header: blob length (patched afterward) and path, so that
+         * the loader can index records without decoding them. */
+        lenpos = ftell(file);
+        SAVE_IMMEDIATE(reclen);
+        SAVE_STRING(plugin->path);
+        datapos = ftell(file);
 
         SAVE_IMMEDIATE(count);
 
@@ -638,10 +772,16 @@ static int CacheSaveBank(FILE *file, vlc_plugin_t *const *cache, size_t n)
 
         /* Save common info */
         SAVE_STRING(plugin->textdomain);
-        SAVE_STRING(plugin->path);
         SAVE_FLAG(plugin->unloadable);
         SAVE_IMMEDIATE(plugin->mtime);
         SAVE_IMMEDIATE(plugin->size);
+
+        endpos = ftell(file);
+        reclen = endpos - datapos;
+        if (fseek(file, lenpos, SEEK_SET)
+         || fwrite(&reclen, sizeof (reclen), 1, file) != 1
+         || fseek(file, endpos, SEEK_SET))
+            goto error;
     }
 
     if (fflush (file)) /* flush libc buffers */
@@ -702,25 +842,4 @@ out:
     free (tmpname);
 }
 
-/**
- * Looks up a plugin file in a table of cached plugins.
- */
-vlc_plugin_t *vlc_cache_lookup(vlc_plugin_t **cache, const char *path)
-{
-    vlc_plugin_t **pp = cache, *plugin;
-
-    while ((plugin = *pp) != NULL)
-    {
-        if (plugin->path != NULL && !strcmp(plugin->path, path))
-        {
-            *pp = plugin->next;
-            plugin->next = NULL;
-            return plugin;
-        }
-
-        pp = &plugin->next;
-    }
-
-    return NULL;
-}
 #endif /* HAVE_DYNAMIC_PLUGINS */
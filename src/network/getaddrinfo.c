@@ -128,3 +128,163 @@ int vlc_getaddrinfo_i11e(const char *node, unsigned port,
     return vlc_getaddrinfo(node, port, hints, res);
 }
 #endif
+
+/*
+ * Resolution cache. getaddrinfo() does not expose the record time-to-live,
+ * so a conservative fixed lifetime is used: short enough that CDN address
+ * rotations are still honoured, long enough to cover a burst of segment
+ * fetches to the same host.
+ */
+#define DNS_CACHE_TTL     VLC_TICK_FROM_SEC(30)
+#define DNS_CACHE_SIZE    8
+
+static struct dns_cache_entry
+{
+    char *host;
+    unsigned port;
+    int flags;
+    int family;
+    int socktype;
+    int protocol;
+    vlc_tick_t expiry;
+    struct addrinfo *res;
+} dns_cache[DNS_CACHE_SIZE];
+
+static vlc_mutex_t dns_cache_lock = VLC_STATIC_MUTEX;
+
+void vlc_freeaddrinfo(struct addrinfo *res)
+{
+    while (res != NULL)
+    {
+        struct addrinfo *next = res->ai_next;
+
+        free(res->ai_canonname);
+        free(res); /* the socket address lives in the same allocation */
+        res = next;
+    }
+}
+
+/**
+ * Duplicates an addrinfo list into vlc_freeaddrinfo()-compatible storage.
+ */
+static struct addrinfo *vlc_copyaddrinfo(const struct addrinfo *src)
+{
+    struct addrinfo *head = NULL, **pp = &head;
+
+    for (; src != NULL; src = src->ai_next)
+    {
+        struct addrinfo *info = malloc(sizeof (*info) + src->ai_addrlen);
+        if (unlikely(info == NULL))
+            goto error;
+
+        *info = *src;
+        info->ai_canonname = NULL;
+        info->ai_next = NULL;
+        if (src->ai_addr != NULL)
+        {
+            info->ai_addr = (struct sockaddr *)(info + 1);
+            memcpy(info->ai_addr, src->ai_addr, src->ai_addrlen);
+        }
+
+        *pp = info;
+        pp = &info->ai_next;
+
+        if (src->ai_canonname != NULL)
+        {
+            info->ai_canonname = strdup(src->ai_canonname);
+            if (unlikely(info->ai_canonname == NULL))
+                goto error;
+        }
+    }
+    return head;
+
+error:
+    vlc_freeaddrinfo(head);
+    return NULL;
+}
+
+int vlc_getaddrinfo_cached(const char *node, unsigned port,
+                           const struct addrinfo *hints,
+                           struct addrinfo **res)
+{
+    int flags = (hints != NULL) ? hints->ai_flags : 0;
+
+    /* Numeric and local addresses resolve without network traffic */
+    if (node == NULL || (flags & (AI_NUMERICHOST | AI_PASSIVE)))
+        return vlc_getaddrinfo_i11e(node, port, hints, res);
+
+    struct dns_cache_entry *entry = NULL;
+    vlc_tick_t now = vlc_tick_now();
+
+    vlc_mutex_lock(&dns_cache_lock);
+    for (size_t i = 0; i < ARRAY_SIZE(dns_cache); i++)
+    {
+        struct dns_cache_entry *e = dns_cache + i;
+
+        if (e->host == NULL || e->expiry <= now)
+            continue;
+        if (e->port != port || e->flags != flags
+         || e->family != ((hints != NULL) ? hints->ai_family : AF_UNSPEC)
+         || e->socktype != ((hints != NULL) ? hints->ai_socktype : 0)
+         || e->protocol != ((hints != NULL) ? hints->ai_protocol : 0)
+         || strcmp(e->host, node))
+            continue;
+
+        entry = e;
+        break;
+    }
+
+    if (entry != NULL)
+    {
+        *res = vlc_copyaddrinfo(entry->res);
+        vlc_mutex_unlock(&dns_cache_lock);
+        return likely(*res != NULL) ? 0 : EAI_MEMORY;
+    }
+    vlc_mutex_unlock(&dns_cache_lock);
+
+    struct addrinfo *sysres;
+    int val = vlc_getaddrinfo_i11e(node, port, hints, &sysres);
+    if (val != 0)
+        return val; /* failures are not cached */
+
+    *res = vlc_copyaddrinfo(sysres);
+    if (unlikely(*res == NULL))
+    {
+        freeaddrinfo(sysres);
+        return EAI_MEMORY;
+    }
+
+    char *host = strdup(node);
+    if (unlikely(host == NULL))
+    {   /* degrade to an uncached success */
+        freeaddrinfo(sysres);
+        return 0;
+    }
+
+    vlc_mutex_lock(&dns_cache_lock);
+    /* Evict the free or soonest-expiring slot */
+    entry = dns_cache;
+    for (size_t i = 1; i < ARRAY_SIZE(dns_cache); i++)
+    {
+        if (entry->host == NULL)
+            break;
+        if (dns_cache[i].host == NULL || dns_cache[i].expiry < entry->expiry)
+            entry = dns_cache + i;
+    }
+
+    if (entry->host != NULL)
+    {
+        free(entry->host);
+        freeaddrinfo(entry->res);
+    }
+    entry->host = host;
+    entry->port = port;
+    entry->flags = flags;
+    entry->family = (hints != NULL) ? hints->ai_family : AF_UNSPEC;
+    entry->socktype = (hints != NULL) ? hints->ai_socktype : 0;
+    entry->protocol = (hints != NULL) ? hints->ai_protocol : 0;
+    entry->expiry = now + DNS_CACHE_TTL;
+    entry->res = sysres;
+    vlc_mutex_unlock(&dns_cache_lock);
+    return 0;
+}
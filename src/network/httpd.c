@@ -42,11 +42,17 @@
 #include <vlc_url.h>
 #include <vlc_mime.h>
 #include <vlc_block.h>
+#include <vlc_fs.h>
 #include "../libvlc.h"
 
 #include <string.h>
 #include <errno.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#ifdef HAVE_SENDFILE
+# include <sys/sendfile.h>
+#endif
 #ifdef HAVE_SYS_UIO_H
 # include <sys/uio.h>
 #endif
@@ -54,6 +60,9 @@
 #ifdef HAVE_POLL_H
 # include <poll.h>
 #endif
+#ifdef HAVE_EPOLL_CREATE1
+# include <sys/epoll.h>
+#endif
 
 #if defined(_WIN32)
 #   include <winsock2.h>
@@ -84,6 +93,10 @@ struct httpd_host_t
     int         *fds;
     unsigned     nfd;
     unsigned     port;
+#ifdef HAVE_EPOLL_CREATE1
+    /* persistent event set covering the listening and client sockets */
+    int          evfd;
+#endif
 
     vlc_thread_t thread;
     vlc_mutex_t lock;
@@ -146,6 +159,10 @@ struct httpd_client_t
 
     bool    b_stream_mode;
     uint8_t i_state;
+#ifdef HAVE_EPOLL_CREATE1
+    /* poll events the socket is registered for, -1 if not registered */
+    int     i_epoll_events;
+#endif
 
     vlc_tick_t i_timeout_date;
 
@@ -154,6 +171,13 @@ struct httpd_client_t
     int     i_buffer;
     uint8_t *p_buffer;
 
+    /* if not NULL, the answer body is streamed from this shared open file
+     * once the header has been sent (see httpd_FilePathNew) */
+    struct httpd_cached_file *body_file;
+    uint64_t body_offset;
+    uint64_t body_end;
+    bool     body_direct; /* plain (non-TLS) socket, sendfile() usable */
+
     /*
      * If waiting for a keyframe, this is the position (in bytes) of the
      * last keyframe the stream saw before this client connected.
@@ -293,6 +317,133 @@ static size_t httpd_HtmlError (char **body, int code, const char *url)
 }
 
 
+/*****************************************************************************
+ * Shared open-file cache
+ *****************************************************************************
+ * Files served with httpd_FilePathNew() are kept open here, so that a file
+ * fetched by many clients at once is opened and stat()ed once, not per
+ * client. Entries are reference counted: evicting one does not close the
+ * descriptor until the last client streaming from it is done.
+ *****************************************************************************/
+#define HTTPD_FILE_CACHE_SIZE 8
+/* how long an entry is served without re-checking the file on disk */
+#define HTTPD_FILE_CACHE_TTL  VLC_TICK_FROM_SEC(1)
+
+struct httpd_cached_file
+{
+    char *psz_path;
+    int fd;
+    uint64_t size;
+    time_t mtime;
+    vlc_tick_t date; /* last time the on-disk file was stat()ed */
+    unsigned refs;   /* one reference is held by the cache itself */
+};
+
+static struct
+{
+    vlc_mutex_t lock;
+    /* most recently used first */
+    struct httpd_cached_file *entry[HTTPD_FILE_CACHE_SIZE];
+} httpd_file_cache = { VLC_STATIC_MUTEX, { NULL } };
+
+static void httpd_CachedFileDestroy(struct httpd_cached_file *f)
+{
+    vlc_close(f->fd);
+    free(f->psz_path);
+    free(f);
+}
+
+static void httpd_CachedFileRelease(struct httpd_cached_file *f)
+{
+    vlc_mutex_lock(&httpd_file_cache.lock);
+    unsigned refs = --f->refs;
+    vlc_mutex_unlock(&httpd_file_cache.lock);
+
+    if (refs == 0)
+        httpd_CachedFileDestroy(f);
+}
+
+static struct httpd_cached_file *httpd_CachedFileGet(const char *psz_path)
+{
+    struct httpd_cached_file *f = NULL, *stale = NULL;
+    struct stat st;
+
+    vlc_mutex_lock(&httpd_file_cache.lock);
+    for (unsigned i = 0; i < HTTPD_FILE_CACHE_SIZE; i++) {
+        f = httpd_file_cache.entry[i];
+        if (f == NULL || strcmp(f->psz_path, psz_path)) {
+            f = NULL;
+            continue;
+        }
+
+        vlc_tick_t now = vlc_tick_now();
+        if (now - f->date >= HTTPD_FILE_CACHE_TTL) {
+            if (vlc_stat(psz_path, &st) != 0 || st.st_mtime != f->mtime
+             || (uint64_t)st.st_size != f->size) {
+                /* The file changed on disk: evict the entry. Clients already
+                 * streaming from the old descriptor keep their references. */
+                httpd_file_cache.entry[i] = NULL;
+                if (--f->refs == 0)
+                    stale = f;
+                f = NULL;
+                break;
+            }
+            f->date = now;
+        }
+
+        memmove(&httpd_file_cache.entry[1], &httpd_file_cache.entry[0],
+                i * sizeof (f));
+        httpd_file_cache.entry[0] = f;
+        f->refs++;
+        break;
+    }
+    vlc_mutex_unlock(&httpd_file_cache.lock);
+
+    if (stale != NULL)
+        httpd_CachedFileDestroy(stale);
+    if (f != NULL)
+        return f;
+
+    int fd = vlc_open(psz_path, O_RDONLY | O_NONBLOCK);
+    if (fd == -1)
+        return NULL;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        vlc_close(fd);
+        return NULL;
+    }
+
+    f = malloc(sizeof (*f));
+    char *path = strdup(psz_path);
+    if (unlikely(f == NULL || path == NULL)) {
+        free(path);
+        free(f);
+        vlc_close(fd);
+        return NULL;
+    }
+
+    f->psz_path = path;
+    f->fd = fd;
+    f->size = st.st_size;
+    f->mtime = st.st_mtime;
+    f->date = vlc_tick_now();
+    f->refs = 2; /* the cache plus the caller */
+
+    /* Two racing misses on the same path can insert two entries; this only
+     * wastes a descriptor until one of them falls off the end. */
+    vlc_mutex_lock(&httpd_file_cache.lock);
+    stale = httpd_file_cache.entry[HTTPD_FILE_CACHE_SIZE - 1];
+    memmove(&httpd_file_cache.entry[1], &httpd_file_cache.entry[0],
+            (HTTPD_FILE_CACHE_SIZE - 1) * sizeof (f));
+    httpd_file_cache.entry[0] = f;
+    if (stale != NULL && --stale->refs > 0)
+        stale = NULL;
+    vlc_mutex_unlock(&httpd_file_cache.lock);
+
+    if (stale != NULL)
+        httpd_CachedFileDestroy(stale);
+    return f;
+}
+
 /*****************************************************************************
  * High Level Functions: httpd_file_t
  *****************************************************************************/
@@ -301,6 +452,7 @@ struct httpd_file_t
     httpd_url_t *url;
     httpd_file_callback_t pf_fill;
     httpd_file_sys_t      *p_sys;
+    char *psz_path; /* file served as-is instead of using pf_fill, or NULL */
     char mime[1];
 };
 
@@ -353,6 +505,54 @@ httpd_FileCallBack(httpd_callback_sys_t *p_sys, httpd_client_t *cl,
     return VLC_SUCCESS;
 }
 
+static int
+httpd_FilePathCallBack(httpd_callback_sys_t *p_sys, httpd_client_t *cl,
+                        httpd_message_t *answer, const httpd_message_t *query)
+{
+    httpd_file_t *file = (httpd_file_t*)p_sys;
+
+    if (!answer || !query)
+        return VLC_SUCCESS;
+
+    answer->i_proto  = HTTPD_PROTO_HTTP;
+    answer->i_version= 1;
+    answer->i_type   = HTTPD_MSG_ANSWER;
+
+    struct httpd_cached_file *f = httpd_CachedFileGet(file->psz_path);
+    if (f == NULL) {
+        char *p;
+
+        answer->i_status = 404;
+        answer->i_body = httpd_HtmlError (&p, 404, query->psz_url);
+        answer->p_body = (uint8_t *)p;
+        httpd_MsgAdd(answer, "Content-Length", "%d", answer->i_body);
+        httpd_MsgAdd(answer, "Content-Type", "%s", "text/html");
+        if (httpd_MsgGet(&cl->query, "Connection") != NULL)
+            httpd_MsgAdd(answer, "Connection", "close");
+        return VLC_SUCCESS;
+    }
+
+    answer->i_status = 200;
+    httpd_MsgAdd(answer, "Content-type",   "%s", file->mime);
+    httpd_MsgAdd(answer, "Content-Length", "%" PRIu64, f->size);
+
+    if (httpd_MsgGet(&cl->query, "Connection") != NULL)
+        httpd_MsgAdd(answer, "Connection", "close");
+
+    if (query->i_type == HTTPD_MSG_HEAD) {
+        httpd_CachedFileRelease(f);
+        return VLC_SUCCESS;
+    }
+
+    /* The body is streamed straight from the shared descriptor once the
+     * header is out (see httpd_ClientSendFile), without per-client buffer */
+    cl->body_file   = f;
+    cl->body_offset = 0;
+    cl->body_end    = f->size;
+    cl->body_direct = (file->url->host->p_tls == NULL);
+    return VLC_SUCCESS;
+}
+
 httpd_file_t *httpd_FileNew(httpd_host_t *host,
                              const char *psz_url, const char *psz_mime,
                              const char *psz_user, const char *psz_password,
@@ -376,6 +576,7 @@ httpd_file_t *httpd_FileNew(httpd_host_t *host,
 
     file->pf_fill = pf_fill;
     file->p_sys   = p_sys;
+    file->psz_path = NULL;
     memcpy(file->mime, mime, mimelen + 1);
 
     httpd_UrlCatch(file->url, HTTPD_MSG_HEAD, httpd_FileCallBack,
@@ -388,11 +589,52 @@ httpd_file_t *httpd_FileNew(httpd_host_t *host,
     return file;
 }
 
+httpd_file_t *httpd_FilePathNew(httpd_host_t *host,
+                                 const char *psz_url, const char *psz_mime,
+                                 const char *psz_user,
+                                 const char *psz_password,
+                                 const char *psz_path)
+{
+    const char *mime = psz_mime;
+    if (mime == NULL || mime[0] == '\0')
+        mime = vlc_mime_Ext2Mime(psz_path);
+
+    size_t mimelen = strlen(mime);
+    httpd_file_t *file = malloc(sizeof(*file) + mimelen);
+    if (unlikely(file == NULL))
+        return NULL;
+
+    file->psz_path = strdup(psz_path);
+    if (unlikely(file->psz_path == NULL)) {
+        free(file);
+        return NULL;
+    }
+
+    file->url = httpd_UrlNew(host, psz_url, psz_user, psz_password);
+    if (!file->url) {
+        free(file->psz_path);
+        free(file);
+        return NULL;
+    }
+
+    file->pf_fill = NULL;
+    file->p_sys   = NULL;
+    memcpy(file->mime, mime, mimelen + 1);
+
+    httpd_UrlCatch(file->url, HTTPD_MSG_HEAD, httpd_FilePathCallBack,
+                    (httpd_callback_sys_t*)file);
+    httpd_UrlCatch(file->url, HTTPD_MSG_GET,  httpd_FilePathCallBack,
+                    (httpd_callback_sys_t*)file);
+
+    return file;
+}
+
 httpd_file_sys_t *httpd_FileDelete(httpd_file_t *file)
 {
     httpd_file_sys_t *p_sys = file->p_sys;
 
     httpd_UrlDelete(file->url);
+    free(file->psz_path);
     free(file);
     return p_sys;
 }
@@ -975,6 +1217,9 @@ static httpd_host_t *httpd_HostCreate(vlc_object_t *p_this,
 
     vlc_mutex_init(&host->lock);
     atomic_init(&host->ref, 1);
+#ifdef HAVE_EPOLL_CREATE1
+    host->evfd = -1;
+#endif
 
     char *hostname = var_InheritString(p_this, hostvar);
 
@@ -987,6 +1232,24 @@ static httpd_host_t *httpd_HostCreate(vlc_object_t *p_this,
     }
     for (host->nfd = 0; host->fds[host->nfd] != -1; host->nfd++);
 
+#ifdef HAVE_EPOLL_CREATE1
+    host->evfd = epoll_create1(EPOLL_CLOEXEC);
+    if (host->evfd == -1) {
+        msg_Err(p_this, "cannot create epoll instance: %s",
+                vlc_strerror_c(errno));
+        goto error;
+    }
+
+    for (unsigned i = 0; i < host->nfd; i++) {
+        struct epoll_event ev = { .events = EPOLLIN, .data.fd = host->fds[i] };
+
+        if (epoll_ctl(host->evfd, EPOLL_CTL_ADD, host->fds[i], &ev)) {
+            msg_Err(p_this, "cannot monitor socket: %s", vlc_strerror_c(errno));
+            goto error;
+        }
+    }
+#endif
+
     host->port     = port;
     vlc_list_init(&host->urls);
     host->client_count = 0;
@@ -1010,6 +1273,10 @@ error:
     vlc_mutex_unlock(&httpd.mutex);
 
     if (host) {
+#ifdef HAVE_EPOLL_CREATE1
+        if (host->evfd != -1)
+            vlc_close(host->evfd);
+#endif
         net_ListenClose(host->fds);
         vlc_object_delete(host);
     }
@@ -1045,6 +1312,9 @@ void httpd_HostDelete(httpd_host_t *host)
 
     assert(vlc_list_is_empty(&host->urls));
     vlc_tls_ServerDelete(host->p_tls);
+#ifdef HAVE_EPOLL_CREATE1
+    vlc_close(host->evfd);
+#endif
     net_ListenClose(host->fds);
     vlc_object_delete(host);
     vlc_mutex_unlock(&httpd.mutex);
@@ -1229,6 +1499,9 @@ char* httpd_ServerIP(const httpd_client_t *cl, char *ip, int *port)
 
 static void httpd_ClientDestroy(httpd_client_t *cl)
 {
+    if (cl->body_file != NULL)
+        httpd_CachedFileRelease(cl->body_file);
+
     vlc_list_remove(&cl->node);
     vlc_tls_Close(cl->sock);
     httpd_MsgClean(&cl->answer);
@@ -1247,9 +1520,13 @@ static httpd_client_t *httpd_ClientNew(vlc_tls_t *sock)
     cl->sock    = sock;
     cl->url     = NULL;
     cl->i_state = HTTPD_CLIENT_RECEIVING;
+#ifdef HAVE_EPOLL_CREATE1
+    cl->i_epoll_events = -1;
+#endif
     cl->i_buffer_size = HTTPD_CL_BUFSIZE;
     cl->i_buffer = 0;
     cl->p_buffer = xmalloc(cl->i_buffer_size);
+    cl->body_file = NULL;
     cl->i_keyframe_wait_to_pass = -1;
     cl->b_stream_mode = false;
 
@@ -1582,6 +1859,70 @@ static int httpd_ClientRecv(httpd_client_t *cl)
     return 0;
 }
 
+/* Sends the next chunk of a file-backed answer body (httpd_FilePathNew).
+ * On a plain socket the file is spliced in kernel space with sendfile();
+ * the shared descriptor is safe there because sendfile() takes an explicit
+ * offset and leaves the file position alone, like pread() in the fallback. */
+static int httpd_ClientSendFile(httpd_client_t *cl)
+{
+    struct httpd_cached_file *f = cl->body_file;
+    uint64_t left = cl->body_end - cl->body_offset;
+    ssize_t i_len;
+
+    if (left == 0) {
+        httpd_CachedFileRelease(f);
+        cl->body_file = NULL;
+        cl->i_state = HTTPD_CLIENT_SEND_DONE;
+        return 0;
+    }
+
+#ifdef HAVE_SENDFILE
+    if (cl->body_direct) {
+        off_t offset = cl->body_offset;
+
+        i_len = sendfile(vlc_tls_GetFD(cl->sock), f->fd, &offset,
+                         __MIN(left, (uint64_t)1 << 20));
+    } else
+#endif
+    {
+        unsigned char buf[8192];
+        ssize_t i_read = pread(f->fd, buf, __MIN(left, sizeof (buf)),
+                               cl->body_offset);
+        if (i_read <= 0) {
+            /* the file was truncated under our feet: give up */
+            httpd_CachedFileRelease(f);
+            cl->body_file = NULL;
+            cl->i_state = HTTPD_CLIENT_DEAD;
+            return 0;
+        }
+        i_len = httpd_NetSend(cl, buf, i_read);
+    }
+
+    if (i_len < 0) {
+#if defined(_WIN32)
+        if (WSAGetLastError() == WSAEWOULDBLOCK)
+#else
+        if (errno == EAGAIN)
+#endif
+            return -1;
+
+        /* Connection failed, or hung up (EPIPE) */
+        httpd_CachedFileRelease(f);
+        cl->body_file = NULL;
+        cl->i_state = HTTPD_CLIENT_DEAD;
+        return 0;
+    }
+
+    cl->body_offset += i_len;
+
+    if (cl->body_offset >= cl->body_end) {
+        httpd_CachedFileRelease(f);
+        cl->body_file = NULL;
+        cl->i_state = HTTPD_CLIENT_SEND_DONE;
+    }
+    return 0;
+}
+
 static int httpd_ClientSend(httpd_client_t *cl)
 {
     int i_len;
@@ -1636,6 +1977,9 @@ static int httpd_ClientSend(httpd_client_t *cl)
     cl->i_buffer += i_len;
 
     if (cl->i_buffer >= cl->i_buffer_size) {
+        if (cl->body_file != NULL) /* header is out, stream the file body */
+            return httpd_ClientSendFile(cl);
+
         if (cl->answer.i_body == 0  && cl->answer.i_body_offset > 0) {
             /* catch more body data */
             int     i_msg = cl->query.i_type;
@@ -1714,352 +2058,411 @@ auth_failed:
     return false;
 }
 
-static void httpdLoop(httpd_host_t *host)
+/* Runs one iteration of a client state machine, then writes the file
+ * descriptor and the I/O events the client now waits for to *pufd.
+ * Returns -1 if the client was destroyed, 0 otherwise. */
+static int httpdClientLoop(httpd_host_t *host, httpd_client_t *cl,
+                           vlc_tick_t now, struct pollfd *pufd,
+                           int *restrict delay)
 {
-    struct pollfd ufd[host->nfd + host->client_count];
-    unsigned nfd;
-    for (nfd = 0; nfd < host->nfd; nfd++) {
-        ufd[nfd].fd = host->fds[nfd];
-        ufd[nfd].events = POLLIN;
-        ufd[nfd].revents = 0;
+    int val = -1;
+
+    switch (cl->i_state) {
+        case HTTPD_CLIENT_RECEIVING:
+            val = httpd_ClientRecv(cl);
+            break;
+        case HTTPD_CLIENT_SENDING:
+            val = httpd_ClientSend(cl);
+            break;
+        case HTTPD_CLIENT_TLS_HS_IN:
+        case HTTPD_CLIENT_TLS_HS_OUT:
+            httpd_ClientTlsHandshake(host, cl);
+            break;
     }
 
-    vlc_mutex_lock(&host->lock);
-    /* add all socket that should be read/write and close dead connection */
-    vlc_tick_t now = vlc_tick_now();
-    int delay = -1;
-    httpd_client_t *cl;
+    if (cl->i_state == HTTPD_CLIENT_DEAD
+     || (host->timeout_sec > 0 && cl->i_timeout_date < now)) {
+        host->client_count--;
+        httpd_ClientDestroy(cl);
+        return -1;
+    }
 
-    int canc = vlc_savecancel();
-    vlc_list_foreach(cl, &host->clients, node) {
-        int val = -1;
+    if (val == 0) {
+        cl->i_timeout_date = now + VLC_TICK_FROM_SEC(host->timeout_sec);
+        *delay = 0;
+    }
 
-        switch (cl->i_state) {
-            case HTTPD_CLIENT_RECEIVING:
-                val = httpd_ClientRecv(cl);
-                break;
-            case HTTPD_CLIENT_SENDING:
-                val = httpd_ClientSend(cl);
-                break;
-            case HTTPD_CLIENT_TLS_HS_IN:
-            case HTTPD_CLIENT_TLS_HS_OUT:
-                httpd_ClientTlsHandshake(host, cl);
-                break;
-        }
+    pufd->events = pufd->revents = 0;
 
-        if (cl->i_state == HTTPD_CLIENT_DEAD
-         || (host->timeout_sec > 0 && cl->i_timeout_date < now)) {
-            host->client_count--;
-            httpd_ClientDestroy(cl);
-            continue;
-        }
+    switch (cl->i_state) {
+        case HTTPD_CLIENT_RECEIVING:
+        case HTTPD_CLIENT_TLS_HS_IN:
+            pufd->events = POLLIN;
+            break;
 
-        if (val == 0) {
-            cl->i_timeout_date = now + VLC_TICK_FROM_SEC(host->timeout_sec);
-            delay = 0;
-        }
+        case HTTPD_CLIENT_SENDING:
+        case HTTPD_CLIENT_TLS_HS_OUT:
+            pufd->events = POLLOUT;
+            break;
 
-        struct pollfd *pufd = ufd + nfd;
-        assert (pufd < ufd + ARRAY_SIZE (ufd));
+        case HTTPD_CLIENT_RECEIVE_DONE: {
+            httpd_message_t *answer = &cl->answer;
+            httpd_message_t *query  = &cl->query;
+
+            httpd_MsgInit(answer);
+
+            /* Handle what we received */
+            switch (query->i_type) {
+                case HTTPD_MSG_ANSWER:
+                    cl->url     = NULL;
+                    cl->i_state = HTTPD_CLIENT_DEAD;
+                    break;
+
+                case HTTPD_MSG_OPTIONS:
+                    answer->i_type   = HTTPD_MSG_ANSWER;
+                    answer->i_proto  = query->i_proto;
+                    answer->i_status = 200;
+                    answer->i_body = 0;
+                    answer->p_body = NULL;
+
+                    httpd_MsgAdd(answer, "Server", "VLC/%s", VERSION);
+                    httpd_MsgAdd(answer, "Content-Length", "0");
+
+                    switch(query->i_proto) {
+                    case HTTPD_PROTO_HTTP:
+                        answer->i_version = 1;
+                        httpd_MsgAdd(answer, "Allow", "GET,HEAD,POST,OPTIONS");
+                        break;
 
-        pufd->events = pufd->revents = 0;
+                    case HTTPD_PROTO_RTSP:
+                        answer->i_version = 0;
 
-        switch (cl->i_state) {
-            case HTTPD_CLIENT_RECEIVING:
-            case HTTPD_CLIENT_TLS_HS_IN:
-                pufd->events = POLLIN;
-                break;
+                        const char *p = httpd_MsgGet(query, "Cseq");
+                        if (p)
+                            httpd_MsgAdd(answer, "Cseq", "%s", p);
+                        p = httpd_MsgGet(query, "Timestamp");
+                        if (p)
+                            httpd_MsgAdd(answer, "Timestamp", "%s", p);
 
-            case HTTPD_CLIENT_SENDING:
-            case HTTPD_CLIENT_TLS_HS_OUT:
-                pufd->events = POLLOUT;
-                break;
+                        p = httpd_MsgGet(query, "Require");
+                        if (p) {
+                            answer->i_status = 551;
+                            httpd_MsgAdd(query, "Unsupported", "%s", p);
+                        }
 
-            case HTTPD_CLIENT_RECEIVE_DONE: {
-                httpd_message_t *answer = &cl->answer;
-                httpd_message_t *query  = &cl->query;
+                        httpd_MsgAdd(answer, "Public", "DESCRIBE,SETUP,"
+                                "TEARDOWN,PLAY,PAUSE,GET_PARAMETER");
+                        break;
+                    }
 
-                httpd_MsgInit(answer);
+                    if (httpd_MsgGet(&cl->query, "Connection") != NULL)
+                        httpd_MsgAdd(answer, "Connection", "close");
 
-                /* Handle what we received */
-                switch (query->i_type) {
-                    case HTTPD_MSG_ANSWER:
-                        cl->url     = NULL;
-                        cl->i_state = HTTPD_CLIENT_DEAD;
-                        break;
+                    cl->i_buffer = -1;  /* Force the creation of the answer in
+                                         * httpd_ClientSend */
+                    cl->i_state = HTTPD_CLIENT_SENDING;
+                    break;
 
-                    case HTTPD_MSG_OPTIONS:
+                case HTTPD_MSG_NONE:
+                    if (query->i_proto == HTTPD_PROTO_NONE) {
+                        cl->url = NULL;
+                        cl->i_state = HTTPD_CLIENT_DEAD;
+                    } else {
+                        /* unimplemented */
+                        answer->i_proto  = query->i_proto ;
                         answer->i_type   = HTTPD_MSG_ANSWER;
-                        answer->i_proto  = query->i_proto;
-                        answer->i_status = 200;
-                        answer->i_body = 0;
-                        answer->p_body = NULL;
+                        answer->i_version= 0;
+                        answer->i_status = 501;
 
-                        httpd_MsgAdd(answer, "Server", "VLC/%s", VERSION);
-                        httpd_MsgAdd(answer, "Content-Length", "0");
+                        char *p;
+                        answer->i_body = httpd_HtmlError (&p, 501, NULL);
+                        answer->p_body = (uint8_t *)p;
+                        httpd_MsgAdd(answer, "Content-Length", "%d", answer->i_body);
+                        httpd_MsgAdd(answer, "Connection", "close");
 
-                        switch(query->i_proto) {
-                        case HTTPD_PROTO_HTTP:
-                            answer->i_version = 1;
-                            httpd_MsgAdd(answer, "Allow", "GET,HEAD,POST,OPTIONS");
-                            break;
-
-                        case HTTPD_PROTO_RTSP:
-                            answer->i_version = 0;
+                        cl->i_buffer = -1;  /* Force the creation of the answer in httpd_ClientSend */
+                        cl->i_state = HTTPD_CLIENT_SENDING;
+                    }
+                    break;
 
-                            const char *p = httpd_MsgGet(query, "Cseq");
-                            if (p)
-                                httpd_MsgAdd(answer, "Cseq", "%s", p);
-                            p = httpd_MsgGet(query, "Timestamp");
-                            if (p)
-                                httpd_MsgAdd(answer, "Timestamp", "%s", p);
+                default: {
+                    httpd_url_t *url;
+                    int i_msg = query->i_type;
+                    bool b_auth_failed = false;
 
-                            p = httpd_MsgGet(query, "Require");
-                            if (p) {
-                                answer->i_status = 551;
-                                httpd_MsgAdd(query, "Unsupported", "%s", p);
-                            }
+                    /* Search the url and trigger callbacks */
+                    vlc_list_foreach(url, &host->urls, node) {
+                        if (strcmp(url->psz_url, query->psz_url))
+                            continue;
+                        if (!url->catch[i_msg].cb)
+                            continue;
 
-                            httpd_MsgAdd(answer, "Public", "DESCRIBE,SETUP,"
-                                    "TEARDOWN,PLAY,PAUSE,GET_PARAMETER");
-                            break;
+                        if (answer) {
+                            b_auth_failed = !httpdAuthOk(url->psz_user,
+                               url->psz_password,
+                               httpd_MsgGet(query, "Authorization")); /* BASIC id */
+                            if (b_auth_failed)
+                               break;
                         }
 
-                        if (httpd_MsgGet(&cl->query, "Connection") != NULL)
-                            httpd_MsgAdd(answer, "Connection", "close");
+                        if (url->catch[i_msg].cb(url->catch[i_msg].p_sys, cl, answer, query))
+                            continue;
 
-                        cl->i_buffer = -1;  /* Force the creation of the answer in
-                                             * httpd_ClientSend */
-                        cl->i_state = HTTPD_CLIENT_SENDING;
-                        break;
+                        if (answer->i_proto == HTTPD_PROTO_NONE)
+                            cl->i_buffer = cl->i_buffer_size; /* Raw answer from a CGI */
+                        else
+                            cl->i_buffer = -1;
 
-                    case HTTPD_MSG_NONE:
-                        if (query->i_proto == HTTPD_PROTO_NONE) {
-                            cl->url = NULL;
-                            cl->i_state = HTTPD_CLIENT_DEAD;
-                        } else {
-                            /* unimplemented */
-                            answer->i_proto  = query->i_proto ;
-                            answer->i_type   = HTTPD_MSG_ANSWER;
-                            answer->i_version= 0;
-                            answer->i_status = 501;
-
-                            char *p;
-                            answer->i_body = httpd_HtmlError (&p, 501, NULL);
-                            answer->p_body = (uint8_t *)p;
-                            httpd_MsgAdd(answer, "Content-Length", "%d", answer->i_body);
+                        /* only one url can answer */
+                        answer = NULL;
+                        if (!cl->url)
+                            cl->url = url;
+                    }
+
+                    if (answer) {
+                        answer->i_proto  = query->i_proto;
+                        answer->i_type   = HTTPD_MSG_ANSWER;
+                        answer->i_version= 0;
+
+                       if (b_auth_failed) {
+                            httpd_MsgAdd(answer, "WWW-Authenticate",
+                                    "Basic realm=\"VLC stream\"");
+                            answer->i_status = 401;
+                        } else
+                            answer->i_status = 404; /* no url registered */
+
+                        char *p;
+                        answer->i_body = httpd_HtmlError (&p, answer->i_status,
+                                query->psz_url);
+                        answer->p_body = (uint8_t *)p;
+
+                        cl->i_buffer = -1;  /* Force the creation of the answer in httpd_ClientSend */
+                        httpd_MsgAdd(answer, "Content-Length", "%d", answer->i_body);
+                        httpd_MsgAdd(answer, "Content-Type", "%s", "text/html");
+                        if (httpd_MsgGet(&cl->query, "Connection") != NULL)
                             httpd_MsgAdd(answer, "Connection", "close");
+                    }
 
-                            cl->i_buffer = -1;  /* Force the creation of the answer in httpd_ClientSend */
-                            cl->i_state = HTTPD_CLIENT_SENDING;
-                        }
-                        break;
+                    cl->i_state = HTTPD_CLIENT_SENDING;
+                }
+            }
+            break;
+        }
 
-                    default: {
-                        httpd_url_t *url;
-                        int i_msg = query->i_type;
-                        bool b_auth_failed = false;
-
-                        /* Search the url and trigger callbacks */
-                        vlc_list_foreach(url, &host->urls, node) {
-                            if (strcmp(url->psz_url, query->psz_url))
-                                continue;
-                            if (!url->catch[i_msg].cb)
-                                continue;
-
-                            if (answer) {
-                                b_auth_failed = !httpdAuthOk(url->psz_user,
-                                   url->psz_password,
-                                   httpd_MsgGet(query, "Authorization")); /* BASIC id */
-                                if (b_auth_failed)
-                                   break;
-                            }
-
-                            if (url->catch[i_msg].cb(url->catch[i_msg].p_sys, cl, answer, query))
-                                continue;
-
-                            if (answer->i_proto == HTTPD_PROTO_NONE)
-                                cl->i_buffer = cl->i_buffer_size; /* Raw answer from a CGI */
-                            else
-                                cl->i_buffer = -1;
-
-                            /* only one url can answer */
-                            answer = NULL;
-                            if (!cl->url)
-                                cl->url = url;
-                        }
+        case HTTPD_CLIENT_SEND_DONE:
+            if (!cl->b_stream_mode || cl->answer.i_body_offset == 0) {
+                bool do_close = false;
 
-                        if (answer) {
-                            answer->i_proto  = query->i_proto;
-                            answer->i_type   = HTTPD_MSG_ANSWER;
-                            answer->i_version= 0;
-
-                           if (b_auth_failed) {
-                                httpd_MsgAdd(answer, "WWW-Authenticate",
-                                        "Basic realm=\"VLC stream\"");
-                                answer->i_status = 401;
-                            } else
-                                answer->i_status = 404; /* no url registered */
-
-                            char *p;
-                            answer->i_body = httpd_HtmlError (&p, answer->i_status,
-                                    query->psz_url);
-                            answer->p_body = (uint8_t *)p;
-
-                            cl->i_buffer = -1;  /* Force the creation of the answer in httpd_ClientSend */
-                            httpd_MsgAdd(answer, "Content-Length", "%d", answer->i_body);
-                            httpd_MsgAdd(answer, "Content-Type", "%s", "text/html");
-                            if (httpd_MsgGet(&cl->query, "Connection") != NULL)
-                                httpd_MsgAdd(answer, "Connection", "close");
-                        }
+                cl->url = NULL;
 
-                        cl->i_state = HTTPD_CLIENT_SENDING;
-                    }
+                if (cl->query.i_proto != HTTPD_PROTO_HTTP
+                 || cl->query.i_version > 0)
+                {
+                    const char *psz_connection = httpd_MsgGet(&cl->answer,
+                                                             "Connection");
+                    if (psz_connection != NULL)
+                        do_close = !strcasecmp(psz_connection, "close");
                 }
-                break;
+                else
+                    do_close = true;
+
+                if (!do_close) {
+                    httpd_MsgClean(&cl->query);
+                    httpd_MsgInit(&cl->query);
+
+                    cl->i_buffer = 0;
+                    cl->i_buffer_size = 1000;
+                    free(cl->p_buffer);
+                    // Allocate an extra byte for the null terminating byte
+                    cl->p_buffer = xmalloc(cl->i_buffer_size + 1);
+                    cl->i_state = HTTPD_CLIENT_RECEIVING;
+                } else
+                    cl->i_state = HTTPD_CLIENT_DEAD;
+                httpd_MsgClean(&cl->answer);
+            } else {
+                int64_t i_offset = cl->answer.i_body_offset;
+                httpd_MsgClean(&cl->answer);
+
+                cl->answer.i_body_offset = i_offset;
+                free(cl->p_buffer);
+                cl->p_buffer = NULL;
+                cl->i_buffer = 0;
+                cl->i_buffer_size = 0;
+
+                cl->i_state = HTTPD_CLIENT_WAITING;
             }
+            break;
 
-            case HTTPD_CLIENT_SEND_DONE:
-                if (!cl->b_stream_mode || cl->answer.i_body_offset == 0) {
-                    bool do_close = false;
+        case HTTPD_CLIENT_WAITING: {
+            int64_t i_offset = cl->answer.i_body_offset;
+            int i_msg = cl->query.i_type;
 
-                    cl->url = NULL;
+            httpd_MsgInit(&cl->answer);
+            cl->answer.i_body_offset = i_offset;
 
-                    if (cl->query.i_proto != HTTPD_PROTO_HTTP
-                     || cl->query.i_version > 0)
-                    {
-                        const char *psz_connection = httpd_MsgGet(&cl->answer,
-                                                                 "Connection");
-                        if (psz_connection != NULL)
-                            do_close = !strcasecmp(psz_connection, "close");
-                    }
-                    else
-                        do_close = true;
-
-                    if (!do_close) {
-                        httpd_MsgClean(&cl->query);
-                        httpd_MsgInit(&cl->query);
-
-                        cl->i_buffer = 0;
-                        cl->i_buffer_size = 1000;
-                        free(cl->p_buffer);
-                        // Allocate an extra byte for the null terminating byte
-                        cl->p_buffer = xmalloc(cl->i_buffer_size + 1);
-                        cl->i_state = HTTPD_CLIENT_RECEIVING;
-                    } else
-                        cl->i_state = HTTPD_CLIENT_DEAD;
-                    httpd_MsgClean(&cl->answer);
-                } else {
-                    int64_t i_offset = cl->answer.i_body_offset;
-                    httpd_MsgClean(&cl->answer);
+            cl->url->catch[i_msg].cb(cl->url->catch[i_msg].p_sys, cl,
+                    &cl->answer, &cl->query);
+            if (cl->answer.i_type != HTTPD_MSG_NONE) {
+                /* we have new data, so re-enter send mode */
+                cl->i_buffer      = 0;
+                cl->p_buffer      = cl->answer.p_body;
+                cl->i_buffer_size = cl->answer.i_body;
+                cl->answer.p_body = NULL;
+                cl->answer.i_body = 0;
+                cl->i_state = HTTPD_CLIENT_SENDING;
+            }
+        }
+    }
 
-                    cl->answer.i_body_offset = i_offset;
-                    free(cl->p_buffer);
-                    cl->p_buffer = NULL;
-                    cl->i_buffer = 0;
-                    cl->i_buffer_size = 0;
+    pufd->fd = vlc_tls_GetPollFD(cl->sock, &pufd->events);
 
-                    cl->i_state = HTTPD_CLIENT_WAITING;
-                }
-                break;
+    /* we will wait 20ms (not too big) if HTTPD_CLIENT_WAITING */
+    if (pufd->events == 0 && *delay != 0)
+        *delay = 20;
+    return 0;
+}
 
-            case HTTPD_CLIENT_WAITING: {
-                int64_t i_offset = cl->answer.i_body_offset;
-                int i_msg = cl->query.i_type;
+/* Accepts one pending connection on the given listening socket */
+static void httpdAccept(httpd_host_t *host, int fd, vlc_tick_t now)
+{
+    httpd_client_t *cl;
 
-                httpd_MsgInit(&cl->answer);
-                cl->answer.i_body_offset = i_offset;
+    fd = vlc_accept (fd, NULL, NULL, true);
+    if (fd == -1)
+        return;
+    setsockopt (fd, SOL_SOCKET, SO_REUSEADDR,
+            &(int){ 1 }, sizeof(int));
 
-                cl->url->catch[i_msg].cb(cl->url->catch[i_msg].p_sys, cl,
-                        &cl->answer, &cl->query);
-                if (cl->answer.i_type != HTTPD_MSG_NONE) {
-                    /* we have new data, so re-enter send mode */
-                    cl->i_buffer      = 0;
-                    cl->p_buffer      = cl->answer.p_body;
-                    cl->i_buffer_size = cl->answer.i_body;
-                    cl->answer.p_body = NULL;
-                    cl->answer.i_body = 0;
-                    cl->i_state = HTTPD_CLIENT_SENDING;
-                }
-            }
+    vlc_tls_t *sk = vlc_tls_SocketOpen(fd);
+    if (unlikely(sk == NULL))
+    {
+        vlc_close(fd);
+        return;
+    }
+
+    if (host->p_tls != NULL)
+    {
+        const char *alpn[] = { "http/1.1", NULL };
+        vlc_tls_t *tls;
+
+        tls = vlc_tls_ServerSessionCreate(host->p_tls, sk, alpn);
+        if (tls == NULL)
+        {
+            vlc_tls_SessionDelete(sk);
+            return;
+        }
+        sk = tls;
+    }
+
+    cl = httpd_ClientNew(sk);
+
+    if (unlikely(cl == NULL))
+    {
+        vlc_tls_Close(sk);
+        return;
+    }
+
+    if (host->p_tls != NULL)
+        cl->i_state = HTTPD_CLIENT_TLS_HS_OUT;
+
+    cl->i_timeout_date = now + VLC_TICK_FROM_SEC(host->timeout_sec);
+    host->client_count++;
+    vlc_list_append(&cl->node, &host->clients);
+}
+
+static void httpdLoop(httpd_host_t *host)
+{
+#ifndef HAVE_EPOLL_CREATE1
+    struct pollfd ufd[host->nfd + host->client_count];
+    unsigned nfd;
+    for (nfd = 0; nfd < host->nfd; nfd++) {
+        ufd[nfd].fd = host->fds[nfd];
+        ufd[nfd].events = POLLIN;
+        ufd[nfd].revents = 0;
+    }
+#endif
+
+    vlc_mutex_lock(&host->lock);
+    /* add all socket that should be read/write and close dead connection */
+    vlc_tick_t now = vlc_tick_now();
+    int delay = -1;
+    httpd_client_t *cl;
+
+    int canc = vlc_savecancel();
+    vlc_list_foreach(cl, &host->clients, node) {
+#ifdef HAVE_EPOLL_CREATE1
+        struct pollfd pfd;
+
+        if (httpdClientLoop(host, cl, now, &pfd, &delay))
+            continue; /* closing the socket dropped it from the event set */
+
+        if (pfd.events == 0) {
+            /* Match poll(): a client waiting for no event must not wake the
+             * thread up, and a merely registered socket still reports HUP. */
+            if (cl->i_epoll_events > 0
+             && epoll_ctl(host->evfd, EPOLL_CTL_DEL, pfd.fd, NULL) == 0)
+                cl->i_epoll_events = -1;
+        } else if (pfd.events != cl->i_epoll_events) {
+            struct epoll_event ev = { .data.fd = -1 };
+            int op = (cl->i_epoll_events > 0) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+
+            if (pfd.events & POLLIN)
+                ev.events |= EPOLLIN;
+            if (pfd.events & POLLOUT)
+                ev.events |= EPOLLOUT;
+
+            if (epoll_ctl(host->evfd, op, pfd.fd, &ev) == 0)
+                cl->i_epoll_events = pfd.events;
         }
+#else
+        struct pollfd *pufd = ufd + nfd;
+        assert (pufd < ufd + ARRAY_SIZE (ufd));
 
-        pufd->fd = vlc_tls_GetPollFD(cl->sock, &pufd->events);
+        if (httpdClientLoop(host, cl, now, pufd, &delay))
+            continue;
 
         if (pufd->events != 0)
             nfd++;
-        /* we will wait 20ms (not too big) if HTTPD_CLIENT_WAITING */
-        else if (delay != 0)
-            delay = 20;
+#endif
     }
     vlc_mutex_unlock(&host->lock);
     vlc_restorecancel(canc);
 
+#ifdef HAVE_EPOLL_CREATE1
+    struct epoll_event events[64];
+    int nev;
+
+    while ((nev = epoll_wait(host->evfd, events, ARRAY_SIZE(events),
+                             delay)) < 0)
+    {
+        if (errno != EINTR)
+            msg_Err(host, "polling error: %s", vlc_strerror_c(errno));
+    }
+#else
     while (poll(ufd, nfd, delay) < 0)
     {
         if (errno != EINTR)
             msg_Err(host, "polling error: %s", vlc_strerror_c(errno));
     }
+#endif
 
     canc = vlc_savecancel();
     vlc_mutex_lock(&host->lock);
 
-    /* Handle client sockets */
-    now = vlc_tick_now();
-    nfd = host->nfd;
-
     /* Handle server sockets (accept new connections) */
+    now = vlc_tick_now();
+#ifdef HAVE_EPOLL_CREATE1
+    for (int i = 0; i < nev; i++)
+        if (events[i].data.fd != -1)
+            httpdAccept(host, events[i].data.fd, now);
+#else
     for (nfd = 0; nfd < host->nfd; nfd++) {
-        int fd = ufd[nfd].fd;
-
-        assert (fd == host->fds[nfd]);
+        assert (ufd[nfd].fd == host->fds[nfd]);
 
-        if (ufd[nfd].revents == 0)
-            continue;
-
-        /* */
-        fd = vlc_accept (fd, NULL, NULL, true);
-        if (fd == -1)
-            continue;
-        setsockopt (fd, SOL_SOCKET, SO_REUSEADDR,
-                &(int){ 1 }, sizeof(int));
-
-        vlc_tls_t *sk = vlc_tls_SocketOpen(fd);
-        if (unlikely(sk == NULL))
-        {
-            vlc_close(fd);
-            continue;
-        }
-
-        if (host->p_tls != NULL)
-        {
-            const char *alpn[] = { "http/1.1", NULL };
-            vlc_tls_t *tls;
-
-            tls = vlc_tls_ServerSessionCreate(host->p_tls, sk, alpn);
-            if (tls == NULL)
-            {
-                vlc_tls_SessionDelete(sk);
-                continue;
-            }
-            sk = tls;
-        }
-
-        cl = httpd_ClientNew(sk);
-
-        if (unlikely(cl == NULL))
-        {
-            vlc_tls_Close(sk);
-            continue;
-        }
-
-        if (host->p_tls != NULL)
-            cl->i_state = HTTPD_CLIENT_TLS_HS_OUT;
-
-        cl->i_timeout_date = now + VLC_TICK_FROM_SEC(host->timeout_sec);
-        host->client_count++;
-        vlc_list_append(&cl->node, &host->clients);
+        if (ufd[nfd].revents != 0)
+            httpdAccept(host, ufd[nfd].fd, now);
     }
+#endif
 
     vlc_mutex_unlock(&host->lock);
     vlc_restorecancel(canc);
@@ -116,6 +116,80 @@ int net_Socket (vlc_object_t *p_this, int family, int socktype,
     return fd;
 }
 
+/* Maximum number of simultaneous connection attempts (RFC 8305 §5) */
+#define NET_CONNECT_PARALLEL 4
+/* Delay before the next address is also tried (RFC 8305 §5) */
+#define NET_CONNECT_DELAY    VLC_TICK_FROM_MS(250)
+
+/**
+ * Reorders resolver results so that address families alternate, as
+ * recommended by RFC 8305 §4: if the preferred family is down, the very
+ * next attempt then uses the other one.
+ */
+static struct addrinfo *net_InterleaveAddresses(struct addrinfo *res)
+{
+    struct addrinfo *head = NULL, **tail = &head;
+
+    while (res != NULL)
+    {
+        int family = res->ai_family;
+        struct addrinfo *p = res;
+
+        res = p->ai_next;
+        p->ai_next = NULL;
+        *tail = p;
+        tail = &p->ai_next;
+
+        /* then the first address of a different family, if any */
+        struct addrinfo **pp = &res;
+
+        while (*pp != NULL && (*pp)->ai_family == family)
+            pp = &(*pp)->ai_next;
+        if (*pp != NULL)
+        {
+            p = *pp;
+            *pp = p->ai_next;
+            p->ai_next = NULL;
+            *tail = p;
+            tail = &p->ai_next;
+        }
+    }
+    return head;
+}
+
+/**
+ * Starts one non-blocking connection attempt.
+ * Returns the socket, or -1 on immediate failure. *connected is set if the
+ * connection already completed (e.g. on the loopback).
+ */
+static int net_ConnectAttempt(vlc_object_t *obj, const struct addrinfo *ptr,
+                              bool *restrict connected)
+{
+    int fd = net_Socket(obj, ptr->ai_family, ptr->ai_socktype,
+                        ptr->ai_protocol);
+    if (fd == -1)
+    {
+        msg_Dbg(obj, "socket error: %s", vlc_strerror_c(net_errno));
+        return -1;
+    }
+
+    if (connect(fd, ptr->ai_addr, ptr->ai_addrlen) == 0)
+    {
+        *connected = true;
+        return fd;
+    }
+
+    if (net_errno != EINPROGRESS && errno != EINTR)
+    {
+        msg_Err(obj, "connection failed: %s", vlc_strerror_c(net_errno));
+        net_Close(fd);
+        return -1;
+    }
+
+    *connected = false;
+    return fd;
+}
+
 int (net_Connect)(vlc_object_t *obj, const char *host, int serv,
                   int type, int proto)
 {
@@ -137,74 +211,98 @@ int (net_Connect)(vlc_object_t *obj, const char *host, int serv,
     vlc_tick_t timeout = VLC_TICK_FROM_MS(var_InheritInteger(obj,
                                                              "ipv4-timeout"));
 
-    for (struct addrinfo *ptr = res; ptr != NULL; ptr = ptr->ai_next)
+    /* Happy eyeballs (RFC 8305): addresses are tried in a staggered,
+     * parallel fashion, so one dead address (typically a stale AAAA
+     * record) delays the connection by NET_CONNECT_DELAY instead of a
+     * full timeout. The first attempt to complete wins. */
+    res = net_InterleaveAddresses(res);
+
+    struct pollfd ufd[NET_CONNECT_PARALLEL];
+    unsigned nfd = 0;
+    const struct addrinfo *ptr = res;
+    vlc_tick_t deadline = vlc_tick_now() + timeout;
+    vlc_tick_t next_attempt = VLC_TICK_INVALID;
+
+    while (ret == -1)
     {
-        int fd = net_Socket(obj, ptr->ai_family,
-                            ptr->ai_socktype, ptr->ai_protocol);
-        if (fd == -1)
-        {
-            msg_Dbg(obj, "socket error: %s", vlc_strerror_c(net_errno));
-            continue;
-        }
+        vlc_tick_t now = vlc_tick_now();
 
-        if (connect(fd, ptr->ai_addr, ptr->ai_addrlen))
+        while (ptr != NULL && nfd < NET_CONNECT_PARALLEL
+            && (nfd == 0 || next_attempt <= now))
         {
-            if (net_errno != EINPROGRESS && errno != EINTR)
+            bool connected;
+            int fd = net_ConnectAttempt(obj, ptr, &connected);
+
+            ptr = ptr->ai_next;
+
+            if (fd == -1)
+                continue;
+            if (connected)
             {
-                msg_Err(obj, "connection failed: %s",
-                        vlc_strerror_c(net_errno));
-                goto next_ai;
+                ret = fd;
+                break;
             }
 
-            struct pollfd ufd;
-            vlc_tick_t deadline = VLC_TICK_INVALID;
-
-            ufd.fd = fd;
-            ufd.events = POLLOUT;
-            deadline = vlc_tick_now() + timeout;
+            ufd[nfd].fd = fd;
+            ufd[nfd].events = POLLOUT;
+            nfd++;
+            next_attempt = now + NET_CONNECT_DELAY;
+        }
 
-            do
-            {
-                vlc_tick_t now = vlc_tick_now();
+        if (ret != -1 || nfd == 0 /* every address failed */
+         || vlc_killed())
+            break;
 
-                if (vlc_killed())
-                    goto next_ai;
+        if (now > deadline)
+        {
+            msg_Warn(obj, "connection timed out");
+            break;
+        }
 
-                if (now > deadline)
-                    now = deadline;
+        vlc_tick_t wakeup = deadline;
+        if (ptr != NULL && nfd < NET_CONNECT_PARALLEL && next_attempt < wakeup)
+            wakeup = next_attempt;
 
-                val = vlc_poll_i11e(&ufd, 1, MS_FROM_VLC_TICK(deadline - now));
-            }
-            while (val == -1 && errno == EINTR);
+        val = vlc_poll_i11e(ufd, nfd, MS_FROM_VLC_TICK(wakeup - now));
+        if (val == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            msg_Err(obj, "polling error: %s", vlc_strerror_c(errno));
+            break;
+        }
 
-            switch (val)
+        for (unsigned i = 0; i < nfd;)
+        {
+            if (ufd[i].revents == 0)
             {
-                 case -1: /* error */
-                     msg_Err(obj, "polling error: %s", vlc_strerror_c(errno));
-                     goto next_ai;
-
-                 case 0: /* timeout */
-                     msg_Warn(obj, "connection timed out");
-                     goto next_ai;
+                i++;
+                continue;
             }
 
             /* There is NO WAY around checking SO_ERROR.
              * Don't ifdef it out!!! */
-            if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &val,
+            if (getsockopt(ufd[i].fd, SOL_SOCKET, SO_ERROR, &val,
                            &(socklen_t){ sizeof (val) }) || val)
             {
                 msg_Err(obj, "connection failed: %s", vlc_strerror_c(val));
-                goto next_ai;
+                net_Close(ufd[i].fd);
+                ufd[i] = ufd[--nfd];
+                continue;
             }
+
+            ret = ufd[i].fd; /* success! */
+            ufd[i] = ufd[--nfd];
+            break;
         }
+    }
 
-        msg_Dbg(obj, "connection succeeded (socket = %d)", fd);
-        ret = fd; /* success! */
-        break;
+    /* close the losing attempts */
+    for (unsigned i = 0; i < nfd; i++)
+        net_Close(ufd[i].fd);
 
-next_ai: /* failure */
-        net_Close(fd);
-    }
+    if (ret != -1)
+        msg_Dbg(obj, "connection succeeded (socket = %d)", ret);
 
     freeaddrinfo(res);
     return ret;
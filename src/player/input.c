@@ -27,6 +27,11 @@
 #include <vlc_memstream.h>
 #include "player.h"
 
+/* Minimum system-clock delay between two coalesced listener events, roughly
+ * one UI refresh interval. Timers are not affected: they have their own
+ * min_period (see vlc_player_AddTimer()). */
+#define VLC_PLAYER_EVENT_MIN_PERIOD VLC_TICK_FROM_MS(100)
+
 struct vlc_player_track_priv *
 vlc_player_input_FindTrackById(struct vlc_player_input *input, vlc_es_id_t *id,
                                size_t *idx)
@@ -82,6 +87,19 @@ vlc_player_input_GetPos(struct vlc_player_input *input)
     return input->position;
 }
 
+void
+vlc_player_input_FlushScrubSeek(struct vlc_player_input *input)
+{
+    input->scrub.seeking = false;
+    if (!input->scrub.pending)
+        return;
+
+    input->scrub.pending = false;
+    if (input_ControlPush(input->thread, input->scrub.type,
+                          &input->scrub.param) == VLC_SUCCESS)
+        input->scrub.seeking = input->player->scrubbing;
+}
+
 static void
 vlc_player_input_UpdateTime(struct vlc_player_input *input)
 {
@@ -250,6 +268,8 @@ vlc_player_input_HandleState(struct vlc_player_input *input,
     {
         player->global_state = input->state;
         vlc_player_SendEvent(player, on_state_changed, player->global_state);
+
+        vlc_player_UpdateMlBackgroundPolicy(player);
     }
 }
 
@@ -792,10 +812,27 @@ input_thread_Events(input_thread_t *input_thread,
                 input->position = event->times.position;
                 system_date = vlc_tick_now();
                 changed = true;
-                vlc_player_SendEvent(player, on_position_changed,
-                                     input->time, input->position);
+
+                /* Demuxers notify new times at their own (fine) granularity:
+                 * coalesce the listener events to roughly one per UI refresh
+                 * interval. Seeks reset position_event_date so that their
+                 * outcome is delivered without delay. */
+                if (input->position_event_date == VLC_TICK_INVALID
+                 || system_date - input->position_event_date
+                        >= VLC_PLAYER_EVENT_MIN_PERIOD)
+                {
+                    input->position_event_date = system_date;
+                    vlc_player_SendEvent(player, on_position_changed,
+                                         input->time, input->position);
+                }
 
                 vlc_player_input_UpdateTime(input);
+
+                /* A new time means the input thread has caught up with its
+                 * control queue: submit the seek parked by scrub mode, if
+                 * any, now that it is the only one in flight. */
+                if (input->scrub.seeking || input->scrub.pending)
+                    vlc_player_input_FlushScrubSeek(input);
             }
             if (input->length != event->times.length)
             {
@@ -853,9 +890,23 @@ input_thread_Events(input_thread_t *input_thread,
                                  input->signal_quality, input->signal_strength);
             break;
         case INPUT_EVENT_CACHE:
+        {
             input->cache = event->cache;
-            vlc_player_SendEvent(player, on_buffering_changed, event->cache);
+
+            /* Always report the buffering edges, coalesce the intermediate
+             * percentages like position updates */
+            vlc_tick_t system_date = vlc_tick_now();
+            if (event->cache <= 0.f || event->cache >= 1.f
+             || input->buffering_event_date == VLC_TICK_INVALID
+             || system_date - input->buffering_event_date
+                    >= VLC_PLAYER_EVENT_MIN_PERIOD)
+            {
+                input->buffering_event_date = system_date;
+                vlc_player_SendEvent(player, on_buffering_changed,
+                                     event->cache);
+            }
             break;
+        }
         case INPUT_EVENT_VOUT:
             vlc_player_input_HandleVoutEvent(input, &event->vout);
             break;
@@ -954,8 +1005,13 @@ vlc_player_input_New(vlc_player_t *player, input_item_t *item)
     input->pause_date = VLC_TICK_INVALID;
     input->position = 0.f;
 
+    input->position_event_date = VLC_TICK_INVALID;
+    input->buffering_event_date = VLC_TICK_INVALID;
+
     input->recording = false;
 
+    input->scrub.seeking = input->scrub.pending = false;
+
     input->cache = 0.f;
     input->signal_quality = input->signal_strength = -1.f;
 
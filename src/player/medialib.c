@@ -297,3 +297,27 @@ vlc_player_RestorePlaybackPos(vlc_player_t *player)
 {
     vlc_player_input_RestoreMlStates(player->input, true);
 }
+
+void
+vlc_player_UpdateMlBackgroundPolicy(vlc_player_t *player)
+{
+    vlc_player_assert_locked(player);
+
+    vlc_medialibrary_t *ml = vlc_ml_instance_get(player);
+    if (ml == NULL)
+        return;
+
+    /* Pause background discovery/parsing/thumbnailing while actually
+     * playing, so that a library scan does not compete with playback for
+     * disk and CPU. Being paused or stopped resumes the scan. */
+    bool pause = player->global_state == VLC_PLAYER_STATE_PLAYING
+              && var_InheritBool(player, "media-library-pause-on-playback");
+    if (pause == player->ml_background_paused)
+        return;
+
+    player->ml_background_paused = pause;
+    if (pause)
+        vlc_ml_pause_background(ml);
+    else
+        vlc_ml_resume_background(ml);
+}
@@ -51,6 +51,18 @@ static_assert(VLC_PLAYER_TITLE_MENU == INPUT_TITLE_MENU &&
 #define vlc_player_foreach_inputs(it) \
     for (struct vlc_player_input *it = player->input; it != NULL; it = NULL)
 
+static void
+vlc_player_DestroyStandbyInput(vlc_player_t *player)
+{
+    if (player->standby_input == NULL)
+        return;
+
+    /* The standby input was never started and never exposed: delete it
+     * directly, bypassing the destructor state machinery */
+    vlc_player_input_Delete(player->standby_input);
+    player->standby_input = NULL;
+}
+
 void
 vlc_player_PrepareNextMedia(vlc_player_t *player)
 {
@@ -65,6 +77,17 @@ vlc_player_PrepareNextMedia(vlc_player_t *player)
     player->next_media =
         player->media_provider->get_next(player, player->media_provider_data);
     player->next_media_requested = true;
+
+    /* Pre-create the input for the upcoming media so that the media change
+     * only has to start it. Track string ids are applied at input creation
+     * and belong to the current media, so don't warm up an input that would
+     * inherit them. */
+    assert(player->standby_input == NULL);
+    if (player->next_media != NULL
+     && player->video_string_ids == NULL && player->audio_string_ids == NULL
+     && player->sub_string_ids == NULL)
+        player->standby_input =
+            vlc_player_input_New(player, player->next_media);
 }
 
 int
@@ -99,8 +122,19 @@ vlc_player_OpenNextMedia(vlc_player_t *player)
         player->media = player->next_media;
         player->next_media = NULL;
 
-        struct vlc_player_input *input = player->input =
-            vlc_player_input_New(player, player->media);
+        struct vlc_player_input *input;
+        if (player->standby_input != NULL)
+        {
+            /* Promote the input pre-created by
+             * vlc_player_PrepareNextMedia() */
+            input = player->standby_input;
+            player->standby_input = NULL;
+            assert(input_GetItem(input->thread) == player->media);
+        }
+        else
+            input = vlc_player_input_New(player, player->media);
+
+        player->input = input;
         if (!input)
         {
             input_item_Release(player->media);
@@ -1125,6 +1159,7 @@ void
 vlc_player_InvalidateNextMedia(vlc_player_t *player)
 {
     vlc_player_assert_locked(player);
+    vlc_player_DestroyStandbyInput(player);
     if (player->next_media)
     {
         input_item_Release(player->next_media);
@@ -1396,6 +1431,58 @@ vlc_player_DisplayPosition(vlc_player_t *player)
                             VLC_PLAYER_WHENCE_ABSOLUTE);
 }
 
+/* Push a seek request to the input thread or, in scrub mode while a previous
+ * seek is still being resolved, park it until the input reports a new time
+ * (see vlc_player_input_FlushScrubSeek()). Only the latest parked target is
+ * kept; back-to-back relative jumps are accumulated like input_ControlPush()
+ * would coalesce them. */
+static int
+vlc_player_input_PushSeek(struct vlc_player_input *input, int type,
+                          const input_control_param_t *param)
+{
+    vlc_player_t *player = input->player;
+
+    if (player->scrubbing)
+    {
+        if (input->scrub.seeking)
+        {
+            if (input->scrub.pending && type == input->scrub.type
+             && type == INPUT_CONTROL_JUMP_TIME)
+                input->scrub.param.time.i_val += param->time.i_val;
+            else if (input->scrub.pending && type == input->scrub.type
+                  && type == INPUT_CONTROL_JUMP_POSITION)
+                input->scrub.param.pos.f_val += param->pos.f_val;
+            else
+            {
+                input->scrub.type = type;
+                input->scrub.param = *param;
+            }
+            input->scrub.pending = true;
+            return VLC_SUCCESS;
+        }
+        input->scrub.seeking = true;
+    }
+    return input_ControlPush(input->thread, type, param);
+}
+
+void
+vlc_player_SetScrubbing(vlc_player_t *player, bool enabled)
+{
+    vlc_player_assert_locked(player);
+
+    if (player->scrubbing == enabled)
+        return;
+    player->scrubbing = enabled;
+
+    if (enabled)
+        return;
+
+    /* Deliver the last parked request, it is where the user let go */
+    struct vlc_player_input *input = vlc_player_get_input_locked(player);
+    if (input)
+        vlc_player_input_FlushScrubSeek(input);
+}
+
 void
 vlc_player_SeekByPos(vlc_player_t *player, double position,
                      enum vlc_player_seek_speed speed,
@@ -1410,15 +1497,19 @@ vlc_player_SeekByPos(vlc_player_t *player, double position,
     const int type =
         whence == VLC_PLAYER_WHENCE_ABSOLUTE ? INPUT_CONTROL_SET_POSITION
                                              : INPUT_CONTROL_JUMP_POSITION;
-    int ret = input_ControlPush(input->thread, type,
+    int ret = vlc_player_input_PushSeek(input, type,
         &(input_control_param_t) {
             .pos.f_val = position,
             .pos.b_fast_seek = speed == VLC_PLAYER_SEEK_FAST,
     });
 
     if (ret == VLC_SUCCESS)
+    {
+        /* Deliver the post-seek position to listeners without coalescing */
+        input->position_event_date = VLC_TICK_INVALID;
         vlc_player_osd_Position(player, input, VLC_TICK_INVALID, position,
                                 whence);
+    }
 }
 
 void
@@ -1435,14 +1526,18 @@ vlc_player_SeekByTime(vlc_player_t *player, vlc_tick_t time,
     const int type =
         whence == VLC_PLAYER_WHENCE_ABSOLUTE ? INPUT_CONTROL_SET_TIME
                                              : INPUT_CONTROL_JUMP_TIME;
-    int ret = input_ControlPush(input->thread, type,
+    int ret = vlc_player_input_PushSeek(input, type,
         &(input_control_param_t) {
             .time.i_val = time,
             .time.b_fast_seek = speed == VLC_PLAYER_SEEK_FAST,
     });
 
     if (ret == VLC_SUCCESS)
+    {
+        /* Deliver the post-seek position to listeners without coalescing */
+        input->position_event_date = VLC_TICK_INVALID;
         vlc_player_osd_Position(player, input, time, -1, whence);
+    }
 }
 
 void
@@ -1887,11 +1982,21 @@ vlc_player_Delete(vlc_player_t *player)
 {
     vlc_mutex_lock(&player->lock);
 
+    /* Don't leave the media library scan paused forever */
+    if (player->ml_background_paused)
+    {
+        vlc_medialibrary_t *ml = vlc_ml_instance_get(player);
+        if (ml != NULL)
+            vlc_ml_resume_background(ml);
+        player->ml_background_paused = false;
+    }
+
     if (player->input)
     {
         vlc_player_destructor_AddInput(player, player->input);
         player->input = NULL;
     }
+    vlc_player_DestroyStandbyInput(player);
 
     player->deleting = true;
     vlc_cond_signal(&player->destructor.wait);
@@ -1956,8 +2061,10 @@ vlc_player_New(vlc_object_t *parent, enum vlc_player_lock_type lock_type,
     vlc_list_init(&player->destructor.joinable_inputs);
     player->media_stopped_action = VLC_PLAYER_MEDIA_STOPPED_CONTINUE;
     player->start_paused = false;
+    player->scrubbing = false;
     player->pause_on_cork = false;
     player->corked = false;
+    player->ml_background_paused = false;
     player->renderer = NULL;
     player->media_provider = media_provider;
     player->media_provider_data = media_provider_data;
@@ -1972,6 +2079,7 @@ vlc_player_New(vlc_object_t *parent, enum vlc_player_lock_type lock_type,
     player->releasing_media = false;
     player->next_media_requested = false;
     player->next_media = NULL;
+    player->standby_input = NULL;
 
     player->video_string_ids = player->audio_string_ids =
     player->sub_string_ids = NULL;
@@ -72,10 +72,27 @@ struct vlc_player_input
     vlc_tick_t time;
     vlc_tick_t normal_time;
 
+    /** System date of the last on_position_changed event, used to coalesce
+     * per-demux-tick updates (VLC_TICK_INVALID to force the next event) */
+    vlc_tick_t position_event_date;
+    /** System date of the last intermediate on_buffering_changed event */
+    vlc_tick_t buffering_event_date;
+
     vlc_tick_t pause_date;
 
     bool recording;
 
+    /** Scrub mode bookkeeping (see vlc_player_SetScrubbing()): while a seek
+     * is being resolved by the input thread, the latest request is parked
+     * here instead of piling up behind it */
+    struct
+    {
+        bool seeking;
+        bool pending;
+        int type;
+        input_control_param_t param;
+    } scrub;
+
     float signal_quality;
     float signal_strength;
     float cache;
@@ -165,6 +182,7 @@ struct vlc_player_aout_listener_id
 enum vlc_player_timer_source_type
 {
     VLC_PLAYER_TIMER_TYPE_BEST,
+    VLC_PLAYER_TIMER_TYPE_VIDEO,
     VLC_PLAYER_TIMER_TYPE_SMPTE,
     VLC_PLAYER_TIMER_TYPE_COUNT
 };
@@ -224,6 +242,7 @@ struct vlc_player_timer
 
     struct vlc_player_timer_source sources[VLC_PLAYER_TIMER_TYPE_COUNT];
 #define best_source sources[VLC_PLAYER_TIMER_TYPE_BEST]
+#define video_source sources[VLC_PLAYER_TIMER_TYPE_VIDEO]
 #define smpte_source sources[VLC_PLAYER_TIMER_TYPE_SMPTE]
 };
 
@@ -238,12 +257,16 @@ struct vlc_player_t
 
     enum vlc_player_media_stopped_action media_stopped_action;
     bool start_paused;
+    bool scrubbing;
 
     const struct vlc_player_media_provider *media_provider;
     void *media_provider_data;
 
     bool pause_on_cork;
     bool corked;
+    /** True while this player paused the media library background
+     * operations (see vlc_player_UpdateMlBackgroundPolicy()) */
+    bool ml_background_paused;
 
     struct vlc_list listeners;
     struct vlc_list metadata_listeners;
@@ -259,6 +282,9 @@ struct vlc_player_t
     bool releasing_media;
     bool next_media_requested;
     input_item_t *next_media;
+    /* Input pre-created for next_media, never started nor exposed, promoted
+     * by vlc_player_OpenNextMedia() to shorten the media change path */
+    struct vlc_player_input *standby_input;
 
     char *video_string_ids;
     char *audio_string_ids;
@@ -452,6 +478,9 @@ vlc_player_input_HandleState(struct vlc_player_input *, enum vlc_player_state,
 struct vlc_player_timer_point
 vlc_player_input_GetTimerValue(struct vlc_player_input *input);
 
+void
+vlc_player_input_FlushScrubSeek(struct vlc_player_input *input);
+
 /*
  * player_timer.c
 */
@@ -544,4 +573,7 @@ vlc_player_input_RestoreMlStates(struct vlc_player_input* input, bool force_pos)
 void
 vlc_player_UpdateMLStates(vlc_player_t *player, struct vlc_player_input* input);
 
+void
+vlc_player_UpdateMlBackgroundPolicy(vlc_player_t *player);
+
 #endif
@@ -182,7 +182,9 @@ vlc_player_UpdateTimerState(vlc_player_t *player, vlc_es_id_t *es_source,
      * discard the event if it was already signalled or not on the good
      * es_source. */
     bool notify = false;
+    bool notify_video = false;
     struct vlc_player_timer_source *bestsource = &player->timer.best_source;
+    struct vlc_player_timer_source *videosource = &player->timer.video_source;
 
     switch(state)
     {
@@ -193,15 +195,20 @@ vlc_player_UpdateTimerState(vlc_player_t *player, vlc_es_id_t *es_source,
                 struct vlc_player_timer_source *source = &player->timer.sources[i];
                 if (source->es != es_source)
                     continue;
-                /* signal discontinuity only on best source */
+                /* signal discontinuity only on the source owning the es */
                 if (source->point.system_date != VLC_TICK_INVALID)
-                    notify = bestsource->es == es_source;
+                {
+                    if (source == bestsource)
+                        notify = true;
+                    else if (source == videosource)
+                        notify_video = true;
+                }
                 source->point.system_date = VLC_TICK_INVALID;
             }
             break;
 
         case VLC_PLAYER_TIMER_STATE_PAUSED:
-            notify = true;
+            notify = notify_video = true;
             assert(system_date != VLC_TICK_INVALID);
             break;
 
@@ -212,18 +219,25 @@ vlc_player_UpdateTimerState(vlc_player_t *player, vlc_es_id_t *es_source,
 
     player->timer.state = state;
 
-    if (!notify)
+    if (!notify && !notify_video)
     {
         vlc_mutex_unlock(&player->timer.lock);
         return;
     }
 
     vlc_player_timer_id *timer;
-    vlc_list_foreach(timer, &bestsource->listeners, node)
-    {
-        timer->last_update_date = VLC_TICK_INVALID;
-        timer->cbs->on_discontinuity(system_date, timer->data);
-    }
+    if (notify)
+        vlc_list_foreach(timer, &bestsource->listeners, node)
+        {
+            timer->last_update_date = VLC_TICK_INVALID;
+            timer->cbs->on_discontinuity(system_date, timer->data);
+        }
+    if (notify_video)
+        vlc_list_foreach(timer, &videosource->listeners, node)
+        {
+            timer->last_update_date = VLC_TICK_INVALID;
+            timer->cbs->on_discontinuity(system_date, timer->data);
+        }
 
     vlc_mutex_unlock(&player->timer.lock);
 }
@@ -346,6 +360,25 @@ vlc_player_UpdateTimer(vlc_player_t *player, vlc_es_id_t *es_source,
         }
     }
 
+    source = &player->timer.video_source;
+    /* Video source: points are sent by the video output clock each time a
+     * frame is rendered, so the updates are aligned with the display */
+    if (!source->es && es_source && vlc_es_id_GetCat(es_source) == VIDEO_ES)
+        source->es = es_source;
+
+    if (source->es == es_source && source->es
+     && (point->ts != player->timer.last_ts
+      || source->point.system_date != system_date
+      || system_date != VLC_TICK_MAX))
+    {
+        vlc_player_UpdateTimerSource(player, source, point->rate, point->ts,
+                                     system_date);
+
+        if (!vlc_list_is_empty(&source->listeners))
+            vlc_player_SendTimerSourceUpdates(player, source, force_update,
+                                              &source->point);
+    }
+
     source = &player->timer.smpte_source;
     /* SMPTE source: only the video source */
     if (!source->es && es_source && vlc_es_id_GetCat(es_source) == VIDEO_ES)
@@ -437,6 +470,28 @@ vlc_player_AddTimer(vlc_player_t *player, vlc_tick_t min_period,
     return timer;
 }
 
+vlc_player_timer_id *
+vlc_player_AddVideoDisplayTimer(vlc_player_t *player,
+                                const struct vlc_player_timer_cbs *cbs,
+                                void *data)
+{
+    assert(cbs && cbs->on_update);
+
+    struct vlc_player_timer_id *timer = malloc(sizeof(*timer));
+    if (!timer)
+        return NULL;
+    timer->period = VLC_TICK_INVALID;
+    timer->last_update_date = VLC_TICK_INVALID;
+    timer->cbs = cbs;
+    timer->data = data;
+
+    vlc_mutex_lock(&player->timer.lock);
+    vlc_list_append(&timer->node, &player->timer.video_source.listeners);
+    vlc_mutex_unlock(&player->timer.lock);
+
+    return timer;
+}
+
 vlc_player_timer_id *
 vlc_player_AddSmpteTimer(vlc_player_t *player,
                          const struct vlc_player_timer_smpte_cbs *cbs,
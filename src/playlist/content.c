@@ -29,6 +29,7 @@
 #include "notify.h"
 #include "playlist.h"
 #include "preparse.h"
+#include "sort.h"
 
 void
 vlc_playlist_ClearItems(vlc_playlist_t *playlist)
@@ -298,6 +299,9 @@ vlc_playlist_Move(vlc_playlist_t *playlist, size_t index, size_t count,
 
     vlc_vector_move_slice(&playlist->items, index, count, target);
 
+    /* the playlist order is changed manually, it may not be sorted anymore */
+    vlc_playlist_ResetSortCriteria(playlist);
+
     vlc_playlist_ItemsMoved(playlist, index, count, target);
     vlc_player_InvalidateNextMedia(playlist->player);
 }
@@ -29,6 +29,7 @@
 #include "content.h"
 #include "item.h"
 #include "player.h"
+#include "preparse.h"
 
 vlc_playlist_t *
 vlc_playlist_New(vlc_object_t *parent)
@@ -53,6 +54,9 @@ vlc_playlist_New(vlc_object_t *parent)
     playlist->repeat = VLC_PLAYLIST_PLAYBACK_REPEAT_NONE;
     playlist->order = VLC_PLAYLIST_PLAYBACK_ORDER_NORMAL;
     playlist->idgen = 0;
+    playlist->sort_criteria = NULL;
+    playlist->sort_criteria_count = 0;
+    vlc_vector_init(&playlist->expand_cursors);
 #ifdef TEST_PLAYLIST
     playlist->libvlc = NULL;
     playlist->auto_preparse = false;
@@ -73,6 +77,8 @@ vlc_playlist_Delete(vlc_playlist_t *playlist)
     vlc_playlist_PlayerDestroy(playlist);
     randomizer_Destroy(&playlist->randomizer);
     vlc_playlist_ClearItems(playlist);
+    vlc_playlist_ExpandCursorsClear(playlist);
+    free(playlist->sort_criteria);
     free(playlist);
 }
 
@@ -45,6 +45,16 @@ typedef struct input_item_t input_item_t;
 
 typedef struct VLC_VECTOR(vlc_playlist_item_t *) playlist_item_vector_t;
 
+/* in-flight chunked subtree expansion (see playlist/preparse.c) */
+struct vlc_playlist_expand_cursor
+{
+    input_item_t *media; /* the media being expanded (held) */
+    uint64_t last_item_id; /* id of the last child inserted so far */
+};
+
+typedef struct VLC_VECTOR(struct vlc_playlist_expand_cursor)
+        expand_cursor_vector_t;
+
 struct vlc_playlist
 {
     vlc_player_t *player;
@@ -61,6 +71,11 @@ struct vlc_playlist
     enum vlc_playlist_playback_repeat repeat;
     enum vlc_playlist_playback_order order;
     uint64_t idgen;
+    /* last sort criteria applied, used by vlc_playlist_InsertSorted();
+     * NULL/0 if the playlist is not known to be sorted (see sort.c) */
+    struct vlc_playlist_sort_criterion *sort_criteria;
+    size_t sort_criteria_count;
+    expand_cursor_vector_t expand_cursors;
 };
 
 /* Also disable vlc_assert_locked in tests since the symbol is not exported */
@@ -62,18 +62,110 @@ vlc_playlist_ExpandItem(vlc_playlist_t *playlist, size_t index,
     return ret;
 }
 
+/* Do not track more in-flight expansions, in case an expand cursor is never
+ * cleaned up (its parse not ending through on_preparse_ended()) */
+#define EXPAND_CURSOR_MAX 32
+
+static ssize_t
+vlc_playlist_ExpandCursorFind(vlc_playlist_t *playlist, input_item_t *media)
+{
+    for (size_t i = 0; i < playlist->expand_cursors.size; ++i)
+        if (playlist->expand_cursors.data[i].media == media)
+            return i;
+    return -1;
+}
+
+static void
+vlc_playlist_ExpandCursorRemove(vlc_playlist_t *playlist, size_t index)
+{
+    input_item_Release(playlist->expand_cursors.data[index].media);
+    vlc_vector_remove(&playlist->expand_cursors, index);
+}
+
+void
+vlc_playlist_ExpandCursorsClear(vlc_playlist_t *playlist)
+{
+    while (playlist->expand_cursors.size)
+        vlc_playlist_ExpandCursorRemove(playlist,
+                                        playlist->expand_cursors.size - 1);
+    vlc_vector_destroy(&playlist->expand_cursors);
+}
+
+static void
+vlc_playlist_ExpandCursorUpdate(vlc_playlist_t *playlist, input_item_t *media,
+                                uint64_t last_item_id)
+{
+    ssize_t i = vlc_playlist_ExpandCursorFind(playlist, media);
+    if (i != -1)
+    {
+        playlist->expand_cursors.data[i].last_item_id = last_item_id;
+        return;
+    }
+
+    if (playlist->expand_cursors.size >= EXPAND_CURSOR_MAX)
+        vlc_playlist_ExpandCursorRemove(playlist, 0); /* drop the oldest */
+
+    struct vlc_playlist_expand_cursor cursor = {
+        .media = input_item_Hold(media),
+        .last_item_id = last_item_id,
+    };
+    if (!vlc_vector_push(&playlist->expand_cursors, cursor))
+        input_item_Release(media); /* not fatal, later chunks are dropped */
+}
+
 int
 vlc_playlist_ExpandItemFromNode(vlc_playlist_t *playlist,
                                 input_item_node_t *subitems)
 {
     vlc_playlist_AssertLocked(playlist);
     input_item_t *media = subitems->p_item;
+
+    /* The subtree may arrive in several chunks (see pf_readdir): the first
+     * chunk replaced the item, insert later chunks after the last child
+     * inserted so far */
+    ssize_t cursor = vlc_playlist_ExpandCursorFind(playlist, media);
+    if (cursor != -1)
+    {
+        uint64_t last_id = playlist->expand_cursors.data[cursor].last_item_id;
+        ssize_t index = vlc_playlist_IndexOfId(playlist, last_id);
+        if (index == -1)
+        {
+            /* the expanded items were removed meanwhile, drop the rest */
+            vlc_playlist_ExpandCursorRemove(playlist, cursor);
+            return VLC_ENOENT;
+        }
+
+        media_vector_t flatten = VLC_VECTOR_INITIALIZER;
+        vlc_playlist_CollectChildren(playlist, &flatten, subitems);
+
+        int ret = VLC_SUCCESS;
+        if (flatten.size > 0)
+        {
+            ret = vlc_playlist_Insert(playlist, index + 1, flatten.data,
+                                      flatten.size);
+            if (ret == VLC_SUCCESS)
+                vlc_playlist_ExpandCursorUpdate(playlist, media,
+                        playlist->items.data[index + flatten.size]->id);
+        }
+        vlc_vector_destroy(&flatten);
+        return ret;
+    }
+
     ssize_t index = vlc_playlist_IndexOfMedia(playlist, media);
     if (index == -1)
         return VLC_ENOENT;
 
     /* replace the item by its flatten subtree */
-    return vlc_playlist_ExpandItem(playlist, index, subitems);
+    media_vector_t flatten = VLC_VECTOR_INITIALIZER;
+    vlc_playlist_CollectChildren(playlist, &flatten, subitems);
+
+    int ret = vlc_playlist_Expand(playlist, index, flatten.data, flatten.size);
+    if (ret == VLC_SUCCESS && flatten.size > 0)
+        vlc_playlist_ExpandCursorUpdate(playlist, media,
+                playlist->items.data[index + flatten.size - 1]->id);
+    vlc_vector_destroy(&flatten);
+
+    return ret;
 }
 
 static void
@@ -92,17 +184,22 @@ static void
 on_preparse_ended(input_item_t *media,
                   enum input_item_preparse_status status, void *userdata)
 {
-    VLC_UNUSED(media); /* retrieved by subtree->p_item */
     vlc_playlist_t *playlist = userdata;
 
-    if (status != ITEM_PREPARSE_DONE)
-        return;
-
     vlc_playlist_Lock(playlist);
-    ssize_t index = vlc_playlist_IndexOfMedia(playlist, media);
-    if (index != -1)
-        vlc_playlist_Notify(playlist, on_items_updated, index,
-                            &playlist->items.data[index], 1);
+
+    /* the subtree of this media, if any, is complete */
+    ssize_t cursor = vlc_playlist_ExpandCursorFind(playlist, media);
+    if (cursor != -1)
+        vlc_playlist_ExpandCursorRemove(playlist, cursor);
+
+    if (status == ITEM_PREPARSE_DONE)
+    {
+        ssize_t index = vlc_playlist_IndexOfMedia(playlist, media);
+        if (index != -1)
+            vlc_playlist_Notify(playlist, on_items_updated, index,
+                                &playlist->items.data[index], 1);
+    }
     vlc_playlist_Unlock(playlist);
 }
 
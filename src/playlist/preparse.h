@@ -37,4 +37,8 @@ int
 vlc_playlist_ExpandItemFromNode(vlc_playlist_t *playlist,
                                 input_item_node_t *subitems);
 
+/* called by vlc_playlist_Delete() in playlist.c */
+void
+vlc_playlist_ExpandCursorsClear(vlc_playlist_t *playlist);
+
 #endif
@@ -28,11 +28,15 @@
 #include "item.h"
 #include "notify.h"
 #include "playlist.h"
+#include "sort.h"
 
 void
 vlc_playlist_Shuffle(vlc_playlist_t *playlist)
 {
     vlc_playlist_AssertLocked(playlist);
+
+    vlc_playlist_ResetSortCriteria(playlist);
+
     if (playlist->items.size < 2)
         /* we use size_t (unsigned), so the following loop would be incorrect */
         return;
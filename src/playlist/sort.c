@@ -30,6 +30,7 @@
 #include "item.h"
 #include "notify.h"
 #include "playlist.h"
+#include "sort.h"
 
 /**
  * Struct containing a copy of (parsed) media metadata, used for sorting
@@ -37,6 +38,7 @@
  */
 struct vlc_playlist_item_meta {
     vlc_playlist_item_t *item;
+    input_item_t *media;
     size_t index;
     const char *title_or_name;
     vlc_tick_t duration;
@@ -98,7 +100,7 @@ static int
 vlc_playlist_item_meta_InitField(struct vlc_playlist_item_meta *meta,
                                  enum vlc_playlist_sort_key key)
 {
-    input_item_t *media = meta->item->media;
+    input_item_t *media = meta->media;
     switch (key)
     {
         case VLC_PLAYLIST_SORT_KEY_TITLE:
@@ -241,21 +243,19 @@ vlc_playlist_item_meta_InitFields(struct vlc_playlist_item_meta *meta,
 }
 
 static struct vlc_playlist_item_meta *
-vlc_playlist_item_meta_New(size_t index, vlc_playlist_item_t *item,
-                           const struct vlc_playlist_sort_criterion criteria[],
-                           size_t count)
+vlc_playlist_item_meta_NewFromMedia(input_item_t *media,
+        const struct vlc_playlist_sort_criterion criteria[], size_t count)
 {
     /* assume that NULL representation is all-zeros */
     struct vlc_playlist_item_meta *meta = calloc(1, sizeof(*meta));
     if (unlikely(!meta))
         return NULL;
 
-    meta->item = item;
-    meta->index = index;
+    meta->media = media;
 
-    vlc_mutex_lock(&item->media->lock);
+    vlc_mutex_lock(&media->lock);
     int ret = vlc_playlist_item_meta_InitFields(meta, criteria, count);
-    vlc_mutex_unlock(&item->media->lock);
+    vlc_mutex_unlock(&media->lock);
 
     if (unlikely(ret != VLC_SUCCESS))
     {
@@ -266,6 +266,22 @@ vlc_playlist_item_meta_New(size_t index, vlc_playlist_item_t *item,
     return meta;
 }
 
+static struct vlc_playlist_item_meta *
+vlc_playlist_item_meta_New(size_t index, vlc_playlist_item_t *item,
+                           const struct vlc_playlist_sort_criterion criteria[],
+                           size_t count)
+{
+    struct vlc_playlist_item_meta *meta =
+            vlc_playlist_item_meta_NewFromMedia(item->media, criteria, count);
+    if (likely(meta))
+    {
+        meta->item = item;
+        meta->index = index;
+    }
+
+    return meta;
+}
+
 static void
 vlc_playlist_item_meta_Delete(struct vlc_playlist_item_meta *meta)
 {
@@ -368,6 +384,28 @@ CompareMetaByKey(const struct vlc_playlist_item_meta *a,
      }
 }
 
+static int
+CompareMetaByCriteria(const struct vlc_playlist_item_meta *a,
+                      const struct vlc_playlist_item_meta *b,
+                      const struct vlc_playlist_sort_criterion criteria[],
+                      size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        const struct vlc_playlist_sort_criterion *criterion = &criteria[i];
+        int ret = CompareMetaByKey(a, b, criterion->key);
+        if (ret)
+        {
+            if (criterion->order == VLC_PLAYLIST_SORT_ORDER_DESCENDING)
+                /* do not return -ret, it's undefined if ret == INT_MIN */
+                return ret > 0 ? -1 : 1;
+            return ret;
+        }
+    }
+
+    return 0;
+}
+
 /* context for qsort_r() */
 struct sort_request
 {
@@ -384,18 +422,9 @@ compare_meta(const void *lhs, const void *rhs, void *userdata)
     const struct vlc_playlist_item_meta *b =
             *(const struct vlc_playlist_item_meta **) rhs;
 
-    for (size_t i = 0; i < req->count; ++i)
-    {
-        const struct vlc_playlist_sort_criterion *criterion = &req->criteria[i];
-        int ret = CompareMetaByKey(a, b, criterion->key);
-        if (ret)
-        {
-            if (criterion->order == VLC_PLAYLIST_SORT_ORDER_DESCENDING)
-                /* do not return -ret, it's undefined if ret == INT_MIN */
-                return ret > 0 ? -1 : 1;
-            return ret;
-        }
-    }
+    int ret = CompareMetaByCriteria(a, b, req->criteria, req->count);
+    if (ret)
+        return ret;
 
     /* If the items are equals regarding the sorting criteria, keep their
      * initial relative order, to make the sort stable. */
@@ -441,6 +470,34 @@ vlc_playlist_NewMetaArray(vlc_playlist_t *playlist,
     return array;
 }
 
+void
+vlc_playlist_ResetSortCriteria(vlc_playlist_t *playlist)
+{
+    free(playlist->sort_criteria);
+    playlist->sort_criteria = NULL;
+    playlist->sort_criteria_count = 0;
+}
+
+static void
+vlc_playlist_SaveSortCriteria(vlc_playlist_t *playlist,
+        const struct vlc_playlist_sort_criterion criteria[], size_t count)
+{
+    struct vlc_playlist_sort_criterion *copy =
+            vlc_alloc(count, sizeof(*copy));
+    if (unlikely(!copy))
+    {
+        /* not fatal: the playlist is sorted anyway, only sorted insertion
+         * will not benefit from it */
+        vlc_playlist_ResetSortCriteria(playlist);
+        return;
+    }
+
+    memcpy(copy, criteria, count * sizeof(*copy));
+    free(playlist->sort_criteria);
+    playlist->sort_criteria = copy;
+    playlist->sort_criteria_count = count;
+}
+
 int
 vlc_playlist_Sort(vlc_playlist_t *playlist,
                   const struct vlc_playlist_sort_criterion criteria[],
@@ -483,5 +540,79 @@ vlc_playlist_Sort(vlc_playlist_t *playlist,
     if (current)
         vlc_playlist_state_NotifyChanges(playlist, &state);
 
+    /* remember the order, so that vlc_playlist_InsertSorted() can keep it */
+    vlc_playlist_SaveSortCriteria(playlist, criteria, count);
+
+    return VLC_SUCCESS;
+}
+
+/**
+ * Find by binary search the index where media (described by meta) is to be
+ * inserted to keep the playlist sorted by the last applied criteria.
+ *
+ * Like a stable sort, insert after the items comparing equal.
+ *
+ * \return the insertion index, -1 on allocation error
+ */
+static ssize_t
+vlc_playlist_FindSortedIndex(vlc_playlist_t *playlist,
+                             const struct vlc_playlist_item_meta *meta)
+{
+    const struct vlc_playlist_sort_criterion *criteria =
+            playlist->sort_criteria;
+    size_t count = playlist->sort_criteria_count;
+
+    size_t lo = 0;
+    size_t hi = playlist->items.size;
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        struct vlc_playlist_item_meta *other =
+                vlc_playlist_item_meta_New(mid, playlist->items.data[mid],
+                                           criteria, count);
+        if (unlikely(!other))
+            return -1;
+
+        int ret = CompareMetaByCriteria(other, meta, criteria, count);
+        vlc_playlist_item_meta_Delete(other);
+
+        if (ret <= 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+int
+vlc_playlist_InsertSorted(vlc_playlist_t *playlist,
+                          input_item_t *const media[], size_t count)
+{
+    vlc_playlist_AssertLocked(playlist);
+
+    if (!playlist->sort_criteria_count)
+        /* the playlist is not sorted, keep the submission order */
+        return vlc_playlist_Append(playlist, media, count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        struct vlc_playlist_item_meta *meta =
+                vlc_playlist_item_meta_NewFromMedia(media[i],
+                                                    playlist->sort_criteria,
+                                                    playlist->sort_criteria_count);
+        if (unlikely(!meta))
+            return VLC_ENOMEM;
+
+        ssize_t index = vlc_playlist_FindSortedIndex(playlist, meta);
+        vlc_playlist_item_meta_Delete(meta);
+        if (unlikely(index == -1))
+            return VLC_ENOMEM;
+
+        int ret = vlc_playlist_Insert(playlist, index, &media[i], 1);
+        if (ret != VLC_SUCCESS)
+            return ret;
+    }
+
     return VLC_SUCCESS;
 }
@@ -2423,6 +2423,72 @@ test_stable_sort(void)
     vlc_playlist_Delete(playlist);
 }
 
+static void
+test_insert_sorted(void)
+{
+    vlc_playlist_t *playlist = vlc_playlist_New(NULL);
+    assert(playlist);
+
+    input_item_t *media[9];
+    media[0] = CreateDummyMedia(0); media[0]->i_duration = 10;
+    media[1] = CreateDummyMedia(1); media[1]->i_duration = 20;
+    media[2] = CreateDummyMedia(2); media[2]->i_duration = 30;
+    media[3] = CreateDummyMedia(3); media[3]->i_duration = 40;
+    /* media to insert afterwards */
+    media[4] = CreateDummyMedia(4); media[4]->i_duration = 25;
+    media[5] = CreateDummyMedia(5); media[5]->i_duration = 5;
+    media[6] = CreateDummyMedia(6); media[6]->i_duration = 100;
+    media[7] = CreateDummyMedia(7); media[7]->i_duration = 30;
+    media[8] = CreateDummyMedia(8); media[8]->i_duration = 15;
+
+    /* the playlist has never been sorted: insert just appends */
+    int ret = vlc_playlist_InsertSorted(playlist, media, 4);
+    assert(ret == VLC_SUCCESS);
+
+    EXPECT_AT(0, 0);
+    EXPECT_AT(1, 1);
+    EXPECT_AT(2, 2);
+    EXPECT_AT(3, 3);
+
+    struct vlc_playlist_sort_criterion criteria[] = {
+        { VLC_PLAYLIST_SORT_KEY_DURATION, VLC_PLAYLIST_SORT_ORDER_ASCENDING },
+    };
+    vlc_playlist_Sort(playlist, criteria, 1);
+
+    /* each media is to be inserted at its sorted position */
+    ret = vlc_playlist_InsertSorted(playlist, &media[4], 3);
+    assert(ret == VLC_SUCCESS);
+
+    /* durations: 5 10 20 25 30 40 100 */
+    EXPECT_AT(0, 5);
+    EXPECT_AT(1, 0);
+    EXPECT_AT(2, 1);
+    EXPECT_AT(3, 4);
+    EXPECT_AT(4, 2);
+    EXPECT_AT(5, 3);
+    EXPECT_AT(6, 6);
+
+    /* insert after the items comparing equal, like a stable sort */
+    ret = vlc_playlist_InsertSorted(playlist, &media[7], 1);
+    assert(ret == VLC_SUCCESS);
+
+    EXPECT_AT(4, 2);
+    EXPECT_AT(5, 7);
+    EXPECT_AT(6, 3);
+    EXPECT_AT(7, 6);
+
+    /* a manual move breaks the sort order: insert appends again */
+    vlc_playlist_Move(playlist, 0, 1, 7);
+
+    ret = vlc_playlist_InsertSorted(playlist, &media[8], 1);
+    assert(ret == VLC_SUCCESS);
+
+    EXPECT_AT(8, 8);
+
+    DestroyMediaArray(media, 9);
+    vlc_playlist_Delete(playlist);
+}
+
 #undef EXPECT_AT
 
 int main(void)
@@ -2459,6 +2525,7 @@ int main(void)
     test_shuffle();
     test_sort();
     test_stable_sort();
+    test_insert_sorted();
     return 0;
 }
 
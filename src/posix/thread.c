@@ -126,7 +126,7 @@ void *vlc_threadvar_get (vlc_threadvar_t key)
 
 void vlc_threads_setup (libvlc_int_t *p_libvlc)
 {
-    (void) p_libvlc;
+    vlc_threads_ReadClassConfig (p_libvlc);
 }
 
 static int vlc_clone_attr (vlc_thread_t *th, pthread_attr_t *attr,
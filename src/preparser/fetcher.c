@@ -49,6 +49,9 @@ struct input_fetcher_t {
 
     vlc_mutex_t lock;
     struct vlc_list submitted_tasks; /**< list of struct task */
+
+    vlc_dictionary_t downloads; /**< art URLs currently being downloaded */
+    vlc_cond_t downloads_wait; /**< signaled when a download completes */
 };
 
 struct task {
@@ -219,6 +222,39 @@ static void AddAlbumCache( input_fetcher_t* fetcher, input_item_t* item,
     free( key );
 }
 
+/**
+ * Items of a same album usually share one art URL. Without coalescing, a
+ * large scan would download the same file once per track, over a fresh
+ * connection every time. Claim the URL so that only one task fetches it;
+ * if another task already did, wait for it to finish instead.
+ *
+ * \return true if the function waited for another download of the same URL
+ */
+static bool DownloadBegin( input_fetcher_t* fetcher, char const* psz_arturl )
+{
+    bool waited = false;
+
+    vlc_mutex_lock( &fetcher->lock );
+    while( vlc_dictionary_has_key( &fetcher->downloads, psz_arturl ) )
+    {
+        vlc_cond_wait( &fetcher->downloads_wait, &fetcher->lock );
+        waited = true;
+    }
+    vlc_dictionary_insert( &fetcher->downloads, psz_arturl, fetcher );
+    vlc_mutex_unlock( &fetcher->lock );
+
+    return waited;
+}
+
+static void DownloadEnd( input_fetcher_t* fetcher, char const* psz_arturl )
+{
+    vlc_mutex_lock( &fetcher->lock );
+    vlc_dictionary_remove_value_for_key( &fetcher->downloads, psz_arturl,
+                                         NULL, NULL );
+    vlc_cond_broadcast( &fetcher->downloads_wait );
+    vlc_mutex_unlock( &fetcher->lock );
+}
+
 static int InvokeModule( input_fetcher_t* fetcher, input_item_t* item,
                          int scope, char const* type )
 {
@@ -305,6 +341,7 @@ static void RunDownloader(void *userdata)
 
     struct task *task = userdata;
     input_fetcher_t *fetcher = task->fetcher;
+    bool downloading = false;
 
     vlc_interrupt_set(&task->interrupt);
 
@@ -318,6 +355,26 @@ static void RunDownloader(void *userdata)
         !strncasecmp( psz_arturl, "attachment://", 13 ) )
         goto out; /* no fetch required */
 
+    if( DownloadBegin( fetcher, psz_arturl ) )
+    {
+        /* Another task just downloaded this URL: its result should now be
+         * served from the caches. */
+        ReadAlbumCache( fetcher, task->item );
+
+        char *psz_cached = input_item_GetArtURL( task->item );
+        if( psz_cached && ( !strncasecmp( psz_cached, "file://", 7 ) ||
+                            !strncasecmp( psz_cached, "attachment://", 13 ) ) )
+        {
+            DownloadEnd( fetcher, psz_arturl );
+            free( psz_arturl );
+            psz_arturl = psz_cached;
+            goto out;
+        }
+        /* It failed; retry the download ourselves */
+        free( psz_cached );
+    }
+    downloading = true;
+
     stream_t* source = vlc_stream_NewURL( fetcher->owner, psz_arturl );
 
     if( !source )
@@ -358,6 +415,9 @@ static void RunDownloader(void *userdata)
 out:
     vlc_interrupt_set(NULL);
 
+    if( downloading )
+        DownloadEnd( fetcher, psz_arturl );
+
     if( psz_arturl )
     {
         var_SetAddress( fetcher->owner, "item-change", task->item );
@@ -373,6 +433,9 @@ out:
 error:
     vlc_interrupt_set(NULL);
 
+    if( downloading )
+        DownloadEnd( fetcher, psz_arturl );
+
     FREENULL( psz_arturl );
     NotifyArtFetchEnded(task, false);
     FetcherRemoveTask(fetcher, task);
@@ -474,6 +537,8 @@ input_fetcher_t* input_fetcher_New( vlc_object_t* owner )
     vlc_list_init(&fetcher->submitted_tasks);
 
     vlc_dictionary_init( &fetcher->album_cache, 0 );
+    vlc_dictionary_init( &fetcher->downloads, 0 );
+    vlc_cond_init( &fetcher->downloads_wait );
 
     return fetcher;
 }
@@ -521,5 +586,6 @@ void input_fetcher_Delete( input_fetcher_t* fetcher )
     vlc_executor_Delete(fetcher->executor_downloader);
 
     vlc_dictionary_clear( &fetcher->album_cache, FreeCacheEntry, NULL );
+    vlc_dictionary_clear( &fetcher->downloads, NULL, NULL );
     free( fetcher );
 }
@@ -31,11 +31,20 @@
 #include "preparser.h"
 #include "fetcher.h"
 
+/* Interactive requests (triggered by a user action) get their own lane so
+ * they never queue behind thousands of background library probes. */
+enum preparser_lane
+{
+    PREPARSER_LANE_INTERACTIVE,
+    PREPARSER_LANE_BACKGROUND,
+    PREPARSER_LANE_COUNT,
+};
+
 struct input_preparser_t
 {
     vlc_object_t* owner;
     input_fetcher_t* fetcher;
-    vlc_executor_t *executor;
+    vlc_executor_t *executors[PREPARSER_LANE_COUNT];
     vlc_tick_t default_timeout;
     atomic_bool deactivated;
 
@@ -52,6 +61,10 @@ struct task
     void *userdata;
     void *id;
     vlc_tick_t timeout;
+    /** Absolute submission deadline, or VLC_TICK_INVALID for a per-run
+     * timeout only */
+    vlc_tick_t deadline;
+    enum preparser_lane lane;
 
     input_item_parser_id_t *parser;
 
@@ -86,6 +99,9 @@ TaskNew(input_preparser_t *preparser, input_item_t *item,
     task->userdata = userdata;
     task->id = id;
     task->timeout = timeout;
+    task->deadline = VLC_TICK_INVALID;
+    task->lane = (options & META_REQUEST_OPTION_DO_INTERACT)
+               ? PREPARSER_LANE_INTERACTIVE : PREPARSER_LANE_BACKGROUND;
 
     input_item_Hold(item);
 
@@ -237,9 +253,19 @@ RunnableRun(void *userdata)
 
     struct task *task = userdata;
 
-    vlc_tick_t deadline = task->timeout ? vlc_tick_now() + task->timeout
+    vlc_tick_t deadline = task->deadline != VLC_TICK_INVALID
+                        ? task->deadline
+                        : task->timeout ? vlc_tick_now() + task->timeout
                                         : VLC_TICK_INVALID;
 
+    if (deadline != VLC_TICK_INVALID && vlc_tick_now() >= deadline)
+    {
+        /* The batch deadline elapsed while this task was queued */
+        atomic_store_explicit(&task->preparse_status, ITEM_PREPARSE_TIMEOUT,
+                              memory_order_relaxed);
+        goto end;
+    }
+
     if (atomic_load(&task->interrupted))
         goto end;
 
@@ -273,6 +299,29 @@ Interrupt(struct task *task)
     vlc_sem_post(&task->preparse_ended);
 }
 
+static void
+CancelSupersededTasks(input_preparser_t *preparser, input_item_t *item)
+{
+    vlc_mutex_lock(&preparser->lock);
+
+    struct task *task;
+    vlc_list_foreach(task, &preparser->submitted_tasks, node)
+    {
+        if (task->item == item && task->lane == PREPARSER_LANE_BACKGROUND
+         && vlc_executor_Cancel(preparser->executors[task->lane],
+                                &task->runnable))
+        {
+            /* Not started yet: the work will be done by the interactive
+             * request instead. Running tasks are left to complete. */
+            NotifyPreparseEnded(task);
+            vlc_list_remove(&task->node);
+            TaskDelete(task);
+        }
+    }
+
+    vlc_mutex_unlock(&preparser->lock);
+}
+
 input_preparser_t* input_preparser_New( vlc_object_t *parent )
 {
     input_preparser_t* preparser = malloc( sizeof *preparser );
@@ -281,15 +330,31 @@ input_preparser_t* input_preparser_New( vlc_object_t *parent )
 
     int max_threads = var_InheritInteger(parent, "preparse-threads");
     if (max_threads < 1)
-        max_threads = 1;
+    {
+        /* Scale the background lane with the machine: bulk preparsing is
+         * mostly blocked on I/O and demuxer probing. */
+        unsigned count = vlc_GetCPUCount();
+        max_threads = count < 8 ? (int)count : 8;
+        if (max_threads < 1)
+            max_threads = 1;
+    }
 
-    preparser->executor = vlc_executor_New(max_threads);
-    if (!preparser->executor)
+    preparser->executors[PREPARSER_LANE_BACKGROUND] =
+        vlc_executor_New(max_threads);
+    if (!preparser->executors[PREPARSER_LANE_BACKGROUND])
     {
         free(preparser);
         return NULL;
     }
 
+    preparser->executors[PREPARSER_LANE_INTERACTIVE] = vlc_executor_New(2);
+    if (!preparser->executors[PREPARSER_LANE_INTERACTIVE])
+    {
+        vlc_executor_Delete(preparser->executors[PREPARSER_LANE_BACKGROUND]);
+        free(preparser);
+        return NULL;
+    }
+
     preparser->default_timeout =
         VLC_TICK_FROM_MS(var_InheritInteger(parent, "preparse-timeout"));
     if (preparser->default_timeout < 0)
@@ -348,9 +413,20 @@ int input_preparser_Push( input_preparser_t *preparser,
     if( !task )
         return VLC_ENOMEM;
 
+    /* An explicit timeout bounds the whole request from submission,
+     * including the time spent queued; the default timeout keeps its
+     * per-run semantics. */
+    if (timeout_ms > 0)
+        task->deadline = vlc_tick_now() + timeout;
+
+    /* The interactive request supersedes any background probe of the same
+     * item still waiting in the queue. */
+    if (task->lane == PREPARSER_LANE_INTERACTIVE)
+        CancelSupersededTasks(preparser, item);
+
     PreparserAddTask(preparser, task);
 
-    vlc_executor_Submit(preparser->executor, &task->runnable);
+    vlc_executor_Submit(preparser->executors[task->lane], &task->runnable);
     return VLC_SUCCESS;
 }
 
@@ -373,7 +449,8 @@ void input_preparser_Cancel( input_preparser_t *preparser, void *id )
         if (!id || task->id == id)
         {
             bool canceled =
-                vlc_executor_Cancel(preparser->executor, &task->runnable);
+                vlc_executor_Cancel(preparser->executors[task->lane],
+                                    &task->runnable);
             if (canceled)
             {
                 NotifyPreparseEnded(task);
@@ -400,7 +477,8 @@ void input_preparser_Delete( input_preparser_t *preparser )
     /* In case input_preparser_Deactivate() has not been called */
     input_preparser_Cancel(preparser, NULL);
 
-    vlc_executor_Delete(preparser->executor);
+    for (int i = 0; i < PREPARSER_LANE_COUNT; i++)
+        vlc_executor_Delete(preparser->executors[i]);
 
     if( preparser->fetcher )
         input_fetcher_Delete( preparser->fetcher );
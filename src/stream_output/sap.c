@@ -35,6 +35,7 @@
 #include <vlc_sout.h>
 #include <vlc_network.h>
 #include <vlc_memstream.h>
+#include <vlc_rand.h>
 
 #include "stream_output.h"
 #include "libvlc.h"
@@ -49,19 +50,16 @@ struct session_descriptor_t
 {
     struct vlc_list node;
     struct sap_address_t *addr;
+    vlc_tick_t next; /**< date of the next scheduled announcement */
     size_t length;
     char *data;
 };
 
-/* A SAP announce address. For each of these, we run the
- * control flow algorithm */
+/* A SAP announce address */
 typedef struct sap_address_t
 {
     struct vlc_list         node;
 
-    vlc_thread_t            thread;
-    vlc_cond_t              wait;
-
     char                    group[NI_MAXNUMERICHOST];
     union {
         struct sockaddr     a;
@@ -76,8 +74,15 @@ typedef struct sap_address_t
     struct vlc_list         sessions;
 } sap_address_t;
 
+/* All announcements are scheduled by a single shared thread rather than one
+ * thread per announce address; the thread exists while sessions do. */
 static struct vlc_list sap_addrs = VLC_LIST_INITIALIZER(&sap_addrs);
 static vlc_mutex_t sap_mutex = VLC_STATIC_MUTEX;
+static vlc_cond_t sap_wait = VLC_STATIC_COND;
+static vlc_thread_t sap_thread;
+static unsigned sap_session_count = 0;
+static bool sap_thread_running = false;
+static bool sap_stopping = false;
 
 #define SAP_MAX_BUFFER 65534
 #define MIN_INTERVAL 2
@@ -104,7 +109,6 @@ static sap_address_t *AddressCreate (vlc_object_t *obj, const char *group)
     getsockname(fd, &addr->orig.a, &addr->origlen);
 
     addr->interval = var_CreateGetInteger (obj, "sap-interval");
-    vlc_cond_init (&addr->wait);
     addr->session_count = 0;
     vlc_list_init(&addr->sessions);
     return addr;
@@ -116,34 +120,59 @@ static void AddressDestroy (sap_address_t *addr)
     free (addr);
 }
 
+/**
+ * Computes the date of the next announcement of a session.
+ *
+ * New sessions are spread anywhere within the announce interval and each
+ * period is shortened by a random amount of up to a 16th of the interval,
+ * so that sessions registered together do not burst on the wire forever.
+ */
+static vlc_tick_t SessionNextDate (const sap_address_t *addr, vlc_tick_t now,
+                                   bool initial)
+{
+    const vlc_tick_t period = vlc_tick_from_sec (addr->interval);
+
+    if (initial)
+        return now + (vlc_tick_t)(vlc_lrand48 () % (unsigned long long)period);
+    return now + period
+         - (vlc_tick_t)(vlc_lrand48 () % (unsigned long long)(period / 16 + 1));
+}
+
 /**
  * main SAP handler thread
- * \param p_this the SAP Handler object
+ *
+ * One shared thread announces the sessions of every address: each pass sends
+ * all announcements that are due, then sleeps until the earliest next date.
  * \return nothing
  */
 static void *RunThread (void *self)
 {
     vlc_thread_set_name("vlc-sap");
-
-    sap_address_t *addr = self;
+    (void) self;
 
     vlc_mutex_lock(&sap_mutex);
 
-    while (!vlc_list_is_empty(&addr->sessions))
+    while (!sap_stopping)
     {
+        sap_address_t *addr;
         session_descriptor_t *p_session;
-        vlc_tick_t deadline = vlc_tick_now();
+        vlc_tick_t now = vlc_tick_now();
+        vlc_tick_t next = INT64_MAX;
 
-        assert (addr->session_count > 0);
-
-        vlc_list_foreach (p_session, &addr->sessions, node)
-        {
-            send (addr->fd, p_session->data, p_session->length, 0);
-            deadline += vlc_tick_from_samples(addr->interval, addr->session_count);
+        vlc_list_foreach (addr, &sap_addrs, node)
+            vlc_list_foreach (p_session, &addr->sessions, node)
+            {
+                if (p_session->next <= now)
+                {
+                    send (addr->fd, p_session->data, p_session->length, 0);
+                    p_session->next = SessionNextDate (addr, now, false);
+                }
+                if (p_session->next < next)
+                    next = p_session->next;
+            }
 
-            if (vlc_cond_timedwait(&addr->wait, &sap_mutex, deadline) == 0)
-                break; /* list may have changed! */
-        }
+        /* Wakes up early when the session lists change */
+        vlc_cond_timedwait(&sap_wait, &sap_mutex, next);
     }
 
     vlc_mutex_unlock(&sap_mutex);
@@ -265,6 +294,10 @@ sout_AnnounceRegisterSDP (vlc_object_t *obj, const char *sdp,
 
     msg_Dbg (obj, "using SAP address: %s", psz_addr);
     vlc_mutex_lock (&sap_mutex);
+    /* Wait out a concurrent shutdown of the announcement thread */
+    while (sap_stopping)
+        vlc_cond_wait(&sap_wait, &sap_mutex);
+
     vlc_list_foreach (sap_addr, &sap_addrs, node)
         if (!strcmp (psz_addr, sap_addr->group))
             goto matched;
@@ -275,8 +308,8 @@ sout_AnnounceRegisterSDP (vlc_object_t *obj, const char *sdp,
         vlc_mutex_unlock(&sap_mutex);
         return NULL;
     }
-matched:
     vlc_list_append(&sap_addr->node, &sap_addrs);
+matched:;
 
     session_descriptor_t *session = malloc(sizeof (*session));
     if (unlikely(session == NULL))
@@ -332,22 +365,32 @@ matched:
     session->addr = sap_addr;
     session->data = stream.ptr;
     session->length = stream.length;
+    session->next = SessionNextDate(sap_addr, vlc_tick_now(), true);
     vlc_list_append(&session->node, &sap_addr->sessions);
+    sap_addr->session_count++;
 
-    if (sap_addr->session_count++ == 0)
+    if (sap_session_count++ == 0 && !sap_thread_running)
     {
-        if (vlc_clone(&sap_addr->thread, RunThread, sap_addr))
+        if (vlc_clone(&sap_thread, RunThread, NULL))
         {
             msg_Err(obj, "unable to spawn SAP announce thread");
-            AddressDestroy(sap_addr);
+            sap_session_count--;
+            sap_addr->session_count--;
+            vlc_list_remove(&session->node);
+            if (vlc_list_is_empty(&sap_addr->sessions))
+            {
+                vlc_list_remove(&sap_addr->node);
+                AddressDestroy(sap_addr);
+            }
             free(session->data);
             free(session);
             session = NULL;
             goto out;
         }
+        sap_thread_running = true;
     }
     else
-        vlc_cond_signal(&sap_addr->wait);
+        vlc_cond_signal(&sap_wait);
 out:
     vlc_mutex_unlock(&sap_mutex);
     return session;
@@ -363,24 +406,38 @@ out:
 void sout_AnnounceUnRegister (vlc_object_t *obj, session_descriptor_t *session)
 {
     sap_address_t *addr = session->addr;
+    bool destroy;
 
     msg_Dbg (obj, "removing SAP session");
     vlc_mutex_lock (&sap_mutex);
     vlc_list_remove(&session->node);
+    addr->session_count--;
 
-    if (vlc_list_is_empty(&addr->sessions))
+    destroy = vlc_list_is_empty(&addr->sessions);
+    if (destroy)
         /* Last session for this address -> unlink the address */
         vlc_list_remove(&addr->node);
 
-    addr->session_count--;
-    vlc_cond_signal(&addr->wait);
+    if (--sap_session_count == 0 && sap_thread_running)
+    {
+        /* Last session of all -> reap the announcement thread. Registrants
+         * wait out sap_stopping, so no thread is spawned until the old one
+         * has been joined. */
+        sap_stopping = true;
+        vlc_cond_broadcast(&sap_wait);
+        vlc_mutex_unlock(&sap_mutex);
+        vlc_join(sap_thread, NULL);
+        vlc_mutex_lock(&sap_mutex);
+        sap_thread_running = false;
+        sap_stopping = false;
+        vlc_cond_broadcast(&sap_wait);
+    }
+    else
+        vlc_cond_signal(&sap_wait);
     vlc_mutex_unlock(&sap_mutex);
 
-    if (vlc_list_is_empty(&addr->sessions))
-    {
-        vlc_join(addr->thread, NULL);
+    if (destroy)
         AddressDestroy(addr);
-    }
 
     free(session->data);
     free(session);
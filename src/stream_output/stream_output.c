@@ -862,6 +862,146 @@ static sout_stream_t *sout_StreamNew( vlc_object_t *parent, char *psz_name,
     return p_stream;
 }
 
+/*
+ * Parsed chain descriptor cache
+ *
+ * Services spawning many short-lived stream outputs tend to reuse the very
+ * same chain description over and over. Parsing a description is pure (the
+ * result only depends on the string), so the module names and option chains
+ * of recently seen descriptions are kept and cloned on reuse instead of
+ * being re-parsed.
+ */
+struct sout_chain_desc
+{
+    char *psz_chain;          /**< chain description this was parsed from */
+    size_t i_count;           /**< number of modules in the chain */
+    char **ppsz_names;        /**< module name of each link */
+    config_chain_t **pp_cfgs; /**< parsed options of each link */
+    struct sout_chain_desc *p_next;
+};
+
+#define SOUT_CHAIN_CACHE_MAX 8
+
+static struct
+{
+    vlc_mutex_t lock;
+    struct sout_chain_desc *p_first;
+    size_t count;
+} chain_cache = { VLC_STATIC_MUTEX, NULL, 0 };
+
+static void sout_ChainDescDelete(struct sout_chain_desc *desc)
+{
+    for (size_t i = 0; i < desc->i_count; i++)
+    {
+        free(desc->ppsz_names[i]);
+        config_ChainDestroy(desc->pp_cfgs[i]);
+    }
+    free(desc->ppsz_names);
+    free(desc->pp_cfgs);
+    free(desc->psz_chain);
+    free(desc);
+}
+
+/* Fill the name and config arrays from a cached descriptor, if any */
+static bool sout_ChainDescLookup(const char *psz_chain,
+                                 vlc_array_t *name, vlc_array_t *cfg)
+{
+    bool found = false;
+
+    vlc_mutex_lock(&chain_cache.lock);
+    for (struct sout_chain_desc **pp = &chain_cache.p_first, *desc = *pp;
+         desc != NULL; pp = &desc->p_next, desc = *pp)
+    {
+        if (strcmp(desc->psz_chain, psz_chain))
+            continue;
+
+        /* Move to front so eviction drops the least recently used chain */
+        *pp = desc->p_next;
+        desc->p_next = chain_cache.p_first;
+        chain_cache.p_first = desc;
+
+        found = true;
+        for (size_t i = 0; i < desc->i_count; i++)
+        {
+            char *psz_name = strdup(desc->ppsz_names[i]);
+            if (unlikely(psz_name == NULL))
+            {
+                found = false;
+                break;
+            }
+            vlc_array_append_or_abort(name, psz_name);
+            vlc_array_append_or_abort(cfg,
+                                      config_ChainDuplicate(desc->pp_cfgs[i]));
+        }
+        if (!found)
+        {   /* fall back to parsing the description */
+            for (size_t i = 0; i < vlc_array_count(name); i++)
+            {
+                free(vlc_array_item_at_index(name, i));
+                config_ChainDestroy(vlc_array_item_at_index(cfg, i));
+            }
+            vlc_array_clear(name);
+            vlc_array_clear(cfg);
+        }
+        break;
+    }
+    vlc_mutex_unlock(&chain_cache.lock);
+    return found;
+}
+
+static void sout_ChainDescStore(const char *psz_chain,
+                                vlc_array_t *name, vlc_array_t *cfg)
+{
+    size_t count = vlc_array_count(name);
+    if (count == 0)
+        return;
+
+    struct sout_chain_desc *desc = malloc(sizeof (*desc));
+    if (unlikely(desc == NULL))
+        return;
+
+    desc->psz_chain = strdup(psz_chain);
+    desc->ppsz_names = vlc_alloc(count, sizeof (char *));
+    desc->pp_cfgs = vlc_alloc(count, sizeof (config_chain_t *));
+    desc->i_count = 0;
+    if (desc->psz_chain == NULL || desc->ppsz_names == NULL
+     || desc->pp_cfgs == NULL)
+        goto error;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        char *psz_name = strdup(vlc_array_item_at_index(name, i));
+        if (unlikely(psz_name == NULL))
+            goto error;
+
+        desc->ppsz_names[desc->i_count] = psz_name;
+        desc->pp_cfgs[desc->i_count] =
+            config_ChainDuplicate(vlc_array_item_at_index(cfg, i));
+        desc->i_count++;
+    }
+
+    vlc_mutex_lock(&chain_cache.lock);
+    desc->p_next = chain_cache.p_first;
+    chain_cache.p_first = desc;
+    if (++chain_cache.count > SOUT_CHAIN_CACHE_MAX)
+    {   /* evict the least recently used descriptor */
+        struct sout_chain_desc **pp = &chain_cache.p_first;
+        while ((*pp)->p_next != NULL)
+            pp = &(*pp)->p_next;
+        desc = *pp;
+        *pp = NULL;
+        chain_cache.count--;
+        vlc_mutex_unlock(&chain_cache.lock);
+        sout_ChainDescDelete(desc);
+        return;
+    }
+    vlc_mutex_unlock(&chain_cache.lock);
+    return;
+
+error:
+    sout_ChainDescDelete(desc);
+}
+
 /* Creates a complete "stream_out" modules chain
  *
  *  chain format: module1{option=*:option=*}[:module2{option=*:...}]
@@ -878,25 +1018,30 @@ sout_stream_t *sout_StreamChainNew(vlc_object_t *parent, const char *psz_chain,
         return sink;
     }
 
-    char *psz_parser = strdup(psz_chain);
-    if(!psz_parser)
-        return NULL;
-
     vlc_array_t cfg, name;
     vlc_array_init(&cfg);
     vlc_array_init(&name);
 
-    /* parse chain */
-    while(psz_parser)
+    if(!sout_ChainDescLookup(psz_chain, &name, &cfg))
     {
-        config_chain_t *p_cfg;
-        char *psz_name;
-        char *psz_rest_chain = config_ChainCreate( &psz_name, &p_cfg, psz_parser );
-        free( psz_parser );
-        psz_parser = psz_rest_chain;
+        char *psz_parser = strdup(psz_chain);
+        if(!psz_parser)
+            return NULL;
+
+        /* parse chain */
+        while(psz_parser)
+        {
+            config_chain_t *p_cfg;
+            char *psz_name;
+            char *psz_rest_chain = config_ChainCreate( &psz_name, &p_cfg, psz_parser );
+            free( psz_parser );
+            psz_parser = psz_rest_chain;
+
+            vlc_array_append_or_abort(&cfg, p_cfg);
+            vlc_array_append_or_abort(&name, psz_name);
+        }
 
-        vlc_array_append_or_abort(&cfg, p_cfg);
-        vlc_array_append_or_abort(&name, psz_name);
+        sout_ChainDescStore(psz_chain, &name, &cfg);
     }
 
     /* Instantiate modules from back to front of chain */
@@ -108,6 +108,49 @@ static void test(bool zombie)
             picture_Release(pics[i]);
 }
 
+static void test_growable(void)
+{
+    picture_t *pics[PICTURES];
+    unsigned count, in_use, starved;
+    vlc_tick_t waited;
+
+    pool = picture_pool_NewGrowable(&fmt, PICTURES / 2, PICTURES);
+    assert(pool != NULL);
+    assert(picture_pool_GetSize(pool) == PICTURES / 2);
+
+    for (unsigned i = 0; i < PICTURES; i++) {
+        pics[i] = picture_pool_Get(pool);
+        assert(pics[i] != NULL);
+    }
+
+    // The pool grew on demand, up to its budget and no further.
+    assert(picture_pool_GetSize(pool) == PICTURES);
+    assert(picture_pool_Get(pool) == NULL);
+
+    picture_pool_GetResetStats(pool, &count, &in_use, &starved, &waited);
+    assert(count == PICTURES);
+    assert(in_use == PICTURES);
+    assert(starved == 1);
+
+    for (unsigned i = 0; i < PICTURES; i++)
+        picture_Release(pics[i]);
+
+    // Extra pictures were freed on release, back to the initial size.
+    assert(picture_pool_GetSize(pool) == PICTURES / 2);
+
+    pics[0] = picture_pool_Wait(pool);
+    assert(pics[0] != NULL);
+    picture_Release(pics[0]);
+
+    picture_pool_GetResetStats(pool, &count, &in_use, &starved, &waited);
+    assert(count == PICTURES / 2);
+    assert(in_use == 0);
+    assert(starved == 0);
+    assert(waited == 0);
+
+    picture_pool_Release(pool);
+}
+
 int main(void)
 {
     video_format_Setup(&fmt, VLC_CODEC_I420, 320, 200, 320, 200, 1, 1);
@@ -123,6 +166,7 @@ int main(void)
 
     test(false);
     test(true);
+    test_growable();
 
     return 0;
 }
@@ -22,6 +22,10 @@
 # include "config.h"
 #endif
 
+#ifdef HAVE_SYS_UIO_H
+# include <sys/uio.h>
+#endif
+
 #include <vlc_common.h>
 #include <vlc_memstream.h>
 
@@ -74,6 +78,26 @@ size_t vlc_memstream_write(struct vlc_memstream *ms, const void *ptr,
     return fwrite(ptr, 1, len, ms->stream);
 }
 
+size_t vlc_memstream_writev(struct vlc_memstream *ms,
+                            const struct iovec *iov, int iovcnt)
+{
+    size_t ret = 0;
+
+    if (unlikely(ms->stream == NULL))
+        return 0;
+
+    for (int i = 0; i < iovcnt; i++)
+    {
+        size_t written = fwrite(iov[i].iov_base, 1, iov[i].iov_len,
+                                ms->stream);
+
+        ret += written;
+        if (written != iov[i].iov_len)
+            break;
+    }
+    return ret;
+}
+
 int vlc_memstream_putc(struct vlc_memstream *ms, int c)
 {
     if (unlikely(ms->stream == NULL))
@@ -102,12 +126,55 @@ int vlc_memstream_vprintf(struct vlc_memstream *ms, const char *fmt,
 #else
 #include <stdlib.h>
 
+/**
+ * Computes the buffer allocation size for a given stream length.
+ *
+ * The size grows geometrically so that appending takes amortized constant
+ * time. It only depends on the current length: no capacity needs to be
+ * stored in the (public, fixed-layout) stream object.
+ *
+ * \param length stream length plus one for the terminating nul
+ */
+static size_t vlc_memstream_bufsize(size_t length)
+{
+    size_t size = 32;
+
+    while (size < length)
+    {
+        if (unlikely(size > (SIZE_MAX / 2)))
+            return length;
+        size *= 2;
+    }
+    return size;
+}
+
+/**
+ * Ensures the buffer can hold a given stream length.
+ *
+ * \param newlen new stream length, including the terminating nul
+ *
+ * \return the buffer base address, or NULL on allocation failure
+ */
+static char *vlc_memstream_grow(struct vlc_memstream *ms, size_t newlen)
+{
+    if (ms->ptr != NULL
+     && vlc_memstream_bufsize(newlen) <= vlc_memstream_bufsize(ms->length + 1))
+        return ms->ptr;
+
+    char *base = realloc(ms->ptr, vlc_memstream_bufsize(newlen));
+    if (likely(base != NULL))
+        ms->ptr = base;
+    return base;
+}
+
 int vlc_memstream_open(struct vlc_memstream *ms)
 {
     ms->error = 0;
-    ms->ptr = calloc(1, 1);
+    ms->ptr = malloc(vlc_memstream_bufsize(1));
     if (unlikely(ms->ptr == NULL))
         ms->error = EOF;
+    else
+        ms->ptr[0] = '\0';
     ms->length = 0;
     return ms->error;
 }
@@ -120,9 +187,18 @@ int vlc_memstream_flush(struct vlc_memstream *ms)
 int vlc_memstream_close(struct vlc_memstream *ms)
 {
     if (ms->error)
+    {
         free(ms->ptr);
-    return ms->error;
-} 
+        return ms->error;
+    }
+
+    /* Trim the geometric growth slack: the buffer may long outlive the
+     * stream object */
+    char *base = realloc(ms->ptr, ms->length + 1);
+    if (likely(base != NULL))
+        ms->ptr = base;
+    return 0;
+}
 
 size_t vlc_memstream_write(struct vlc_memstream *ms, const void *ptr,
                            size_t len)
@@ -133,12 +209,11 @@ size_t vlc_memstream_write(struct vlc_memstream *ms, const void *ptr,
      || unlikely(add_overflow(newlen, 1, &newlen)))
         goto error;
 
-    char *base = realloc(ms->ptr, newlen);
+    char *base = vlc_memstream_grow(ms, newlen);
     if (unlikely(base == NULL))
         goto error;
 
     memcpy(base + ms->length, ptr, len);
-    ms->ptr = base;
     ms->length += len;
     base[ms->length] = '\0';
     return len;
@@ -148,6 +223,37 @@ error:
     return 0;
 }
 
+size_t vlc_memstream_writev(struct vlc_memstream *ms,
+                            const struct iovec *iov, int iovcnt)
+{
+    size_t total = 0;
+    size_t newlen;
+
+    for (int i = 0; i < iovcnt; i++)
+        if (unlikely(add_overflow(total, iov[i].iov_len, &total)))
+            goto error;
+
+    if (unlikely(add_overflow(ms->length, total, &newlen))
+     || unlikely(add_overflow(newlen, 1, &newlen)))
+        goto error;
+
+    char *base = vlc_memstream_grow(ms, newlen);
+    if (unlikely(base == NULL))
+        goto error;
+
+    for (int i = 0; i < iovcnt; i++)
+    {
+        memcpy(base + ms->length, iov[i].iov_base, iov[i].iov_len);
+        ms->length += iov[i].iov_len;
+    }
+    base[ms->length] = '\0';
+    return total;
+
+error:
+    ms->error = EOF;
+    return 0;
+}
+
 int vlc_memstream_putc(struct vlc_memstream *ms, int c)
 {
     return (vlc_memstream_write(ms, &(unsigned char){ c }, 1u) == 1) ? c : EOF;
@@ -176,12 +282,11 @@ int vlc_memstream_vprintf(struct vlc_memstream *ms, const char *fmt,
      || unlikely(add_overflow(newlen, 1, &newlen)))
         goto error;
 
-    ptr = realloc(ms->ptr, newlen);
+    ptr = vlc_memstream_grow(ms, newlen);
     if (ptr == NULL)
         goto error;
 
     vsnprintf(ptr + ms->length, len + 1, fmt, args);
-    ms->ptr = ptr;
     ms->length += len;
     return len;
 
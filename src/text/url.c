@@ -792,9 +792,9 @@ error:
     return NULL;
 }
 
-char *vlc_uri_resolve(const char *base, const char *ref)
+char *vlc_uri_resolve_url(const vlc_url_t *base, const char *ref)
 {
-    vlc_url_t base_uri, rel_uri;
+    vlc_url_t rel_uri;
     vlc_url_t tgt_uri;
     char *pathbuf = NULL, *ret = NULL;
 
@@ -810,34 +810,39 @@ char *vlc_uri_resolve(const char *base, const char *ref)
         return strdup(ref);
     }
 
-    vlc_UrlParse(&base_uri, base);
-
     /* RFC3986 section 5.2.2 */
     do
     {
         tgt_uri = rel_uri;
-        tgt_uri.psz_protocol = base_uri.psz_protocol;
+        tgt_uri.psz_protocol = base->psz_protocol;
 
         if (rel_uri.psz_host != NULL)
             break;
 
-        tgt_uri.psz_username = base_uri.psz_username;
-        tgt_uri.psz_password = base_uri.psz_password;
-        tgt_uri.psz_host = base_uri.psz_host;
-        tgt_uri.i_port = base_uri.i_port;
+        tgt_uri.psz_username = base->psz_username;
+        tgt_uri.psz_password = base->psz_password;
+        tgt_uri.psz_host = base->psz_host;
+        tgt_uri.i_port = base->i_port;
 
         if (rel_uri.psz_path == NULL || rel_uri.psz_path[0] == '\0')
         {
-            tgt_uri.psz_path = base_uri.psz_path;
+            if (base->psz_path != NULL)
+            {   /* Copy: removing dot segments must not modify the caller's
+                 * base URI */
+                pathbuf = strdup(base->psz_path);
+                if (unlikely(pathbuf == NULL))
+                    goto error;
+            }
+            tgt_uri.psz_path = pathbuf;
             if (rel_uri.psz_option == NULL)
-                tgt_uri.psz_option = base_uri.psz_option;
+                tgt_uri.psz_option = base->psz_option;
             break;
         }
 
         if (rel_uri.psz_path[0] == '/')
             break;
 
-        pathbuf = vlc_uri_merge_paths(base_uri.psz_path, rel_uri.psz_path);
+        pathbuf = vlc_uri_merge_paths(base->psz_path, rel_uri.psz_path);
         if (unlikely(pathbuf == NULL))
             goto error;
 
@@ -851,11 +856,22 @@ char *vlc_uri_resolve(const char *base, const char *ref)
     ret = vlc_uri_compose(&tgt_uri);
 error:
     free(pathbuf);
-    vlc_UrlClean(&base_uri);
     vlc_UrlClean(&rel_uri);
     return ret;
 }
 
+char *vlc_uri_resolve(const char *base, const char *ref)
+{
+    vlc_url_t base_uri;
+
+    vlc_UrlParse(&base_uri, base);
+
+    char *ret = vlc_uri_resolve_url(&base_uri, ref);
+
+    vlc_UrlClean(&base_uri);
+    return ret;
+}
+
 static char *vlc_uri_fixup_inner(const char *str, const char *extras)
 {
     assert(str && extras);
@@ -25,28 +25,25 @@
 
 #include <assert.h>
 
-typedef struct {
-    int     shift;
-    vlc_tick_t avg;
-    unsigned avg_count;
+/* Maximum number of samples kept in the sliding window */
+#define VOUT_CHRONO_MAX_SAMPLES 64
 
-    int     shift_mad;
-    vlc_tick_t mad; /* mean absolute deviation */
-    unsigned mad_count;
+typedef struct {
+    unsigned window;  /* sliding window size, at most VOUT_CHRONO_MAX_SAMPLES */
+    unsigned count;   /* number of valid samples, at most window */
+    unsigned index;   /* next write position in the ring */
+    vlc_tick_t samples[VOUT_CHRONO_MAX_SAMPLES];
 
+    vlc_tick_t initial; /* estimate returned until the first sample */
     vlc_tick_t start;
 } vout_chrono_t;
 
-static inline void vout_chrono_Init(vout_chrono_t *chrono, int shift, vlc_tick_t avg_initial)
+static inline void vout_chrono_Init(vout_chrono_t *chrono, int shift, vlc_tick_t initial)
 {
-    chrono->avg_count   = 0;
-    chrono->mad_count   = 0;
-
-    chrono->shift       = shift;
-    chrono->avg         = avg_initial;
-
-    chrono->shift_mad   = shift+1;
-    chrono->mad         = 0;
+    chrono->window  = __MIN(1u << shift, VOUT_CHRONO_MAX_SAMPLES);
+    chrono->count   = 0;
+    chrono->index   = 0;
+    chrono->initial = initial;
 
     chrono->start = VLC_TICK_INVALID;
 }
@@ -56,14 +53,43 @@ static inline void vout_chrono_Start(vout_chrono_t *chrono)
     chrono->start = vlc_tick_now();
 }
 
-static inline vlc_tick_t vout_chrono_GetHigh(vout_chrono_t *chrono)
+/**
+ * Returns the requested percentile of the sampled durations.
+ *
+ * Percentiles are computed over a sliding window rather than a running
+ * average: with jittery render times (variable GPU load) the average
+ * underestimates the deadline and produces bursts of late frames, while a
+ * high percentile absorbs the jitter.
+ */
+static inline vlc_tick_t vout_chrono_GetPercentile(const vout_chrono_t *chrono,
+                                                   unsigned percentile)
 {
-    return chrono->avg + 2 * chrono->mad;
+    assert(percentile > 0 && percentile <= 100);
+
+    if (chrono->count == 0)
+        return chrono->initial;
+
+    /* The window is small: a sorted insertion is cheap enough */
+    vlc_tick_t sorted[VOUT_CHRONO_MAX_SAMPLES];
+    for (unsigned i = 0; i < chrono->count; i++) {
+        unsigned j = i;
+        while (j > 0 && sorted[j - 1] > chrono->samples[i]) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = chrono->samples[i];
+    }
+
+    /* Nearest-rank percentile */
+    const unsigned rank = (percentile * chrono->count + 99) / 100;
+    return sorted[rank - 1];
 }
 
-static inline vlc_tick_t vout_chrono_GetLow(vout_chrono_t *chrono)
+static inline vlc_tick_t vout_chrono_GetHigh(const vout_chrono_t *chrono)
 {
-    return __MAX(chrono->avg - 2 * chrono->mad, 0);
+    /* p90 paces rendering: late enough to absorb jitter, but a few
+     * outliers do not stall the pipeline for seconds */
+    return vout_chrono_GetPercentile(chrono, 90);
 }
 
 static inline void vout_chrono_Stop(vout_chrono_t *chrono)
@@ -72,29 +98,10 @@ static inline void vout_chrono_Stop(vout_chrono_t *chrono)
 
     const vlc_tick_t duration = vlc_tick_now() - chrono->start;
 
-    if (chrono->avg_count == 0)
-    {
-        /* Overwrite the arbitrary initial values with the real first sample */
-        chrono->avg = duration;
-        chrono->avg_count = 1;
-    }
-    else
-    {
-        /* Update average only if the current point is 'valid' */
-        if( duration < vout_chrono_GetHigh( chrono ) )
-        {
-            if (chrono->avg_count < (1u << chrono->shift))
-                ++chrono->avg_count;
-            chrono->avg = ((chrono->avg_count - 1) * chrono->avg + duration) / chrono->avg_count;
-        }
-
-        const vlc_tick_t abs_diff = llabs( duration - chrono->avg );
-
-        /* Always update the mean absolute deviation */
-        if (chrono->mad_count < (1u << chrono->shift_mad))
-            ++chrono->mad_count;
-        chrono->mad = ((chrono->mad_count - 1) * chrono->mad + abs_diff) / chrono->mad_count;
-    }
+    chrono->samples[chrono->index] = duration;
+    chrono->index = (chrono->index + 1) % chrono->window;
+    if (chrono->count < chrono->window)
+        chrono->count++;
 
     /* For assert */
     chrono->start = VLC_TICK_INVALID;
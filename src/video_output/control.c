@@ -38,14 +38,20 @@ void vout_control_Init(vout_control_t *ctrl)
 
     ctrl->is_held = false;
     ctrl->yielding = false;
-    ctrl->forced_awake = false;
+    atomic_init(&ctrl->forced_awake, false);
     ctrl->pending_count = 0;
 }
 
 void vout_control_Wake(vout_control_t *ctrl)
 {
+    /* Coalesce wake-ups: if a previous wake has not been consumed yet, the
+     * vout thread is guaranteed to come back to us without a new signal.
+     * This keeps back-to-back picture pushes down to one atomic operation. */
+    if (atomic_exchange_explicit(&ctrl->forced_awake, true,
+                                 memory_order_release))
+        return;
+
     vlc_mutex_lock(&ctrl->lock);
-    ctrl->forced_awake = true;
     vlc_cond_signal(&ctrl->wait_request);
     vlc_mutex_unlock(&ctrl->lock);
 }
@@ -82,7 +88,7 @@ void vout_control_ReleaseAndWake(vout_control_t *ctrl)
 {
     vlc_mutex_lock(&ctrl->lock);
     vout_control_ReleaseUnlocked(ctrl);
-    ctrl->forced_awake = true;
+    atomic_store_explicit(&ctrl->forced_awake, true, memory_order_release);
     vlc_cond_signal(&ctrl->wait_request);
     vlc_mutex_unlock(&ctrl->lock);
 }
@@ -104,7 +110,8 @@ void vout_control_Wait(vout_control_t *ctrl, vlc_tick_t deadline)
     {
         do
         {
-            if (ctrl->forced_awake)
+            if (atomic_load_explicit(&ctrl->forced_awake,
+                                     memory_order_acquire))
                 break;
 
             vlc_cond_signal(&ctrl->wait_available);
@@ -118,7 +125,7 @@ void vout_control_Wait(vout_control_t *ctrl, vlc_tick_t deadline)
     while (ctrl->is_held)
         vlc_cond_wait(&ctrl->wait_available, &ctrl->lock);
 
-    ctrl->forced_awake = false;
+    atomic_store_explicit(&ctrl->forced_awake, false, memory_order_relaxed);
     vlc_mutex_unlock(&ctrl->lock);
 }
 
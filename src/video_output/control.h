@@ -23,6 +23,8 @@
 #ifndef LIBVLC_VOUT_INTERNAL_CONTROL_H
 #define LIBVLC_VOUT_INTERNAL_CONTROL_H
 
+#include <stdatomic.h>
+
 #include <vlc_viewpoint.h>
 
 /* */
@@ -32,7 +34,7 @@ typedef struct {
     vlc_cond_t wait_available; /* available: yielding && !is_held */
 
     /* */
-    bool forced_awake;
+    atomic_bool forced_awake;
     bool yielding;
     bool is_held;
     unsigned pending_count;
@@ -229,6 +229,10 @@ void vout_display_TranslateCoordinates(int *restrict xp, int *restrict yp,
     *yp = y;
 }
 
+/* Delay without any resize after which the display geometry is considered
+ * settled and the scaler can be rebuilt at the configured quality */
+#define VOUT_RESIZE_SETTLE_DELAY VLC_TICK_FROM_MS(250)
+
 typedef struct {
     vout_display_t  display;
 
@@ -244,6 +248,15 @@ typedef struct {
       * can be done and nothing will be displayed */
     filter_chain_t *converters;
     picture_pool_t *pool;
+
+    /* Scaler quality ladder: while the display size is being dragged
+     * around, software scaling drops to a cheap filter so that each
+     * intermediate size stays interactive; the configured quality is
+     * restored once the geometry has settled. Only effective when the
+     * converter chain does the scaling. */
+    vlc_tick_t resize_date;
+    int64_t scale_mode;
+    bool low_quality_scale;
 } vout_display_priv_t;
 
 /*****************************************************************************
@@ -376,10 +389,30 @@ picture_t *vout_ConvertForDisplay(vout_display_t *vd, picture_t *picture)
     return filter_chain_VideoFilter(osys->converters, picture);
 }
 
+/* Restore the configured scaler quality once resizing has stopped */
+static void VoutDisplayRestoreScaleQuality(vout_display_t *vd)
+{
+    vout_display_priv_t *osys = container_of(vd, vout_display_priv_t, display);
+
+    if (likely(!osys->low_quality_scale)
+     || vlc_tick_now() - osys->resize_date < VOUT_RESIZE_SETTLE_DELAY)
+        return;
+
+    osys->low_quality_scale = false;
+    var_SetInteger(vd, "swscale-mode", osys->scale_mode);
+
+    if (osys->converters != NULL && !filter_chain_IsEmpty(osys->converters)) {
+        filter_chain_Delete(osys->converters);
+        if (VoutDisplayCreateRender(vd))
+            msg_Err(vd, "Failed to restore the scaler quality");
+    }
+}
+
 picture_t *vout_display_Prepare(vout_display_t *vd, picture_t *picture,
                                 subpicture_t *subpic, vlc_tick_t date)
 {
     assert(subpic == NULL); /* TODO */
+    VoutDisplayRestoreScaleQuality(vd);
     picture = vout_ConvertForDisplay(vd, picture);
 
     if (picture != NULL && vd->ops->prepare != NULL)
@@ -539,6 +572,16 @@ void vout_UpdateDisplaySourceProperties(vout_display_t *vd, const video_format_t
 void vout_display_SetSize(vout_display_t *vd, unsigned width, unsigned height)
 {
     vout_display_priv_t *osys = container_of(vd, vout_display_priv_t, display);
+    vlc_tick_t now = vlc_tick_now();
+
+    if (!osys->low_quality_scale && osys->resize_date != VLC_TICK_INVALID
+     && now - osys->resize_date < VOUT_RESIZE_SETTLE_DELAY) {
+        /* Second resize in a row: the size is being dragged interactively,
+         * make any software scaler rebuilt below as cheap as possible */
+        osys->low_quality_scale = true;
+        var_SetInteger(vd, "swscale-mode", 0 /* fast bilinear */);
+    }
+    osys->resize_date = now;
 
     osys->cfg.display.width  = width;
     osys->cfg.display.height = height;
@@ -692,6 +735,12 @@ vout_display_t *vout_display_New(vlc_object_t *parent,
 
     osys->pool = NULL;
 
+    /* Inherit the software scaler quality here, so that it can be
+     * overridden for the converter chain while resizing */
+    osys->resize_date = VLC_TICK_INVALID;
+    osys->scale_mode = var_CreateGetInteger(&osys->display, "swscale-mode");
+    osys->low_quality_scale = false;
+
     video_format_Copy(&osys->source, source);
     osys->crop.mode = VOUT_CROP_NONE;
 
@@ -146,29 +146,46 @@ void vout_InitInterlacingSupport(vout_thread_t *vout, vout_thread_private_t *sys
     var_Create(vout, "sout-deinterlace-mode", VLC_VAR_STRING);
 
     sys->interlacing.is_interlaced = false;
+    sys->interlacing.sample = 0;
 }
 
 void vout_ReinitInterlacingSupport(vout_thread_t *vout, vout_thread_private_t *sys)
 {
     sys->interlacing.is_interlaced = false;
+    sys->interlacing.sample = 0;
     var_SetBool(vout, "deinterlace-needed", false);
 }
 
+/* While the verdict is stable, only refresh the hold-off clock once every
+ * that many frames; content type changes are still acted on immediately. */
+#define INTERLACING_SAMPLE_PERIOD 16
+
 void vout_SetInterlacingState(vout_thread_t *vout, vout_thread_private_t *sys, bool is_interlaced)
 {
-    const bool interlacing_change =
-        is_interlaced != sys->interlacing.is_interlaced;
+    if (is_interlaced == sys->interlacing.is_interlaced)
+    {
+        /* Steady state: nothing to decide, and no reason to read the
+         * clock on every single displayed frame */
+        if (!is_interlaced)
+            return;
+        if (++sys->interlacing.sample < INTERLACING_SAMPLE_PERIOD)
+            return;
+        sys->interlacing.sample = 0;
+        sys->interlacing.date = vlc_tick_now();
+        return;
+    }
 
     /* Wait 30s before quitting interlacing mode */
     const bool is_after_deadline =
         sys->interlacing.date + VLC_TICK_FROM_SEC(30) < vlc_tick_now();
 
-    if (interlacing_change && (is_interlaced || is_after_deadline))
+    if (is_interlaced || is_after_deadline)
     {
         msg_Dbg(vout, "Detected %s video",
                  is_interlaced ? "interlaced" : "progressive");
         var_SetBool(vout, "deinterlace-needed", is_interlaced);
         sys->interlacing.is_interlaced = is_interlaced;
+        sys->interlacing.sample = 0;
     }
     if (is_interlaced)
         sys->interlacing.date = vlc_tick_now();
@@ -31,6 +31,7 @@
 #include <time.h>
 
 #include <vlc_common.h>
+#include <vlc_executor.h>
 #include <vlc_fs.h>
 #include <vlc_strings.h>
 #include <vlc_block.h>
@@ -46,6 +47,9 @@ struct vout_snapshot {
     bool        is_available;
     int         request_count;
     vlc_picture_chain_t pics;
+
+    /* Worker for asynchronous snapshot saving, spawned on first use */
+    vlc_executor_t *executor;
 };
 
 vout_snapshot_t *vout_snapshot_New(void)
@@ -60,6 +64,7 @@ vout_snapshot_t *vout_snapshot_New(void)
     snap->is_available = true;
     snap->request_count = 0;
     vlc_picture_chain_Init( &snap->pics );
+    snap->executor = NULL;
     return snap;
 }
 
@@ -68,6 +73,11 @@ void vout_snapshot_Destroy(vout_snapshot_t *snap)
     if (snap == NULL)
         return;
 
+    if (snap->executor != NULL) {
+        vlc_executor_WaitIdle(snap->executor);
+        vlc_executor_Delete(snap->executor);
+    }
+
     while ( !vlc_picture_chain_IsEmpty( &snap->pics ) ) {
         picture_t *picture = vlc_picture_chain_PopFront( &snap->pics );
         picture_Release(picture);
@@ -116,6 +126,26 @@ picture_t *vout_snapshot_Get(vout_snapshot_t *snap, vlc_tick_t timeout)
     return picture;
 }
 
+int vout_snapshot_Submit(vout_snapshot_t *snap, struct vlc_runnable *runnable)
+{
+    if (snap == NULL)
+        return VLC_EGENERIC;
+
+    vlc_mutex_lock(&snap->lock);
+    if (snap->executor == NULL)
+        /* One thread is plenty: the picture handoff with the display
+         * thread serializes the requests anyway. */
+        snap->executor = vlc_executor_New(1);
+    vlc_executor_t *executor = snap->executor;
+    vlc_mutex_unlock(&snap->lock);
+
+    if (unlikely(executor == NULL))
+        return VLC_ENOMEM;
+
+    vlc_executor_Submit(executor, runnable);
+    return VLC_SUCCESS;
+}
+
 bool vout_snapshot_IsRequested(vout_snapshot_t *snap)
 {
     if (snap == NULL)
@@ -23,6 +23,7 @@
 #ifndef LIBVLC_VOUT_INTERNAL_SNAPSHOT_H
 #define LIBVLC_VOUT_INTERNAL_SNAPSHOT_H
 
+#include <vlc_executor.h>
 #include <vlc_picture.h>
 
 typedef struct vout_snapshot vout_snapshot_t;
@@ -36,6 +37,14 @@ void vout_snapshot_End(vout_snapshot_t *);
 /* */
 picture_t *vout_snapshot_Get(vout_snapshot_t *, vlc_tick_t timeout);
 
+/**
+ * It runs a snapshot saving task on a worker thread.
+ *
+ * The worker is created on the first submission and joined by
+ * vout_snapshot_Destroy(), which waits for the pending tasks.
+ */
+int vout_snapshot_Submit(vout_snapshot_t *, struct vlc_runnable *);
+
 /**
  * It tells if they are pending snapshot request
  */
@@ -24,6 +24,8 @@
 # define LIBVLC_VOUT_STATISTIC_H
 # include <stdatomic.h>
 
+# include "../misc/latency.h"
+
 /* NOTE: Both statistics are atomic on their own, so one might be older than
  * the other one. Currently, only one of them is updated at a time, so this
  * is a non-issue. */
@@ -31,6 +33,10 @@ typedef struct {
     atomic_uint displayed;
     atomic_uint lost;
     atomic_uint late;
+    atomic_uint degraded;
+    atomic_uintmax_t latency_sum;
+    atomic_uint latency_samples;
+    atomic_uint latency_buckets[INPUT_STATS_LATENCY_BUCKETS];
 } vout_statistic_t;
 
 static inline void vout_statistic_Init(vout_statistic_t *stat)
@@ -38,6 +44,11 @@ static inline void vout_statistic_Init(vout_statistic_t *stat)
     atomic_init(&stat->displayed, 0);
     atomic_init(&stat->lost, 0);
     atomic_init(&stat->late, 0);
+    atomic_init(&stat->degraded, 0);
+    atomic_init(&stat->latency_sum, 0);
+    atomic_init(&stat->latency_samples, 0);
+    for (size_t i = 0; i < ARRAY_SIZE(stat->latency_buckets); i++)
+        atomic_init(&stat->latency_buckets[i], 0);
 }
 
 static inline void vout_statistic_Clean(vout_statistic_t *stat)
@@ -48,12 +59,23 @@ static inline void vout_statistic_Clean(vout_statistic_t *stat)
 static inline void vout_statistic_GetReset(vout_statistic_t *stat,
                                            unsigned *restrict displayed,
                                            unsigned *restrict lost,
-                                           unsigned *restrict late)
+                                           unsigned *restrict late,
+                                           unsigned *restrict degraded,
+                                           struct vlc_latency_histogram *restrict latency)
 {
     *displayed = atomic_exchange_explicit(&stat->displayed, 0,
                                           memory_order_relaxed);
     *lost = atomic_exchange_explicit(&stat->lost, 0, memory_order_relaxed);
     *late = atomic_exchange_explicit(&stat->late, 0, memory_order_relaxed);
+    *degraded = atomic_exchange_explicit(&stat->degraded, 0,
+                                         memory_order_relaxed);
+    latency->sum = atomic_exchange_explicit(&stat->latency_sum, 0,
+                                            memory_order_relaxed);
+    latency->samples = atomic_exchange_explicit(&stat->latency_samples, 0,
+                                                memory_order_relaxed);
+    for (size_t i = 0; i < ARRAY_SIZE(stat->latency_buckets); i++)
+        latency->buckets[i] = atomic_exchange_explicit(&stat->latency_buckets[i],
+                                                       0, memory_order_relaxed);
 }
 
 static inline void vout_statistic_AddDisplayed(vout_statistic_t *stat,
@@ -73,4 +95,21 @@ static inline void vout_statistic_AddLate(vout_statistic_t *stat, int late)
     atomic_fetch_add_explicit(&stat->late, late, memory_order_relaxed);
 }
 
+static inline void vout_statistic_AddDegraded(vout_statistic_t *stat,
+                                              int degraded)
+{
+    atomic_fetch_add_explicit(&stat->degraded, degraded,
+                              memory_order_relaxed);
+}
+
+static inline void vout_statistic_AddLatency(vout_statistic_t *stat,
+                                             vlc_tick_t latency)
+{
+    atomic_fetch_add_explicit(&stat->latency_sum, latency,
+                              memory_order_relaxed);
+    atomic_fetch_add_explicit(&stat->latency_samples, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&stat->latency_buckets[vlc_latency_HistogramBucket(latency)],
+                              1, memory_order_relaxed);
+}
+
 #endif
@@ -103,6 +103,9 @@ typedef struct vout_thread_sys_t
     vlc_fourcc_t    spu_blend_chroma;
     vlc_blender_t   *spu_blend;
 
+    /* Worker pool for full picture copies (subtitle blending, ...) */
+    vlc_plane_copier_t *plane_copier;
+
     /* Thread & synchronization */
     vout_control_t  control;
     atomic_bool     control_is_terminated; // shutdown the vout thread
@@ -131,6 +134,13 @@ typedef struct vout_thread_sys_t
     /* */
     bool            is_late_dropped;
 
+    /* Degradation ladder for late pictures (display thread only). The
+     * decoder already drops non-reference frames on its own when late;
+     * the next rung is to bypass the user (interactive) filters until the
+     * output has caught up. */
+    unsigned        late_streak; /**< consecutive pictures dropped for lateness */
+    bool            degraded;    /**< interactive filters currently bypassed */
+
     /* */
     vlc_mouse_t     mouse;
 
@@ -262,11 +272,14 @@ static void vout_UpdateWindowSizeLocked(vout_thread_sys_t *vout)
 
 /* */
 void vout_GetResetStatistic(vout_thread_t *vout, unsigned *restrict displayed,
-                            unsigned *restrict lost, unsigned *restrict late)
+                            unsigned *restrict lost, unsigned *restrict late,
+                            unsigned *restrict degraded,
+                            struct vlc_latency_histogram *restrict latency)
 {
     vout_thread_sys_t *sys = VOUT_THREAD_TO_SYS(vout);
     assert(!sys->dummy);
-    vout_statistic_GetReset( &sys->statistic, displayed, lost, late );
+    vout_statistic_GetReset( &sys->statistic, displayed, lost, late,
+                             degraded, latency );
 }
 
 bool vout_IsEmpty(vout_thread_t *vout)
@@ -391,6 +404,17 @@ void vout_PutPicture(vout_thread_t *vout, picture_t *picture)
     vout_control_Wake(&sys->control);
 }
 
+void vout_PutPictureChain(vout_thread_t *vout, vlc_picture_chain_t *chain)
+{
+    vout_thread_sys_t *sys = VOUT_THREAD_TO_SYS(vout);
+    picture_t *picture;
+
+    assert(!sys->dummy);
+    while ((picture = vlc_picture_chain_PopFront(chain)) != NULL)
+        picture_fifo_Push(sys->decoder_fifo, picture);
+    vout_control_Wake(&sys->control);
+}
+
 /* */
 int vout_GetSnapshot(vout_thread_t *vout,
                      block_t **image_dst, picture_t **picture_dst,
@@ -427,6 +451,13 @@ int vout_GetSnapshot(vout_thread_t *vout,
     return VLC_SUCCESS;
 }
 
+int vout_SubmitSnapshotTask(vout_thread_t *vout, struct vlc_runnable *runnable)
+{
+    vout_thread_sys_t *sys = VOUT_THREAD_TO_SYS(vout);
+    assert(!sys->dummy);
+    return vout_snapshot_Submit(sys->snapshot, runnable);
+}
+
 /* vout_Control* are usable by anyone at anytime */
 void vout_ChangeFullscreen(vout_thread_t *vout, const char *id)
 {
@@ -905,9 +936,19 @@ static void ChangeFilters(vout_thread_sys_t *vout)
 
     es_format_Clean(&fmt_target);
 
+    unsigned copies =
+        filter_chain_GetVideoCopyCount(sys->filter.chain_static) +
+        filter_chain_GetVideoCopyCount(sys->filter.chain_interactive);
+    if (copies > 1)
+        msg_Warn(&vout->obj, "filters copy pictures to CPU memory %u times "
+                 "per frame", copies);
+
     sys->filter.changed = false;
 }
 
+/* Consecutive late-dropped pictures before user filters are bypassed */
+#define VOUT_DEGRADE_LATE_STREAK 4
+
 static bool IsPictureLate(vout_thread_sys_t *vout, picture_t *decoded,
                           vlc_tick_t system_now, vlc_tick_t system_pts)
 {
@@ -968,6 +1009,15 @@ static picture_t *PreparePicture(vout_thread_sys_t *vout, bool reuse_decoded,
                         picture_Release(decoded);
                         vout_statistic_AddLost(&sys->statistic, 1);
 
+                        if (++sys->late_streak >= VOUT_DEGRADE_LATE_STREAK
+                         && !sys->degraded)
+                        {
+                            msg_Warn(&vout->obj, "%u consecutive late "
+                                     "pictures, bypassing user filters",
+                                     sys->late_streak);
+                            sys->degraded = true;
+                        }
+
                         /* A picture dropped means discontinuity for the
                          * filters and we need to notify eg. deinterlacer. */
                         filter_chain_VideoFlush(sys->filter.chain_static);
@@ -975,6 +1025,17 @@ static picture_t *PreparePicture(vout_thread_sys_t *vout, bool reuse_decoded,
                     }
                 }
 
+                if (sys->late_streak > 0)
+                {
+                    sys->late_streak = 0;
+                    if (sys->degraded)
+                    {
+                        msg_Dbg(&vout->obj, "output caught up, restoring "
+                                "user filters");
+                        sys->degraded = false;
+                    }
+                }
+
                 if (!VideoFormatIsCropArEqual(&decoded->format, &sys->filter.src_fmt))
                 {
                     // we received an aspect ratio change
@@ -986,7 +1047,26 @@ static picture_t *PreparePicture(vout_thread_sys_t *vout, bool reuse_decoded,
                     vlc_video_context *pic_vctx = picture_GetVideoContext(decoded);
                     sys->filter.src_vctx = pic_vctx ? vlc_video_context_Hold(pic_vctx) : NULL;
 
-                    ChangeFilters(vout);
+                    /* Benign deltas (SAR updates from repeated SPS, frame
+                     * rate changes) are absorbed by the loaded filters;
+                     * only true layout changes rebuild the chains. */
+                    es_format_t fmt;
+                    es_format_InitFromVideo(&fmt, &decoded->format);
+                    bool updated = filter_chain_UpdateSourceFormat(
+                            sys->filter.chain_static, &fmt,
+                            sys->filter.src_vctx);
+                    if (updated)
+                        updated = filter_chain_UpdateSourceFormat(
+                                sys->filter.chain_interactive,
+                                filter_chain_GetFmtOut(sys->filter.chain_static),
+                                filter_chain_GetVideoCtxOut(sys->filter.chain_static));
+                    es_format_Clean(&fmt);
+
+                    if (updated)
+                        msg_Dbg(&vout->obj,
+                                "updated filters in place on format change");
+                    else
+                        ChangeFilters(vout);
                 }
             }
         }
@@ -1082,6 +1162,16 @@ static picture_t *FilterPictureInteractive(vout_thread_sys_t *sys)
     picture_Hold(sys->displayed.current);
 
     vlc_mutex_lock(&sys->filter.lock);
+    if (sys->degraded
+     && video_format_IsSimilar(&sys->displayed.current->format,
+            &filter_chain_GetFmtOut(sys->filter.chain_interactive)->video))
+    {
+        /* Running behind: skip the user filters to catch up. Only possible
+         * when the chain does not change the picture format. */
+        vlc_mutex_unlock(&sys->filter.lock);
+        vout_statistic_AddDegraded(&sys->statistic, 1);
+        return sys->displayed.current;
+    }
     picture_t *filtered = filter_chain_VideoFilter(sys->filter.chain_interactive, sys->displayed.current);
     vlc_mutex_unlock(&sys->filter.lock);
 
@@ -1200,7 +1290,11 @@ static int PrerenderPicture(vout_thread_sys_t *sys, picture_t *filtered,
             picture_t *blent = picture_pool_Get(sys->private.private_pool);
             if (blent) {
                 video_format_CopyCropAr(&blent->format, &filtered->format);
-                picture_Copy(blent, filtered);
+                if (sys->plane_copier != NULL) {
+                    vlc_plane_copier_CopyPixels(sys->plane_copier, blent, filtered);
+                    picture_CopyProperties(blent, filtered);
+                } else
+                    picture_Copy(blent, filtered);
                 if (picture_BlendSubpicture(blent, sys->spu_blend, subpic)) {
                     picture_Release(todisplay);
                     snap_pic = todisplay = blent;
@@ -1299,12 +1393,33 @@ static int RenderPicture(vout_thread_sys_t *sys, bool render_now)
     const unsigned frame_rate = todisplay->format.i_frame_rate;
     const unsigned frame_rate_base = todisplay->format.i_frame_rate_base;
 
+    struct vlc_tracer *tracer = GetTracer(sys);
+
     if (vd->ops->prepare != NULL)
+    {
+        vlc_tick_t prepare_start = vlc_tick_now();
         vd->ops->prepare(vd, todisplay, subpic, system_pts);
+        if (tracer != NULL)
+            vlc_tracer_Trace(tracer, VLC_TRACE("type", "RENDER"),
+                             VLC_TRACE("id", sys->str_id),
+                             VLC_TRACE("prepare_time",
+                                       vlc_tick_now() - prepare_start),
+                             VLC_TRACE_END);
+    }
 
     vout_chrono_Stop(&sys->chrono.render);
 
-    struct vlc_tracer *tracer = GetTracer(sys);
+    if (tracer != NULL)
+        vlc_tracer_Trace(tracer, VLC_TRACE("type", "RENDER"),
+                         VLC_TRACE("id", sys->str_id),
+                         VLC_TRACE("render_p50",
+                                   vout_chrono_GetPercentile(&sys->chrono.render, 50)),
+                         VLC_TRACE("render_p90",
+                                   vout_chrono_GetPercentile(&sys->chrono.render, 90)),
+                         VLC_TRACE("render_p99",
+                                   vout_chrono_GetPercentile(&sys->chrono.render, 99)),
+                         VLC_TRACE_END);
+
     system_now = vlc_tick_now();
     if (!render_now)
     {
@@ -1368,9 +1483,40 @@ static int RenderPicture(vout_thread_sys_t *sys, bool render_now)
                                              frame_rate, frame_rate_base);
 
     /* Display the direct buffer returned by vout_RenderPicture */
+    vlc_tick_t display_start = vlc_tick_now();
     vout_display_Display(vd, todisplay);
+    if (tracer != NULL)
+        vlc_tracer_Trace(tracer, VLC_TRACE("type", "RENDER"),
+                         VLC_TRACE("id", sys->str_id),
+                         VLC_TRACE("display_time",
+                                   vlc_tick_now() - display_start),
+                         VLC_TRACE_END);
     vlc_queuedmutex_unlock(&sys->display_lock);
 
+    /* Account the glass-to-glass latency of the displayed picture */
+    struct vlc_ancillary *latency_ancillary =
+        picture_GetAncillary(todisplay, VLC_ANCILLARY_ID_LATENCY);
+    if (latency_ancillary != NULL)
+    {
+        const struct vlc_latency_tag *tag =
+            vlc_ancillary_GetData(latency_ancillary);
+        if (tag->demux != VLC_TICK_INVALID)
+        {
+            vlc_tick_t display_date = vlc_tick_now();
+
+            vout_statistic_AddLatency(&sys->statistic,
+                                      display_date - tag->demux);
+            if (tracer != NULL)
+                vlc_tracer_Trace(tracer, VLC_TRACE("type", "RENDER"),
+                                 VLC_TRACE("id", sys->str_id),
+                                 VLC_TRACE("decode_latency",
+                                           tag->decode - tag->demux),
+                                 VLC_TRACE("display_latency",
+                                           display_date - tag->demux),
+                                 VLC_TRACE_END);
+        }
+    }
+
     picture_Release(todisplay);
 
     if (subpic)
@@ -1659,7 +1805,9 @@ static int vout_Start(vout_thread_sys_t *vout, vlc_video_context *vctx, const vo
                                         cfg->mouse_event, cfg->mouse_opaque);
     vlc_mutex_unlock(&sys->window_lock);
 
-    sys->decoder_fifo = picture_fifo_New();
+    /* Only the decoder pushes and only the vout thread pops; flushes are
+     * serialized against the vout thread through the control. */
+    sys->decoder_fifo = picture_fifo_NewSPSC();
     sys->private.display_pool = NULL;
     sys->private.private_pool = NULL;
 
@@ -1945,6 +2093,9 @@ void vout_Release(vout_thread_t *vout)
     assert(!sys->window_enabled);
     vout_display_window_Delete(sys->display_cfg.window);
 
+    if (sys->plane_copier != NULL)
+        vlc_plane_copier_Delete(sys->plane_copier);
+
     /* */
     vout_statistic_Clean(&sys->statistic);
 
@@ -2025,6 +2176,9 @@ vout_thread_t *vout_Create(vlc_object_t *object)
     sys->snapshot = vout_snapshot_New();
     vout_statistic_Init(&sys->statistic);
 
+    /* Shared by every full picture copy performed on the vout thread */
+    sys->plane_copier = vlc_plane_copier_New(0);
+
     /* Initialize subpicture unit */
     sys->spu = var_InheritBool(vout, "spu") || var_InheritBool(vout, "osd") ?
                spu_Create(vout, vout) : NULL;
@@ -2039,6 +2193,8 @@ vout_thread_t *vout_Create(vlc_object_t *object)
     vout_InitInterlacingSupport(vout, &sys->private);
 
     sys->is_late_dropped = var_InheritBool(vout, "drop-late-frames");
+    sys->late_streak = 0;
+    sys->degraded = false;
 
     vlc_mutex_init(&sys->filter.lock);
 
@@ -2232,3 +2388,31 @@ vlc_decoder_device *vout_GetDevice(vout_thread_t *vout)
     vlc_mutex_unlock(&sys->window_lock);
     return dec_device;
 }
+
+vlc_decoder_device *vout_PeekDevice(vout_thread_t *vout)
+{
+    vlc_decoder_device *dec_device;
+
+    vout_thread_sys_t *sys = VOUT_THREAD_TO_SYS(vout);
+
+    vlc_mutex_lock(&sys->window_lock);
+    dec_device = sys->dec_device ? vlc_decoder_device_Hold( sys->dec_device ) : NULL;
+    vlc_mutex_unlock(&sys->window_lock);
+    return dec_device;
+}
+
+void vout_AdoptDevice(vout_thread_t *vout, vlc_decoder_device *dec_device)
+{
+    vout_thread_sys_t *sys = VOUT_THREAD_TO_SYS(vout);
+
+    vlc_mutex_lock(&sys->window_lock);
+    if (sys->dec_device == NULL)
+    {
+        sys->dec_device = dec_device;
+        dec_device = NULL;
+    }
+    vlc_mutex_unlock(&sys->window_lock);
+
+    if (dec_device != NULL)
+        vlc_decoder_device_Release(dec_device);
+}
@@ -28,6 +28,8 @@
 #include <vlc_clock.h>
 
 typedef struct input_thread_t input_thread_t;
+struct vlc_runnable;
+struct vlc_latency_histogram;
 
 /* It should be high enough to absorbe jitter due to difficult picture(s)
  * to decode but not too high as memory is not that cheap.
@@ -64,6 +66,24 @@ vout_thread_t *vout_CreateDummy(vlc_object_t *obj) VLC_USED;
  */
 vlc_decoder_device *vout_GetDevice(vout_thread_t *vout);
 
+/**
+ * Gets the decoder device the vout already created, if any.
+ *
+ * Unlike vout_GetDevice(), this does not create a device on demand.
+ *
+ * \return a decoder device reference, or NULL if the vout has none
+ */
+vlc_decoder_device *vout_PeekDevice(vout_thread_t *vout);
+
+/**
+ * Transfers a cached decoder device to the vout.
+ *
+ * The vout takes ownership of the reference and will hand the device out
+ * from vout_GetDevice() rather than creating a new one. The reference is
+ * released if the vout already owns a device.
+ */
+void vout_AdoptDevice(vout_thread_t *vout, vlc_decoder_device *dec_device);
+
 /**
  * Returns a suitable vout or release the given one.
  *
@@ -175,6 +195,12 @@ void vout_IntfReinit( vout_thread_t * );
 void vout_IntfDeinit(vlc_object_t *);
 enum vlc_video_fitting var_InheritFit(vlc_object_t *);
 
+/**
+ * This function queues a task on the vout snapshot worker thread.
+ * It is thread safe
+ */
+int vout_SubmitSnapshotTask(vout_thread_t *, struct vlc_runnable *);
+
 /* */
 ssize_t vout_RegisterSubpictureChannelInternal( vout_thread_t *,
                                                 vlc_clock_t *clock,
@@ -221,7 +247,9 @@ void vout_ChangeSpuDelay( vout_thread_t *, size_t channel_id, vlc_tick_t delay )
  * This function will return and reset internal statistics.
  */
 void vout_GetResetStatistic( vout_thread_t *p_vout, unsigned *pi_displayed,
-                             unsigned *pi_lost, unsigned *pi_late );
+                             unsigned *pi_lost, unsigned *pi_late,
+                             unsigned *pi_degraded,
+                             struct vlc_latency_histogram *p_latency );
 
 /**
  * This function will force to display the next picture while paused
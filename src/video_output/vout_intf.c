@@ -466,6 +466,19 @@ exit:
     free( psz_path );
 }
 
+struct vout_snapshot_task {
+    vout_thread_t *vout;
+    struct vlc_runnable runnable;
+};
+
+static void VoutSaveSnapshotTask( void *userdata )
+{
+    struct vout_snapshot_task *task = userdata;
+
+    VoutSaveSnapshot( task->vout );
+    free( task );
+}
+
 bool vout_ParseCrop(struct vout_crop *restrict cfg, const char *crop_str)
 {
     float fnum, fden;
@@ -627,6 +640,23 @@ static int SnapshotCallback( vlc_object_t *p_this, char const *psz_cmd,
     VLC_UNUSED(psz_cmd); VLC_UNUSED(oldval);
     VLC_UNUSED(newval); VLC_UNUSED(p_data);
 
+    /* Saving waits for the next rendered picture, then converts and encodes
+     * it: queue the work on the snapshot worker so the caller does not
+     * stall. The task does not hold a reference on the vout; vout_Close()
+     * removes this callback before the last reference can go away, and the
+     * worker is joined by the vout destructor before the object is deleted. */
+    struct vout_snapshot_task *task = malloc( sizeof(*task) );
+    if( likely(task != NULL) )
+    {
+        task->vout = p_vout;
+        task->runnable.run = VoutSaveSnapshotTask;
+        task->runnable.userdata = task;
+        if( vout_SubmitSnapshotTask( p_vout, &task->runnable ) == VLC_SUCCESS )
+            return VLC_SUCCESS;
+        free( task );
+    }
+
+    /* Keep the synchronous path as fallback */
     VoutSaveSnapshot( p_vout );
     return VLC_SUCCESS;
 }
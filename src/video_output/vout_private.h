@@ -36,6 +36,7 @@ struct vout_thread_private_t
     struct {
         bool        is_interlaced;
         bool        has_deint;
+        unsigned    sample;
         vlc_tick_t  date;
     } interlacing;
 
@@ -0,0 +1,255 @@
+/*****************************************************************************
+ * core.c: microbenchmarks for libvlccore primitives
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+/*
+ * Run with `make bench`. Each benchmark auto-scales its iteration count
+ * until the measured run is long enough to be meaningful, then reports
+ * the per-operation cost. The numbers are only comparable on the same
+ * machine and build flags; track them across releases, not across hosts.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include <vlc_common.h>
+#include <vlc_block.h>
+#include <vlc_cpu.h>
+#include <vlc_es.h>
+#include <vlc_picture.h>
+#include <vlc_picture_pool.h>
+#include <vlc_sort.h>
+#include <vlc_tick.h>
+#include <vlc_vector.h>
+
+#include "../modules/packetizer/startcode_helper.h"
+
+/* Long enough to dwarf timer and call overhead */
+#define BENCH_MIN_DURATION VLC_TICK_FROM_MS(200)
+
+typedef size_t (*bench_fn)(size_t iters);
+
+static void bench_Run(const char *name, bench_fn fn)
+{
+    size_t iters = 1024;
+    vlc_tick_t elapsed;
+    volatile size_t sink;
+
+    /* Warm-up run, also pages in the working set */
+    sink = fn(iters);
+
+    for (;;)
+    {
+        vlc_tick_t start = vlc_tick_now();
+        sink = fn(iters);
+        elapsed = vlc_tick_now() - start;
+        if (elapsed >= BENCH_MIN_DURATION || iters >= SIZE_MAX / 4)
+            break;
+        iters *= 4;
+    }
+    (void) sink;
+
+    printf("%-24s %12zu iters %10.1f ns/op\n", name, iters,
+           (double)NS_FROM_VLC_TICK(elapsed) / iters);
+}
+
+/* block_Alloc() / block_Release() round trip at a typical demux size */
+static size_t bench_BlockAlloc(size_t iters)
+{
+    size_t acc = 0;
+
+    for (size_t i = 0; i < iters; i++)
+    {
+        block_t *block = block_Alloc(1536);
+        if (unlikely(block == NULL))
+            abort();
+        block->p_buffer[0] = (uint8_t)i;
+        acc += block->p_buffer[0];
+        block_Release(block);
+    }
+    return acc;
+}
+
+/* Fifo enqueue/dequeue in small batches: the hot part of es_out_Send()
+ * feeding the decoder, without spinning up an input thread. */
+static size_t bench_BlockFifo(size_t iters)
+{
+    block_fifo_t *fifo = block_FifoNew();
+    if (unlikely(fifo == NULL))
+        abort();
+
+    size_t acc = 0;
+    for (size_t i = 0; i < iters; i += 64)
+    {
+        for (size_t j = 0; j < 64; j++)
+        {
+            block_t *block = block_Alloc(188);
+            if (unlikely(block == NULL))
+                abort();
+            block_FifoPut(fifo, block);
+        }
+        for (size_t j = 0; j < 64; j++)
+        {
+            block_t *block = block_FifoGet(fifo);
+            acc += block->i_buffer;
+            block_Release(block);
+        }
+    }
+    block_FifoRelease(fifo);
+    return acc;
+}
+
+/* picture_pool_Get() / picture_Release() cycling, as done per decoded
+ * frame by the video decoder owner */
+static size_t bench_PicturePool(size_t iters)
+{
+    video_format_t fmt;
+    video_format_Init(&fmt, 0);
+    video_format_Setup(&fmt, VLC_CODEC_I420, 640, 480, 640, 480, 1, 1);
+
+    picture_pool_t *pool = picture_pool_NewFromFormat(&fmt, 8);
+    if (unlikely(pool == NULL))
+        abort();
+
+    size_t acc = 0;
+    for (size_t i = 0; i < iters; i++)
+    {
+        picture_t *pic = picture_pool_Get(pool);
+        if (unlikely(pic == NULL))
+            abort();
+        acc += pic->i_planes;
+        picture_Release(pic);
+    }
+    picture_pool_Release(pool);
+    video_format_Clean(&fmt);
+    return acc;
+}
+
+/* vlc_vector_push() growth from an empty vector */
+static size_t bench_VectorGrow(size_t iters)
+{
+    struct VLC_VECTOR(int) v = VLC_VECTOR_INITIALIZER;
+
+    for (size_t i = 0; i < iters; i++)
+        if (!vlc_vector_push(&v, (int)i))
+            abort();
+
+    size_t acc = v.size;
+    vlc_vector_destroy(&v);
+    return acc;
+}
+
+/* vlc_vector_push_hole() growth with a struct payload built in place */
+static size_t bench_VectorStructGrow(size_t iters)
+{
+    struct entry { uint64_t key; uint64_t a, b, c; };
+    struct VLC_VECTOR(struct entry) v = VLC_VECTOR_INITIALIZER;
+
+    for (size_t i = 0; i < iters; i++)
+    {
+        struct entry *e;
+        if (!vlc_vector_push_hole(&v, &e))
+            abort();
+        e->key = i;
+        e->a = e->b = e->c = i ^ UINT64_C(0x5555555555555555);
+    }
+
+    size_t acc = v.size;
+    vlc_vector_destroy(&v);
+    return acc;
+}
+
+static int bench_CompareInt(const void *a, const void *b, void *arg)
+{
+    int x = *(const int *)a, y = *(const int *)b;
+
+    (void) arg;
+    return (x > y) - (x < y);
+}
+
+/* vlc_qsort() over 4096 random integers, re-shuffled each round */
+static size_t bench_SortInts(size_t iters)
+{
+    enum { COUNT = 4096 };
+    static int buf[COUNT];
+    uint32_t seed = 0x2545f491;
+
+    size_t acc = 0;
+    for (size_t i = 0; i < iters; i += COUNT)
+    {
+        for (size_t j = 0; j < COUNT; j++)
+        {
+            seed = seed * 1103515245 + 12345;
+            buf[j] = (int)(seed >> 8);
+        }
+        vlc_qsort(buf, COUNT, sizeof (buf[0]), bench_CompareInt, NULL);
+        acc += (unsigned)buf[0];
+    }
+    return acc;
+}
+
+/* Annex B start code scanning over a 64 KiB buffer with a start code
+ * every 4 KiB, the packetizer inner loop */
+static size_t bench_Startcode(size_t iters)
+{
+    static uint8_t buf[64 * 1024];
+    uint32_t seed = 0x12345678;
+
+    for (size_t i = 0; i < sizeof (buf); i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        buf[i] = 0x10 | (seed >> 24); /* never a 0x00 run */
+    }
+    for (size_t i = 4096; i < sizeof (buf); i += 4096)
+    {
+        buf[i - 3] = 0x00;
+        buf[i - 2] = 0x00;
+        buf[i - 1] = 0x01;
+    }
+
+    size_t acc = 0;
+    for (size_t i = 0; i < iters; i++)
+    {
+        const uint8_t *p = buf, *end = buf + sizeof (buf);
+        while ((p = startcode_FindAnnexB(p, end)) != NULL)
+        {
+            acc++;
+            p++;
+        }
+    }
+    return acc;
+}
+
+int main(void)
+{
+    printf("libvlccore microbenchmarks\n");
+
+    bench_Run("block_Alloc", bench_BlockAlloc);
+    bench_Run("block_Fifo", bench_BlockFifo);
+    bench_Run("picture_pool", bench_PicturePool);
+    bench_Run("vlc_vector_grow", bench_VectorGrow);
+    bench_Run("vlc_vector_struct_grow", bench_VectorStructGrow);
+    bench_Run("vlc_qsort_ints", bench_SortInts);
+    bench_Run("startcode_64k", bench_Startcode);
+    return 0;
+}
@@ -0,0 +1,305 @@
+/*****************************************************************************
+ * chroma.c: chroma converter benchmark and correctness matrix
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+/*
+ * For each (chroma in, chroma out, size) tuple, every "video converter"
+ * module able to open the conversion is run over the same deterministic
+ * input.  The lowest-score opened module (the C implementation) is the
+ * reference; the others must match it within a small per-conversion
+ * tolerance.  The module that default module_need() dispatches to is
+ * printed so silently disengaged SIMD paths are visible, and each
+ * implementation is timed.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#undef NDEBUG
+#include <assert.h>
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "../../libvlc/test.h"
+#include "../lib/libvlc_internal.h"
+
+#include <vlc/vlc.h>
+
+#include <vlc_common.h>
+#include <vlc_modules.h>
+#include <vlc_filter.h>
+#include <vlc_picture.h>
+
+#define BENCH_ITERS 32
+
+static const struct conversion
+{
+    vlc_fourcc_t in;
+    vlc_fourcc_t out;
+    unsigned tolerance; /* max per-byte difference vs the C reference */
+} conversions[] = {
+    { VLC_CODEC_I420, VLC_CODEC_YUYV, 0 },
+    { VLC_CODEC_YUYV, VLC_CODEC_I420, 0 },
+    { VLC_CODEC_I422, VLC_CODEC_YUYV, 0 },
+    { VLC_CODEC_I422, VLC_CODEC_I420, 0 },
+    { VLC_CODEC_GREY, VLC_CODEC_I420, 0 },
+    /* RGB matrixing rounds differently across implementations */
+    { VLC_CODEC_I420, VLC_CODEC_RGB32, 4 },
+};
+
+static const struct { unsigned width, height; } sizes[] = {
+    { 176, 144 }, { 640, 480 }, { 1920, 1080 },
+};
+
+static void format_Setup(video_format_t *fmt, vlc_fourcc_t chroma,
+                         unsigned width, unsigned height)
+{
+    video_format_Init(fmt, chroma);
+    fmt->i_width = fmt->i_visible_width = width;
+    fmt->i_height = fmt->i_visible_height = height;
+    fmt->i_sar_num = fmt->i_sar_den = 1;
+}
+
+static filter_t *converter_Create(vlc_object_t *parent,
+                                  const video_format_t *fmt_in,
+                                  const video_format_t *fmt_out,
+                                  const char *name)
+{
+    filter_t *filter = vlc_object_create(parent, sizeof (*filter));
+    assert(filter != NULL);
+
+    es_format_InitFromVideo(&filter->fmt_in, fmt_in);
+    es_format_InitFromVideo(&filter->fmt_out, fmt_out);
+
+    filter->p_module = module_need(filter, "video converter", name,
+                                   name != NULL);
+    if (filter->p_module == NULL)
+    {
+        es_format_Clean(&filter->fmt_in);
+        es_format_Clean(&filter->fmt_out);
+        vlc_object_delete(filter);
+        return NULL;
+    }
+    assert(filter->ops != NULL);
+    return filter;
+}
+
+static void converter_Delete(filter_t *filter)
+{
+    filter_Close(filter);
+    module_unneed(filter, filter->p_module);
+    es_format_Clean(&filter->fmt_in);
+    es_format_Clean(&filter->fmt_out);
+    vlc_object_delete(filter);
+}
+
+static void picture_FillPattern(picture_t *pic)
+{
+    uint32_t seed = 0x2545f491;
+
+    for (int i = 0; i < pic->i_planes; i++)
+    {
+        const plane_t *plane = &pic->p[i];
+        for (int y = 0; y < plane->i_lines; y++)
+        {
+            uint8_t *line = &plane->p_pixels[y * plane->i_pitch];
+            for (int x = 0; x < plane->i_pitch; x++)
+            {
+                seed = seed * 1103515245 + 12345;
+                line[x] = seed >> 24;
+            }
+        }
+    }
+}
+
+static unsigned picture_MaxDiff(const picture_t *a, const picture_t *b)
+{
+    unsigned max = 0;
+
+    assert(a->i_planes == b->i_planes);
+    for (int i = 0; i < a->i_planes; i++)
+    {
+        const plane_t *pa = &a->p[i], *pb = &b->p[i];
+        int lines = __MIN(pa->i_visible_lines, pb->i_visible_lines);
+        int pitch = __MIN(pa->i_visible_pitch, pb->i_visible_pitch);
+
+        for (int y = 0; y < lines; y++)
+        {
+            const uint8_t *la = &pa->p_pixels[y * pa->i_pitch];
+            const uint8_t *lb = &pb->p_pixels[y * pb->i_pitch];
+            for (int x = 0; x < pitch; x++)
+            {
+                unsigned diff = la[x] > lb[x] ? la[x] - lb[x] : lb[x] - la[x];
+                if (diff > max)
+                    max = diff;
+            }
+        }
+    }
+    return max;
+}
+
+static size_t picture_VisibleBytes(const picture_t *pic)
+{
+    size_t bytes = 0;
+
+    for (int i = 0; i < pic->i_planes; i++)
+        bytes += (size_t)pic->p[i].i_visible_lines
+               * (size_t)pic->p[i].i_visible_pitch;
+    return bytes;
+}
+
+static picture_t *converter_Run(filter_t *filter, picture_t *src)
+{
+    picture_Hold(src);
+    return filter->ops->filter_video(filter, src);
+}
+
+/* Returns the number of implementations disagreeing with the reference */
+static unsigned run_matrix_entry(vlc_object_t *parent, module_t *const *mods,
+                                 size_t nmods, const struct conversion *conv,
+                                 unsigned width, unsigned height)
+{
+    video_format_t fmt_in, fmt_out;
+    format_Setup(&fmt_in, conv->in, width, height);
+    format_Setup(&fmt_out, conv->out, width, height);
+
+    /* Which module does the default dispatch select? */
+    filter_t *dispatched = converter_Create(parent, &fmt_in, &fmt_out, NULL);
+    if (dispatched == NULL)
+    {
+        printf("%4.4s -> %4.4s %ux%u: no converter available\n",
+               (const char *)&conv->in, (const char *)&conv->out,
+               width, height);
+        return 0;
+    }
+    printf("%4.4s -> %4.4s %ux%u: dispatched %s\n",
+           (const char *)&conv->in, (const char *)&conv->out, width, height,
+           module_get_object(dispatched->p_module));
+    converter_Delete(dispatched);
+
+    picture_t *src = picture_NewFromFormat(&fmt_in);
+    assert(src != NULL);
+    picture_FillPattern(src);
+
+    picture_t *reference = NULL;
+    int reference_score = 0;
+    unsigned failures = 0;
+
+    /* Lowest score first, so the C implementation becomes the reference */
+    for (size_t pass = 0; pass < 2; pass++)
+        for (size_t i = 0; i < nmods; i++)
+        {
+            module_t *mod = mods[i];
+            if (!module_provides(mod, "video converter"))
+                continue;
+
+            const char *name = module_get_object(mod);
+            int score = module_get_score(mod);
+            bool ref_pass = reference == NULL
+                         || (pass == 0 && score <= reference_score);
+            if ((pass == 0) != ref_pass)
+                continue;
+
+            filter_t *filter = converter_Create(parent, &fmt_in, &fmt_out,
+                                                name);
+            if (filter == NULL)
+                continue;
+
+            picture_t *dst = converter_Run(filter, src);
+            if (dst == NULL)
+            {
+                converter_Delete(filter);
+                continue;
+            }
+
+            unsigned diff = 0;
+            if (reference == NULL)
+            {
+                reference = dst;
+                reference_score = score;
+                dst = NULL;
+            }
+            else
+                diff = picture_MaxDiff(reference, dst);
+
+            /* Time it over the same input */
+            vlc_tick_t start = vlc_tick_now();
+            for (unsigned iter = 0; iter < BENCH_ITERS; iter++)
+            {
+                picture_t *out = converter_Run(filter, src);
+                assert(out != NULL);
+                picture_Release(out);
+            }
+            vlc_tick_t elapsed = vlc_tick_now() - start;
+            double frame_us = (double)US_FROM_VLC_TICK(elapsed) / BENCH_ITERS;
+            double mb_s = frame_us > 0.
+                ? picture_VisibleBytes(src) / frame_us : 0.;
+
+            printf("  %-20s score %3d %10.1f us/frame %8.1f MB/s"
+                   " maxdiff %u%s%s\n", name, score, frame_us, mb_s, diff,
+                   dst == NULL ? " (reference)" : "",
+                   diff > conv->tolerance ? " MISMATCH" : "");
+            if (diff > conv->tolerance)
+                failures++;
+
+            if (dst != NULL)
+                picture_Release(dst);
+            converter_Delete(filter);
+        }
+
+    if (reference != NULL)
+        picture_Release(reference);
+    picture_Release(src);
+    video_format_Clean(&fmt_in);
+    video_format_Clean(&fmt_out);
+    return failures;
+}
+
+int main(void)
+{
+    test_init();
+
+    libvlc_instance_t *vlc = libvlc_new(0, NULL);
+    assert(vlc != NULL);
+
+    vlc_object_t *parent = VLC_OBJECT(vlc->p_libvlc_int);
+
+    size_t nmods;
+    module_t **mods = module_list_get(&nmods);
+    assert(mods != NULL);
+
+    unsigned failures = 0;
+    for (size_t c = 0; c < ARRAY_SIZE(conversions); c++)
+        for (size_t s = 0; s < ARRAY_SIZE(sizes); s++)
+            failures += run_matrix_entry(parent, mods, nmods,
+                                         &conversions[c],
+                                         sizes[s].width, sizes[s].height);
+
+    module_list_free(mods);
+    libvlc_release(vlc);
+
+    if (failures > 0)
+    {
+        fprintf(stderr, "%u converter(s) disagree with the C reference\n",
+                failures);
+        return 1;
+    }
+    return 0;
+}
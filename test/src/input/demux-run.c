@@ -53,6 +53,9 @@ struct test_es_out_t
 {
     struct es_out_t out;
     struct es_out_id_t *ids;
+    uintmax_t added_es;
+    uintmax_t sent_blocks;
+    uintmax_t sent_bytes;
 #ifdef HAVE_DECODERS
     vlc_object_t *parent;
 #endif
@@ -81,6 +84,7 @@ static es_out_id_t *EsOutAdd(es_out_t *out, input_source_t* in, const es_format_
 
     id->next = ctx->ids;
     ctx->ids = id;
+    ctx->added_es++;
 #ifdef HAVE_DECODERS
     es_format_Copy(&id->fmt, fmt);
     id->decoder = test_decoder_create(ctx->parent, &id->fmt);
@@ -107,6 +111,8 @@ static int EsOutSend(es_out_t *out, es_out_id_t *id, block_t *block)
 
     //debug("[%p] Sent    ES: %zu\n", (void *)idd, block->i_buffer);
     EsOutCheckId(ctx, id);
+    ctx->sent_blocks++;
+    ctx->sent_bytes += block->i_buffer;
 #ifdef HAVE_DECODERS
     if (id->decoder)
         test_decoder_process(id->decoder, block);
@@ -232,6 +238,9 @@ static es_out_t *test_es_out_create(vlc_object_t *parent)
     }
 
     ctx->ids = NULL;
+    ctx->added_es = 0;
+    ctx->sent_blocks = 0;
+    ctx->sent_bytes = 0;
 
     es_out_t *out = &ctx->out;
     out->cbs = &es_out_cbs;
@@ -303,9 +312,15 @@ static int demux_process_stream(const struct vlc_run_args *args, stream_t *s)
         return -1;
     }
 
+    struct test_es_out_t *ctx = (struct test_es_out_t *)out;
+    /* The demuxer owns the stream: copy the URL for the benchmark report */
+    char *url = (args->benchmark && s->psz_url != NULL)
+              ? strdup(s->psz_url) : NULL;
     uintmax_t i = 0;
     int val;
 
+    vlc_tick_t start = vlc_tick_now();
+
     while ((val = demux_Demux(demux)) == VLC_DEMUXER_SUCCESS)
     {
         if (args->test_demux_controls)
@@ -330,7 +345,27 @@ static int demux_process_stream(const struct vlc_run_args *args, stream_t *s)
         i++;
     }
 
+    vlc_tick_t elapsed = vlc_tick_now() - start;
+
     demux_Delete(demux);
+
+    if (args->benchmark)
+    {
+        double secs = secf_from_vlc_tick(elapsed);
+
+        printf("{\"demux\": \"%s\", \"url\": \"%s\", "
+               "\"iterations\": %" PRIuMAX ", "
+               "\"es\": %" PRIuMAX ", \"blocks\": %" PRIuMAX ", "
+               "\"bytes\": %" PRIuMAX ", \"elapsed_us\": %" PRId64 ", "
+               "\"mb_per_s\": %.2f, \"blocks_per_s\": %.0f}\n",
+               name, url != NULL ? url : "", i, ctx->added_es,
+               ctx->sent_blocks, ctx->sent_bytes,
+               US_FROM_VLC_TICK(elapsed),
+               secs > 0. ? ctx->sent_bytes / secs / 1e6 : 0.,
+               secs > 0. ? ctx->sent_blocks / secs : 0.);
+    }
+    free(url);
+
     es_out_Delete(out);
 
     debug("Completed with %" PRIuMAX " iteration(s).\n", i);
@@ -135,5 +135,24 @@ int main( void )
     assert_current( p_epg, "B" );
     vlc_epg_Delete( p_epg );
 
+    /* Test lookups by airing time */
+    printf("--test %d\n", i++);
+    p_epg = vlc_epg_New( 0, 0 );
+    assert(p_epg);
+    assert( vlc_epg_GetEvent( p_epg, 42 ) == NULL );
+    EPG_ADD( p_epg,  42, 20, "A" );
+    EPG_ADD( p_epg,  62, 20, "B" );
+    EPG_ADD( p_epg, 102, 20, "D" );
+    print_order( p_epg );
+    assert( vlc_epg_GetEvent( p_epg, 41 ) == NULL );
+    assert( vlc_epg_GetEvent( p_epg, 42 )->psz_name[0] == 'A' );
+    assert( vlc_epg_GetEvent( p_epg, 61 )->psz_name[0] == 'A' );
+    assert( vlc_epg_GetEvent( p_epg, 62 )->psz_name[0] == 'B' );
+    assert( vlc_epg_GetEvent( p_epg, 82 ) == NULL ); /* gap before D */
+    assert( vlc_epg_GetEvent( p_epg, 102 )->psz_name[0] == 'D' );
+    assert( vlc_epg_GetEvent( p_epg, 121 )->psz_name[0] == 'D' );
+    assert( vlc_epg_GetEvent( p_epg, 122 ) == NULL );
+    vlc_epg_Delete( p_epg );
+
     return 0;
 }
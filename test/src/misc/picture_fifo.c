@@ -0,0 +1,102 @@
+/*****************************************************************************
+ * picture_fifo.c: test for the picture fifo
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+
+#include <vlc_common.h>
+#include <vlc_picture.h>
+#include <vlc_picture_fifo.h>
+
+/* Must match the ring size of the SPSC variant (src/misc/picture_fifo.c) */
+#define SPSC_RING_SIZE 64
+
+static vlc_tick_t push_date;
+static vlc_tick_t pop_date;
+
+static void push_next(picture_fifo_t *fifo)
+{
+    picture_t *picture = picture_New(VLC_CODEC_I420, 64, 48, 1, 1);
+    assert(picture != NULL);
+
+    picture->date = push_date++;
+    picture_fifo_Push(fifo, picture);
+}
+
+static void pop_next(picture_fifo_t *fifo)
+{
+    picture_t *picture = picture_fifo_Pop(fifo);
+    assert(picture != NULL);
+
+    /* Pictures must come out in push order, whatever internal path
+     * (ring, overflow chain) each of them took */
+    assert(picture->date == pop_date);
+    pop_date++;
+    picture_Release(picture);
+}
+
+static void check_fifo_order(picture_fifo_t *fifo)
+{
+    push_date = pop_date = VLC_TICK_0;
+
+    /* Basic order on the fast path */
+    for (int i = 0; i < 10; i++)
+        push_next(fifo);
+    assert(!picture_fifo_IsEmpty(fifo));
+    for (int i = 0; i < 10; i++)
+        pop_next(fifo);
+    assert(picture_fifo_IsEmpty(fifo));
+    assert(picture_fifo_Pop(fifo) == NULL);
+
+    /* Stalled consumer: fill the ring and overflow it */
+    for (int i = 0; i < SPSC_RING_SIZE + 5; i++)
+        push_next(fifo);
+
+    /* Resumed consumer: drain interleaved with further pushes, so new
+     * pictures arrive while older overflowed ones are still queued */
+    for (int i = 0; i < 4 * SPSC_RING_SIZE; i++) {
+        pop_next(fifo);
+        push_next(fifo);
+    }
+
+    /* Drain completely */
+    while (pop_date < push_date)
+        pop_next(fifo);
+    assert(picture_fifo_IsEmpty(fifo));
+    assert(picture_fifo_Pop(fifo) == NULL);
+}
+
+int main(void)
+{
+    picture_fifo_t *fifo = picture_fifo_New();
+    assert(fifo != NULL);
+    check_fifo_order(fifo);
+    picture_fifo_Delete(fifo);
+
+    fifo = picture_fifo_NewSPSC();
+    assert(fifo != NULL);
+    check_fifo_order(fifo);
+    picture_fifo_Delete(fifo);
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*****************************************************************************
+ * sort.c: test for vlc_qsort
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include <vlc_common.h>
+#include <vlc_sort.h>
+
+static int compar_int(const void *a, const void *b, void *arg)
+{
+    int x = *(const int *)a, y = *(const int *)b;
+
+    *(size_t *)arg += 1; /* check that the context is passed through */
+    return (x > y) - (x < y);
+}
+
+struct wide
+{
+    int key;
+    char payload[13]; /* odd size, not a multiple of the word size */
+};
+
+static int compar_wide(const void *a, const void *b, void *arg)
+{
+    const struct wide *x = a, *y = b;
+
+    (void) arg;
+    return (x->key > y->key) - (x->key < y->key);
+}
+
+static uint32_t lcg(uint32_t *seed)
+{
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 16;
+}
+
+static void check_ints(size_t count, uint32_t pattern)
+{
+    int *array = vlc_alloc(count > 0 ? count : 1, sizeof (*array));
+    assert(array != NULL);
+
+    uint32_t seed = 0x2545f491 + (uint32_t)count;
+    long long sum = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        switch (pattern)
+        {
+            case 0: /* random */
+                array[i] = (int)lcg(&seed) - 0x4000;
+                break;
+            case 1: /* already sorted */
+                array[i] = (int)i;
+                break;
+            case 2: /* reverse sorted */
+                array[i] = (int)(count - i);
+                break;
+            case 3: /* all equal */
+                array[i] = 42;
+                break;
+            case 4: /* few distinct values */
+                array[i] = (int)(lcg(&seed) % 7);
+                break;
+        }
+        sum += array[i];
+    }
+
+    size_t calls = 0;
+    vlc_qsort(array, count, sizeof (*array), compar_int, &calls);
+
+    long long sorted_sum = count > 0 ? array[0] : 0;
+    for (size_t i = 1; i < count; i++)
+    {
+        assert(array[i - 1] <= array[i]);
+        sorted_sum += array[i];
+    }
+    /* weak multiset check: the content must be preserved */
+    assert(sorted_sum == sum);
+    free(array);
+}
+
+static void check_wide(size_t count)
+{
+    struct wide *array = vlc_alloc(count, sizeof (*array));
+    assert(array != NULL);
+
+    uint32_t seed = 0x12345678;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        array[i].key = (int)(lcg(&seed) % 1000);
+        memset(array[i].payload, (int)(array[i].key & 0xff),
+               sizeof (array[i].payload));
+    }
+
+    vlc_qsort(array, count, sizeof (*array), compar_wide, NULL);
+
+    for (size_t i = 1; i < count; i++)
+    {
+        assert(array[i - 1].key <= array[i].key);
+        /* the payload must travel with its key */
+        assert(array[i].payload[0] == (char)(array[i].key & 0xff));
+    }
+    free(array);
+}
+
+int main(void)
+{
+    static const size_t counts[] = { 0, 1, 2, 7, 23, 24, 25, 100, 1000,
+                                     65536 };
+
+    for (size_t i = 0; i < ARRAY_SIZE(counts); i++)
+        for (uint32_t pattern = 0; pattern <= 4; pattern++)
+            check_ints(counts[i], pattern);
+
+    check_wide(10000);
+    return 0;
+}
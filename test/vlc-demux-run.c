@@ -33,19 +33,21 @@
 
 int main(int argc, char *argv[])
 {
-    const char *filename;
     struct vlc_run_args args;
     vlc_run_args_init(&args);
 
-    switch (argc)
+    if (argc < 2)
     {
-        case 2:
-            filename = argv[argc - 1];
-            break;
-        default:
-            fprintf(stderr, "Usage: [VLC_TARGET=demux] %s <filename>\n", argv[0]);
-            return 1;
+        fprintf(stderr, "Usage: [VLC_TARGET=demux] [VLC_DEMUX_BENCH=1] "
+                "%s <filename>...\n", argv[0]);
+        return 1;
     }
 
-    return -vlc_demux_process_path(&args, filename);
+    int ret = 0;
+
+    for (int i = 1; i < argc; i++)
+        if (vlc_demux_process_path(&args, argv[i]))
+            ret = 1;
+
+    return ret;
 }